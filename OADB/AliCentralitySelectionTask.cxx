@@ -52,6 +52,7 @@
 #include "AliCentrality.h"
 #include "AliOADBCentrality.h"
 #include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliMultiplicity.h"
 #include "AliAODHandler.h"
 #include "AliAODHeader.h"
@@ -336,7 +337,8 @@ AliAnalysisTaskSE(),
   fHOutMultTRKvsCL1qual2(0),
   fHOutQuality(0),
   fHOutVertex(0),
-  fHOutVertexT0(0)
+  fHOutVertexT0(0),
+  fCentralityOADB(0)
 {   
   // Default constructor
   AliInfo("Centrality Selection enabled.");
@@ -606,7 +608,8 @@ AliCentralitySelectionTask::AliCentralitySelectionTask(const char *name):
   fHOutMultTRKvsCL1qual2(0),
   fHOutQuality(0),
   fHOutVertex(0),
-  fHOutVertexT0(0)
+  fHOutVertexT0(0),
+  fCentralityOADB(0)
 {
   // Default constructor
   AliInfo("Centrality Selection enabled.");
@@ -886,7 +889,8 @@ AliCentralitySelectionTask::AliCentralitySelectionTask(const AliCentralitySelect
   fHOutMultTRKvsCL1qual2(ana.fHOutMultTRKvsCL1qual2),
   fHOutQuality(ana.fHOutQuality),
   fHOutVertex(ana.fHOutVertex),
-  fHOutVertexT0(ana.fHOutVertexT0)
+  fHOutVertexT0(ana.fHOutVertexT0),
+  fCentralityOADB(0)
 {
   // Copy Constructor	
 
@@ -901,6 +905,7 @@ AliCentralitySelectionTask::~AliCentralitySelectionTask()
   if (fEsdTrackCuts) delete fEsdTrackCuts;
   if (fEsdTrackCutsExtra1) delete fEsdTrackCutsExtra1;
   if (fEsdTrackCutsExtra2) delete fEsdTrackCutsExtra2;
+  if (fCentralityOADB) AliOADBCache::Instance()->Release(Form("%s/COMMON/CENTRALITY/data/centrality.root", AliAnalysisManager::GetOADBPath()), "Centrality");
 }  
 
 //________________________________________________________________________
@@ -2008,8 +2013,13 @@ Int_t AliCentralitySelectionTask::SetupRun(const AliVEvent* const esd)
   TString fileName =(Form("%s/COMMON/CENTRALITY/data/centrality.root", AliAnalysisManager::GetOADBPath()));
   AliInfo(Form("Setup Centrality Selection for run %d with file %s\n",fCurrentRun,fileName.Data()));
 
-  AliOADBContainer *con = new AliOADBContainer("OADB");
-  con->InitFromFile(fileName,"Centrality");
+  // the container is read once per worker and shared through the OADB cache
+  if (!fCentralityOADB) fCentralityOADB = AliOADBCache::Instance()->GetContainer(fileName,"Centrality");
+  if (!fCentralityOADB) {
+    AliError(Form("Centrality OADB container not available in %s", fileName.Data()));
+    return -1;
+  }
+  AliOADBContainer *con = fCentralityOADB;
 
   AliOADBCentrality*  centOADB = 0;
   centOADB = (AliOADBCentrality*)(con->GetObject(fCurrentRun));
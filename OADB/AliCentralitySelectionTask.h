@@ -19,6 +19,7 @@ class TString;
 
 class AliESDEvent;
 class AliESDtrackCuts;
+class AliOADBContainer;
 
 class AliCentralitySelectionTask : public AliAnalysisTaskSE {
 
@@ -326,7 +327,9 @@ class AliCentralitySelectionTask : public AliAnalysisTaskSE {
   TH1F *fHOutVertex ;           //control histogram for vertex SPD
   TH1F *fHOutVertexT0 ;         //control histogram for vertex T0
 
-  ClassDef(AliCentralitySelectionTask, 31); 
+  AliOADBContainer *fCentralityOADB; //! centrality OADB container, reference held in AliOADBCache
+
+  ClassDef(AliCentralitySelectionTask, 32); 
 };
 
 #endif
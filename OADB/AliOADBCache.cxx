@@ -0,0 +1,210 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//     Process-wide cache of OADB containers and objects
+//     See header for the usage
+//-------------------------------------------------------------------------
+
+#include <mutex>
+#include <TFile.h>
+#include <TString.h>
+#include <TDirectory.h>
+#include "AliOADBContainer.h"
+#include "AliOADBCache.h"
+#include "AliLog.h"
+
+ClassImp(AliOADBCache);
+
+namespace {
+  std::mutex gOADBCacheMutex;  // guards all AliOADBCache state
+
+  std::string ContainerKey(const char* fileName, const char* containerName)
+  {
+    // key of a container in the cache
+    return std::string(fileName) + "#" + containerName;
+  }
+}
+
+//______________________________________________________________________________
+AliOADBCache* AliOADBCache::Instance()
+{
+  // Returns the cache shared by all tasks in the process. It is never deleted:
+  // clients may still release their references from static destructors at exit.
+  static AliOADBCache* instance = new AliOADBCache();
+  return instance;
+}
+
+//______________________________________________________________________________
+AliOADBCache::AliOADBCache() :
+  TObject(),
+  fContainers(),
+  fNHits(0),
+  fNMisses(0),
+  fNFileOpens(0)
+{
+  // Default constructor, use Instance()
+}
+
+//______________________________________________________________________________
+AliOADBCache::~AliOADBCache()
+{
+  // Destructor
+  for (std::map<std::string, ContainerEntry_t>::iterator it = fContainers.begin(); it != fContainers.end(); ++it) {
+    delete it->second.fContainer;
+  }
+}
+
+//______________________________________________________________________________
+AliOADBCache::ContainerEntry_t* AliOADBCache::LoadContainer(const char* fileName, const char* containerName)
+{
+  // Returns the entry for (file, container), reading the container on first request.
+  // The caller must hold gOADBCacheMutex.
+  std::string key = ContainerKey(fileName, containerName);
+  std::map<std::string, ContainerEntry_t>::iterator it = fContainers.find(key);
+  if (it != fContainers.end()) return &(it->second);
+
+  TDirectory::TContext context(0);  // do not change gDirectory of the caller
+  TFile* file = TFile::Open(fileName);
+  fNFileOpens++;
+  if (!file || !file->IsOpen()) {
+    AliError(Form("Cannot open OADB file %s", fileName));
+    delete file;
+    return 0;
+  }
+  AliOADBContainer* container = dynamic_cast<AliOADBContainer*>(file->Get(containerName));
+  file->Close();
+  delete file;
+  if (!container) {
+    AliError(Form("Cannot fetch OADB container %s from %s", containerName, fileName));
+    return 0;
+  }
+  AliInfo(Form("Loaded OADB container %s from %s", containerName, fileName));
+
+  ContainerEntry_t& entry = fContainers[key];
+  entry.fContainer = container;
+  entry.fRefCount  = 0;
+  entry.fNHits     = 0;
+  entry.fNMisses   = 0;
+  return &entry;
+}
+
+//______________________________________________________________________________
+AliOADBContainer* AliOADBCache::GetContainer(const char* fileName, const char* containerName)
+{
+  // Returns the container and takes a reference on it, 0 if not available.
+  // The container stays owned by the cache. It, and every object taken from
+  // it, stays valid until the reference is released.
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  ContainerEntry_t* entry = LoadContainer(fileName, containerName);
+  if (!entry) return 0;
+  entry->fRefCount++;
+  return entry->fContainer;
+}
+
+//______________________________________________________________________________
+TObject* AliOADBCache::GetObject(const char* fileName, const char* containerName, Int_t run,
+                                 const char* defaultName, const char* passName)
+{
+  // Returns the object valid for run/pass (or the default object) and takes a
+  // reference on the container. The object is owned by the container and must
+  // not be modified or deleted - Clone() it if it has to be changed. Objects are
+  // not refcounted individually: the container reference pins them, so the
+  // pointer must not be used after the matching Release().
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  ContainerEntry_t* entry = LoadContainer(fileName, containerName);
+  if (!entry) return 0;
+  entry->fRefCount++;
+
+  std::string key = Form("%d#%s#%s", run, defaultName ? defaultName : "", passName ? passName : "");
+  std::map<std::string, TObject*>::iterator it = entry->fObjects.find(key);
+  if (it != entry->fObjects.end()) {
+    entry->fNHits++;
+    fNHits++;
+    return it->second;
+  }
+  entry->fNMisses++;
+  fNMisses++;
+  TObject* obj = entry->fContainer->GetObject(run, defaultName, passName);
+  entry->fObjects[key] = obj;  // missing objects are cached as well
+  return obj;
+}
+
+//______________________________________________________________________________
+void AliOADBCache::Release(const char* fileName, const char* containerName)
+{
+  // Drops a reference taken by GetContainer/GetObject
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  std::map<std::string, ContainerEntry_t>::iterator it = fContainers.find(ContainerKey(fileName, containerName));
+  if (it == fContainers.end() || it->second.fRefCount <= 0) {
+    AliWarning(Form("No reference held on OADB container %s from %s", containerName, fileName));
+    return;
+  }
+  it->second.fRefCount--;
+}
+
+//______________________________________________________________________________
+void AliOADBCache::ReleaseUnused()
+{
+  // Deletes the containers (and their objects) nobody holds a reference on
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  std::map<std::string, ContainerEntry_t>::iterator it = fContainers.begin();
+  while (it != fContainers.end()) {
+    if (it->second.fRefCount > 0) {
+      ++it;
+      continue;
+    }
+    delete it->second.fContainer;
+    fContainers.erase(it++);
+  }
+}
+
+//______________________________________________________________________________
+void AliOADBCache::Reset()
+{
+  // Deletes all cached containers and clears the object lookups. Containers
+  // still referenced pin their objects: they are kept, with a warning
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  std::map<std::string, ContainerEntry_t>::iterator it = fContainers.begin();
+  while (it != fContainers.end()) {
+    if (it->second.fRefCount > 0) {
+      AliWarning(Form("OADB container %s still holds %d reference(s), not deleted", it->first.c_str(), it->second.fRefCount));
+      ++it;
+      continue;
+    }
+    delete it->second.fContainer;
+    fContainers.erase(it++);
+  }
+}
+
+//______________________________________________________________________________
+void AliOADBCache::PrintStatistics() const
+{
+  // Prints the cache hit statistics, per container and in total
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  Printf("AliOADBCache: %lld file opens, %lld object hits, %lld object misses (hit rate %.1f%%)",
+         fNFileOpens, fNHits, fNMisses, (fNHits+fNMisses) > 0 ? 100.*fNHits/(fNHits+fNMisses) : 0.);
+  for (std::map<std::string, ContainerEntry_t>::const_iterator it = fContainers.begin(); it != fContainers.end(); ++it) {
+    Printf("  %-80s refs %4d  hits %8lld  misses %6lld", it->first.c_str(),
+           it->second.fRefCount, it->second.fNHits, it->second.fNMisses);
+  }
+}
+
+//______________________________________________________________________________
+void AliOADBCache::Print(Option_t* /*option*/) const
+{
+  // Print the cache content and statistics
+  PrintStatistics();
+}
@@ -0,0 +1,73 @@
+#ifndef ALIOADBCACHE_H
+#define ALIOADBCACHE_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Process-wide cache of OADB containers and objects
+//
+//     Containers are read lazily once per (file, container) and shared by
+//     all tasks of a train worker. Object lookups are memoized per
+//     (file, container, run, default name, pass). Tasks hold references on
+//     the containers they use; containers without references can be
+//     dropped with ReleaseUnused() or Reset(). Objects are not refcounted
+//     on their own: an object returned by GetObject() (or taken from a
+//     container) is only valid while the container reference is held, so
+//     either keep the reference for as long as the object is used or copy
+//     the object before releasing. All methods are thread safe.
+//
+//     Usage:
+//       TObject* obj = AliOADBCache::Instance()->GetObject(fileName, "physSel", run, "oadbDefaultPP", pass);
+//       TObject* copy = obj->Clone();
+//       AliOADBCache::Instance()->Release(fileName, "physSel");  // obj must not be used anymore
+//-------------------------------------------------------------------------
+
+#include <map>
+#include <string>
+#include <TObject.h>
+
+class AliOADBContainer;
+
+class AliOADBCache : public TObject
+{
+ public:
+  static AliOADBCache* Instance();
+  virtual ~AliOADBCache();
+
+  AliOADBContainer* GetContainer(const char* fileName, const char* containerName);
+  TObject*          GetObject(const char* fileName, const char* containerName, Int_t run,
+                              const char* defaultName="", const char* passName="");
+  void              Release(const char* fileName, const char* containerName);
+  void              ReleaseUnused();
+  void              Reset();
+
+  Long64_t          GetNHits()        const { return fNHits;        }
+  Long64_t          GetNMisses()      const { return fNMisses;      }
+  Long64_t          GetNFileOpens()   const { return fNFileOpens;   }
+  void              PrintStatistics() const;
+  virtual void      Print(Option_t* option="") const;
+
+ private:
+  struct ContainerEntry_t {
+    AliOADBContainer*                 fContainer;  // container read from file, owned
+    Int_t                             fRefCount;   // number of outstanding references
+    Long64_t                          fNHits;      // object lookups served from the cache
+    Long64_t                          fNMisses;    // object lookups resolved in the container
+    std::map<std::string, TObject*>   fObjects;    // (run, default, pass) -> object owned by fContainer
+  };
+
+  AliOADBCache();
+  AliOADBCache(const AliOADBCache& cache);
+  AliOADBCache& operator=(const AliOADBCache& cache);
+
+  ContainerEntry_t* LoadContainer(const char* fileName, const char* containerName);
+
+  std::map<std::string, ContainerEntry_t> fContainers; //! (file, container) -> entry
+  Long64_t fNHits;       //! total object cache hits
+  Long64_t fNMisses;     //! total object cache misses
+  Long64_t fNFileOpens;  //! number of OADB files opened
+
+  ClassDef(AliOADBCache, 0);
+};
+
+#endif
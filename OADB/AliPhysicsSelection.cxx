@@ -66,6 +66,9 @@
 //           Michele Floris, CERN
 //-------------------------------------------------------------------------
 #include <vector>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 
 #include <Riostream.h>
 #include <TH1F.h>
@@ -96,6 +99,7 @@
 #include "TPRegexp.h"
 #include "TFile.h"
 #include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliOADBPhysicsSelection.h"
 #include "AliOADBFillingScheme.h"
 #include "AliOADBTriggerAnalysis.h"
@@ -111,6 +115,47 @@
 
 class StringToRegexp : public std::map<std::string, TPRegexp> {};
 
+/// Trigger logic (e.g. "(SPDGFO >= 1 || V0A || V0C) && !V0ABG") compiled into
+/// a postfix program over the trigger bits. Replaces the TFormula evaluation.
+class TriggerLogicProgram {
+public:
+  enum EOp { kPushBit, kPushConst, kNot, kAnd, kOr, kGT, kGE, kLT, kLE, kEQ, kNE };
+  TriggerLogicProgram() : fCode(), fValid(kFALSE) {}
+  std::vector<std::pair<Int_t, Int_t>> fCode; // (operation, operand)
+  Bool_t fValid;                              // kFALSE if the logic could not be compiled
+};
+class StringToProgram : public std::map<std::string, TriggerLogicProgram> {};
+
+/// Requirements of one trigger class, see CheckTriggerClass for the format
+struct TriggerClassCut {
+  std::vector<std::pair<size_t, Bool_t>> fTokens; // (index in TriggerClassCuts::fRegexps, required/rejected)
+  std::vector<Int_t> fBunchCrossings;             // accepted bunch crossings, empty: no requirement
+  UInt_t fReturnCode;                             // returned if the class is fired
+  Int_t  fTriggerLogic;                           // index of the trigger logic
+};
+
+/// Trigger class requirements of all collision and background classes,
+/// the fired classes of an event are decoded once into fFired
+class TriggerClassCuts {
+public:
+  std::vector<TriggerClassCut> fCuts;   // one per entry of fCollTrigClasses + fBGTrigClasses
+  std::vector<std::string> fTokens;     // distinct trigger class tokens
+  std::vector<TPRegexp*> fRegexps;      // regexp per token, owned by fTriggerToRegexp
+  std::vector<Bool_t> fFired;           // per event: token found in the fired classes
+};
+
+/// Results of AliTriggerAnalysis::EvaluateTrigger for the current event. The
+/// AliTriggerAnalysis objects of all trigger classes share the same configuration,
+/// so each (bit, online/offline) combination is evaluated at most once per event.
+class TriggerBitCache {
+public:
+  enum { kNBits = AliTriggerAnalysis::kStartOfFlags };
+  TriggerBitCache() : fEvent(1) { for (Int_t i=0; i<2*kNBits; i++) { fStamp[i]=0; fValue[i]=0; } }
+  ULong64_t fEvent;             // current event counter
+  ULong64_t fStamp[2*kNBits];   // event counter for which fValue is valid
+  Int_t     fValue[2*kNBits];   // cached trigger result
+};
+
 ClassImp(AliPhysicsSelection)
 
 AliPhysicsSelection::AliPhysicsSelection() :
@@ -132,7 +177,10 @@ fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
 fTriggerToFormula(new StringToFormula()),
-fTriggerToRegexp(new StringToRegexp())
+fTriggerToRegexp(new StringToRegexp()),
+fTriggerToProgram(new StringToProgram()),
+fTriggerClassCuts(new TriggerClassCuts()),
+fTriggerBitCache(new TriggerBitCache())
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
@@ -162,7 +210,10 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  fFillOADB(0),
  fTriggerOADB(0),
  fTriggerToFormula(new StringToFormula()),
- fTriggerToRegexp(new StringToRegexp())
+ fTriggerToRegexp(new StringToRegexp()),
+ fTriggerToProgram(new StringToProgram()),
+ fTriggerClassCuts(new TriggerClassCuts()),
+ fTriggerBitCache(new TriggerBitCache())
  {
    // constructor
    fCollTrigClasses.SetOwner(1);
@@ -179,6 +230,9 @@ AliPhysicsSelection::~AliPhysicsSelection(){
   if (fTriggerOADB)  delete fTriggerOADB;
   delete fTriggerToFormula;
   delete fTriggerToRegexp;
+  delete fTriggerToProgram;
+  delete fTriggerClassCuts;
+  delete fTriggerBitCache;
 }
 
 UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
@@ -270,22 +324,125 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
 Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event,
 						 AliTriggerAnalysis* triggerAnalysis,
 						 const char* triggerLogic, Bool_t offline){
+  auto offline_flag = offline ? AliTriggerAnalysis::kOfflineFlag : 0;
+  const TriggerLogicProgram& program = FindProgram(triggerLogic);
+  if (program.fValid) {
+    // Run the compiled program on a small value stack
+    Int_t stack[64];
+    Int_t n = 0;
+    for (const auto& instr : program.fCode) {
+      switch (instr.first) {
+        case TriggerLogicProgram::kPushBit:   stack[n++] = EvaluateTriggerBit(event, triggerAnalysis, instr.second | offline_flag); break;
+        case TriggerLogicProgram::kPushConst: stack[n++] = instr.second; break;
+        case TriggerLogicProgram::kNot:       stack[n-1] = !stack[n-1]; break;
+        case TriggerLogicProgram::kAnd:       n--; stack[n-1] = stack[n-1] && stack[n]; break;
+        case TriggerLogicProgram::kOr:        n--; stack[n-1] = stack[n-1] || stack[n]; break;
+        case TriggerLogicProgram::kGT:        n--; stack[n-1] = stack[n-1] >  stack[n]; break;
+        case TriggerLogicProgram::kGE:        n--; stack[n-1] = stack[n-1] >= stack[n]; break;
+        case TriggerLogicProgram::kLT:        n--; stack[n-1] = stack[n-1] <  stack[n]; break;
+        case TriggerLogicProgram::kLE:        n--; stack[n-1] = stack[n-1] <= stack[n]; break;
+        case TriggerLogicProgram::kEQ:        n--; stack[n-1] = stack[n-1] == stack[n]; break;
+        case TriggerLogicProgram::kNE:        n--; stack[n-1] = stack[n-1] != stack[n]; break;
+      }
+    }
+    return stack[0] != 0;
+  }
+
+  // Fall back to TFormula for logic not supported by the program compiler
   auto& formula_and_bits = FindForumla(triggerLogic);
   auto& trg_formula = formula_and_bits.first;
   auto& bits = formula_and_bits.second;
   // Get the values for each individual trigger in the trigger logic string;
   // These values are the parameters of the TFormula
   std::vector<Double_t> paras(bits.size());
-  auto offline_flag = offline ? AliTriggerAnalysis::kOfflineFlag : 0;
   for (size_t i = 0; i < bits.size(); ++i) {
-    typedef AliTriggerAnalysis::Trigger Trigger;
-    Trigger bit = static_cast<Trigger>(bits[i] | offline_flag);
-    paras[i] = triggerAnalysis->EvaluateTrigger(event, bit);
+    paras[i] = EvaluateTriggerBit(event, triggerAnalysis, bits[i] | offline_flag);
   }
   Double_t dummy_val[] = {0};
   return trg_formula.EvalPar(dummy_val, paras.data());
 }
 
+/// Evaluate a single trigger bit, memoized for the current event
+///
+/// \param event Pointer to the current event
+/// \param triggerAnalysis Pointer to the TriggerAnlysis class
+/// \param bit AliTriggerAnalysis::Trigger, optionally with kOfflineFlag
+///
+/// \return Result of AliTriggerAnalysis::EvaluateTrigger
+Int_t AliPhysicsSelection::EvaluateTriggerBit(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, Int_t bit){
+  if (bit & ~(AliTriggerAnalysis::kOfflineFlag | (AliTriggerAnalysis::kStartOfFlags-1))) // flags other than offline are not cached
+    return triggerAnalysis->EvaluateTrigger(event, static_cast<AliTriggerAnalysis::Trigger>(bit));
+  Int_t index = (bit & (AliTriggerAnalysis::kStartOfFlags-1)) + ((bit & AliTriggerAnalysis::kOfflineFlag) ? TriggerBitCache::kNBits : 0);
+  if (fTriggerBitCache->fStamp[index] != fTriggerBitCache->fEvent) {
+    fTriggerBitCache->fValue[index] = triggerAnalysis->EvaluateTrigger(event, static_cast<AliTriggerAnalysis::Trigger>(bit));
+    fTriggerBitCache->fStamp[index] = fTriggerBitCache->fEvent;
+  }
+  return fTriggerBitCache->fValue[index];
+}
+
+void AliPhysicsSelection::BuildTriggerClassCuts(){
+  // Decode the collision and background trigger class strings once,
+  // format as in CheckTriggerClass(const AliVEvent*, const char*, Int_t&)
+  TriggerClassCuts& cuts = *fTriggerClassCuts;
+  cuts.fCuts.clear();
+  cuts.fTokens.clear();
+  cuts.fRegexps.clear();
+
+  Int_t nColl = fCollTrigClasses.GetEntries();
+  Int_t nBG   = fBGTrigClasses.GetEntries();
+  for (Int_t i=0; i<nColl+nBG; i++) {
+    const char* trigger = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
+    TriggerClassCut cut;
+    cut.fReturnCode = AliVEvent::kUserDefined;
+    cut.fTriggerLogic = 0;
+    std::string str;
+    while (*trigger) {
+      if (*trigger == '+' || *trigger == '-') {
+        Bool_t flag = (*trigger == '+');
+        const char* begin = ++trigger;
+        while (*trigger && *trigger != ' ')
+          trigger++;
+        str.assign(begin, trigger);
+        size_t token = std::find(cuts.fTokens.begin(), cuts.fTokens.end(), str) - cuts.fTokens.begin();
+        if (token == cuts.fTokens.size()) {
+          cuts.fTokens.push_back(str);
+          cuts.fRegexps.push_back(&FindRegexp(str));
+        }
+        cut.fTokens.push_back(std::make_pair(token, flag));
+        continue;
+      }
+      if (*trigger == '#' || *trigger == '&' || *trigger == '*') {
+        char type = *trigger++;
+        Int_t value = 0;
+        while (*trigger && *trigger != ' ')
+          value = 10 * value + (*trigger++ - '0');
+        if (type == '#') cut.fBunchCrossings.push_back(value);
+        else if (type == '&') cut.fReturnCode = value;
+        else cut.fTriggerLogic = value;
+        continue;
+      }
+      trigger++;
+    }
+    cuts.fCuts.push_back(cut);
+  }
+  cuts.fFired.assign(cuts.fTokens.size(), kFALSE);
+}
+
+UInt_t AliPhysicsSelection::CheckTriggerClass(Int_t i, Int_t bunchCrossing, Int_t& triggerLogic) const {
+  // checks trigger class i against the fired classes decoded for the current event,
+  // same result as CheckTriggerClass(event, trigger, triggerLogic)
+  const TriggerClassCut& cut = fTriggerClassCuts->fCuts[i];
+  for (const auto& token : cut.fTokens) {
+    if (fTriggerClassCuts->fFired[token.first] != token.second)
+      return kFALSE; // required not found or rejected found
+  }
+  if (!cut.fBunchCrossings.empty() &&
+      std::find(cut.fBunchCrossings.begin(), cut.fBunchCrossings.end(), bunchCrossing) == cut.fBunchCrossings.end())
+    return kFALSE;
+  triggerLogic = cut.fTriggerLogic;
+  return cut.fReturnCode;
+}
+
 //______________________________________________________________________________
 UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
   // checks if the given event is a collision candidate
@@ -305,15 +462,24 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
   UInt_t accept = 0;
   Int_t nColl = fCollTrigClasses.GetEntries();
   Int_t nBG   = fBGTrigClasses.GetEntries();
+  if ((Int_t)fTriggerClassCuts->fCuts.size() != nColl+nBG) BuildTriggerClassCuts();
+
+  // decode the fired classes once per event and start a new trigger bit cache
+  const TString classes = event->GetFiredTriggerClasses();
+  AliDebug(AliLog::kDebug+1, Form("Processing event with triggers %s", classes.Data()));
+  for (size_t t=0; t<fTriggerClassCuts->fRegexps.size(); t++)
+    fTriggerClassCuts->fFired[t] = fTriggerClassCuts->fRegexps[t]->Match(classes, "", 0, 1) > 0;
+  fTriggerBitCache->fEvent++;
+  Int_t bunchCrossing = event->GetBunchCrossNumber();
+
   for (Int_t i=0; i<nColl+nBG; i++) {
-    const char* triggerClass = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
-    AliDebug(AliLog::kDebug+1, Form("Processing trigger class %s", triggerClass));
+    AliDebug(AliLog::kDebug+1, Form("Processing trigger class %s", i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName()));
     
     AliTriggerAnalysis* triggerAnalysis = static_cast<AliTriggerAnalysis*> (fTriggerAnalysis.At(i));
-    triggerAnalysis->FillTriggerClasses(event);
+    triggerAnalysis->FillTriggerClasses(classes);
     
     Int_t triggerLogic = 0;
-    UInt_t singleTriggerResult = CheckTriggerClass(event, triggerClass, triggerLogic);
+    UInt_t singleTriggerResult = CheckTriggerClass(i, bunchCrossing, triggerLogic);
     if (!singleTriggerResult) continue;
     Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE);
     Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE);
@@ -358,32 +524,35 @@ Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
   Bool_t oldStatus = TH1::AddDirectoryStatus();
   TH1::AddDirectory(kFALSE);
   
-  /// Open OADB file and fetch OADB objects
+  /// Fetch OADB objects through the process-wide cache, the OADB file is opened
+  /// once per worker and shared with the other physics selection instances.
+  /// The cached objects are cloned since fTriggerOADB is updated from OCDB below.
   TString oadbfilename = AliPhysicsSelection::GetOADBFileName();
-  
-  TFile * foadb = TFile::Open(oadbfilename);
-  if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
+  AliOADBCache* oadbCache = AliOADBCache::Instance();
   
   if(!fPSOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
     AliInfo("Using Standard OADB");
-    AliOADBContainer * psContainer = (AliOADBContainer*) foadb->Get("physSel");
-    if (!psContainer) AliFatal("Cannot fetch OADB container for Physics selection");
-    fPSOADB = (AliOADBPhysicsSelection*) psContainer->GetObject(runNumber, fIsPP ? "oadbDefaultPP" : "oadbDefaultPbPb",fPassName);
-    if (!fPSOADB) AliFatal(Form("Cannot find physics selection object for run %d", runNumber));
+    TObject* obj = oadbCache->GetObject(oadbfilename, "physSel", runNumber, fIsPP ? "oadbDefaultPP" : "oadbDefaultPbPb", fPassName);
+    if (!obj) AliFatal(Form("Cannot find physics selection object for run %d", runNumber));
+    delete fPSOADB;
+    fPSOADB = (AliOADBPhysicsSelection*) obj->Clone();
+    oadbCache->Release(oadbfilename, "physSel");
   } else {
     AliInfo("Using Custom OADB");
   }
   if(!fFillOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
-    AliOADBContainer * fillContainer = (AliOADBContainer*) foadb->Get("fillScheme");
-    if (!fillContainer) AliFatal("Cannot fetch OADB container for filling scheme");
-    fFillOADB = (AliOADBFillingScheme*) fillContainer->GetObject(runNumber, "Default",fPassName);
-    if (!fFillOADB) AliFatal(Form("Cannot find  filling scheme object for run %d", runNumber));
+    TObject* obj = oadbCache->GetObject(oadbfilename, "fillScheme", runNumber, "Default", fPassName);
+    if (!obj) AliFatal(Form("Cannot find  filling scheme object for run %d", runNumber));
+    delete fFillOADB;
+    fFillOADB = (AliOADBFillingScheme*) obj->Clone();
+    oadbCache->Release(oadbfilename, "fillScheme");
   }
   if(!fTriggerOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
-    AliOADBContainer * triggerContainer = (AliOADBContainer*) foadb->Get("trigAnalysis");
-    if (!triggerContainer) AliFatal("Cannot fetch OADB container for trigger analysis");
-    fTriggerOADB = (AliOADBTriggerAnalysis*) triggerContainer->GetObject(runNumber, "Default",fPassName);
-    if (!fTriggerOADB) AliFatal(Form("Cannot find  trigger analysis object for run %d", runNumber));
+    TObject* obj = oadbCache->GetObject(oadbfilename, "trigAnalysis", runNumber, "Default", fPassName);
+    if (!obj) AliFatal(Form("Cannot find  trigger analysis object for run %d", runNumber));
+    delete fTriggerOADB;
+    fTriggerOADB = (AliOADBTriggerAnalysis*) obj->Clone();
+    oadbCache->Release(oadbfilename, "trigAnalysis");
     fTriggerOADB->Print();
   }
   
@@ -852,13 +1021,7 @@ FormulaAndBits& AliPhysicsSelection::FindForumla(const char* triggerLogic) {
       e = pos[1];
       std::string matched(trigger.Data() + b, trigger.Data() + e);
 
-      TInterpreter::EErrorCode error;
-      Int_t bit = gInterpreter->ProcessLine(Form("AliTriggerAnalysis::k%s;", matched.c_str()), &error);
-
-      if (error > 0)
-	AliFatal(Form("Trigger token %s unknown", matched.c_str()));
-
-      bits.push_back(static_cast<AliTriggerAnalysis::Trigger>(bit));
+      bits.push_back(static_cast<AliTriggerAnalysis::Trigger>(GetTriggerBit(matched)));
     }
     trg_logic_formated.append({trigger.Data() + e, trigger.Data() + trigger.Length()});
 
@@ -876,6 +1039,103 @@ FormulaAndBits& AliPhysicsSelection::FindForumla(const char* triggerLogic) {
   return it->second;
 }
 
+Int_t AliPhysicsSelection::GetTriggerBit(const std::string& token) const {
+  // Resolve a trigger token like "V0A" to AliTriggerAnalysis::Trigger
+  TInterpreter::EErrorCode error;
+  Int_t bit = gInterpreter->ProcessLine(Form("AliTriggerAnalysis::k%s;", token.c_str()), &error);
+
+  if (error > 0)
+    AliFatal(Form("Trigger token %s unknown", token.c_str()));
+  return bit;
+}
+
+const TriggerLogicProgram& AliPhysicsSelection::FindProgram(const char* triggerLogic) {
+  // Do we have this logic compiled? If not, compile it into a postfix program.
+  // Grammar (C precedence): or := and {"||" and}, and := cmp {"&&" cmp},
+  // cmp := unary [(">="|">"|"<="|"<"|"=="|"!=") unary], unary := "!" unary | primary,
+  // primary := "(" or ")" | integer | trigger token
+  auto it = fTriggerToProgram->find(triggerLogic);
+  if (it != fTriggerToProgram->end())
+    return it->second;
+
+  struct Compiler {
+    const char* fPos;
+    TriggerLogicProgram& fProgram;
+    const AliPhysicsSelection& fSelection;
+    Bool_t fOk;
+    Int_t fDepth;    // current stack depth
+    Int_t fMaxDepth; // maximum stack depth
+
+    void SkipSpaces() { while (*fPos == ' ' || *fPos == '\t') fPos++; }
+    Bool_t Accept(const char* op) {
+      SkipSpaces();
+      size_t len = strlen(op);
+      if (strncmp(fPos, op, len) != 0) return kFALSE;
+      if (len == 1 && (op[0] == '>' || op[0] == '<' || op[0] == '!') && fPos[1] == '=') return kFALSE;
+      fPos += len;
+      return kTRUE;
+    }
+    void Emit(Int_t op, Int_t operand, Int_t depthChange) {
+      fProgram.fCode.push_back(std::make_pair(op, operand));
+      fDepth += depthChange;
+      if (fDepth > fMaxDepth) fMaxDepth = fDepth;
+    }
+    void Or() {
+      And();
+      while (fOk && Accept("||")) { And(); Emit(TriggerLogicProgram::kOr, 0, -1); }
+    }
+    void And() {
+      Cmp();
+      while (fOk && Accept("&&")) { Cmp(); Emit(TriggerLogicProgram::kAnd, 0, -1); }
+    }
+    void Cmp() {
+      Unary();
+      static const char* ops[] = {">=", "<=", "==", "!=", ">", "<"};
+      static const Int_t codes[] = {TriggerLogicProgram::kGE, TriggerLogicProgram::kLE, TriggerLogicProgram::kEQ,
+                                    TriggerLogicProgram::kNE, TriggerLogicProgram::kGT, TriggerLogicProgram::kLT};
+      for (Int_t i=0; fOk && i<6; i++) {
+        if (Accept(ops[i])) { Unary(); Emit(codes[i], 0, -1); return; }
+      }
+    }
+    void Unary() {
+      if (Accept("!")) { Unary(); Emit(TriggerLogicProgram::kNot, 0, 0); return; }
+      Primary();
+    }
+    void Primary() {
+      SkipSpaces();
+      if (Accept("(")) {
+        Or();
+        if (!Accept(")")) fOk = kFALSE;
+        return;
+      }
+      if (isdigit(*fPos)) {
+        Int_t value = 0;
+        while (isdigit(*fPos)) value = 10 * value + (*fPos++ - '0');
+        Emit(TriggerLogicProgram::kPushConst, value, +1);
+        return;
+      }
+      if (isalpha(*fPos)) {
+        const char* begin = fPos;
+        while (isalnum(*fPos)) fPos++;
+        Emit(TriggerLogicProgram::kPushBit, fSelection.GetTriggerBit(std::string(begin, fPos)), +1);
+        return;
+      }
+      fOk = kFALSE;
+    }
+  };
+
+  TriggerLogicProgram& program = (*fTriggerToProgram)[triggerLogic];
+  Compiler compiler = {triggerLogic, program, *this, kTRUE, 0, 0};
+  compiler.Or();
+  compiler.SkipSpaces();
+  program.fValid = compiler.fOk && *compiler.fPos == 0 && compiler.fDepth == 1 && compiler.fMaxDepth <= 64;
+  if (!program.fValid) {
+    AliWarning(Form("Trigger logic %s not supported by the compiler, using TFormula", triggerLogic));
+    program.fCode.clear();
+  }
+  return program;
+}
+
 TPRegexp& AliPhysicsSelection::FindRegexp(const std::string& triggers) const {
   auto it = fTriggerToRegexp->find(triggers);
   if (it != fTriggerToRegexp->end())
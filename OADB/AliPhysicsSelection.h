@@ -45,6 +45,10 @@ class AliOADBFillingScheme;
 class AliOADBTriggerAnalysis;
 class TPRegexp;
 class StringToRegexp;
+class StringToProgram;
+class TriggerLogicProgram;
+class TriggerClassCuts;
+class TriggerBitCache;
 
 typedef std::pair<R5TFormula, std::vector<AliTriggerAnalysis::Trigger>> FormulaAndBits;
 typedef std::map<std::string, FormulaAndBits> StringToFormula;
@@ -128,6 +132,17 @@ protected:
   StringToRegexp* fTriggerToRegexp; //!
   TPRegexp& FindRegexp(const std::string& triggers) const;
 
+  StringToProgram* fTriggerToProgram; //! Map trigger strings to compiled boolean programs
+  const TriggerLogicProgram& FindProgram(const char* triggerLogic); //! Returns compiled program, invalid if the logic is not supported
+  Int_t GetTriggerBit(const std::string& token) const;              //! Returns AliTriggerAnalysis::Trigger for the token, e.g. "V0A"
+  Int_t EvaluateTriggerBit(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, Int_t bit); //! Memoized per event
+
+  TriggerClassCuts* fTriggerClassCuts; //! Trigger class requirements decoded once from fCollTrigClasses and fBGTrigClasses
+  void BuildTriggerClassCuts();
+  UInt_t CheckTriggerClass(Int_t i, Int_t bunchCrossing, Int_t& triggerLogic) const;
+
+  TriggerBitCache* fTriggerBitCache; //! Per event cache of AliTriggerAnalysis::EvaluateTrigger results
+
   ClassDef(AliPhysicsSelection, 24)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
@@ -1,5 +1,6 @@
 #include "AliPhysicsSelectionTask.h"
 #include "AliPhysicsSelection.h"
+#include "AliOADBCache.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 #include "TFile.h"
@@ -92,6 +93,7 @@ void AliPhysicsSelectionTask::FinishTaskOutput(){
 // This gets called at the end of the processing on the worker. It allows dumping
 // statistics printed by the physics selection object to the statistics message
 // handled by the analysis manager.
+   AliOADBCache::Instance()->PrintStatistics();
    if (!fPhysicsSelection) return;
    fPhysicsSelection->FillStatistics();
 //   fPhysicsSelection->Print("STAT");
@@ -1605,10 +1605,16 @@ void AliTriggerAnalysis::SaveHistograms() const {
 //-------------------------------------------------------------------------------------------------
 void AliTriggerAnalysis::FillTriggerClasses(const AliVEvent* event){
   // fills trigger classes map
-  TParameter<Long64_t>* count = dynamic_cast<TParameter<Long64_t>*> (fTriggerClasses->GetValue(event->GetFiredTriggerClasses().Data()));
+  FillTriggerClasses(event->GetFiredTriggerClasses());
+}
+
+//-------------------------------------------------------------------------------------------------
+void AliTriggerAnalysis::FillTriggerClasses(const TString& classes){
+  // fills trigger classes map for the fired classes already decoded by the caller
+  TParameter<Long64_t>* count = dynamic_cast<TParameter<Long64_t>*> (fTriggerClasses->GetValue(classes.Data()));
   if (!count) {
-    count = new TParameter<Long64_t>(event->GetFiredTriggerClasses(), 0);
-    fTriggerClasses->Add(new TObjString(event->GetFiredTriggerClasses().Data()), count);
+    count = new TParameter<Long64_t>(classes, 0);
+    fTriggerClasses->Add(new TObjString(classes.Data()), count);
   }
   count->SetVal(count->GetVal() + 1);
 }
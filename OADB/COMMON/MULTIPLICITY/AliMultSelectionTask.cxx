@@ -82,6 +82,7 @@ class AliESDAD; //AD
 
 //For MultSelection Framework
 #include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliOADBMultSelection.h"
 #include "AliMultEstimator.h"
 #include "AliMultVariable.h"
@@ -246,7 +247,9 @@ fHistQASelected_PtITSsaVsCL1(0),
 
 //Objects
 fOadbMultSelection(0),
-fInput(0)
+fInput(0),
+fOADBFileName(""),
+fOADBFileNameAlter("")
 //------------------------------------------------
 // Tree Variables
 {
@@ -395,7 +398,9 @@ fHistQASelected_PtITSsaVsCL1(0),
 
 //Objects
 fOadbMultSelection(0),
-fInput(0)
+fInput(0),
+fOADBFileName(""),
+fOADBFileNameAlter("")
 {
     
     for( Int_t iq=0; iq<100; iq++ ) fQuantiles[iq] = -1 ;
@@ -434,6 +439,8 @@ AliMultSelectionTask::~AliMultSelectionTask()
         delete fESDtrackCuts;
         fESDtrackCuts = 0x0;
     }
+    if ( !fOADBFileName.IsNull() ) AliOADBCache::Instance()->Release(fOADBFileName, "MultSel");
+    if ( !fOADBFileNameAlter.IsNull() ) AliOADBCache::Instance()->Release(fOADBFileNameAlter, "MultSel");
     if ( fTrackCuts ){
         delete fTrackCuts;
         fTrackCuts = 0x0;
@@ -2080,16 +2087,17 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         lOADBref = Form("BYPASS: %s", fAlternateOADBFullManualBypass.Data());
     }
     
-    //Open File without calling InitFromFile, don't load it all!
-    TFile * foadb = TFile::Open(fileName);
-    if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", fileName.Data()));
+    //Container read once per worker and shared through the OADB cache. The objects taken
+    //from it belong to the container, so the reference is held until the next run is set
+    //up (or the task is deleted); the one of the previous run is only dropped afterwards
+    AliOADBContainer * MultContainer = AliOADBCache::Instance()->GetContainer(fileName, "MultSel");
+    if(!MultContainer) AliFatal(Form("Cannot open OADB file %s or it does not contain OADBContainer named MultSel, stopping here", fileName.Data()));
+    if ( !fOADBFileName.IsNull() ) AliOADBCache::Instance()->Release(fOADBFileName, "MultSel");
+    fOADBFileName = fileName;
     
     //Managed to open, save name of opened OADB file
     lHistTitle.Append(Form(", OADB: %s",lOADBref.Data()));
     
-    AliOADBContainer * MultContainer = (AliOADBContainer*) foadb->Get("MultSel");
-    if(!MultContainer) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileName.Data()));
-    
     //Get Object for this run!
     TObject *lObjAcquired = 0x0;
     
@@ -2171,16 +2179,11 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         //Managed to open, save name of opened OADB file
         lHistTitle.Append(Form(", muOADB: %s",lmuOADBref.Data()));
         
-        //Open fileNameAlter
-        TFile * foadbAlter = 0x0;
-        foadbAlter = TFile::Open(fileNameAlter);
-        
-        //Check existence, please
-        if(!foadbAlter) AliFatal(Form("Cannot open OADB file %s", fileNameAlter.Data()));
-        if(!foadbAlter->IsOpen()) AliFatal(Form("Cannot open OADB file %s", fileNameAlter.Data()));
-        
-        AliOADBContainer * MultContainerAlter = (AliOADBContainer*) foadbAlter->Get("MultSel");
-        if(!MultContainerAlter) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileNameAlter.Data()));
+        //Container of fileNameAlter, shared through the OADB cache and held like the one above
+        AliOADBContainer * MultContainerAlter = AliOADBCache::Instance()->GetContainer(fileNameAlter, "MultSel");
+        if(!MultContainerAlter) AliFatal(Form("Cannot open OADB file %s or it does not contain OADBContainer named MultSel, stopping here", fileNameAlter.Data()));
+        if ( !fOADBFileNameAlter.IsNull() ) AliOADBCache::Instance()->Release(fOADBFileNameAlter, "MultSel");
+        fOADBFileNameAlter = fileNameAlter;
         
         //Get Object for this run
         TObject *lObjAcquiredAlter = 0x0;
@@ -351,6 +351,8 @@ private:
     //AliMultSelection Framework
     AliOADBMultSelection *fOadbMultSelection;
     AliMultInput         *fInput;
+    TString fOADBFileName;      //! MultSel container of this run, reference held in AliOADBCache
+    TString fOADBFileNameAlter; //! same, for the alternate (MC) estimator definitions
 
     AliMultSelectionTask(const AliMultSelectionTask&);            // not implemented
     AliMultSelectionTask& operator=(const AliMultSelectionTask&); // not implemented
@@ -0,0 +1,199 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TObjArray.h>
+#include <TLorentzVector.h>
+#include <TVector3.h>
+#include <TMath.h>
+
+// --- C++ ---
+#include <algorithm>
+
+// --- AliRoot system ---
+#include "AliVTrack.h"
+#include "AliVCluster.h"
+#include "AliMixedEvent.h"
+
+// --- CaloTrackCorr ---
+#include "AliCaloTrackParticle.h"
+#include "AliCaloTrackReader.h"
+#include "AliCaloTrackEtaPhiGrid.h"
+
+/// \cond CLASSIMP
+ClassImp(AliCaloTrackEtaPhiGrid) ;
+/// \endcond
+
+//____________________________________________________________________
+/// Constructor.
+/// \param cellSize: size of the cells in eta and in phi (rad).
+//____________________________________________________________________
+AliCaloTrackEtaPhiGrid::AliCaloTrackEtaPhiGrid(Float_t cellSize) :
+TObject(),
+fCellSize(cellSize),
+fList(0x0),         fNEntries(0),
+fValid(),           fPt(),             fEta(),            fPhi(),
+fGrid(),            fCandidates()
+{
+}
+
+//____________________________________________________________________
+/// \return True if the grid was filled for the list and the list was
+/// not modified since then (same number of entries).
+/// The reader resets the grid when the lists are reset.
+//____________________________________________________________________
+Bool_t AliCaloTrackEtaPhiGrid::IsFilledFor(const TObjArray * list) const
+{
+  return ( list && list == fList && list->GetEntriesFast() == fNEntries ) ;
+}
+
+//____________________________________________________________________
+/// Calculate the kinematics of the entries of the list and sort them
+/// in the eta-phi cells.
+/// The kinematics are calculated as in AliIsolationCut::MakeIsolationCut():
+///  * tracks: from the momentum components,
+///  * clusters: momentum assuming they come from the vertex of their event in straight line,
+///  * mixed events particles: as stored.
+/// \param list: list of tracks or clusters filled by the reader.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access the vertex.
+//____________________________________________________________________
+void AliCaloTrackEtaPhiGrid::Fill(const TObjArray * list, AliCaloTrackReader * reader)
+{
+  fList     = list ;
+  fNEntries = list ? list->GetEntriesFast() : 0 ;
+
+  fValid.assign(fNEntries, kFALSE);
+  fPt   .assign(fNEntries, -100.);
+  fEta  .assign(fNEntries, -100.);
+  fPhi  .assign(fNEntries, -100.);
+
+  TVector3       trackVector ;
+  TLorentzVector momentum ;
+
+  Float_t etaMin =  1e6 ;
+  Float_t etaMax = -1e6 ;
+
+  for(Int_t i = 0; i < fNEntries; i++)
+  {
+    TObject * obj = list->At(i) ;
+    if ( !obj ) continue ;
+
+    Float_t pt  = -100. ;
+    Float_t eta = -100. ;
+    Float_t phi = -100. ;
+
+    AliVTrack            * track    = dynamic_cast<AliVTrack*>           (obj) ;
+    AliVCluster          * calo     = 0x0 ;
+    AliCaloTrackParticle * particle = 0x0 ;
+
+    if ( track )
+    {
+      trackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+      pt  = trackVector.Pt();
+      eta = trackVector.Eta();
+      phi = trackVector.Phi() ;
+    }
+    else if ( (calo = dynamic_cast<AliVCluster*>(obj)) )
+    {
+      // Get the index where the cluster comes, to retrieve the corresponding vertex
+      Int_t evtIndex = 0 ;
+      if (reader->GetMixedEvent())
+        evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+
+      calo->GetMomentum(momentum,reader->GetVertex(evtIndex)) ;
+      pt  = momentum.Pt()  ;
+      eta = momentum.Eta() ;
+      phi = momentum.Phi() ;
+    }
+    else if ( (particle = dynamic_cast<AliCaloTrackParticle*>(obj)) )
+    {
+      pt  = particle->Pt();
+      eta = particle->Eta();
+      phi = particle->Phi() ;
+    }
+    else continue ;
+
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+
+    fValid[i] = kTRUE ;
+    fPt   [i] = pt ;
+    fEta  [i] = eta ;
+    fPhi  [i] = phi ;
+
+    if ( eta < etaMin ) etaMin = eta ;
+    if ( eta > etaMax ) etaMax = eta ;
+  }
+
+  // Grid limits, large eta values (pT = 0 tracks) go to the edge cells
+  if ( etaMin < -10 ) etaMin = -10 ;
+  if ( etaMax >  10 ) etaMax =  10 ;
+  if ( etaMax < etaMin ) { etaMin = 0 ; etaMax = 0 ; }
+
+  Int_t nEtaCells = Int_t((etaMax-etaMin)/fCellSize) + 1 ;
+  Int_t nPhiCells = TMath::Max(1, Int_t(TMath::TwoPi()/fCellSize)) ;
+  fGrid.SetBinning(nEtaCells, etaMin, etaMin + nEtaCells*fCellSize, nPhiCells);
+
+  // Sort the entries by cell, keep the list order within a cell
+  for(Int_t i = 0; i < fNEntries; i++)
+  {
+    if ( fValid[i] ) fGrid.Add(i, fEta[i], fPhi[i]);
+  }
+  fGrid.Build();
+}
+
+//____________________________________________________________________
+/// Get the indices of the entries which can be in the cone around a
+/// candidate, and optionally in the eta and phi bands used for the
+/// underlying event estimation in AliIsolationCut. The indices are
+/// returned in the list order, such that sums are done in the same
+/// order as when looping over the full list.
+/// The cells overlapping the cone are taken with phi wrapped around 2pi,
+/// as in AliIsolationCut::Radius(). The cells of the eta band are wrapped
+/// as well, a superset of the band of AliIsolationCut::MakeIsolationCut().
+/// The exact selection is left to the caller.
+/// \param etaC: pseudorapidity of candidate particle.
+/// \param phiC: azimuthal angle of candidate particle, in [0, 2pi[.
+/// \param r: radius of the cone, for several cones the largest one.
+/// \param bands: also get the entries in the eta and phi bands around the cone.
+/// \param indices: indices of the entries in the list, output.
+//____________________________________________________________________
+void AliCaloTrackEtaPhiGrid::GetEntriesAround(Float_t etaC, Float_t phiC, Float_t r, Bool_t bands,
+                                              std::vector<Int_t> & indices) const
+{
+  indices.clear();
+
+  if ( !fList ) return ;
+
+  // Margin on the window, protects against rounding at the cell edges
+  const Float_t window = r + 1e-3 ;
+
+  if ( !bands )
+  {
+    // Cone, phi wraps around 2pi
+    fGrid.FindCandidates(etaC, phiC, window, window, indices);
+    return ;
+  }
+
+  // Phi band, candidate eta range and all phi, contains the cone
+  fGrid.FindCandidates(etaC, phiC, window, TMath::Pi(), indices);
+
+  // Eta band, candidate phi range and all eta
+  fGrid.FindCandidates(etaC, phiC, 1e6, window, fCandidates);
+
+  Int_t nPhiBand = indices.size() ;
+  indices.insert(indices.end(), fCandidates.begin(), fCandidates.end());
+  std::inplace_merge(indices.begin(), indices.begin() + nPhiBand, indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
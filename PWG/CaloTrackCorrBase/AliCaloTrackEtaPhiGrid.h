@@ -0,0 +1,91 @@
+#ifndef ALICALOTRACKETAPHIGRID_H
+#define ALICALOTRACKETAPHIGRID_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliCaloTrackEtaPhiGrid
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Per event packed kinematics and eta-phi cell index of a list of tracks or clusters
+///
+/// The pT, eta and phi of the tracks or clusters of one of the lists filled by
+/// AliCaloTrackReader (CTS, EMCAL, DCAL or PHOS) are calculated once per event
+/// and stored in flat arrays, together with an index of the entries in
+/// eta-phi cells. It allows to find the particles in a cone, or in the eta and phi
+/// bands around it, without looping over the full list. The values are calculated
+/// exactly as in AliIsolationCut, phi is in [0, 2pi[. The eta-phi cells are
+/// a PWG::EMCAL::AliEmcalEtaPhiGrid, the grid used by the EMCal cluster-track matchers.
+///
+/// The grids are owned by the reader, retrieved with AliCaloTrackReader::GetEtaPhiGrid(),
+/// and reset when the lists are reset.
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+class TObjArray ;
+
+// --- C++ ---
+#include <vector>
+
+// --- AliRoot system ---
+#include "AliEmcalEtaPhiGrid.h"
+
+// --- ANALYSIS system ---
+class AliCaloTrackReader ;
+
+class AliCaloTrackEtaPhiGrid : public TObject {
+
+ public:
+
+  AliCaloTrackEtaPhiGrid(Float_t cellSize = 0.1) ;
+
+  /// Virtual destructor.
+  virtual ~AliCaloTrackEtaPhiGrid() { ; }
+
+  void       Fill(const TObjArray * list, AliCaloTrackReader * reader) ;
+
+  /// Invalidate the content, to be called when the list is reset.
+  void       Reset()                                 { fList = 0x0 ; fNEntries = 0 ; }
+
+  /// \return True if the grid was filled for the current content of the list.
+  Bool_t     IsFilledFor(const TObjArray * list) const ;
+
+  void       GetEntriesAround(Float_t etaC, Float_t phiC, Float_t r, Bool_t bands,
+                              std::vector<Int_t> & indices) const ;
+
+  Int_t      GetNEntries()                     const { return fNEntries      ; }
+  Bool_t     IsValid(Int_t i)                  const { return fValid[i]      ; }
+  Float_t    GetPt (Int_t i)                   const { return fPt [i]        ; }
+  Float_t    GetEta(Int_t i)                   const { return fEta[i]        ; }
+  Float_t    GetPhi(Int_t i)                   const { return fPhi[i]        ; }
+
+  Float_t    GetCellSize()                     const { return fCellSize      ; }
+  void       SetCellSize(Float_t size)               { fCellSize = size ; Reset() ; }
+
+ private:
+
+  Float_t    fCellSize ;                     ///<  Size of the cells in eta and phi (rad)
+
+  const TObjArray * fList ;                  //!<! List the grid was filled for
+  Int_t      fNEntries ;                     //!<! Number of entries of the list
+  std::vector<Bool_t>  fValid ;              //!<! Entry is a track, a cluster or a mixed event particle
+  std::vector<Float_t> fPt ;                 //!<! pT of the entries
+  std::vector<Float_t> fEta ;                //!<! Pseudorapidity of the entries
+  std::vector<Float_t> fPhi ;                //!<! Azimuthal angle of the entries, in [0, 2pi[
+
+  PWG::EMCAL::AliEmcalEtaPhiGrid fGrid ;     //!<! Eta-phi cells of the valid entries
+  mutable std::vector<Int_t> fCandidates ;   //!<! Entries of the eta band, merged with the phi band
+
+  /// Copy constructor not implemented.
+  AliCaloTrackEtaPhiGrid(              const AliCaloTrackEtaPhiGrid & g) ;
+
+  /// Assignment operator not implemented.
+  AliCaloTrackEtaPhiGrid & operator = (const AliCaloTrackEtaPhiGrid & g) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliCaloTrackEtaPhiGrid,2) ;
+  /// \endcond
+
+} ;
+
+#endif //ALICALOTRACKETAPHIGRID_H
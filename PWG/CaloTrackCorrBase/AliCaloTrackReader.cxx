@@ -43,6 +43,7 @@
 
 // ---- CaloTrackCorr ---
 #include "AliCalorimeterUtils.h"
+#include "AliCaloTrackEtaPhiGrid.h"
 #include "AliCaloTrackReader.h"
 #include "AliMCAnalysisUtils.h"
 
@@ -139,7 +140,10 @@ fhEMCALClusterEtaPhi(0),     fhEMCALClusterEtaPhiFidCut(0),
 fhEMCALClusterTimeE(0),
 fEnergyHistogramNbins(0),
 fhNEventsAfterCut(0),        fNMCGenerToAccept(0),            fMCGenerEventHeaderToAccept(""),
-fGenEventHeader(0),          fGenPythiaEventHeader(0)
+fGenEventHeader(0),          fGenPythiaEventHeader(0),
+fUseEtaPhiGrid(kFALSE),      fEtaPhiGridCellSize(0.1),
+fCTSEtaPhiGrid(0x0),         fEMCALEtaPhiGrid(0x0),
+fDCALEtaPhiGrid(0x0),        fPHOSEtaPhiGrid(0x0)
 {
   for(Int_t i = 0; i < 8; i++) fhEMCALClusterCutsE [i]= 0x0 ;    
   for(Int_t i = 0; i < 7; i++) fhPHOSClusterCutsE  [i]= 0x0 ;  
@@ -226,6 +230,11 @@ void AliCaloTrackReader::DeletePointers()
     
   if ( fMCUtils     ) delete fMCUtils ; 
 
+  delete fCTSEtaPhiGrid   ; fCTSEtaPhiGrid   = 0x0 ;
+  delete fEMCALEtaPhiGrid ; fEMCALEtaPhiGrid = 0x0 ;
+  delete fDCALEtaPhiGrid  ; fDCALEtaPhiGrid  = 0x0 ;
+  delete fPHOSEtaPhiGrid  ; fPHOSEtaPhiGrid  = 0x0 ;
+
   //  Pointers not owned, done by the analysis frame
   //  if(fInputEvent)  delete fInputEvent ;
   //  if(fOutputEvent) delete fOutputEvent ;
@@ -3281,6 +3290,36 @@ void AliCaloTrackReader::ResetLists()
   
   if(fNonStandardJets) fNonStandardJets -> Clear("C");
   fBackgroundJets->Reset();
+  
+  if(fCTSEtaPhiGrid)   fCTSEtaPhiGrid   -> Reset();
+  if(fEMCALEtaPhiGrid) fEMCALEtaPhiGrid -> Reset();
+  if(fDCALEtaPhiGrid)  fDCALEtaPhiGrid  -> Reset();
+  if(fPHOSEtaPhiGrid)  fPHOSEtaPhiGrid  -> Reset();
+}
+
+//___________________________________________________________________
+/// Get the eta-phi index of one of the lists of tracks or clusters
+/// filled by the reader. The index is built at the first request in
+/// the event and shared by all the analyses using this reader.
+/// \param list: CTS, EMCAL, DCAL or PHOS list of the reader.
+/// \return The index, null if disabled or if the list is not one of the reader lists.
+//___________________________________________________________________
+AliCaloTrackEtaPhiGrid * AliCaloTrackReader::GetEtaPhiGrid(const TObjArray * list)
+{
+  if ( !fUseEtaPhiGrid || !list ) return 0x0 ;
+  
+  AliCaloTrackEtaPhiGrid ** grid = 0x0 ;
+  if      ( list == fCTSTracks     ) grid = &fCTSEtaPhiGrid   ;
+  else if ( list == fEMCALClusters ) grid = &fEMCALEtaPhiGrid ;
+  else if ( list == fDCALClusters  ) grid = &fDCALEtaPhiGrid  ;
+  else if ( list == fPHOSClusters  ) grid = &fPHOSEtaPhiGrid  ;
+  else return 0x0 ;
+  
+  if ( !(*grid) ) *grid = new AliCaloTrackEtaPhiGrid(fEtaPhiGridCellSize) ;
+  
+  if ( !(*grid)->IsFilledFor(list) ) (*grid)->Fill(list, this) ;
+  
+  return *grid ;
 }
 
 //___________________________________________
@@ -52,6 +52,7 @@ class AliVCluster;
 // --- CaloTrackCorr / EMCAL ---
 #include "AliFiducialCut.h"
 class AliCalorimeterUtils;
+class AliCaloTrackEtaPhiGrid;
 #include "AliAnaWeights.h"
 #include "AliMCAnalysisUtils.h"
 
@@ -310,6 +311,16 @@ public:
   virtual TObjArray*     GetPHOSClusters()           const { return fPHOSClusters           ; }
   virtual AliVCaloCells* GetEMCALCells()             const { return fEMCALCells             ; }
   virtual AliVCaloCells* GetPHOSCells()              const { return fPHOSCells              ; }
+
+  // Per event eta-phi index of the tracks/clusters lists, for cone searches
+  
+  AliCaloTrackEtaPhiGrid * GetEtaPhiGrid(const TObjArray * list) ;
+  
+  void             SwitchOnEtaPhiGrid()                    { fUseEtaPhiGrid = kTRUE         ; }
+  void             SwitchOffEtaPhiGrid()                   { fUseEtaPhiGrid = kFALSE        ; }
+  Bool_t           IsEtaPhiGridUsed()                const { return fUseEtaPhiGrid          ; }
+  void             SetEtaPhiGridCellSize(Float_t size)     { fEtaPhiGridCellSize = size     ; }
+  Float_t          GetEtaPhiGridCellSize()           const { return fEtaPhiGridCellSize     ; }
   
   //-------------------------------------
   // Event/track selection methods
@@ -1014,6 +1025,14 @@ public:
   AliGenEventHeader       * fGenEventHeader;       //!<! Event header
   AliGenPythiaEventHeader * fGenPythiaEventHeader; //!<! Event header casted to pythia
   
+  // Eta-phi index of the lists
+  Bool_t           fUseEtaPhiGrid;                 ///<  Publish the eta-phi index of the lists, used in cone searches
+  Float_t          fEtaPhiGridCellSize;            ///<  Size of the eta-phi index cells
+  AliCaloTrackEtaPhiGrid * fCTSEtaPhiGrid;         //!<! Eta-phi index of the CTS tracks list
+  AliCaloTrackEtaPhiGrid * fEMCALEtaPhiGrid;       //!<! Eta-phi index of the EMCAL clusters list
+  AliCaloTrackEtaPhiGrid * fDCALEtaPhiGrid;        //!<! Eta-phi index of the DCAL clusters list
+  AliCaloTrackEtaPhiGrid * fPHOSEtaPhiGrid;        //!<! Eta-phi index of the PHOS clusters list
+  
   /// Copy constructor not implemented.
   AliCaloTrackReader(              const AliCaloTrackReader & r) ; 
   
@@ -1021,7 +1040,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,81) ;
+  ClassDef(AliCaloTrackReader,82) ;
   /// \endcond
 
 } ;
@@ -27,6 +27,7 @@
 
 // --- CaloTrackCorrelations --- 
 #include "AliCaloTrackReader.h"
+#include "AliCaloTrackEtaPhiGrid.h"
 #include "AliCalorimeterUtils.h"
 #include "AliCaloPID.h"
 #include "AliFiducialCut.h"
@@ -54,7 +55,8 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fEntriesAround()
 {
   InitParameters();
 }
@@ -457,6 +459,11 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   Int_t       ntrackrefs   = 0;
   Int_t       nclusterrefs = 0;
   
+  // If the lists are the ones of the reader, only check the tracks/clusters
+  // around the candidate, found with the eta-phi index published by the reader.
+  // The eta and phi bands are only needed for the UE subtraction.
+  Bool_t bands = ( fICMethod == kSumBkgSubIC );
+  
   // --------------------------------
   // Check charged tracks in cone.
   // --------------------------------
@@ -464,8 +471,14 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   if(plCTS &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
-    for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+    AliCaloTrackEtaPhiGrid * grid = reader->GetEtaPhiGrid(plCTS);
+    if ( grid ) grid->GetEntriesAround(etaC, phiC, fConeSize, bands, fEntriesAround);
+    
+    Int_t nentries = grid ? fEntriesAround.size() : plCTS->GetEntries();
+    for(Int_t ientry = 0;ientry < nentries ; ientry ++ )
     {
+      Int_t ipr = grid ? fEntriesAround[ientry] : ientry;
+      
       AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
       
       if(track)
@@ -486,10 +499,19 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
           if ( contained ) continue ;
         }
         
-        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
-        pt  = fTrackVector.Pt();
-        eta = fTrackVector.Eta();
-        phi = fTrackVector.Phi() ;
+        if ( grid )
+        {
+          pt  = grid->GetPt (ipr);
+          eta = grid->GetEta(ipr);
+          phi = grid->GetPhi(ipr);
+        }
+        else
+        {
+          fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+          pt  = fTrackVector.Pt();
+          eta = fTrackVector.Eta();
+          phi = fTrackVector.Phi() ;
+        }
       }
       else
       {// Mixed event stored in AliCaloTrackParticles
@@ -610,18 +632,18 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
     
-    for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+    AliCaloTrackEtaPhiGrid * grid = reader->GetEtaPhiGrid(plNe);
+    if ( grid ) grid->GetEntriesAround(etaC, phiC, fConeSize, bands, fEntriesAround);
+    
+    Int_t nentries = grid ? fEntriesAround.size() : plNe->GetEntries();
+    for(Int_t ientry = 0;ientry < nentries ; ientry ++ )
     {
+      Int_t ipr = grid ? fEntriesAround[ientry] : ientry;
+      
       AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
       
       if(calo)
       {
-        // Get the index where the cluster comes, to retrieve the corresponding vertex
-        Int_t evtIndex = 0 ;
-        if (reader->GetMixedEvent())
-          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
-        
-        
         // Do not count the candidate (photon or pi0) or the daughters of the candidate
         if(calo->GetID() == pCandidate->GetCaloLabel(0) ||
            calo->GetID() == pCandidate->GetCaloLabel(1)   ) continue ;
@@ -633,12 +655,26 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
              pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
         }
         
-        // Assume that come from vertex in straight line
-        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
-        
-        pt  = fMomentum.Pt()  ;
-        eta = fMomentum.Eta() ;
-        phi = fMomentum.Phi() ;
+        if ( grid )
+        {
+          pt  = grid->GetPt (ipr);
+          eta = grid->GetEta(ipr);
+          phi = grid->GetPhi(ipr);
+        }
+        else
+        {
+          // Get the index where the cluster comes, to retrieve the corresponding vertex
+          Int_t evtIndex = 0 ;
+          if (reader->GetMixedEvent())
+            evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+          
+          // Assume that come from vertex in straight line
+          calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+          
+          pt  = fMomentum.Pt()  ;
+          eta = fMomentum.Eta() ;
+          phi = fMomentum.Phi() ;
+        }
       }
       else
       {// Mixed event stored in AliCaloTrackParticles
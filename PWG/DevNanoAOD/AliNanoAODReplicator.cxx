@@ -103,6 +103,9 @@ AliAODBranchReplicator(),
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fTrackColumnsResolved(kFALSE),
+  fTrackColumnIndex(),
+  fTrackColumnVar(),
   fVarListHeader_fTC(""){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file
   }
@@ -134,6 +137,9 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fTrackColumnsResolved(kFALSE),
+  fTrackColumnIndex(),
+  fTrackColumnVar(),
   fVarListHeader_fTC("")
 {
   // default ctor
@@ -521,6 +527,12 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
 
   if(entries<=0) return;
 
+  // The variables copied from the AOD tracks are resolved once
+  if(!fTrackColumnsResolved){
+    AliNanoAODTrack::GetAODColumns(fVarList, fTrackColumnIndex, fTrackColumnVar);
+    fTrackColumnsResolved = kTRUE;
+  }
+
   for(Int_t j=0; j<entries; j++){
     AliVTrack *track = 0x0;
     if (particleArray) track = (AliVTrack*)particleArray->At(j);
@@ -529,7 +541,9 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
     AliAODTrack *aodtrack =(AliAODTrack*)track;// FIXME DYNAMIC CAST?
     if(fTrackCut && !fTrackCut->IsSelected(aodtrack)) continue;
 
-    AliNanoAODTrack * special = new((*fTracks)[ntracks++]) AliNanoAODTrack (aodtrack, fVarList);
+    // Reuse the tracks of the previous events, only their storage is refilled
+    AliNanoAODTrack * special = static_cast<AliNanoAODTrack*>(fTracks->ConstructedAt(ntracks++));
+    special->SetAODVariables(aodtrack, fTrackColumnIndex, fTrackColumnVar);
 
     if(fCustomSetter) fCustomSetter->SetNanoAODTrack(aodtrack, special);
   }  
@@ -15,6 +15,7 @@
 #endif
 
 #include <iostream>
+#include <vector>
 
 /* #ifndef AliAOD3LH_H */
 /* #include "AliAOD3LH.h" */
@@ -146,13 +147,17 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   TString fInputArrayName; // name of array if tracks are stored in a TObjectArray
   TString fOutputArrayName; // name of the output array, where the NanoAODTracks are stored
+
+  Bool_t fTrackColumnsResolved; //! kTRUE once the track columns are resolved from fVarList
+  std::vector<Int_t> fTrackColumnIndex; //! storage index of each AOD track variable copied
+  std::vector<Int_t> fTrackColumnVar; //! AOD track variable of each column, see AliNanoAODTrack::EAODVar_t
  private:
 
 
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
 
-  ClassDef(AliNanoAODReplicator,4) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,5) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
@@ -20,6 +20,7 @@
 //     michele.floris@cern.ch
 //-------------------------------------------------------------------------
 
+#include <algorithm>
 #include <TVector3.h>
 #include "AliLog.h"
 #include "AliExternalTrackParam.h"
@@ -66,76 +67,157 @@ AliNanoAODTrack::AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars) :
   fAODEvent(NULL)
 {
   // constructor
+  std::vector<Int_t> index, var;
+  GetAODColumns(vars, index, var);
+  SetAODVariables(aodTrack, index, var);
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrack::GetAODColumns(const char * vars, std::vector<Int_t> & index, std::vector<Int_t> & var)
+{
+  // Resolve the variables of the mapping copied from the AOD track: for
+  // each column, the index in the storage and the AOD variable (EAODVar_t).
+  // Custom variables are not columns, they are left to the custom setter.
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance(vars);
+
+  index.clear();
+  var.clear();
+  for (Int_t ivar = 0; ivar<mapping->GetSize(); ivar++) {
+    TString varString = mapping->GetVarName(ivar);
+    Int_t varIndex = -1, varCode = -1;
+
+    if     (varString == "pt"                     ) { varIndex = mapping->GetPt()               ; varCode = kAODVarPt               ; }
+    else if(varString == "phi"                    ) { varIndex = mapping->GetPhi()              ; varCode = kAODVarPhi              ; }
+    else if(varString == "theta"                  ) { varIndex = mapping->GetTheta()            ; varCode = kAODVarTheta            ; }
+    else if(varString == "chi2perNDF"             ) { varIndex = mapping->GetChi2PerNDF()       ; varCode = kAODVarChi2PerNDF       ; }
+    else if(varString == "posx"                   ) { varIndex = mapping->GetPosX()             ; varCode = kAODVarPosX             ; }
+    else if(varString == "posy"                   ) { varIndex = mapping->GetPosY()             ; varCode = kAODVarPosY             ; }
+    else if(varString == "posz"                   ) { varIndex = mapping->GetPosZ()             ; varCode = kAODVarPosZ             ; }
+    else if(varString == "posDCAx"                ) { varIndex = mapping->GetPosDCAx()          ; varCode = kAODVarPosDCAx          ; }
+    else if(varString == "posDCAy"                ) { varIndex = mapping->GetPosDCAy()          ; varCode = kAODVarPosDCAy          ; }
+    else if(varString == "pDCAx"                  ) { varIndex = mapping->GetPDCAX()            ; varCode = kAODVarPDCAx            ; }
+    else if(varString == "pDCAy"                  ) { varIndex = mapping->GetPDCAY()            ; varCode = kAODVarPDCAy            ; }
+    else if(varString == "pDCAz"                  ) { varIndex = mapping->GetPDCAZ()            ; varCode = kAODVarPDCAz            ; }
+    else if(varString == "RAtAbsorberEnd"         ) { varIndex = mapping->GetRAtAbsorberEnd()   ; varCode = kAODVarRAtAbsorberEnd   ; }
+    else if(varString == "TPCncls"                ) { varIndex = mapping->GetTPCncls()          ; varCode = kAODVarTPCncls          ; }
+    else if(varString == "id"                     ) { varIndex = mapping->Getid()               ; varCode = kAODVarID               ; }
+    else if(varString == "TPCnclsF"               ) { varIndex = mapping->GetTPCnclsF()         ; varCode = kAODVarTPCnclsF         ; }
+    else if(varString == "TPCNCrossedRows"        ) { varIndex = mapping->GetTPCNCrossedRows()  ; varCode = kAODVarTPCNCrossedRows  ; }
+    else if(varString == "TrackPhiOnEMCal"        ) { varIndex = mapping->GetTrackPhiOnEMCal()  ; varCode = kAODVarTrackPhiOnEMCal  ; }
+    else if(varString == "TrackEtaOnEMCal"        ) { varIndex = mapping->GetTrackEtaOnEMCal()  ; varCode = kAODVarTrackEtaOnEMCal  ; }
+    else if(varString == "TrackPtOnEMCal"         ) { varIndex = mapping->GetTrackPtOnEMCal()   ; varCode = kAODVarTrackPtOnEMCal   ; }
+    else if(varString == "ITSsignal"              ) { varIndex = mapping->GetITSsignal()        ; varCode = kAODVarITSsignal        ; }
+    else if(varString == "TPCsignal"              ) { varIndex = mapping->GetTPCsignal()        ; varCode = kAODVarTPCsignal        ; }
+    else if(varString == "TPCsignalTuned"         ) { varIndex = mapping->GetTPCsignalTuned()   ; varCode = kAODVarTPCsignalTuned   ; }
+    else if(varString == "TPCsignalN"             ) { varIndex = mapping->GetTPCsignalN()       ; varCode = kAODVarTPCsignalN       ; }
+    else if(varString == "TPCmomentum"            ) { varIndex = mapping->GetTPCmomentum()      ; varCode = kAODVarTPCmomentum      ; }
+    else if(varString == "TPCTgl"                 ) { varIndex = mapping->GetTPCTgl()           ; varCode = kAODVarTPCTgl           ; }
+    else if(varString == "TOFsignal"              ) { varIndex = mapping->GetTOFsignal()        ; varCode = kAODVarTOFsignal        ; }
+    else if(varString == "integratedLength"       ) { varIndex = mapping->GetintegratedLenght() ; varCode = kAODVarIntegratedLength ; }
+    else if(varString == "TOFsignalTuned"         ) { varIndex = mapping->GetTOFsignalTuned()   ; varCode = kAODVarTOFsignalTuned   ; }
+    else if(varString == "HMPIDsignal"            ) { varIndex = mapping->GetHMPIDsignal()      ; varCode = kAODVarHMPIDsignal      ; }
+    else if(varString == "HMPIDoccupancy"         ) { varIndex = mapping->GetHMPIDoccupancy()   ; varCode = kAODVarHMPIDoccupancy   ; }
+    else if(varString == "TRDsignal"              ) { varIndex = mapping->GetTRDsignal()        ; varCode = kAODVarTRDsignal        ; }
+    else if(varString == "TRDChi2"                ) { varIndex = mapping->GetTRDChi2()          ; varCode = kAODVarTRDChi2          ; }
+    else if(varString == "TRDnSlices"             ) { varIndex = mapping->GetTRDnSlices()       ; varCode = kAODVarTRDnSlices       ; }
+    else if(varString == "IsMuonTrack"            ) { varIndex = mapping->GetIsMuonTrack()      ; varCode = kAODVarIsMuonTrack      ; }
+    else if(varString == "TPCnclsS"               ) { varIndex = mapping->GetTPCnclsS()         ; varCode = kAODVarTPCnclsS         ; }
+    else if(varString == "FilterMap"              ) { varIndex = mapping->GetFilterMap()        ; varCode = kAODVarFilterMap        ; }
+    else if(varString == "covmat0"                ) {
+      for(Int_t i=0;i<21;i++){
+        index.push_back(mapping->GetCovMat(i));
+        var.push_back(kAODVarCovMat+i);
+      }
+      ivar+=20;
+    }
+
+    if (varCode >= 0) {
+      index.push_back(varIndex);
+      var.push_back(varCode);
+    }
+  }
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrack::SetAODVariables(AliAODTrack * aodTrack, const std::vector<Int_t> & index, const std::vector<Int_t> & var)
+{
+  // Fill the track from an AOD track with the columns of GetAODColumns().
+  // The storage is reused if already allocated, so the track can be filled
+  // again in place, e.g. in a TClonesArray cleared with option "C".
 
   Double_t position[3];
   Bool_t isPosAvailable = !(aodTrack->GetXYZ(position)); // GetXYZ() returns kTRUE, if it's DCA information
-  AliNanoAODTrackMapping::GetInstance(vars);
+  Double_t covMatrix[21];
+  Bool_t isCovMatrixRead = kFALSE;
 
-  // Create internal structure
+  // Create internal structure, variables not filled are 0
   AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
-
-  for (Int_t index = 0; index<AliNanoAODTrackMapping::GetInstance()->GetSize(); index++) {
-    TString varString = AliNanoAODTrackMapping::GetInstance()->GetVarName(index);
-
-    if     (varString == "pt"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()               , aodTrack->Pt()                      );
-    else if(varString == "phi"                    ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi()              , aodTrack->Phi()                     );
-    else if(varString == "theta"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()            , aodTrack->Theta()                   );
-    else if(varString == "chi2perNDF"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()       , aodTrack->Chi2perNDF()              );  
-    else if(varString == "posx" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()             , position[0]                         );
-    else if(varString == "posy" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()             , position[1]                         );
-    else if(varString == "posz" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ()             , position[2]                         );
-    else if(varString == "posDCAx"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()          , aodTrack->XAtDCA()                  );
-    else if(varString == "posDCAy"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()          , aodTrack->YAtDCA()                  );
-    else if(varString == "pDCAx"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAX()            , aodTrack->PxAtDCA()                 );
-    else if(varString == "pDCAy"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAY()            , aodTrack->PyAtDCA()                 );
-    else if(varString == "pDCAz"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()            , aodTrack->PzAtDCA()                 );
-    else if(varString == "RAtAbsorberEnd"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()   , aodTrack->GetRAtAbsorberEnd()       );
-    else if(varString == "TPCncls"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCncls()          , aodTrack->GetTPCNcls()              );
-    else if(varString == "id"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->Getid()               , aodTrack->GetID()                   );
-    else if(varString == "TPCnclsF"               ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF()         , aodTrack->GetTPCNclsF()             );
-    else if(varString == "TPCNCrossedRows"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows()  , aodTrack->GetTPCNCrossedRows()      );
-    else if(varString == "TrackPhiOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal()  , aodTrack->GetTrackPhiOnEMCal()      );
-    else if(varString == "TrackEtaOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal()  , aodTrack->GetTrackEtaOnEMCal()      );
-    else if(varString == "TrackPtOnEMCal"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal()   , aodTrack->GetTrackPtOnEMCal()       );
-    else if(varString == "ITSsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetITSsignal()        , aodTrack->GetITSsignal()            );
-    else if(varString == "TPCsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignal()        , aodTrack->GetTPCsignal()            );
-    else if(varString == "TPCsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned()   , aodTrack->GetTPCsignalTunedOnData() );
-    else if(varString == "TPCsignalN"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalN()       , aodTrack->GetTPCsignalN()           );
-    else if(varString == "TPCmomentum"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCmomentum()      , aodTrack->GetTPCmomentum()          );
-    else if(varString == "TPCTgl"                 ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCTgl()           , aodTrack->GetTPCTgl()               );
-    else if(varString == "TOFsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignal()        , aodTrack->GetTOFsignal()            );
-    else if(varString == "integratedLength"       ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetintegratedLenght() , aodTrack->GetIntegratedLength()     );
-    else if(varString == "TOFsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned()   , aodTrack->GetTOFsignalTunedOnData() );
-    else if(varString == "HMPIDsignal"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDsignal()      , aodTrack->GetHMPIDsignal()          );
-    else if(varString == "HMPIDoccupancy"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDoccupancy()   , aodTrack->GetHMPIDoccupancy()       );
-    else if(varString == "TRDsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDsignal()        , aodTrack->GetTRDsignal()            );
-    else if(varString == "TRDChi2"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDChi2()          , aodTrack->GetTRDchi2()              );
-    else if(varString == "TRDnSlices"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDnSlices()       , aodTrack->GetNumberOfTRDslices()    );  
-    else if(varString == "IsMuonTrack"             ) {
-        if (aodTrack->IsMuonTrack()) SetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack(), 1.);
-        else SetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack(), 0.);
-    }
-    else if(varString == "TPCnclsS"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsS()         , aodTrack->GetTPCnclsS()             );
-    else if(varString == "FilterMap"               ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetFilterMap()        , aodTrack->GetFilterMap()            );
-    else if(varString == "covmat0"                 ) {
-        Double_t covMatrix[21];
+  std::fill(fVars.begin(), fVars.end(), 0.);
+
+  const Int_t ncolumns = var.size();
+  for (Int_t icol = 0; icol<ncolumns; icol++) {
+    Double_t value = 0;
+    switch (var[icol]) {
+    case kAODVarPt               : value = aodTrack->Pt()                      ; break;
+    case kAODVarPhi              : value = aodTrack->Phi()                     ; break;
+    case kAODVarTheta            : value = aodTrack->Theta()                   ; break;
+    case kAODVarChi2PerNDF       : value = aodTrack->Chi2perNDF()              ; break;
+    case kAODVarPosX             : if (!isPosAvailable) continue; value = position[0]; break;
+    case kAODVarPosY             : if (!isPosAvailable) continue; value = position[1]; break;
+    case kAODVarPosZ             : if (!isPosAvailable) continue; value = position[2]; break;
+    case kAODVarPosDCAx          : value = aodTrack->XAtDCA()                  ; break;
+    case kAODVarPosDCAy          : value = aodTrack->YAtDCA()                  ; break;
+    case kAODVarPDCAx            : value = aodTrack->PxAtDCA()                 ; break;
+    case kAODVarPDCAy            : value = aodTrack->PyAtDCA()                 ; break;
+    case kAODVarPDCAz            : value = aodTrack->PzAtDCA()                 ; break;
+    case kAODVarRAtAbsorberEnd   : value = aodTrack->GetRAtAbsorberEnd()       ; break;
+    case kAODVarTPCncls          : value = aodTrack->GetTPCNcls()              ; break;
+    case kAODVarID               : value = aodTrack->GetID()                   ; break;
+    case kAODVarTPCnclsF         : value = aodTrack->GetTPCNclsF()             ; break;
+    case kAODVarTPCNCrossedRows  : value = aodTrack->GetTPCNCrossedRows()      ; break;
+    case kAODVarTrackPhiOnEMCal  : value = aodTrack->GetTrackPhiOnEMCal()      ; break;
+    case kAODVarTrackEtaOnEMCal  : value = aodTrack->GetTrackEtaOnEMCal()      ; break;
+    case kAODVarTrackPtOnEMCal   : value = aodTrack->GetTrackPtOnEMCal()       ; break;
+    case kAODVarITSsignal        : value = aodTrack->GetITSsignal()            ; break;
+    case kAODVarTPCsignal        : value = aodTrack->GetTPCsignal()            ; break;
+    case kAODVarTPCsignalTuned   : value = aodTrack->GetTPCsignalTunedOnData() ; break;
+    case kAODVarTPCsignalN       : value = aodTrack->GetTPCsignalN()           ; break;
+    case kAODVarTPCmomentum      : value = aodTrack->GetTPCmomentum()          ; break;
+    case kAODVarTPCTgl           : value = aodTrack->GetTPCTgl()               ; break;
+    case kAODVarTOFsignal        : value = aodTrack->GetTOFsignal()            ; break;
+    case kAODVarIntegratedLength : value = aodTrack->GetIntegratedLength()     ; break;
+    case kAODVarTOFsignalTuned   : value = aodTrack->GetTOFsignalTunedOnData() ; break;
+    case kAODVarHMPIDsignal      : value = aodTrack->GetHMPIDsignal()          ; break;
+    case kAODVarHMPIDoccupancy   : value = aodTrack->GetHMPIDoccupancy()       ; break;
+    case kAODVarTRDsignal        : value = aodTrack->GetTRDsignal()            ; break;
+    case kAODVarTRDChi2          : value = aodTrack->GetTRDchi2()              ; break;
+    case kAODVarTRDnSlices       : value = aodTrack->GetNumberOfTRDslices()    ; break;
+    case kAODVarIsMuonTrack      : value = aodTrack->IsMuonTrack() ? 1. : 0.   ; break;
+    case kAODVarTPCnclsS         : value = aodTrack->GetTPCnclsS()             ; break;
+    case kAODVarFilterMap        : value = aodTrack->GetFilterMap()            ; break;
+    default:
+      // Covariance matrix, read once for all its elements
+      if (!isCovMatrixRead) {
         aodTrack->GetCovarianceXYZPxPyPz(covMatrix);
-        for(Int_t i=0;i<21;i++){
-            SetVar(AliNanoAODTrackMapping::GetInstance()->GetCovMat(i)       , covMatrix[i]                        );
-        }
-        index+=20;
+        isCovMatrixRead = kTRUE;
+      }
+      value = covMatrix[var[icol]-kAODVarCovMat];
     }
+    SetVar(index[icol], value);
   }
 
-
   fLabel = aodTrack->GetLabel();
   fCharge = aodTrack->Charge();
   fProdVertex = aodTrack->GetProdVertex();
+  fAODEvent = NULL;
+  // Status bits left by a previous fill of the track
+  ResetBit(AliAODTrack::kIsDCA | AliAODTrack::kUsedForVtxFit | AliAODTrack::kUsedForPrimVtxFit |
+           AliAODTrack::kIsTPCConstrained | AliAODTrack::kIsHybridTPCCG |
+           AliAODTrack::kIsGlobalConstrained | AliAODTrack::kIsHybridGCG);
   // SetUsedForVtxFit(usedForVtxFit);// FIXME: what is this
   // SetUsedForPrimVtxFit(usedForPrimVtxFit);// FIXME: what is this
   // //  if(covMatrix) SetCovMatrix(covMatrix);// FIXME: 
   // for (Int_t i=0;i<3;i++) {fTOFLabel[i]=-1;}
-
 }
 
 //______________________________________________________________________________
@@ -203,8 +285,13 @@ AliNanoAODTrack::AliNanoAODTrack(const AliNanoAODTrack& trk) :
   // std::cout << "Copy Ctor" << std::endl;
   
   AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
-  for (Int_t isize = 0; isize<AliNanoAODTrackMapping::GetInstance()->GetSize(); isize++) {
-    SetVar(isize, trk.GetVar(isize));    
+  if (trk.fVars.size() >= fVars.size()) {
+    // Same mapping, copy the storage as one block
+    std::copy(trk.fVars.begin(), trk.fVars.begin() + fVars.size(), fVars.begin());
+  } else {
+    for (Int_t isize = 0; isize<AliNanoAODTrackMapping::GetInstance()->GetSize(); isize++) {
+      SetVar(isize, trk.GetVar(isize));    
+    }
   }
 
 
@@ -71,7 +71,22 @@ class AliNanoAODTrack : public AliVTrack, public AliNanoAODStorage {
 public:
   
   using TObject::ClassName;
-  
+
+  // Variables copied from the AOD track, see GetAODColumns(). The 21
+  // elements of the covariance matrix follow kAODVarCovMat.
+  enum EAODVar_t {
+    kAODVarPt = 0, kAODVarPhi, kAODVarTheta, kAODVarChi2PerNDF,
+    kAODVarPosX, kAODVarPosY, kAODVarPosZ, kAODVarPosDCAx, kAODVarPosDCAy,
+    kAODVarPDCAx, kAODVarPDCAy, kAODVarPDCAz, kAODVarRAtAbsorberEnd,
+    kAODVarTPCncls, kAODVarID, kAODVarTPCnclsF, kAODVarTPCNCrossedRows,
+    kAODVarTrackPhiOnEMCal, kAODVarTrackEtaOnEMCal, kAODVarTrackPtOnEMCal,
+    kAODVarITSsignal, kAODVarTPCsignal, kAODVarTPCsignalTuned, kAODVarTPCsignalN,
+    kAODVarTPCmomentum, kAODVarTPCTgl, kAODVarTOFsignal, kAODVarIntegratedLength,
+    kAODVarTOFsignalTuned, kAODVarHMPIDsignal, kAODVarHMPIDoccupancy,
+    kAODVarTRDsignal, kAODVarTRDChi2, kAODVarTRDnSlices, kAODVarIsMuonTrack,
+    kAODVarTPCnclsS, kAODVarFilterMap, kAODVarCovMat
+  };
+
   AliNanoAODTrack();
   AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars);
   AliNanoAODTrack(AliESDTrack * esdTrack, const char * vars);
@@ -83,7 +98,12 @@ public:
 
 
   virtual void Clear(Option_t * opt) ;
-  
+
+  // Copy of the variables of an AOD track with the columns resolved once
+  // for a variable list, such that tracks can be refilled in place
+  static void GetAODColumns(const char * vars, std::vector<Int_t> & index, std::vector<Int_t> & var);
+  void SetAODVariables(AliAODTrack * aodTrack, const std::vector<Int_t> & index, const std::vector<Int_t> & var);
+
   // kinematics
   virtual Double_t OneOverPt() const { return (Pt() != 0.) ? 1./Pt() : -999.; }
   virtual Double_t Phi()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi());   }
@@ -26,6 +26,9 @@
 #include <TMath.h>
 #include <TRandom.h>
 #include <TChain.h>
+#include <TTree.h>
+#include <TBranch.h>
+#include <TEnv.h>
 #include <TGrid.h>
 #include <TGridResult.h>
 #include <TSystem.h>
@@ -167,7 +170,11 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fUseHeaderPreselection(true),
+  fTreeCacheSize(0),
+  fUseAsyncPrefetching(false),
+  fPreselectedEntries()
 {
   if (fgInstance != nullptr) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -239,7 +246,11 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fUseHeaderPreselection(true),
+  fTreeCacheSize(0),
+  fUseAsyncPrefetching(false),
+  fPreselectedEntries()
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -324,6 +335,9 @@ void AliAnalysisTaskEmcalEmbeddingHelper::RetrieveTaskPropertiesFromYAMLConfig()
   res = fYAMLConfig.GetProperty("randomFileAccess", fRandomFileAccess, false);
   res = fYAMLConfig.GetProperty("createHisto", fCreateHisto, false);
   res = fYAMLConfig.GetProperty("printTimingInfoInLog", fPrintTimingInfoToLog, false);
+  res = fYAMLConfig.GetProperty("useHeaderPreselection", fUseHeaderPreselection, false);
+  res = fYAMLConfig.GetProperty("treeCacheSize", fTreeCacheSize, false);
+  res = fYAMLConfig.GetProperty("asyncPrefetching", fUseAsyncPrefetching, false);
   // More general embedding helper properties
   res = fYAMLConfig.GetProperty("filePattern", fFilePattern, false);
   res = fYAMLConfig.GetProperty("inputFilename", fInputFilename, false);
@@ -817,6 +831,7 @@ void AliAnalysisTaskEmcalEmbeddingHelper::DetermineFirstFileToEmbed()
 Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
 {
   Int_t attempts = -1;
+  Bool_t selected = kFALSE;
 
   do {
     // Reset to start of tree
@@ -842,7 +857,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
     // Load current event
     // Can be a simple less than, because fFileNumber counts from 0.
     if (fFileNumber < fMaxNumberOfFiles) {
-      fChain->GetEntry(fCurrentEntry);
+      // Continue with GetEntry as normal
     }
     else {
       AliError("====================================================================================================");
@@ -856,16 +871,31 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
       fUpperEntry = 0;
 
       // Re-init back to the start
+      // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
       InitTree();
+    }
 
-      // Access the relevant entry
-      // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
-      fChain->GetEntry(fCurrentEntry);
+    // Entries rejected by the header pre-selection are not read at all.
+    // Only the properties needed for the bookkeeping are taken from the pre-selection.
+    const PreselectedEntry_t * preselectedEntry = nullptr;
+    Long64_t localEntry = fCurrentEntry - fLowerEntry;
+    if (static_cast<Long64_t>(fPreselectedEntries.size()) == fUpperEntry - fLowerEntry && localEntry >= 0 && localEntry < static_cast<Long64_t>(fPreselectedEntries.size())) {
+      preselectedEntry = &(fPreselectedEntries.at(localEntry));
     }
-    AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
 
-    // Set relevant event properties
-    SetEmbeddedEventProperties();
+    if (preselectedEntry && !preselectedEntry->fSelected) {
+      AliDebug(4, TString::Format("Skipping entry %i between %i-%i, rejected by the header pre-selection (%s)", fCurrentEntry, fLowerEntry, fUpperEntry, preselectedEntry->fRejectionReason.c_str()));
+      fPythiaTrials = preselectedEntry->fPythiaTrials;
+      fPythiaCrossSection = preselectedEntry->fPythiaCrossSection;
+      fPythiaPtHard = preselectedEntry->fPythiaPtHard;
+    }
+    else {
+      AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
+      fChain->GetEntry(fCurrentEntry);
+
+      // Set relevant event properties
+      SetEmbeddedEventProperties();
+    }
 
     // Increment current entry
     fCurrentEntry++;
@@ -880,7 +910,18 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
       RecordEmbeddedEventProperties();
     }
 
-  } while (!IsEventSelected());
+    if (preselectedEntry && !preselectedEntry->fSelected) {
+      if (fCreateHisto) {
+        fHistManager.FillTH1("fHistEmbeddedEventRejection", preselectedEntry->fRejectionReason.c_str(), 1);
+        fHistManager.FillTH1("fHistEventCount", "Rejected");
+      }
+      selected = kFALSE;
+    }
+    else {
+      selected = IsEventSelected();
+    }
+
+  } while (!selected);
 
   if (fCreateHisto) {
     fHistManager.FillTH1("fHistEventCount", "Accepted");
@@ -968,6 +1009,29 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::IsEventSelected()
  * @return kTRUE if the event successfully passes all criteria.
  */
 Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
+{
+  std::string rejectionReason = "";
+  if (CheckIsEmbeddedEventHeaderSelected(rejectionReason) && CheckIsEmbeddedEventVertexSelected(rejectionReason)) {
+    return kTRUE;
+  }
+
+  if (fCreateHisto) {
+    fHistManager.FillTH1("fHistEmbeddedEventRejection", rejectionReason.c_str(), 1);
+  }
+  return kFALSE;
+}
+
+/**
+ * Performs the part of the embedded event selection which only depends on the external event itself
+ * (pt hard, physics selection, z vertex and MC outliers). It only needs the header, the vertices and the
+ * MC header of the external event, such that it can be evaluated in BuildPreselectionIndex() before
+ * reading the full event.
+ *
+ * @param[out] rejectionReason Label of the rejection reason in fHistEmbeddedEventRejection if the event is rejected.
+ *
+ * @return kTRUE if the event successfully passes all criteria.
+ */
+Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventHeaderSelected(std::string & rejectionReason) const
 {
   // Check if pt hard bin is 0, indicating a problem with the event or the grid.
   // In such a case, the event should be rejected.
@@ -975,9 +1039,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
   // (pt hard should still be set even if the production wasn't done in pt hard bins).
   if (fPythiaPtHard == 0. && fPythiaHeader) {
     AliDebugStream(3) << "Event rejected due to pt hard = 0, indicating a problem with the external event.\n";
-    if (fCreateHisto) {
-      fHistManager.FillTH1("fHistEmbeddedEventRejection", "PtHardIs0", 1);
-    }
+    rejectionReason = "PtHardIs0";
     return kFALSE;
   }
 
@@ -1003,38 +1065,21 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
     if ((res & fTriggerMask) == 0) {
       AliDebug(3, Form("Event rejected due to physics selection. Event trigger mask: %d, trigger mask selection: %d.",
                       res, fTriggerMask));
-      if (fCreateHisto) {
-        fHistManager.FillTH1("fHistEmbeddedEventRejection", "PhysSel", 1);
-      }
+      rejectionReason = "PhysSel";
       return kFALSE;
     }
   }
 
-  // Vertex selection
-  Double_t externalVertex[3]={0};
-  Double_t inputVertex[3]={0};
+  // Z vertex selection
   const AliVVertex *externalVert = fExternalEvent->GetPrimaryVertex();
-  const AliVVertex *inputVert = AliAnalysisTaskSE::InputEvent()->GetPrimaryVertex();
-  if (externalVert && inputVert) {
+  if (externalVert) {
+    Double_t externalVertex[3]={0};
     externalVert->GetXYZ(externalVertex);
-    inputVert->GetXYZ(inputVertex);
 
     if (TMath::Abs(externalVertex[2]) > fZVertexCut) {
       AliDebug(3, Form("Event rejected due to Z vertex selection. Event Z vertex: %f, Z vertex cut: %f",
        externalVertex[2], fZVertexCut));
-      if (fCreateHisto) {
-        fHistManager.FillTH1("fHistEmbeddedEventRejection", "Vz", 1);
-      }
-      return kFALSE;
-    }
-    Double_t dist = TMath::Sqrt((externalVertex[0]-inputVertex[0])*(externalVertex[0]-inputVertex[0])+(externalVertex[1]-inputVertex[1])*(externalVertex[1]-inputVertex[1])+(externalVertex[2]-inputVertex[2])*(externalVertex[2]-inputVertex[2]));
-    if (dist > fMaxVertexDist) {
-      AliDebug(3, Form("Event rejected because the distance between the current and embedded vertices is > %f. "
-       "Current event vertex (%f, %f, %f), embedded event vertex (%f, %f, %f). Distance = %f",
-       fMaxVertexDist, inputVertex[0], inputVertex[1], inputVertex[2], externalVertex[0], externalVertex[1], externalVertex[2], dist));
-      if (fCreateHisto) {
-        fHistManager.FillTH1("fHistEmbeddedEventRejection", "VertexDist", 1);
-      }
+      rejectionReason = "Vz";
       return kFALSE;
     }
   }
@@ -1064,7 +1109,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
         //Compare jet pT and pt Hard
         if (jet.Pt() > fPtHardJetPtRejectionFactor * fPythiaPtHard) {
           AliDebugStream(3) << "Event rejected because of MC outlier removal. Pythia header jet with: pT Hard " << fPythiaPtHard << ", pycell jet pT " << jet.Pt() << ", rejection factor " << fPtHardJetPtRejectionFactor << "\n";
-          fHistManager.FillTH1("fHistEmbeddedEventRejection", "MCOutlier", 1);
+          rejectionReason = "MCOutlier";
           return kFALSE;
         }
       }
@@ -1074,6 +1119,38 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
   return kTRUE;
 }
 
+/**
+ * Performs the part of the embedded event selection which depends on the internal event, namely the
+ * distance between the internal and the external primary vertices. It can therefore not be part of
+ * the pre-selection.
+ *
+ * @param[out] rejectionReason Label of the rejection reason in fHistEmbeddedEventRejection if the event is rejected.
+ *
+ * @return kTRUE if the event successfully passes all criteria.
+ */
+Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventVertexSelected(std::string & rejectionReason) const
+{
+  Double_t externalVertex[3]={0};
+  Double_t inputVertex[3]={0};
+  const AliVVertex *externalVert = fExternalEvent->GetPrimaryVertex();
+  const AliVVertex *inputVert = AliAnalysisTaskSE::InputEvent()->GetPrimaryVertex();
+  if (externalVert && inputVert) {
+    externalVert->GetXYZ(externalVertex);
+    inputVert->GetXYZ(inputVertex);
+
+    Double_t dist = TMath::Sqrt((externalVertex[0]-inputVertex[0])*(externalVertex[0]-inputVertex[0])+(externalVertex[1]-inputVertex[1])*(externalVertex[1]-inputVertex[1])+(externalVertex[2]-inputVertex[2])*(externalVertex[2]-inputVertex[2]));
+    if (dist > fMaxVertexDist) {
+      AliDebug(3, Form("Event rejected because the distance between the current and embedded vertices is > %f. "
+       "Current event vertex (%f, %f, %f), embedded event vertex (%f, %f, %f). Distance = %f",
+       fMaxVertexDist, inputVertex[0], inputVertex[1], inputVertex[2], externalVertex[0], externalVertex[1], externalVertex[2], dist));
+      rejectionReason = "VertexDist";
+      return kFALSE;
+    }
+  }
+
+  return kTRUE;
+}
+
 /**
  * Initialize the external event by creating an event and then reading the event info from the TChain.
  *
@@ -1260,6 +1337,12 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
   // Determine which file to start with
   DetermineFirstFileToEmbed();
 
+  // Asynchronous prefetching is a setting of the ROOT environment, which is left to the user (e.g. in the run macro)
+  if (fUseAsyncPrefetching && (fTreeCacheSize <= 0 || !gEnv->GetValue("TFile.AsyncPrefetching", 0))) {
+    AliWarningStream() << "Asynchronous prefetching requested, but it requires a tree cache (treeCacheSize) and \"TFile.AsyncPrefetching\" "
+                       << "to be enabled in the ROOT environment before the files are opened. The embedded events are read synchronously.\n";
+  }
+
   // Setup TChain
   fChain = new TChain(fTreeName);
 
@@ -1487,6 +1570,10 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   //       invalid filenames may be included in the fFilenames count!
   //AliDebug(2, TString::Format("Will start embedding file %i as the %ith file beginning from entry %i.", (fFilenameIndex + fFileNumber) % fMaxNumberOfFiles, fFileNumber, fCurrentEntry));
 
+  // Select the entries of the new file on their header and setup the cache for the full reads
+  BuildPreselectionIndex();
+  SetupTreeCache();
+
   // (re)set whether we have wrapped the tree
   fWrappedAroundTree = false;
 
@@ -1503,6 +1590,84 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
 
 }
 
+/**
+ * Build the header pre-selection of the entries in the current file. Only the branches needed by
+ * CheckIsEmbeddedEventHeaderSelected() (header, vertices and MC header) are read for each entry,
+ * such that GetNextEntry() can skip the rejected entries without reading them. This matters for tight
+ * selections (for instance on the trigger), which otherwise require to fully read many events for each
+ * accepted one.
+ *
+ * The pre-selection is only available for AODs. It is disabled if any of the branches is missing.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::BuildPreselectionIndex()
+{
+  fPreselectedEntries.clear();
+  if (!fUseHeaderPreselection || fTreeName != "aodTree") return;
+
+  TTree * tree = fChain->GetTree();
+  if (!tree) return;
+
+  std::vector <TBranch *> branches;
+  std::vector <std::string> branchNames = {"header", "vertices"};
+  // The MC header is only needed (and available) for MC productions
+  if (fExternalEvent->FindListObject(AliAODMCHeader::StdBranchName())) {
+    branchNames.push_back(AliAODMCHeader::StdBranchName());
+  }
+  for (const auto & branchName : branchNames) {
+    TBranch * branch = tree->GetBranch(branchName.c_str());
+    if (!branch) {
+      AliWarningStream() << "Branch \"" << branchName << "\" not found in the embedded tree. Disabling the header pre-selection for this file.\n";
+      return;
+    }
+    branches.push_back(branch);
+  }
+
+  // The pre-selection must not go through the tree cache, which would read all the cached branches.
+  // The cache is restored afterwards, such that the full reads are done as without the pre-selection.
+  Long64_t cacheSize = tree->GetCacheSize();
+  tree->SetCacheSize(0);
+
+  Long64_t nEntries = tree->GetEntries();
+  fPreselectedEntries.resize(nEntries);
+  Long64_t nSelected = 0;
+  for (Long64_t entry = 0; entry < nEntries; entry++) {
+    for (auto branch : branches) {
+      branch->GetEntry(entry);
+    }
+    SetEmbeddedEventProperties();
+
+    PreselectedEntry_t & preselectedEntry = fPreselectedEntries.at(entry);
+    preselectedEntry.fRejectionReason = "";
+    preselectedEntry.fSelected = CheckIsEmbeddedEventHeaderSelected(preselectedEntry.fRejectionReason);
+    preselectedEntry.fPythiaTrials = fPythiaTrials;
+    preselectedEntry.fPythiaCrossSection = fPythiaCrossSection;
+    preselectedEntry.fPythiaPtHard = fPythiaPtHard;
+    if (preselectedEntry.fSelected) nSelected++;
+  }
+
+  if (cacheSize > 0) {
+    tree->SetCacheSize(cacheSize);
+  }
+
+  AliDebugStream(2) << "Header pre-selection accepted " << nSelected << " out of " << nEntries << " entries in the current file.\n";
+}
+
+/**
+ * Setup the tree cache of the current file for the full reads of the embedded events, if a cache size
+ * is set (off by default, then the default cache of ROOT is used). All branches are cached, as the full
+ * events are read. If "TFile.AsyncPrefetching" is enabled in the ROOT environment, the baskets of the
+ * next entries are prefetched in a background thread while the current event is processed.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::SetupTreeCache()
+{
+  TTree * tree = fChain->GetTree();
+  if (!tree || fTreeCacheSize <= 0) return;
+
+  tree->SetCacheSize(fTreeCacheSize);
+  tree->AddBranchToCache("*", kTRUE);
+  tree->StopCacheLearningPhase();
+}
+
 /**
  * Extract pythia information from a cross section file. Modified from AliAnalysisTaskEmcal::PythiaInfoFromFile().
  *
@@ -1800,6 +1965,9 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "File list filename: \"" << fFileListFilename << "\"\n";
   tempSS << "Tree name: " << fTreeName << "\n";
   tempSS << "Print timing info to log: " << fPrintTimingInfoToLog << "\n";
+  tempSS << "Header pre-selection: " << fUseHeaderPreselection << "\n";
+  tempSS << "Tree cache size: " << fTreeCacheSize << "\n";
+  tempSS << "Asynchronous prefetching: " << fUseAsyncPrefetching << "\n";
   tempSS << "Random event number access: " << fRandomEventNumberAccess << "\n";
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
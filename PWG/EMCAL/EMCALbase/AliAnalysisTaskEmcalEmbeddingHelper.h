@@ -152,6 +152,23 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetConfigurationPath(const char * path)                    { fConfigurationPath = path; }
   /* @} */
 
+  /**
+   * @{
+   * @name Reading of the embedded events
+   */
+  bool GetUseHeaderPreselection()                           const { return fUseHeaderPreselection; }
+  Long64_t GetTreeCacheSize()                               const { return fTreeCacheSize; }
+  bool GetUseAsyncPrefetching()                             const { return fUseAsyncPrefetching; }
+
+  /// Only read the header branches to select the entries of each file before fully reading them. Only available for AODs.
+  void SetUseHeaderPreselection(bool b = true)                    { fUseHeaderPreselection = b; }
+  /// Size of the tree cache used to read the embedded events, in bytes. 0 (default) keeps the default cache of ROOT.
+  void SetTreeCacheSize(Long64_t size)                            { fTreeCacheSize = size; }
+  /// Prefetch the baskets of the next entries in a background thread (off by default). Requires the tree cache
+  /// and "TFile.AsyncPrefetching" to be enabled in the ROOT environment by the user, e.g. in the run macro.
+  void SetUseAsyncPrefetching(bool b = true)                      { fUseAsyncPrefetching = b; }
+  /* @} */
+
   /**
    * @{
    * @name Internal event selection
@@ -297,6 +314,10 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void            RecordEmbeddedEventProperties();
   Bool_t          IsEventSelected()     ;
   Bool_t          CheckIsEmbeddedEventSelected();
+  Bool_t          CheckIsEmbeddedEventHeaderSelected(std::string & rejectionReason) const;
+  Bool_t          CheckIsEmbeddedEventVertexSelected(std::string & rejectionReason) const;
+  void            BuildPreselectionIndex();
+  void            SetupTreeCache();
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
@@ -371,6 +392,23 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   bool                                          fPrintTimingInfoToLog; ///< Flag to print time to execute InitTree(), for logging purposes
   TStopwatch                                    fTimer            ;    //!<! Timer for the InitTree() function
 
+  /**
+   * \struct PreselectedEntry_t
+   * \brief Result of the header pre-selection of an entry in the current file
+   */
+  struct PreselectedEntry_t {
+    bool                                        fSelected         ; ///< Entry passes the header selection
+    std::string                                 fRejectionReason  ; ///< Reason of the rejection, as labeled in fHistEmbeddedEventRejection
+    int                                         fPythiaTrials     ; ///< Number of pythia trials of the entry
+    double                                      fPythiaCrossSection; ///< Pythia cross section of the entry
+    double                                      fPythiaPtHard     ; ///< Pt hard of the entry
+  };
+
+  bool                                          fUseHeaderPreselection; ///< If true, entries are selected on their header branches before being fully read (AOD only)
+  Long64_t                                      fTreeCacheSize    ; ///< Size of the tree cache for the embedded events (bytes). 0 keeps the default cache of ROOT
+  bool                                          fUseAsyncPrefetching; ///< If true, the prefetching of the tree cache is requested (see SetUseAsyncPrefetching())
+  std::vector <PreselectedEntry_t>              fPreselectedEntries; //!<! Header pre-selection of the entries of the current file
+
   static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
 
  private:
@@ -378,7 +416,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 11);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 12);
   /// \endcond
 };
 #endif
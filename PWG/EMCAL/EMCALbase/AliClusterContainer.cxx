@@ -421,13 +421,7 @@ Bool_t AliClusterContainer::ApplyClusterCuts(const AliVCluster* clus, UInt_t &re
  */
 Int_t AliClusterContainer::GetNAcceptedClusters() const
 {
-  UInt_t rejectionReason = 0;
-  Int_t nClus = 0;
-  for(int iclust = 0; iclust < this->fClArray->GetEntries(); ++iclust){
-    AliVCluster *clust = this->GetCluster(iclust);
-    if(this->AcceptCluster(clust, rejectionReason)) nClus++;
-  }
-  return nClus;
+  return GetNAcceptEntries();
 }
 
 /**
@@ -458,6 +452,7 @@ void AliClusterContainer::SetClusUserDefEnergyCut(Int_t t, Double_t cut)
   else {
     fMinE = cut;
   }
+  InvalidateAcceptanceCache();
 }
 
 /**
@@ -36,6 +36,7 @@
 // EMCAL includes
 #include "AliEMCALRecoUtils.h"
 #include "AliEMCALGeometry.h"
+#include "AliEmcalCellGeometryTable.h"
 #include "AliTrackerBase.h"
 #include "AliEMCALPIDUtils.h"
 
@@ -75,7 +76,8 @@ AliEMCALRecoUtils::AliEMCALRecoUtils():
   fCutRequireTPCRefit(kFALSE),            fCutRequireITSRefit(kFALSE),            fCutAcceptKinkDaughters(kFALSE),
   fCutMaxDCAToVertexXY(0),                fCutMaxDCAToVertexZ(0),                 fCutDCAToVertex2D(kFALSE),
   fCutRequireITSStandAlone(kFALSE),       fCutRequireITSpureSA(kFALSE),             
-  fNMCGenerToAccept(0),                   fMCGenerToAcceptForTrack(1)
+  fNMCGenerToAccept(0),                   fMCGenerToAcceptForTrack(1),
+  fClusterCells()
 {
   // Init parameters
   InitParameters();
@@ -137,7 +139,8 @@ AliEMCALRecoUtils::AliEMCALRecoUtils(const AliEMCALRecoUtils & reco)
   fCutAcceptKinkDaughters(reco.fCutAcceptKinkDaughters),     fCutMaxDCAToVertexXY(reco.fCutMaxDCAToVertexXY),    
   fCutMaxDCAToVertexZ(reco.fCutMaxDCAToVertexZ),             fCutDCAToVertex2D(reco.fCutDCAToVertex2D),
   fCutRequireITSStandAlone(reco.fCutRequireITSStandAlone),   fCutRequireITSpureSA(reco.fCutRequireITSpureSA),
-  fNMCGenerToAccept(reco.fNMCGenerToAccept),                 fMCGenerToAcceptForTrack(reco.fMCGenerToAcceptForTrack)
+  fNMCGenerToAccept(reco.fNMCGenerToAccept),                 fMCGenerToAcceptForTrack(reco.fMCGenerToAcceptForTrack),
+  fClusterCells()
 {  
   for (Int_t i = 0; i < 15 ; i++) { fMisalRotShift[i]      = reco.fMisalRotShift[i]      ; 
                                     fMisalTransShift[i]    = reco.fMisalTransShift[i]    ; }
@@ -776,7 +779,35 @@ Float_t AliEMCALRecoUtils::CorrectClusterEnergyLinearity(AliVCluster* cluster)
     return 0;
   }
   
-  Float_t energy = cluster->E();
+  return CorrectEnergyLinearity(cluster->E());
+}
+
+///
+/// Correct the energy of all clusters of the cell arrays from non linearity functions,
+/// as CorrectClusterEnergyLinearity(AliVCluster*) for each cluster.
+///
+/// \param clusterCells: cells of the clusters of the event
+/// \param energies: corrected cluster energies, in the order of the clusters in the cell arrays
+///
+//____________________________________________________________________________
+void AliEMCALRecoUtils::CorrectClusterEnergyLinearity(const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells, 
+                                                      std::vector<Float_t> &energies)
+{
+  energies.resize(clusterCells.GetNumberOfClusters());
+  for (Int_t icl = 0; icl < clusterCells.GetNumberOfClusters(); icl++) 
+    energies[icl] = CorrectEnergyLinearity(clusterCells.GetCluster(icl)->E());
+}
+
+///
+/// Correct an energy from non linearity functions, defined in enum NonlinearityFunctions
+///
+/// \param energy: cluster energy
+///
+/// \return float with corrected cluster energy
+///
+//____________________________________________________________________________
+Float_t AliEMCALRecoUtils::CorrectEnergyLinearity(Float_t energy) const
+{  
   if (energy < 0.100) 
   {
     // Clusters with less than 100 MeV or negative are not possible
@@ -1361,9 +1392,6 @@ void AliEMCALRecoUtils::GetMaxEnergyCell(const AliEMCALGeometry *geom,
   Float_t  recalFactor = 1.;
   Int_t    cellAbsId   = -1 ;
 
-  Int_t iTower  = -1;
-  Int_t iIphi   = -1;
-  Int_t iIeta   = -1;
   Int_t iSupMod0= -1;
 
   if (!clu) 
@@ -1373,6 +1401,8 @@ void AliEMCALRecoUtils::GetMaxEnergyCell(const AliEMCALGeometry *geom,
     return;
   }
   
+  const PWG::EMCAL::AliEmcalCellGeometryTable *table = PWG::EMCAL::AliEmcalCellGeometryTable::Get(geom);
+  
   for (Int_t iDig=0; iDig< clu->GetNCells(); iDig++) 
   {
     cellAbsId = clu->GetCellAbsId(iDig);
@@ -1380,8 +1410,7 @@ void AliEMCALRecoUtils::GetMaxEnergyCell(const AliEMCALGeometry *geom,
     //printf("a Cell %d, id, %d, amp %f, fraction %f\n",iDig,cellAbsId,cells->GetCellAmplitude(cellAbsId),fraction);
     if (fraction < 1e-4) fraction = 1.; // in case unfolding is off
     
-    geom->GetCellIndex(cellAbsId,iSupMod,iTower,iIphi,iIeta); 
-    geom->GetCellPhiEtaIndexInSModule(iSupMod,iTower,iIphi, iIeta,iphi,ieta);
+    GetCellIndexInSModule(geom, table, cellAbsId, iSupMod, ieta, iphi);
     
     if (iDig==0) 
     {
@@ -1406,13 +1435,91 @@ void AliEMCALRecoUtils::GetMaxEnergyCell(const AliEMCALGeometry *geom,
   }// cell loop
   
   //Get from the absid the supermodule, tower and eta/phi numbers
-  geom->GetCellIndex(absId,iSupMod,iTower,iIphi,iIeta); 
-  //Gives SuperModule and Tower numbers
-  geom->GetCellPhiEtaIndexInSModule(iSupMod,iTower,iIphi, iIeta,iphi,ieta); 
+  GetCellIndexInSModule(geom, table, absId, iSupMod, ieta, iphi);
   //printf("Max id %d, iSM %d, col %d, row %d\n",absId,iSupMod,ieta,iphi);
   //printf("Max end---\n");
 }
 
+///
+/// Same as GetMaxEnergyCell() above, for the cells of a cluster of the cell arrays.
+///
+/// \param geom: AliEMCALGeometry pointer
+/// \param table: cell geometry table of geom
+/// \param clusterCells: cells of the clusters
+/// \param icl: index of the cluster in the cell arrays
+/// \param absId: absolute id number of cell with highest energy in cluster
+/// \param iSupMod: supermodule number of cell with highest energy in cluster
+/// \param ieta: column number of cell with highest energy in cluster
+/// \param iphi: row number of cell with highest energy in cluster
+/// \param shared: cluster is shared between 2 supermodules
+///
+//____________________________________________________________________
+void AliEMCALRecoUtils::GetMaxEnergyCell(const AliEMCALGeometry *geom, 
+                                         const PWG::EMCAL::AliEmcalCellGeometryTable *table,
+                                         const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells,
+                                         Int_t    icl,
+                                         Int_t  & absId,  
+                                         Int_t  & iSupMod, 
+                                         Int_t  & ieta, 
+                                         Int_t  & iphi, 
+                                         Bool_t & shared)
+{  
+  Double_t eMax        = -1.;
+  Double_t eCell       = -1.;
+  Float_t  recalFactor = 1.;
+  Int_t    cellAbsId   = -1 ;
+  Int_t    iSupMod0    = -1;
+  
+  const Int_t firstCell = clusterCells.GetFirstCell(icl);
+  const Int_t lastCell  = firstCell + clusterCells.GetNumberOfCells(icl);
+  for (Int_t iCell = firstCell; iCell < lastCell; iCell++) 
+  {
+    cellAbsId = clusterCells.GetCellAbsId(iCell);
+    
+    GetCellIndexInSModule(geom, table, cellAbsId, iSupMod, ieta, iphi);
+    
+    if      (iCell == firstCell)   iSupMod0 = iSupMod;
+    else if (iSupMod0 != iSupMod)  shared   = kTRUE;
+
+    if (!fCellsRecalibrated && IsRecalibrationOn()) 
+      recalFactor = GetEMCALChannelRecalibrationFactor(iSupMod,ieta,iphi);
+    
+    eCell  = clusterCells.GetCellAmplitude(iCell)*clusterCells.GetCellFraction(iCell)*recalFactor;
+    if (eCell > eMax) 
+    { 
+      eMax  = eCell; 
+      absId = cellAbsId;
+    }
+  }// cell loop
+  
+  GetCellIndexInSModule(geom, table, absId, iSupMod, ieta, iphi);
+}
+
+///
+/// Super module number and column/row in the super module of a cell, from the cell geometry
+/// table if the cell is in it, otherwise from the geometry. The numbers are left unchanged
+/// for a cell which does not exist.
+///
+/// \param geom: AliEMCALGeometry pointer
+/// \param table: cell geometry table of geom, can be null
+/// \param absId: absolute id number of the cell
+/// \param iSupMod: supermodule number of the cell
+/// \param ieta: column number of the cell
+/// \param iphi: row number of the cell
+///
+//____________________________________________________________________
+void AliEMCALRecoUtils::GetCellIndexInSModule(const AliEMCALGeometry *geom, 
+                                              const PWG::EMCAL::AliEmcalCellGeometryTable *table,
+                                              Int_t absId, Int_t & iSupMod, Int_t & ieta, Int_t & iphi) const
+{
+  if (table && table->GetCellIndex(absId, iSupMod, ieta, iphi)) return;
+  
+  Int_t iTower = -1, iIphi = -1, iIeta = -1, iSM = -1;
+  if (!geom->GetCellIndex(absId, iSM, iTower, iIphi, iIeta)) return;
+  iSupMod = iSM;
+  geom->GetCellPhiEtaIndexInSModule(iSupMod, iTower, iIphi, iIeta, iphi, ieta);
+}
+
 ///
 /// \return weight of cell for shower shape calculation
 /// If fW0 parameter is negative, apply log weight without trimming.
@@ -1960,6 +2067,30 @@ void AliEMCALRecoUtils::RecalculateClusterPosition(const AliEMCALGeometry *geom,
   else    AliDebug(2,"Algorithm to recalculate position not selected, do nothing.");
 }  
 
+///
+/// For all clusters of the cell arrays recalculates the position for a given set of misalignment shifts
+/// and puts it again in the cluster. Same result as RecalculateClusterPosition() for each cluster.
+///
+/// \param geom: EMCal geometry pointer
+/// \param clusterCells: cells of the clusters subject to position recalculation
+///
+//______________________________________________________________________________
+void AliEMCALRecoUtils::RecalculateClusterPosition(const AliEMCALGeometry *geom, 
+                                                   const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells)
+{  
+  if (fPosAlgo != kPosTowerGlobal && fPosAlgo != kPosTowerIndex)
+  {
+    AliDebug(2,"Algorithm to recalculate position not selected, do nothing.");
+    return;
+  }
+  
+  for (Int_t icl = 0; icl < clusterCells.GetNumberOfClusters(); icl++)
+  {
+    if (fPosAlgo==kPosTowerGlobal) RecalculateClusterPositionFromTowerGlobal(geom, clusterCells, icl);
+    else                           RecalculateClusterPositionFromTowerIndex (geom, clusterCells, icl);
+  }
+}  
+
 ///
 /// For a given CaloCluster recalculates the position for a given set of misalignment shifts and puts it again in the CaloCluster.
 /// The algorithm is a copy of what is done in AliEMCALRecPoint.
@@ -1972,51 +2103,66 @@ void AliEMCALRecoUtils::RecalculateClusterPosition(const AliEMCALGeometry *geom,
 void AliEMCALRecoUtils::RecalculateClusterPositionFromTowerGlobal(const AliEMCALGeometry *geom, 
                                                                   AliVCaloCells* cells, 
                                                                   AliVCluster* clu)
+{  
+  fClusterCells.Fill(cells, clu);
+  if (fClusterCells.GetNumberOfClusters())
+    RecalculateClusterPositionFromTowerGlobal(geom, fClusterCells, 0);
+  fClusterCells.Clear();
+}  
+
+///
+/// Same as RecalculateClusterPositionFromTowerGlobal() above, for a cluster of the cell arrays.
+///
+/// \param geom: EMCal geometry pointer
+/// \param clusterCells: cells of the clusters
+/// \param icl: index of the cluster subject to position recalculation in the cell arrays
+///
+//_____________________________________________________________________________________________
+void AliEMCALRecoUtils::RecalculateClusterPositionFromTowerGlobal(const AliEMCALGeometry *geom, 
+                                                                  const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells,
+                                                                  Int_t icl)
 {  
   Double_t eCell       = 0.;
-  Float_t  fraction    = 1.;
   Float_t  recalFactor = 1.;
   
   Int_t    absId   = -1;
-  Int_t    iTower  = -1, iIphi  = -1, iIeta  = -1;
   Int_t    iSupModMax = -1, iSM=-1, iphi   = -1, ieta   = -1;
   Float_t  weight = 0.,  totalWeight=0.;
   Float_t  newPos[3] = {-1.,-1.,-1.};
   Double_t pLocal[3], pGlobal[3];
   Bool_t shared = kFALSE;
 
+  AliVCluster *clu = clusterCells.GetCluster(icl);
   Float_t  clEnergy = clu->E(); //Energy already recalibrated previously
   if (clEnergy <= 0) return;
   
-  GetMaxEnergyCell(geom, cells, clu, absId,  iSupModMax, ieta, iphi,shared);
-  Double_t depth = GetDepth(clEnergy,fParticleType,iSupModMax) ;
+  const PWG::EMCAL::AliEmcalCellGeometryTable *table = PWG::EMCAL::AliEmcalCellGeometryTable::Get(geom);
   
-  //printf("** Cluster energy %f, ncells %d, depth %f\n",clEnergy,clu->GetNCells(),depth);
+  GetMaxEnergyCell(geom, table, clusterCells, icl, absId,  iSupModMax, ieta, iphi,shared);
+  Double_t depth = GetDepth(clEnergy,fParticleType,iSupModMax) ;
   
-  for (Int_t iDig=0; iDig< clu->GetNCells(); iDig++) 
+  const Int_t firstCell = clusterCells.GetFirstCell(icl);
+  const Int_t lastCell  = firstCell + clusterCells.GetNumberOfCells(icl);
+  for (Int_t iCell = firstCell; iCell < lastCell; iCell++) 
   {
-    absId = clu->GetCellAbsId(iDig);
-    fraction  = clu->GetCellAmplitudeFraction(iDig);
-    if (fraction < 1e-4) fraction = 1.; // in case unfolding is off
+    absId = clusterCells.GetCellAbsId(iCell);
     
     if (!fCellsRecalibrated) 
     {
-      geom->GetCellIndex(absId,iSM,iTower,iIphi,iIeta); 
-      geom->GetCellPhiEtaIndexInSModule(iSM,iTower,iIphi, iIeta,iphi,ieta);      
+      GetCellIndexInSModule(geom, table, absId, iSM, ieta, iphi);
       if (IsRecalibrationOn()) {
         recalFactor = GetEMCALChannelRecalibrationFactor(iSM,ieta,iphi);
       }
     }
     
-    eCell  = cells->GetCellAmplitude(absId)*fraction*recalFactor;
+    eCell  = clusterCells.GetCellAmplitude(iCell)*clusterCells.GetCellFraction(iCell)*recalFactor;
     
     weight = GetCellWeight(eCell,clEnergy);
     totalWeight += weight;
     
+    // The local position depends on the depth, it is not taken from the table
     geom->RelPosCellInSModule(absId,depth,pLocal[0],pLocal[1],pLocal[2]);
-    //printf("pLocal (%f,%f,%f), SM %d, absId %d\n",pLocal[0],pLocal[1],pLocal[2],iSupModMax,absId);
     geom->GetGlobal(pLocal,pGlobal,iSupModMax);
-    //printf("pLocal (%f,%f,%f)\n",pGlobal[0],pGlobal[1],pGlobal[2]);
 
     for (int i=0; i<3; i++ ) newPos[i] += (weight*pGlobal[i]);
   }// cell loop
@@ -2025,24 +2171,16 @@ void AliEMCALRecoUtils::RecalculateClusterPositionFromTowerGlobal(const AliEMCAL
   {
     for (int i=0; i<3; i++ )    newPos[i] /= totalWeight;
   }
-    
-  //Float_t pos[]={0,0,0};
-  //clu->GetPosition(pos);
-  //printf("OldPos  : %2.3f,%2.3f,%2.3f\n",pos[0],pos[1],pos[2]);
-  //printf("NewPos  : %2.3f,%2.3f,%2.3f\n",newPos[0],newPos[1],newPos[2]);
   
   if (iSupModMax > 1) { //sector 1
     newPos[0] +=fMisalTransShift[3];//-=3.093; 
     newPos[1] +=fMisalTransShift[4];//+=6.82;
     newPos[2] +=fMisalTransShift[5];//+=1.635;
-    //printf("   +    : %2.3f,%2.3f,%2.3f\n",fMisalTransShift[3],fMisalTransShift[4],fMisalTransShift[5]);
   } else { //sector 0
     newPos[0] +=fMisalTransShift[0];//+=1.134;
     newPos[1] +=fMisalTransShift[1];//+=8.2;
     newPos[2] +=fMisalTransShift[2];//+=1.197;
-    //printf("   +    : %2.3f,%2.3f,%2.3f\n",fMisalTransShift[0],fMisalTransShift[1],fMisalTransShift[2]);
   }
-  //printf("NewPos : %2.3f,%2.3f,%2.3f\n",newPos[0],newPos[1],newPos[2]);
 
   clu->SetPosition(newPos);
 }  
@@ -2059,42 +2197,58 @@ void AliEMCALRecoUtils::RecalculateClusterPositionFromTowerGlobal(const AliEMCAL
 void AliEMCALRecoUtils::RecalculateClusterPositionFromTowerIndex(const AliEMCALGeometry *geom, 
                                                                  AliVCaloCells* cells, 
                                                                  AliVCluster* clu)
+{
+  fClusterCells.Fill(cells, clu);
+  if (fClusterCells.GetNumberOfClusters())
+    RecalculateClusterPositionFromTowerIndex(geom, fClusterCells, 0);
+  fClusterCells.Clear();
+}
+
+///
+/// Same as RecalculateClusterPositionFromTowerIndex() above, for a cluster of the cell arrays.
+///
+/// \param geom: EMCal geometry pointer
+/// \param clusterCells: cells of the clusters
+/// \param icl: index of the cluster subject to position recalculation in the cell arrays
+///
+//____________________________________________________________________________________________
+void AliEMCALRecoUtils::RecalculateClusterPositionFromTowerIndex(const AliEMCALGeometry *geom, 
+                                                                 const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells,
+                                                                 Int_t icl)
 {
   Double_t eCell       = 1.;
-  Float_t  fraction    = 1.;
   Float_t  recalFactor = 1.;
   
   Int_t absId   = -1;
-  Int_t iTower  = -1;
-  Int_t iIphi   = -1, iIeta   = -1;
   Int_t iSupMod = -1, iSupModMax = -1;
   Int_t iphi = -1, ieta =-1;
   Bool_t shared = kFALSE;
 
+  AliVCluster *clu = clusterCells.GetCluster(icl);
   Float_t clEnergy = clu->E(); //Energy already recalibrated previously.
   
   if (clEnergy <= 0)
     return;
-  GetMaxEnergyCell(geom, cells, clu, absId,  iSupModMax, ieta, iphi,shared);
+  
+  const PWG::EMCAL::AliEmcalCellGeometryTable *table = PWG::EMCAL::AliEmcalCellGeometryTable::Get(geom);
+  
+  GetMaxEnergyCell(geom, table, clusterCells, icl, absId,  iSupModMax, ieta, iphi,shared);
   Float_t  depth = GetDepth(clEnergy,fParticleType,iSupMod) ;
 
   Float_t weight = 0., weightedCol = 0., weightedRow = 0., totalWeight=0.;
   Bool_t areInSameSM = kTRUE; //exclude clusters with cells in different SMs for now
   Int_t startingSM = -1;
   
-  for (Int_t iDig=0; iDig< clu->GetNCells(); iDig++) 
+  const Int_t firstCell = clusterCells.GetFirstCell(icl);
+  const Int_t lastCell  = firstCell + clusterCells.GetNumberOfCells(icl);
+  for (Int_t iCell = firstCell; iCell < lastCell; iCell++) 
   {
-    absId = clu->GetCellAbsId(iDig);
-    fraction  = clu->GetCellAmplitudeFraction(iDig);
-    if (fraction < 1e-4) fraction = 1.; // in case unfolding is off
+    absId = clusterCells.GetCellAbsId(iCell);
 
-    if      (iDig==0)  startingSM = iSupMod;
+    if      (iCell == firstCell) startingSM = iSupMod;
     else if (iSupMod != startingSM) areInSameSM = kFALSE;
 
-    eCell  = cells->GetCellAmplitude(absId);
-    
-    geom->GetCellIndex(absId,iSupMod,iTower,iIphi,iIeta); 
-    geom->GetCellPhiEtaIndexInSModule(iSupMod,iTower,iIphi, iIeta,iphi,ieta);    
+    GetCellIndexInSModule(geom, table, absId, iSupMod, ieta, iphi);
     
     if (!fCellsRecalibrated)
     {
@@ -2103,28 +2257,24 @@ void AliEMCALRecoUtils::RecalculateClusterPositionFromTowerIndex(const AliEMCALG
       }
     }
     
-    eCell  = cells->GetCellAmplitude(absId)*fraction*recalFactor;
+    eCell  = clusterCells.GetCellAmplitude(iCell)*clusterCells.GetCellFraction(iCell)*recalFactor;
     
     weight = GetCellWeight(eCell,clEnergy);
     if (weight < 0) weight = 0;
     totalWeight += weight;
     weightedCol += ieta*weight;
     weightedRow += iphi*weight;
-    
-    //printf("Max cell? cell %d, amplitude org %f, fraction %f, recalibration %f, amplitude new %f \n",cellAbsId, cells->GetCellAmplitude(cellAbsId), fraction, recalFactor, eCell) ;
   }// cell loop
     
   Float_t xyzNew[]={-1.,-1.,-1.};
   if (areInSameSM == kTRUE) 
   {
-    //printf("In Same SM\n");
     weightedCol = weightedCol/totalWeight;
     weightedRow = weightedRow/totalWeight;
     geom->RecalculateTowerPosition(weightedRow, weightedCol, iSupModMax, depth, fMisalTransShift, fMisalRotShift, xyzNew); 
   } 
   else 
   {
-    //printf("In Different SM\n");
     geom->RecalculateTowerPosition(iphi,        ieta,        iSupModMax, depth, fMisalTransShift, fMisalRotShift, xyzNew); 
   }
   
@@ -2277,17 +2427,49 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
     AliInfo("Cluster pointer null!");
     return;
   }
-    
+  
+  fClusterCells.Fill(cells, cluster);
+  RecalculateClusterShowerShapeParametersWithCellCuts(geom, fClusterCells, 0, cellEcut, cellTimeCut, bc,
+                                                      enAfterCuts, l0, l1, disp, dEta, dPhi, sEta, sPhi, sEtaPhi);
+  fClusterCells.Clear();
+}
+
+///
+/// Same as RecalculateClusterShowerShapeParametersWithCellCuts() above, for a cluster of the cell arrays.
+/// The cell indices and locations are taken from the cell geometry table.
+///
+/// \param geom: EMCal geometry pointer
+/// \param clusterCells: cells of the clusters
+/// \param icl: index of the cluster subject to shower shape recalculation in the cell arrays
+/// \param cellEcut: minimum cell energy to be considered in the shower shape recalculation
+/// \param cellTimeCut: time window of cells to be considered in shower recalculation
+/// \param bc: event bunch crossing number
+/// \param enAfterCuts: cluster energy when applying the cell cuts cellEcut and cellTime cut
+/// \param l0: main shower shape eigen value
+/// \param l1: second eigenvalue of shower shape
+/// \param disp: dispersion
+/// \param dEta: dispersion in eta (cols) direction
+/// \param dPhi: disperion in phi (rows) direction
+/// \param sEta: shower shape in eta  (cols) direction
+/// \param sPhi: shower shape in phi (rows) direction
+/// \param sEtaPhi: shower shape on phi / eta directions term
+///
+//___________________________________________________________________________________________________________________
+void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(const AliEMCALGeometry * geom, 
+                                                                            const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells, Int_t icl,
+                                                                            Float_t cellEcut, Float_t cellTimeCut, Int_t bc, 
+                                                                            Float_t & enAfterCuts, Float_t & l0,   Float_t & l1,   
+                                                                            Float_t & disp, Float_t & dEta, Float_t & dPhi,
+                                                                            Float_t & sEta, Float_t & sPhi, Float_t & sEtaPhi)
+{  
+  AliVCluster *cluster = clusterCells.GetCluster(icl);
+  
   Double_t eCell       = 0.;
   Double_t tCell       = 0.;
-  Float_t  fraction    = 1.;
   Float_t  recalFactor = 1.;
   Bool_t   isLowGain   = kFALSE;
 
   Int_t    iSupMod = -1;
-  Int_t    iTower  = -1;
-  Int_t    iIphi   = -1;
-  Int_t    iIeta   = -1;
   Int_t    iphi    = -1;
   Int_t    ieta    = -1;
   Double_t etai    = -1.;
@@ -2301,6 +2483,9 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
   
   Double_t pGlobal[3];
   
+  // Cell locations other than the indices are needed from the table
+  const PWG::EMCAL::AliEmcalCellGeometryTable *table = PWG::EMCAL::AliEmcalCellGeometryTable::Get(geom, fShowerShapeCellLocationType != 0);
+  
   // Loop on cells, calculate the cluster energy, in case a cut on cell energy is added,
   // or the non linearity correction was applied
   // and to check if the cluster is between 2 SM in eta
@@ -2313,29 +2498,26 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
   disp = 0; dEta = 0; dPhi = 0;
   sEta = 0; sPhi = 0; sEtaPhi = 0;
   
-  for (Int_t iDigit=0; iDigit < cluster->GetNCells(); iDigit++)
+  const Int_t firstCell = clusterCells.GetFirstCell(icl);
+  const Int_t lastCell  = firstCell + clusterCells.GetNumberOfCells(icl);
+  for (Int_t iCell = firstCell; iCell < lastCell; iCell++)
   {
     // Get from the absid the supermodule, tower and eta/phi numbers
-    
-    Int_t absId = cluster->GetCellAbsId(iDigit);
+    Int_t absId = clusterCells.GetCellAbsId(iCell);
 
-    geom->GetCellIndex(absId,iSupMod,iTower,iIphi,iIeta);
-    geom->GetCellPhiEtaIndexInSModule(iSupMod,iTower,iIphi,iIeta, iphi,ieta);
+    GetCellIndexInSModule(geom, table, absId, iSupMod, ieta, iphi);
     
     // Check if there are cells of different SM
-    if      (iDigit == 0   ) iSM0 = iSupMod;
+    if      (iCell == firstCell) iSM0 = iSupMod;
     else if (iSupMod!= iSM0) shared = kTRUE;
     
     // Get the cell energy, if recalibration is on, apply factors
-    fraction  = cluster->GetCellAmplitudeFraction(iDigit);
-    if (fraction < 1e-4) fraction = 1.; // in case unfolding is off
-    
     if (IsRecalibrationOn()) 
       recalFactor = GetEMCALChannelRecalibrationFactor(iSupMod,ieta,iphi);
     
-    eCell  = cells->GetCellAmplitude(absId)*fraction*recalFactor;
-    tCell  = cells->GetCellTime     (absId);
-    isLowGain = !(cells->GetCellHighGain(absId));//HG = false -> LG = true
+    eCell  = clusterCells.GetCellAmplitude(iCell)*clusterCells.GetCellFraction(iCell)*recalFactor;
+    tCell  = clusterCells.GetCellTime(iCell);
+    isLowGain = !(clusterCells.GetCellHighGain(iCell));//HG = false -> LG = true
 
     RecalibrateCellTime(absId, bc, tCell,isLowGain);
     tCell*=1e9;
@@ -2350,24 +2532,20 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
     
   
   // Loop on cells to calculate weights and shower shape terms parameters
-  for (Int_t iDigit=0; iDigit < cluster->GetNCells(); iDigit++) 
+  for (Int_t iCell = firstCell; iCell < lastCell; iCell++) 
   {
     // Get from the absid the supermodule, tower and eta/phi numbers
-    Int_t absId = cluster->GetCellAbsId(iDigit);
+    Int_t absId = clusterCells.GetCellAbsId(iCell);
 
-    geom->GetCellIndex(absId,iSupMod,iTower,iIphi,iIeta); 
-    geom->GetCellPhiEtaIndexInSModule(iSupMod,iTower,iIphi,iIeta, iphi,ieta);        
+    GetCellIndexInSModule(geom, table, absId, iSupMod, ieta, iphi);
     
     //Get the cell energy, if recalibration is on, apply factors
-    fraction  = cluster->GetCellAmplitudeFraction(iDigit);
-    if (fraction < 1e-4) fraction = 1.; // in case unfolding is off
-    
     if (!fCellsRecalibrated && IsRecalibrationOn()) 
         recalFactor = GetEMCALChannelRecalibrationFactor(iSupMod,ieta,iphi);
     
-    eCell  = cells->GetCellAmplitude(absId)*fraction*recalFactor;
-    tCell  = cells->GetCellTime     (absId);
-    isLowGain = !(cells->GetCellHighGain(absId));//HG = false -> LG = true
+    eCell  = clusterCells.GetCellAmplitude(iCell)*clusterCells.GetCellFraction(iCell)*recalFactor;
+    tCell  = clusterCells.GetCellTime(iCell);
+    isLowGain = !(clusterCells.GetCellHighGain(iCell));//HG = false -> LG = true
 
     RecalibrateCellTime(absId, bc, tCell,isLowGain);
     tCell*=1e9;
@@ -2390,13 +2568,15 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
       // Cell angle location
       else if( fShowerShapeCellLocationType == 1 )
       {
-        geom->EtaPhiFromIndex(absId, etai, phii);
+        if (table->IsValid(absId)) { etai = table->GetEta(absId); phii = table->GetPhi(absId); }
+        else geom->EtaPhiFromIndex(absId, etai, phii);
         etai *= TMath::RadToDeg(); // change units to degrees instead of radians
         phii *= TMath::RadToDeg(); // change units to degrees instead of radians       
       }
       else
       {
-        geom->GetGlobal(absId,pGlobal);
+        if (table->IsValid(absId)) table->GetGlobal(absId,pGlobal);
+        else geom->GetGlobal(absId,pGlobal);
         
         // Cell x-z location
         if( fShowerShapeCellLocationType == 2 )
@@ -2429,8 +2609,6 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
       AliDebug(2,Form("Wrong energy in cell %f and/or cluster %f\n", eCell, cluster->E()));
   } // cell loop
   
-  //printf("sEta %f sPhi %f etaMean %f phiMean %f sEtaPhi %f wtot %f\n",sEta,sPhi,etaMean,phiMean,sEtaPhi, wtot);
-  
   // Normalize to the weight  
   if (wtot > 0) 
   {
@@ -2441,23 +2619,20 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
     AliDebug(2,Form("Wrong weight %f\n", wtot));
   
   // Loop on cells to calculate dispersion  
-  for (Int_t iDigit=0; iDigit < cluster->GetNCells(); iDigit++) 
+  for (Int_t iCell = firstCell; iCell < lastCell; iCell++) 
   {
     // Get from the absid the supermodule, tower and eta/phi numbers
-    Int_t absId = cluster->GetCellAbsId(iDigit);
+    Int_t absId = clusterCells.GetCellAbsId(iCell);
 
-    geom->GetCellIndex(absId,iSupMod,iTower,iIphi,iIeta); 
-    geom->GetCellPhiEtaIndexInSModule(iSupMod,iTower,iIphi,iIeta, iphi,ieta);
+    GetCellIndexInSModule(geom, table, absId, iSupMod, ieta, iphi);
     
     //Get the cell energy, if recalibration is on, apply factors
-    fraction  = cluster->GetCellAmplitudeFraction(iDigit);
-    if (fraction < 1e-4) fraction = 1.; // in case unfolding is off
     if (IsRecalibrationOn()) 
       recalFactor = GetEMCALChannelRecalibrationFactor(iSupMod,ieta,iphi);
     
-    eCell  = cells->GetCellAmplitude(absId)*fraction*recalFactor;
-    tCell  = cells->GetCellTime     (absId);
-    isLowGain = !(cells->GetCellHighGain(absId));//HG = false -> LG = true
+    eCell  = clusterCells.GetCellAmplitude(iCell)*clusterCells.GetCellFraction(iCell)*recalFactor;
+    tCell  = clusterCells.GetCellTime(iCell);
+    isLowGain = !(clusterCells.GetCellHighGain(iCell));//HG = false -> LG = true
 
     RecalibrateCellTime(absId, bc, tCell,isLowGain);
     tCell*=1e9;
@@ -2480,13 +2655,15 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
       // Cell angle location
       else if( fShowerShapeCellLocationType == 1 )
       {
-        geom->EtaPhiFromIndex(absId, etai, phii);
+        if (table->IsValid(absId)) { etai = table->GetEta(absId); phii = table->GetPhi(absId); }
+        else geom->EtaPhiFromIndex(absId, etai, phii);
         etai *= TMath::RadToDeg(); // change units to degrees instead of radians
         phii *= TMath::RadToDeg(); // change units to degrees instead of radians       
       }
       else
       {
-        geom->GetGlobal(absId,pGlobal);
+        if (table->IsValid(absId)) table->GetGlobal(absId,pGlobal);
+        else geom->GetGlobal(absId,pGlobal);
         
         // Cell x-z location
         if( fShowerShapeCellLocationType == 2 )
@@ -2529,9 +2706,6 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
     
     l0 = (0.5 * (sEta + sPhi) + TMath::Sqrt( 0.25 * (sEta - sPhi) * (sEta - sPhi) + sEtaPhi * sEtaPhi ));
     l1 = (0.5 * (sEta + sPhi) - TMath::Sqrt( 0.25 * (sEta - sPhi) * (sEta - sPhi) + sEtaPhi * sEtaPhi ));
-    
-    //printf("sEta %f sPhi %f etaMean %f phiMean %f sEtaPhi %f wtot %f l0 %f l1 %f\n",sEta,sPhi,etaMean,phiMean,sEtaPhi, wtot,l0,l1);
-
   } 
   else 
   {
@@ -2636,6 +2810,77 @@ void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(cons
   
 } 
 
+///
+/// Calculates Dispersion and main axis of all clusters of the cell arrays and puts them into the clusters.
+/// Same result as RecalculateClusterShowerShapeParameters() for each cluster.
+///
+/// \param geom: EMCal geometry pointer
+/// \param clusterCells: cells of the clusters subject to shower shape recalculation
+///
+//____________________________________________________________________________________________
+void AliEMCALRecoUtils::RecalculateClusterShowerShapeParameters(const AliEMCALGeometry * geom, 
+                                                                const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells)
+{  
+  Float_t newEnergy      = 0;
+  Float_t cellEmin       = 0.05; // 50 MeV
+  Float_t cellTimeWindow = 1000; // open cut
+  Int_t   bc             = 0; 
+  
+  for (Int_t icl = 0; icl < clusterCells.GetNumberOfClusters(); icl++)
+  {
+    Float_t l0   = 0., l1   = 0.;
+    Float_t disp = 0., dEta = 0., dPhi    = 0.; 
+    Float_t sEta = 0., sPhi = 0., sEtaPhi = 0.;
+    
+    RecalculateClusterShowerShapeParametersWithCellCuts(geom, clusterCells, icl,
+                                                        cellEmin, cellTimeWindow, bc,
+                                                        newEnergy, l0, l1, disp,
+                                                        dEta, dPhi, sEta, sPhi, sEtaPhi);
+    
+    AliVCluster *cluster = clusterCells.GetCluster(icl);
+    cluster->SetM02(l0);
+    cluster->SetM20(l1);
+    if (disp > 0. ) cluster->SetDispersion(TMath::Sqrt(disp)) ;
+  }
+} 
+
+///
+/// Calculates Dispersion and main axis of all clusters of the cell arrays and puts them into the clusters.
+/// Same result as RecalculateClusterShowerShapeParametersWithCellCuts() for each cluster.
+/// 
+/// \param geom: EMCal geometry pointer
+/// \param clusterCells: cells of the clusters subject to shower shape recalculation
+/// \param cellEcut: minimum cell energy to be considered in the shower shape recalculation
+/// \param cellTimeCut: time window of cells to be considered in shower recalculation
+/// \param bc: event bunch crossing number
+/// \param enAfterCuts: cluster energies when applying the cell cuts cellEcut and cellTime cut, by cluster of the cell arrays
+///
+//____________________________________________________________________________________________
+void AliEMCALRecoUtils::RecalculateClusterShowerShapeParametersWithCellCuts(const AliEMCALGeometry * geom, 
+                                                                            const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells,
+                                                                            Float_t cellEcut, Float_t cellTimeCut, Int_t bc,
+                                                                            std::vector<Float_t> & enAfterCuts)
+{  
+  enAfterCuts.assign(clusterCells.GetNumberOfClusters(), 0.);
+  
+  for (Int_t icl = 0; icl < clusterCells.GetNumberOfClusters(); icl++)
+  {
+    Float_t l0   = 0., l1   = 0.;
+    Float_t disp = 0., dEta = 0., dPhi    = 0.; 
+    Float_t sEta = 0., sPhi = 0., sEtaPhi = 0.;
+    
+    RecalculateClusterShowerShapeParametersWithCellCuts(geom, clusterCells, icl,
+                                                        cellEcut, cellTimeCut, bc,
+                                                        enAfterCuts[icl], l0, l1, disp,
+                                                        dEta, dPhi, sEta, sPhi, sEtaPhi);
+    
+    AliVCluster *cluster = clusterCells.GetCluster(icl);
+    cluster->SetM02(l0);
+    cluster->SetM20(l1);
+    if (disp > 0. ) cluster->SetDispersion(TMath::Sqrt(disp)) ;
+  }
+} 
+
 ///
 /// Find the candidate cluster-track matchs.
 ///
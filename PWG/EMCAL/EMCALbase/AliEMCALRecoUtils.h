@@ -20,6 +20,11 @@
 ///      * Position
 ///      * Matching to tracks
 ///
+/// The cluster recalculations take the cell indices and positions from the per-cell geometry
+/// table (PWG::EMCAL::AliEmcalCellGeometryTable) instead of the geometry. Besides the per-cluster
+/// methods, they have batch overloads running on the cells of all clusters of an event
+/// (PWG::EMCAL::AliEmcalClusterCellArrays), giving identical results.
+///
 /// Plus other helper methods.
 ///
 /// Class derived from AliEMCALRecoUtilsBase since AliRoot tag v5-09-26
@@ -32,6 +37,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // Root includes
+#include <vector>
 #include <TNamed.h>
 #include <TMath.h>
 class TObjArray;
@@ -51,11 +57,13 @@ class AliMCEvent;
 
 // EMCAL includes
 #include "AliEMCALRecoUtilsBase.h"
+#include "AliEmcalClusterCellArrays.h"
 class AliEMCALGeometry;
 class AliEMCALPIDUtils;
 class AliESDtrack;
 class AliExternalTrackParam;
 class AliVTrack;
+namespace PWG { namespace EMCAL { class AliEmcalCellGeometryTable; } }
 
 class AliEMCALRecoUtils : public AliEMCALRecoUtilsBase {
   
@@ -103,6 +111,7 @@ public:
   void     RecalculateClusterPosition               (const AliEMCALGeometry *geom, AliVCaloCells* cells, AliVCluster* clu); 
   void     RecalculateClusterPositionFromTowerIndex (const AliEMCALGeometry *geom, AliVCaloCells* cells, AliVCluster* clu); 
   void     RecalculateClusterPositionFromTowerGlobal(const AliEMCALGeometry *geom, AliVCaloCells* cells, AliVCluster* clu); 
+  void     RecalculateClusterPosition               (const AliEMCALGeometry *geom, const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells);
   
   Float_t  GetCellWeight(Float_t eCell, Float_t eCluster) const ;
   void     GetMaxEnergyCell(const AliEMCALGeometry *geom, AliVCaloCells* cells, const AliVCluster* clu, 
@@ -135,6 +144,8 @@ public:
   // Non Linearity
   //-----------------------------------------------------
   Float_t  CorrectClusterEnergyLinearity(AliVCluster* clu) ;
+  void     CorrectClusterEnergyLinearity(const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells, std::vector<Float_t> &energies) ;
+  Float_t  CorrectEnergyLinearity(Float_t energy) const ;
   Float_t  GetNonLinearityParam(Int_t i)     const { if(i < 10 && i >=0 ){ return fNonLinearityParams[i]  ; }
                                                      else  { AliInfo(Form("Index %d larger than 9 or negative, do nothing\n",i)) ;
                                                                          return 0.                     ; } }
@@ -163,6 +174,8 @@ public:
   void     RecalibrateCells(AliVCaloCells * cells, Int_t bc) ; // Energy and Time
   void     RecalibrateClusterEnergy(const AliEMCALGeometry* geom, AliVCluster* cluster, AliVCaloCells * cells, Int_t bc=-1) ; // Energy and time
   void     ResetCellsCalibrated()                        { fCellsRecalibrated = kFALSE; }
+  void     SetCellsCalibrated()                          { fCellsRecalibrated = kTRUE ; }
+  Bool_t   AreCellsCalibrated()                    const { return fCellsRecalibrated ; }
 
   // Energy recalibration
   Bool_t   IsRecalibrationOn()                     const { return fRecalibration ; }
@@ -189,6 +202,7 @@ public:
                                                            SwitchOnRecalibration()           ; }      
   // Time Recalibration  
   void     SetConstantTimeShift(Float_t shift)           { fConstantTimeShift = shift  ; }
+  Float_t  GetConstantTimeShift()                  const { return fConstantTimeShift ; }
 
   void     RecalibrateCellTime(Int_t absId, Int_t bc, Double_t & time,Bool_t isLGon = kFALSE) const;
   
@@ -297,6 +311,10 @@ public:
                                                                Float_t & enAfterCuts, Float_t & l0,   Float_t & l1,   
                                                                Float_t & disp, Float_t & dEta, Float_t & dPhi,
                                                                Float_t & sEta, Float_t & sPhi, Float_t & sEtaPhi);
+
+  void     RecalculateClusterShowerShapeParameters(const AliEMCALGeometry * geom, const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells);
+  void     RecalculateClusterShowerShapeParametersWithCellCuts(const AliEMCALGeometry * geom, const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells,
+                                                               Float_t cellEcut, Float_t cellTimeCut, Int_t bc, std::vector<Float_t> & enAfterCuts);
   void     RecalculateClusterPID(AliVCluster * cluster);
   AliEMCALPIDUtils * GetPIDUtils() { return fPIDUtils;}
 
@@ -445,6 +463,20 @@ public:
                                                       Float_t & amp, TArrayI & labeArr, TArrayF & eDepArr ) const;
 private:  
   
+  // Recalculations on the cells of one cluster of the cell arrays
+  void     GetCellIndexInSModule(const AliEMCALGeometry *geom, const PWG::EMCAL::AliEmcalCellGeometryTable *table,
+                                 Int_t absId, Int_t & iSupMod, Int_t & ieta, Int_t & iphi) const;
+  void     GetMaxEnergyCell(const AliEMCALGeometry *geom, const PWG::EMCAL::AliEmcalCellGeometryTable *table,
+                            const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells, Int_t icl,
+                            Int_t & absId,  Int_t& iSupMod, Int_t& ieta, Int_t& iphi, Bool_t &shared);
+  void     RecalculateClusterPositionFromTowerIndex (const AliEMCALGeometry *geom, const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells, Int_t icl);
+  void     RecalculateClusterPositionFromTowerGlobal(const AliEMCALGeometry *geom, const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells, Int_t icl);
+  void     RecalculateClusterShowerShapeParametersWithCellCuts(const AliEMCALGeometry * geom, const PWG::EMCAL::AliEmcalClusterCellArrays &clusterCells, Int_t icl,
+                                                               Float_t cellEcut, Float_t cellTimeCut, Int_t bc,
+                                                               Float_t & enAfterCuts, Float_t & l0,   Float_t & l1,   
+                                                               Float_t & disp, Float_t & dEta, Float_t & dPhi,
+                                                               Float_t & sEta, Float_t & sPhi, Float_t & sEtaPhi);
+
   // Position recalculation
   Float_t    fMisalTransShift[15];       ///< Cluster position translation shift parameters
   Float_t    fMisalRotShift[15];         ///< Cluster position rotation shift parameters
@@ -551,8 +583,10 @@ private:
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
   Bool_t     fMCGenerToAcceptForTrack;   ///<  Activate the removal of tracks entering the track matching that come from a particular generator
   
+  PWG::EMCAL::AliEmcalClusterCellArrays fClusterCells; //!<! Cells of the cluster recalculated by the per-cluster methods
+  
   /// \cond CLASSIMP
-  ClassDef(AliEMCALRecoUtils, 26) ;
+  ClassDef(AliEMCALRecoUtils, 27) ;
   /// \endcond
 
 };
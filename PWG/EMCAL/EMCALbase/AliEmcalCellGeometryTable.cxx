@@ -0,0 +1,131 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <TGeoManager.h>
+
+#include "AliEMCALGeometry.h"
+#include "AliEmcalCellGeometryTable.h"
+
+/// \cond CLASSIMP
+ClassImp(PWG::EMCAL::AliEmcalCellGeometryTable)
+/// \endcond
+
+using namespace PWG::EMCAL;
+
+std::vector<std::unique_ptr<AliEmcalCellGeometryTable> > AliEmcalCellGeometryTable::fgTables;
+
+AliEmcalCellGeometryTable::AliEmcalCellGeometryTable():
+  fGeometry(nullptr),
+  fGeometryName(),
+  fMatrices(),
+  fGeoManager(nullptr),
+  fHasPositions(kFALSE),
+  fSuperModule(),
+  fColumn(),
+  fRow(),
+  fX(),
+  fY(),
+  fZ(),
+  fEta(),
+  fPhi()
+{
+}
+
+const AliEmcalCellGeometryTable *AliEmcalCellGeometryTable::Get(const AliEMCALGeometry *geom, Bool_t withPositions){
+  if(!geom) return nullptr;
+  AliEmcalCellGeometryTable *table = nullptr;
+  for(auto &tab : fgTables){
+    if(tab->fGeometry == geom) {
+      table = tab.get();
+      break;
+    }
+  }
+  if(!table){
+    table = new AliEmcalCellGeometryTable;
+    table->BuildIndices(geom);
+    fgTables.emplace_back(table);
+  } else if(!table->IsSameGeometry(geom)) {
+    // Another geometry at the address of a deleted one
+    table->BuildIndices(geom);
+  }
+  if(withPositions && !table->IsUpToDate(geom)) table->BuildPositions(geom);
+  return table;
+}
+
+Bool_t AliEmcalCellGeometryTable::IsSameGeometry(const AliEMCALGeometry *geom) const {
+  return fGeometry == geom && fGeometryName == geom->GetName() && GetNCells() == geom->GetNCells();
+}
+
+Bool_t AliEmcalCellGeometryTable::IsUpToDate(const AliEMCALGeometry *geom) const {
+  if(!fHasPositions) return kFALSE;
+  // Matrices not set in the geometry are taken from the geometry manager
+  if(fGeoManager != gGeoManager) return kFALSE;
+  for(int ism = 0; ism < static_cast<int>(fMatrices.size()); ism++){
+    if(fMatrices[ism] != geom->GetMatrixForSuperModuleFromArray(ism)) return kFALSE;
+  }
+  return kTRUE;
+}
+
+void AliEmcalCellGeometryTable::BuildIndices(const AliEMCALGeometry *geom){
+  fGeometry = geom;
+  fGeometryName = geom->GetName();
+  fHasPositions = kFALSE;
+  const int ncells = geom->GetNCells();
+  fSuperModule.assign(ncells, -1);
+  fColumn.assign(ncells, -1);
+  fRow.assign(ncells, -1);
+  Int_t iSupMod = -1, iTower = -1, iIphi = -1, iIeta = -1, iphi = -1, ieta = -1;
+  for(int absId = 0; absId < ncells; absId++){
+    if(!geom->GetCellIndex(absId, iSupMod, iTower, iIphi, iIeta)) continue;
+    geom->GetCellPhiEtaIndexInSModule(iSupMod, iTower, iIphi, iIeta, iphi, ieta);
+    fSuperModule[absId] = iSupMod;
+    fColumn[absId] = ieta;
+    fRow[absId] = iphi;
+  }
+}
+
+void AliEmcalCellGeometryTable::BuildPositions(const AliEMCALGeometry *geom){
+  const int ncells = GetNCells();
+  fX.assign(ncells, 0.);
+  fY.assign(ncells, 0.);
+  fZ.assign(ncells, 0.);
+  fEta.assign(ncells, 0.);
+  fPhi.assign(ncells, 0.);
+  Double_t glob[3];
+  for(int absId = 0; absId < ncells; absId++){
+    if(fSuperModule[absId] < 0) continue;
+    geom->GetGlobal(absId, glob);
+    fX[absId] = glob[0];
+    fY[absId] = glob[1];
+    fZ[absId] = glob[2];
+    geom->EtaPhiFromIndex(absId, fEta[absId], fPhi[absId]);
+  }
+
+  fGeoManager = gGeoManager;
+  fMatrices.resize(geom->GetNumberOfSuperModules());
+  for(int ism = 0; ism < static_cast<int>(fMatrices.size()); ism++) fMatrices[ism] = geom->GetMatrixForSuperModuleFromArray(ism);
+  fHasPositions = kTRUE;
+}
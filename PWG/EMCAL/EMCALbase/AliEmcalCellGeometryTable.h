@@ -0,0 +1,142 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALCELLGEOMETRYTABLE_H
+#define ALIEMCALCELLGEOMETRYTABLE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <Rtypes.h>
+
+class AliEMCALGeometry;
+class TGeoHMatrix;
+class TGeoManager;
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class AliEmcalCellGeometryTable
+ * @brief Per-cell geometry of the EMCal, by absolute cell ID
+ * @ingroup EMCALCOREFW
+ *
+ * Table of the geometry quantities of each cell needed in the cluster
+ * recalculations of AliEMCALRecoUtils, obtained once from AliEMCALGeometry:
+ * - supermodule, column (\f$\eta\f$ index) and row (\f$\phi\f$ index) in the supermodule,
+ *   as from AliEMCALGeometry::GetCellIndex() and GetCellPhiEtaIndexInSModule(),
+ * - global position, as from AliEMCALGeometry::GetGlobal(),
+ * - \f$\eta\f$ and \f$\phi\f$, as from AliEMCALGeometry::EtaPhiFromIndex().
+ * The values are the ones returned by the geometry, the table only saves the
+ * lookups. The positions depend on the supermodule matrices and are filled only
+ * when requested, such that users of the indices never need the matrices.
+ *
+ * One table exists per geometry, shared by all users and obtained with Get().
+ * The geometry is identified by its address, name and number of cells, such that
+ * a geometry created at the address of a deleted one gets a new table. The
+ * positions are rebuilt when the supermodule matrices of the geometry change.
+ * The tables are owned by the class and deleted at exit.
+ */
+class AliEmcalCellGeometryTable {
+public:
+  virtual ~AliEmcalCellGeometryTable() {}
+
+  /**
+   * @brief Get the table of a geometry, building it if needed
+   * @param[in] geom EMCal geometry
+   * @param[in] withPositions If true, the global positions and \f$\eta\f$-\f$\phi\f$ are filled as well
+   * @return Table of the geometry, null if the geometry is null
+   */
+  static const AliEmcalCellGeometryTable *Get(const AliEMCALGeometry *geom, Bool_t withPositions = kFALSE);
+
+  Int_t GetNCells() const { return fSuperModule.size(); }
+  Bool_t HasPositions() const { return fHasPositions; }
+
+  /// True if the absolute ID is a cell of the geometry
+  Bool_t IsValid(Int_t absId) const { return absId >= 0 && absId < GetNCells() && fSuperModule[absId] >= 0; }
+
+  /**
+   * @brief Supermodule, column and row in the supermodule of a cell
+   * @param[in] absId Absolute ID of the cell
+   * @param[out] iSupMod Supermodule
+   * @param[out] ieta Column in the supermodule
+   * @param[out] iphi Row in the supermodule
+   * @return False (and outputs unchanged) if the cell does not exist
+   */
+  Bool_t GetCellIndex(Int_t absId, Int_t &iSupMod, Int_t &ieta, Int_t &iphi) const {
+    if (!IsValid(absId)) return kFALSE;
+    iSupMod = fSuperModule[absId];
+    ieta = fColumn[absId];
+    iphi = fRow[absId];
+    return kTRUE;
+  }
+
+  Int_t GetSuperModule(Int_t absId) const { return fSuperModule[absId]; }
+  Int_t GetColumn(Int_t absId) const { return fColumn[absId]; }
+  Int_t GetRow(Int_t absId) const { return fRow[absId]; }
+
+  /// Global position of the cell, only with positions
+  void GetGlobal(Int_t absId, Double_t glob[3]) const { glob[0] = fX[absId]; glob[1] = fY[absId]; glob[2] = fZ[absId]; }
+  Double_t GetEta(Int_t absId) const { return fEta[absId]; }
+  Double_t GetPhi(Int_t absId) const { return fPhi[absId]; }
+
+private:
+  AliEmcalCellGeometryTable();
+  AliEmcalCellGeometryTable(const AliEmcalCellGeometryTable &);
+  AliEmcalCellGeometryTable &operator=(const AliEmcalCellGeometryTable &);
+
+  Bool_t IsSameGeometry(const AliEMCALGeometry *geom) const;
+  Bool_t IsUpToDate(const AliEMCALGeometry *geom) const;
+  void BuildIndices(const AliEMCALGeometry *geom);
+  void BuildPositions(const AliEMCALGeometry *geom);
+
+  const AliEMCALGeometry             *fGeometry;       //!<! Geometry of the table
+  std::string                         fGeometryName;   //!<! Name of the geometry of the table
+  std::vector<const TGeoHMatrix *>    fMatrices;       //!<! Supermodule matrices of the geometry when the positions were filled
+  const TGeoManager                  *fGeoManager;     //!<! Geometry manager when the positions were filled
+  Bool_t                              fHasPositions;   //!<! Positions are filled
+  std::vector<Short_t>                fSuperModule;    //!<! Supermodule by absolute ID, -1 if the cell does not exist
+  std::vector<Short_t>                fColumn;         //!<! Column in the supermodule by absolute ID
+  std::vector<Short_t>                fRow;            //!<! Row in the supermodule by absolute ID
+  std::vector<Double_t>               fX;              //!<! Global x by absolute ID
+  std::vector<Double_t>               fY;              //!<! Global y by absolute ID
+  std::vector<Double_t>               fZ;              //!<! Global z by absolute ID
+  std::vector<Double_t>               fEta;            //!<! \f$\eta\f$ by absolute ID
+  std::vector<Double_t>               fPhi;            //!<! \f$\phi\f$ by absolute ID
+
+  static std::vector<std::unique_ptr<AliEmcalCellGeometryTable> > fgTables;   //!<! Tables of all geometries
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalCellGeometryTable, 0);
+  /// \endcond
+};
+
+}
+
+}
+
+#endif /* ALIEMCALCELLGEOMETRYTABLE_H */
@@ -0,0 +1,432 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <iostream>
+#include <TClonesArray.h>
+#include <TGeoMatrix.h>
+#include <TObjArray.h>
+
+#include "AliAODCaloCells.h"
+#include "AliAODCaloCluster.h"
+#include "AliEMCALGeometry.h"
+#include "AliEMCALRecoUtils.h"
+#include "AliLog.h"
+#include "AliVCaloCells.h"
+#include "AliVCluster.h"
+#include "AliEmcalClusterCellArrays.h"
+
+/// \cond CLASSIMP
+ClassImp(PWG::EMCAL::AliEmcalClusterCellArrays)
+ClassImp(PWG::EMCAL::TestAliEmcalClusterCellArrays)
+/// \endcond
+
+using namespace PWG::EMCAL;
+
+AliEmcalClusterCellArrays::AliEmcalClusterCellArrays():
+  fCells(nullptr),
+  fClusters(),
+  fFirstCell(1, 0),
+  fAbsId(),
+  fFraction(),
+  fAmplitude(),
+  fTime(),
+  fHighGain()
+{
+}
+
+void AliEmcalClusterCellArrays::Clear(){
+  fCells = nullptr;
+  fClusters.clear();
+  fFirstCell.assign(1, 0);
+  fAbsId.clear();
+  fFraction.clear();
+  fAmplitude.clear();
+  fTime.clear();
+  fHighGain.clear();
+}
+
+void AliEmcalClusterCellArrays::Fill(AliVCaloCells *cells, const TObjArray *clusters){
+  Clear();
+  fCells = cells;
+  if(!clusters) return;
+  for(int icl = 0; icl < clusters->GetEntriesFast(); icl++){
+    AliVCluster *cluster = static_cast<AliVCluster *>(clusters->UncheckedAt(icl));
+    if(!cluster || !cluster->IsEMCAL()) continue;
+    AddCluster(cluster);
+  }
+}
+
+void AliEmcalClusterCellArrays::Fill(AliVCaloCells *cells, AliVCluster *cluster){
+  Clear();
+  fCells = cells;
+  if(cluster) AddCluster(cluster);
+}
+
+void AliEmcalClusterCellArrays::AddCluster(AliVCluster *cluster){
+  fClusters.push_back(cluster);
+  const Int_t ncells = cluster->GetNCells();
+  Short_t cellNumber = -1;
+  Double_t amplitude = 0., time = 0., efrac = 0.;
+  Int_t mclabel = -1;
+  for(int icell = 0; icell < ncells; icell++){
+    Int_t absId = cluster->GetCellAbsId(icell);
+    Float_t fraction = cluster->GetCellAmplitudeFraction(icell);
+    if(fraction < 1e-4) fraction = 1.; // in case unfolding is off
+    // One lookup of the cell for amplitude, time and gain, cells not found are empty
+    Short_t pos = fCells->GetCellPosition(absId);
+    Bool_t found = pos >= 0 && fCells->GetCell(pos, cellNumber, amplitude, time, mclabel, efrac);
+    fAbsId.push_back(absId);
+    fFraction.push_back(fraction);
+    fAmplitude.push_back(found ? amplitude : 0.);
+    fTime.push_back(found ? time : 0.);
+    fHighGain.push_back(found ? fCells->GetHighGain(pos) : kFALSE);
+  }
+  fFirstCell.push_back(fAbsId.size());
+}
+
+bool TestAliEmcalClusterCellArrays::RunAllTests() const {
+  bool testresult = true;
+  testresult &= TestShowerShape();
+  testresult &= TestPosition();
+  testresult &= TestNonLinearity();
+  return testresult;
+}
+
+bool TestAliEmcalClusterCellArrays::TestShowerShape() const {
+  AliEMCALGeometry *geom = GetGeometry();
+  AliAODCaloCells cells("emcalCells", "emcalCells", AliVCaloCells::kEMCALCell);
+  TClonesArray batch("AliAODCaloCluster"), reference("AliAODCaloCluster");
+  MakeEvent(geom, cells, batch);
+  MakeEvent(geom, cells, reference);
+
+  AliEMCALRecoUtils recoUtils;
+  AliEmcalClusterCellArrays clustercells;
+  bool testresult = true;
+
+  clustercells.Fill(&cells, &batch);
+  recoUtils.RecalculateClusterShowerShapeParameters(geom, clustercells);
+  for(int icl = 0; icl < reference.GetEntriesFast(); icl++){
+    AliVCluster *cluster = static_cast<AliVCluster *>(reference.At(icl));
+    if(cluster->IsEMCAL()) recoUtils.RecalculateClusterShowerShapeParameters(geom, &cells, cluster);
+  }
+  testresult &= CompareClusters(batch, reference, "shower shape");
+
+  // M02, M20 and dispersion of the EMCal clusters from AliEMCALRecoUtils before the
+  // batch recalculations, with the default cell cuts (50 MeV, 1000 ns)
+  const Double_t showershape[5][3] = {
+    {0.532404482, 0.523593366,     1.02762032},
+    {0.638193429, 0.11423853,      0.867469668},
+    {0.293150395, 0.120990179,     0.643499374},
+    {0.235606268, -1.34419875e-09, 0.485417962},
+    {0.239571273, 2.67624855e-05,  0.489460081}
+  };
+  for(int icl = 0; icl < 5; icl++){
+    const AliVCluster *cluster = static_cast<const AliVCluster *>(batch.At(icl));
+    testresult &= CompareValue(cluster->GetM02(), showershape[icl][0], icl, "M02", "shower shape, former implementation");
+    testresult &= CompareValue(cluster->GetM20(), showershape[icl][1], icl, "M20", "shower shape, former implementation");
+    testresult &= CompareValue(cluster->GetDispersion(), showershape[icl][2], icl, "dispersion", "shower shape, former implementation");
+  }
+
+  // Cell cuts on energy and time (ns), the late cell is removed
+  const Float_t cellEcut = 0.1, cellTimeCut = 100.;
+  std::vector<Float_t> enAfterCuts;
+  clustercells.Fill(&cells, &batch);
+  recoUtils.RecalculateClusterShowerShapeParametersWithCellCuts(geom, clustercells, cellEcut, cellTimeCut, 0, enAfterCuts);
+  for(int icl = 0, iemcal = 0; icl < reference.GetEntriesFast(); icl++){
+    AliVCluster *cluster = static_cast<AliVCluster *>(reference.At(icl));
+    if(!cluster->IsEMCAL()) continue;
+    Float_t enreference = 0.;
+    recoUtils.RecalculateClusterShowerShapeParametersWithCellCuts(geom, &cells, cluster, cellEcut, cellTimeCut, 0, enreference);
+    if(enAfterCuts[iemcal] != enreference) {
+      AliErrorStream() << "Shower shape with cell cuts, cluster " << icl << ": energy after cuts " << enAfterCuts[iemcal] << ", expected " << enreference << std::endl;
+      testresult = false;
+    }
+    iemcal++;
+  }
+  testresult &= CompareClusters(batch, reference, "shower shape with cell cuts");
+
+  // Same with the cell cuts, and the energy after the cuts
+  const Double_t showershapecuts[5][4] = {
+    {0.568142593, 0.399532944,     0.983711243, 5.74999952},
+    {0.638193429, 0.11423853,      0.867469668, 2.6500001},
+    {0.293150395, 0.120990179,     0.643499374, 1.96000016},
+    {0.235606268, -1.34419875e-09, 0.485417962, 0.949999988},
+    {0.239571273, 2.67624855e-05,  0.489460081, 1.85000002}
+  };
+  for(int icl = 0; icl < 5; icl++){
+    const AliVCluster *cluster = static_cast<const AliVCluster *>(batch.At(icl));
+    testresult &= CompareValue(cluster->GetM02(), showershapecuts[icl][0], icl, "M02", "shower shape with cell cuts, former implementation");
+    testresult &= CompareValue(cluster->GetM20(), showershapecuts[icl][1], icl, "M20", "shower shape with cell cuts, former implementation");
+    testresult &= CompareValue(cluster->GetDispersion(), showershapecuts[icl][2], icl, "dispersion", "shower shape with cell cuts, former implementation");
+    testresult &= CompareValue(enAfterCuts[icl], showershapecuts[icl][3], icl, "energy after cuts", "shower shape with cell cuts, former implementation");
+  }
+  return testresult;
+}
+
+bool TestAliEmcalClusterCellArrays::TestPosition() const {
+  AliEMCALGeometry *geom = GetGeometry();
+  AliAODCaloCells cells("emcalCells", "emcalCells", AliVCaloCells::kEMCALCell);
+  AliEMCALRecoUtils recoUtils;
+  AliEmcalClusterCellArrays clustercells;
+  bool testresult = true;
+  for(auto algorithm : {AliEMCALRecoUtils::kPosTowerGlobal, AliEMCALRecoUtils::kPosTowerIndex}){
+    TClonesArray batch("AliAODCaloCluster"), reference("AliAODCaloCluster");
+    MakeEvent(geom, cells, batch);
+    MakeEvent(geom, cells, reference);
+    recoUtils.SetPositionAlgorithm(algorithm);
+
+    clustercells.Fill(&cells, &batch);
+    recoUtils.RecalculateClusterPosition(geom, clustercells);
+    for(int icl = 0; icl < reference.GetEntriesFast(); icl++){
+      AliVCluster *cluster = static_cast<AliVCluster *>(reference.At(icl));
+      if(cluster->IsEMCAL()) recoUtils.RecalculateClusterPosition(geom, &cells, cluster);
+    }
+    testresult &= CompareClusters(batch, reference, algorithm == AliEMCALRecoUtils::kPosTowerGlobal ? "position from global towers" : "position from tower indices");
+
+    // Former per-cluster implementation
+    TClonesArray former("AliAODCaloCluster");
+    MakeEvent(geom, cells, former);
+    for(int icl = 0; icl < former.GetEntriesFast(); icl++){
+      AliVCluster *cluster = static_cast<AliVCluster *>(former.At(icl));
+      if(cluster->IsEMCAL()) RecalculatePositionReference(recoUtils, geom, &cells, cluster);
+    }
+    testresult &= CompareClusters(batch, former, algorithm == AliEMCALRecoUtils::kPosTowerGlobal ? "position from global towers, former implementation" : "position from tower indices, former implementation");
+  }
+  return testresult;
+}
+
+bool TestAliEmcalClusterCellArrays::TestNonLinearity() const {
+  AliEMCALGeometry *geom = GetGeometry();
+  AliAODCaloCells cells("emcalCells", "emcalCells", AliVCaloCells::kEMCALCell);
+  TClonesArray clusters("AliAODCaloCluster");
+  MakeEvent(geom, cells, clusters);
+
+  AliEMCALRecoUtils recoUtils;
+  recoUtils.SetNonLinearityFunction(AliEMCALRecoUtils::kBeamTestCorrectedv3);
+  AliEmcalClusterCellArrays clustercells;
+  clustercells.Fill(&cells, &clusters);
+  std::vector<Float_t> energies;
+  recoUtils.CorrectClusterEnergyLinearity(clustercells, energies);
+
+  bool testresult = true;
+  if(energies.size() != static_cast<UInt_t>(clustercells.GetNumberOfClusters())) {
+    AliErrorStream() << "Non-linearity: " << energies.size() << " energies for " << clustercells.GetNumberOfClusters() << " clusters" << std::endl;
+    return false;
+  }
+  for(int icl = 0; icl < clustercells.GetNumberOfClusters(); icl++){
+    Float_t reference = recoUtils.CorrectClusterEnergyLinearity(clustercells.GetCluster(icl));
+    if(energies[icl] != reference){
+      AliErrorStream() << "Non-linearity, cluster " << icl << ": energy " << energies[icl] << ", expected " << reference << std::endl;
+      testresult = false;
+    }
+  }
+
+  // Corrected energies from AliEMCALRecoUtils before the batch recalculations
+  const Double_t corrected[5] = {5.91329384, 2.64680409, 1.98186684, 0.99892205, 1.87582433};
+  for(int icl = 0; icl < 5; icl++) testresult &= CompareValue(energies[icl], corrected[icl], icl, "energy", "non-linearity, former implementation");
+  return testresult;
+}
+
+AliEMCALGeometry *TestAliEmcalClusterCellArrays::GetGeometry() const {
+  AliEMCALGeometry *geom = AliEMCALGeometry::GetInstance("EMCAL_COMPLETE12SMV1_DCAL_8SM");
+  // Ideal super module matrices, the positions only need to be the same in both recalculations
+  TGeoHMatrix identity;
+  for(int ism = 0; ism < geom->GetNumberOfSuperModules(); ism++) {
+    if(!geom->GetMatrixForSuperModuleFromArray(ism)) geom->SetMisalMatrix(&identity, ism);
+  }
+  return geom;
+}
+
+void TestAliEmcalClusterCellArrays::MakeEvent(AliEMCALGeometry *geom, AliAODCaloCells &cells, TClonesArray &clusters) const {
+  // (super module, row, column, amplitude, time, fraction in the cluster), clusters separated by a negative super module
+  struct TestCell { Int_t fSM, fRow, fCol; Double_t fAmplitude, fTime, fFraction; };
+  const std::vector<TestCell> testcells = {
+    {0,  9,  9, 0.20, 0., 0.}, {0,  9, 10, 0.50, 0., 0.}, {0,  9, 11, 0.21, 0., 0.},    // 3x3 shower
+    {0, 10,  9, 0.52, 0., 0.}, {0, 10, 10, 3.00, 0., 0.}, {0, 10, 11, 0.54, 0., 0.},
+    {0, 11,  9, 0.22, 0., 0.}, {0, 11, 10, 0.56, 0., 0.}, {0, 11, 11, 0.25, 500e-9, 0.},
+    {-1, 0, 0, 0., 0., 0.},
+    {0,  5, 46, 0.30, 0., 0.}, {0,  5, 47, 1.20, 0., 0.}, {1,  5,  0, 0.90, 0., 0.}, {1,  6,  0, 0.25, 0., 0.}, // shared by SM 0 and 1
+    {-1, 0, 0, 0., 0., 0.},
+    {3, 12, 20, 2.00, 0., 0.6}, {3, 12, 21, 1.10, 0., 0.4}, {3, 13, 20, 0.40, 0., 0.8},    // unfolded
+    {-1, 0, 0, 0., 0., 0.},
+    {4, 20, 30, 0.80, 0., 0.}, {4, 20, 31, -1., 0., 0.}, {4, 21, 30, 0.15, 0., 0.},       // cell missing in the cell list
+    {-1, 0, 0, 0., 0., 0.},
+    {12, 3, 20, 1.50, 0., 0.}, {12, 4, 20, 0.35, 0., 0.}                                   // DCal
+  };
+
+  cells.DeleteContainer();
+  Int_t ncells = 0;
+  for(const auto &tc : testcells) if(tc.fAmplitude > 0) ncells++;
+  cells.CreateContainer(ncells);
+  Int_t icell = 0;
+  for(const auto &tc : testcells) {
+    if(tc.fSM >= 0 && tc.fAmplitude > 0) cells.SetCell(icell++, geom->GetAbsCellIdFromCellIndexes(tc.fSM, tc.fRow, tc.fCol), tc.fAmplitude, tc.fTime);
+  }
+  cells.Sort();
+
+  std::vector<UShort_t> absIds;
+  std::vector<Double32_t> fractions;
+  Double_t energy = 0.;
+  auto addCluster = [&clusters, &absIds, &fractions, &energy]() {
+    AliAODCaloCluster *cluster = new(clusters[clusters.GetEntriesFast()]) AliAODCaloCluster;
+    cluster->SetType(AliVCluster::kEMCALClusterv1);
+    cluster->SetE(energy);
+    cluster->SetNCells(absIds.size());
+    cluster->SetCellsAbsId(absIds.data());
+    cluster->SetCellsAmplitudeFraction(fractions.data());
+    absIds.clear();
+    fractions.clear();
+    energy = 0.;
+  };
+  for(const auto &tc : testcells) {
+    if(tc.fSM < 0) {
+      addCluster();
+      continue;
+    }
+    absIds.push_back(geom->GetAbsCellIdFromCellIndexes(tc.fSM, tc.fRow, tc.fCol));
+    fractions.push_back(tc.fFraction);
+    if(tc.fAmplitude > 0) energy += tc.fAmplitude * (tc.fFraction > 0 ? tc.fFraction : 1.);
+  }
+  addCluster();
+
+  // PHOS cluster, skipped by the recalculations
+  AliAODCaloCluster *phoscluster = new(clusters[clusters.GetEntriesFast()]) AliAODCaloCluster;
+  phoscluster->SetType(AliVCluster::kPHOSNeutral);
+  phoscluster->SetE(1.);
+}
+
+bool TestAliEmcalClusterCellArrays::CompareClusters(const TClonesArray &test, const TClonesArray &reference, const char *testname) const {
+  bool testresult = true;
+  for(int icl = 0; icl < reference.GetEntriesFast(); icl++){
+    const AliVCluster *testcluster = static_cast<const AliVCluster *>(test.At(icl)),
+                      *refcluster = static_cast<const AliVCluster *>(reference.At(icl));
+    Float_t testpos[3], refpos[3];
+    testcluster->GetPosition(testpos);
+    refcluster->GetPosition(refpos);
+    if(testcluster->GetM02() != refcluster->GetM02() || testcluster->GetM20() != refcluster->GetM20() ||
+       testcluster->GetDispersion() != refcluster->GetDispersion() || testcluster->E() != refcluster->E() ||
+       testpos[0] != refpos[0] || testpos[1] != refpos[1] || testpos[2] != refpos[2]) {
+      AliErrorStream() << testname << ", cluster " << icl << ": M02 " << testcluster->GetM02() << ", M20 " << testcluster->GetM20()
+                       << ", dispersion " << testcluster->GetDispersion() << ", position (" << testpos[0] << ", " << testpos[1] << ", " << testpos[2]
+                       << "), expected M02 " << refcluster->GetM02() << ", M20 " << refcluster->GetM20() << ", dispersion " << refcluster->GetDispersion()
+                       << ", position (" << refpos[0] << ", " << refpos[1] << ", " << refpos[2] << ")" << std::endl;
+      testresult = false;
+    }
+  }
+  return testresult;
+}
+
+bool TestAliEmcalClusterCellArrays::CompareValue(Double_t value, Double_t reference, Int_t icl, const char *quantity, const char *testname) const {
+  // The reference values are printed with 9 significant digits from single precision results
+  if(TMath::Abs(value - reference) <= 1e-6 + 1e-6 * TMath::Abs(reference)) return true;
+  AliErrorStream() << testname << ", cluster " << icl << ": " << quantity << " " << value << ", expected " << reference << std::endl;
+  return false;
+}
+
+void TestAliEmcalClusterCellArrays::RecalculatePositionReference(AliEMCALRecoUtils &recoUtils, const AliEMCALGeometry *geom, AliVCaloCells *cells, AliVCluster *clu) const {
+  // Per-cluster position recalculation of AliEMCALRecoUtils before the batch recalculations,
+  // geometry lookups included, for the settings of the test (no recalibration)
+  Float_t clEnergy = clu->E();
+  if (clEnergy <= 0) return;
+
+  // Cell with the maximum energy (GetMaxEnergyCell)
+  Int_t absIdMax = -1, iSupModMax = -1;
+  Int_t iTower = -1, iIphi = -1, iIeta = -1;
+  Double_t eMax = -1.;
+  for (Int_t iDig=0; iDig< clu->GetNCells(); iDig++) {
+    Int_t cellAbsId = clu->GetCellAbsId(iDig);
+    Float_t fraction = clu->GetCellAmplitudeFraction(iDig);
+    if (fraction < 1e-4) fraction = 1.;
+    Double_t eCell = cells->GetCellAmplitude(cellAbsId)*fraction;
+    if (eCell > eMax) {
+      eMax = eCell;
+      absIdMax = cellAbsId;
+    }
+  }
+  geom->GetCellIndex(absIdMax,iSupModMax,iTower,iIphi,iIeta);
+
+  Float_t *misalTransShift = recoUtils.GetMisalTransShiftArray();
+  if (recoUtils.GetPositionAlgorithm() == AliEMCALRecoUtils::kPosTowerGlobal) {
+    // RecalculateClusterPositionFromTowerGlobal
+    Float_t weight = 0., totalWeight = 0.;
+    Float_t newPos[3] = {-1.,-1.,-1.};
+    Double_t pLocal[3], pGlobal[3];
+    Double_t depth = recoUtils.GetDepth(clEnergy,recoUtils.GetParticleType(),iSupModMax);
+    for (Int_t iDig=0; iDig< clu->GetNCells(); iDig++) {
+      Int_t absId = clu->GetCellAbsId(iDig);
+      Float_t fraction = clu->GetCellAmplitudeFraction(iDig);
+      if (fraction < 1e-4) fraction = 1.;
+      Double_t eCell = cells->GetCellAmplitude(absId)*fraction;
+      weight = recoUtils.GetCellWeight(eCell,clEnergy);
+      totalWeight += weight;
+      geom->RelPosCellInSModule(absId,depth,pLocal[0],pLocal[1],pLocal[2]);
+      geom->GetGlobal(pLocal,pGlobal,iSupModMax);
+      for (int i=0; i<3; i++) newPos[i] += (weight*pGlobal[i]);
+    }
+    if (totalWeight>0) {
+      for (int i=0; i<3; i++) newPos[i] /= totalWeight;
+    }
+    Int_t ishift = iSupModMax > 1 ? 3 : 0;
+    for (int i=0; i<3; i++) newPos[i] += misalTransShift[ishift+i];
+    clu->SetPosition(newPos);
+  }
+  else if (recoUtils.GetPositionAlgorithm() == AliEMCALRecoUtils::kPosTowerIndex) {
+    // RecalculateClusterPositionFromTowerIndex. As it was, the depth is evaluated for the
+    // super module index before the cell loop (-1), the super module of a cell is compared
+    // with the one of the previous cell, and clusters in different super modules take the
+    // indices of their last cell
+    Int_t iSupMod = -1, iphi = -1, ieta = -1;
+    Float_t depth = recoUtils.GetDepth(clEnergy,recoUtils.GetParticleType(),iSupMod);
+    Float_t weight = 0., weightedCol = 0., weightedRow = 0., totalWeight = 0.;
+    Bool_t areInSameSM = kTRUE;
+    Int_t startingSM = -1;
+    for (Int_t iDig=0; iDig< clu->GetNCells(); iDig++) {
+      Int_t absId = clu->GetCellAbsId(iDig);
+      Float_t fraction = clu->GetCellAmplitudeFraction(iDig);
+      if (fraction < 1e-4) fraction = 1.;
+      if      (iDig==0)  startingSM = iSupMod;
+      else if (iSupMod != startingSM) areInSameSM = kFALSE;
+      geom->GetCellIndex(absId,iSupMod,iTower,iIphi,iIeta);
+      geom->GetCellPhiEtaIndexInSModule(iSupMod,iTower,iIphi,iIeta,iphi,ieta);
+      Double_t eCell = cells->GetCellAmplitude(absId)*fraction;
+      weight = recoUtils.GetCellWeight(eCell,clEnergy);
+      if (weight < 0) weight = 0;
+      totalWeight += weight;
+      weightedCol += ieta*weight;
+      weightedRow += iphi*weight;
+    }
+    Float_t xyzNew[] = {-1.,-1.,-1.};
+    if (areInSameSM == kTRUE) {
+      weightedCol = weightedCol/totalWeight;
+      weightedRow = weightedRow/totalWeight;
+      geom->RecalculateTowerPosition(weightedRow, weightedCol, iSupModMax, depth, misalTransShift, recoUtils.GetMisalRotShiftArray(), xyzNew);
+    }
+    else {
+      geom->RecalculateTowerPosition(iphi, ieta, iSupModMax, depth, misalTransShift, recoUtils.GetMisalRotShiftArray(), xyzNew);
+    }
+    clu->SetPosition(xyzNew);
+  }
+}
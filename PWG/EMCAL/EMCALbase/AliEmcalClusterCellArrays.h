@@ -0,0 +1,195 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALCLUSTERCELLARRAYS_H
+#define ALIEMCALCLUSTERCELLARRAYS_H
+
+#include <vector>
+#include <Rtypes.h>
+#include <TObject.h>
+
+class AliAODCaloCells;
+class AliEMCALGeometry;
+class AliEMCALRecoUtils;
+class AliVCaloCells;
+class AliVCluster;
+class TClonesArray;
+class TObjArray;
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class AliEmcalClusterCellArrays
+ * @brief Cells of the EMCal clusters of an event, as structure of arrays
+ * @ingroup EMCALCOREFW
+ *
+ * The cells of all clusters of an event are read once into contiguous arrays
+ * (absolute ID, amplitude fraction, amplitude, time, high gain flag of the cell),
+ * cluster after cluster, with the range of each cluster. The batch overloads of
+ * the cluster recalculations in AliEMCALRecoUtils run on these arrays, so that the
+ * cells are not looked up in AliVCaloCells again by every recalculation and pass.
+ *
+ * Amplitude fractions below 1e-4 (unfolding off) are stored as 1, as used by all
+ * recalculations. The cells and the cell content of the clusters must not change
+ * between Fill() and the recalculations; the cluster energies can.
+ *
+ * ~~~{.cxx}
+ * PWG::EMCAL::AliEmcalClusterCellArrays clustercells;
+ * clustercells.Fill(event->GetEMCALCells(), clusters);
+ * recoUtils->RecalculateClusterShowerShapeParameters(geom, clustercells);
+ * recoUtils->RecalculateClusterPosition(geom, clustercells);
+ * ~~~
+ */
+class AliEmcalClusterCellArrays {
+public:
+  AliEmcalClusterCellArrays();
+  virtual ~AliEmcalClusterCellArrays() {}
+
+  /**
+   * @brief Read the cells of all EMCal clusters of an array
+   * @param[in] cells Cells of the event
+   * @param[in] clusters Clusters of the event, clusters which are not EMCal clusters are skipped
+   */
+  void Fill(AliVCaloCells *cells, const TObjArray *clusters);
+
+  /**
+   * @brief Read the cells of a single cluster
+   * @param[in] cells Cells of the event
+   * @param[in] cluster Cluster
+   */
+  void Fill(AliVCaloCells *cells, AliVCluster *cluster);
+
+  /**
+   * @brief Remove all clusters
+   */
+  void Clear();
+
+  AliVCaloCells *GetCells()                       const { return fCells; }
+  Int_t          GetNumberOfClusters()            const { return fClusters.size(); }
+  AliVCluster   *GetCluster(Int_t icl)            const { return fClusters[icl]; }
+  /// Index of the first cell of a cluster in the cell arrays
+  Int_t          GetFirstCell(Int_t icl)          const { return fFirstCell[icl]; }
+  Int_t          GetNumberOfCells(Int_t icl)      const { return fFirstCell[icl+1] - fFirstCell[icl]; }
+
+  Int_t          GetCellAbsId(Int_t icell)        const { return fAbsId[icell]; }
+  Float_t        GetCellFraction(Int_t icell)     const { return fFraction[icell]; }
+  Double_t       GetCellAmplitude(Int_t icell)    const { return fAmplitude[icell]; }
+  Double_t       GetCellTime(Int_t icell)         const { return fTime[icell]; }
+  Bool_t         GetCellHighGain(Int_t icell)     const { return fHighGain[icell]; }
+
+private:
+  void AddCluster(AliVCluster *cluster);
+
+  AliVCaloCells               *fCells;        //!<! Cells of the event
+  std::vector<AliVCluster *>   fClusters;     //!<! Clusters, in the order read
+  std::vector<Int_t>           fFirstCell;    //!<! First cell of each cluster, with one entry past the last cluster
+  std::vector<Int_t>           fAbsId;        //!<! Absolute ID of the cell
+  std::vector<Float_t>         fFraction;     //!<! Amplitude fraction of the cell in the cluster
+  std::vector<Double_t>        fAmplitude;    //!<! Amplitude of the cell
+  std::vector<Double_t>        fTime;         //!<! Time of the cell
+  std::vector<UChar_t>         fHighGain;     //!<! High gain flag of the cell
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalClusterCellArrays, 0);
+  /// \endcond
+};
+
+/**
+ * @class TestAliEmcalClusterCellArrays
+ * @brief Unit test for the batch cluster recalculations of AliEMCALRecoUtils on AliEmcalClusterCellArrays
+ * @ingroup EMCALCOREFW
+ *
+ * Runs the batch recalculations on the cell arrays of all clusters of an event and
+ * the per-cluster recalculations on a copy of the same clusters. Both must give
+ * identical results. The event contains a 3x3 shower, a cluster shared between the
+ * super modules of a pair, an unfolded cluster, a cluster with a cell missing in the
+ * cell list, a DCal cluster and a PHOS cluster which must be skipped.
+ *
+ * As both paths share one implementation, the results are also compared with the
+ * ones of AliEMCALRecoUtils before the batch recalculations were introduced: the
+ * shower shapes (cell index locations) and the non-linearity do not depend on the
+ * geometry and are stored as reference values, the positions are recalculated with
+ * a copy of the former per-cluster algorithms.
+ */
+class TestAliEmcalClusterCellArrays : public TObject {
+public:
+  TestAliEmcalClusterCellArrays() : TObject() {}
+  virtual ~TestAliEmcalClusterCellArrays() {}
+
+  /**
+   * @brief Run all unit tests for the batch recalculations
+   *
+   * @return true All tests passed
+   * @return false At least one test failed
+   */
+  bool RunAllTests() const;
+
+  /**
+   * @brief Shower shape, with and without cell cuts
+   *
+   * Compares \f$\sigma_{long}^{2}\f$, \f$\sigma_{short}^{2}\f$, the dispersion and the
+   * energy after the cell cuts.
+   *
+   * @return true Same results for all clusters
+   * @return false At least one cluster different
+   */
+  bool TestShowerShape() const;
+
+  /**
+   * @brief Position, with the global and the index tower algorithms
+   *
+   * @return true Same positions for all clusters
+   * @return false At least one cluster different
+   */
+  bool TestPosition() const;
+
+  /**
+   * @brief Non-linearity correction of the cluster energies
+   *
+   * @return true Same energies for all clusters
+   * @return false At least one cluster different
+   */
+  bool TestNonLinearity() const;
+
+private:
+  AliEMCALGeometry *GetGeometry() const;
+  void MakeEvent(AliEMCALGeometry *geom, AliAODCaloCells &cells, TClonesArray &clusters) const;
+  bool CompareClusters(const TClonesArray &test, const TClonesArray &reference, const char *testname) const;
+  bool CompareValue(Double_t value, Double_t reference, Int_t icl, const char *quantity, const char *testname) const;
+  void RecalculatePositionReference(AliEMCALRecoUtils &recoUtils, const AliEMCALGeometry *geom, AliVCaloCells *cells, AliVCluster *cluster) const;
+
+  /// \cond CLASSIMP
+  ClassDef(TestAliEmcalClusterCellArrays, 1);
+  /// \endcond
+};
+
+}
+
+}
+
+#endif /* ALIEMCALCLUSTERCELLARRAYS_H */
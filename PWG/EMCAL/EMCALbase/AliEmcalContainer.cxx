@@ -55,6 +55,16 @@ AliEmcalContainer::AliEmcalContainer():
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fUseAcceptanceCache(kTRUE),
+  fAcceptanceCacheValid(kFALSE),
+  fAcceptanceCacheArray(0),
+  fCachedRejection(),
+  fCachedAcceptIndices(),
+  fCachedMomStatus(),
+  fCachedPx(),
+  fCachedPy(),
+  fCachedPz(),
+  fCachedE(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -92,6 +102,16 @@ AliEmcalContainer::AliEmcalContainer(const char *name):
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fUseAcceptanceCache(kTRUE),
+  fAcceptanceCacheValid(kFALSE),
+  fAcceptanceCacheArray(0),
+  fCachedRejection(),
+  fCachedAcceptIndices(),
+  fCachedMomStatus(),
+  fCachedPx(),
+  fCachedPy(),
+  fCachedPz(),
+  fCachedE(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -142,6 +162,8 @@ void AliEmcalContainer::GetVertexFromEvent(const AliVEvent * event)
  */
 void AliEmcalContainer::SetArray(const AliVEvent *event)
 {
+  InvalidateAcceptanceCache();
+
   // Handling of default containers
   if(fClArrayName == "usedefault"){
     fClArrayName = GetDefaultArrayName(event);
@@ -184,6 +206,8 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
  */
 void AliEmcalContainer::NextEvent(const AliVEvent * event)
 {
+  InvalidateAcceptanceCache();
+
   // Get the right event (either the current event of the embedded event)
   event = AliEmcalContainerUtils::GetEvent(event, fIsEmbedding);
 
@@ -197,6 +221,7 @@ void AliEmcalContainer::NextEvent(const AliVEvent * event)
  * @return Number of accepted events in the container
  */
 Int_t AliEmcalContainer::GetNAcceptEntries() const{
+  if (BuildAcceptanceCache()) return fCachedAcceptIndices.size();
   Int_t result = 0;
   for(int index = 0; index < GetNEntries(); index++){
     UInt_t rejectionReason = 0;
@@ -205,6 +230,104 @@ Int_t AliEmcalContainer::GetNAcceptEntries() const{
   return result;
 }
 
+/**
+ * Build the per-event acceptance cache: rejection reason and momentum of
+ * each entry, as well as the list of accepted entries. The cache is filled
+ * at the first request after NextEvent and serves all iterators and counters
+ * until the next event. It is invalidated when the selection is changed via
+ * the setters of this class, or when the underlying array changes its size.
+ * Derived classes or tasks modifying the objects or the selection in a
+ * different way within an event need to call InvalidateAcceptanceCache().
+ * @return True if the cache can be used, false if the cache is disabled
+ */
+Bool_t AliEmcalContainer::BuildAcceptanceCache() const
+{
+  if (!fUseAcceptanceCache || !fClArray) return kFALSE;
+  Int_t nentries = GetNEntries();
+  if (fAcceptanceCacheValid && fAcceptanceCacheArray == fClArray && (Int_t)fCachedRejection.size() == nentries) return kTRUE;
+
+  fCachedRejection.resize(nentries);
+  fCachedMomStatus.resize(nentries);
+  fCachedPx.resize(nentries);
+  fCachedPy.resize(nentries);
+  fCachedPz.resize(nentries);
+  fCachedE.resize(nentries);
+  fCachedAcceptIndices.clear();
+  fCachedAcceptIndices.reserve(nentries);
+
+  AliTLorentzVector mom;
+  for (Int_t index = 0; index < nentries; index++) {
+    fCachedMomStatus[index] = GetMomentum(mom, index);
+    fCachedPx[index] = mom.Px();
+    fCachedPy[index] = mom.Py();
+    fCachedPz[index] = mom.Pz();
+    fCachedE[index] = mom.E();
+
+    UInt_t rejectionReason = 0;
+    if (AcceptObject(index, rejectionReason)) {
+      fCachedRejection[index] = 0;
+      fCachedAcceptIndices.push_back(index);
+    }
+    else {
+      // keep a non-zero rejection reason for rejected entries
+      fCachedRejection[index] = rejectionReason ? rejectionReason : kNullObject;
+    }
+  }
+
+  fAcceptanceCacheArray = fClArray;
+  fAcceptanceCacheValid = kTRUE;
+  return kTRUE;
+}
+
+/**
+ * Check whether the entry at the given index is accepted, using the
+ * acceptance cache if enabled.
+ * @param[in] i Index of the entry
+ * @param[out] rejectionReason Reason why the entry was rejected
+ * @return True if the entry is accepted, false otherwise
+ */
+Bool_t AliEmcalContainer::AcceptObjectCached(Int_t i, UInt_t &rejectionReason) const
+{
+  if (i < 0 || i >= GetNEntries() || !BuildAcceptanceCache()) return AcceptObject(i, rejectionReason);
+  rejectionReason |= fCachedRejection[i];
+  return fCachedRejection[i] == 0;
+}
+
+/**
+ * Get the momentum of the entry at the given index. The value is served
+ * from the acceptance cache if it was already built for this event,
+ * otherwise it is calculated via GetMomentum.
+ * @param[out] mom Momentum vector
+ * @param[in] i Index of the entry
+ * @return Status of the momentum calculation
+ */
+Bool_t AliEmcalContainer::GetCachedMomentum(TLorentzVector &mom, Int_t i) const
+{
+  if (!fUseAcceptanceCache || !fAcceptanceCacheValid || fAcceptanceCacheArray != fClArray ||
+      i < 0 || i >= (Int_t)fCachedRejection.size() || (Int_t)fCachedRejection.size() != GetNEntries()) {
+    return GetMomentum(mom, i);
+  }
+  mom.SetPxPyPzE(fCachedPx[i], fCachedPy[i], fCachedPz[i], fCachedE[i]);
+  return fCachedMomStatus[i];
+}
+
+/**
+ * Get the indices of the accepted entries in the current event. In case
+ * the acceptance cache is disabled the list is rebuilt at each call.
+ * @return Indices of the accepted entries
+ */
+const std::vector<Int_t> &AliEmcalContainer::GetAcceptedIndices() const
+{
+  if (!BuildAcceptanceCache()) {
+    fCachedAcceptIndices.clear();
+    for (Int_t index = 0; index < GetNEntries(); index++) {
+      UInt_t rejectionReason = 0;
+      if (AcceptObject(index, rejectionReason)) fCachedAcceptIndices.push_back(index);
+    }
+  }
+  return fCachedAcceptIndices;
+}
+
 /**
  * Get the index in the container from a given label
  * @param lab Label to check
@@ -11,6 +11,7 @@ class AliVEvent;
 class AliNamedArrayI;
 class AliVParticle;
 
+#include <vector>
 #include <TNamed.h>
 #include <TClonesArray.h>
 
@@ -151,28 +152,34 @@ class AliEmcalContainer : public TObject {
   virtual Bool_t              AcceptObject(Int_t i, UInt_t &rejectionReason) const = 0;
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const = 0;
   Int_t                       GetNAcceptEntries() const;
+  Bool_t                      AcceptObjectCached(Int_t i, UInt_t &rejectionReason) const;
+  Bool_t                      GetCachedMomentum(TLorentzVector &mom, Int_t i) const;
+  const std::vector<Int_t>   &GetAcceptedIndices() const;
+  void                        InvalidateAcceptanceCache()           { fAcceptanceCacheValid = kFALSE    ; }
+  void                        SetUseAcceptanceCache(Bool_t b)       { fUseAcceptanceCache = b; InvalidateAcceptanceCache(); }
+  Bool_t                      GetUseAcceptanceCache()         const { return fUseAcceptanceCache        ; }
   void                        ResetCurrentID(Int_t i=-1)            { fCurrentID = i                    ; }
   virtual void                SetArray(const AliVEvent *event);
   void                        SetArrayName(const char *n)           { fClArrayName = n                  ; }
-  void                        SetVertex(Double_t *vtx)              { memcpy(fVertex, vtx, sizeof(Double_t) * 3); }
-  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; }
+  void                        SetVertex(Double_t *vtx)              { memcpy(fVertex, vtx, sizeof(Double_t) * 3); InvalidateAcceptanceCache(); }
+  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; InvalidateAcceptanceCache(); }
   void                        SetIsParticleLevel(Bool_t b)          { fIsParticleLevel = b              ; }
-  void                        SortArray()                           { fClArray->Sort()                  ; }
+  void                        SortArray()                           { fClArray->Sort()                  ; InvalidateAcceptanceCache(); }
 
   TClass*                     GetLoadedClass()                      { return fLoadedClass               ; }
   virtual void                NextEvent(const AliVEvent *event);
-  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; }
-  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; }
+  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; InvalidateAcceptanceCache(); }
+  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; InvalidateAcceptanceCache(); }
   void                        SetMCLabelRange(Int_t min, Int_t max)             { SetMinMCLabel(min)     ; SetMaxMCLabel(max)    ; }
-  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; }
-  void                        SetMinE(Double_t min)                     { fMinE   = min ; }
-  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; }
-  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; }
-  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; }
-  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; }
-  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; }
-  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; }
-  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; }
+  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; InvalidateAcceptanceCache(); }
+  void                        SetMinE(Double_t min)                     { fMinE   = min ; InvalidateAcceptanceCache(); }
+  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; InvalidateAcceptanceCache(); }
+  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; InvalidateAcceptanceCache(); }
+  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; InvalidateAcceptanceCache(); }
+  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; InvalidateAcceptanceCache(); }
+  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; InvalidateAcceptanceCache(); }
+  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; InvalidateAcceptanceCache(); }
+  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; InvalidateAcceptanceCache(); }
   void                        SetClassName(const char *clname);
   void                        SetIsEmbedding(Bool_t b)                  { fIsEmbedding = b ; }
   Bool_t                      GetIsEmbedding() const                    { return fIsEmbedding; }
@@ -203,6 +210,7 @@ class AliEmcalContainer : public TObject {
    */
   virtual TString             GetDefaultArrayName(const AliVEvent * const ev) const { return ""; }
   void                        GetVertexFromEvent(const AliVEvent * event);
+  Bool_t                      BuildAcceptanceCache() const;
 
   TString                     fName;                    ///< object name
   TString                     fClArrayName;             ///< name of branch
@@ -226,6 +234,17 @@ class AliEmcalContainer : public TObject {
   AliNamedArrayI             *fLabelMap;                //!<! Label-Index map
   Double_t                    fVertex[3];               //!<! event vertex array
   TClass                     *fLoadedClass;             //!<! Class of the objects contained in the TClonesArray
+  Bool_t                      fUseAcceptanceCache;      ///< Serve acceptance and momenta from the per-event cache
+
+  mutable Bool_t              fAcceptanceCacheValid;    //!<! Acceptance cache is up to date
+  mutable const TClonesArray *fAcceptanceCacheArray;    //!<! Array the acceptance cache was built for
+  mutable std::vector<UInt_t> fCachedRejection;         //!<! Rejection reason of each entry (0 if accepted)
+  mutable std::vector<Int_t>  fCachedAcceptIndices;     //!<! Indices of the accepted entries
+  mutable std::vector<Bool_t> fCachedMomStatus;         //!<! Status of the momentum of each entry
+  mutable std::vector<Double_t> fCachedPx;              //!<! Momentum of each entry, x component
+  mutable std::vector<Double_t> fCachedPy;              //!<! Momentum of each entry, y component
+  mutable std::vector<Double_t> fCachedPz;              //!<! Momentum of each entry, z component
+  mutable std::vector<Double_t> fCachedE;               //!<! Energy of each entry
 
  private:
   TString                     fClassName;               ///< name of the class in the TClonesArray
@@ -234,7 +253,7 @@ class AliEmcalContainer : public TObject {
   AliEmcalContainer& operator=(const AliEmcalContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalContainer,9);
+  ClassDef(AliEmcalContainer,10);
   /// \endcond
 };
 #endif
@@ -0,0 +1,223 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <algorithm>
+#include <iostream>
+
+#include <TMath.h>
+#include <TRandom3.h>
+#include <TVector2.h>
+
+#include "AliLog.h"
+#include "AliEmcalEtaPhiGrid.h"
+
+/// \cond CLASSIMP
+ClassImp(PWG::EMCAL::AliEmcalEtaPhiGrid)
+ClassImp(PWG::EMCAL::TestAliEmcalEtaPhiGrid)
+/// \endcond
+
+using namespace PWG::EMCAL;
+
+AliEmcalEtaPhiGrid::AliEmcalEtaPhiGrid():
+  fNbinsEta(1),
+  fEtaMin(-1.),
+  fEtaMax(1.),
+  fNbinsPhi(1),
+  fIds(),
+  fBins(),
+  fFirst(),
+  fSorted()
+{
+}
+
+AliEmcalEtaPhiGrid::AliEmcalEtaPhiGrid(Int_t nbinsEta, Double_t etaMin, Double_t etaMax, Int_t nbinsPhi):
+  fNbinsEta(1),
+  fEtaMin(-1.),
+  fEtaMax(1.),
+  fNbinsPhi(1),
+  fIds(),
+  fBins(),
+  fFirst(),
+  fSorted()
+{
+  SetBinning(nbinsEta, etaMin, etaMax, nbinsPhi);
+}
+
+void AliEmcalEtaPhiGrid::SetBinning(Int_t nbinsEta, Double_t etaMin, Double_t etaMax, Int_t nbinsPhi){
+  fNbinsEta = TMath::Max(nbinsEta, 1);
+  fEtaMin = etaMin;
+  fEtaMax = etaMax > etaMin ? etaMax : etaMin + 1.;
+  fNbinsPhi = TMath::Max(nbinsPhi, 1);
+  Clear();
+}
+
+void AliEmcalEtaPhiGrid::Clear(){
+  fIds.clear();
+  fBins.clear();
+  fFirst.assign(fNbinsEta * fNbinsPhi + 1, 0);
+  fSorted.clear();
+}
+
+void AliEmcalEtaPhiGrid::Add(Int_t id, Double_t eta, Double_t phi){
+  fIds.push_back(id);
+  fBins.push_back(EtaBin(eta) * fNbinsPhi + PhiBin(phi));
+}
+
+void AliEmcalEtaPhiGrid::Build(){
+  // Counting sort of the objects by bin, keeping the order in which they were added
+  const Int_t nbins = fNbinsEta * fNbinsPhi;
+  fFirst.assign(nbins + 1, 0);
+  for(auto bin : fBins) fFirst[bin + 1]++;
+  for(Int_t ibin = 0; ibin < nbins; ibin++) fFirst[ibin + 1] += fFirst[ibin];
+  fSorted.resize(fIds.size());
+  std::vector<Int_t> next(fFirst.begin(), fFirst.end() - 1);
+  for(size_t iobj = 0; iobj < fIds.size(); iobj++) fSorted[next[fBins[iobj]]++] = fIds[iobj];
+}
+
+void AliEmcalEtaPhiGrid::FindCandidates(Double_t eta, Double_t phi, Double_t maxDEta, Double_t maxDPhi, std::vector<Int_t> &candidates) const {
+  candidates.clear();
+  if(fSorted.empty()) return;
+
+  // Small margin such that objects exactly at the edge of the window are not lost to rounding
+  const Double_t margin = 1e-6;
+  Int_t etaFirst = EtaBin(eta - maxDEta - margin), etaLast = EtaBin(eta + maxDEta + margin);
+
+  Int_t phiFirst = 0, nPhi = fNbinsPhi;
+  if(maxDPhi + margin < TMath::Pi() && TMath::Abs(phi) < 1e6) {
+    const Double_t binWidth = TMath::TwoPi() / fNbinsPhi;
+    Double_t phiLow = TVector2::Phi_0_2pi(phi) - maxDPhi - margin;
+    phiFirst = TMath::FloorNint(phiLow / binWidth);
+    nPhi = TMath::FloorNint((phiLow + 2. * (maxDPhi + margin)) / binWidth) - phiFirst + 1;
+    if(nPhi > fNbinsPhi) nPhi = fNbinsPhi;
+    phiFirst = ((phiFirst % fNbinsPhi) + fNbinsPhi) % fNbinsPhi;
+  }
+
+  for(Int_t ieta = etaFirst; ieta <= etaLast; ieta++) {
+    for(Int_t iphi = 0; iphi < nPhi; iphi++) {
+      Int_t bin = ieta * fNbinsPhi + (phiFirst + iphi) % fNbinsPhi;
+      candidates.insert(candidates.end(), fSorted.begin() + fFirst[bin], fSorted.begin() + fFirst[bin + 1]);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+}
+
+Int_t AliEmcalEtaPhiGrid::EtaBin(Double_t eta) const {
+  if(!(eta > fEtaMin)) return 0;      // includes NaN
+  if(eta >= fEtaMax) return fNbinsEta - 1;
+  return TMath::Min(Int_t((eta - fEtaMin) / (fEtaMax - fEtaMin) * fNbinsEta), fNbinsEta - 1);
+}
+
+Int_t AliEmcalEtaPhiGrid::PhiBin(Double_t phi) const {
+  if(!(TMath::Abs(phi) < 1e6)) return 0;  // includes NaN
+  phi = TVector2::Phi_0_2pi(phi);
+  return TMath::Min(Int_t(phi / TMath::TwoPi() * fNbinsPhi), fNbinsPhi - 1);
+}
+
+bool TestAliEmcalEtaPhiGrid::RunAllTests() const {
+  bool testresult = true;
+  testresult &= TestRandomWindows();
+  testresult &= TestEdges();
+  return testresult;
+}
+
+bool TestAliEmcalEtaPhiGrid::TestRandomWindows() const {
+  TRandom3 rnd(1234);
+  AliEmcalEtaPhiGrid grid(20, -1., 1., 63);
+  const int nobjects = 500;
+  std::vector<Double_t> eta(nobjects), phi(nobjects);
+  for(int iobj = 0; iobj < nobjects; iobj++){
+    // Some objects outside of the range of the first axis, phi in any range
+    eta[iobj] = rnd.Uniform(-1.2, 1.2);
+    phi[iobj] = rnd.Uniform(-TMath::TwoPi(), 2. * TMath::TwoPi());
+    grid.Add(iobj, eta[iobj], phi[iobj]);
+  }
+  grid.Build();
+
+  bool testresult = true;
+  std::vector<Int_t> candidates;
+  for(int iwindow = 0; iwindow < 1000; iwindow++){
+    Double_t etaC = rnd.Uniform(-1.1, 1.1), phiC = rnd.Uniform(0., TMath::TwoPi()),
+             maxDEta = rnd.Uniform(0., 0.5), maxDPhi = iwindow % 10 ? rnd.Uniform(0., 0.5) : rnd.Uniform(2., 4.);
+    if(iwindow % 7 == 0) phiC = rnd.Uniform(-0.05, 0.05);
+    grid.FindCandidates(etaC, phiC, maxDEta, maxDPhi, candidates);
+
+    for(size_t icand = 1; icand < candidates.size(); icand++){
+      if(candidates[icand] <= candidates[icand-1]) {
+        AliErrorStream() << "Window " << iwindow << ": candidates not in increasing order" << std::endl;
+        testresult = false;
+        break;
+      }
+    }
+    for(int iobj = 0; iobj < nobjects; iobj++){
+      if(TMath::Abs(eta[iobj] - etaC) > maxDEta || TMath::Abs(TVector2::Phi_mpi_pi(phi[iobj] - phiC)) > maxDPhi) continue;
+      if(!std::binary_search(candidates.begin(), candidates.end(), iobj)) {
+        AliErrorStream() << "Window " << iwindow << " (" << etaC << ", " << phiC << ", " << maxDEta << ", " << maxDPhi << "): object "
+                         << iobj << " (" << eta[iobj] << ", " << phi[iobj] << ") missing" << std::endl;
+        testresult = false;
+      }
+    }
+  }
+  return testresult;
+}
+
+bool TestAliEmcalEtaPhiGrid::TestEdges() const {
+  // 2 x 4 bins, bin width in phi pi/2
+  AliEmcalEtaPhiGrid grid(2, -1., 1., 4);
+  grid.Add(0, -0.5, 0.1);
+  grid.Add(1,  0.5, TMath::TwoPi() - 0.1);   // last phi bin, next to object 0 through 2pi
+  grid.Add(2, -0.5, TMath::Pi());
+  grid.Add(3,  5.0, -0.1);                   // above the axis range, in the last eta bin
+  grid.Add(4, -0.5, 0.2);
+  grid.Build();
+
+  struct Window { Double_t fEta, fPhi, fMaxDEta, fMaxDPhi; std::vector<Int_t> fExpected; };
+  const std::vector<Window> windows = {
+    {-0.5, 0.1,  0.1, 0.1, {0, 4}},          // first bin only
+    {-0.5, 0.1,  1.5, 0.3, {0, 1, 3, 4}},    // across 2pi, both eta bins
+    { 0.5, 6.2,  0.1, 0.3, {1, 3}},          // last phi bin and first through 2pi, second eta bin
+    {-0.5, 0.1,  0.1, 4.0, {0, 2, 4}},       // all phi
+    {-0.5, 3.2,  0.1, 0.1, {2}}
+  };
+
+  bool testresult = true;
+  std::vector<Int_t> candidates;
+  for(size_t iwindow = 0; iwindow < windows.size(); iwindow++){
+    const Window &w = windows[iwindow];
+    grid.FindCandidates(w.fEta, w.fPhi, w.fMaxDEta, w.fMaxDPhi, candidates);
+    if(candidates != w.fExpected) {
+      AliErrorStream() << "Window " << iwindow << ": " << candidates.size() << " candidates, expected " << w.fExpected.size() << std::endl;
+      testresult = false;
+    }
+  }
+  grid.Clear();
+  grid.Build();
+  grid.FindCandidates(0., 0., 1., 1., candidates);
+  if(candidates.size()) {
+    AliErrorStream() << "Candidates found after Clear()" << std::endl;
+    testresult = false;
+  }
+  return testresult;
+}
@@ -0,0 +1,183 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALETAPHIGRID_H
+#define ALIEMCALETAPHIGRID_H
+
+#include <vector>
+#include <Rtypes.h>
+#include <TObject.h>
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class AliEmcalEtaPhiGrid
+ * @brief Regular \f$\eta\f$-\f$\phi\f$ grid of objects for neighbour searches
+ * @ingroup EMCALCOREFW
+ *
+ * Objects (tracks, clusters) are added with an index and their position, and sorted
+ * into the bins of the grid with Build(). FindCandidates() then returns the indices
+ * of all objects in the bins overlapping a window around a position, such that a
+ * matcher only has to compute the residuals of these candidates instead of all
+ * objects of the event. The candidates are a superset of the objects inside the
+ * window; the caller applies the exact selection.
+ *
+ * The \f$\phi\f$ axis is periodic over \f$[0, 2\pi)\f$. Objects outside of the range
+ * of the first axis are put in the first or last bin, the first axis can be any
+ * longitudinal coordinate (\f$\eta\f$, z).
+ *
+ * ~~~{.cxx}
+ * PWG::EMCAL::AliEmcalEtaPhiGrid grid(40, -1., 1., 126);
+ * for (int itrack = 0; itrack < ntracks; itrack++) grid.Add(itrack, eta[itrack], phi[itrack]);
+ * grid.Build();
+ * std::vector<Int_t> candidates;
+ * grid.FindCandidates(clusterEta, clusterPhi, 0.1, 0.1, candidates);
+ * ~~~
+ */
+class AliEmcalEtaPhiGrid {
+public:
+  AliEmcalEtaPhiGrid();
+
+  /**
+   * @brief Constructor, defining the binning
+   * @param[in] nbinsEta Number of bins of the first axis
+   * @param[in] etaMin Lower edge of the first axis
+   * @param[in] etaMax Upper edge of the first axis
+   * @param[in] nbinsPhi Number of bins in \f$\phi\f$ over \f$[0, 2\pi)\f$
+   */
+  AliEmcalEtaPhiGrid(Int_t nbinsEta, Double_t etaMin, Double_t etaMax, Int_t nbinsPhi);
+  virtual ~AliEmcalEtaPhiGrid() {}
+
+  /**
+   * @brief Change the binning, removing all objects
+   */
+  void SetBinning(Int_t nbinsEta, Double_t etaMin, Double_t etaMax, Int_t nbinsPhi);
+
+  /**
+   * @brief Remove all objects, keeping the binning
+   */
+  void Clear();
+
+  /**
+   * @brief Add an object to the grid, visible in FindCandidates() after Build()
+   * @param[in] id Index of the object
+   * @param[in] eta Position of the object on the first axis
+   * @param[in] phi Azimuth of the object, any range
+   */
+  void Add(Int_t id, Double_t eta, Double_t phi);
+
+  /**
+   * @brief Sort the objects added into the bins
+   */
+  void Build();
+
+  /**
+   * @brief Find the objects in the bins overlapping a window
+   *
+   * @param[in] eta Center of the window on the first axis
+   * @param[in] phi Center of the window in azimuth
+   * @param[in] maxDEta Half width of the window on the first axis
+   * @param[in] maxDPhi Half width of the window in azimuth
+   * @param[out] candidates Indices of the objects, in increasing order
+   */
+  void FindCandidates(Double_t eta, Double_t phi, Double_t maxDEta, Double_t maxDPhi, std::vector<Int_t> &candidates) const;
+
+  Int_t GetNumberOfObjects() const { return fIds.size(); }
+  Int_t GetNbinsEta() const { return fNbinsEta; }
+  Int_t GetNbinsPhi() const { return fNbinsPhi; }
+
+private:
+  Int_t EtaBin(Double_t eta) const;
+  Int_t PhiBin(Double_t phi) const;
+
+  Int_t                 fNbinsEta;        ///< Number of bins of the first axis
+  Double_t              fEtaMin;          ///< Lower edge of the first axis
+  Double_t              fEtaMax;          ///< Upper edge of the first axis
+  Int_t                 fNbinsPhi;        ///< Number of bins in azimuth
+  std::vector<Int_t>    fIds;             ///< Indices of the objects, in the order added
+  std::vector<Int_t>    fBins;            ///< Bins of the objects, in the order added
+  std::vector<Int_t>    fFirst;           ///< First object of each bin in fSorted, with one bin past the end
+  std::vector<Int_t>    fSorted;          ///< Indices of the objects sorted by bin
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalEtaPhiGrid, 1);
+  /// \endcond
+};
+
+/**
+ * @class TestAliEmcalEtaPhiGrid
+ * @brief Unit test for class AliEmcalEtaPhiGrid
+ * @ingroup EMCALCOREFW
+ *
+ * Compares the candidates of the grid with a selection over all objects,
+ * for random objects and windows.
+ */
+class TestAliEmcalEtaPhiGrid : public TObject {
+public:
+  TestAliEmcalEtaPhiGrid() : TObject() {}
+  virtual ~TestAliEmcalEtaPhiGrid() {}
+
+  /**
+   * @brief Run all unit tests for the class AliEmcalEtaPhiGrid
+   *
+   * @return true All tests passed
+   * @return false At least one failure observed
+   */
+  bool RunAllTests() const;
+
+  /**
+   * @brief Random objects and windows
+   *
+   * The candidates must contain all objects inside the window, with
+   * \f$\phi\f$ wrapped around \f$2\pi\f$, in increasing order and without
+   * duplicates. Windows around \f$\phi = 0\f$, larger than \f$\pi\f$ and
+   * objects outside the range of the first axis are included.
+   *
+   * @return true All windows passed
+   * @return false At least one object inside a window missing
+   */
+  bool TestRandomWindows() const;
+
+  /**
+   * @brief Fixed objects at the edges of the bins and of the \f$\phi\f$ range
+   *
+   * @return true Expected candidates found
+   * @return false Candidates different
+   */
+  bool TestEdges() const;
+
+  /// \cond CLASSIMP
+  ClassDef(TestAliEmcalEtaPhiGrid, 1);
+  /// \endcond
+};
+
+}
+
+}
+
+#endif /* ALIEMCALETAPHIGRID_H */
@@ -150,7 +150,7 @@ public:
       }
       else {
         this->fCurrentElement.second = (*fkData)[fCurrent];
-        fkData->GetContainer()->GetMomentum(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
+        fkData->GetContainer()->GetCachedMomentum(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
       }
     }
   };
@@ -327,17 +327,14 @@ T *AliEmcalIterableContainerT<T, STAR>::operator[](int index) const {
 
 /**
  * Build list of accepted indices inside the container.
- * For this all objects inside the container are checked
- * for being accepted or not.
+ * The list is taken from the container, which evaluates
+ * the selection only once per event for all iterators.
  */
 template <typename T, typename STAR>
 void AliEmcalIterableContainerT<T, STAR>::BuildAcceptIndices(){
-  fAcceptIndices.Set(fkContainer->GetNAcceptEntries());
-  int acceptCounter = 0;
-  for(int index = 0; index < fkContainer->GetNEntries(); index++){
-    UInt_t rejectionReason = 0;
-    if(fkContainer->AcceptObject(index, rejectionReason)) fAcceptIndices[acceptCounter++] = index;
-  }
+  const std::vector<Int_t> &accepted = fkContainer->GetAcceptedIndices();
+  fAcceptIndices.Set(accepted.size());
+  for(std::size_t index = 0; index < accepted.size(); index++) fAcceptIndices[index] = accepted[index];
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -0,0 +1,247 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "AliAnalysisManager.h"
+#include "AliEMCALRecoUtils.h"
+#include "AliESDEvent.h"
+#include "AliESDtrack.h"
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+
+#include "AliEmcalTrackSurfaceCache.h"
+
+/// \cond CLASSIMP
+ClassImp(PWG::EMCAL::AliEmcalTrackSurfaceCache)
+ClassImp(PWG::EMCAL::TestAliEmcalTrackSurfaceCache)
+/// \endcond
+
+using namespace PWG::EMCAL;
+
+AliEmcalTrackSurfaceCache *AliEmcalTrackSurfaceCache::Instance(){
+  static AliEmcalTrackSurfaceCache instance;
+  return &instance;
+}
+
+AliEmcalTrackSurfaceCache::AliEmcalTrackSurfaceCache():
+  TObject(),
+  fEnabled(kTRUE),
+  fEvent(nullptr),
+  fEntry(-1),
+  fRun(-1),
+  fNTracks(-1),
+  fTracks(),
+  fParams(),
+  fNHits(0),
+  fNMisses(0)
+{
+}
+
+void AliEmcalTrackSurfaceCache::Reset(){
+  fTracks.clear();
+  fParams.clear();
+  fEvent = nullptr;
+  fEntry = -1;
+  fRun = -1;
+  fNTracks = -1;
+}
+
+void AliEmcalTrackSurfaceCache::SetEvent(const AliVEvent *event){
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  SetEvent(event, mgr ? mgr->GetCurrentEntry() : -1);
+}
+
+void AliEmcalTrackSurfaceCache::SetEvent(const AliVEvent *event, Long64_t entry){
+  // Tracks are identified by their address, which is reused from one event to the next
+  if(event == fEvent && entry == fEntry && entry >= 0 && event && event->GetRunNumber() == fRun && event->GetNumberOfTracks() == fNTracks) return;
+  Reset();
+  fEvent = event;
+  fEntry = entry;
+  if(event) {
+    fRun = event->GetRunNumber();
+    fNTracks = event->GetNumberOfTracks();
+  }
+}
+
+Bool_t AliEmcalTrackSurfaceCache::PropagateTrack(AliVTrack *track, Double_t emcalR, Double_t mass, Double_t step, Double_t minpT,
+                                                 Bool_t useMassForTracking, Bool_t useDCA){
+  if(!fEnabled || !track) {
+    fNMisses++;
+    return AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, emcalR, mass, step, minpT, useMassForTracking, useDCA);
+  }
+
+  const Double_t settings[6] = {emcalR, mass, step, minpT, Double_t(useMassForTracking), Double_t(useDCA)};
+  // The address can be reused by another track within the event (e.g. tracks created by a task), with
+  // the same values on the EMCal surface as a failed propagation: the track must be the same as well
+  const Double_t kinematics[4] = {track->Px(), track->Py(), track->Pz(), Double_t(track->Charge())};
+  auto found = fTracks.find(track);
+  if(found != fTracks.end()) {
+    const TrackSurface_t &surface = found->second;
+    if(std::equal(settings, settings + 6, surface.fSettings) && track->GetID() == surface.fID &&
+       std::equal(kinematics, kinematics + 4, surface.fKinematics) && track->GetTrackEtaOnEMCal() == surface.fEta &&
+       track->GetTrackPhiOnEMCal() == surface.fPhi && track->GetTrackPtOnEMCal() == surface.fPt) {
+      fNHits++;
+      return surface.fResult;
+    }
+  }
+
+  fNMisses++;
+  TrackSurface_t surface;
+  std::copy(settings, settings + 6, surface.fSettings);
+  surface.fID = track->GetID();
+  std::copy(kinematics, kinematics + 4, surface.fKinematics);
+  surface.fResult = AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, emcalR, mass, step, minpT, useMassForTracking, useDCA);
+  surface.fEta = track->GetTrackEtaOnEMCal();
+  surface.fPhi = track->GetTrackPhiOnEMCal();
+  surface.fPt = track->GetTrackPtOnEMCal();
+  fTracks[track] = surface;
+  return surface.fResult;
+}
+
+Bool_t AliEmcalTrackSurfaceCache::PropagateTrackParam(const AliVTrack *track, AliExternalTrackParam *trkParam, Double_t emcalR, Double_t mass, Double_t step,
+                                                      Float_t &eta, Float_t &phi, Float_t &pt){
+  if(!fEnabled || !track || !trkParam) {
+    fNMisses++;
+    return AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(trkParam, emcalR, mass, step, eta, phi, pt);
+  }
+
+  const Double_t settings[3] = {emcalR, mass, step};
+  auto range = fParams.equal_range(track);
+  for(auto it = range.first; it != range.second; ++it) {
+    const ParamSurface_t &surface = it->second;
+    if(!std::equal(settings, settings + 3, surface.fSettings) || !SameParam(*trkParam, surface.fStart)) continue;
+    fNHits++;
+    *trkParam = surface.fEnd;
+    eta = surface.fEta;
+    phi = surface.fPhi;
+    pt = surface.fPt;
+    return surface.fResult;
+  }
+
+  fNMisses++;
+  ParamSurface_t surface;
+  std::copy(settings, settings + 3, surface.fSettings);
+  surface.fStart = *trkParam;
+  surface.fResult = AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(trkParam, emcalR, mass, step, eta, phi, pt);
+  surface.fEnd = *trkParam;
+  surface.fEta = eta;
+  surface.fPhi = phi;
+  surface.fPt = pt;
+  fParams.insert(std::make_pair(track, surface));
+  return surface.fResult;
+}
+
+Bool_t AliEmcalTrackSurfaceCache::SameParam(const AliExternalTrackParam &a, const AliExternalTrackParam &b){
+  if(a.GetX() != b.GetX() || a.GetAlpha() != b.GetAlpha()) return kFALSE;
+  const Double_t *pa = a.GetParameter(), *pb = b.GetParameter();
+  if(!std::equal(pa, pa + 5, pb)) return kFALSE;
+  const Double_t *ca = a.GetCovariance(), *cb = b.GetCovariance();
+  return std::equal(ca, ca + 15, cb);
+}
+
+bool TestAliEmcalTrackSurfaceCache::RunAllTests() const {
+  return TestInvalidation();
+}
+
+bool TestAliEmcalTrackSurfaceCache::TestInvalidation() const {
+  AliEmcalTrackSurfaceCache *cache = AliEmcalTrackSurfaceCache::Instance();
+  cache->SetEnabled(kTRUE);
+
+  AliESDEvent event;
+  event.CreateStdContent();
+
+  // pt = 0.1 GeV/c, below the minimum pt of the propagation
+  const Double_t param[5] = {0., 0., 0., 0., 10.}, cov[15] = {1., 0., 1., 0., 0., 1., 0., 0., 0., 1., 0., 0., 0., 0., 1.};
+  AliESDtrack track1, track2;
+  track1.AliExternalTrackParam::Set(0., 0., param, cov);
+  track2.AliExternalTrackParam::Set(0., 0., param, cov);
+
+  // Each step: entry for SetEvent (no call if < -1), track, EMCal radius, expected to be served from the cache
+  struct Request { Long64_t fEntry; AliESDtrack *fTrack; Double_t fRadius; bool fHit; const char *fDescription; };
+  const std::vector<Request> requests = {
+    {5,  &track1, 440., false, "first request"},
+    {-2, &track1, 440., true,  "same entry"},
+    {-2, &track2, 440., false, "other track"},
+    {5,  &track1, 440., true,  "same event and entry set again"},
+    {-2, &track1, 430., false, "other settings"},
+    {6,  &track1, 440., false, "same event, next entry"},
+    {-2, &track1, 440., true,  "next entry, second request"},
+    {-1, &track1, 440., false, "unknown entry"},
+    {-1, &track1, 440., false, "unknown entry set again"}
+  };
+
+  bool testresult = true;
+  for(size_t ireq = 0; ireq < requests.size(); ireq++){
+    const Request &req = requests[ireq];
+    if(req.fEntry >= -1) cache->SetEvent(&event, req.fEntry);
+    Long64_t nhits = cache->GetNHits();
+    cache->PropagateTrack(req.fTrack, req.fRadius);
+    bool hit = cache->GetNHits() > nhits;
+    if(hit != req.fHit) {
+      AliErrorStream() << "Request " << ireq << " (" << req.fDescription << "): " << (hit ? "served from the cache" : "propagated")
+                       << ", expected " << (req.fHit ? "served from the cache" : "propagated") << std::endl;
+      testresult = false;
+    }
+  }
+
+  // Track propagated outside of the cache in the meantime
+  cache->SetEvent(&event, 7);
+  cache->PropagateTrack(&track1);
+  track1.SetTrackPhiEtaPtOnEMCal(1., 0.5, 2.);
+  Long64_t nhits = cache->GetNHits();
+  cache->PropagateTrack(&track1);
+  if(cache->GetNHits() > nhits) {
+    AliErrorStream() << "Track modified outside of the cache served from the cache" << std::endl;
+    testresult = false;
+  }
+
+  // Another track at the address of a track with a failed propagation, both with the default values on the surface
+  cache->SetEvent(&event, 8);
+  AliESDtrack failed;
+  failed.AliExternalTrackParam::Set(0., 0., param, cov);
+  track1 = failed;
+  if(cache->PropagateTrack(&track1)) {
+    AliErrorStream() << "Propagation of a track below the minimum pt succeeded" << std::endl;
+    testresult = false;
+  }
+  const Double_t otherparam[5] = {0., 0., 0., 0.1, 5.};
+  AliESDtrack other;
+  other.AliExternalTrackParam::Set(0., 0., otherparam, cov);
+  track1 = other;
+  nhits = cache->GetNHits();
+  cache->PropagateTrack(&track1);
+  if(cache->GetNHits() > nhits) {
+    AliErrorStream() << "Other track at the address of a failed propagation served from the cache" << std::endl;
+    testresult = false;
+  }
+
+  cache->Reset();
+  return testresult;
+}
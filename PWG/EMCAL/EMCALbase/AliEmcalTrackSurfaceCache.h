@@ -0,0 +1,211 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALTRACKSURFACECACHE_H
+#define ALIEMCALTRACKSURFACECACHE_H
+
+#include <map>
+#include <TObject.h>
+#include "AliExternalTrackParam.h"
+
+class AliVEvent;
+class AliVTrack;
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class AliEmcalTrackSurfaceCache
+ * @brief Per-event cache of the track propagations to the EMCal surface, shared by all tasks
+ * @ingroup EMCALCOREFW
+ *
+ * Several tasks of a train propagate the same tracks to the calorimeter surface in each
+ * event (cluster-track matchers, track propagator, GammaConv calo track matcher). The cache
+ * runs the propagation of AliEMCALRecoUtils once per track, settings and event, and hands
+ * the result to the following requests:
+ * - PropagateTrack() propagates an AliVTrack in place. A request is served from the cache
+ *   if the track was propagated with the same settings in the event, has the same ID and
+ *   kinematics as when it was propagated, and still carries the result. Otherwise (e.g. the
+ *   track was propagated with other settings in the meantime, or another track was created
+ *   at the same address) the propagation is redone.
+ * - PropagateTrackParam() propagates track parameters obtained from a track. A request is
+ *   served from the cache if the same track was propagated with the same settings from
+ *   identical starting parameters in the event.
+ *
+ * The cache is a singleton, it is invalidated when the event changes, in the same way as
+ * AliPIDResponseCache.
+ *
+ * ~~~{.cxx}
+ * auto cache = PWG::EMCAL::AliEmcalTrackSurfaceCache::Instance();
+ * cache->SetEvent(InputEvent());
+ * cache->PropagateTrack(track, 440.);
+ * ~~~
+ */
+class AliEmcalTrackSurfaceCache : public TObject {
+public:
+
+  /**
+   * @brief Get the cache shared by all tasks in the process
+   * @return Cache instance
+   */
+  static AliEmcalTrackSurfaceCache *Instance();
+
+  virtual ~AliEmcalTrackSurfaceCache() {}
+
+  /**
+   * @brief Set the event the next requests belong to, dropping the results of the previous event
+   * @param[in] event Current event
+   */
+  void SetEvent(const AliVEvent *event);
+
+  /**
+   * @brief Set the event the next requests belong to, with the entry of the event in the input
+   *
+   * Results are kept only for the same event at the same entry, for entries >= 0.
+   * @param[in] event Current event
+   * @param[in] entry Entry of the event, -1 if unknown
+   */
+  void SetEvent(const AliVEvent *event, Long64_t entry);
+
+  /**
+   * @brief Propagate a track to the EMCal surface, see AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface()
+   *
+   * The default settings are the ones of AliEMCALRecoUtils.
+   * @return Result of the propagation
+   */
+  Bool_t PropagateTrack(AliVTrack *track, Double_t emcalR = 440, Double_t mass = 0.1396, Double_t step = 20, Double_t minpT = 0.35,
+                        Bool_t useMassForTracking = kFALSE, Bool_t useDCA = kFALSE);
+
+  /**
+   * @brief Propagate parameters of a track to the EMCal surface, see AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface()
+   *
+   * @param[in] track Track the parameters are obtained from, key of the cache
+   * @param[in,out] trkParam Starting parameters, propagated on return
+   * @return Result of the propagation
+   */
+  Bool_t PropagateTrackParam(const AliVTrack *track, AliExternalTrackParam *trkParam, Double_t emcalR, Double_t mass, Double_t step,
+                             Float_t &eta, Float_t &phi, Float_t &pt);
+
+  /**
+   * @brief Use the cache, or pass all requests through to AliEMCALRecoUtils
+   */
+  void     SetEnabled(Bool_t enabled = kTRUE) { fEnabled = enabled; Reset(); }
+  Bool_t   IsEnabled() const { return fEnabled; }
+  void     Reset();
+
+  Long64_t GetNHits()   const { return fNHits; }
+  Long64_t GetNMisses() const { return fNMisses; }
+
+private:
+  /// Propagation of a track in place
+  struct TrackSurface_t {
+    Double_t              fSettings[6];     ///< emcalR, mass, step, minpT, useMassForTracking, useDCA
+    Int_t                 fID;              ///< Track ID
+    Double_t              fKinematics[4];   ///< Track px, py, pz and charge, not changed by the propagation
+    Bool_t                fResult;          ///< Result of the propagation
+    Double_t              fEta;             ///< Track eta on the EMCal surface after the propagation
+    Double_t              fPhi;             ///< Track phi on the EMCal surface after the propagation
+    Double_t              fPt;              ///< Track pt on the EMCal surface after the propagation
+  };
+
+  /// Propagation of track parameters
+  struct ParamSurface_t {
+    Double_t              fSettings[3];     ///< emcalR, mass, step
+    AliExternalTrackParam fStart;           ///< Starting parameters
+    AliExternalTrackParam fEnd;             ///< Propagated parameters
+    Bool_t                fResult;          ///< Result of the propagation
+    Float_t               fEta;             ///< Eta on the EMCal surface
+    Float_t               fPhi;             ///< Phi on the EMCal surface
+    Float_t               fPt;              ///< Pt on the EMCal surface
+  };
+
+  AliEmcalTrackSurfaceCache();
+  AliEmcalTrackSurfaceCache(const AliEmcalTrackSurfaceCache &);
+  AliEmcalTrackSurfaceCache &operator=(const AliEmcalTrackSurfaceCache &);
+
+  static Bool_t SameParam(const AliExternalTrackParam &a, const AliExternalTrackParam &b);
+
+  Bool_t                                              fEnabled;       ///< Use the cache
+  const AliVEvent                                    *fEvent;         //!<! Event of the cached results
+  Long64_t                                            fEntry;         //!<! Entry of the analysis manager for fEvent
+  Int_t                                               fRun;           //!<! Run number of fEvent
+  Int_t                                               fNTracks;       //!<! Number of tracks of fEvent
+  std::map<const AliVTrack *, TrackSurface_t>         fTracks;        //!<! Last propagation of each track in place
+  std::multimap<const AliVTrack *, ParamSurface_t>    fParams;        //!<! Propagations of track parameters
+  Long64_t                                            fNHits;         //!<! Requests served from the cache
+  Long64_t                                            fNMisses;       //!<! Requests propagated
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTrackSurfaceCache, 0);
+  /// \endcond
+};
+
+/**
+ * @class TestAliEmcalTrackSurfaceCache
+ * @brief Unit test for class AliEmcalTrackSurfaceCache
+ * @ingroup EMCALCOREFW
+ *
+ * Checks when propagations in place are served from the cache, with tracks
+ * below the minimum \f$p_{t}\f$ of the propagation, which need no magnetic field.
+ */
+class TestAliEmcalTrackSurfaceCache : public TObject {
+public:
+  TestAliEmcalTrackSurfaceCache() : TObject() {}
+  virtual ~TestAliEmcalTrackSurfaceCache() {}
+
+  /**
+   * @brief Run all unit tests for the class AliEmcalTrackSurfaceCache
+   *
+   * @return true All tests passed
+   * @return false At least one failure observed
+   */
+  bool RunAllTests() const;
+
+  /**
+   * @brief Invalidation of the cached propagations
+   *
+   * The second request for a track is served from the cache within an entry. It is
+   * propagated again after a change of entry with the same event object, for an
+   * unknown entry, with other settings, when the track was propagated in the
+   * meantime outside of the cache, and when another track with a failed propagation
+   * cached for its address takes its place.
+   *
+   * @return true All requests served as expected
+   * @return false At least one request served from the cache when it should not, or the opposite
+   */
+  bool TestInvalidation() const;
+
+  /// \cond CLASSIMP
+  ClassDef(TestAliEmcalTrackSurfaceCache, 1);
+  /// \endcond
+};
+
+}
+
+}
+
+#endif /* ALIEMCALTRACKSURFACECACHE_H */
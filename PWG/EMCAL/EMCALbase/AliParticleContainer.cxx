@@ -418,12 +418,7 @@ Bool_t AliParticleContainer::ApplyKinematicCuts(const AliTLorentzVector& mom, UI
  */
 Int_t AliParticleContainer::GetNAcceptedParticles() const
 {
-  Int_t nPart = 0;
-  for(int ipart = 0; ipart < this->GetNParticles(); ipart++){
-    UInt_t rejectionReason = 0;
-    if(this->AcceptParticle(ipart, rejectionReason)) nPart++;
-  }
-  return nPart;
+  return GetNAcceptEntries();
 }
 
 /**
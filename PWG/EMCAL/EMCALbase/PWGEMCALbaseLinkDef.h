@@ -47,8 +47,15 @@
 #pragma link C++ class PWG::EMCAL::AliEmcalESDHybridTrackCuts+;
 #pragma link C++ class PWG::EMCAL::AliEmcalESDTrackCutsGenerator+;
 #pragma link C++ class PWG::EMCAL::AliEmcalESDtrackCutsWrapper+;
+#pragma link C++ class PWG::EMCAL::AliEmcalCellGeometryTable+;
+#pragma link C++ class PWG::EMCAL::AliEmcalClusterCellArrays+;
+#pragma link C++ class PWG::EMCAL::AliEmcalEtaPhiGrid+;
+#pragma link C++ class PWG::EMCAL::AliEmcalTrackSurfaceCache+;
 #pragma link C++ class PWG::EMCAL::TestAliEmcalTrackSelResultPtr+;
 #pragma link C++ class PWG::EMCAL::TestAliEmcalAODHybridTrackCuts+;
 #pragma link C++ class PWG::EMCAL::TestAliEmcalTrackSelectionAOD+;
+#pragma link C++ class PWG::EMCAL::TestAliEmcalClusterCellArrays+;
+#pragma link C++ class PWG::EMCAL::TestAliEmcalEtaPhiGrid+;
+#pragma link C++ class PWG::EMCAL::TestAliEmcalTrackSurfaceCache+;
 
 #endif
@@ -0,0 +1,396 @@
+// AliEmcalCorrectionCellArray
+//
+
+#include "AliEmcalCorrectionCellArray.h"
+
+#include <iostream>
+
+#include <AliAODCaloCells.h>
+#include <AliEMCALGeometry.h>
+#include <AliEMCALRecoUtils.h>
+#include <AliLog.h>
+#include <AliVCaloCells.h>
+
+/// \cond CLASSIMP
+ClassImp(PWG::EMCAL::TestAliEmcalCorrectionCellArray);
+/// \endcond
+
+/**
+ * Default constructor
+ */
+AliEmcalCorrectionCellCalibTable::AliEmcalCorrectionCellCalibTable() :
+  fRun(-1),
+  fFilled(0),
+  fNCells(0),
+  fSuperModule(),
+  fBad(),
+  fEnergyFactor(),
+  fTimeFactor(),
+  fL1Phase()
+{
+}
+
+/**
+ * Fill the tables of the calibrations switched on in the reco utils. All tables are refilled when the
+ * run changes, as the components load their calibration at the first event of a run. Calibrations switched
+ * on later in the run are filled when first needed.
+ *
+ * @param[in] recoUtils Reco utils holding the calibration histograms of the component
+ * @param[in] run Run of the calibration
+ */
+void AliEmcalCorrectionCellCalibTable::Update(const AliEMCALRecoUtils * recoUtils, Int_t run)
+{
+  AliEMCALGeometry * geom = AliEMCALGeometry::GetInstance();
+
+  if (run != fRun) {
+    fRun = run;
+    fFilled = 0;
+    // Cells outside of the geometry are rejected as in AliEMCALRecoUtils::AcceptCalibrateCell()
+    fNCells = geom ? 24*48*geom->GetNumberOfSuperModules() : 0;
+    fSuperModule.assign(fNCells, -1);
+    Int_t iSM = -1, iEta = -1, iPhi = -1;
+    for (Int_t absId = 0; absId < fNCells; absId++) {
+      if (GetCellIndex(absId, iSM, iEta, iPhi)) fSuperModule[absId] = iSM;
+    }
+  }
+  if (fNCells == 0) return;
+
+  if (recoUtils->IsBadChannelsRemovalSwitchedOn() && !(fFilled & kBadChannels)) {
+    fBad.assign(fNCells, 0);
+    Int_t iSM = -1, iEta = -1, iPhi = -1, status = 0;
+    for (Int_t absId = 0; absId < fNCells; absId++) {
+      if (GetCellIndex(absId, iSM, iEta, iPhi)) fBad[absId] = recoUtils->GetEMCALChannelStatus(iSM, iEta, iPhi, status);
+    }
+    fFilled |= kBadChannels;
+  }
+
+  if (recoUtils->IsRecalibrationOn() && !(fFilled & kEnergy)) {
+    fEnergyFactor.assign(fNCells, 1);
+    Int_t iSM = -1, iEta = -1, iPhi = -1;
+    for (Int_t absId = 0; absId < fNCells; absId++) {
+      if (GetCellIndex(absId, iSM, iEta, iPhi)) fEnergyFactor[absId] = recoUtils->GetEMCALChannelRecalibrationFactor(iSM, iEta, iPhi);
+    }
+    fFilled |= kEnergy;
+  }
+
+  if (recoUtils->IsTimeRecalibrationOn()) {
+    // The low gain factors are only read when the low gain calibration is used
+    for (Int_t isLGon = 0; isLGon < 2; isLGon++) {
+      UInt_t table = isLGon ? kTimeLowGain : kTime;
+      if (fFilled & table) continue;
+      if (isLGon && !recoUtils->IsLGOn()) continue;
+      for (Int_t bc = 0; bc < 4; bc++) {
+        std::vector<Float_t> & factors = fTimeFactor[bc+4*isLGon];
+        factors.assign(fNCells, 0);
+        for (Int_t absId = 0; absId < fNCells; absId++) {
+          if (fSuperModule[absId] >= 0) factors[absId] = recoUtils->GetEMCALChannelTimeRecalibrationFactor(bc, absId, isLGon);
+        }
+      }
+      fFilled |= table;
+    }
+  }
+
+  if (recoUtils->IsL1PhaseInTimeRecalibrationOn() && !(fFilled & kL1Phase)) {
+    Int_t nSM = geom->GetNumberOfSuperModules();
+    fL1Phase.assign(nSM, 0);
+    for (Int_t iSM = 0; iSM < nSM; iSM++) {
+      fL1Phase[iSM] = recoUtils->GetEMCALL1PhaseInTimeRecalibrationForSM(iSM);
+    }
+    fFilled |= kL1Phase;
+  }
+}
+
+/**
+ * Super module and column/row in the super module of a cell, as used by the calibration histograms.
+ *
+ * @return False if the cell does not exist
+ */
+Bool_t AliEmcalCorrectionCellCalibTable::GetCellIndex(Int_t absId, Int_t & iSM, Int_t & iEta, Int_t & iPhi) const
+{
+  AliEMCALGeometry * geom = AliEMCALGeometry::GetInstance();
+  Int_t iTower = -1, iIphi = -1, iIeta = -1;
+  if (!geom->GetCellIndex(absId, iSM, iTower, iIphi, iIeta)) return kFALSE;
+  geom->GetCellPhiEtaIndexInSModule(iSM, iTower, iIphi, iIeta, iPhi, iEta);
+  return kTRUE;
+}
+
+/**
+ * Default constructor
+ */
+AliEmcalCorrectionCellArray::AliEmcalCorrectionCellArray() :
+  fCells(0),
+  fModified(kFALSE),
+  fAbsId(),
+  fAmplitude(),
+  fTime(),
+  fMCLabel(),
+  fEFrac(),
+  fHighGain(),
+  fStages()
+{
+}
+
+/**
+ * Read the cells into the columns. The cells must not be modified through AliVCaloCells until Store().
+ *
+ * @param[in] cells Cells of the event
+ */
+void AliEmcalCorrectionCellArray::Load(AliVCaloCells * cells)
+{
+  fCells = cells;
+  fModified = kFALSE;
+  fStages.clear();
+
+  Int_t nCells = cells->GetNumberOfCells();
+  fAbsId.resize(nCells);
+  fAmplitude.resize(nCells);
+  fTime.resize(nCells);
+  fMCLabel.resize(nCells);
+  fEFrac.resize(nCells);
+  fHighGain.resize(nCells);
+
+  Short_t absId = -1;
+  for (Int_t iCell = 0; iCell < nCells; iCell++) {
+    cells->GetCell(iCell, absId, fAmplitude[iCell], fTime[iCell], fMCLabel[iCell], fEFrac[iCell]);
+    fAbsId[iCell] = absId;
+    fHighGain[iCell] = cells->GetHighGain(iCell);
+  }
+}
+
+/**
+ * Apply the queued stages and write the cells back, sorted as after AliEmcalCorrectionComponent::UpdateCells().
+ * The cells are unloaded.
+ */
+void AliEmcalCorrectionCellArray::Store()
+{
+  if (!fCells) return;
+
+  Apply();
+  if (fModified) {
+    Int_t nCells = fAbsId.size();
+    for (Int_t iCell = 0; iCell < nCells; iCell++) {
+      fCells->SetCell(iCell, fAbsId[iCell], fAmplitude[iCell], fTime[iCell], fMCLabel[iCell], fEFrac[iCell], fHighGain[iCell]);
+    }
+    fCells->Sort();
+  }
+
+  fCells = 0;
+  fModified = kFALSE;
+}
+
+/**
+ * Queue the recalibration of the cells with the current settings of the reco utils, as
+ * AliEMCALRecoUtils::RecalibrateCells() would do it. The settings are copied, such that the reco
+ * utils can be reconfigured before the stage is applied. The table must be up to date for the reco utils.
+ *
+ * @param[in] recoUtils Reco utils of the component, marked as having calibrated the cells
+ * @param[in] table Calibration of the reco utils by absolute cell ID
+ * @param[in] bc Bunch crossing number of the event
+ */
+void AliEmcalCorrectionCellArray::AddStage(AliEMCALRecoUtils * recoUtils, const AliEmcalCorrectionCellCalibTable * table, Int_t bc)
+{
+  fModified = kTRUE;
+
+  if (!recoUtils->IsRecalibrationOn() && !recoUtils->IsTimeRecalibrationOn() && !recoUtils->IsBadChannelsRemovalSwitchedOn())
+    return;
+
+  Stage stage;
+  stage.fTable             = table;
+  stage.fCalibrated        = recoUtils->AreCellsCalibrated();
+  stage.fRemoveBadChannels = recoUtils->IsBadChannelsRemovalSwitchedOn();
+  stage.fRecalibration     = recoUtils->IsRecalibrationOn();
+  stage.fTimeRecalibration = recoUtils->IsTimeRecalibrationOn();
+  stage.fLowGain           = recoUtils->IsLGOn();
+  stage.fL1Phase           = recoUtils->IsL1PhaseInTimeRecalibrationOn();
+  stage.fConstantTimeShift = recoUtils->GetConstantTimeShift();
+  stage.fBC                = bc;
+  fStages.push_back(stage);
+
+  recoUtils->SetCellsCalibrated();
+}
+
+/**
+ * Apply the queued stages in one loop over the cells. The stages only depend on the cell itself,
+ * so that each cell goes through all stages at once.
+ */
+void AliEmcalCorrectionCellArray::Apply()
+{
+  if (fStages.empty()) return;
+
+  const Int_t nCells = fAbsId.size();
+  for (Int_t iCell = 0; iCell < nCells; iCell++) {
+    const Int_t absId = fAbsId[iCell];
+    Double_t ecell = fAmplitude[iCell];
+    Double_t tcell = fTime[iCell];
+    Bool_t highGain = fHighGain[iCell];
+
+    for (const Stage & stage : fStages) {
+      const AliEmcalCorrectionCellCalibTable * table = stage.fTable;
+      const Bool_t isLowGain = !highGain;
+      // SetCell() without the gain in RecalibrateCells() resets the high gain flag
+      highGain = kFALSE;
+
+      const Int_t iSM = (absId >= 0 && absId < table->GetNCells()) ? table->GetSuperModule(absId) : -1;
+      if (iSM < 0 || (stage.fRemoveBadChannels && table->IsBad(absId))) {
+        ecell = 0;
+        tcell = -1;
+        continue;
+      }
+
+      // Energy, in single precision as in AcceptCalibrateCell()
+      Float_t amp = ecell;
+      if (!stage.fCalibrated && stage.fRecalibration)
+        amp *= table->GetEnergyFactor(absId);
+
+      // Time
+      Double_t time = tcell;
+      time -= stage.fConstantTimeShift*1e-9;
+      if (!stage.fCalibrated && stage.fTimeRecalibration && stage.fBC >= 0)
+        time -= table->GetTimeFactor(stage.fBC%4, absId, stage.fLowGain ? isLowGain : kFALSE)*1.e-9;
+
+      // Time with L1 phase, see AliEMCALRecoUtils::RecalibrateCellTimeL1Phase()
+      if (!stage.fCalibrated && stage.fL1Phase && stage.fBC >= 0) {
+        Int_t bc = stage.fBC%4;
+        Float_t offsetPerSM = 0.;
+        Int_t l1PhaseShift = table->GetL1Phase(iSM);
+        Int_t l1Phase = l1PhaseShift & 3;
+        if (bc >= l1Phase)
+          offsetPerSM = (bc - l1Phase)*25;
+        else
+          offsetPerSM = (bc - l1Phase + 4)*25;
+        Int_t l1shiftOffset = l1PhaseShift>>2;
+        l1shiftOffset *= 25;
+        time -= offsetPerSM*1.e-9;
+        time -= l1shiftOffset*1.e-9;
+      }
+
+      ecell = amp;
+      tcell = time;
+    }
+
+    fAmplitude[iCell] = ecell;
+    fTime[iCell] = tcell;
+    fHighGain[iCell] = highGain;
+  }
+
+  fStages.clear();
+}
+
+using namespace PWG::EMCAL;
+
+bool TestAliEmcalCorrectionCellArray::RunAllTests() const {
+  return TestCompareRecalibrateCells();
+}
+
+bool TestAliEmcalCorrectionCellArray::TestCompareRecalibrateCells() const {
+  AliEMCALGeometry *geom = AliEMCALGeometry::GetInstance("EMCAL_COMPLETE12SMV1_DCAL_8SM");
+  const Int_t run = 244918, bc = 1234;
+
+  // (super module, row, column, energy, time, high gain, bad channel status, energy factor, time factor high/low gain in ns)
+  struct TestCell { Int_t fSM, fRow, fCol; Double_t fE, fTime; Bool_t fHighGain; Int_t fStatus; Double_t fEnergyFactor, fTimeHG, fTimeLG; };
+  const std::vector<TestCell> testcells = {
+    { 0,  3,  5, 1.20, 612e-9, kTRUE,  0, 1.043, 598.4, 601.2},
+    { 0,  3,  6, 0.45, 615e-9, kFALSE, 2, 1.112, 599.1, 603.7},   // bad
+    { 1, 10, 20, 2.50, 605e-9, kTRUE,  0, 0.957, 602.3, 596.8},
+    { 1, 10, 21, 0.80, 608e-9, kFALSE, 0, 1.000, 600.7, 604.9},
+    { 5,  0, 47, 0.33, 590e-9, kTRUE,  1, 0.981, 597.5, 599.9},   // bad
+    { 9, 23,  0, 0.12, 620e-9, kFALSE, 0, 1.250, 603.8, 607.2},
+    {12,  5, 10, 3.10, 600e-9, kTRUE,  0, 0.912, 601.6, 598.3},
+    {12,  6, 10, 0.25, 601e-9, kFALSE, 0, 1.074, 596.2, 602.5},
+    {15, 20, 31, 0.70, 598e-9, kTRUE,  0, 1.031, 604.4, 600.1}
+  };
+  // Inside the calibration histograms, but not in the geometry
+  const Short_t nonExistingCell = 17700;
+
+  enum { kBadChannel, kEnergy, kTime };
+  auto configure = [&](AliEMCALRecoUtils &recoUtils, Int_t component) {
+    if (component == kBadChannel) {
+      recoUtils.SwitchOnBadChannelsRemoval();
+      for (const auto &tc : testcells) recoUtils.SetEMCALChannelStatus(tc.fSM, tc.fCol, tc.fRow, tc.fStatus);
+    } else if (component == kEnergy) {
+      recoUtils.SwitchOnRecalibration();
+      for (const auto &tc : testcells) recoUtils.SetEMCALChannelRecalibrationFactor(tc.fSM, tc.fCol, tc.fRow, tc.fEnergyFactor);
+    } else {
+      recoUtils.SwitchOnLG();
+      recoUtils.SwitchOnTimeRecalibration();
+      recoUtils.SwitchOnL1PhaseInTimeRecalibration();
+      recoUtils.SetConstantTimeShift(15.8);
+      for (const auto &tc : testcells) {
+        Int_t absId = geom->GetAbsCellIdFromCellIndexes(tc.fSM, tc.fRow, tc.fCol);
+        recoUtils.SetEMCALChannelTimeRecalibrationFactor(bc%4, absId, tc.fTimeHG, kFALSE);
+        recoUtils.SetEMCALChannelTimeRecalibrationFactor(bc%4, absId, tc.fTimeLG, kTRUE);
+      }
+      // L1 phase in the two lowest bits, shift in bunch crossings above
+      for (Int_t ism = 0; ism < geom->GetNumberOfSuperModules(); ism++) recoUtils.SetEMCALL1PhaseInTimeRecalibrationForSM(ism, (5*ism)%16);
+    }
+  };
+  auto fillCells = [&](AliAODCaloCells &cells) {
+    cells.CreateContainer(testcells.size() + 1);
+    for (UInt_t icell = 0; icell < testcells.size(); icell++) {
+      const TestCell &tc = testcells[icell];
+      cells.SetCell(icell, geom->GetAbsCellIdFromCellIndexes(tc.fSM, tc.fRow, tc.fCol), tc.fE, tc.fTime, -1, 0., tc.fHighGain);
+    }
+    cells.SetCell(testcells.size(), nonExistingCell, 0.5, 600e-9, -1, 0., kTRUE);
+    cells.Sort();
+  };
+
+  // Order of the default configuration, and time calibration first to use the gain of the input cells
+  const std::vector<std::vector<Int_t>> orders = {{kBadChannel, kEnergy, kTime}, {kTime, kBadChannel, kEnergy}};
+  bool testresult = true;
+  for (UInt_t iorder = 0; iorder < orders.size(); iorder++) {
+    const std::vector<Int_t> &order = orders[iorder];
+    AliAODCaloCells defaultCells("emcalCells", "emcalCells", AliVCaloCells::kEMCALCell), fusedCells("emcalCells", "emcalCells", AliVCaloCells::kEMCALCell);
+    fillCells(defaultCells);
+    fillCells(fusedCells);
+
+    // Default path, as in AliEmcalCorrectionComponent::UpdateCells()
+    AliEMCALRecoUtils defaultUtils[3];
+    for (UInt_t icomp = 0; icomp < order.size(); icomp++) {
+      configure(defaultUtils[icomp], order[icomp]);
+      defaultUtils[icomp].RecalibrateCells(&defaultCells, bc);
+      defaultCells.Sort();
+    }
+
+    // Packed cells, as with AliEmcalCorrectionTask::SetFuseCellComponents()
+    AliEMCALRecoUtils fusedUtils[3];
+    AliEmcalCorrectionCellCalibTable tables[3];
+    AliEmcalCorrectionCellArray cellArray;
+    cellArray.Load(&fusedCells);
+    for (UInt_t icomp = 0; icomp < order.size(); icomp++) {
+      configure(fusedUtils[icomp], order[icomp]);
+      tables[icomp].Update(&fusedUtils[icomp], run);
+      cellArray.AddStage(&fusedUtils[icomp], &tables[icomp], bc);
+    }
+    cellArray.Store();
+
+    const Int_t nCells = testcells.size() + 1;
+    if (defaultCells.GetNumberOfCells() != nCells || fusedCells.GetNumberOfCells() != nCells) {
+      AliErrorStream() << "Order " << iorder << ": " << defaultCells.GetNumberOfCells() << " cells with the default path, "
+                       << fusedCells.GetNumberOfCells() << " with the packed cells, expected " << nCells << std::endl;
+      testresult = false;
+      continue;
+    }
+    Int_t nRejected = 0;
+    for (Int_t icell = 0; icell < nCells; icell++) {
+      Short_t defaultId = -1, fusedId = -1;
+      Double_t defaultE = 0, fusedE = 0, defaultTime = 0, fusedTime = 0, efrac = 0;
+      Int_t mclabel = -1;
+      defaultCells.GetCell(icell, defaultId, defaultE, defaultTime, mclabel, efrac);
+      fusedCells.GetCell(icell, fusedId, fusedE, fusedTime, mclabel, efrac);
+      if (defaultE == 0) nRejected++;
+      // The packed cells reproduce the single precision of the default path, the results must be identical
+      if (defaultId != fusedId || defaultE != fusedE || defaultTime != fusedTime || defaultCells.GetHighGain(icell) != fusedCells.GetHighGain(icell)) {
+        AliErrorStream() << "Order " << iorder << ", cell " << icell << ": ID " << defaultId << ", E = " << defaultE << ", t = " << defaultTime
+                         << ", high gain " << defaultCells.GetHighGain(icell) << " with the default path, ID " << fusedId << ", E = " << fusedE
+                         << ", t = " << fusedTime << ", high gain " << fusedCells.GetHighGain(icell) << " with the packed cells" << std::endl;
+        testresult = false;
+      }
+    }
+    // Two bad cells and the cell outside of the geometry
+    if (nRejected != 3) {
+      AliErrorStream() << "Order " << iorder << ": " << nRejected << " cells rejected by the default path, expected 3" << std::endl;
+      testresult = false;
+    }
+  }
+  return testresult;
+}
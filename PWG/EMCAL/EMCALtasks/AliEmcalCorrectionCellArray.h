@@ -0,0 +1,164 @@
+#ifndef ALIEMCALCORRECTIONCELLARRAY_H
+#define ALIEMCALCORRECTIONCELLARRAY_H
+
+#include <vector>
+
+#include <Rtypes.h>
+#include <TObject.h>
+
+class AliEMCALRecoUtils;
+class AliVCaloCells;
+
+/**
+ * @class AliEmcalCorrectionCellCalibTable
+ * @ingroup EMCALCOREFW
+ * @brief Per-run cell calibration of an AliEMCALRecoUtils, flattened by absolute cell ID
+ *
+ * Dense copy of the bad channel map, energy and time calibration factors and L1 phases held by
+ * the histograms of an AliEMCALRecoUtils, such that the cell loop does not go through the
+ * histograms and the geometry for each cell. The tables are filled with the getters of
+ * AliEMCALRecoUtils, only for the calibrations switched on, and refilled when the run changes.
+ */
+class AliEmcalCorrectionCellCalibTable {
+ public:
+  AliEmcalCorrectionCellCalibTable();
+
+  void Update(const AliEMCALRecoUtils * recoUtils, Int_t run);
+
+  Int_t    GetNCells()                              const { return fNCells                 ; }
+  /// Super module of the cell, -1 if the absolute ID does not exist
+  Int_t    GetSuperModule(Int_t absId)              const { return fSuperModule[absId]     ; }
+  Bool_t   IsBad(Int_t absId)                       const { return fBad[absId]             ; }
+  Float_t  GetEnergyFactor(Int_t absId)             const { return fEnergyFactor[absId]    ; }
+  Float_t  GetTimeFactor(Int_t bc, Int_t absId, Bool_t isLGon) const { return fTimeFactor[bc+4*isLGon][absId]; }
+  Int_t    GetL1Phase(Int_t iSM)                    const { return fL1Phase[iSM]           ; }
+
+ private:
+  /// Calibrations filled in the tables
+  enum ETable_t {
+    kBadChannels   = 1<<0,
+    kEnergy        = 1<<1,
+    kTime          = 1<<2,
+    kTimeLowGain   = 1<<3,
+    kL1Phase       = 1<<4
+  };
+
+  Bool_t GetCellIndex(Int_t absId, Int_t & iSM, Int_t & iEta, Int_t & iPhi) const;
+
+  Int_t                  fRun;                ///< Run of the tables
+  UInt_t                 fFilled;             ///< Tables filled for the run, see ETable_t
+  Int_t                  fNCells;             ///< Number of absolute cell IDs
+  std::vector<Short_t>   fSuperModule;        ///< Super module by absolute ID, -1 if the cell does not exist
+  std::vector<UChar_t>   fBad;                ///< Bad channel flag by absolute ID, with the bad status selection applied
+  std::vector<Float_t>   fEnergyFactor;       ///< Energy recalibration factor by absolute ID
+  std::vector<Float_t>   fTimeFactor[8];      ///< Time recalibration factor (ns) by absolute ID, index bc+4*isLGon as in AliEMCALRecoUtils
+  std::vector<Int_t>     fL1Phase;            ///< L1 phase shift by super module
+};
+
+/**
+ * @class AliEmcalCorrectionCellArray
+ * @ingroup EMCALCOREFW
+ * @brief Packed per-event copy of the cells shared by the cell correction components
+ *
+ * The cells are read once from AliVCaloCells into contiguous columns (absolute ID, amplitude, time,
+ * MC label, energy fraction, high gain flag). The cell components queue their recalibration as a
+ * stage (AddStage()) instead of looping over AliVCaloCells, and the queued stages are applied in a
+ * single loop over the cells, each cell going through the stages in the order they were added.
+ * The result is written back to AliVCaloCells once with Store().
+ *
+ * Each stage reproduces AliEMCALRecoUtils::RecalibrateCells() exactly, including the single
+ * precision of the recalibrated amplitude and the reset of the high gain flag by SetCell().
+ */
+class AliEmcalCorrectionCellArray {
+ public:
+  AliEmcalCorrectionCellArray();
+
+  void Load(AliVCaloCells * cells);
+  void Store();
+  void AddStage(AliEMCALRecoUtils * recoUtils, const AliEmcalCorrectionCellCalibTable * table, Int_t bc);
+  void Apply();
+
+  /// Cells currently loaded, null if none
+  AliVCaloCells   *GetCells()                 const { return fCells                ; }
+  Int_t            GetNumberOfCells()         const { return (Int_t)fAbsId.size()  ; }
+  Short_t          GetCellNumber(Int_t i)     const { return fAbsId[i]             ; }
+  Double_t         GetAmplitude(Int_t i)      const { return fAmplitude[i]         ; }
+  Double_t         GetTime(Int_t i)           const { return fTime[i]              ; }
+
+ private:
+  /// Recalibration of the cells by one component, see AliEMCALRecoUtils::AcceptCalibrateCell()
+  struct Stage {
+    const AliEmcalCorrectionCellCalibTable *fTable; ///< Calibration of the component
+    Bool_t    fCalibrated;                    ///< Cells already calibrated, only the bad channels are removed
+    Bool_t    fRemoveBadChannels;             ///< Reject the bad channels
+    Bool_t    fRecalibration;                 ///< Recalibrate the energy
+    Bool_t    fTimeRecalibration;             ///< Recalibrate the time
+    Bool_t    fLowGain;                       ///< Use the low gain time calibration for low gain cells
+    Bool_t    fL1Phase;                       ///< Correct the time for the L1 phase
+    Float_t   fConstantTimeShift;             ///< Constant time shift (ns)
+    Int_t     fBC;                            ///< Bunch crossing number
+  };
+
+  AliVCaloCells           *fCells;            ///< Cells loaded in the columns
+  Bool_t                   fModified;         ///< Stages were applied since loading
+  std::vector<Short_t>     fAbsId;            ///< Absolute cell ID
+  std::vector<Double_t>    fAmplitude;        ///< Cell amplitude
+  std::vector<Double_t>    fTime;             ///< Cell time
+  std::vector<Int_t>       fMCLabel;          ///< Cell MC label
+  std::vector<Double_t>    fEFrac;            ///< Cell energy fraction from embedded signal
+  std::vector<UChar_t>     fHighGain;         ///< Cell high gain flag
+  std::vector<Stage>       fStages;           ///< Stages queued since the last Apply()
+};
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class TestAliEmcalCorrectionCellArray
+ * @brief Unit test for the packed cells of the cell correction components
+ * @ingroup EMCALCOREFW
+ *
+ * Recalibrates a fixed list of cells with the bad channel, energy and time
+ * calibration of three reco utils, once with AliEMCALRecoUtils::RecalibrateCells()
+ * as the cell components do by default and once with the stages of
+ * AliEmcalCorrectionCellArray, and compares the cells obtained.
+ */
+class TestAliEmcalCorrectionCellArray : public TObject {
+public:
+  TestAliEmcalCorrectionCellArray() : TObject() {}
+  virtual ~TestAliEmcalCorrectionCellArray() {}
+
+  /**
+   * @brief Run all unit tests for the packed cells
+   *
+   * @return true All tests passed
+   * @return false At least one failure observed
+   */
+  bool RunAllTests() const;
+
+  /**
+   * @brief Compare the packed cells with the default recalibration
+   *
+   * The cell list contains bad cells, recalibrated cells, high and low gain
+   * cells in EMCal and DCal super modules with different L1 phases, and a
+   * cell ID outside of the geometry. The components are run in the order of
+   * the default configuration and with the time calibration first, such that
+   * the low gain time calibration sees the gain of the input cells. Both paths
+   * must give the same cells, amplitudes, times and gains.
+   *
+   * @return true  Same cells obtained
+   * @return false At least one cell different
+   */
+  bool TestCompareRecalibrateCells() const;
+
+  /// \cond CLASSIMP
+  ClassDef(TestAliEmcalCorrectionCellArray, 1);
+  /// \endcond
+};
+
+}
+
+}
+
+#endif /* ALIEMCALCORRECTIONCELLARRAY_H */
@@ -140,32 +140,17 @@ Int_t AliEmcalCorrectionCellEnergy::InitRecalib()
   Int_t runRC = fEventManager.InputEvent()->GetRunNumber();
   
   std::unique_ptr<AliOADBContainer> contRF;
-  std::unique_ptr<TFile> recalibFile;
   if (fBasePath!="")
   { //if fBasePath specified
     AliInfo(Form("Loading Recalib OADB from given path %s",fBasePath.Data()));
     
-    recalibFile = std::unique_ptr<TFile>(TFile::Open(Form("%s/EMCALRecalib.root",fBasePath.Data()),"read"));
-    if (!recalibFile || recalibFile->IsZombie())
-    {
-      AliFatal(Form("EMCALRecalib.root not found in %s",fBasePath.Data()));
-      return 0;
-    }
-    
-    contRF = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(recalibFile->Get("AliEMCALRecalib")));
+    contRF = LoadOADBContainer(Form("%s/EMCALRecalib.root",fBasePath.Data()), "AliEMCALRecalib", runRC);
   }
   else
   { // Else choose the one in the $ALICE_PHYSICS directory
     AliInfo("Loading Recalib OADB from OADB/EMCAL");
     
-    recalibFile = std::unique_ptr<TFile>(TFile::Open(AliDataFile::GetFileNameOADB("EMCAL/EMCALRecalib.root").data(),"read"));
-    if (!recalibFile || recalibFile->IsZombie())
-    {
-      AliFatal("OADB/EMCAL/EMCALRecalib.root was not found");
-      return 0;
-    }
-    
-    contRF = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(recalibFile->Get("AliEMCALRecalib")));
+    contRF = LoadOADBContainer(AliDataFile::GetFileNameOADB("EMCAL/EMCALRecalib.root"), "AliEMCALRecalib", runRC);
   }
   if(!contRF) {
     AliError("No OADB container found");
@@ -243,42 +228,16 @@ Int_t AliEmcalCorrectionCellEnergy::InitRunDepRecalib()
     // two files and two OADB containers are needed for the correction factor
     std::unique_ptr<AliOADBContainer> contTemperature;
     std::unique_ptr<AliOADBContainer> contParams;
-    std::unique_ptr<TFile> runDepTemperatureFile;
-    std::unique_ptr<TFile> temperatureCalibParamFile;
 
     if (fBasePath!="")
     { //if fBasePath specified in the ->SetBasePath()
-      runDepTemperatureFile = std::unique_ptr<TFile>(TFile::Open(Form("%s/EMCALTemperatureCalibSM.root",fBasePath.Data()),"read"));
-      if (!runDepTemperatureFile || runDepTemperatureFile->IsZombie()) {
-        AliFatal(Form("EMCALTemperatureCalibSM.root not found in %s",fBasePath.Data()));
-        return 0;
-      }
-
-      temperatureCalibParamFile = std::unique_ptr<TFile>(TFile::Open(Form("%s/EMCALTemperatureCalibParam.root",fBasePath.Data()),"read"));
-      if (!temperatureCalibParamFile || temperatureCalibParamFile->IsZombie()) {
-        AliFatal(Form("EMCALTemperatureCalibParam.root not found in %s",fBasePath.Data()));
-        return 0;
-      }
-
-      contTemperature = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(runDepTemperatureFile->Get("AliEMCALTemperatureCalibSM")));
-      contParams = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(temperatureCalibParamFile->Get("AliEMCALTemperatureCalibParam")));
+      contTemperature = LoadOADBContainer(Form("%s/EMCALTemperatureCalibSM.root",fBasePath.Data()), "AliEMCALTemperatureCalibSM", runRC);
+      contParams = LoadOADBContainer(Form("%s/EMCALTemperatureCalibParam.root",fBasePath.Data()), "AliEMCALTemperatureCalibParam", runRC);
     }
     else
     { // Else choose the one in the $ALICE_PHYSICS directory or on EOS via the wrapper function
-      runDepTemperatureFile = std::unique_ptr<TFile>(TFile::Open(AliDataFile::GetFileNameOADB("EMCAL/EMCALTemperatureCalibSM.root").data(),"read"));
-      if (!runDepTemperatureFile || runDepTemperatureFile->IsZombie()) {
-        AliFatal("OADB/EMCAL/EMCALTemperatureCalibSM.root was not found");
-        return 0;
-      }
-
-      temperatureCalibParamFile = std::unique_ptr<TFile>(TFile::Open(AliDataFile::GetFileNameOADB("EMCAL/EMCALTemperatureCalibParam.root").data(),"read"));
-      if (!temperatureCalibParamFile || temperatureCalibParamFile->IsZombie()) {
-        AliFatal("OADB/EMCAL/EMCALTemperatureCalibParam.root was not found");
-        return 0;
-      }
-
-      contTemperature = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(runDepTemperatureFile->Get("AliEMCALTemperatureCalibSM")));
-      contParams = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(temperatureCalibParamFile->Get("AliEMCALTemperatureCalibParam")));
+      contTemperature = LoadOADBContainer(AliDataFile::GetFileNameOADB("EMCAL/EMCALTemperatureCalibSM.root"), "AliEMCALTemperatureCalibSM", runRC);
+      contParams = LoadOADBContainer(AliDataFile::GetFileNameOADB("EMCAL/EMCALTemperatureCalibParam.root"), "AliEMCALTemperatureCalibParam", runRC);
     }
 
     if(!contTemperature || !contParams) {
@@ -334,32 +293,17 @@ Int_t AliEmcalCorrectionCellEnergy::InitRunDepRecalib()
     AliInfo("Initialising recalibration factors");
 
     std::unique_ptr<AliOADBContainer> contRF;
-    std::unique_ptr<TFile> runDepRecalibFile;
     if (fBasePath!="")
     { //if fBasePath specified in the ->SetBasePath()
       AliInfo(Form("Loading Recalib OADB from given path %s",fBasePath.Data()));
 
-      runDepRecalibFile = std::unique_ptr<TFile>(TFile::Open(Form("%s/EMCALTemperatureCorrCalib.root",fBasePath.Data()),"read"));
-      if (!runDepRecalibFile || runDepRecalibFile->IsZombie())
-      {
-        AliFatal(Form("EMCALTemperatureCorrCalib.root not found in %s",fBasePath.Data()));
-        return 0;
-      }
-
-      contRF = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(runDepRecalibFile->Get("AliEMCALRunDepTempCalibCorrections")));
+      contRF = LoadOADBContainer(Form("%s/EMCALTemperatureCorrCalib.root",fBasePath.Data()), "AliEMCALRunDepTempCalibCorrections", runRC);
     }
     else
     { // Else choose the one in the $ALICE_PHYSICS directory or on EOS via the wrapper function
       AliInfo("Loading Recalib OADB from OADB/EMCAL");
 
-      runDepRecalibFile = std::unique_ptr<TFile>(TFile::Open(AliDataFile::GetFileNameOADB("EMCAL/EMCALTemperatureCorrCalib.root").data(),"read"));
-      if (!runDepRecalibFile || runDepRecalibFile->IsZombie())
-      {
-        AliFatal("OADB/EMCAL/EMCALTemperatureCorrCalib.root was not found");
-        return 0;
-      }
-
-      contRF = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(runDepRecalibFile->Get("AliEMCALRunDepTempCalibCorrections")));
+      contRF = LoadOADBContainer(AliDataFile::GetFileNameOADB("EMCAL/EMCALTemperatureCorrCalib.root"), "AliEMCALRunDepTempCalibCorrections", runRC);
     }
     if(!contRF) {
       AliError("No OADB container found");
@@ -147,32 +147,17 @@ Int_t AliEmcalCorrectionCellTimeCalib::InitTimeCalibration()
   Int_t runBC = fEventManager.InputEvent()->GetRunNumber();
   
   std::unique_ptr<AliOADBContainer> contTimeCalib;
-  std::unique_ptr<TFile> timeCalibFile;
   if (fBasePath!="")
   { //if fBasePath specified in the ->SetBasePath()
     AliInfo(Form("Loading time calibration OADB from given path %s",fBasePath.Data()));
     
-    timeCalibFile = std::unique_ptr<TFile>(TFile::Open(Form("%s/EMCALTimeCalib.root",fBasePath.Data()),"read"));
-    if (!timeCalibFile || timeCalibFile->IsZombie())
-    {
-      AliFatal(Form("EMCALTimeCalib.root was not found in the path provided: %s",fBasePath.Data()));
-      return 0;
-    }
-    
-    contTimeCalib = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(timeCalibFile->Get("AliEMCALTimeCalib")));
+    contTimeCalib = LoadOADBContainer(Form("%s/EMCALTimeCalib.root",fBasePath.Data()), "AliEMCALTimeCalib", runBC);
   }
   else
   { // Else choose the one in the $ALICE_PHYSICS directory
     AliInfo("Loading time calibration OADB from $ALICE_PHYSICS/OADB/EMCAL");
     
-    timeCalibFile = std::unique_ptr<TFile>(TFile::Open(AliDataFile::GetFileNameOADB("EMCAL/EMCALTimeCalib.root").data(),"read"));
-    if (!timeCalibFile || timeCalibFile->IsZombie())
-    {
-      AliFatal("OADB/EMCAL/EMCALTimeCalib.root was not found");
-      return 0;
-    }
-    
-    contTimeCalib = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(timeCalibFile->Get("AliEMCALTimeCalib")));
+    contTimeCalib = LoadOADBContainer(AliDataFile::GetFileNameOADB("EMCAL/EMCALTimeCalib.root"), "AliEMCALTimeCalib", runBC);
   }
   if(!contTimeCalib){
     AliError("No OADB container found");
@@ -252,32 +237,17 @@ Int_t AliEmcalCorrectionCellTimeCalib::InitTimeCalibrationL1Phase()
   Int_t runBC = fEventManager.InputEvent()->GetRunNumber();
   
   std::unique_ptr<AliOADBContainer> contTimeCalib;
-  std::unique_ptr<TFile> timeFile;
   if (fBasePath!="")
   { //if fBasePath specified in the ->SetBasePath()
     AliInfo(Form("Loading time calibration OADB from given path %s",fBasePath.Data()));
     
-    timeFile = std::unique_ptr<TFile>(TFile::Open(Form("%s/EMCALTimeL1PhaseCalib.root",fBasePath.Data()),"read"));
-    if (!timeFile || timeFile->IsZombie())
-    {
-      AliFatal(Form("EMCALTimeL1PhaseCalib.root was not found in the path provided: %s",fBasePath.Data()));
-      return 0;
-    }
-    
-    contTimeCalib = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(timeFile->Get("AliEMCALTimeL1PhaseCalib")));
+    contTimeCalib = LoadOADBContainer(Form("%s/EMCALTimeL1PhaseCalib.root",fBasePath.Data()), "AliEMCALTimeL1PhaseCalib", runBC);
   }
   else
   { // Else choose the one in the $ALICE_PHYSICS directory
     AliInfo("Loading L1 phase in time calibration OADB from OADB/EMCAL");
     
-    timeFile = std::unique_ptr<TFile>(TFile::Open(AliDataFile::GetFileNameOADB("EMCAL/EMCALTimeL1PhaseCalib.root").data(),"read"));
-    if (!timeFile || timeFile->IsZombie())
-    {
-      AliFatal("OADB/EMCAL/EMCALTimeL1PhaseCalib.root was not found");
-      return 0;
-    }
-    
-    contTimeCalib = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(timeFile->Get("AliEMCALTimeL1PhaseCalib")));
+    contTimeCalib = LoadOADBContainer(AliDataFile::GetFileNameOADB("EMCAL/EMCALTimeL1PhaseCalib.root"), "AliEMCALTimeL1PhaseCalib", runBC);
   }
   if(!contTimeCalib){
     AliError("No OADB container found");
@@ -5,6 +5,7 @@
 
 #include <TH1.h>
 #include <TList.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -13,6 +14,7 @@
 #include "AliAODCaloCluster.h"
 #include "AliVParticle.h"
 #include "AliEmcalParticle.h"
+#include "AliEmcalTrackSurfaceCache.h"
 #include "AliEMCALGeometry.h"
 #include "AliMCEvent.h"
 
@@ -39,6 +41,8 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUpdateClusters(kTRUE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
+  fTrackGrid(),
+  fTrackCandidates(),
   fEmcalTracks(0),
   fEmcalClusters(0),
   fNEmcalTracks(0),
@@ -181,6 +185,10 @@ void AliEmcalCorrectionClusterTrackMatcher::ExecOnce()
 {
   fClusterContainerIndexMap.CopyMappingFrom(AliClusterContainer::GetEmcalContainerIndexMap(), fClusterCollArray);
   fParticleContainerIndexMap.CopyMappingFrom(AliParticleContainer::GetEmcalContainerIndexMap(), fParticleCollArray);
+
+  // Bins of the track grid at least as large as the matching distance, tracks outside of |eta| < 1 are in the edge bins
+  Double_t binWidth = TMath::Max(fMaxDistance, 0.05);
+  fTrackGrid.SetBinning(TMath::CeilNint(2. / binWidth), -1., 1., TMath::CeilNint(TMath::TwoPi() / binWidth));
 }
 
 /**
@@ -290,6 +298,9 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
     mass = 0.1396;
   }
 
+  PWG::EMCAL::AliEmcalTrackSurfaceCache *surfaceCache = PWG::EMCAL::AliEmcalTrackSurfaceCache::Instance();
+  surfaceCache->SetEvent(fEventManager.InputEvent());
+
   AliParticleContainer * partCont = 0;
   TIter nextPartCont(&fParticleCollArray);
   while ((partCont = static_cast<AliParticleContainer*>(nextPartCont()))) {
@@ -333,7 +344,7 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
         }
         
         // Propagate the track
-        AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA);
+        surfaceCache->PropagateTrack(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA);
       }
 
       // Reset properties of the track to fix TRefArray errors which occur when AddTrackMatched(obj) is called.
@@ -363,18 +374,34 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 
 /**
  * Set the links between tracks and clusters.
+ *
+ * Each cluster is compared to the tracks found in the track grid around its position. The candidates
+ * are in increasing track order, and the clusters are processed in increasing order, such that the
+ * matched objects are added in the same order as when comparing all tracks to all clusters.
  */
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  fTrackGrid.Clear();
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
-    AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
-    AliVTrack* track = emcalTrack->GetTrack();
+    AliVTrack* track = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack))->GetTrack();
+    fTrackGrid.Add(itrack, track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal());
+  }
+  fTrackGrid.Build();
+
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    AliVCluster* cluster = emcalCluster->GetCluster();
+
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    fTrackGrid.FindCandidates(cpos.Eta(), cpos.Phi(), fMaxDistance, fMaxDistance, fTrackCandidates);
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
-      AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
-      AliVCluster* cluster = emcalCluster->GetCluster();
+    for (auto itrack : fTrackCandidates) {
+      AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
+      AliVTrack* track = emcalTrack->GetTrack();
       
       Double_t deta = 999;
       Double_t dphi = 999;
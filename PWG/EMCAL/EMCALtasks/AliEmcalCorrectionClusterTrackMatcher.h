@@ -1,7 +1,10 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
+#include "AliEmcalEtaPhiGrid.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 #include "AliEmcalContainerIndexMap.h"
@@ -45,6 +48,11 @@ class AliVParticle;
  ~~~
  (again assuming that the task is derived from AliAnalysisTaskEmcal or AliAnalysisTaskEmcalJet).
  *
+ * The tracks are propagated through PWG::EMCAL::AliEmcalTrackSurfaceCache, such that a track propagated with the same
+ * settings by another task in the event (e.g. another track matcher or AliEmcalTrackPropagatorTask) is not propagated
+ * again. For the matching, the tracks are binned in an \f$\eta\f$-\f$\phi\f$ grid by their position on the EMCal
+ * surface, and each cluster is only compared to the tracks in the bins within the maximum distance.
+ *
  * Based on code in AliEmcalClusTrackMatcherTask. 
  *
  * @author Constantin Loizides, LBNL, AliEmcalClusTrackMatcherTask
@@ -94,6 +102,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   AliEmcalContainerIndexMap <AliParticleContainer, AliVParticle> fParticleContainerIndexMap; //!<! Mapping between index and particle containers
 #endif
 
+  PWG::EMCAL::AliEmcalEtaPhiGrid fTrackGrid; //!<!tracks binned by their position on the EMCal surface
+  std::vector<Int_t> fTrackCandidates;  //!<!tracks close to the current cluster
   TClonesArray *fEmcalTracks;           //!<!emcal tracks
   TClonesArray *fEmcalClusters;         //!<!emcal clusters
   Int_t         fNEmcalTracks;          //!<!number of emcal tracks
@@ -115,7 +125,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
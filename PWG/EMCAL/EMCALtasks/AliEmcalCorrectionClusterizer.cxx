@@ -16,9 +16,15 @@
  **************************************************************************/
 
 // --- Root ---
+#include <algorithm>
+#include <iostream>
+
+#include <TClonesArray.h>
+#include <TGeoMatrix.h>
 #include <TObjArray.h>
 #include <TArrayI.h>
 #include <TStopwatch.h>
+#include <TVector2.h>
 
 // --- AliRoot ---
 #include "AliCDBEntry.h"
@@ -38,6 +44,8 @@
 #include "AliInputEventHandler.h"
 #include "AliClusterContainer.h"
 #include "AliAODMCParticle.h"
+#include "AliAODCaloCells.h"
+#include "AliAODCaloCluster.h"
 #include "AliEMCALRecoUtils.h"
 #include "AliAODEvent.h"
 #include "AliESDEvent.h"
@@ -47,6 +55,7 @@
 
 /// \cond CLASSIMP
 ClassImp(AliEmcalCorrectionClusterizer);
+ClassImp(PWG::EMCAL::TestAliEmcalCorrectionClusterizer);
 /// \endcond
 
 // Actually registers the class with the base class
@@ -94,6 +103,23 @@ AliEmcalCorrectionClusterizer::AliEmcalCorrectionClusterizer() :
   fRemapMCLabelForAODs(0),
   fRecalDistToBadChannels(kFALSE),
   fRecalShowerShape(kFALSE),
+  fConnectedComponents(kFALSE),
+  fClusterizeSuperModules(),
+  fClusterizeRegions(),
+  fGridSuperModule(),
+  fGridEta(),
+  fGridPhi(),
+  fGridNeighbours(),
+  fGridSeedAllowed(),
+  fGridCellIndex(),
+  fCCAbsId(),
+  fCCAmplitude(),
+  fCCTime(),
+  fCCMCLabel(),
+  fCCMCEnergy(),
+  fCCParent(),
+  fCCCluster(),
+  fClusterCells(),
   fCaloClusters(0),
   fEsd(0),
   fAod(0)
@@ -145,6 +171,9 @@ Bool_t AliEmcalCorrectionClusterizer::Initialize()
   Float_t diffEAggregation = 0.;
   GetProperty("diffEAggregation", diffEAggregation);
   GetProperty("useTestPatternForInput", fTestPatternInput);
+  GetProperty("connectedComponents", fConnectedComponents);
+  GetProperty("clusterizeSuperModules", fClusterizeSuperModules);
+  GetProperty("clusterizeRegions", fClusterizeRegions);
   
   Int_t removeNMCGenerators = 0;
   GetProperty("removeNMCGenerators", removeNMCGenerators);
@@ -189,6 +218,28 @@ Bool_t AliEmcalCorrectionClusterizer::Initialize()
     }
   }
   
+  if (fConnectedComponents) {
+    if (clusterizerType != AliEMCALRecParam::kClusterizerv1 || fRecParam->GetUnfold()) {
+      AliWarning(Form("Connected components clusterization only available in place of %s without unfolding, using %s", "kClusterizerv1", clusterizerTypeStr.c_str()));
+      fConnectedComponents = kFALSE;
+    }
+    else if (fSetCellMCLabelFromCluster || fSetCellMCLabelFromEdepFrac || fTestPatternInput || fSubBackground || fLoadCalib || fLoadPed) {
+      AliWarning("Connected components clusterization not available with cell MC labels from clusters, test pattern, background subtraction or OCDB calibration, using the clusterizer");
+      fConnectedComponents = kFALSE;
+    }
+    else {
+      // same weight for the position and shower shape as in the rec points
+      fRecoUtils->SetW0(w0);
+    }
+  }
+  if (fClusterizeRegions.size() % 4) {
+    AliError(Form("Regions to clusterize must be given as (etaMin, etaMax, phiMin, phiMax), ignoring the last %d values", (Int_t)(fClusterizeRegions.size() % 4)));
+    fClusterizeRegions.resize(fClusterizeRegions.size() - fClusterizeRegions.size() % 4);
+  }
+  if (!fConnectedComponents && (fClusterizeSuperModules.size() || fClusterizeRegions.size())) {
+    AliWarning("Super modules or regions to clusterize are only used by the connected components clusterization, ignored");
+  }
+
   // Only support one cluster container for the clusterizer!
   if (fClusterCollArray.GetEntries() > 1) {
     AliFatal("Passed more than one cluster container to the clusterizer, but the clusterizer only supports one cluster container!");
@@ -278,11 +329,16 @@ Bool_t AliEmcalCorrectionClusterizer::Run()
     return kTRUE;
   }
   
-  FillDigitsArray();
-  
-  Clusterize();
-  
-  UpdateClusters();
+  if (fConnectedComponents) {
+    ClusterizeConnectedComponents();
+  }
+  else {
+    FillDigitsArray();
+    
+    Clusterize();
+    
+    UpdateClusters();
+  }
   
   CalibrateClusters();
 
@@ -627,6 +683,15 @@ void AliEmcalCorrectionClusterizer::UpdateClusters()
  */
 void AliEmcalCorrectionClusterizer::CalibrateClusters()
 {
+  // SHOWER SHAPE -----------------------------------------------
+  // always computed for the connected components, which have no rec points.
+  // The cells of all clusters are read once for the batch recalculation
+  if (fRecalShowerShape || fConnectedComponents) {
+    fClusterCells.Fill(fCaloCells, fCaloClusters);
+    fRecoUtils->RecalculateClusterShowerShapeParameters(fGeom, fClusterCells);
+    fClusterCells.Clear();
+  }
+  
   Int_t nclusters = fCaloClusters->GetEntriesFast();
   for (Int_t icluster=0; icluster < nclusters; ++icluster) {
     AliVCluster *clust = static_cast<AliVCluster*>(fCaloClusters->At(icluster));
@@ -637,10 +702,6 @@ void AliEmcalCorrectionClusterizer::CalibrateClusters()
       continue;
     }
     
-    // SHOWER SHAPE -----------------------------------------------
-    if (fRecalShowerShape)
-      fRecoUtils->RecalculateClusterShowerShapeParameters(fGeom, fCaloCells, clust);
-    
     // DISTANCE TO BAD CHANNELS -----------------------------------
     if (fRecalDistToBadChannels)
       fRecoUtils->RecalculateClusterDistanceToBadChannel(fGeom, fCaloCells, clust);
@@ -650,6 +711,264 @@ void AliEmcalCorrectionClusterizer::CalibrateClusters()
   fCaloClusters->Compress();
 }
 
+/**
+ * Build the flat cell grid of the connected components clusterization: super module, column, row and
+ * side neighbours of each absolute cell ID, and whether clusters can be seeded in the cell. The cells at
+ * the eta border of the two super modules of a row (2n, 2n+1) are neighbours, as for the cell cross.
+ */
+void AliEmcalCorrectionClusterizer::InitCellGrid()
+{
+  const Int_t nSM     = fGeom->GetNumberOfSuperModules();
+  const Int_t nRows   = AliEMCALGeoParams::fgkEMCALRows;
+  const Int_t nCols   = AliEMCALGeoParams::fgkEMCALCols;
+  const Int_t nAbsIds = nSM*nRows*nCols;
+  
+  if ((Int_t)fGridSuperModule.size() != nAbsIds) {
+    fGridSuperModule.assign(nAbsIds, -1);
+    fGridEta.assign(nAbsIds, -1);
+    fGridPhi.assign(nAbsIds, -1);
+    fGridNeighbours.assign(4*nAbsIds, -1);
+    fGridCellIndex.assign(nAbsIds, -1);
+    fGridSeedAllowed.clear();
+    
+    // absolute ID by (super module, row, column)
+    std::vector<Int_t> grid(nAbsIds, -1);
+    Int_t iSM = -1, iTower = -1, iIphi = -1, iIeta = -1, iphi = -1, ieta = -1;
+    for (Int_t absId = 0; absId < nAbsIds; absId++) {
+      if (!fGeom->GetCellIndex(absId, iSM, iTower, iIphi, iIeta)) continue;
+      fGeom->GetCellPhiEtaIndexInSModule(iSM, iTower, iIphi, iIeta, iphi, ieta);
+      fGridSuperModule[absId] = iSM;
+      fGridEta[absId]         = ieta;
+      fGridPhi[absId]         = iphi;
+      grid[(iSM*nRows + iphi)*nCols + ieta] = absId;
+    }
+    
+    for (Int_t absId = 0; absId < nAbsIds; absId++) {
+      iSM = fGridSuperModule[absId];
+      if (iSM < 0) continue;
+      iphi = fGridPhi[absId];
+      ieta = fGridEta[absId];
+      Int_t *neighbours = &fGridNeighbours[4*absId];
+      if (iphi > 0)                   neighbours[0] = grid[(iSM*nRows + iphi-1)*nCols + ieta];
+      if (iphi < nRows-1)             neighbours[1] = grid[(iSM*nRows + iphi+1)*nCols + ieta];
+      if (ieta > 0)                   neighbours[2] = grid[(iSM*nRows + iphi)*nCols + ieta-1];
+      else if (iSM%2)                 neighbours[2] = grid[((iSM-1)*nRows + iphi)*nCols + nCols-1];
+      if (ieta < nCols-1)             neighbours[3] = grid[(iSM*nRows + iphi)*nCols + ieta+1];
+      else if (!(iSM%2) && iSM+1<nSM) neighbours[3] = grid[((iSM+1)*nRows + iphi)*nCols];
+    }
+  }
+  
+  if (fGridSeedAllowed.empty()) {
+    fGridSeedAllowed.assign(nAbsIds, 0);
+    Double_t eta = 0, phi = 0;
+    for (Int_t absId = 0; absId < nAbsIds; absId++) {
+      Int_t iSM = fGridSuperModule[absId];
+      if (iSM < 0) continue;
+      Bool_t allowed = fClusterizeSuperModules.empty() ||
+        std::find(fClusterizeSuperModules.begin(), fClusterizeSuperModules.end(), iSM) != fClusterizeSuperModules.end();
+      if (allowed && !fClusterizeRegions.empty()) {
+        fGeom->EtaPhiFromIndex(absId, eta, phi);
+        phi = TVector2::Phi_0_2pi(phi);
+        allowed = kFALSE;
+        for (UInt_t ireg = 0; ireg + 3 < fClusterizeRegions.size() && !allowed; ireg += 4) {
+          allowed = eta >= fClusterizeRegions[ireg]   && eta <= fClusterizeRegions[ireg+1] &&
+                    phi >= fClusterizeRegions[ireg+2] && phi <= fClusterizeRegions[ireg+3];
+        }
+      }
+      fGridSeedAllowed[absId] = allowed;
+    }
+  }
+}
+
+/**
+ * Root of the connected component of a clusterized cell, halving the path on the way.
+ */
+Int_t AliEmcalCorrectionClusterizer::FindCellComponent(Int_t icell)
+{
+  while (fCCParent[icell] != icell) {
+    fCCParent[icell] = fCCParent[fCCParent[icell]];
+    icell = fCCParent[icell];
+  }
+  return icell;
+}
+
+/**
+ * Clusterize the cells as connected components of the cell grid and fill the new clusters.
+ * The cells are selected as the digits of the clusterizer (cellE, time window), and joined in one pass
+ * to their side neighbours within the cluster time length. Each component with a cell above seedE in
+ * the allowed super modules or regions is a cluster, clusters are ordered by their first seed cell.
+ */
+void AliEmcalCorrectionClusterizer::ClusterizeConnectedComponents()
+{
+  InitCellGrid();
+  
+  const Int_t    nAbsIds = fGridSuperModule.size();
+  const Double_t minE    = fRecParam->GetMinECut();
+  const Double_t seedE   = fRecParam->GetClusteringThreshold();
+  const Double_t timeMin = fRecParam->GetTimeMin();
+  const Double_t timeMax = fRecParam->GetTimeMax();
+  const Double_t timeCut = fRecParam->GetTimeCut();
+  
+  // Select the cells
+  fCCAbsId.clear();
+  fCCAmplitude.clear();
+  fCCTime.clear();
+  fCCMCLabel.clear();
+  fCCMCEnergy.clear();
+  fCCParent.clear();
+  
+  const Int_t ncells = fCaloCells->GetNumberOfCells();
+  for (Int_t icell = 0; icell < ncells; ++icell)
+  {
+    Double_t cellTime=0, amp = 0, cellEFrac = 0;
+    Short_t  cellNumber=0;
+    Int_t cellMCLabel=-1;
+    if (fCaloCells->GetCell(icell, cellNumber, amp, cellTime, cellMCLabel, cellEFrac) != kTRUE)
+      break;
+    
+    Float_t cellAmplitude = amp;
+    
+    if (fRemapMCLabelForAODs) RemapMCLabelForAODs(cellMCLabel);
+    
+    if (cellMCLabel > 0 && cellEFrac < 1e-6)
+      cellEFrac = 1;
+    
+    if (cellAmplitude < 1e-6 || cellNumber < 0 || cellNumber >= nAbsIds || fGridSuperModule[cellNumber] < 0)
+      continue;
+    
+    if (cellAmplitude < minE || (Float_t)cellTime < timeMin || (Float_t)cellTime > timeMax)
+      continue;
+    
+    fGridCellIndex[cellNumber] = fCCAbsId.size();
+    fCCParent.push_back(fCCAbsId.size());
+    fCCAbsId.push_back(cellNumber);
+    fCCAmplitude.push_back(cellAmplitude);
+    fCCTime.push_back(cellTime);
+    fCCMCLabel.push_back(cellMCLabel);
+    fCCMCEnergy.push_back(cellEFrac*cellAmplitude);
+  }
+  const Int_t nCC = fCCAbsId.size();
+  
+  // Join the neighbours, each pair once
+  for (Int_t icell = 0; icell < nCC; icell++) {
+    const Int_t *neighbours = &fGridNeighbours[4*fCCAbsId[icell]];
+    for (Int_t in = 0; in < 4; in++) {
+      if (neighbours[in] < 0) continue;
+      Int_t jcell = fGridCellIndex[neighbours[in]];
+      if (jcell <= icell) continue;
+      if (timeCut > 1e-12 && TMath::Abs(fCCTime[icell] - fCCTime[jcell]) >= timeCut) continue;
+      Int_t iroot = FindCellComponent(icell);
+      Int_t jroot = FindCellComponent(jcell);
+      if      (iroot < jroot) fCCParent[jroot] = iroot;
+      else if (jroot < iroot) fCCParent[iroot] = jroot;
+    }
+  }
+  
+  // Seeded components
+  fCCCluster.assign(nCC, -1);
+  Int_t nClusters = 0;
+  for (Int_t icell = 0; icell < nCC; icell++) {
+    if (fCCAmplitude[icell] <= seedE || !fGridSeedAllowed[fCCAbsId[icell]]) continue;
+    Int_t root = FindCellComponent(icell);
+    if (fCCCluster[root] < 0) fCCCluster[root] = nClusters++;
+  }
+  
+  // Cells of each cluster, in cell order
+  std::vector<Int_t> firstCell(nClusters+1, 0);
+  std::vector<Int_t> clusterCells(nCC);
+  for (Int_t icell = 0; icell < nCC; icell++) {
+    Int_t iclus = fCCCluster[FindCellComponent(icell)];
+    if (iclus >= 0) firstCell[iclus+1]++;
+  }
+  for (Int_t iclus = 0; iclus < nClusters; iclus++) firstCell[iclus+1] += firstCell[iclus];
+  std::vector<Int_t> nextCell(firstCell.begin(), firstCell.end()-1);
+  for (Int_t icell = 0; icell < nCC; icell++) {
+    Int_t iclus = fCCCluster[FindCellComponent(icell)];
+    if (iclus >= 0) clusterCells[nextCell[iclus]++] = icell;
+  }
+  
+  // cells sharing a side or a corner, for the local maxima
+  auto areNeighbours = [this](Int_t absId1, Int_t absId2) {
+    Int_t iSM1 = fGridSuperModule[absId1], iSM2 = fGridSuperModule[absId2];
+    if (iSM1/2 != iSM2/2) return kFALSE;
+    Int_t ieta1 = fGridEta[absId1] + (iSM1%2)*AliEMCALGeoParams::fgkEMCALCols;
+    Int_t ieta2 = fGridEta[absId2] + (iSM2%2)*AliEMCALGeoParams::fgkEMCALCols;
+    return TMath::Abs(ieta1-ieta2) <= 1 && TMath::Abs(fGridPhi[absId1]-fGridPhi[absId2]) <= 1;
+  };
+  
+  // Fill the clusters
+  ClearEMCalClusters();
+  
+  fCaloClusters->Compress();
+  
+  std::vector<UShort_t>   absIds;
+  std::vector<Double32_t> ratios;
+  std::vector<std::pair<Float_t, Int_t> > parents;
+  std::vector<Int_t>      labels;
+  for (Int_t iclus = 0, nout = fCaloClusters->GetEntries(); iclus < nClusters; iclus++)
+  {
+    const Int_t *cells = &clusterCells[firstCell[iclus]];
+    const Int_t ncellsClus = firstCell[iclus+1] - firstCell[iclus];
+    
+    absIds.resize(ncellsClus);
+    ratios.assign(ncellsClus, 1.);
+    Float_t energy = 0;
+    Int_t imax = cells[0];
+    for (Int_t c = 0; c < ncellsClus; c++) {
+      absIds[c] = fCCAbsId[cells[c]];
+      energy   += fCCAmplitude[cells[c]];
+      if (fCCAmplitude[cells[c]] > fCCAmplitude[imax]) imax = cells[c];
+    }
+    
+    // local maxima and MC labels, ordered by deposited energy
+    Int_t nExMax = 0;
+    Double_t mcEnergy = 0;
+    parents.clear();
+    for (Int_t c = 0; c < ncellsClus; c++) {
+      Int_t icell = cells[c];
+      Bool_t isLocalMax = kTRUE;
+      for (Int_t c2 = 0; c2 < ncellsClus && isLocalMax; c2++) {
+        if (c2 != c && fCCAmplitude[cells[c2]] >= fCCAmplitude[icell] && areNeighbours(absIds[c], absIds[c2])) isLocalMax = kFALSE;
+      }
+      if (isLocalMax) nExMax++;
+      
+      if (fCCMCLabel[icell] > 0)
+        mcEnergy += fCCMCEnergy[icell]/energy;
+      if (fCCMCLabel[icell] >= 0) {
+        Bool_t found = kFALSE;
+        for (auto & parent : parents) {
+          if (parent.second == fCCMCLabel[icell]) { parent.first += fCCMCEnergy[icell]; found = kTRUE; break; }
+        }
+        if (!found) parents.push_back(std::make_pair(fCCMCEnergy[icell], fCCMCLabel[icell]));
+      }
+    }
+    std::stable_sort(parents.begin(), parents.end(), [](const std::pair<Float_t, Int_t> & a, const std::pair<Float_t, Int_t> & b) { return a.first > b.first; });
+    labels.clear();
+    for (auto & parent : parents) labels.push_back(parent.second);
+    
+    AliVCluster *c = static_cast<AliVCluster*>(fCaloClusters->New(nout++));
+    c->SetType(AliVCluster::kEMCALClusterv1);
+    c->SetE(energy);
+    c->SetNCells(ncellsClus);
+    c->SetCellsAbsId(&absIds[0]);
+    c->SetCellsAmplitudeFraction(&ratios[0]);
+    c->SetID(nout-1);
+    c->SetDispersion(0);
+    c->SetEmcCpvDistance(-1);
+    c->SetChi2(-1);
+    c->SetTOF(fCCTime[imax]) ;     //time-of-flight
+    c->SetNExMax(nExMax);          //number of local maxima
+    c->SetMCEnergyFraction(mcEnergy);
+    if (labels.size()) c->SetLabel(&labels[0], labels.size());
+    
+    // the shower shape is computed for all clusters in CalibrateClusters()
+    fRecoUtils->RecalculateClusterPositionFromTowerGlobal(fGeom, fCaloCells, c);
+  }
+  
+  // reset the grid for the next event
+  for (Int_t icell = 0; icell < nCC; icell++) fGridCellIndex[fCCAbsId[icell]] = -1;
+}
+
 /**
  * MC label for Cells not remapped after ESD filtering -- do it here.
  */
@@ -845,6 +1164,18 @@ void AliEmcalCorrectionClusterizer::Init()
     fGeomMatrixSet=kTRUE;
   }
   
+  // no digits nor clusterizer for the connected components
+  if (fConnectedComponents)
+    return;
+  
+  InitClusterizer();
+}
+
+/**
+ * Set up the digits array and the clusterizer of the configured type.
+ */
+void AliEmcalCorrectionClusterizer::InitClusterizer()
+{
   // setup digit array if needed
   if (!fDigitsArr) {
     fDigitsArr = new TClonesArray("AliEMCALDigit", 1000);
@@ -956,3 +1287,95 @@ void AliEmcalCorrectionClusterizer::ClearEMCalClusters()
     }
   }
 }
+
+using namespace PWG::EMCAL;
+
+bool TestAliEmcalCorrectionClusterizer::RunAllTests() const {
+  return TestCompareV1();
+}
+
+bool TestAliEmcalCorrectionClusterizer::TestCompareV1() const {
+  AliEMCALGeometry *geom = AliEMCALGeometry::GetInstance("EMCAL_COMPLETE12SMV1_DCAL_8SM");
+  // Positions are not compared, ideal super module matrices only let the rec points evaluate them
+  TGeoHMatrix identity;
+  for (Int_t ism = 0; ism < geom->GetNumberOfSuperModules(); ism++) geom->SetMisalMatrix(&identity, ism);
+
+  // (super module, row, column, energy, time)
+  struct TestCell { Int_t fSM, fRow, fCol; Double_t fE, fTime; };
+  const std::vector<TestCell> testcells = {
+    {0,  2,  2, 1.00, 0.},       // isolated seed, with a neighbour below the cell energy
+    {0,  2,  3, 0.03, 0.},
+    {0,  2, 10, 0.08, 0.},       // isolated cell below the seed energy
+    {0,  9,  9, 0.20, 0.}, {0,  9, 10, 0.50, 0.}, {0,  9, 11, 0.21, 0.},     // 3x3 shower
+    {0, 10,  9, 0.52, 0.}, {0, 10, 10, 3.00, 0.}, {0, 10, 11, 0.54, 0.},
+    {0, 11,  9, 0.22, 0.}, {0, 11, 10, 0.56, 0.}, {0, 11, 11, 0.23, 0.},
+    {0, 20, 20, 0.80, 0.}, {0, 21, 21, 0.60, 0.},                            // touching at a corner
+    {0,  5, 47, 0.70, 0.}, {1,  5,  0, 0.40, 0.},                            // across the eta border of the pair
+    {2,  8,  8, 0.90, 0.}, {2,  8,  9, 0.50, 200e-9}, {2,  8, 10, 0.06, 200e-9}, // outside the cluster time length
+    {2, 15, 30, 0.50, 0.}, {2, 15, 31, 0.07, 0.}, {2, 15, 32, 0.07, 0.}, {2, 15, 33, 0.30, 0.} // seeds joined by low cells
+  };
+  AliAODCaloCells cells("emcalCells", "emcalCells", AliVCaloCells::kEMCALCell);
+  cells.CreateContainer(testcells.size());
+  for (UInt_t icell = 0; icell < testcells.size(); icell++) {
+    const TestCell &tc = testcells[icell];
+    cells.SetCell(icell, geom->GetAbsCellIdFromCellIndexes(tc.fSM, tc.fRow, tc.fCol), tc.fE, tc.fTime);
+  }
+  cells.Sort();
+
+  AliEMCALRecoUtils recoUtils;
+  recoUtils.SetW0(4.5);
+
+  TClonesArray ccClusters("AliAODCaloCluster"), v1Clusters("AliAODCaloCluster");
+  AliEmcalCorrectionClusterizer ccClusterizer, v1Clusterizer;
+  for (auto clusterizer : {&ccClusterizer, &v1Clusterizer}) {
+    clusterizer->SetEMCALGeometry(geom);
+    clusterizer->SetCaloCells(&cells);
+    clusterizer->SetRecoUtils(&recoUtils);
+    clusterizer->fRecParam->SetClusterizerFlag(AliEMCALRecParam::kClusterizerv1);
+    clusterizer->fRecParam->SetMinECut(0.05);
+    clusterizer->fRecParam->SetClusteringThreshold(0.1);
+    clusterizer->fRecParam->SetW0(4.5);
+    clusterizer->fRecParam->SetTimeMin(-1);
+    clusterizer->fRecParam->SetTimeMax(1);
+    clusterizer->fRecParam->SetTimeCut(50e-9);
+    clusterizer->fRecParam->SetLocMaxCut(0.);
+  }
+  ccClusterizer.fConnectedComponents = kTRUE;
+  ccClusterizer.fCaloClusters = &ccClusters;
+  ccClusterizer.ClusterizeConnectedComponents();
+  v1Clusterizer.fCaloClusters = &v1Clusters;
+  v1Clusterizer.InitClusterizer();
+  v1Clusterizer.FillDigitsArray();
+  v1Clusterizer.Clusterize();
+  v1Clusterizer.UpdateClusters();
+
+  // Clusters as (sorted cells, energy, time), ordered by their cells
+  struct TestCluster { std::vector<Int_t> fCells; Double_t fE, fTime; };
+  auto sortClusters = [](const TClonesArray &clusters) {
+    std::vector<TestCluster> result;
+    for (Int_t iclus = 0; iclus < clusters.GetEntriesFast(); iclus++) {
+      const AliVCluster *clus = static_cast<const AliVCluster *>(clusters.At(iclus));
+      if (!clus) continue;
+      TestCluster tc = {std::vector<Int_t>(clus->GetCellsAbsId(), clus->GetCellsAbsId() + clus->GetNCells()), clus->E(), clus->GetTOF()};
+      std::sort(tc.fCells.begin(), tc.fCells.end());
+      result.push_back(tc);
+    }
+    std::sort(result.begin(), result.end(), [](const TestCluster &a, const TestCluster &b) { return a.fCells < b.fCells; });
+    return result;
+  };
+  std::vector<TestCluster> cc = sortClusters(ccClusters), v1 = sortClusters(v1Clusters);
+
+  bool testresult = true;
+  if (cc.size() != v1.size() || cc.size() != 8) {
+    AliErrorStream() << cc.size() << " connected components clusters, " << v1.size() << " v1 clusters, expected 8" << std::endl;
+    testresult = false;
+  }
+  for (UInt_t iclus = 0; iclus < std::min(cc.size(), v1.size()); iclus++) {
+    if (cc[iclus].fCells != v1[iclus].fCells || TMath::Abs(cc[iclus].fE - v1[iclus].fE) > 1e-4 || TMath::Abs(cc[iclus].fTime - v1[iclus].fTime) > 1e-12) {
+      AliErrorStream() << "Cluster " << iclus << ": " << cc[iclus].fCells.size() << " cells, E = " << cc[iclus].fE << ", t = " << cc[iclus].fTime
+                   << " with the connected components, " << v1[iclus].fCells.size() << " cells, E = " << v1[iclus].fE << ", t = " << v1[iclus].fTime << " with v1" << std::endl;
+      testresult = false;
+    }
+  }
+  return testresult;
+}
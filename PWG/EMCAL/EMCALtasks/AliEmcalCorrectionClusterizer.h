@@ -3,10 +3,19 @@
 
 #include "AliEmcalCorrectionComponent.h"
 
+#include <vector>
+
 #include "AliEMCALRecParam.h"
+#include "AliEmcalClusterCellArrays.h"
 
 class TStopwatch;
 
+namespace PWG {
+namespace EMCAL {
+class TestAliEmcalCorrectionClusterizer;
+}
+}
+
 /**
  * @class AliEmcalCorrectionClusterizer
  * @ingroup EMCALCOREFW
@@ -22,6 +31,14 @@ class TStopwatch;
  *
  * At this point the energy of the cluster will be available through `cluster->E()` where cluster is the pointer to the AliAODCaloCluster or AliESDCaloCluster object.
  *
+ * With `connectedComponents` set and the v1 clusterizer, the cells are not converted to digits and clusterized by the AliEMCALClusterizer.
+ * Clusters are instead formed in one pass over a flat cell grid, as the connected components of the cells above
+ * `cellE` within the time window, joined through the cells sharing a side within `clusterTimeLength`. Components with a cell
+ * above `seedE` become clusters, as with the v1 clusterizer. Seeds can be restricted to some super modules
+ * (`clusterizeSuperModules`) or eta-phi regions (`clusterizeRegions`, or AddClusterizeRegion(), e.g. from trigger patches),
+ * clusters seeded there still being built completely. The cluster position is computed with
+ * AliEMCALRecoUtils::RecalculateClusterPositionFromTowerGlobal() and the shower shape as with `recalShowerShape`.
+ *
  * Based on code in AliAnalysisTaskEMCALClusterizeFast, in turn based on code by Deepa Thomas.
  *
  * @author Constantin Loizides, LBNL, AliAnalysisTaskEMCALClusterizeFast
@@ -44,15 +61,24 @@ class AliEmcalCorrectionClusterizer : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  /// Allow clusters to be seeded in an eta-phi region (phi in [0, 2pi)), in the connected components clusterization
+  void AddClusterizeRegion(Double_t etaMin, Double_t etaMax, Double_t phiMin, Double_t phiMax)
+  { fClusterizeRegions.insert(fClusterizeRegions.end(), {etaMin, etaMax, phiMin, phiMax}); fGridSeedAllowed.clear(); }
   
 protected:
   void           Clusterize();
   void           FillDigitsArray();
   void           Init();
+  void           InitClusterizer();
   void           RecPoints2Clusters(TClonesArray *clus);
   void           UpdateClusters();
   void           CalibrateClusters();
   
+  void           InitCellGrid();
+  void           ClusterizeConnectedComponents();
+  Int_t          FindCellComponent(Int_t icell);
+
   void           RemapMCLabelForAODs(Int_t &label);
   void           SetClustersMCLabelFromOriginalClusters();
   void           ClearEMCalClusters();
@@ -101,12 +127,33 @@ protected:
   
   Bool_t                 fRecalDistToBadChannels;         ///< recalculate distance to bad channel
   Bool_t                 fRecalShowerShape;               ///< switch for recalculation of the shower shape
+
+  // Connected components clusterization
+  Bool_t                 fConnectedComponents;            ///< clusterize the cells as connected components of the cell grid, instead of with the AliEMCALClusterizer
+  std::vector<Int_t>     fClusterizeSuperModules;         ///< super modules where clusters can be seeded, all if empty (connected components only)
+  std::vector<Double_t>  fClusterizeRegions;              ///< regions where clusters can be seeded, as groups of (etaMin, etaMax, phiMin, phiMax), all if empty (connected components only)
+  std::vector<Short_t>   fGridSuperModule;                //!<! super module by absolute cell ID, -1 if the cell does not exist
+  std::vector<Short_t>   fGridEta;                        //!<! column in the super module by absolute cell ID
+  std::vector<Short_t>   fGridPhi;                        //!<! row in the super module by absolute cell ID
+  std::vector<Int_t>     fGridNeighbours;                 //!<! absolute IDs of the 4 cells sharing a side with each cell, -1 if none
+  std::vector<UChar_t>   fGridSeedAllowed;                //!<! whether a cluster can be seeded in each cell
+  std::vector<Int_t>     fGridCellIndex;                  //!<! index in the clusterized cells of the event by absolute cell ID, -1 if none
+  std::vector<Int_t>     fCCAbsId;                        //!<! absolute ID of the clusterized cells
+  std::vector<Float_t>   fCCAmplitude;                    //!<! amplitude of the clusterized cells
+  std::vector<Float_t>   fCCTime;                         //!<! time of the clusterized cells
+  std::vector<Int_t>     fCCMCLabel;                      //!<! MC label of the clusterized cells
+  std::vector<Float_t>   fCCMCEnergy;                     //!<! MC deposited energy of the clusterized cells
+  std::vector<Int_t>     fCCParent;                       //!<! parent of the clusterized cells in their connected component
+  std::vector<Int_t>     fCCCluster;                      //!<! cluster of each connected component, by root cell, -1 if not seeded
+  PWG::EMCAL::AliEmcalClusterCellArrays fClusterCells;    //!<! cells of the clusters, for the batch shower shape recalculation
   
   TClonesArray          *fCaloClusters;                   //!<!calo clusters array
   AliESDEvent           *fEsd;                            //!<!esd event
   AliAODEvent           *fAod;                            //!<!aod event
 
  private:
+  friend class PWG::EMCAL::TestAliEmcalCorrectionClusterizer;
+
   AliEmcalCorrectionClusterizer(const AliEmcalCorrectionClusterizer &);               // Not implemented
   AliEmcalCorrectionClusterizer &operator=(const AliEmcalCorrectionClusterizer &);    // Not implemented
 
@@ -114,8 +161,56 @@ protected:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterizer> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterizer, 4); // EMCal correction clusterizer component
+  ClassDef(AliEmcalCorrectionClusterizer, 5); // EMCal correction clusterizer component
+  /// \endcond
+};
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class TestAliEmcalCorrectionClusterizer
+ * @brief Unit test for the connected components clusterization of AliEmcalCorrectionClusterizer
+ * @ingroup EMCALCOREFW
+ *
+ * Clusterizes a fixed list of cells with the connected components and with
+ * the v1 clusterizer without unfolding, and compares the clusters found.
+ */
+class TestAliEmcalCorrectionClusterizer : public TObject {
+public:
+  TestAliEmcalCorrectionClusterizer() : TObject() {}
+  virtual ~TestAliEmcalCorrectionClusterizer() {}
+
+  /**
+   * @brief Run all unit tests for the connected components clusterization
+   *
+   * @return true All tests passed
+   * @return false At least one failure observed
+   */
+  bool RunAllTests() const;
+
+  /**
+   * @brief Compare the connected components with the v1 clusterizer
+   *
+   * The cell list contains isolated cells above and below the seed energy,
+   * a 3x3 shower, clusters touching only at a corner, a cluster across
+   * the eta border of a super module pair and neighbouring cells outside
+   * the cluster time length. Both clusterizations must find the same
+   * clusters, with the same cells, energy and time.
+   *
+   * @return true  Same clusters found
+   * @return false At least one cluster different or missing
+   */
+  bool TestCompareV1() const;
+
+  /// \cond CLASSIMP
+  ClassDef(TestAliEmcalCorrectionClusterizer, 1);
   /// \endcond
 };
 
+}
+
+}
+
 #endif /* ALIEMCALCORRECTIONCLUSTERIZER_H */
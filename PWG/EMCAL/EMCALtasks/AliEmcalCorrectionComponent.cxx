@@ -3,8 +3,10 @@
 
 #include "AliEmcalCorrectionComponent.h"
 
+#include <map>
 #include <TFile.h>
 #include <TH1.h>
+#include <TSystem.h>
 
 #include <AliAnalysisManager.h>
 #include <AliVEvent.h>
@@ -16,6 +18,8 @@
 #include "AliParticleContainer.h"
 #include "AliMCParticleContainer.h"
 #include "AliDataFile.h"
+#include "AliCalibSnapshot.h"
+#include "AliEmcalCorrectionCellArray.h"
 
 /// \cond CLASSIMP
 ClassImp(AliEmcalCorrectionComponent);
@@ -50,7 +54,10 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   fCaloCells(0),
   fRecoUtils(0),
   fOutput(0),
-  fBasePath("")
+  fBasePath(""),
+  fCalibSnapshot(0),
+  fCellArray(0),
+  fCellCalibTable(0)
 
 {
   fVertex[0] = 0;
@@ -84,7 +91,10 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   fCaloCells(0),
   fRecoUtils(0),
   fOutput(0),
-  fBasePath("")
+  fBasePath(""),
+  fCalibSnapshot(0),
+  fCellArray(0),
+  fCellCalibTable(0)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -96,6 +106,7 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
  */
 AliEmcalCorrectionComponent::~AliEmcalCorrectionComponent()
 {
+  delete fCellCalibTable;
 }
 
 /**
@@ -196,6 +207,10 @@ void AliEmcalCorrectionComponent::GetEtaPhiDiff(const AliVTrack *t, const AliVCl
 /**
  * Remove bad cells from the cell list
  * Recalibrate energy and time cells
+ *
+ * When the packed cells are set (see AliEmcalCorrectionTask::SetFuseCellComponents()), the recalibration
+ * is only queued on them, with the calibration flattened by absolute cell ID. It is applied together with
+ * the one of the other cell components and written back to the cells by the correction task.
  */
 void AliEmcalCorrectionComponent::UpdateCells()
 {
@@ -204,6 +219,15 @@ void AliEmcalCorrectionComponent::UpdateCells()
   
   Int_t bunchCrossNo = fEventManager.InputEvent()->GetBunchCrossNumber();
   
+  if (fCellArray && fCellArray->GetCells() == fCaloCells) {
+    if (fRecoUtils) {
+      if (!fCellCalibTable) fCellCalibTable = new AliEmcalCorrectionCellCalibTable;
+      fCellCalibTable->Update(fRecoUtils, fRun);
+      fCellArray->AddStage(fRecoUtils, fCellCalibTable, bunchCrossNo);
+    }
+    return;
+  }
+
   if (fRecoUtils)
     fRecoUtils->RecalibrateCells(fCaloCells, bunchCrossNo);
   
@@ -292,6 +316,20 @@ void AliEmcalCorrectionComponent::FillCellQA(TH1F* h){
   Double_t efrac = 0;
   Int_t  mclabel = -1;
   
+  if (fCellArray && fCellArray->GetCells() == fCaloCells) {
+    // apply the queued recalibrations first
+    fCellArray->Apply();
+    for (Int_t iCell = 0; iCell < fCellArray->GetNumberOfCells(); iCell++){
+      if(name.Contains("Energy")){
+        h->Fill(fCellArray->GetAmplitude(iCell));
+      }
+      else if(name.Contains("Time")){
+        h->Fill(fCellArray->GetTime(iCell));
+      }
+    }
+    return;
+  }
+
   for (Int_t iCell = 0; iCell < fCaloCells->GetNumberOfCells(); iCell++){
     
     fCaloCells->GetCell(iCell, absId, ecell, tcell, mclabel, efrac);
@@ -323,32 +361,17 @@ Int_t AliEmcalCorrectionComponent::InitBadChannels()
   Int_t runBC = fEventManager.InputEvent()->GetRunNumber();
   
   std::unique_ptr<AliOADBContainer> contBC(nullptr);
-  std::unique_ptr<TFile> fbad;
   if (fBasePath!="")
   { //if fBasePath specified in the ->SetBasePath()
     AliInfo(Form("Loading Bad Channels OADB from given path %s",fBasePath.Data()));
     
-    fbad = std::unique_ptr<TFile>(TFile::Open(Form("%s/EMCALBadChannels.root",fBasePath.Data()),"read"));
-    if (!fbad || fbad->IsZombie())
-    {
-      AliFatal(Form("EMCALBadChannels.root was not found in the path provided: %s",fBasePath.Data()));
-      return 0;
-    }
-    
-    contBC = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(fbad->Get("AliEMCALBadChannels")));
+    contBC = LoadOADBContainer(Form("%s/EMCALBadChannels.root",fBasePath.Data()), "AliEMCALBadChannels", runBC);
   }
   else
   { // Else choose the one in the $ALICE_PHYSICS directory
     AliInfo("Loading Bad Channels OADB from $ALICE_PHYSICS/OADB/EMCAL");
     
-    fbad = std::unique_ptr<TFile>(TFile::Open(AliDataFile::GetFileNameOADB("EMCAL/EMCALBadChannels.root").data(),"read"));
-    if (!fbad || fbad->IsZombie())
-    {
-      AliFatal("OADB/EMCAL/EMCALBadChannels.root was not found");
-      return 0;
-    }
-    
-    contBC = std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(fbad->Get("AliEMCALBadChannels")));
+    contBC = LoadOADBContainer(AliDataFile::GetFileNameOADB("EMCAL/EMCALBadChannels.root"), "AliEMCALBadChannels", runBC);
   }
   if(!contBC){
     AliError("No OADB container found");
@@ -383,3 +406,121 @@ Int_t AliEmcalCorrectionComponent::InitBadChannels()
   return 1;
 }
 
+
+/**
+ * Load an OADB container from a file. If the correction task uses calibration snapshots,
+ * the entry valid for the run is taken from the snapshot of the run when it is there, without
+ * opening the file, which can be remote. Otherwise the container is read from the file and its
+ * entry for the run is added to the snapshot. A container from the snapshot only holds the
+ * entry valid for the run: if there is none (for instance when the caller falls back to the closest
+ * run), the full container is always read from the file.
+ *
+ * @param[in] fileName Name of the OADB file
+ * @param[in] containerName Name of the container in the file
+ * @param[in] run Run number
+ *
+ * @return The container, or nullptr if it is not in the file
+ */
+std::unique_ptr<AliOADBContainer> AliEmcalCorrectionComponent::LoadOADBContainer(const std::string & fileName, const std::string & containerName, Int_t run)
+{
+  std::string key;
+  if (fCalibSnapshot)
+  {
+    fCalibSnapshot->SetRun(run);
+    key = GetOADBSnapshotKey(fileName, containerName);
+    AliOADBContainer * cached = key.empty() ? nullptr : static_cast<AliOADBContainer *>(fCalibSnapshot->Get(key.c_str()));
+    if (cached)
+    {
+      AliDebug(1, Form("Loading %s for run %d from the calibration snapshot", containerName.c_str(), run));
+      return std::unique_ptr<AliOADBContainer>(static_cast<AliOADBContainer *>(cached->Clone()));
+    }
+  }
+
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "read"));
+  if (!file || file->IsZombie())
+  {
+    AliFatal(Form("%s was not found", fileName.c_str()));
+    return nullptr;
+  }
+  std::unique_ptr<AliOADBContainer> cont(static_cast<AliOADBContainer *>(file->Get(containerName.c_str())));
+  if (cont && fCalibSnapshot && !key.empty())
+  {
+    AliOADBContainer * contRun = GetOADBContainerForRun(*cont, run, fileName);
+    if (contRun)
+      fCalibSnapshot->Add(key.c_str(), contRun);
+  }
+  return cont;
+}
+
+/**
+ * Key of an OADB container in the calibration snapshots. It is a hash of the file name, of the
+ * container name and of the version of the file (see GetOADBFileStamp()), such that an updated
+ * OADB file is not hidden by older snapshots.
+ *
+ * @param[in] fileName Name of the OADB file
+ * @param[in] containerName Name of the container in the file
+ *
+ * @return Key of the container, empty if the version of the file cannot be determined
+ */
+std::string AliEmcalCorrectionComponent::GetOADBSnapshotKey(const std::string & fileName, const std::string & containerName)
+{
+  std::string stamp = GetOADBFileStamp(fileName);
+  if (stamp.empty())
+    return "";
+  std::string source = fileName + ":" + containerName + ":" + stamp;
+  return AliCalibSnapshot::GetHash(source.c_str()).Data();
+}
+
+/**
+ * Version of an OADB file: size and modification time if the file can be stat'ed (local files,
+ * or remote ones through the system plugins), otherwise size and UUID of the ROOT file, which
+ * changes whenever the file is rewritten. This requires to open the file, so the version is
+ * determined only once per file and job.
+ *
+ * @param[in] fileName Name of the OADB file
+ *
+ * @return Version of the file, empty if it can neither be stat'ed nor opened
+ */
+std::string AliEmcalCorrectionComponent::GetOADBFileStamp(const std::string & fileName)
+{
+  static std::map<std::string, std::string> stamps;
+  auto found = stamps.find(fileName);
+  if (found != stamps.end())
+    return found->second;
+
+  std::string stamp;
+  FileStat_t stat;
+  if (!gSystem->GetPathInfo(fileName.c_str(), stat) && stat.fMtime > 0) {
+    stamp = Form("%lld:%ld", stat.fSize, stat.fMtime);
+  }
+  else {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "read"));
+    if (file && !file->IsZombie())
+      stamp = Form("%lld:%s", file->GetSize(), file->GetUUID().AsString());
+  }
+  if (!stamp.empty())
+    stamps[fileName] = stamp;
+  return stamp;
+}
+
+/**
+ * Copy of an OADB container reduced to its entry valid for a run, as stored in the calibration
+ * snapshots. The name of the container is kept, the title is the source file, used by the
+ * warm-up of the snapshots (AliEmcalCorrectionTask::MakeCalibSnapshots()).
+ *
+ * @param[in] cont OADB container
+ * @param[in] run Run number
+ * @param[in] fileName Name of the OADB file of the container
+ *
+ * @return New container, or nullptr if no entry is valid for the run
+ */
+AliOADBContainer * AliEmcalCorrectionComponent::GetOADBContainerForRun(const AliOADBContainer & cont, Int_t run, const std::string & fileName)
+{
+  Int_t index = cont.GetIndexForRun(run);
+  if (index < 0 || !cont.GetObjectByIndex(index))
+    return nullptr;
+  AliOADBContainer * contRun = new AliOADBContainer(cont.GetName());
+  contRun->SetTitle(fileName.c_str());
+  contRun->AppendObject(cont.GetObjectByIndex(index)->Clone(), cont.LowerLimit(index), cont.UpperLimit(index));
+  return contRun;
+}
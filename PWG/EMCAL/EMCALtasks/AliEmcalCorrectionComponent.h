@@ -2,12 +2,17 @@
 #define ALIEMCALCORRECTIONCOMPONENT_H
 
 #include <map>
+#include <memory>
 #include <string>
 
 class TH1F;
 #include <TNamed.h>
 
+class AliCalibSnapshot;
+class AliEmcalCorrectionCellArray;
+class AliEmcalCorrectionCellCalibTable;
 class AliMCEvent;
+class AliOADBContainer;
 class AliEMCALRecoUtils;
 class AliVCaloCells;
 class AliVTrack;
@@ -85,6 +90,12 @@ class AliEmcalCorrectionComponent : public TNamed {
   
   void SetCaloCells(AliVCaloCells * cells) { fCaloCells = cells; }
   void SetRecoUtils(AliEMCALRecoUtils *ru) { fRecoUtils = ru; }
+  /// Set the per-run snapshot of the calibration objects, owned by the correction task
+  void SetCalibSnapshot(AliCalibSnapshot * snapshot) { fCalibSnapshot = snapshot; }
+  /// Set the packed cells shared with the neighbouring cell components, owned by the correction task
+  void SetCellArray(AliEmcalCorrectionCellArray * cellArray) { fCellArray = cellArray; }
+  /// True if the component only modifies the cells through UpdateCells(), such that it can work on the packed cells
+  virtual Bool_t SupportsCellArray() const { return kFALSE; }
 
   void SetInputEvent(AliVEvent * event) { fEventManager.SetInputEvent(event); }
   void SetMCEvent(AliMCEvent * mcevent) { fMCEvent = mcevent; }
@@ -108,7 +119,14 @@ class AliEmcalCorrectionComponent : public TNamed {
 
   /// Retrieve property
   template<typename T> bool GetProperty(std::string propertyName, T & property, bool requiredProperty = true, std::string correctionName = "");
+
+  // Calibration snapshots
+  static std::string GetOADBSnapshotKey(const std::string & fileName, const std::string & containerName);
+  static std::string GetOADBFileStamp(const std::string & fileName);
+  static AliOADBContainer * GetOADBContainerForRun(const AliOADBContainer & cont, Int_t run, const std::string & fileName);
  protected:
+  std::unique_ptr<AliOADBContainer> LoadOADBContainer(const std::string & fileName, const std::string & containerName, Int_t run);
+
   PWG::Tools::AliYAMLConfiguration fYAMLConfig;           ///< Contains the %YAML configuration used to configure the component
   Bool_t                  fCreateHisto;                   ///< Flag to make some basic histograms
   Int_t                   fRun;                           //!<! Run number
@@ -133,13 +151,16 @@ class AliEmcalCorrectionComponent : public TNamed {
   TList                  *fOutput;                        //!<! List of output histograms
   
   TString                fBasePath;                       ///< Base folder path to get root files
+  AliCalibSnapshot      *fCalibSnapshot;                  //!<! Per-run snapshot of the calibration objects (not owned)
+  AliEmcalCorrectionCellArray *fCellArray;                //!<! Packed cells of the event, used by UpdateCells() when set (not owned)
+  AliEmcalCorrectionCellCalibTable *fCellCalibTable;      //!<! Calibration of fRecoUtils by absolute cell ID, for the packed cells
 
  private:
   AliEmcalCorrectionComponent(const AliEmcalCorrectionComponent &);               // Not implemented
   AliEmcalCorrectionComponent &operator=(const AliEmcalCorrectionComponent &);    // Not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionComponent, 5); // EMCal correction component
+  ClassDef(AliEmcalCorrectionComponent, 7); // EMCal correction component
   /// \endcond
 };
 
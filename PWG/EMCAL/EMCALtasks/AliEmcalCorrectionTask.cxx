@@ -14,6 +14,9 @@
 #include <algorithm>
 
 #include <TChain.h>
+#include <TFile.h>
+#include <TKey.h>
+#include <TSystem.h>
 
 #include <AliAnalysisManager.h>
 #include <AliVEventHandler.h>
@@ -25,6 +28,9 @@
 #include <AliCentrality.h>
 #include "AliMultSelection.h"
 #include "AliAnalysisTaskEmcalEmbeddingHelper.h"
+#include "AliCalibSnapshot.h"
+#include "AliEmcalCorrectionCellArray.h"
+#include "AliOADBContainer.h"
 
 /// \cond CLASSIMP
 ClassImp(AliEmcalCorrectionTask);
@@ -65,7 +71,11 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
-  fOutput(0)
+  fOutput(0),
+  fCalibSnapshotDir(""),
+  fCalibSnapshot(0),
+  fFuseCellComponents(kFALSE),
+  fCellArray(0)
 {
   // Default constructor
   AliDebug(3, Form("%s", __PRETTY_FUNCTION__));
@@ -111,7 +121,11 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
-  fOutput(0)
+  fOutput(0),
+  fCalibSnapshotDir(""),
+  fCalibSnapshot(0),
+  fFuseCellComponents(kFALSE),
+  fCellArray(0)
 {
   // Standard constructor
   AliDebug(3, Form("%s", __PRETTY_FUNCTION__));
@@ -156,7 +170,11 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fGeom(task.fGeom),
   fParticleCollArray(*(static_cast<TObjArray *>(task.fParticleCollArray.Clone()))),
   fClusterCollArray(*(static_cast<TObjArray *>(task.fClusterCollArray.Clone()))),
-  fOutput(task.fOutput)                           // TODO: More care is needed here!
+  fOutput(task.fOutput),                          // TODO: More care is needed here!
+  fCalibSnapshotDir(task.fCalibSnapshotDir),
+  fCalibSnapshot(0),                              // Each task writes its own snapshots
+  fFuseCellComponents(task.fFuseCellComponents),
+  fCellArray(0)
 {
   // Vertex position
   std::copy(std::begin(task.fVertex), std::end(task.fVertex), std::begin(fVertex));
@@ -222,6 +240,10 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fClusterCollArray, second.fClusterCollArray);
   swap(first.fCellCollArray, second.fCellCollArray);
   swap(first.fOutput, second.fOutput);
+  swap(first.fCalibSnapshotDir, second.fCalibSnapshotDir);
+  swap(first.fCalibSnapshot, second.fCalibSnapshot);
+  swap(first.fFuseCellComponents, second.fFuseCellComponents);
+  swap(first.fCellArray, second.fCellArray);
 }
 
 /**
@@ -231,6 +253,9 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
 AliEmcalCorrectionTask::~AliEmcalCorrectionTask()
 {
   // Destructor
+  // Writes the snapshot of the last run if needed
+  delete fCalibSnapshot;
+  delete fCellArray;
 }
 
 void AliEmcalCorrectionTask::Initialize(bool removeDummyTask)
@@ -1178,6 +1203,11 @@ void AliEmcalCorrectionTask::ExecOnce()
   // when the Analysis Manager was created. Using cout to be certain that it is shown on the train!
   std::cout << "=== NOTE: Additional EMCal Corrections configuration information can be found when the Analysis Manager is configured. For a run macro, see above, while for a LEGO train, see the generation.log ===\n";
 
+  // Calibration snapshots, shared by the components
+  if (fCalibSnapshotDir != "" && !fCalibSnapshot) {
+    fCalibSnapshot = new AliCalibSnapshot(fCalibSnapshotDir, "EMCALCalib");
+  }
+
   // Setup the components
   ExecOnceComponents();
 }
@@ -1193,6 +1223,7 @@ void AliEmcalCorrectionTask::ExecOnceComponents()
   {
     // Setup geometry
     component->SetEMCALGeometry(fGeom);
+    component->SetCalibSnapshot(fCalibSnapshot);
 
     // Add the requested cells to the component
     AddContainersToComponent(component, AliEmcalContainerUtils::kCaloCells);
@@ -1214,6 +1245,92 @@ void AliEmcalCorrectionTask::ExecOnceComponents()
   }
 }
 
+/**
+ * Warm-up of the calibration snapshots (see SetCalibSnapshotDir()) for a list of runs. The OADB containers
+ * are those found in an existing snapshot of the directory, written by a previous job with the same
+ * configuration. Each OADB file is read once, and its entries valid for each run are written to the
+ * snapshot of the run. Existing snapshots are kept.
+ *
+ * @param[in] dir Directory of the snapshots
+ * @param[in] runList Name of a file with the run numbers, one per line
+ *
+ * @return Number of snapshots written
+ */
+int AliEmcalCorrectionTask::MakeCalibSnapshots(const char * dir, const char * runList)
+{
+  // Find a snapshot written by a job
+  std::string templateName;
+  void * dirp = gSystem->OpenDirectory(dir);
+  if (dirp) {
+    const char * entry = 0;
+    while ((entry = gSystem->GetDirEntry(dirp))) {
+      TString name(entry);
+      if (name.BeginsWith("EMCALCalib_") && name.EndsWith(".root")) {
+        templateName = TString::Format("%s/%s", dir, entry).Data();
+        break;
+      }
+    }
+    gSystem->FreeDirectory(dirp);
+  }
+  if (templateName == "") {
+    AliErrorClass(TString::Format("No calibration snapshot in %s, run one job first!", dir));
+    return 0;
+  }
+
+  // The snapshot containers have the name of the full container and the OADB file as title
+  std::vector<std::string> fileNames;
+  std::vector<std::unique_ptr<AliOADBContainer>> containers;
+  std::unique_ptr<TFile> templateFile(TFile::Open(templateName.c_str(), "read"));
+  if (!templateFile || templateFile->IsZombie()) {
+    AliErrorClass(TString::Format("Cannot read %s", templateName.c_str()));
+    return 0;
+  }
+  TIter next(templateFile->GetListOfKeys());
+  TKey * key = 0;
+  while ((key = static_cast<TKey *>(next()))) {
+    TObject * obj = key->ReadObj();
+    std::unique_ptr<AliOADBContainer> contRun(dynamic_cast<AliOADBContainer *>(obj));
+    if (!contRun) {
+      delete obj;
+      continue;
+    }
+    std::unique_ptr<TFile> file(TFile::Open(contRun->GetTitle(), "read"));
+    AliOADBContainer * cont = 0;
+    if (file && !file->IsZombie()) cont = dynamic_cast<AliOADBContainer *>(file->Get(contRun->GetName()));
+    if (!cont) {
+      AliErrorClass(TString::Format("Cannot read %s from %s", contRun->GetName(), contRun->GetTitle()));
+      continue;
+    }
+    cont->SetOwner(true);
+    fileNames.push_back(contRun->GetTitle());
+    containers.push_back(std::unique_ptr<AliOADBContainer>(cont));
+  }
+
+  std::ifstream runs(runList);
+  if (!runs) {
+    AliErrorClass(TString::Format("Cannot read the run list %s", runList));
+    return 0;
+  }
+  int nWritten = 0;
+  int run = 0;
+  while (runs >> run) {
+    AliCalibSnapshot snapshot(dir, "EMCALCalib");
+    if (snapshot.SetRun(run)) continue;
+    for (std::size_t i = 0; i < containers.size(); i++) {
+      AliOADBContainer * contRun = AliEmcalCorrectionComponent::GetOADBContainerForRun(*containers[i], run, fileNames[i]);
+      if (!contRun) continue;
+      std::string key = AliEmcalCorrectionComponent::GetOADBSnapshotKey(fileNames[i], containers[i]->GetName());
+      if (key.empty()) {
+        delete contRun;
+        continue;
+      }
+      snapshot.Add(key.c_str(), contRun);
+    }
+    if (snapshot.IsModified() && snapshot.Flush()) nWritten++;
+  }
+  return nWritten;
+}
+
 /**
  * Retrieve objects from event.
  * @return
@@ -1322,8 +1439,29 @@ Bool_t AliEmcalCorrectionTask::Run()
     component->SetCentrality(fCent);
     component->SetVertex(fVertex);
 
+    if (fFuseCellComponents) {
+      // Consecutive cell components on the same cells share the packed cells, which are written back
+      // before any other component, as it may use or modify the cells.
+      AliVCaloCells * cells = component->SupportsCellArray() ? component->GetCaloCells() : 0;
+      if (!fCellArray) fCellArray = new AliEmcalCorrectionCellArray;
+      if (fCellArray->GetCells() && fCellArray->GetCells() != cells) fCellArray->Store();
+      if (cells && !fCellArray->GetCells()) fCellArray->Load(cells);
+      component->SetCellArray(cells ? fCellArray : 0);
+    }
+
+    // components modify the objects in place, the per-event selection of the containers must be redone
+    AliEmcalContainer* cont = 0;
+    TIter nextPartColl(&fParticleCollArray);
+    while ((cont = static_cast<AliEmcalContainer*>(nextPartColl()))) cont->InvalidateAcceptanceCache();
+    TIter nextClusColl(&fClusterCollArray);
+    while ((cont = static_cast<AliEmcalContainer*>(nextClusColl()))) cont->InvalidateAcceptanceCache();
+
     component->Run();
   }
+  if (fCellArray) fCellArray->Store();
+
+  // Components load their calibration at the first event of a run
+  if (fCalibSnapshot) fCalibSnapshot->Flush();
 
   PostData(1, fOutput);
 
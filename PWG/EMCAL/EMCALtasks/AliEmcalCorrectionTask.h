@@ -1,6 +1,8 @@
 #ifndef ALIEMCALCORRECTIONTASK_H
 #define ALIEMCALCORRECTIONTASK_H
 
+class AliCalibSnapshot;
+class AliEmcalCorrectionCellArray;
 class AliEmcalCorrectionCellContainer;
 class AliEmcalCorrectionComponent;
 class AliEMCALGeometry;
@@ -105,6 +107,19 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
   virtual void                SetNCentBins(Int_t n)                                 { fNcentBins         = n                              ; }
   void                        SetCentRange(Double_t min, Double_t max)              { fMinCent           = min  ; fMaxCent = max          ; }
+  /**
+   * Keep a local snapshot of the calibration objects loaded by the components (bad channels, time and
+   * energy calibration) for each run in the given directory, shared by the jobs on the same node. When
+   * the snapshot of a run exists, the objects are read from it instead of the OADB files.
+   */
+  void                        SetCalibSnapshotDir(const char * dir)                 { fCalibSnapshotDir  = dir                            ; }
+  static int                  MakeCalibSnapshots(const char * dir, const char * runList);
+  /**
+   * Run consecutive cell components working on the same cells (bad channel, energy and time calibration) on
+   * a packed copy of the cells. Their recalibrations are applied in a single loop over the cells, with the
+   * calibration flattened by absolute cell ID, and the cells are written back once, before the next component.
+   */
+  void                        SetFuseCellComponents(Bool_t b = kTRUE)               { fFuseCellComponents = b                             ; }
 
   /**
    * Direct access to the correction components.
@@ -248,9 +263,13 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   std::vector <AliEmcalCorrectionCellContainer *> fCellCollArray; ///< Cells collection array
   
   TList *                     fOutput;                     //!<! Output for histograms
+  TString                     fCalibSnapshotDir;           ///< Directory of the per-run calibration snapshots
+  AliCalibSnapshot *          fCalibSnapshot;              //!<! Per-run snapshot of the calibration objects
+  Bool_t                      fFuseCellComponents;         ///< Run the consecutive cell components on packed cells
+  AliEmcalCorrectionCellArray * fCellArray;                //!<! Packed cells shared by the consecutive cell components
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 6); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 8); // EMCal correction task
   /// \endcond
 };
 
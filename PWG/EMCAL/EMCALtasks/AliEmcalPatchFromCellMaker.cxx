@@ -31,6 +31,8 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker() :
   fCellTimeMax(685e-9),
   fL1Slide(0),
   fTriggerBitConfig(0x0),
+  fTableADCSimple(),
+  fTableESimple(),
   fh3EEtaPhiCell(0),
   fh2CellEnergyVsTime(0),
   fh1CellEnergySum(0)
@@ -57,6 +59,8 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker(const char *name) :
   fCellTimeMax(685e-9),
   fL1Slide(0),
   fTriggerBitConfig(0x0),
+  fTableADCSimple(),
+  fTableESimple(),
   fh3EEtaPhiCell(0),
   fh2CellEnergyVsTime(0),
   fh1CellEnergySum(0)
@@ -272,25 +276,23 @@ void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger()
   Int_t maxRow = fGeom->GetNTotalTRU()*2 - patchSize; //apparently this is the total TRU in phi ??
   //  Printf("fGeom->GetNTotalTRU(): %d %d = %d x %d ;  %d x %d",fGeom->GetNTRU(),fGeom->GetNTotalTRU(),fGeom->GetNTRUEta(),fGeom->GetNTRUPhi(),fGeom->GetNModulesInTRUEta(),fGeom->GetNModulesInTRUPhi());
 
+  // summed-area tables of the maps, the ADC counts of the trigger towers are truncated as in the sum
+  fTableADCSimple.Build(&fPatchADCSimple[0][0], kPatchCols, kPatchRows, kPatchRows, kTRUE);
+  fTableESimple.Build(&fPatchESimple[0][0], kPatchCols, kPatchRows, kPatchRows);
+
   for (Int_t i = 0; i <= maxCol; i += stepSize) {
     for (Int_t j = 0; j <= maxRow; j += stepSize) {
-      // get the trigger towers composing the patch
-      Int_t   adcAmp = 0;
-      Double_t enAmp = 0.;
-      // window
-      for (Int_t k = 0; k < patchSize; ++k) {
-        for (Int_t l = 0; l < patchSize; ++l) {
-	  // add amplitudes
-          adcAmp += (ULong64_t)fPatchADCSimple[i+k][j+l];
-	  enAmp += fPatchESimple[i+k][j+l];
-	}
-      }
+      // sum of the trigger towers composing the patch
+      Int_t adcAmp = fTableADCSimple.GetIntegerSum(i, j, patchSize, patchSize);
 
       if (adcAmp == 0) {
 	AliDebug(2,"EMCal trigger patch with 0 ADC counts.");
 	continue;
       }
 
+      // energy summed tower by tower, eta in the outer loop
+      Double_t enAmp = fTableESimple.GetSum(i, j, patchSize, patchSize, PWG::EMCAL::AliEmcalTriggerSummedAreaTable::kColsOuter);
+
       Int_t absId=-1;
       Int_t cellAbsId[4]={-1,-1,-1,-1};
 
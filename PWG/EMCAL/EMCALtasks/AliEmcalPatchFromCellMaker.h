@@ -6,6 +6,7 @@ class TH3F;
 class AliEMCALTriggerBitConfig;
 
 #include "AliAnalysisTaskEmcal.h"
+#include "AliEmcalTriggerSummedAreaTable.h"
 
 class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
  public:
@@ -22,7 +23,7 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
  protected:
   enum{
     kPatchCols = 48,
-    kPatchRows = 64
+    kPatchRows = 104   // EMCal and DCal, GetNTotalTRU()*2 for the largest geometry
   };
 
   void               ExecOnce();
@@ -44,6 +45,8 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
       
   Double_t           fPatchADCSimple[kPatchCols][kPatchRows];   // patch map for simple offline trigger
   Double_t           fPatchESimple[kPatchCols][kPatchRows];     // patch map for simple offline trigger
+  PWG::EMCAL::AliEmcalTriggerSummedAreaTable fTableADCSimple;     //!summed-area table of the truncated ADC map
+  PWG::EMCAL::AliEmcalTriggerSummedAreaTable fTableESimple;       //!summed-area table of the energy map
 
   Int_t              fPatchDim;             // dimension of patch in #cells
   Double_t           fMinCellE;             // minimum cell energy
@@ -60,6 +63,6 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   AliEmcalPatchFromCellMaker(const AliEmcalPatchFromCellMaker&);            // not implemented
   AliEmcalPatchFromCellMaker &operator=(const AliEmcalPatchFromCellMaker&); // not implemented
 
-  ClassDef(AliEmcalPatchFromCellMaker, 1); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
+  ClassDef(AliEmcalPatchFromCellMaker, 2); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
 };
 #endif
@@ -12,6 +12,8 @@
 #include <AliVTrack.h>
 #include <AliEMCALRecoUtils.h>
 
+#include "AliEmcalTrackSurfaceCache.h"
+
 ClassImp(AliEmcalTrackPropagatorTask)
 
 //________________________________________________________________________
@@ -62,13 +64,17 @@ Bool_t AliEmcalTrackPropagatorTask::Run()
 
   if (!tracks) return 0;
   
+  // Propagations shared with the track matchers running in the same event
+  PWG::EMCAL::AliEmcalTrackSurfaceCache *surfaceCache = PWG::EMCAL::AliEmcalTrackSurfaceCache::Instance();
+  surfaceCache->SetEvent(InputEvent());
+
   tracks->ResetCurrentID();
   AliVTrack* track = 0;
   while ((track = static_cast<AliVTrack*>(tracks->GetNextAcceptParticle()))) {
     if (fOnlyIfNotSet && track->IsExtrapolatedToEMCAL()) continue;
     if (fOnlyIfEmcal && !track->IsEMCAL()) continue;
     
-    AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fDist);
+    surfaceCache->PropagateTrack(track, fDist);
   }
 
   return kTRUE;
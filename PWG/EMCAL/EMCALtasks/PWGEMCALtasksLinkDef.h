@@ -68,4 +68,6 @@
 #pragma link C++ class PWG::EMCAL::TestImplAliEmcalTrackSelectionITSpure+;
 #pragma link C++ class PWG::EMCAL::TestImplAliEmcalTrackSelectionHybrid+;
 #pragma link C++ class PWG::EMCAL::TestImplAliEmcalTrackSelectionTPConly+;
+#pragma link C++ class PWG::EMCAL::TestAliEmcalCorrectionClusterizer+;
+#pragma link C++ class PWG::EMCAL::TestAliEmcalCorrectionCellArray+;
 #endif
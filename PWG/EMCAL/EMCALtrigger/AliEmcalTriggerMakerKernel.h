@@ -9,6 +9,8 @@
 
 #include <TObject.h>
 #include <TArrayF.h>
+#include "AliEmcalTriggerPatchEngine.h"
+#include "AliEmcalTriggerSummedAreaTable.h"
 //#include <AliEMCALTriggerPatchInfoV1.h>
 
 class TF1;
@@ -42,6 +44,8 @@ const Double_t kEMCL0ADCtoGeV_AP = 0.018970588*4;  // 0.075882352;             /
  * the trigger maker:
  * - Filling of the data grids
  * - Steering and running the patch finders
+ * - Building the summed-area tables of the data grids, on which
+ *   the patch finders run (see PWG::EMCAL::AliEmcalTriggerPatchEngine)
  * - Conversion of the raw patches obtained by the patch finders
  *   to full EMCAL trigger patch info objects.
  * I/O, which means interaction with the ALICE analysis system,
@@ -370,6 +374,17 @@ public:
    */
   void SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize);
 
+  /**
+   * @brief Find the patches on summed-area tables of the data grids
+   *
+   * If switched on, the L1 and L0 algorithms run on the summed-area tables of
+   * the data grids, built once per event and shared between all algorithms.
+   * Otherwise (default) the patch finders from AliRoot are used. Both produce
+   * identical patches (see TestAliEmcalTriggerPatchEngine).
+   * @param[in] doUse If true the patches are found on the summed-area tables
+   */
+  void SetUsePatchEngine(Bool_t doUse) { fUsePatchEngine = doUse; }
+
   /**
    * @brief Set energy-dependent models for gaussian energy smearing
    * @param[in] mean Parameterization of the mean
@@ -486,6 +501,9 @@ protected:
 
   AliEMCALTriggerPatchFinder<double>       *fPatchFinder;                 ///< The actual patch finder
   AliEMCALTriggerAlgorithm<double>         *fLevel0PatchFinder;           ///< Patch finder for Level0 patches
+  PWG::EMCAL::AliEmcalTriggerPatchEngine    fL1PatchEngine;               ///< L1 algorithms running on the summed-area tables
+  PWG::EMCAL::AliEmcalTriggerPatchEngine    fL0PatchEngine;               ///< L0 algorithm running on the summed-area tables
+  Bool_t                                    fUsePatchEngine;              ///< Find patches on the summed-area tables instead of the patch finders
   Int_t                                     fL0MinTime;                   ///< Minimum L0 time
   Int_t                                     fL0MaxTime;                   ///< Maximum L0 time
   Int_t                                     fMinCellAmp;                  ///< Minimum offline amplitude of the cells used to generate the patches
@@ -513,11 +531,14 @@ protected:
   AliEMCALTriggerDataGrid<double>           *fPatchEnergySimpleSmeared;   //!<! Data grid for smeared energy values from cell energies
   AliEMCALTriggerDataGrid<char>             *fLevel0TimeMap;              //!<! Map needed to store the level0 times
   AliEMCALTriggerDataGrid<int>              *fTriggerBitMap;              //!<! Map of trigger bits
+  PWG::EMCAL::AliEmcalTriggerSummedAreaTable fTableAmplitudes;            //!<! Summed-area table of the TRU amplitudes
+  PWG::EMCAL::AliEmcalTriggerSummedAreaTable fTableADCSimple;             //!<! Summed-area table of the simple offline patch map
+  PWG::EMCAL::AliEmcalTriggerSummedAreaTable fTableADC;                   //!<! Summed-area table of the ADC values
 
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
@@ -0,0 +1,173 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <iostream>
+#include <TRandom3.h>
+#include "AliEMCALTriggerAlgorithm.h"
+#include "AliEMCALTriggerDataGrid.h"
+#include "AliEMCALTriggerPatchFinder.h"
+#include "AliEMCALTriggerRawPatch.h"
+#include "AliEmcalTriggerPatchEngine.h"
+#include "AliEmcalTriggerSummedAreaTable.h"
+#include "AliLog.h"
+
+/// \cond CLASSIMP
+ClassImp(PWG::EMCAL::AliEmcalTriggerPatchEngine)
+ClassImp(PWG::EMCAL::TestAliEmcalTriggerPatchEngine)
+/// \endcond
+
+using namespace PWG::EMCAL;
+
+AliEmcalTriggerPatchEngine::AliEmcalTriggerPatchEngine():
+  fRowMin(),
+  fRowMax(),
+  fBitMask(),
+  fPatchSize(),
+  fSubregionSize()
+{
+}
+
+void AliEmcalTriggerPatchEngine::AddAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize){
+  fRowMin.push_back(rowmin);
+  fRowMax.push_back(rowmax);
+  fBitMask.push_back(bitmask);
+  fPatchSize.push_back(patchSize);
+  fSubregionSize.push_back(subregionSize);
+}
+
+void AliEmcalTriggerPatchEngine::Clear(){
+  fRowMin.clear();
+  fRowMax.clear();
+  fBitMask.clear();
+  fPatchSize.clear();
+  fSubregionSize.clear();
+}
+
+void AliEmcalTriggerPatchEngine::FindPatches(const AliEmcalTriggerSummedAreaTable &adc, const AliEmcalTriggerSummedAreaTable &offlineAdc, std::vector<AliEMCALTriggerRawPatch> &patches) const {
+  for(int ialgo = 0; ialgo < GetNumberOfAlgorithms(); ialgo++){
+    const int patchsize = fPatchSize[ialgo], stepsize = fSubregionSize[ialgo];
+    if(patchsize <= 0 || stepsize <= 0) continue;
+    // Same window positions as AliEMCALTriggerAlgorithm
+    const int rowStartMax = fRowMax[ialgo] - (patchsize - 1),
+              colStartMax = adc.GetNumberOfCols() - patchsize;
+    for(int irow = fRowMin[ialgo]; irow <= rowStartMax; irow += stepsize){
+      for(int icol = 0; icol <= colStartMax; icol += stepsize){
+        // Empty windows sum to 0 in both maps and never make a patch
+        if(adc.IsEmpty(icol, irow, patchsize, patchsize) && offlineAdc.IsEmpty(icol, irow, patchsize, patchsize)) continue;
+        double sumadc = adc.GetSum(icol, irow, patchsize, patchsize),
+               sumofflineAdc = offlineAdc.GetSum(icol, irow, patchsize, patchsize);
+        if(sumadc > 0 || sumofflineAdc > 0){
+          AliEMCALTriggerRawPatch recpatch(icol, irow, patchsize, sumadc, sumofflineAdc);
+          recpatch.SetBitmask(fBitMask[ialgo]);
+          patches.push_back(recpatch);
+        }
+      }
+    }
+  }
+}
+
+TestAliEmcalTriggerPatchEngine::TestAliEmcalTriggerPatchEngine():
+  TObject()
+{
+}
+
+bool TestAliEmcalTriggerPatchEngine::RunAllTests() const {
+  return TestIntegerMaps() && TestFloatingPointMaps();
+}
+
+bool TestAliEmcalTriggerPatchEngine::TestIntegerMaps() const {
+  AliInfoStream() << "Running test with integer online and offline maps" << std::endl;
+  return CompareOnRandomMaps(true, 1);
+}
+
+bool TestAliEmcalTriggerPatchEngine::TestFloatingPointMaps() const {
+  AliInfoStream() << "Running test with floating point offline maps" << std::endl;
+  return CompareOnRandomMaps(false, 2);
+}
+
+bool TestAliEmcalTriggerPatchEngine::CompareOnRandomMaps(bool integerOffline, int seed) const {
+  // Run 2 layout: 48 columns, EMCAL rows 0-63 and DCAL rows 64-103, with the
+  // gamma (2x2), jet (16x16 and 8x8) and background (8x8) algorithms of the trigger maker
+  const int kNCols = 48, kNRows = 104, kNEvents = 20;
+  const double kOccupancy[kNEvents] = {0., 0.001, 0.01, 0.01, 0.05, 0.05, 0.1, 0.1, 0.2, 0.2,
+                                       0.3, 0.3, 0.5, 0.5, 0.7, 0.7, 0.9, 0.9, 1., 1.};
+
+  AliEMCALTriggerPatchFinder<double> finder;
+  AliEmcalTriggerPatchEngine engine;
+  const int algorithms[7][5] = {{0, 63, 1<<0, 2, 1}, {64, 103, 1<<0, 2, 1},
+                                {0, 63, 1<<1, 16, 4}, {64, 103, 1<<1, 16, 4},
+                                {0, 63, 1<<2, 8, 4}, {64, 103, 1<<2, 8, 4},
+                                {0, 103, 1<<3, 8, 4}};
+  for(int ialgo = 0; ialgo < 7; ialgo++){
+    const int *algo = algorithms[ialgo];
+    AliEMCALTriggerAlgorithm<double> *trigger = new AliEMCALTriggerAlgorithm<double>(algo[0], algo[1], algo[2]);
+    trigger->SetPatchSize(algo[3]);
+    trigger->SetSubregionSize(algo[4]);
+    finder.AddTriggerAlgorithm(trigger);
+    engine.AddAlgorithm(algo[0], algo[1], algo[2], algo[3], algo[4]);
+  }
+
+  TRandom3 rng(seed);
+  AliEMCALTriggerDataGrid<double> adc, offlineAdc;
+  adc.Allocate(kNCols, kNRows);
+  offlineAdc.Allocate(kNCols, kNRows);
+  AliEmcalTriggerSummedAreaTable tableADC, tableOfflineADC;
+  int nfailure = 0;
+  for(int ievent = 0; ievent < kNEvents; ievent++){
+    adc.Reset();
+    offlineAdc.Reset();
+    for(int icol = 0; icol < kNCols; icol++){
+      for(int irow = 0; irow < kNRows; irow++){
+        if(rng.Uniform() < kOccupancy[ievent]) adc(icol, irow) = rng.Integer(1024);
+        if(rng.Uniform() < kOccupancy[ievent]) offlineAdc(icol, irow) = integerOffline ? rng.Integer(1024) : rng.Exp(20.);
+      }
+    }
+
+    std::vector<AliEMCALTriggerRawPatch> reference = finder.FindPatches(adc, offlineAdc), test;
+    tableADC.Build(adc);
+    tableOfflineADC.Build(offlineAdc);
+    engine.FindPatches(tableADC, tableOfflineADC, test);
+
+    if(test.size() != reference.size()){
+      AliErrorStream() << "Event " << ievent << ": " << test.size() << " patches found, expected " << reference.size() << std::endl;
+      nfailure++;
+      continue;
+    }
+    for(std::vector<AliEMCALTriggerRawPatch>::size_type ipatch = 0; ipatch < reference.size(); ipatch++){
+      const AliEMCALTriggerRawPatch &ref = reference[ipatch], &patch = test[ipatch];
+      if(patch.GetColStart() != ref.GetColStart() || patch.GetRowStart() != ref.GetRowStart() || patch.GetPatchSize() != ref.GetPatchSize()
+         || patch.GetBitmask() != ref.GetBitmask() || patch.GetADC() != ref.GetADC() || patch.GetOfflineADC() != ref.GetOfflineADC()){
+        AliErrorStream() << "Event " << ievent << ", patch " << ipatch << ": found (" << patch.GetColStart() << ", " << patch.GetRowStart()
+                         << ", size " << patch.GetPatchSize() << ", ADC " << patch.GetADC() << ", offline " << patch.GetOfflineADC()
+                         << "), expected (" << ref.GetColStart() << ", " << ref.GetRowStart() << ", size " << ref.GetPatchSize()
+                         << ", ADC " << ref.GetADC() << ", offline " << ref.GetOfflineADC() << ")" << std::endl;
+        nfailure++;
+        break;
+      }
+    }
+  }
+  return nfailure == 0;
+}
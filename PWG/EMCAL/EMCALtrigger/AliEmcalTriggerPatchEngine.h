@@ -0,0 +1,164 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALTRIGGERPATCHENGINE_H
+#define ALIEMCALTRIGGERPATCHENGINE_H
+
+#include <vector>
+#include <Rtypes.h>
+#include <TObject.h>
+
+class AliEMCALTriggerRawPatch;
+
+namespace PWG {
+
+namespace EMCAL {
+
+class AliEmcalTriggerSummedAreaTable;
+
+/**
+ * @class AliEmcalTriggerPatchEngine
+ * @brief Sliding window patch finder running on summed-area tables
+ * @ingroup EMCALTRGFW
+ *
+ * Set of sliding window trigger algorithms, each defined by a row range, a bitmask,
+ * the patch size and the step of the window (subregion size), as the
+ * AliEMCALTriggerAlgorithm objects of AliEMCALTriggerPatchFinder. Instead of
+ * summing the channels of each window, the patches are obtained from the
+ * summed-area tables of the online and offline maps
+ * (see AliEmcalTriggerSummedAreaTable), which are built once per event and shared
+ * between all algorithms and patch sizes. Windows without any channel fired are
+ * rejected with a single lookup, and patch amplitudes of integer maps come from
+ * the tables as well.
+ *
+ * The patches found, their order and their amplitudes are identical to the ones of
+ * AliEMCALTriggerPatchFinder with the same algorithms and zero thresholds.
+ */
+class AliEmcalTriggerPatchEngine {
+public:
+  AliEmcalTriggerPatchEngine();
+  virtual ~AliEmcalTriggerPatchEngine() {}
+
+  /**
+   * @brief Add a sliding window algorithm
+   * @param[in] rowmin Minimum row value
+   * @param[in] rowmax Maximum row value
+   * @param[in] bitmask Offline bit mask to be applied to the patches
+   * @param[in] patchSize Size of the patches
+   * @param[in] subregionSize Size of the sliding sub region
+   */
+  void AddAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize);
+
+  /**
+   * @brief Remove all algorithms
+   */
+  void Clear();
+
+  Int_t GetNumberOfAlgorithms() const { return fPatchSize.size(); }
+
+  /**
+   * @brief Run all algorithms on the tables of the online and offline maps
+   *
+   * Patches are appended algorithm by algorithm, each in the order of the
+   * sliding window (rows in the outer loop), if either the online or the
+   * offline amplitude is above 0.
+   *
+   * @param[in] adc Table of the online (or online-like) amplitudes
+   * @param[in] offlineAdc Table of the offline amplitudes
+   * @param[out] patches Patches found
+   */
+  void FindPatches(const AliEmcalTriggerSummedAreaTable &adc, const AliEmcalTriggerSummedAreaTable &offlineAdc, std::vector<AliEMCALTriggerRawPatch> &patches) const;
+
+private:
+  std::vector<Int_t>      fRowMin;          ///< Minimum row of each algorithm
+  std::vector<Int_t>      fRowMax;          ///< Maximum row of each algorithm
+  std::vector<UInt_t>     fBitMask;         ///< Bitmask of each algorithm
+  std::vector<Int_t>      fPatchSize;       ///< Patch size of each algorithm
+  std::vector<Int_t>      fSubregionSize;   ///< Step of the sliding window of each algorithm
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTriggerPatchEngine, 1);
+  /// \endcond
+};
+
+/**
+ * @class TestAliEmcalTriggerPatchEngine
+ * @brief Unit test for class AliEmcalTriggerPatchEngine
+ * @ingroup EMCALTRGFW
+ *
+ * Runs the patch engine and AliEMCALTriggerPatchFinder with the same
+ * algorithms on random channel maps and compares the patches found.
+ */
+class TestAliEmcalTriggerPatchEngine : public TObject {
+public:
+  TestAliEmcalTriggerPatchEngine();
+  virtual ~TestAliEmcalTriggerPatchEngine() {}
+
+  /**
+   * @brief Run all unit tests for the class AliEmcalTriggerPatchEngine
+   *
+   * @return true All tests passed
+   * @return false At least one failure observed
+   */
+  bool RunAllTests() const;
+
+  /**
+   * @brief Test with integer online and offline maps
+   *
+   * Random ADC maps with a fraction of channels fired, as the L1 ADC and
+   * the simple offline ADC maps of the trigger maker. The patches found
+   * by the engine and by the patch finder must be identical, including
+   * their order and amplitudes.
+   *
+   * @return true  All events passed
+   * @return false At least one event with different patches
+   */
+  bool TestIntegerMaps() const;
+
+  /**
+   * @brief Test with a non-integer offline map
+   *
+   * Same as TestIntegerMaps, with a floating point offline map, for which
+   * the engine sums the channels one by one.
+   *
+   * @return true  All events passed
+   * @return false At least one event with different patches
+   */
+  bool TestFloatingPointMaps() const;
+
+private:
+  bool CompareOnRandomMaps(bool integerOffline, int seed) const;
+
+  /// \cond CLASSIMP
+  ClassDef(TestAliEmcalTriggerPatchEngine, 1);
+  /// \endcond
+};
+
+}
+
+}
+
+#endif /* ALIEMCALTRIGGERPATCHENGINE_H */
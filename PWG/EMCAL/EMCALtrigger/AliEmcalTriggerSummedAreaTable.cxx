@@ -0,0 +1,161 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "AliEMCALTriggerDataGrid.h"
+#include "AliEmcalTriggerSummedAreaTable.h"
+
+/// \cond CLASSIMP
+ClassImp(PWG::EMCAL::AliEmcalTriggerSummedAreaTable)
+/// \endcond
+
+using namespace PWG::EMCAL;
+
+AliEmcalTriggerSummedAreaTable::AliEmcalTriggerSummedAreaTable():
+  fNCols(0),
+  fNRows(0),
+  fIntegral(kTRUE),
+  fValues(),
+  fOccupancy(),
+  fSum()
+{
+}
+
+void AliEmcalTriggerSummedAreaTable::Build(const AliEMCALTriggerDataGrid<double> &grid){
+  Resize(grid.GetNumberOfCols(), grid.GetNumberOfRows());
+  for(int irow = 0; irow < fNRows; irow++){
+    for(int icol = 0; icol < fNCols; icol++){
+      fValues[irow * fNCols + icol] = grid(icol, irow);
+    }
+  }
+  Fill();
+}
+
+void AliEmcalTriggerSummedAreaTable::Build(const Double_t *values, Int_t ncols, Int_t nrows, Int_t colStride, Bool_t truncate){
+  Resize(ncols, nrows);
+  for(int icol = 0; icol < fNCols; icol++){
+    const Double_t *column = values + icol * colStride;
+    for(int irow = 0; irow < fNRows; irow++){
+      fValues[irow * fNCols + icol] = truncate ? static_cast<Double_t>(static_cast<ULong64_t>(column[irow])) : column[irow];
+    }
+  }
+  Fill();
+}
+
+void AliEmcalTriggerSummedAreaTable::Resize(Int_t ncols, Int_t nrows){
+  fNCols = std::max(ncols, 0);
+  fNRows = std::max(nrows, 0);
+  fValues.resize(fNCols * fNRows);
+  fOccupancy.resize((fNCols + 1) * (fNRows + 1));
+}
+
+void AliEmcalTriggerSummedAreaTable::Fill(){
+  // Integer channels have to stay exact in the double precision sum of the
+  // patch finders as well, which holds as long as they stay below 2^31
+  const Double_t maxIntegral = 2147483648.;
+  fIntegral = kTRUE;
+  for(auto val : fValues){
+    if(std::floor(val) != val || std::fabs(val) >= maxIntegral){
+      fIntegral = kFALSE;
+      break;
+    }
+  }
+  fSum.resize(fIntegral ? fOccupancy.size() : 0);
+
+  // First row and column of the tables are 0
+  for(int icol = 0; icol <= fNCols; icol++){
+    fOccupancy[TableIndex(icol, 0)] = 0;
+    if(fIntegral) fSum[TableIndex(icol, 0)] = 0;
+  }
+  for(int irow = 0; irow < fNRows; irow++){
+    const Double_t *rowvalues = fValues.data() + irow * fNCols;
+    Int_t rowOccupancy = 0;
+    Long64_t rowSum = 0;
+    fOccupancy[TableIndex(0, irow + 1)] = 0;
+    if(fIntegral) fSum[TableIndex(0, irow + 1)] = 0;
+    for(int icol = 0; icol < fNCols; icol++){
+      if(rowvalues[icol] != 0) rowOccupancy++;
+      fOccupancy[TableIndex(icol + 1, irow + 1)] = fOccupancy[TableIndex(icol + 1, irow)] + rowOccupancy;
+      if(fIntegral){
+        rowSum += static_cast<Long64_t>(rowvalues[icol]);
+        fSum[TableIndex(icol + 1, irow + 1)] = fSum[TableIndex(icol + 1, irow)] + rowSum;
+      }
+    }
+  }
+}
+
+Bool_t AliEmcalTriggerSummedAreaTable::Clamp(Int_t &colmin, Int_t &rowmin, Int_t &colmax, Int_t &rowmax) const {
+  // Convert the window to the range [min, max) inside the map
+  colmin = std::max(colmin, 0);
+  rowmin = std::max(rowmin, 0);
+  colmax = std::min(colmax, fNCols);
+  rowmax = std::min(rowmax, fNRows);
+  return colmin < colmax && rowmin < rowmax;
+}
+
+Bool_t AliEmcalTriggerSummedAreaTable::IsEmpty(Int_t col, Int_t row, Int_t ncols, Int_t nrows) const {
+  Int_t colmin = col, rowmin = row, colmax = col + ncols, rowmax = row + nrows;
+  if(!Clamp(colmin, rowmin, colmax, rowmax)) return kTRUE;
+  return fOccupancy[TableIndex(colmax, rowmax)] - fOccupancy[TableIndex(colmin, rowmax)]
+       - fOccupancy[TableIndex(colmax, rowmin)] + fOccupancy[TableIndex(colmin, rowmin)] == 0;
+}
+
+Long64_t AliEmcalTriggerSummedAreaTable::GetIntegerSum(Int_t col, Int_t row, Int_t ncols, Int_t nrows) const {
+  Int_t colmin = col, rowmin = row, colmax = col + ncols, rowmax = row + nrows;
+  if(!Clamp(colmin, rowmin, colmax, rowmax)) return 0;
+  if(fIntegral){
+    return fSum[TableIndex(colmax, rowmax)] - fSum[TableIndex(colmin, rowmax)]
+         - fSum[TableIndex(colmax, rowmin)] + fSum[TableIndex(colmin, rowmin)];
+  }
+  Long64_t sum = 0;
+  for(int irow = rowmin; irow < rowmax; irow++){
+    for(int icol = colmin; icol < colmax; icol++){
+      sum += static_cast<Long64_t>(fValues[irow * fNCols + icol]);
+    }
+  }
+  return sum;
+}
+
+Double_t AliEmcalTriggerSummedAreaTable::GetSum(Int_t col, Int_t row, Int_t ncols, Int_t nrows, ESumOrder_t order) const {
+  if(IsEmpty(col, row, ncols, nrows)) return 0.;
+  if(fIntegral) return static_cast<Double_t>(GetIntegerSum(col, row, ncols, nrows));
+
+  Int_t colmin = col, rowmin = row, colmax = col + ncols, rowmax = row + nrows;
+  Clamp(colmin, rowmin, colmax, rowmax);
+  Double_t sum = 0.;
+  if(order == kRowsOuter){
+    for(int irow = rowmin; irow < rowmax; irow++){
+      for(int icol = colmin; icol < colmax; icol++) sum += fValues[irow * fNCols + icol];
+    }
+  } else {
+    for(int icol = colmin; icol < colmax; icol++){
+      for(int irow = rowmin; irow < rowmax; irow++) sum += fValues[irow * fNCols + icol];
+    }
+  }
+  return sum;
+}
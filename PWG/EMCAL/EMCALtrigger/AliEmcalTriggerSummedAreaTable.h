@@ -0,0 +1,147 @@
+/************************************************************************************
+ * Copyright (C) 2017, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALTRIGGERSUMMEDAREATABLE_H
+#define ALIEMCALTRIGGERSUMMEDAREATABLE_H
+
+#include <vector>
+#include <Rtypes.h>
+
+template<class T> class AliEMCALTriggerDataGrid;
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class AliEmcalTriggerSummedAreaTable
+ * @brief Summed-area table of a trigger channel map
+ * @ingroup EMCALTRGFW
+ *
+ * Copy of a map of trigger channels (FastORs) together with its summed-area
+ * tables, built once per event with Build(). Any rectangular window can then
+ * be tested for channels with non-zero amplitude, and for maps with integer
+ * amplitudes (ADC values) be summed, with a constant number of lookups,
+ * independent of the size of the window.
+ *
+ * Sums are always identical to the sum of the channels one by one:
+ * - Windows without any non-zero channel sum to 0.
+ * - For integer maps, the integer table is exact, and so is the sum of
+ *   the channels in double precision.
+ * - Otherwise the channels of the window are summed in the order given,
+ *   as done by the patch finders, since a floating point table would not
+ *   reproduce their rounding.
+ * Channels of the window outside of the map are skipped.
+ */
+class AliEmcalTriggerSummedAreaTable {
+public:
+  /**
+   * @enum ESumOrder_t
+   * @brief Order in which the channels of a window are summed
+   */
+  enum ESumOrder_t {
+    kRowsOuter,           ///< Rows in the outer loop, as AliEMCALTriggerAlgorithm
+    kColsOuter            ///< Columns in the outer loop
+  };
+
+  AliEmcalTriggerSummedAreaTable();
+  virtual ~AliEmcalTriggerSummedAreaTable() {}
+
+  /**
+   * @brief Build the table from a trigger data grid
+   * @param[in] grid Channel map
+   */
+  void Build(const AliEMCALTriggerDataGrid<double> &grid);
+
+  /**
+   * @brief Build the table from a two-dimensional array
+   * @param[in] values Channel map, channel (col, row) at values[col * colStride + row]
+   * @param[in] ncols Number of columns
+   * @param[in] nrows Number of rows
+   * @param[in] colStride Distance between two columns in the array
+   * @param[in] truncate If true the channels are truncated to integers as by a cast to ULong64_t
+   */
+  void Build(const Double_t *values, Int_t ncols, Int_t nrows, Int_t colStride, Bool_t truncate = kFALSE);
+
+  /**
+   * @brief Check whether all channels of a window are 0
+   * @param[in] col First column of the window
+   * @param[in] row First row of the window
+   * @param[in] ncols Number of columns of the window
+   * @param[in] nrows Number of rows of the window
+   * @return True if the window does not contain any non-zero channel
+   */
+  Bool_t IsEmpty(Int_t col, Int_t row, Int_t ncols, Int_t nrows) const;
+
+  /**
+   * @brief Sum of the channels of a window
+   * @param[in] col First column of the window
+   * @param[in] row First row of the window
+   * @param[in] ncols Number of columns of the window
+   * @param[in] nrows Number of rows of the window
+   * @param[in] order Order of the sum for maps with non-integer channels
+   * @return Sum of the channels
+   */
+  Double_t GetSum(Int_t col, Int_t row, Int_t ncols, Int_t nrows, ESumOrder_t order = kRowsOuter) const;
+
+  /**
+   * @brief Integer sum of the channels of a window, only valid for integer maps
+   * @param[in] col First column of the window
+   * @param[in] row First row of the window
+   * @param[in] ncols Number of columns of the window
+   * @param[in] nrows Number of rows of the window
+   * @return Sum of the channels
+   */
+  Long64_t GetIntegerSum(Int_t col, Int_t row, Int_t ncols, Int_t nrows) const;
+
+  Bool_t IsIntegral() const { return fIntegral; }
+  Int_t GetNumberOfCols() const { return fNCols; }
+  Int_t GetNumberOfRows() const { return fNRows; }
+
+private:
+  void Resize(Int_t ncols, Int_t nrows);
+  void Fill();
+  Bool_t Clamp(Int_t &colmin, Int_t &rowmin, Int_t &colmax, Int_t &rowmax) const;
+  /// Index of the table entry after column col and row row
+  Int_t TableIndex(Int_t col, Int_t row) const { return row * (fNCols + 1) + col; }
+
+  Int_t                   fNCols;           ///< Number of columns of the map
+  Int_t                   fNRows;           ///< Number of rows of the map
+  Bool_t                  fIntegral;        ///< All channels are integers, the sum table is filled
+  std::vector<Double_t>   fValues;          ///< Channels by row, channel (col, row) at row * fNCols + col
+  std::vector<Int_t>      fOccupancy;       ///< Table of the number of non-zero channels, (fNCols+1)*(fNRows+1)
+  std::vector<Long64_t>   fSum;             ///< Table of the sum of the channels for integer maps, (fNCols+1)*(fNRows+1)
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTriggerSummedAreaTable, 1);
+  /// \endcond
+};
+
+}
+
+}
+
+#endif /* ALIEMCALTRIGGERSUMMEDAREATABLE_H */
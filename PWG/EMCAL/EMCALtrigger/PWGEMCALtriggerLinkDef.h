@@ -20,4 +20,7 @@
 #pragma link C++ class PWG::EMCAL::AliEmcalTriggerSelectionCuts++;
 #pragma link C++ class PWG::EMCAL::AliEmcalTriggerSelection+;
 #pragma link C++ class PWG::EMCAL::Triggerinfo+;
+#pragma link C++ class PWG::EMCAL::AliEmcalTriggerSummedAreaTable+;
+#pragma link C++ class PWG::EMCAL::AliEmcalTriggerPatchEngine+;
+#pragma link C++ class PWG::EMCAL::TestAliEmcalTriggerPatchEngine+;
 #endif
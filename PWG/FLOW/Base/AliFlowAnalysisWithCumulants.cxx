@@ -448,15 +448,16 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionsForDifferentTuningPara
  }
  
  // Looping over tracks:
+ const AliFlowEventSimple::TrackArrays& tracks = anEvent->GetTrackArrays(); // packed tracks, no access to the track objects
  for(Int_t i=0;i<nPrim;i++)
  {
-  AliFlowTrackSimple *aftsTrack = anEvent->GetTrack(i);
-  if(aftsTrack && aftsTrack->InRPSelection())
+  Int_t t = anEvent->GetTrackIndex(i); // same (shuffled) order as GetTrack(i)
+  if(tracks.InRPSelection(t))
   {
    // Access particle variables and weights:
-   dPhi = aftsTrack->Phi();
-   dPt  = aftsTrack->Pt();
-   dEta = aftsTrack->Eta();
+   dPhi = tracks.fPhi[t];
+   dPt  = tracks.fPt[t];
+   dEta = tracks.fEta[t];
    if(fUsePhiWeights && fnBinsPhi) // determine phi weight for this particle:
    {
     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -485,7 +486,7 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionsForDifferentTuningPara
      } // end of for(Int_t p=0;p<pMax[pq];p++)
     } // end for(Int_t pq=0;pq<5;pq++) // 5 different values for set (pMax,qMax)
    } // end of for(Int_t r=0;r<10;r++) // 10 different values for interpolating parameter r0  
-  } // end of if(aftsTrack && aftsTrack->InRPSelection())
+  } // end of if(tracks.InRPSelection(t))
  } // end of for(Int_t i=0;i<nPrim;i++) 
   
  // Store G[p][q]:
@@ -548,16 +549,17 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForReferenceFlow(AliFlo
  Int_t crossCheckRP = 0; 
  
  // Looping over tracks:
+ const AliFlowEventSimple::TrackArrays& tracks = anEvent->GetTrackArrays(); // packed tracks, no access to the track objects
  for(Int_t i=0;i<nPrim;i++)
  {
-  AliFlowTrackSimple *aftsTrack = anEvent->GetTrack(i);
-  if(aftsTrack && aftsTrack->InRPSelection())
+  Int_t t = anEvent->GetTrackIndex(i); // same (shuffled) order as GetTrack(i)
+  if(tracks.InRPSelection(t))
   {
    crossCheckRP++;
    // Access particle variables and weights:
-   dPhi = aftsTrack->Phi();
-   dPt  = aftsTrack->Pt();
-   dEta = aftsTrack->Eta();
+   dPhi = tracks.fPhi[t];
+   dPt  = tracks.fPt[t];
+   dEta = tracks.fEta[t];
    if(fUsePhiWeights && fnBinsPhi) // determine phi weight for this particle:
    {
     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -580,7 +582,7 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForReferenceFlow(AliFlo
    }
    // Fill the profile to calculate <<w^2>>: 
    fAverageOfSquaredWeight->Fill(0.5,pow(wPhi*wPt*wEta,2.),1.); 
-  } // end of if(aftsTrack && aftsTrack->InRPSelection())
+  } // end of if(tracks.InRPSelection(t))
  } // end of for(Int_t i=0;i<nPrim;i++) 
  
  // Cross check # of RPs:
@@ -676,19 +678,19 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForDiffFlow(AliFlowEven
  Int_t nRP = anEvent->GetEventNSelTracksRP(); // nRP = # of particles used to determine the reaction plane
        
  // Start the second loop over event in order to evaluate the generating function D[b][p][q] for differential flow: 
+ const AliFlowEventSimple::TrackArrays& tracks = anEvent->GetTrackArrays(); // packed tracks, no access to the track objects
  for(Int_t i=0;i<nPrim;i++)
  {
-  AliFlowTrackSimple *aftsTrack = anEvent->GetTrack(i);
-  if(aftsTrack)
+  Int_t t = anEvent->GetTrackIndex(i); // same (shuffled) order as GetTrack(i)
+  if(tracks.InRPSelection(t) || tracks.InPOISelection(t))
   {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())) continue;
    // Differential flow of POIs:
-   if(aftsTrack->InPOISelection())
+   if(tracks.InPOISelection(t))
    {
     // Get azimuthal angle, momentum and pseudorapidity of a particle:
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    dPhi = tracks.fPhi[t];
+    dPt  = tracks.fPt[t];
+    dEta = tracks.fEta[t];
     Double_t ptEta[2] = {dPt,dEta};    
    
     // Count number of POIs in pt/eta bin:
@@ -697,7 +699,7 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForDiffFlow(AliFlowEven
      fNoOfParticlesInBin[1][pe]->Fill(ptEta[pe],ptEta[pe],1.);
     }
   
-    if(!(aftsTrack->InRPSelection())) // particle was flagged only as POI 
+    if(!(tracks.InRPSelection(t))) // particle was flagged only as POI 
     {
      // Fill generating function:
      for(Int_t p=0;p<pMax;p++)
@@ -722,8 +724,8 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForDiffFlow(AliFlowEven
        } // end of for(Int_t ri=0;ri<2;ri++) 
       } // end of for(Int_t q=0;q<qMax;q++)
      } // end of for(Int_t p=0;p<pMax;p++)       
-    } // end of if(!(aftsTrack->InRPSelection())) // particle was flagged only as POI 
-    else if(aftsTrack->InRPSelection()) // particle was flagged both as RP and POI 
+    } // end of if(!(tracks.InRPSelection(t))) // particle was flagged only as POI 
+    else if(tracks.InRPSelection(t)) // particle was flagged both as RP and POI 
     {
      // If particle weights were used, get them:
      if(fUsePhiWeights && fnBinsPhi) // determine phi weight for this particle:
@@ -761,15 +763,15 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForDiffFlow(AliFlowEven
        } // end of for(Int_t ri=0;ri<2;ri++) 
       } // end of for(Int_t q=0;q<qMax;q++)
      } // end of for(Int_t p=0;p<pMax;p++)
-    } // end of else if (aftsTrack->InRPSelection()) // particle was flagged both as RP and POI 
-   } // end of if(aftsTrack->InPOISelection())
+    } // end of else if (tracks.InRPSelection(t)) // particle was flagged both as RP and POI 
+   } // end of if(tracks.InPOISelection(t))
    // Differential flow of RPs:
-   if(aftsTrack->InRPSelection()) 
+   if(tracks.InRPSelection(t)) 
    {
     // Get azimuthal angle, momentum and pseudorapidity of a particle:
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    dPhi = tracks.fPhi[t];
+    dPt  = tracks.fPt[t];
+    dEta = tracks.fEta[t];
     Double_t ptEta[2] = {dPt,dEta}; 
     
     // Count number of RPs in pt/eta bin:
@@ -814,8 +816,8 @@ void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForDiffFlow(AliFlowEven
       } // end of for(Int_t ri=0;ri<2;ri++) 
      } // end of for(Int_t q=0;q<qMax;q++)
     } // end of for(Int_t p=0;p<pMax;p++)
-   } // end of if(aftsTrack->InRPSelection()) 
-  } // end of if(aftsTrack)  
+   } // end of if(tracks.InRPSelection(t)) 
+  } // end of if(tracks.InRPSelection(t) || tracks.InPOISelection(t))
  } // end of for(Int_t i=0;i<nPrim;i++)
  
 } // end of void AliFlowAnalysisWithCumulants::FillGeneratingFunctionForDiffFlow(AliFlowEventSimple* anEvent)
@@ -377,61 +377,95 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
                                                                                                                                                                                                                                                                                         
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
- AliFlowTrackSimple *aftsTrack = NULL;
- Int_t n = fHarmonic; // shortcut for the harmonic 
+ const AliFlowEventSimple::TrackArrays& tracks = anEvent->GetTrackArrays(); // packed tracks, no access to the track objects
+ Double_t wPow[9] = {0.}; // powers k = 0,...,8 of the particle weight
+ Double_t dCosPhi[12] = {0.}; // cos((m+1)*n*dPhi), m = 0,...,11, n = fHarmonic
+ Double_t dSinPhi[12] = {0.}; // sin((m+1)*n*dPhi), m = 0,...,11, n = fHarmonic
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
-  aftsTrack=anEvent->GetTrack(i);
-  if(aftsTrack)
-  {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())){continue;} // safety measure: consider only tracks which are RPs or POIs
-   if(aftsTrack->InRPSelection()) // RP condition:
-   {    
-    nCounterNoRPs++;
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
-    {
-     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
-    }
-    if(fUsePtWeights && fPtWeights && fnBinsPt) // determine pt weight for this particle:
-    {
-     wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
-    }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
-    {
-     wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
-    }      
-    // Access track weight:
-    if(fUseTrackWeights)
+  Int_t t = anEvent->GetTrackIndex(i); // same (shuffled) order as GetTrack(i)
+  Bool_t bRP = tracks.InRPSelection(t);
+  Bool_t bPOI = tracks.InPOISelection(t);
+  if(!(bRP || bPOI)){continue;} // safety measure: consider only tracks which are RPs or POIs
+  if(bRP) // RP condition:
+  {    
+   nCounterNoRPs++;
+   dPhi = tracks.fPhi[t];
+   dPt  = tracks.fPt[t];
+   dEta = tracks.fEta[t];
+   if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
+   {
+    wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
+   }
+   if(fUsePtWeights && fPtWeights && fnBinsPt) // determine pt weight for this particle:
+   {
+    wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
+   }              
+   if(fUseEtaWeights && fEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
+   {
+    wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
+   }      
+   // Access track weight:
+   if(fUseTrackWeights)
+   {
+    wTrack = tracks.fWeight[t]; 
+   }
+   this->PowersAndHarmonics(wPhi*wPt*wEta*wTrack,dPhi,wPow,dCosPhi,dSinPhi);
+   // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
+   for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+   {
+    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
     {
-     wTrack = aftsTrack->Weight(); 
+     (*fReQ)(m,k)+=wPow[k]*dCosPhi[m]; 
+     (*fImQ)(m,k)+=wPow[k]*dSinPhi[m]; 
+    } 
+   }
+   // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
+   for(Int_t p=0;p<8;p++)
+   {
+    for(Int_t k=0;k<9;k++)
+    {     
+     (*fSpk)(p,k)+=wPow[k];
     }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+   } 
+   // Differential flow:
+   if(fCalculateDiffFlow || fCalculate2DDiffFlow)
+   {
+    ptEta[0] = dPt; 
+    ptEta[1] = dEta; 
+    // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs): 
+    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
     {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
      {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
-    {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
-     }
-    } 
-    // Differential flow:
-    if(fCalculateDiffFlow || fCalculate2DDiffFlow)
+      if(fCalculateDiffFlow)
+      {
+       for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+       {
+        fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],wPow[k]*dCosPhi[m],1.);
+        fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],wPow[k]*dSinPhi[m],1.);          
+        if(m==0) // s_{p,k} does not depend on index m
+        {
+         fs1dEBE[0][pe][k]->Fill(ptEta[pe],wPow[k],1.);
+        } // end of if(m==0) // s_{p,k} does not depend on index m
+       } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+      } // end of if(fCalculateDiffFlow) 
+      if(fCalculate2DDiffFlow)
+      {
+       fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,wPow[k]*dCosPhi[m],1.);
+       fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,wPow[k]*dSinPhi[m],1.);      
+       if(m==0) // s_{p,k} does not depend on index m
+       {
+        fs2dEBE[0][k]->Fill(dPt,dEta,wPow[k],1.);
+       } // end of if(m==0) // s_{p,k} does not depend on index m
+      } // end of if(fCalculate2DDiffFlow)
+     } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+    } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+    // Checking if RP particle is also POI particle:      
+    if(bPOI)
     {
-     ptEta[0] = dPt; 
-     ptEta[1] = dEta; 
-     // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs): 
+     // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
      {
       for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
@@ -440,112 +474,78 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
        {
         for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
         {
-         fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
+         fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],wPow[k]*dCosPhi[m],1.);
+         fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],wPow[k]*dSinPhi[m],1.);          
          if(m==0) // s_{p,k} does not depend on index m
          {
-          fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
+          fs1dEBE[2][pe][k]->Fill(ptEta[pe],wPow[k],1.);
          } // end of if(m==0) // s_{p,k} does not depend on index m
         } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
        } // end of if(fCalculateDiffFlow) 
        if(fCalculate2DDiffFlow)
        {
-        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
+        fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,wPow[k]*dCosPhi[m],1.);
+        fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,wPow[k]*dSinPhi[m],1.);      
         if(m==0) // s_{p,k} does not depend on index m
         {
-         fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
+         fs2dEBE[2][k]->Fill(dPt,dEta,wPow[k],1.);
         } // end of if(m==0) // s_{p,k} does not depend on index m
        } // end of if(fCalculate2DDiffFlow)
       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     // Checking if RP particle is also POI particle:      
-     if(aftsTrack->InPOISelection())
-     {
-      // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
-      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-      {
-       for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-       {
-        if(fCalculateDiffFlow)
-        {
-         for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-         {
-          fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-          fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-          if(m==0) // s_{p,k} does not depend on index m
-          {
-           fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-          } // end of if(m==0) // s_{p,k} does not depend on index m
-         } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-        } // end of if(fCalculateDiffFlow) 
-        if(fCalculate2DDiffFlow)
-        {
-         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of if(fCalculate2DDiffFlow)
-       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-     } // end of if(aftsTrack->InPOISelection())  
-    } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)         
-   } // end of if(pTrack->InRPSelection())
-   if(aftsTrack->InPOISelection())
-   {
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
-    wPhi = 1.;
-    wPt  = 1.;
-    wEta = 1.;
-    wTrack = 1.;
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && aftsTrack->InRPSelection()) // determine phi weight for POI && RP particle:
-    {
-     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
-    }
-    if(fUsePtWeights && fPtWeights && fnBinsPt && aftsTrack->InRPSelection()) // determine pt weight for POI && RP particle:
-    {
-     wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
-    }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && aftsTrack->InRPSelection()) // determine eta weight for POI && RP particle: 
-    {
-     wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
-    }      
-    // Access track weight for POI && RP particle:
-    if(aftsTrack->InRPSelection() && fUseTrackWeights)
-    {
-     wTrack = aftsTrack->Weight(); 
-    }
-    ptEta[0] = dPt;
-    ptEta[1] = dEta;
-    // Calculate p_{m*n,k} ('p-vector' for POIs): 
-    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
+    } // end of if(bPOI)  
+   } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)         
+  } // end of if(pTrack->InRPSelection())
+  if(bPOI)
+  {
+   dPhi = tracks.fPhi[t];
+   dPt  = tracks.fPt[t];
+   dEta = tracks.fEta[t];
+   wPhi = 1.;
+   wPt  = 1.;
+   wEta = 1.;
+   wTrack = 1.;
+   if(fUsePhiWeights && fPhiWeights && fnBinsPhi && bRP) // determine phi weight for POI && RP particle:
+   {
+    wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
+   }
+   if(fUsePtWeights && fPtWeights && fnBinsPt && bRP) // determine pt weight for POI && RP particle:
+   {
+    wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
+   }              
+   if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && bRP) // determine eta weight for POI && RP particle: 
+   {
+    wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
+   }      
+   // Access track weight for POI && RP particle:
+   if(bRP && fUseTrackWeights)
+   {
+    wTrack = tracks.fWeight[t]; 
+   }
+   this->PowersAndHarmonics(wPhi*wPt*wEta*wTrack,dPhi,wPow,dCosPhi,dSinPhi);
+   ptEta[0] = dPt;
+   ptEta[1] = dEta;
+   // Calculate p_{m*n,k} ('p-vector' for POIs): 
+   for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+   {
+    for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
     {
-     for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+     if(fCalculateDiffFlow)
      {
-      if(fCalculateDiffFlow)
+      for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
       {
-       for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-       {
-        fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-       } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-      } // end of if(fCalculateDiffFlow) 
-      if(fCalculate2DDiffFlow)
-      {
-       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-      } // end of if(fCalculate2DDiffFlow)
-     } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-    } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-   } // end of if(pTrack->InPOISelection())    
-  } else // to if(aftsTrack)
-    {
-     printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
-    }
+       fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],wPow[k]*dCosPhi[m],1.);
+       fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],wPow[k]*dSinPhi[m],1.);          
+      } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+     } // end of if(fCalculateDiffFlow) 
+     if(fCalculate2DDiffFlow)
+     {
+      fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,wPow[k]*dCosPhi[m],1.);
+      fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,wPow[k]*dSinPhi[m],1.);      
+     } // end of if(fCalculate2DDiffFlow)
+    } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+   } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
+  } // end of if(pTrack->InPOISelection())    
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
@@ -700,6 +700,25 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithQCumulants::PowersAndHarmonics(Double_t w, Double_t dPhi, Double_t *wPow, Double_t *dCosPhi, Double_t *dSinPhi) const
+{
+ // Per-particle factors of the Q-vectors, evaluated once per particle in Make():
+ // wPow[k] = w^k (k = 0,...,8), dCosPhi[m] = cos((m+1)*n*dPhi) and dSinPhi[m] = sin((m+1)*n*dPhi) (m = 0,...,11).
+
+ for(Int_t k=0;k<9;k++)
+ {
+  wPow[k] = pow(w,k);
+ }
+ for(Int_t m=0;m<12;m++)
+ {
+  dCosPhi[m] = TMath::Cos((m+1)*fHarmonic*dPhi);
+  dSinPhi[m] = TMath::Sin((m+1)*fHarmonic*dPhi);
+ }
+
+} // end of void AliFlowAnalysisWithQCumulants::PowersAndHarmonics(Double_t w, Double_t dPhi, Double_t *wPow, Double_t *dCosPhi, Double_t *dSinPhi) const
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::Finish()
 {
  // Calculate the final results.
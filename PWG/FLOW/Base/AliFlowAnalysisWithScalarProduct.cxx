@@ -371,15 +371,14 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
   fHistProNUAq->Fill(5.,vQm.Y()/dNq,dWq);
   fHistProNUAq->Fill(6.,vQm.X()/dNq,dWq);
 
-  //loop over the tracks of the event
-  AliFlowTrackSimple*   pTrack = NULL; 
+  //loop over the tracks of the event, packed: the track object is needed only to subtract it from the Q vector
+  const AliFlowEventSimple::TrackArrays& tracks = anEvent->GetTrackArrays();
   Int_t iNumberOfTracks = anEvent->NumberOfTracks(); 
   for (Int_t i=0;i<iNumberOfTracks;i++) {
-    pTrack = anEvent->GetTrack(i) ; 
-    if (!pTrack) continue;
-    Double_t dPhi = pTrack->Phi();
-    Double_t dPt  = pTrack->Pt();
-    Double_t dEta = pTrack->Eta();
+    Int_t t = anEvent->GetTrackIndex(i);
+    Double_t dPhi = tracks.fPhi[t];
+    Double_t dPt  = tracks.fPt[t];
+    Double_t dEta = tracks.fEta[t];
 
     //calculate vU
     TVector2 vU;
@@ -402,7 +401,7 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
 
     //remove track if in subevent
     for(Int_t inSubEvent=0; inSubEvent<2; ++inSubEvent) {
-      if( !pTrack->InSubevent( inSubEvent ) )
+      if( !tracks.InSubevent( t, inSubEvent ) )
         continue;
       if(inSubEvent==0)
         if( (fTotalQvector%2)!=1 )
@@ -426,13 +425,14 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
       //subtrack the track from the Q vector, but only if it was used to construct this
       //Q vector: i.e. check wether it has the same tags and is in the same subevent
       //this is especially important for the daughters (as for the mother it is already checked)
+      AliFlowTrackSimple* pTrack = anEvent->GetTrack(i);
       Int_t numberOfsubtractedDaughters=vQm.SubtractTrackWithDaughters(pTrack,dW);
       
       if(!fMinimalBook) {
         fHistNumberOfSubtractedDaughters->Fill(numberOfsubtractedDaughters);
       }
 
-      dMq = dMq-dW*pTrack->Weight();
+      dMq = dMq-dW*tracks.fWeight[t];
     }
     dNq = fNormalizationType ? dMq : vQm.Mod();
     dWq = fNormalizationType ? dMq : 1;
@@ -455,9 +455,9 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
 
     //fill the profile histograms
     for(Int_t iPOI=0; iPOI!=2; ++iPOI) {
-      if( (iPOI==0)&&(!pTrack->InRPSelection()) )
+      if( (iPOI==0)&&(!tracks.InRPSelection(t)) )
         continue;
-      if( (iPOI==1)&&(!pTrack->InPOISelection(fPOItype)) )
+      if( (iPOI==1)&&(!tracks.InPOISelection(t,fPOItype)) )
         continue;
       fHistProUQ[iPOI][0]->Fill(dPt ,dUQ/dNq,dWq); //Fill (uQ/Nq') with weight (Nq')
       fHistProUQ[iPOI][1]->Fill(dEta,dUQ/dNq,dWq); //Fill (uQ/Nq') with weight (Nq')
@@ -589,20 +589,19 @@ Bool_t AliFlowCommonHist::FillControlHistograms(AliFlowEventSimple* anEvent,TLis
   Double_t dMultRP = 0.;
   Double_t dMultPOI = 0.;
   
-  Int_t iNumberOfTracks = anEvent->NumberOfTracks();
-  AliFlowTrackSimple* pTrack = NULL;     
-
-  for (Int_t i=0;i<iNumberOfTracks;i++) {
-    pTrack = anEvent->GetTrack(i);
-    if (pTrack ) {
-      dWeight = pTrack->Weight();
-      dPt = pTrack->Pt();
-      dPhi = pTrack->Phi();
+  //same packed tracks as used by GetQ() and Get2Qsub() above
+  const AliFlowEventSimple::TrackArrays& tracks = anEvent->GetTrackArrays();
+
+  for (Int_t i=0;i<tracks.fN;i++) {
+    if (tracks.fPOItype[i]) {
+      dWeight = tracks.fWeight[i];
+      dPt = tracks.fPt[i];
+      dPhi = tracks.fPhi[i];
       if (dPhi<0.) dPhi+=2*TMath::Pi();
-      dEta = pTrack->Eta();
+      dEta = tracks.fEta[i];
 
       //weights are only used for the RP selection
-      if (pTrack->InRPSelection()){
+      if (tracks.InRPSelection(i)){
 	// determine Phi weight:
 	if(phiWeights && nBinsPhi) {
 	  dWPhi = phiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhi/TMath::TwoPi())));
@@ -632,7 +631,7 @@ Bool_t AliFlowCommonHist::FillControlHistograms(AliFlowEventSimple* anEvent,TLis
 	//count
 	dMultRP += dW;
       }
-      if (pTrack->InRPSelection() && pTrack->InSubevent(0)) {
+      if (tracks.InRPSelection(i) && tracks.InSubevent(i,0)) {
 	// determine Phi weight:
 	if(phiWeightsSub0 && nBinsPhiSub0){
 	  dWPhi = phiWeightsSub0->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhiSub0/TMath::TwoPi())));
@@ -656,7 +655,7 @@ Bool_t AliFlowCommonHist::FillControlHistograms(AliFlowEventSimple* anEvent,TLis
 	//eta
 	if(!fBookOnlyBasic){fHistEtaSub0 ->Fill(dEta,dW);}
       }
-      if (pTrack->InRPSelection() && pTrack->InSubevent(1)) {
+      if (tracks.InRPSelection(i) && tracks.InSubevent(i,1)) {
 	// determine Phi weight:
 	if(phiWeightsSub1 && nBinsPhiSub1){
 	  dWPhi = phiWeightsSub1->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhiSub1/TMath::TwoPi())));
@@ -680,7 +679,7 @@ Bool_t AliFlowCommonHist::FillControlHistograms(AliFlowEventSimple* anEvent,TLis
 	//eta
 	if(!fBookOnlyBasic){fHistEtaSub1 -> Fill(dEta,dW);}
       }
-      if (pTrack->InPOISelection()){
+      if (tracks.InPOISelection(i)){
 
 	Double_t dW = dWeight; //no pt, phi or eta weights
 
@@ -695,7 +694,7 @@ Bool_t AliFlowCommonHist::FillControlHistograms(AliFlowEventSimple* anEvent,TLis
 	//mean pt
 	fHistProMeanPtperBin ->Fill(dPt,dPt,dW);
 	//mass
-	fHistMassPOI->Fill(pTrack->Mass(),dPt,dW);
+	fHistMassPOI->Fill(tracks.fMass[i],dPt,dW);
 	//count
 	dMultPOI += dW;
       }
@@ -75,6 +75,8 @@ AliFlowEventSimple::AliFlowEventSimple():
   fShuffledIndexes(NULL),
   fShuffleTracks(kFALSE),
   fMothersCollection(NULL),
+  fTrackArrays(NULL),
+  fTrackArraysFilled(kFALSE),
   fCentrality(-1.),
   fCentralityCL1(-1.),
   fNITSCL1(-1.),
@@ -134,6 +136,8 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fShuffledIndexes(NULL),
   fShuffleTracks(kFALSE),
   fMothersCollection(new TObjArray()),
+  fTrackArrays(NULL),
+  fTrackArraysFilled(kFALSE),
   fCentrality(-1.),
   fCentralityCL1(-1.),
   fNITSCL1(-1.),
@@ -195,6 +199,8 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fShuffledIndexes(NULL),
   fShuffleTracks(anEvent.fShuffleTracks),
   fMothersCollection(new TObjArray()),
+  fTrackArrays(NULL),
+  fTrackArraysFilled(kFALSE),
   fCentrality(anEvent.fCentrality),
   fCentralityCL1(anEvent.fCentralityCL1),
   fNITSCL1(anEvent.fNITSCL1),
@@ -306,6 +312,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
     fV0A[i] = anEvent.fV0A[i];
   }
   delete [] fShuffledIndexes;
+  fTrackArraysFilled = kFALSE;
   return *this;
 }
 
@@ -321,6 +328,7 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fMCReactionPlaneAngleWrap;
   delete fShuffledIndexes;
   delete fMothersCollection;
+  delete fTrackArrays;
   delete [] fNumberOfPOIs;
 }
 
@@ -417,18 +425,22 @@ void AliFlowEventSimple::Generate(Int_t nParticles,
 AliFlowTrackSimple* AliFlowEventSimple::GetTrack(Int_t i)
 {
   //get track i from collection
+  //a caller modifying the track after GetTrackArrays() has to call InvalidateTrackArrays()
   if (i>=fNumberOfTracks) return NULL;
-  Int_t trackIndex=i;
-  //if asked use the shuffled index
-  if (fShuffleTracks)
-  {
-    if (!fShuffledIndexes) ShuffleTracks();
-    trackIndex=fShuffledIndexes[i];
-  }
-  AliFlowTrackSimple* pTrack = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(trackIndex)) ;
+  AliFlowTrackSimple* pTrack = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(GetTrackIndex(i))) ;
   return pTrack;
 }
 
+//-----------------------------------------------------------------------
+Int_t AliFlowEventSimple::GetTrackIndex(Int_t i)
+{
+  //index in the collection and in the packed arrays of the track returned by GetTrack(i)
+  //if asked use the shuffled index
+  if (!fShuffleTracks) return i;
+  if (!fShuffledIndexes) ShuffleTracks();
+  return fShuffledIndexes[i];
+}
+
 //-----------------------------------------------------------------------
 void AliFlowEventSimple::ShuffleTracks()
 {
@@ -467,6 +479,7 @@ void AliFlowEventSimple::TrackAdded()
 {
   //book keeping after a new track has been added
   fNumberOfTracks++;
+  fTrackArraysFilled = kFALSE;
   if (fShuffledIndexes)
   {
     delete [] fShuffledIndexes;
@@ -485,6 +498,53 @@ AliFlowTrackSimple* AliFlowEventSimple::MakeNewTrack()
    return t;
 }
 
+//-----------------------------------------------------------------------
+const AliFlowEventSimple::TrackArrays& AliFlowEventSimple::GetTrackArrays()
+{
+  //packed copy of the tracks, refilled only if the tracks may have changed since the last call
+  //the arrays keep their capacity, no allocation once the largest event has been seen
+  if (!fTrackArrays) fTrackArrays = new TrackArrays();
+  if (fTrackArraysFilled) return *fTrackArrays;
+
+  TrackArrays& a = *fTrackArrays;
+  a.fN = fNumberOfTracks;
+  a.fPhi.resize(fNumberOfTracks);
+  a.fPt.resize(fNumberOfTracks);
+  a.fEta.resize(fNumberOfTracks);
+  a.fWeight.resize(fNumberOfTracks);
+  a.fMass.resize(fNumberOfTracks);
+  a.fPOItype.resize(fNumberOfTracks);
+  a.fSubEvents.resize(fNumberOfTracks);
+  for (Int_t i=0; i<fNumberOfTracks; i++)
+  {
+    AliFlowTrackSimple* pTrack = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
+    if (!pTrack)
+    {
+      cerr << "no particle!!!"<<endl;
+      a.fPhi[i] = a.fPt[i] = a.fEta[i] = 0.;
+      a.fWeight[i] = 1.;
+      a.fMass[i] = -1.;
+      a.fPOItype[i] = a.fSubEvents[i] = 0;
+      continue;
+    }
+    a.fPhi[i]    = pTrack->Phi();
+    a.fPt[i]     = pTrack->Pt();
+    a.fEta[i]    = pTrack->Eta();
+    a.fWeight[i] = pTrack->Weight();
+    a.fMass[i]   = pTrack->Mass();
+    UInt_t bits = 0;
+    const TBits* poiType = pTrack->GetPOItype();
+    for (UInt_t b=poiType->FirstSetBit(); b<32 && b<poiType->GetNbits(); b=poiType->FirstSetBit(b+1)) bits |= (1u<<b);
+    a.fPOItype[i] = bits;
+    bits = 0;
+    const TBits* subEvents = pTrack->GetSubEventBits();
+    for (UInt_t b=subEvents->FirstSetBit(); b<32 && b<subEvents->GetNbits(); b=subEvents->FirstSetBit(b+1)) bits |= (1u<<b);
+    a.fSubEvents[i] = bits;
+  }
+  fTrackArraysFilled = kTRUE;
+  return a;
+}
+
 //-----------------------------------------------------------------------
 AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
                                         TList *weightsList,
@@ -505,8 +565,6 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
   Double_t dEta = 0.;
   Double_t dWeight = 1.;
 
-  AliFlowTrackSimple* pTrack = NULL;
-
   Int_t nBinsPhi = 0;
   Double_t dBinWidthPt = 0.;
   Double_t dPtMin = 0.;
@@ -549,47 +607,40 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
   } // end of if(weightsList)
 
   // loop over tracks
-  for(Int_t i=0; i<fNumberOfTracks; i++)
+  const TrackArrays& tracks = GetTrackArrays();
+  for(Int_t i=0; i<tracks.fN; i++)
   {
-    pTrack = (AliFlowTrackSimple*)fTrackCollection->At(i);
-    if(pTrack)
+    if(tracks.InRPSelection(i))
     {
-      if(pTrack->InRPSelection())
-      {
-        dPhi = pTrack->Phi();
-        dPt  = pTrack->Pt();
-        dEta = pTrack->Eta();
-	      dWeight = pTrack->Weight();
+      dPhi = tracks.fPhi[i];
+      dPt  = tracks.fPt[i];
+      dEta = tracks.fEta[i];
+      dWeight = tracks.fWeight[i];
 
-        // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
-        if(phiWeights && nBinsPhi)
-        {
-          wPhi = phiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhi/TMath::TwoPi())));
-        }
-        // determine v'(pt) weight:
-        if(ptWeights && dBinWidthPt)
-        {
-          wPt=ptWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-dPtMin)/dBinWidthPt)));
-        }
-        // determine v'(eta) weight:
-        if(etaWeights && dBinWidthEta)
-        {
-          wEta=etaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-dEtaMin)/dBinWidthEta)));
-        }
+      // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
+      if(phiWeights && nBinsPhi)
+      {
+        wPhi = phiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhi/TMath::TwoPi())));
+      }
+      // determine v'(pt) weight:
+      if(ptWeights && dBinWidthPt)
+      {
+        wPt=ptWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-dPtMin)/dBinWidthPt)));
+      }
+      // determine v'(eta) weight:
+      if(etaWeights && dBinWidthEta)
+      {
+        wEta=etaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-dEtaMin)/dBinWidthEta)));
+      }
 
-        // building up the weighted Q-vector:
-        dQX += dWeight*wPhi*wPt*wEta*TMath::Cos(iOrder*dPhi);
-        dQY += dWeight*wPhi*wPt*wEta*TMath::Sin(iOrder*dPhi);
+      // building up the weighted Q-vector:
+      dQX += dWeight*wPhi*wPt*wEta*TMath::Cos(iOrder*dPhi);
+      dQY += dWeight*wPhi*wPt*wEta*TMath::Sin(iOrder*dPhi);
 
-        // weighted multiplicity:
-        sumOfWeights += dWeight*wPhi*wPt*wEta;
+      // weighted multiplicity:
+      sumOfWeights += dWeight*wPhi*wPt*wEta;
 
-      } // end of if (pTrack->InRPSelection())
-    } // end of if (pTrack)
-    else
-    {
-      cerr << "no particle!!!"<<endl;
-    }
+    } // end of if (tracks.InRPSelection(i))
   } // loop over particles
 
   vQ.Set(dQX,dQY);
@@ -622,8 +673,6 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
   Double_t dEta = 0.;
   Double_t dWeight = 1.;
 
-  AliFlowTrackSimple* pTrack = NULL;
-
   Int_t    iNbinsPhiSub0 = 0;
   Int_t    iNbinsPhiSub1 = 0;
   Double_t dBinWidthPt = 0.;
@@ -673,24 +722,20 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
     }
   } // end of if(weightsList)
 
+  const TrackArrays& tracks = GetTrackArrays();
+
   //loop over the two subevents
   for (Int_t s=0; s<2; s++)
   {
     // loop over tracks
-    for(Int_t i=0; i<fNumberOfTracks; i++)
+    for(Int_t i=0; i<tracks.fN; i++)
     {
-      pTrack = (AliFlowTrackSimple*)fTrackCollection->At(i);
-      if(!pTrack)
-      {
-        cerr << "no particle!!!"<<endl;
-        continue;
-      }
-      if(pTrack->InRPSelection() && (pTrack->InSubevent(s)))
+      if(tracks.InRPSelection(i) && tracks.InSubevent(i,s))
       {
-        dPhi    = pTrack->Phi();
-        dPt     = pTrack->Pt();
-        dEta    = pTrack->Eta();
-        dWeight = pTrack->Weight();
+        dPhi    = tracks.fPhi[i];
+        dPt     = tracks.fPt[i];
+        dEta    = tracks.fEta[i];
+        dWeight = tracks.fWeight[i];
 
         // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
         //subevent 0
@@ -881,6 +926,8 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fShuffledIndexes(NULL),
   fShuffleTracks(kFALSE),
   fMothersCollection(new TObjArray()),
+  fTrackArrays(NULL),
+  fTrackArraysFilled(kFALSE),
   fCentrality(-1.),
   fCentralityCL1(-1.),
   fNITSCL1(-1.),
@@ -974,6 +1021,7 @@ void AliFlowEventSimple::CloneTracks(Int_t n)
 void AliFlowEventSimple::ResolutionPt(Double_t res)
 {
   //smear pt of all tracks by gaussian with sigma=res
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -989,6 +1037,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
                                             Double_t etaMaxB )
 {
   //Flag two subevents in given eta ranges
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1004,6 +1053,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
 void AliFlowEventSimple::TagSubeventsByCharge()
 {
   //Flag two subevents in given eta ranges
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1019,6 +1069,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
 void AliFlowEventSimple::AddV1( Double_t v1 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1036,6 +1087,7 @@ void AliFlowEventSimple::AddV1( Double_t v1 )
 void AliFlowEventSimple::AddV2( Double_t v2 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1053,6 +1105,7 @@ void AliFlowEventSimple::AddV2( Double_t v2 )
 void AliFlowEventSimple::AddV3( Double_t v3 )
 {
   //add v3 to all tracks wrt the reaction plane angle
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1070,6 +1123,7 @@ void AliFlowEventSimple::AddV3( Double_t v3 )
 void AliFlowEventSimple::AddV4( Double_t v4 )
 {
   //add v4 to all tracks wrt the reaction plane angle
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1087,6 +1141,7 @@ void AliFlowEventSimple::AddV4( Double_t v4 )
 void AliFlowEventSimple::AddV5( Double_t v5 )
 {
   //add v4 to all tracks wrt the reaction plane angle
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1105,6 +1160,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
                                   Double_t rp1, Double_t rp2, Double_t rp3, Double_t rp4, Double_t rp5 )
 {
   //add flow to all tracks wrt the reaction plane angle, for all harmonic separate angle
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1117,6 +1173,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_t v4, Double_t v5 )
 {
   //add flow to all tracks wrt the reaction plane angle
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1129,6 +1186,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1143,6 +1201,7 @@ void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1157,6 +1216,7 @@ void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 {
   //tag tracks as reference particles (RPs)
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1179,6 +1239,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiType )
 {
   //tag tracks as particles of interest (POIs)
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1212,6 +1273,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
 {
   //mark tracks in given eta-phi region as dead
   //by resetting the flow bits
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1235,6 +1297,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   //remove tracks that have no flow tags set and cleanup the container
   //returns number of cleaned tracks
   Int_t ncleaned=0;
+  fTrackArraysFilled = kFALSE;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1282,5 +1345,6 @@ void AliFlowEventSimple::ClearFast()
   fMCReactionPlaneAngleIsSet = kFALSE;
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
+  fTrackArraysFilled = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
 }
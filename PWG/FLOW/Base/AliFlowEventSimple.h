@@ -16,6 +16,7 @@
 #ifndef ALIFLOWEVENTSIMPLE_H
 #define ALIFLOWEVENTSIMPLE_H
 
+#include <vector>
 #include "TObject.h"
 #include "TParameter.h"
 #include "TMath.h"
@@ -32,6 +33,23 @@ class AliFlowEventSimple: public TObject {
 
   enum ConstructionMethod {kEmpty,kGenerate};
 
+  // Packed copy of the tracks for loops over the full event: one array per quantity,
+  // in the order of the track collection (not shuffled). Kept and reused between events.
+  struct TrackArrays {
+    Int_t                 fN;         // number of tracks
+    std::vector<Double_t> fPhi;       // azimuthal angle
+    std::vector<Double_t> fPt;        // transverse momentum
+    std::vector<Double_t> fEta;       // pseudorapidity
+    std::vector<Double_t> fWeight;    // track weight
+    std::vector<Double_t> fMass;      // mass
+    std::vector<UInt_t>   fPOItype;   // bit i set if the track is of POI type i < 32 (bit 0: RP)
+    std::vector<UInt_t>   fSubEvents; // bit s set if the track is in subevent s < 32
+    TrackArrays() : fN(0), fPhi(), fPt(), fEta(), fWeight(), fMass(), fPOItype(), fSubEvents() {}
+    Bool_t InRPSelection(Int_t i) const             { return (fPOItype[i] & 1u); }
+    Bool_t InPOISelection(Int_t i, Int_t t=1) const { return (fPOItype[i] & (1u<<t)); }
+    Bool_t InSubevent(Int_t i, Int_t s) const       { return (fSubEvents[i] & (1u<<s)); }
+  };
+
   AliFlowEventSimple();
   AliFlowEventSimple( Int_t nParticles,
                       ConstructionMethod m=kEmpty,
@@ -113,10 +131,16 @@ class AliFlowEventSimple: public TObject {
   static TF2* SimplePtEtaDepV2();
 
   AliFlowTrackSimple* GetTrack(Int_t i);
+  Int_t GetTrackIndex(Int_t i);
   void AddTrack( AliFlowTrackSimple* track );
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
 
+  const TrackArrays& GetTrackArrays();
+  // to be called after modifying tracks through GetTrack() once GetTrackArrays() was called in the event;
+  // the methods of the event modifying tracks (adding, tagging, afterburners, ClearFast()) do it themselves
+  void InvalidateTrackArrays()                      { fTrackArraysFilled = kFALSE; }
+
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
@@ -186,6 +210,8 @@ class AliFlowEventSimple: public TObject {
   Int_t*                  fShuffledIndexes;           //! placeholder for randomized indexes
   Bool_t                  fShuffleTracks;             // do we shuffle tracks on get?
   TObjArray*              fMothersCollection;         //!cache the particles with daughters
+  TrackArrays*            fTrackArrays;               //! packed tracks, see GetTrackArrays()
+  Bool_t                  fTrackArraysFilled;         //! fTrackArrays is up to date
   Double_t                fCentrality;                // centrality
   Double_t                fCentralityCL1;             // centrality (CL1)
   Double_t                fNITSCL1;                   // number of clusters in ITS layer 1
@@ -209,7 +235,7 @@ class AliFlowEventSimple: public TObject {
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
 
-  ClassDef(AliFlowEventSimple,7)
+  ClassDef(AliFlowEventSimple,8)
 };
 
 #endif
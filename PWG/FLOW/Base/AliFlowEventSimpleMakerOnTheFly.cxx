@@ -175,7 +175,18 @@ Bool_t AliFlowEventSimpleMakerOnTheFly::AcceptPt(AliFlowTrackSimple *pTrack)
 
 AliFlowEventSimple* AliFlowEventSimpleMakerOnTheFly::CreateEventOnTheFly(AliFlowTrackSimpleCuts const *cutsRP, AliFlowTrackSimpleCuts const *cutsPOI)
 {
- // Method to create event 'on the fly'.
+ // Method to create event 'on the fly'. The caller owns the event.
+
+ return FillEventOnTheFly(new AliFlowEventSimple(fMaxMult*fNTimes),cutsRP,cutsPOI);
+
+} // end of CreateEventOnTheFly()
+
+//====================================================================================================================
+
+AliFlowEventSimple* AliFlowEventSimpleMakerOnTheFly::FillEventOnTheFly(AliFlowEventSimple *pEvent, AliFlowTrackSimpleCuts const *cutsRP, AliFlowTrackSimpleCuts const *cutsPOI)
+{
+ // Method to fill event 'on the fly', the event and its tracks are reused and no memory is allocated
+ // once the largest event has been generated. Random numbers are drawn exactly as in CreateEventOnTheFly().
  
  // a) Determine the multiplicity of an event;
  // b) Determine the reaction plane of an event;
@@ -197,14 +208,16 @@ AliFlowEventSimple* AliFlowEventSimpleMakerOnTheFly::CreateEventOnTheFly(AliFlow
  } 
 
  // d) Create event 'on the fly':
- AliFlowEventSimple *pEvent = new AliFlowEventSimple(iMult); 
+ pEvent->ClearFast(); 
  pEvent->SetReferenceMultiplicity(iMult);
  pEvent->SetMCReactionPlaneAngle(dReactionPlane); 
  Int_t nRPs = 0; // number of particles tagged RP in this event
  Int_t nPOIs = 0; // number of particles tagged POI in this event
+ AliFlowTrackSimple *pTrack = NULL;
  for(Int_t p=0;p<iMult;p++)
  {
-  AliFlowTrackSimple *pTrack = new AliFlowTrackSimple();
+  if(!pTrack){pTrack = pEvent->MakeNewTrack();} // kept if rejected below
+  pTrack->Clear();
   pTrack->SetPt(fPtSpectra->GetRandom()); 
   if(fPtDependentV2 && !fUniformFluctuationsV2)
   {
@@ -248,10 +261,14 @@ AliFlowEventSimple* AliFlowEventSimpleMakerOnTheFly::CreateEventOnTheFly(AliFlow
   {
    for(Int_t nt=1;nt<fNTimes;nt++)
    {
-    pEvent->AddTrack(pTrack->Clone());  
+    AliFlowTrackSimple *pClone = pEvent->MakeNewTrack();
+    *pClone = *pTrack;
+    pEvent->AddTrack(pClone);  
    } 
   } // end of if(fNTimes>1)       
+  pTrack = NULL;
  } // end of for(Int_t p=0;p<iMult;p++)
+ delete pTrack; // last track rejected
  pEvent->SetNumberOfRPs(fNTimes*nRPs);
  pEvent->SetNumberOfPOIs(fNTimes*nPOIs);
  
@@ -274,7 +291,7 @@ AliFlowEventSimple* AliFlowEventSimpleMakerOnTheFly::CreateEventOnTheFly(AliFlow
 
  return pEvent;
     
-} // end of CreateEventOnTheFly()
+} // end of FillEventOnTheFly()
  
 //====================================================================================================================
 
@@ -31,6 +31,7 @@ class AliFlowEventSimpleMakerOnTheFly{
   Bool_t AcceptPhi(AliFlowTrackSimple *pTrack);  
   Bool_t AcceptPt(AliFlowTrackSimple *pTrack);  
   AliFlowEventSimple* CreateEventOnTheFly(AliFlowTrackSimpleCuts const *cutsRP, AliFlowTrackSimpleCuts const *cutsPOI); 
+  AliFlowEventSimple* FillEventOnTheFly(AliFlowEventSimple *pEvent, AliFlowTrackSimpleCuts const *cutsRP, AliFlowTrackSimpleCuts const *cutsPOI); // reuses pEvent and its tracks
   // Setters and getters:
   void SetMinMult(Int_t iMinMult) {this->fMinMult = iMinMult;}
   Int_t GetMinMult() const {return this->fMinMult;} 
@@ -0,0 +1,276 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+/************************************************
+ * Generate events 'on the fly' and analyze     *
+ * them with the flow analysis methods in N     *
+ * independent workers, see header.             *
+ ************************************************/
+
+#include <cstdio>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "Riostream.h"
+#include "TSystem.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TRandom3.h"
+#include "AliFlowOnTheFlyParallelDriver.h"
+#include "AliFlowEventSimpleMakerOnTheFly.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowAnalysisWithLYZEventPlane.h"
+#include "AliFlowLYZEventPlane.h"
+
+using std::endl;
+using std::cout;
+ClassImp(AliFlowOnTheFlyParallelDriver)
+
+namespace {
+ // Lee-Yang Zeros event plane: Make() takes the event plane as well
+ class MethodLYZEP : public AliFlowOnTheFlyParallelDriver::Method{
+  public:
+   MethodLYZEP(AliFlowAnalysisWithLYZEventPlane *lyzep, AliFlowLYZEventPlane *ep, const char *name) : Method(name), fLYZEP(lyzep), fEP(ep) {}
+   virtual void Init() {fEP->Init(); fLYZEP->Init();}
+   virtual void Make(AliFlowEventSimple *anEvent) {fLYZEP->Make(anEvent,fEP);}
+   virtual TList* GetHistList() const {return fLYZEP->GetHistList();}
+   virtual void GetOutputHistograms(TList *outputListHistos) {fLYZEP->GetOutputHistograms(outputListHistos);}
+   virtual void Finish() {fLYZEP->Finish();}
+  private:
+   MethodLYZEP(const MethodLYZEP& m);
+   MethodLYZEP& operator=(const MethodLYZEP& m);
+   AliFlowAnalysisWithLYZEventPlane *fLYZEP; // analysis method (not owned)
+   AliFlowLYZEventPlane *fEP;                // event plane from the second LYZ run (not owned)
+ };
+}
+
+//========================================================================================================================================
+
+AliFlowOnTheFlyParallelDriver::AliFlowOnTheFlyParallelDriver(AliFlowEventSimpleMakerOnTheFly *eventMaker,
+                                                             AliFlowTrackSimpleCuts const *cutsRP,
+                                                             AliFlowTrackSimpleCuts const *cutsPOI):
+fEventMaker(eventMaker),
+fCutsRP(cutsRP),
+fCutsPOI(cutsPOI),
+fMethods(),
+fSeed(0),
+fWorkDir(gSystem->TempDirectory())
+{
+ // Constructor.
+
+} // end of AliFlowOnTheFlyParallelDriver::AliFlowOnTheFlyParallelDriver(...)
+
+//====================================================================================================================
+
+AliFlowOnTheFlyParallelDriver::~AliFlowOnTheFlyParallelDriver()
+{
+ // Destructor, the analysis methods themselves are not owned.
+
+ for(UInt_t m=0;m<fMethods.size();m++){delete fMethods[m];}
+
+} // end of AliFlowOnTheFlyParallelDriver::~AliFlowOnTheFlyParallelDriver()
+
+//====================================================================================================================
+
+void AliFlowOnTheFlyParallelDriver::AddMethod(AliFlowAnalysisWithLYZEventPlane *lyzep, AliFlowLYZEventPlane *ep, const char *name)
+{
+ // Add the Lee-Yang Zeros event plane method, configured (second run list set) but not initialized.
+
+ fMethods.push_back(new MethodLYZEP(lyzep,ep,name));
+
+} // end of void AliFlowOnTheFlyParallelDriver::AddMethod(AliFlowAnalysisWithLYZEventPlane *lyzep, AliFlowLYZEventPlane *ep, const char *name)
+
+//====================================================================================================================
+
+Bool_t AliFlowOnTheFlyParallelDriver::Run(Long64_t nEvents, Int_t nWorkers)
+{
+ // Generate and analyze nEvents in nWorkers processes, merge the outputs and call Finish() of the methods.
+ // With a single worker everything runs in this process, as in runFlowAnalysisOnTheFly.C.
+ //
+ // Workers are forked processes: the event maker draws from gRandom and several methods
+ // use static or global objects, so threads would need locking in the event loop. Each
+ // worker instead has its own copy of everything and only its output lists are merged.
+
+ if(!fEventMaker || fMethods.empty())
+ {
+  cout<<" WARNING (AliFlowOnTheFlyParallelDriver): no event maker or no method, nothing to do."<<endl;
+  return kFALSE;
+ }
+ if(nWorkers < 1){nWorkers = 1;}
+ if(nWorkers > nEvents){nWorkers = (nEvents > 0) ? (Int_t)nEvents : 1;}
+
+ if(nWorkers == 1)
+ {
+  for(UInt_t m=0;m<fMethods.size();m++){fMethods[m]->Init();}
+  ProcessEvents(nEvents);
+  for(UInt_t m=0;m<fMethods.size();m++){fMethods[m]->Finish();}
+  return kTRUE;
+ }
+
+ // Avoid duplicating the buffered output in the workers:
+ cout.flush();
+ fflush(stdout);
+ fflush(stderr);
+
+ std::vector<TString> fileNames(nWorkers);
+ std::vector<pid_t> pids(nWorkers,-1);
+ Bool_t ok = kTRUE;
+ for(Int_t w=0;w<nWorkers;w++)
+ {
+  // Events of this worker, the remainder goes to the first ones:
+  Long64_t nEventsWorker = nEvents/nWorkers + (w < nEvents%nWorkers ? 1 : 0);
+  fileNames[w] = Form("%s/AliFlowOnTheFly_%d_worker%d.root",fWorkDir.Data(),gSystem->GetPid(),w);
+  pids[w] = fork();
+  if(pids[w] == 0)
+  {
+   // Worker:
+   Bool_t workerOk = RunWorker(w,nEventsWorker,fileNames[w].Data());
+   cout.flush();
+   fflush(stdout);
+   _exit(workerOk ? 0 : 1);
+  } else if(pids[w] < 0)
+    {
+     cout<<" WARNING (AliFlowOnTheFlyParallelDriver): cannot start worker "<<w<<"."<<endl;
+     ok = kFALSE;
+    }
+ } // end of for(Int_t w=0;w<nWorkers;w++)
+
+ // Wait for all workers:
+ for(Int_t w=0;w<nWorkers;w++)
+ {
+  if(pids[w] <= 0){continue;}
+  Int_t status = 0;
+  if(waitpid(pids[w],&status,0) != pids[w] || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+  {
+   cout<<" WARNING (AliFlowOnTheFlyParallelDriver): worker "<<w<<" failed."<<endl;
+   ok = kFALSE;
+  }
+ }
+
+ if(ok){ok = MergeAndFinish(fileNames);}
+
+ for(Int_t w=0;w<nWorkers;w++){gSystem->Unlink(fileNames[w].Data());}
+
+ return ok;
+
+} // end of Bool_t AliFlowOnTheFlyParallelDriver::Run(Long64_t nEvents, Int_t nWorkers)
+
+//====================================================================================================================
+
+void AliFlowOnTheFlyParallelDriver::ProcessEvents(Long64_t nEvents)
+{
+ // Generate and analyze the events of this process, the same event object and its tracks are reused.
+
+ AliFlowEventSimple *event = NULL;
+ for(Long64_t i=0;i<nEvents;i++)
+ {
+  event = (event ? fEventMaker->FillEventOnTheFly(event,fCutsRP,fCutsPOI) : fEventMaker->CreateEventOnTheFly(fCutsRP,fCutsPOI));
+  for(UInt_t m=0;m<fMethods.size();m++){fMethods[m]->Make(event);}
+ }
+ delete event;
+
+} // end of void AliFlowOnTheFlyParallelDriver::ProcessEvents(Long64_t nEvents)
+
+//====================================================================================================================
+
+Bool_t AliFlowOnTheFlyParallelDriver::RunWorker(Int_t iWorker, Long64_t nEvents, const char *fileName)
+{
+ // Executed in the forked worker: seed, initialize the methods, process the events and write the output lists.
+
+ delete gRandom;
+ gRandom = new TRandom3(fSeed > 0 ? fSeed+iWorker : 0); // if 0, the seed is determined uniquely in space and time via TUUID
+
+ for(UInt_t m=0;m<fMethods.size();m++){fMethods[m]->Init();}
+ ProcessEvents(nEvents);
+
+ TFile *file = TFile::Open(fileName,"RECREATE");
+ if(!file || file->IsZombie()){return kFALSE;}
+ for(UInt_t m=0;m<fMethods.size();m++)
+ {
+  TList *list = fMethods[m]->GetHistList();
+  if(!list){continue;}
+  list->Write(fMethods[m]->GetName(),TObject::kSingleKey);
+ }
+ file->Close();
+ delete file;
+ return kTRUE;
+
+} // end of Bool_t AliFlowOnTheFlyParallelDriver::RunWorker(Int_t iWorker, Long64_t nEvents, const char *fileName)
+
+//====================================================================================================================
+
+Bool_t AliFlowOnTheFlyParallelDriver::MergeAndFinish(const std::vector<TString> &fileNames)
+{
+ // Merge the output lists of the workers and get the results via GetOutputHistograms() and Finish().
+ // The merged lists are kept by the methods. If the output of a worker is missing, the results would
+ // silently miss its events: nothing is finished and kFALSE is returned.
+
+ Bool_t oldStatus = TH1::AddDirectoryStatus();
+ TH1::AddDirectory(kFALSE); // the histograms must survive the closing of the files
+
+ std::vector<TFile*> files;
+ Int_t nSkipped = 0;
+ for(UInt_t w=0;w<fileNames.size();w++)
+ {
+  TFile *file = TFile::Open(fileNames[w].Data(),"READ");
+  if(!file || file->IsZombie())
+  {
+   cout<<" WARNING (AliFlowOnTheFlyParallelDriver): cannot open "<<fileNames[w].Data()<<"."<<endl;
+   delete file;
+   nSkipped++;
+   continue;
+  }
+  files.push_back(file);
+ }
+ if(nSkipped > 0)
+ {
+  cout<<" WARNING (AliFlowOnTheFlyParallelDriver): "<<nSkipped<<" out of "<<fileNames.size()<<" worker outputs skipped, results not finished."<<endl;
+ }
+
+ Bool_t ok = (nSkipped == 0 && !files.empty());
+ for(UInt_t m=0;ok && m<fMethods.size();m++)
+ {
+  TList *merged = NULL;
+  TList others;
+  others.SetOwner(kTRUE);
+  Int_t nMissing = 0;
+  for(UInt_t f=0;f<files.size();f++)
+  {
+   TList *list = dynamic_cast<TList*>(files[f]->Get(fMethods[m]->GetName()));
+   if(!list){nMissing++; continue;}
+   if(!merged){merged = list;} else {others.Add(list);}
+  }
+  if(!merged)
+  {
+   cout<<" WARNING (AliFlowOnTheFlyParallelDriver): no output for method "<<fMethods[m]->GetName()<<"."<<endl;
+   continue;
+  }
+  if(nMissing > 0)
+  {
+   cout<<" WARNING (AliFlowOnTheFlyParallelDriver): no output for method "<<fMethods[m]->GetName()<<" in "<<nMissing<<" out of "<<files.size()<<" worker outputs, results not finished."<<endl;
+   delete merged;
+   ok = kFALSE;
+   continue;
+  }
+  if(others.GetEntries() > 0){merged->Merge(&others);}
+  fMethods[m]->GetOutputHistograms(merged);
+  fMethods[m]->Finish();
+ } // end of for(UInt_t m=0;ok && m<fMethods.size();m++)
+
+ for(UInt_t f=0;f<files.size();f++){files[f]->Close(); delete files[f];}
+ TH1::AddDirectory(oldStatus);
+ return ok;
+
+} // end of Bool_t AliFlowOnTheFlyParallelDriver::MergeAndFinish(const std::vector<TString> &fileNames)
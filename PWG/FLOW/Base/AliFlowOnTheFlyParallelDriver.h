@@ -0,0 +1,111 @@
+/*
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.
+ * See cxx source for full Copyright notice
+ * $Id$
+ */
+
+/************************************************
+ * Generate events 'on the fly' and analyze     *
+ * them with the flow analysis methods in N     *
+ * independent workers. Each worker has its own *
+ * copy of the event maker and of the methods   *
+ * (and its own random generator), nothing is   *
+ * shared nor locked during the event loop.     *
+ * The output lists of the workers are merged   *
+ * and the results are obtained with the usual  *
+ * GetOutputHistograms() + Finish() path, as    *
+ * for the merged output of a grid analysis.    *
+ *                                              *
+ * Usage (e.g. in runFlowAnalysisOnTheFly.C):   *
+ *  AliFlowOnTheFlyParallelDriver d(maker,      *
+ *                           cutsRP,cutsPOI);   *
+ *  AliFlowAnalysisWithQCumulants *qc = ...;    *
+ *  // configure qc, but do not call Init()     *
+ *  d.AddMethod(qc,"QC");                       *
+ *  d.Run(nEvts,nWorkers);                      *
+ *  qc->WriteHistograms(dir);                   *
+ ************************************************/
+
+#ifndef ALIFLOWONTHEFLYPARALLELDRIVER_H
+#define ALIFLOWONTHEFLYPARALLELDRIVER_H
+
+#include <vector>
+#include "TString.h"
+#include "TList.h"
+
+class AliFlowEventSimple;
+class AliFlowEventSimpleMakerOnTheFly;
+class AliFlowTrackSimpleCuts;
+class AliFlowAnalysisWithLYZEventPlane;
+class AliFlowLYZEventPlane;
+
+class AliFlowOnTheFlyParallelDriver{
+ public:
+  // Interface to a flow analysis method, see MethodT below for the methods
+  // providing the standard Init(), Make(), GetHistList(), GetOutputHistograms() and Finish().
+  class Method{
+   public:
+    Method(const char *name) : fName(name) {}
+    virtual ~Method() {}
+    const char* GetName() const {return fName.Data();}
+    virtual void Init() = 0;
+    virtual void Make(AliFlowEventSimple *anEvent) = 0;
+    virtual TList* GetHistList() const = 0;
+    virtual void GetOutputHistograms(TList *outputListHistos) = 0;
+    virtual void Finish() = 0;
+   private:
+    TString fName; // name of the method, key of its output in the worker files
+  };
+
+  template <class T> class MethodT : public Method{
+   public:
+    MethodT(T *method, const char *name) : Method(name), fMethod(method) {}
+    virtual void Init() {fMethod->Init();}
+    virtual void Make(AliFlowEventSimple *anEvent) {fMethod->Make(anEvent);}
+    virtual TList* GetHistList() const {return fMethod->GetHistList();}
+    virtual void GetOutputHistograms(TList *outputListHistos) {fMethod->GetOutputHistograms(outputListHistos);}
+    virtual void Finish() {fMethod->Finish();}
+   private:
+    MethodT(const MethodT& m);
+    MethodT& operator=(const MethodT& m);
+    T *fMethod; // analysis method (not owned)
+  };
+
+  AliFlowOnTheFlyParallelDriver(AliFlowEventSimpleMakerOnTheFly *eventMaker, AliFlowTrackSimpleCuts const *cutsRP, AliFlowTrackSimpleCuts const *cutsPOI);
+  virtual ~AliFlowOnTheFlyParallelDriver();
+
+  // Add a method, configured but not initialized. The driver initializes the copy of each worker.
+  template <class T> void AddMethod(T *method, const char *name) {fMethods.push_back(new MethodT<T>(method,name));}
+  void AddMethod(Method *method) {fMethods.push_back(method);} // adopted
+  // Lee-Yang Zeros event plane, whose Make() also takes the event plane (both are initialized by the driver)
+  void AddMethod(AliFlowAnalysisWithLYZEventPlane *lyzep, AliFlowLYZEventPlane *ep, const char *name);
+  Int_t GetNMethods() const {return (Int_t)fMethods.size();}
+
+  // Seed of the first worker, worker i uses seed+i. If 0, each worker is seeded uniquely via TUUID.
+  void SetSeed(UInt_t uiSeed) {this->fSeed = uiSeed;}
+  UInt_t GetSeed() const {return this->fSeed;}
+  // Directory for the output of the workers, the system temporary directory by default.
+  void SetWorkDir(const char *dir) {this->fWorkDir = dir;}
+  const char* GetWorkDir() const {return this->fWorkDir.Data();}
+
+  Bool_t Run(Long64_t nEvents, Int_t nWorkers);
+
+ private:
+  AliFlowOnTheFlyParallelDriver(const AliFlowOnTheFlyParallelDriver& d);
+  AliFlowOnTheFlyParallelDriver& operator=(const AliFlowOnTheFlyParallelDriver& d);
+
+  void ProcessEvents(Long64_t nEvents);
+  Bool_t RunWorker(Int_t iWorker, Long64_t nEvents, const char *fileName);
+  Bool_t MergeAndFinish(const std::vector<TString> &fileNames);
+
+  AliFlowEventSimpleMakerOnTheFly *fEventMaker; // event maker, configured and initialized (not owned)
+  AliFlowTrackSimpleCuts const *fCutsRP;        // RP cuts (not owned)
+  AliFlowTrackSimpleCuts const *fCutsPOI;       // POI cuts (not owned)
+  std::vector<Method*> fMethods;                // analysis methods (owned)
+  UInt_t fSeed;                                 // seed of the first worker
+  TString fWorkDir;                             // directory for the output of the workers
+
+  ClassDef(AliFlowOnTheFlyParallelDriver,0) // parallel on the fly flow analysis
+};
+
+#endif
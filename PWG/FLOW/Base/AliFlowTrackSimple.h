@@ -123,6 +123,7 @@ public:
 
   const TBits* GetPOItype() const {return &fPOItype;}
   const TBits* GetFlowBits() const {return GetPOItype();}
+  const TBits* GetSubEventBits() const {return &fSubEventBits;}
 
   void  SetID(Int_t i) {fID=i;}
   Int_t GetID() const {return fID;}
@@ -22,6 +22,7 @@
 #pragma link C++ class AliFlowEventSimpleCuts+;
 
 #pragma link C++ class AliFlowEventSimpleMakerOnTheFly+;
+#pragma link C++ class AliFlowOnTheFlyParallelDriver+;
 
 #pragma link C++ class AliFlowCommonHist+;
 #pragma link C++ class AliFlowCommonHistResults+;
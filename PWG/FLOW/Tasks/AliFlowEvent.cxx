@@ -832,6 +832,8 @@ void AliFlowEvent::FindDaughters(Bool_t keepDaughtersInRPselection)
   //each flow track holds it's esd track index as well as its daughters esd index.
   //fill the array of daughters for every track with the pointers to flow tracks
   //to associate the mothers with daughters directly
+  //the RP selection of the daughters changes, the packed tracks are refilled
+  fTrackArraysFilled = kFALSE;
   for (Int_t iTrack=0; iTrack<fMothersCollection->GetEntriesFast(); iTrack++)
   {
     AliFlowTrack* mother = static_cast<AliFlowTrack*>(fMothersCollection->At(iTrack));
@@ -1029,6 +1031,7 @@ void AliFlowEvent::InsertTrack(AliFlowTrack *track) {
 AliFlowTrack* AliFlowEvent::ReuseTrack(Int_t i)
 {
   //try to reuse an existing track, if empty, make new one
+  fTrackArraysFilled = kFALSE;
   AliFlowTrack* pTrack = static_cast<AliFlowTrack*>(fTrackCollection->At(i));
   if (pTrack)
   {
@@ -67,6 +67,8 @@ AliJetContainer::AliJetContainer():
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
+  // jet selection depends on rho, tags and constituents updated within the event
+  SetUseAcceptanceCache(kFALSE);
 }
 
 /**
@@ -108,6 +110,8 @@ AliJetContainer::AliJetContainer(const char *name):
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
+  // jet selection depends on rho, tags and constituents updated within the event
+  SetUseAcceptanceCache(kFALSE);
   SetMinPt(1);
 }
 
@@ -158,6 +162,8 @@ AliJetContainer::AliJetContainer(EJetType_t jetType, EJetAlgo_t jetAlgo, ERecoSc
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
+  // jet selection depends on rho, tags and constituents updated within the event
+  SetUseAcceptanceCache(kFALSE);
   SetMinPt(1);
 }
 
@@ -0,0 +1,266 @@
+#ifndef ALIDPHISTARPAIRCUT_H
+#define ALIDPHISTARPAIRCUT_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Two-track efficiency (dphi*) pair cut, header only
+//
+//     dphi* is the azimuthal distance of the two tracks of a pair at a
+//     radius r in the TPC:
+//       dphi* = phi1 - phi2 - q1 B asin(0.075 r/pt1) + q2 B asin(0.075 r/pt2)
+//     folded into [-pi, pi]. The cut developed by the HBT group (and used
+//     e.g. in AliUEHistograms, AliBalancePsi, AliTwoParticlePIDCorr) looks
+//     for the minimum |dphi*| in the range [minRadius, 2.5] m, in steps of
+//     1 cm, for the pairs close in eta.
+//
+//     The bending term only depends on the track and on the radius. It is
+//     computed once per track of a block and reused for all its pairs, the
+//     pair loop is a branch-free subtraction and fold over a contiguous
+//     array of radii. Tracks are stored as structure of arrays (phi, pt,
+//     charge, eta) and the terms are computed lazily, so that tracks never
+//     paired in eta do not cost anything.
+//
+//     The values and the order of the operations are the same as in the
+//     scalar GetDPhiStar() / radius scan of the analysis classes, such that
+//     they can adopt it without changing their results.
+//
+//     Usage:
+//       AliDPhiStarPairCut cut(0.02);              // cut value, minimum radius 0.8 m
+//       AliDPhiStarPairCut::TrackBlock trig, assoc;
+//       cut.Fill(trig, n, phi, pt, charge, eta, bSign);
+//       cut.EvaluateRow(trig, i, assoc, out);      // minimum dphi* of trigger i with all associated
+//       if (out.IsRejected(j, cut.GetCutValue()) ...
+//-------------------------------------------------------------------------
+
+#include <vector>
+#include <TMath.h>
+
+class AliDPhiStarPairCut
+{
+ public:
+  // Tracks of one side of the pairs, structure of arrays
+  class TrackBlock {
+   public:
+    TrackBlock() : fPhi(), fPt(), fCharge(), fEta(), fBSign(0), fNRadii(0), fBend(), fState() {}
+
+    Int_t   GetN()             const { return fPhi.size(); }
+    Float_t GetPhi(Int_t i)    const { return fPhi[i];     }
+    Float_t GetPt(Int_t i)     const { return fPt[i];      }
+    Float_t GetCharge(Int_t i) const { return fCharge[i];  }
+    Float_t GetEta(Int_t i)    const { return fEta[i];     }
+
+   private:
+    friend class AliDPhiStarPairCut;
+
+    std::vector<Float_t>  fPhi;     // azimuthal angle (rad)
+    std::vector<Float_t>  fPt;      // transverse momentum (GeV/c)
+    std::vector<Float_t>  fCharge;  // charge
+    std::vector<Float_t>  fEta;     // pseudorapidity
+    Float_t               fBSign;   // sign of the magnetic field
+    Int_t                 fNRadii;  // bending terms per track
+    std::vector<Double_t> fBend;    // bending terms, track major: [track*fNRadii + radius]
+    std::vector<UChar_t>  fState;   // bending terms computed for the track: 0 none, 1 boundaries, 2 all
+  };
+
+  // Per pair output of the evaluation of a trigger with a block of associated tracks
+  class PairResult {
+   public:
+    enum EStatus { kSkipped = 0, kOutsideEta, kBoundaries, kScanned };
+
+    PairResult() : fStatus(), fDEta(), fDPhiStarMin(), fDPhiStarMinAbs() {}
+
+    Int_t   GetN()                        const { return fStatus.size();     }
+    Int_t   GetStatus(Int_t j)            const { return fStatus[j];         }
+    Float_t GetDEta(Int_t j)              const { return fDEta[j];           }
+    Float_t GetDPhiStarMin(Int_t j)       const { return fDPhiStarMin[j];    }
+    Float_t GetDPhiStarMinAbs(Int_t j)    const { return fDPhiStarMinAbs[j]; }
+    // the minimum was searched, i.e. the pair was close at one of the boundaries or crossed in between
+    Bool_t  IsScanned(Int_t j)            const { return fStatus[j] == kScanned; }
+    // the pair is removed by the cut
+    Bool_t  IsRejected(Int_t j, Double_t cutValue) const
+      { return fStatus[j] == kScanned && fDPhiStarMinAbs[j] < cutValue && TMath::Abs(fDEta[j]) < cutValue; }
+
+   private:
+    friend class AliDPhiStarPairCut;
+
+    std::vector<UChar_t> fStatus;         // EStatus of the pair
+    std::vector<Float_t> fDEta;           // eta(trigger) - eta(associated)
+    std::vector<Float_t> fDPhiStarMin;    // dphi* at the minimum, 1e5 if not scanned
+    std::vector<Float_t> fDPhiStarMinAbs; // minimum |dphi*|, 1e5 if not scanned
+  };
+
+  AliDPhiStarPairCut(Double_t cutValue = 0.02, Double_t minRadius = 0.8) :
+    fCutValue(cutValue), fMinRadius(minRadius), fRadii() { SetRadii(); }
+
+  Double_t GetCutValue()  const { return fCutValue;  }
+  Double_t GetMinRadius() const { return fMinRadius; }
+  void     SetCutValue(Double_t cutValue)   { fCutValue = cutValue; }
+  void     SetMinRadius(Double_t minRadius) { fMinRadius = minRadius; SetRadii(); }
+
+  // dphi* of a pair at the given radius, same as the scalar copies in the analysis classes
+  static Float_t DPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign)
+  {
+    Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
+    return Fold(dphistar);
+  }
+
+  // circularity
+  static Float_t Fold(Float_t dphistar)
+  {
+    static const Double_t kPi = TMath::Pi();
+    if (dphistar > kPi)
+      dphistar = kPi * 2 - dphistar;
+    if (dphistar < -kPi)
+      dphistar = -kPi * 2 - dphistar;
+    if (dphistar > kPi) // might look funny but is needed
+      dphistar = kPi * 2 - dphistar;
+    return dphistar;
+  }
+
+  // Fills the block with n tracks, the bending terms are computed on demand
+  void Fill(TrackBlock &block, Int_t n, const Float_t *phi, const Float_t *pt, const Float_t *charge, const Float_t *eta, Float_t bSign) const
+  {
+    block.fPhi.assign(phi, phi + n);
+    block.fPt.assign(pt, pt + n);
+    block.fCharge.assign(charge, charge + n);
+    block.fEta.assign(eta, eta + n);
+    Reset(block, bSign);
+  }
+
+  // Same, adding the tracks one by one with Add() after Clear()
+  void Clear(TrackBlock &block, Float_t bSign) const
+  {
+    block.fPhi.clear();
+    block.fPt.clear();
+    block.fCharge.clear();
+    block.fEta.clear();
+    Reset(block, bSign);
+  }
+  void Add(TrackBlock &block, Float_t phi, Float_t pt, Float_t charge, Float_t eta) const
+  {
+    block.fPhi.push_back(phi);
+    block.fPt.push_back(pt);
+    block.fCharge.push_back(charge);
+    block.fEta.push_back(eta);
+    block.fState.push_back(0);
+    block.fBend.resize(block.fBend.size() + block.fNRadii);
+  }
+
+  // Minimum dphi* of the pair (i, j), as the radius scan of the analysis classes.
+  // Returns kFALSE if the minimum was not searched (no crossing nor close
+  // approach at the boundaries), dphistarmin and dphistarminabs are then 1e5.
+  Bool_t MinDPhiStar(TrackBlock &trig, Int_t i, TrackBlock &assoc, Int_t j, Float_t &dphistarmin, Float_t &dphistarminabs) const
+  {
+    dphistarmin    = 1e5;
+    dphistarminabs = 1e5;
+    const Float_t kLimit = fCutValue * 3;
+    const Float_t dphi = trig.fPhi[i] - assoc.fPhi[j];
+
+    // check first boundaries to see if is worth to loop and find the minimum
+    const Double_t *bend1 = Bend(trig, i, 1);
+    const Double_t *bend2 = Bend(assoc, j, 1);
+    Float_t dphistar1 = Fold(dphi - bend1[0] + bend2[0]);
+    Float_t dphistar2 = Fold(dphi - bend1[1] + bend2[1]);
+    if (!(TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0))
+      return kFALSE;
+
+    bend1 = Bend(trig, i, 2) + 2;
+    bend2 = Bend(assoc, j, 2) + 2;
+    const Int_t nRadii = fRadii.size() - 2;
+    for (Int_t k = 0; k < nRadii; k++) {
+      Float_t dphistar = Fold(dphi - bend1[k] + bend2[k]);
+      Float_t dphistarabs = TMath::Abs(dphistar);
+      if (dphistarabs < dphistarminabs) {
+        dphistarmin = dphistar;
+        dphistarminabs = dphistarabs;
+      }
+    }
+    return kTRUE;
+  }
+
+  // Evaluates trigger i with all the associated tracks of the block.
+  // Pairs with |deta| >= 7.5 cut value are not evaluated (kOutsideEta).
+  // chargeProduct > 0 (< 0) restricts to like (unlike) sign pairs, the
+  // other ones and the pairs with the same index if skipSameIndex (same
+  // block, no auto correlations) are kSkipped.
+  void EvaluateRow(TrackBlock &trig, Int_t i, TrackBlock &assoc, PairResult &out, Int_t chargeProduct = 0, Bool_t skipSameIndex = kFALSE) const
+  {
+    const Int_t n = assoc.GetN();
+    out.fStatus.assign(n, PairResult::kSkipped);
+    out.fDEta.resize(n);
+    out.fDPhiStarMin.assign(n, 1e5);
+    out.fDPhiStarMinAbs.assign(n, 1e5);
+
+    const Float_t eta1 = trig.fEta[i];
+    const Float_t charge1 = trig.fCharge[i];
+    const Double_t etaWindow = fCutValue * 2.5 * 3;
+
+    // eta early-out, vectorizable
+    for (Int_t j = 0; j < n; j++)
+      out.fDEta[j] = eta1 - assoc.fEta[j];
+
+    for (Int_t j = 0; j < n; j++) {
+      if (skipSameIndex && j == i) continue;
+      if (chargeProduct > 0 && !(charge1 * assoc.fCharge[j] > 0)) continue;
+      if (chargeProduct < 0 && !(charge1 * assoc.fCharge[j] < 0)) continue;
+      if (!(TMath::Abs(out.fDEta[j]) < etaWindow)) {
+        out.fStatus[j] = PairResult::kOutsideEta;
+        continue;
+      }
+      Bool_t scanned = MinDPhiStar(trig, i, assoc, j, out.fDPhiStarMin[j], out.fDPhiStarMinAbs[j]);
+      out.fStatus[j] = scanned ? PairResult::kScanned : PairResult::kBoundaries;
+    }
+  }
+
+  // Evaluates all the trigger x associated pairs, out[i] for trigger i
+  void Evaluate(TrackBlock &trig, TrackBlock &assoc, std::vector<PairResult> &out, Int_t chargeProduct = 0, Bool_t skipSameIndex = kFALSE) const
+  {
+    out.resize(trig.GetN());
+    for (Int_t i = 0; i < trig.GetN(); i++)
+      EvaluateRow(trig, i, assoc, out[i], chargeProduct, skipSameIndex);
+  }
+
+ private:
+  void SetRadii()
+  {
+    // boundaries first, then the scanned radii, as in the analysis classes
+    fRadii.clear();
+    fRadii.push_back(fMinRadius);
+    fRadii.push_back(2.5);
+    for (Double_t rad = fMinRadius; rad < 2.51; rad += 0.01)
+      fRadii.push_back(rad);
+  }
+
+  void Reset(TrackBlock &block, Float_t bSign) const
+  {
+    block.fBSign  = bSign;
+    block.fNRadii = fRadii.size();
+    block.fState.assign(block.fPhi.size(), 0);
+    block.fBend.resize(block.fPhi.size() * block.fNRadii);
+  }
+
+  // Bending terms of track i, computed up to the boundaries (state 1) or for all the radii (state 2)
+  const Double_t *Bend(TrackBlock &block, Int_t i, UChar_t state) const
+  {
+    Double_t *bend = &block.fBend[i * block.fNRadii];
+    if (block.fState[i] < state) {
+      const Float_t chargeBSign = block.fCharge[i] * block.fBSign;
+      const Float_t pt = block.fPt[i];
+      Int_t first = (block.fState[i] == 0) ? 0 : 2;
+      Int_t last  = (state == 1) ? 2 : block.fNRadii;
+      for (Int_t k = first; k < last; k++) {
+        const Float_t radius = fRadii[k];
+        bend[k] = chargeBSign * TMath::ASin(0.075 * radius / pt);
+      }
+      block.fState[i] = state;
+    }
+    return bend;
+  }
+
+  Double_t fCutValue;              // cut on the minimum |dphi*| and |deta|
+  Double_t fMinRadius;             // lowest radius of the scan (m)
+  std::vector<Double_t> fRadii;    // boundaries, then scanned radii (m)
+};
+
+#endif
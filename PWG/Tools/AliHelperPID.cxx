@@ -32,6 +32,7 @@
 #include "AliAODMCParticle.h" 
 #include "AliPIDResponse.h"   
 #include "AliPIDCombined.h"   
+#include "AliPIDResponseCache.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
@@ -314,10 +315,12 @@ void AliHelperPID::CalculateNSigmas(AliVTrack * trk, Bool_t FIllQAHistos){
   
   // Compute nsigma for each hypthesis
   AliVParticle *inEvHMain = dynamic_cast<AliVParticle *>(trk);
+  // values are shared with the other PID helpers of the train through the per-event cache
+  AliPIDResponseCache *pidCache = AliPIDResponseCache::Instance();
   // --- TPC
-  Double_t nsigmaTPCkProton = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kProton);
-  Double_t nsigmaTPCkKaon   = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kKaon); 
-  Double_t nsigmaTPCkPion   = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kPion); 
+  Double_t nsigmaTPCkProton = pidCache->NumberOfSigmasTPC(fPIDResponse, inEvHMain, AliPID::kProton);
+  Double_t nsigmaTPCkKaon   = pidCache->NumberOfSigmasTPC(fPIDResponse, inEvHMain, AliPID::kKaon); 
+  Double_t nsigmaTPCkPion   = pidCache->NumberOfSigmasTPC(fPIDResponse, inEvHMain, AliPID::kPion); 
   // --- TOF
   Double_t nsigmaTOFkProton=999.,nsigmaTOFkKaon=999.,nsigmaTOFkPion=999.;
   Double_t nsigmaTPCTOFkProton=999.,nsigmaTPCTOFkKaon=999.,nsigmaTPCTOFkPion=999.;
@@ -325,9 +328,9 @@ void AliHelperPID::CalculateNSigmas(AliVTrack * trk, Bool_t FIllQAHistos){
   CheckTOF(trk);
   
   if(fHasTOFPID && trk->Pt()>fPtTOFPID){//use TOF information
-    nsigmaTOFkProton = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kProton);
-    nsigmaTOFkKaon   = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kKaon); 
-    nsigmaTOFkPion   = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kPion); 
+    nsigmaTOFkProton = pidCache->NumberOfSigmasTOF(fPIDResponse, inEvHMain, AliPID::kProton);
+    nsigmaTOFkKaon   = pidCache->NumberOfSigmasTOF(fPIDResponse, inEvHMain, AliPID::kKaon); 
+    nsigmaTOFkPion   = pidCache->NumberOfSigmasTOF(fPIDResponse, inEvHMain, AliPID::kPion); 
     Double_t d2Proton=nsigmaTPCkProton * nsigmaTPCkProton + nsigmaTOFkProton * nsigmaTOFkProton;
     Double_t d2Kaon=nsigmaTPCkKaon * nsigmaTPCkKaon + nsigmaTOFkKaon * nsigmaTOFkKaon;
     Double_t d2Pion=nsigmaTPCkPion * nsigmaTPCkPion + nsigmaTOFkPion * nsigmaTOFkPion;
@@ -604,7 +607,7 @@ void AliHelperPID::CheckTOF(AliVTrack * trk)
   //check if the particle has TOF Matching
   
   //get the PIDResponse
-  if(fPIDResponse->CheckPIDStatus(AliPIDResponse::kTOF,trk)==0)fHasTOFPID=kFALSE;
+  if(AliPIDResponseCache::Instance()->CheckPIDStatus(fPIDResponse,AliPIDResponse::kTOF,trk)==0)fHasTOFPID=kFALSE;
   else fHasTOFPID=kTRUE;
   
   //in addition to TOF status we look at the pt
@@ -0,0 +1,187 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//     Process-wide, per-event cache of the AliPIDResponse output
+//     See header for the usage
+//-------------------------------------------------------------------------
+
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+#include "AliAnalysisManager.h"
+#include "AliPIDResponseCache.h"
+#include "AliLog.h"
+
+ClassImp(AliPIDResponseCache);
+
+//______________________________________________________________________________
+AliPIDResponseCache* AliPIDResponseCache::Instance()
+{
+  // Returns the cache shared by all tasks in the process
+  static AliPIDResponseCache instance;
+  return &instance;
+}
+
+//______________________________________________________________________________
+AliPIDResponseCache::AliPIDResponseCache() :
+  TObject(),
+  fEnabled(kTRUE),
+  fSlots(),
+  fRows(),
+  fNRows(0),
+  fEpoch(0),
+  fResponse(0),
+  fEvent(0),
+  fRun(-1),
+  fEntry(-1),
+  fNTracks(-1),
+  fNHits(0),
+  fNMisses(0)
+{
+  // Default constructor, use Instance()
+}
+
+//______________________________________________________________________________
+AliPIDResponseCache::~AliPIDResponseCache()
+{
+  // Destructor
+}
+
+//______________________________________________________________________________
+void AliPIDResponseCache::Reset()
+{
+  // Drops all cached values and releases the memory
+  std::vector<TrackSlot_t>().swap(fSlots);
+  std::vector<TrackRow_t>().swap(fRows);
+  fNRows    = 0;
+  fEpoch    = 0;
+  fResponse = 0;
+  fEvent    = 0;
+  fRun      = -1;
+  fEntry    = -1;
+  fNTracks  = -1;
+}
+
+//______________________________________________________________________________
+AliPIDResponseCache::TrackRow_t* AliPIDResponseCache::GetRow(AliPIDResponse *pid, const AliVParticle *track)
+{
+  // Returns the row of the track for the current event, 0 if the request
+  // cannot be served from the cache.
+  // The analysis manager processes events sequentially, no locking is needed.
+  if (!fEnabled || !pid || !track) return 0;
+  const AliVEvent *event = pid->GetCurrentEvent();
+  if (!event) return 0;
+
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if (event != fEvent || entry != fEntry || event->GetRunNumber() != fRun ||
+      event->GetNumberOfTracks() != fNTracks) {
+    // new event, the first response asking owns the cached values
+    fEvent    = event;
+    fEntry    = entry;
+    fRun      = event->GetRunNumber();
+    fNTracks  = event->GetNumberOfTracks();
+    fResponse = pid;
+    fNRows    = 0;
+    // keep the memory of the previous events unless it is far above what this one can use
+    size_t maxSlots = 4*(size_t)(fNTracks+1)+64;
+    if (fSlots.size() > 4*maxSlots) std::vector<TrackSlot_t>().swap(fSlots);
+    if (fRows.size() > 2*maxSlots)  std::vector<TrackRow_t>().swap(fRows);
+    if (++fEpoch == 0) {
+      // stamp wrapped around, invalidate explicitly
+      for (size_t i = 0; i < fSlots.size(); i++) fSlots[i].fEpoch = 0;
+      fEpoch = 1;
+    }
+  }
+  if (pid != fResponse) return 0;
+
+  const AliVTrack *vtrack = dynamic_cast<const AliVTrack*>(track);
+  if (!vtrack) return 0;
+  // negative IDs (TPC-only constrained AOD tracks) are interleaved with the positive ones
+  Int_t id = vtrack->GetID();
+  UInt_t index = (id >= 0) ? 2*(UInt_t)id : 2*(UInt_t)(-(id+1))+1;
+  if (index >= fSlots.size()) {
+    if (index >= 4*(UInt_t)(fNTracks+1)+64) return 0;  // protect against inconsistent IDs
+    TrackSlot_t empty = {0, -1};
+    fSlots.resize(index+1, empty);
+  }
+
+  TrackSlot_t &slot = fSlots[index];
+  if (slot.fEpoch != fEpoch) {
+    if (fNRows == (Int_t)fRows.size()) fRows.resize(fNRows+1);
+    slot.fEpoch = fEpoch;
+    slot.fRow   = fNRows++;
+    TrackRow_t &row = fRows[slot.fRow];
+    row.fTrack = track;
+    for (Int_t idet = 0; idet < kNDetectors; idet++) {
+      row.fNSigmaMask[idet] = 0;
+      row.fStatus[idet]     = -1;
+    }
+    return &row;
+  }
+  TrackRow_t &row = fRows[slot.fRow];
+  if (row.fTrack != track) return 0;
+  return &row;
+}
+
+//______________________________________________________________________________
+Float_t AliPIDResponseCache::NumberOfSigmas(AliPIDResponse *pid, AliPIDResponse::EDetector detector,
+                                            const AliVParticle *track, AliPID::EParticleType type)
+{
+  // Number of sigmas of the track for the given species and detector
+  TrackRow_t *row = GetRow(pid, track);
+  if (!row || detector < 0 || detector >= kNDetectors || type < 0 || type >= kNSpecies) {
+    fNMisses++;
+    return pid->NumberOfSigmas(detector, track, type);
+  }
+  UShort_t bit = 1 << type;
+  if (row->fNSigmaMask[detector] & bit) {
+    fNHits++;
+    return row->fNSigma[detector][type];
+  }
+  fNMisses++;
+  row->fNSigma[detector][type] = pid->NumberOfSigmas(detector, track, type);
+  row->fNSigmaMask[detector] |= bit;
+  return row->fNSigma[detector][type];
+}
+
+//______________________________________________________________________________
+AliPIDResponse::EDetPidStatus AliPIDResponseCache::CheckPIDStatus(AliPIDResponse *pid, AliPIDResponse::EDetector detector,
+                                                                  const AliVTrack *track)
+{
+  // PID status of the track for the given detector
+  TrackRow_t *row = GetRow(pid, track);
+  if (!row || detector < 0 || detector >= kNDetectors) {
+    fNMisses++;
+    return pid->CheckPIDStatus(detector, track);
+  }
+  if (row->fStatus[detector] >= 0) {
+    fNHits++;
+    return (AliPIDResponse::EDetPidStatus)row->fStatus[detector];
+  }
+  fNMisses++;
+  AliPIDResponse::EDetPidStatus status = pid->CheckPIDStatus(detector, track);
+  row->fStatus[detector] = (Char_t)status;
+  return status;
+}
+
+//______________________________________________________________________________
+void AliPIDResponseCache::PrintStatistics() const
+{
+  // Prints the cache usage
+  Long64_t total = fNHits + fNMisses;
+  AliInfo(Form("PID response cache: %lld requests, %lld served from the cache (%.1f%%), %lld rows and %lld track slots allocated",
+               total, fNHits, total > 0 ? 100.*fNHits/total : 0., (Long64_t)fRows.size(), (Long64_t)fSlots.size()));
+}
@@ -0,0 +1,92 @@
+#ifndef ALIPIDRESPONSECACHE_H
+#define ALIPIDRESPONSECACHE_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Process-wide, per-event cache of the AliPIDResponse output
+//
+//     The number of sigmas and the PID status are computed once per
+//     (track, detector, species) and event, and are shared by all the PID
+//     helpers and cut classes of a train. Rows are only allocated for the
+//     tracks that are asked for, in the order of the requests, and a small
+//     table indexed by track ID points to them; both are recycled when the
+//     current event of the PID response changes, and shrunk when they grew
+//     much larger than the current event needs.
+//     Values are only cached for the track object that first filled the
+//     row and for the PID response used for the event, other requests
+//     (e.g. TPC-only constrained copies or a second response object) are
+//     passed through to AliPIDResponse.
+//
+//     Usage:
+//       AliPIDResponseCache *cache = AliPIDResponseCache::Instance();
+//       Float_t nsigma = cache->NumberOfSigmasTPC(fPIDResponse, track, AliPID::kKaon);
+//-------------------------------------------------------------------------
+
+#include <vector>
+#include <TObject.h>
+#include "AliPID.h"
+#include "AliPIDResponse.h"
+
+class AliVEvent;
+class AliVParticle;
+class AliVTrack;
+
+class AliPIDResponseCache : public TObject
+{
+ public:
+  static AliPIDResponseCache* Instance();
+  virtual ~AliPIDResponseCache();
+
+  Float_t NumberOfSigmas(AliPIDResponse *pid, AliPIDResponse::EDetector detector, const AliVParticle *track, AliPID::EParticleType type);
+  Float_t NumberOfSigmasITS(AliPIDResponse *pid, const AliVParticle *track, AliPID::EParticleType type) { return NumberOfSigmas(pid, AliPIDResponse::kITS, track, type); }
+  Float_t NumberOfSigmasTPC(AliPIDResponse *pid, const AliVParticle *track, AliPID::EParticleType type) { return NumberOfSigmas(pid, AliPIDResponse::kTPC, track, type); }
+  Float_t NumberOfSigmasTOF(AliPIDResponse *pid, const AliVParticle *track, AliPID::EParticleType type) { return NumberOfSigmas(pid, AliPIDResponse::kTOF, track, type); }
+
+  AliPIDResponse::EDetPidStatus CheckPIDStatus(AliPIDResponse *pid, AliPIDResponse::EDetector detector, const AliVTrack *track);
+
+  void     SetEnabled(Bool_t enabled=kTRUE) { fEnabled = enabled; Reset(); }
+  Bool_t   IsEnabled()   const { return fEnabled; }
+  void     Reset();
+
+  Long64_t GetNHits()    const { return fNHits;   }
+  Long64_t GetNMisses()  const { return fNMisses; }
+  void     PrintStatistics() const;
+
+ private:
+  enum { kNSpecies = AliPID::kSPECIESC, kNDetectors = AliPIDResponse::kNdetectors };
+
+  struct TrackRow_t {
+    const AliVParticle *fTrack;                         // track object the row was filled with
+    UShort_t            fNSigmaMask[kNDetectors];       // species with cached number of sigmas
+    Char_t              fStatus[kNDetectors];           // PID status, -1 if not cached
+    Float_t             fNSigma[kNDetectors][kNSpecies];// number of sigmas
+  };
+  struct TrackSlot_t {
+    UInt_t              fEpoch;                         // event the slot is valid for
+    Int_t               fRow;                           // index of the track row in fRows
+  };
+
+  AliPIDResponseCache();
+  AliPIDResponseCache(const AliPIDResponseCache& cache);
+  AliPIDResponseCache& operator=(const AliPIDResponseCache& cache);
+
+  TrackRow_t* GetRow(AliPIDResponse *pid, const AliVParticle *track);
+
+  Bool_t                  fEnabled;    //  use the cache, pass through to AliPIDResponse otherwise
+  std::vector<TrackSlot_t> fSlots;     //! track ID -> row of the current event
+  std::vector<TrackRow_t> fRows;       //! cached values, in the order of the first request
+  Int_t                   fNRows;      //! rows used in the current event
+  UInt_t                  fEpoch;      //! current event stamp of the slots
+  const AliPIDResponse   *fResponse;   //! PID response the current event is cached for
+  const AliVEvent        *fEvent;      //! current event of fResponse
+  Int_t                   fRun;        //! run number of fEvent
+  Long64_t                fEntry;      //! entry of the analysis manager for fEvent
+  Int_t                   fNTracks;    //! number of tracks of fEvent
+  Long64_t                fNHits;      //! values served from the cache
+  Long64_t                fNMisses;    //! values computed by AliPIDResponse
+
+  ClassDef(AliPIDResponseCache, 0);
+};
+
+#endif
@@ -42,14 +42,16 @@ ClassImp(THistManager)
 THistManager::THistManager():
 		TNamed(),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fLookupTable()
 {
 }
 
 THistManager::THistManager(const char *name):
 		TNamed(name, Form("Histogram container %s", name)),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fLookupTable()
 {
 	fHistos = new THashList();
 	fHistos->SetName(Form("histos%s", name));
@@ -409,15 +411,9 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
+	TH1 *hist = dynamic_cast<TH1 *>(FindHistogram(name, "THistManager::FillTH1"));
 	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH1", "Histogram %s is not of type TH1", name);
 		return;
 	}
 	TString optionstring(opt);
@@ -432,15 +428,9 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
+  TH1 *hist = dynamic_cast<TH1 *>(FindHistogram(name, "THistManager::FillTH1"));
   if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+    Fatal("THistManager::FillTH1", "Histogram %s is not of type TH1", name);
     return;
   }
 	TString optionstring(opt);
@@ -456,15 +446,9 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name, "THistManager::FillTH2"));
 	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH2", "Histogram %s is not of type TH2", name);
 		return;
 	}
 	TString optstring(opt);
@@ -481,15 +465,9 @@ void THistManager::FillTH2(const char *name, double x, double y, double weight,
 }
 
 void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name, "THistManager::FillTH2"));
 	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH2", "Histogram %s is not of type TH2", name);
 		return;
 	}
 	TString optstring(opt);
@@ -506,15 +484,9 @@ void THistManager::FillTH2(const char *name, double *point, double weight, Optio
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
+  TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name, "THistManager::FillTH2"));
   if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+    Fatal("THistManager::FillTH2", "Histogram %s is not of type TH2", name);
     return;
   }
   TString optstring(opt);
@@ -531,15 +503,9 @@ void THistManager::FillTH2(const char *name, const char *labelX, const char *lab
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
+	TH3 *hist = dynamic_cast<TH3 *>(FindHistogram(name, "THistManager::FillTH3"));
 	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH3", "Histogram %s is not of type TH3", name);
 		return;
 	}
 	TString optstring(opt);
@@ -560,15 +526,9 @@ void THistManager::FillTH3(const char* name, double x, double y, double z, doubl
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
+	TH3 *hist = dynamic_cast<TH3 *>(FindHistogram(name, "THistManager::FillTH3"));
 	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH3", "Histogram %s is not of type TH3", name);
 		return;
 	}
 	TString optstring(opt);
@@ -589,15 +549,9 @@ void THistManager::FillTH3(const char* name, const double* point, double weight,
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
+	THnSparseD *hist = dynamic_cast<THnSparseD *>(FindHistogram(name, "THistManager::FillTHnSparse"));
 	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTHnSparse", "Histogram %s is not of type THnSparseD", name);
 		return;
 	}
 	TString optstring(opt);
@@ -615,17 +569,15 @@ void THistManager::FillTHnSparse(const char *name, const double *x, double weigh
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
+  TProfile *hist = dynamic_cast<TProfile *>(FindHistogram(name, "THistManager::FillTProfile"));
   if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTProfile", "Histogram %s is not of type TProfile", name);
   hist->Fill(x, y, weight);
 }
 
 TObject *THistManager::FindObject(const char *name) const {
+	std::unordered_map<std::string, TObject *>::const_iterator found = fLookupTable.find(name);
+	if(found != fLookupTable.end()) return found->second;
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) return NULL;
@@ -647,6 +599,25 @@ THashList *THistManager::FindGroup(const char *dirname) const {
 	return nullptr;
 }
 
+TObject *THistManager::FindHistogram(const char *name, const char *caller) const {
+	std::unordered_map<std::string, TObject *>::const_iterator found = fLookupTable.find(name);
+	if(found != fLookupTable.end()) return found->second;
+	TString dirname(basename(name)), hname(histname(name));
+	THashList *parent(FindGroup(dirname));
+	if(!parent){
+		Fatal(caller, "Parent group %s does not exist", dirname.Data());
+		return nullptr;
+	}
+	TObject *hist = parent->FindObject(hname);
+	if(!hist){
+		Fatal(caller, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		return nullptr;
+	}
+	// histograms are never removed from the container, the entry stays valid
+	fLookupTable[name] = hist;
+	return hist;
+}
+
 TString THistManager::basename(const TString &path) const {
 	int index = path.Last('/');
 	if(index < 0) return "";  // no directory structure
@@ -1030,6 +1001,60 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandles(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Test1", "Test fill 1D histogram via handle", 1, 0., 1.);
+    testmgr.CreateTH2("Group1/Test2", "Test fill 2D histogram via handle", 1, 0., 1., 1, 0., 1.);
+    for(int icent = 0; icent < 3; icent++)
+      testmgr.CreateTH1(Form("Cent%d/Test1", icent), "Test fill 1D histogram via handle array", 1, 0., 1.);
+
+    THistManager::THistHandle<TH1> handle1 = testmgr.GetHandle<TH1>("Test1");
+    THistManager::THistHandle<TH2> handle2 = testmgr.GetHandle<TH2>("Group1/Test2");
+    THistManager::THistHandleArray<TH1> handlecent = testmgr.GetHandleArray<TH1>("Cent%d/Test1", 3);
+    for(int i = 0; i < 100; i++){
+      handle1.Fill(0.5);
+      handle2.Fill(0.5, 0.5);
+      for(int icent = 0; icent < handlecent.GetSize(); icent++) handlecent[icent].Fill(0.5, icent + 1.);
+      // mixed with fill by name, served from the lookup table
+      testmgr.FillTH1("Test1", 0.5);
+    }
+
+    // Evaluate test
+    bool success(true);
+
+    TH1 *test1 = dynamic_cast<TH1 *>(testmgr.FindObject("Test1"));
+    if(!test1 || test1 != handle1.Get()){
+      std::cout << "Test1: Handle does not point to the histogram in the container" << std::endl;
+      success = false;
+    } else if(TMath::Abs(test1->GetBinContent(1) - 200) > DBL_EPSILON){
+      std::cout << "Test1: Mismatch in values, expected 200, found " << test1->GetBinContent(1) << std::endl;
+      success = false;
+    }
+
+    TH2 *test2 = dynamic_cast<TH2 *>(testmgr.FindObject("Group1/Test2"));
+    if(!test2 || test2 != handle2.Get()){
+      std::cout << "Group1/Test2: Handle does not point to the histogram in the container" << std::endl;
+      success = false;
+    } else if(TMath::Abs(test2->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test2: Mismatch in values, expected 100, found " << test2->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+
+    for(int icent = 0; icent < 3; icent++){
+      TH1 *testcent = dynamic_cast<TH1 *>(testmgr.FindObject(Form("Cent%d/Test1", icent)));
+      if(!testcent || testcent != handlecent[icent].Get()){
+        std::cout << "Cent" << icent << "/Test1: Handle does not point to the histogram in the container" << std::endl;
+        success = false;
+      } else if(TMath::Abs(testcent->GetBinContent(1) - 100. * (icent + 1)) > DBL_EPSILON){
+        std::cout << "Cent" << icent << "/Test1: Mismatch in values, expected " << 100 * (icent + 1) << ", found " << testcent->GetBinContent(1) << std::endl;
+        success = false;
+      }
+    }
+
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1075,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handles" << std::endl;
+    testresult += testsuite.TestFillHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1101,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandles();
+  }
 }
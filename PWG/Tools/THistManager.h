@@ -6,7 +6,11 @@
 #include <THashList.h>
 #include <TIterator.h>
 #include <TNamed.h>
+#include <TString.h>
 #include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class TArrayD;
 class TAxis;
@@ -95,6 +99,24 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * ## Filling via handles
+ *
+ * Histograms filled in track or jet loops should be accessed via handles. The
+ * handle is obtained once (i.e. in UserCreateOutputObjects or at the first event)
+ * and forwards the Fill directly to the histogram, without parsing the path and
+ * looking up the group. Handles for a set of histograms differing only by an index
+ * (i.e. one group per centrality class) can be obtained as handle array.
+ *
+ * ~~~{.cxx}
+ * THistManager::THistHandle<TH1> hpt = mgr.GetHandle<TH1>("hPt");
+ * THistManager::THistHandleArray<TH2> hcent = mgr.GetHandleArray<TH2>("Cent%d/hEtaPhi", 4);
+ * hpt.Fill(pt);
+ * hcent[centbin].Fill(eta, phi);
+ * ~~~
+ *
+ * Fills by name are routed through an internal path lookup table, so only the
+ * first fill of a histogram pays for the lookup in the group structure.
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +251,57 @@ public:
     iterator();
   };
 
+  /**
+   * @class THistHandle
+   * @brief Typed handle to a histogram inside the histogram manager
+   * @ingroup Histmanager
+   *
+   * Pointer to the histogram with inline Fill, obtained via GetHandle. The
+   * handle does not own the histogram, it is valid as long as the histogram
+   * manager is. Options for bin width correction are not supported, for those
+   * the Fill functions of the histogram manager need to be used.
+   */
+  template<class H>
+  class THistHandle {
+  public:
+    THistHandle(): fHist(nullptr) {}
+    explicit THistHandle(H *hist): fHist(hist) {}
+
+    /**
+     * @brief Fill the histogram, arguments are forwarded to H::Fill
+     */
+    template<typename... Args>
+    void Fill(Args... args) const { fHist->Fill(args...); }
+
+    H *Get() const { return fHist; }
+    H *operator->() const { return fHist; }
+    bool IsValid() const { return fHist != nullptr; }
+
+  private:
+    H                           *fHist;               ///< Underlying histogram (not owned)
+  };
+
+  /**
+   * @class THistHandleArray
+   * @brief Set of histogram handles indexed by an integer bin
+   * @ingroup Histmanager
+   *
+   * Obtained via GetHandleArray for histograms which only differ by
+   * an index in the path, i.e. one group per centrality class.
+   */
+  template<class H>
+  class THistHandleArray {
+  public:
+    THistHandleArray(): fHandles() {}
+
+    void Add(const THistHandle<H> &handle) { fHandles.push_back(handle); }
+    const THistHandle<H> &operator[](int index) const { return fHandles[index]; }
+    int GetSize() const { return fHandles.size(); }
+
+  private:
+    std::vector<THistHandle<H>>  fHandles;            ///< Handles, ordered by index
+  };
+
   /**
    * @brief Default constructor.
    *
@@ -634,6 +707,30 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Get a typed handle to a histogram within the container.
+   *
+   * The histogram name also contains the parent group(s) according
+   * to the common group notation. Fatal in case the histogram does not
+   * exist or is not of the requested type.
+   * @param[in] name Name of the histogram
+   * @return Handle to the histogram
+   */
+  template<class H>
+  THistHandle<H> GetHandle(const char *name) const;
+
+  /**
+   * @brief Get typed handles to a set of histograms differing by an index.
+   *
+   * The path is obtained by formatting the path pattern with the
+   * index, i.e. "Cent%d/hPt" for index 0 to n-1.
+   * @param[in] pathformat Format string of the histogram path, containing one integer
+   * @param[in] n Number of histograms
+   * @return Array of handles indexed by the integer
+   */
+  template<class H>
+  THistHandleArray<H> GetHandleArray(const char *pathformat, int n) const;
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -705,6 +802,17 @@ private:
 	 */
 	THashList *FindGroup(const char *dirname) const;
 
+	/**
+	 * @brief Find histogram via the path lookup table.
+	 *
+	 * On first access the histogram is searched in the group
+	 * structure and added to the lookup table.
+	 * @param[in] name Path of the histogram
+	 * @param[in] caller Name of the calling function (for error message)
+	 * @return Histogram object (Fatal if not found)
+	 */
+	TObject *FindHistogram(const char *name, const char *caller) const;
+
 	/**
 	 * @brief Extracting the basename from a given histogram path.
 	 * @param[in] path histogram path
@@ -721,12 +829,27 @@ private:
 
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
+	mutable std::unordered_map<std::string, TObject *> fLookupTable;  //!<! Path to histogram lookup table
 
   /// \cond CLASSIMP
-	ClassDef(THistManager, 1);  // Container for histograms
+	ClassDef(THistManager, 2);  // Container for histograms
   /// \endcond
 };
 
+template<class H>
+THistManager::THistHandle<H> THistManager::GetHandle(const char *name) const {
+  H *hist = dynamic_cast<H *>(FindHistogram(name, "THistManager::GetHandle"));
+  if(!hist) Fatal("THistManager::GetHandle", "Histogram %s is not of type %s", name, H::Class_Name());
+  return THistHandle<H>(hist);
+}
+
+template<class H>
+THistManager::THistHandleArray<H> THistManager::GetHandleArray(const char *pathformat, int n) const {
+  THistHandleArray<H> handles;
+  for(int index = 0; index < n; index++) handles.Add(GetHandle<H>(TString::Format(pathformat, index).Data()));
+  return handles;
+}
+
 THistManager::iterator THistManager::begin() const {
   return iterator(this, 0, iterator::kTHMIforward);
 }
@@ -845,6 +968,8 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  int TestFillHandles();
 };
 
 /**
@@ -882,5 +1007,7 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+int TestRunFillHandles();
+
 }
 #endif
@@ -30,6 +30,7 @@
  * - \ref HasMC to know if MC information is available in the analyzed data
  * - \ref Event to access the current event
  * - \ref MCEvent to access to current MC event (if available)
+ * - \ref Proxy and \ref MCProxy to access the histograms of a given path
  *
  * A few trivial cut methods (\ref AlwaysTrue and \ref AlwaysFalse) are defined as well and
  * can be used to register some control cut combinations (see \ref AliAnalysisMuMuCutCombination)
@@ -69,11 +70,28 @@ fCutRegistry(0x0),
 fEvent(0x0),
 fMCEvent(0x0),
 fHistogramToDisable(0x0),
-fHasMC(kFALSE)
+fHasMC(kFALSE),
+fProxies(),
+fProxyCombinations(),
+fProxySlots(),
+fMCProxySlots(),
+fCurrentCombination(-1),
+fCurrentCutSlot(-1),
+fCurrentEventSelection(0x0),
+fCurrentTriggerClassName(0x0),
+fCurrentCentrality(0x0),
+fCurrentCut(0x0)
 {
  /// default ctor
 }
 
+//_____________________________________________________________________________
+AliAnalysisMuMuBase::~AliAnalysisMuMuBase()
+{
+  /// dtor
+  ClearProxyCache();
+}
+
 //_____________________________________________________________________________
 TString AliAnalysisMuMuBase::BuildPath(const char* eventSelection, const char* triggerClassName,
                                        const char* centrality, const char* cut) const
@@ -90,6 +108,144 @@ TString AliAnalysisMuMuBase::BuildPath(const char* eventSelection, const char* t
   return path;
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::ClearProxyCache()
+{
+  /** Delete the proxies created by \ref Proxy and \ref MCProxy. Must be called
+   * whenever the histogram collection is changed or pruned.
+   */
+  std::map<std::string,AliMergeableCollectionProxy*>::iterator it;
+  for ( it = fProxies.begin(); it != fProxies.end(); ++it ) delete it->second;
+  fProxies.clear();
+
+  fProxyCombinations.clear();
+  fProxySlots.clear();
+  fMCProxySlots.clear();
+  fCurrentCombination = -1;
+  fCurrentCutSlot = -1;
+  fCurrentEventSelection = fCurrentTriggerClassName = fCurrentCentrality = fCurrentCut = 0x0;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::SelectProxyCombination(const char* eventSelection, const char* triggerClassName,
+                                                 const char* centrality)
+{
+  /** Select the eventSelection/triggerClassName/centrality combination the next
+   * \ref Proxy and \ref MCProxy calls refer to. The combination is looked up once here,
+   * so that the proxies of its cuts can then be retrieved by integer index.
+   * The strings must stay valid until the next call (they are compared by address).
+   */
+
+  TString key(Form("%s/%s/%s",eventSelection,triggerClassName,centrality));
+
+  std::map<std::string,Int_t>::const_iterator it = fProxyCombinations.find(key.Data());
+  if ( it != fProxyCombinations.end() )
+  {
+    fCurrentCombination = it->second;
+  }
+  else
+  {
+    fCurrentCombination = fProxySlots.size();
+    fProxyCombinations[key.Data()] = fCurrentCombination;
+    fProxySlots.push_back(std::vector<AliMergeableCollectionProxy*>());
+    fMCProxySlots.push_back(std::vector<AliMergeableCollectionProxy*>());
+  }
+
+  fCurrentEventSelection = eventSelection;
+  fCurrentTriggerClassName = triggerClassName;
+  fCurrentCentrality = centrality;
+  fCurrentCutSlot = -1;
+  fCurrentCut = 0x0;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::SelectProxyCut(Int_t cutIndex, const char* cut)
+{
+  /** Select the cut the next \ref Proxy and \ref MCProxy calls refer to, within the
+   * current combination (see \ref SelectProxyCombination). cutIndex must identify
+   * the cut uniquely (e.g. its index in the cut registry), cut is its name.
+   */
+  fCurrentCutSlot = cutIndex + 1; // slot 0 is the event level (no cut)
+  fCurrentCut = cut;
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::CurrentProxySlot(const char* eventSelection, const char* triggerClassName,
+                                            const char* centrality, const char* cut) const
+{
+  /// Return the slot of the current combination matching the arguments, or -1 if they
+  /// do not refer to the current combination/cut
+
+  if ( fCurrentCombination < 0 ||
+       eventSelection != fCurrentEventSelection ||
+       triggerClassName != fCurrentTriggerClassName ||
+       centrality != fCurrentCentrality ) return -1;
+
+  if ( !cut || cut[0] == '\0' ) return 0;
+
+  if ( cut == fCurrentCut && fCurrentCutSlot > 0 ) return fCurrentCutSlot;
+
+  return -1;
+}
+
+//_____________________________________________________________________________
+AliMergeableCollectionProxy* AliAnalysisMuMuBase::CachedProxy(const TString& path) const
+{
+  /// Get the proxy of a path, creating it if needed. Return 0x0 if the path does not exist (yet)
+
+  std::map<std::string,AliMergeableCollectionProxy*>::const_iterator it = fProxies.find(path.Data());
+  if ( it != fProxies.end() ) return it->second;
+
+  AliMergeableCollectionProxy* proxy = fHistogramCollection->CreateProxy(path.Data());
+  if ( proxy ) fProxies[path.Data()] = proxy;
+
+  return proxy;
+}
+
+//_____________________________________________________________________________
+AliMergeableCollectionProxy* AliAnalysisMuMuBase::Proxy(const char* eventSelection, const char* triggerClassName,
+                                                        const char* centrality, const char* cut) const
+{
+  /** Get the proxy to the histograms of the path (see \ref BuildPath).
+   * The proxy is created once per path and owned by this object : do not delete it.
+   * Return 0x0 if the path does not exist (yet) in the histogram collection.
+   *
+   * If the arguments are the ones selected with \ref SelectProxyCombination and
+   * \ref SelectProxyCut the proxy is retrieved by index, without building the path.
+   */
+
+  if (!fHistogramCollection) return 0x0;
+
+  Int_t slot = CurrentProxySlot(eventSelection,triggerClassName,centrality,cut);
+
+  if ( slot < 0 ) return CachedProxy(BuildPath(eventSelection,triggerClassName,centrality,cut));
+
+  std::vector<AliMergeableCollectionProxy*>& proxies = fProxySlots[fCurrentCombination];
+  if ( static_cast<Int_t>(proxies.size()) <= slot ) proxies.resize(slot+1,0x0);
+  if ( !proxies[slot] ) proxies[slot] = CachedProxy(BuildPath(eventSelection,triggerClassName,centrality,cut));
+
+  return proxies[slot];
+}
+
+//_____________________________________________________________________________
+AliMergeableCollectionProxy* AliAnalysisMuMuBase::MCProxy(const char* eventSelection, const char* triggerClassName,
+                                                          const char* centrality, const char* cut) const
+{
+  /// Same as \ref Proxy for the MC path (see \ref BuildMCPath)
+
+  if (!fHistogramCollection) return 0x0;
+
+  Int_t slot = CurrentProxySlot(eventSelection,triggerClassName,centrality,cut);
+
+  if ( slot < 0 ) return CachedProxy(BuildMCPath(eventSelection,triggerClassName,centrality,cut));
+
+  std::vector<AliMergeableCollectionProxy*>& proxies = fMCProxySlots[fCurrentCombination];
+  if ( static_cast<Int_t>(proxies.size()) <= slot ) proxies.resize(slot+1,0x0);
+  if ( !proxies[slot] ) proxies[slot] = CachedProxy(BuildMCPath(eventSelection,triggerClassName,centrality,cut));
+
+  return proxies[slot];
+}
+
 //_____________________________________________________________________________
 TString AliAnalysisMuMuBase::BuildMCPath(const char* eventSelection, const char* triggerClassName,
                                           const char* centrality, const char* cut) const
@@ -516,6 +672,7 @@ void AliAnalysisMuMuBase::Init(AliCounterCollection& cc,
   /// Set the internal references
   fEventCounters       = &cc;
   fHistogramCollection = &hc;
+  ClearProxyCache();
   fBinning             = &binning;
   fCutRegistry         = &registry;
 }
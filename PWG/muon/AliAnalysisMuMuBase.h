@@ -14,9 +14,14 @@
 #include "TString.h"
 #include "TProfile.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 class AliCounterCollection;
 class AliAnalysisMuMuBinning;
 class AliMergeableCollection;
+class AliMergeableCollectionProxy;
 class AliVParticle;
 class AliVEvent;
 class AliMCEvent;
@@ -29,7 +34,7 @@ class AliAnalysisMuMuBase : public TObject
 public:
 
   AliAnalysisMuMuBase();
-  virtual ~AliAnalysisMuMuBase() {}
+  virtual ~AliAnalysisMuMuBase();
 
   /** Define the histograms needed for the path starting at eventSelection/triggerClassName/centrality.
    * This method has to ensure the histogram creation is performed only once !
@@ -101,7 +106,13 @@ public:
   Bool_t AlwaysFalse(const AliVParticle& /*particle*/, const AliVParticle& /*particle*/) const { return kFALSE; }
   void NameOfAlwaysFalse(TString& name) const { name = "NONE"; }
 
-  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; }
+  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; ClearProxyCache(); }
+
+  void ClearProxyCache();
+
+  void SelectProxyCombination(const char* eventSelection, const char* triggerClassName, const char* centrality);
+
+  void SelectProxyCut(Int_t cutIndex, const char* cut);
 
 protected:
 
@@ -111,6 +122,12 @@ protected:
   TString BuildMCPath(const char* eventSelection, const char* triggerClassName, const char* centrality,
                       const char* cut="") const;
 
+  AliMergeableCollectionProxy* Proxy(const char* eventSelection, const char* triggerClassName, const char* centrality,
+                                     const char* cut="") const;
+
+  AliMergeableCollectionProxy* MCProxy(const char* eventSelection, const char* triggerClassName, const char* centrality,
+                                       const char* cut="") const;
+
   void CreateHistos(const TObjArray& paths,
                     const char* hname, const char* htitle,
                     Int_t nbinsx, Double_t xmin, Double_t xmax,
@@ -214,8 +231,22 @@ private:
   AliMCEvent* fMCEvent; //! current MC event
   TList* fHistogramToDisable; // list of regexp of histo name to disable
   Bool_t fHasMC; // whether or not we're dealing with MC data
-
-  ClassDef(AliAnalysisMuMuBase,1) // base class for a companion class to AliAnalysisMuMu
+  AliMergeableCollectionProxy* CachedProxy(const TString& path) const;
+  Int_t CurrentProxySlot(const char* eventSelection, const char* triggerClassName, const char* centrality,
+                         const char* cut) const;
+
+  mutable std::map<std::string,AliMergeableCollectionProxy*> fProxies; //! proxies (owned) already created, by path
+  std::map<std::string,Int_t> fProxyCombinations; //! index of each eventSelection/triggerClassName/centrality combination
+  mutable std::vector<std::vector<AliMergeableCollectionProxy*> > fProxySlots; //! proxies (not owned) by combination and cut index
+  mutable std::vector<std::vector<AliMergeableCollectionProxy*> > fMCProxySlots; //! MC proxies (not owned) by combination and cut index
+  Int_t fCurrentCombination; //! index of the current combination (-1 if none)
+  Int_t fCurrentCutSlot; //! slot of the current cut in the current combination
+  const char* fCurrentEventSelection; //! event selection of the current combination
+  const char* fCurrentTriggerClassName; //! trigger class of the current combination
+  const char* fCurrentCentrality; //! centrality of the current combination
+  const char* fCurrentCut; //! name of the current cut
+
+  ClassDef(AliAnalysisMuMuBase,2) // base class for a companion class to AliAnalysisMuMu
 };
 
 #endif
@@ -13,6 +13,9 @@
  * be an event cutter and a track cutter for instance). The work is done in the
  * Pass method(s).
  *
+ * The cut elements are sorted by type once (see \ref Compile), so the Pass methods
+ * only loop over the elements of the relevant type.
+ *
  */
 
 #include "AliAnalysisMuMuCutElement.h"
@@ -28,7 +31,8 @@ AliAnalysisMuMuCutCombination::AliAnalysisMuMuCutCombination()
 : TObject(), fCuts(0x0), fName(""),
 fIsEventCutter(kFALSE), fIsEventHandlerCutter(kFALSE),
 fIsTrackCutter(kFALSE), fIsTrackPairCutter(kFALSE),
-fIsTriggerClassCutter(kFALSE)
+fIsTriggerClassCutter(kFALSE), fIsCompiled(kFALSE),
+fEventCuts(), fEventHandlerCuts(), fTrackCuts(), fTrackPairCuts()
 {
   /// Default ctor.
 }
@@ -71,6 +75,7 @@ void AliAnalysisMuMuCutCombination::Add(AliAnalysisMuMuCutElement* ce)
     fIsTrackPairCutter = fIsTrackPairCutter || ce->IsTrackPairCutter();
     fIsTriggerClassCutter = fIsTriggerClassCutter || ce->IsTriggerClassCutter();
 
+    fIsCompiled = kFALSE;
   }
 
   // update the name
@@ -190,31 +195,53 @@ Bool_t AliAnalysisMuMuCutCombination::IsEqual(const TObject* obj) const
   return (n1in2==n2in1 && n1in2==fCuts->GetLast()+1);
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuCutCombination::Compile() const
+{
+  /// Sort the cut elements by type, keeping their order
+
+  fEventCuts.clear();
+  fEventHandlerCuts.clear();
+  fTrackCuts.clear();
+  fTrackPairCuts.clear();
+
+  if (fCuts)
+  {
+    for ( Int_t i = 0; i <= fCuts->GetLast(); ++i )
+    {
+      const AliAnalysisMuMuCutElement* ce = static_cast<const AliAnalysisMuMuCutElement*>(fCuts->At(i));
+      if (!ce) continue;
+      if ( ce->IsEventCutter() ) fEventCuts.push_back(ce);
+      if ( ce->IsEventHandlerCutter() ) fEventHandlerCuts.push_back(ce);
+      if ( ce->IsTrackCutter() ) fTrackCuts.push_back(ce);
+      if ( ce->IsTrackPairCutter() ) fTrackPairCuts.push_back(ce);
+    }
+  }
+
+  fIsCompiled = kTRUE;
+}
+
 //_____________________________________________________________________________
 Bool_t AliAnalysisMuMuCutCombination::Pass(const AliVEventHandler& eventHandler) const
 {
   /// Whether or not the event handler is passing the cut
 
   if (!fCuts) return kFALSE;
-  TIter next(fCuts);
-  AliAnalysisMuMuCutElement* ce;
+  if (!fIsCompiled) Compile();
 
   const AliVEvent* event = eventHandler.GetEvent();
 
   Bool_t passEvent(kTRUE);
   Bool_t passEventHandler(kTRUE);
 
-  while ( ( ce = static_cast<AliAnalysisMuMuCutElement*>(next()) ) )
+  for ( std::vector<const AliAnalysisMuMuCutElement*>::size_type i = 0; i < fEventCuts.size() && passEvent; ++i )
   {
-    if ( ce->IsEventCutter() && !ce->Pass(*event) )
-    {
-      passEvent = kFALSE;
-    }
+    passEvent = fEventCuts[i]->Pass(*event);
+  }
 
-    if ( ce->IsEventHandlerCutter() && !ce->Pass(eventHandler) )
-    {
-      passEventHandler = kFALSE;
-    }
+  for ( std::vector<const AliAnalysisMuMuCutElement*>::size_type i = 0; i < fEventHandlerCuts.size() && passEventHandler; ++i )
+  {
+    passEventHandler = fEventHandlerCuts[i]->Pass(eventHandler);
   }
 
   if ( IsEventCutter() && IsEventHandlerCutter() )
@@ -242,12 +269,11 @@ Bool_t AliAnalysisMuMuCutCombination::Pass(const AliVParticle& particle) const
   /// Whether or not the particle is passing the cut
 
   if (!fCuts) return kFALSE;
-  TIter next(fCuts);
-  AliAnalysisMuMuCutElement* ce;
+  if (!fIsCompiled) Compile();
 
-  while ( ( ce = static_cast<AliAnalysisMuMuCutElement*>(next()) ) )
+  for ( std::vector<const AliAnalysisMuMuCutElement*>::size_type i = 0; i < fTrackCuts.size(); ++i )
   {
-    if (ce->IsTrackCutter() && !ce->Pass(particle))
+    if (!fTrackCuts[i]->Pass(particle))
     {
       return kFALSE;
     }
@@ -262,12 +288,11 @@ Bool_t AliAnalysisMuMuCutCombination::Pass(const AliVParticle& p1, const AliVPar
   /// Whether or not the particle pair is passing the cut
 
   if (!fCuts) return kFALSE;
-  TIter next(fCuts);
-  AliAnalysisMuMuCutElement* ce;
+  if (!fIsCompiled) Compile();
 
-  while ( ( ce = static_cast<AliAnalysisMuMuCutElement*>(next()) ) )
+  for ( std::vector<const AliAnalysisMuMuCutElement*>::size_type i = 0; i < fTrackPairCuts.size(); ++i )
   {
-    if (ce->IsTrackPairCutter() && !ce->Pass(p1,p2))
+    if (!fTrackPairCuts[i]->Pass(p1,p2))
     {
       return kFALSE;
     }
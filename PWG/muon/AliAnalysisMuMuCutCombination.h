@@ -13,6 +13,8 @@
 #include "TObject.h"
 #include "TString.h"
 
+#include <vector>
+
 class AliAnalysisMuMuCutElement;
 class AliVEvent;
 class AliVEventHandler;
@@ -55,6 +57,8 @@ private:
   /// not implemented on purpose
   AliAnalysisMuMuCutCombination& operator=(const AliAnalysisMuMuCutCombination& rhs);
 
+  void Compile() const;
+
 private:
   TObjArray* fCuts; // array of cut elements that form this cut combination
   TString fName; // name of the combination
@@ -64,7 +68,13 @@ private:
   Bool_t fIsTrackPairCutter; // whether or not the combination cuts on track pairs
   Bool_t fIsTriggerClassCutter; // whether or not the combination cuts on trigger class
 
-  ClassDef(AliAnalysisMuMuCutCombination,1) // combination of 1 or more individual cuts
+  mutable Bool_t fIsCompiled; //! whether or not the vectors below are up-to-date with fCuts
+  mutable std::vector<const AliAnalysisMuMuCutElement*> fEventCuts; //! event cut elements
+  mutable std::vector<const AliAnalysisMuMuCutElement*> fEventHandlerCuts; //! event handler cut elements
+  mutable std::vector<const AliAnalysisMuMuCutElement*> fTrackCuts; //! track cut elements
+  mutable std::vector<const AliAnalysisMuMuCutElement*> fTrackPairCuts; //! track pair cut elements
+
+  ClassDef(AliAnalysisMuMuCutCombination,2) // combination of 1 or more individual cuts
 };
 
 #endif
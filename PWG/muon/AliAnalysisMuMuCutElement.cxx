@@ -12,6 +12,12 @@
  * Generally a real cut is made of several cut elements,
  * see \ref AliAnalysisMuMuCutCombination
  *
+ * The cut method is bound once (see \ref Init). When the result cache is enabled
+ * (see \ref SetResultCacheEnabled), the result of the cut for a given event, track or
+ * track pair is computed only once per event, whatever the number of cut combinations
+ * this element belongs to. The results of all the cut elements for one object are stored
+ * as bit masks, each cut element owning one bit.
+ *
  *  \author L. Aphecetche (Subatech)
  */
 
@@ -19,16 +25,68 @@
 #include "AliLog.h"
 #include "Riostream.h"
 #include "AliVParticle.h"
+#include <map>
+#include <utility>
 
 ClassImp(AliAnalysisMuMuCutElement)
 ClassImp(AliAnalysisMuMuCutElementBar)
 
+namespace
+{
+  /// Results of the cut elements for the objects (event, event handler, track or track pair)
+  /// of the current event. The key is the address of the object(s), so the cache must
+  /// be reset at each event (and whenever an object it may contain is deleted).
+  class MuMuCutResultCache
+  {
+  public:
+    struct Masks_t
+    {
+      ULong64_t fEvaluated; // cuts already applied to the object(s)
+      ULong64_t fPassed; // cuts passed by the object(s)
+    };
+    typedef std::pair<const void*,const void*> Key_t;
+
+    MuMuCutResultCache() : fEnabled(kFALSE), fUsedSlots(0), fResults() {}
+
+    Int_t AcquireSlot()
+    {
+      for ( Int_t i = 0; i < 64; ++i )
+      {
+        if ( !( fUsedSlots & ( 1ULL << i ) ) )
+        {
+          fUsedSlots |= ( 1ULL << i );
+          return i;
+        }
+      }
+      return -1; // too many cut elements, the remaining ones are not cached
+    }
+
+    void ReleaseSlot(Int_t i)
+    {
+      fUsedSlots &= ~( 1ULL << i );
+      fResults.clear(); // the bit might be given to another cut element within the same event
+    }
+
+    Bool_t fEnabled; // whether or not the results are cached
+    ULong64_t fUsedSlots; // bits owned by the existing cut elements
+    std::map<Key_t,Masks_t> fResults; // object(s) -> cut results
+  };
+
+  MuMuCutResultCache& ResultCache()
+  {
+    // not deleted on purpose, cut elements might be destroyed after the static objects
+    static MuMuCutResultCache* cache = new MuMuCutResultCache;
+    return *cache;
+  }
+}
+
 //_____________________________________________________________________________
 AliAnalysisMuMuCutElement::AliAnalysisMuMuCutElement()
 : TObject(), fName(""), fIsEventCutter(kFALSE), fIsEventHandlerCutter(kFALSE),
 fIsTrackCutter(kFALSE), fIsTrackPairCutter(kFALSE), fIsTriggerClassCutter(kFALSE),
 fCutObject(0x0), fCutMethodName(""), fCutMethodPrototype(""),
-fDefaultParameters(""), fNofParams(0), fCutMethod(0x0), fCallParams(), fDoubleParams()
+fDefaultParameters(""), fNofParams(0), fCutMethod(0x0), fCallParams(), fDoubleParams(),
+fCacheSlot(-1)
 {
   /// Default ctor, leading to an invalid cut object
 }
@@ -43,7 +101,7 @@ AliAnalysisMuMuCutElement::AliAnalysisMuMuCutElement(ECutType expectedType,
 fIsTrackCutter(kFALSE), fIsTrackPairCutter(kFALSE), fIsTriggerClassCutter(kFALSE),
 fCutObject(&cutObject), fCutMethodName(cutMethodName),
 fCutMethodPrototype(cutMethodPrototype),fDefaultParameters(defaultParameters),
-fNofParams(0), fCutMethod(0x0), fCallParams(), fDoubleParams()
+fNofParams(0), fCutMethod(0x0), fCallParams(), fDoubleParams(), fCacheSlot(-1)
 {
   /**
    * Construct a cut, which is a proxy to another method of (most probably) another object
@@ -66,6 +124,7 @@ AliAnalysisMuMuCutElement::~AliAnalysisMuMuCutElement()
 {
   /// Dtor
   delete fCutMethod;
+  if ( fCacheSlot >= 0 ) ResultCache().ReleaseSlot(fCacheSlot);
 }
 
 //_____________________________________________________________________________
@@ -107,6 +166,41 @@ Bool_t AliAnalysisMuMuCutElement::CallCutMethod(Long_t p1, Long_t p2) const
   return (result!=0);
 }
 
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuCutElement::CachedCallCutMethod(const void* o1, const void* o2) const
+{
+  /// Call the cut method for one object (o2=0x0) or a pair of objects, unless
+  /// the result for this (these) object(s) is already in the result cache
+
+  if (!fCutMethod)
+  {
+    Init();
+    if (!fCutMethod) return kFALSE;
+  }
+
+  MuMuCutResultCache& cache = ResultCache();
+
+  if ( !cache.fEnabled || fCacheSlot < 0 )
+  {
+    return o2 ? CallCutMethod(reinterpret_cast<Long_t>(o1),reinterpret_cast<Long_t>(o2)) :
+    CallCutMethod(reinterpret_cast<Long_t>(o1));
+  }
+
+  // a new entry is value-initialized, i.e. nothing evaluated yet
+  MuMuCutResultCache::Masks_t& masks = cache.fResults[MuMuCutResultCache::Key_t(o1,o2)];
+  ULong64_t bit = 1ULL << fCacheSlot;
+
+  if ( masks.fEvaluated & bit ) return ( ( masks.fPassed & bit ) != 0 );
+
+  Bool_t pass = o2 ? CallCutMethod(reinterpret_cast<Long_t>(o1),reinterpret_cast<Long_t>(o2)) :
+  CallCutMethod(reinterpret_cast<Long_t>(o1));
+
+  masks.fEvaluated |= bit;
+  if ( pass ) masks.fPassed |= bit;
+
+  return pass;
+}
+
 //_____________________________________________________________________________
 Int_t AliAnalysisMuMuCutElement::CountOccurences(const TString& prototype, const char* search) const
 {
@@ -446,6 +540,13 @@ void AliAnalysisMuMuCutElement::Init(ECutType expectedType) const
     delete fCutMethod;
     fCutMethod=0x0;
   }
+
+  // Trigger class cutters have an output parameter, their results are not cached
+
+  if ( fCutMethod && !fIsTriggerClassCutter && fCacheSlot < 0 )
+  {
+    fCacheSlot = ResultCache().AcquireSlot();
+  }
 }
 
 //_____________________________________________________________________________
@@ -474,28 +575,28 @@ Bool_t AliAnalysisMuMuCutElement::IsEqual(const TObject* obj) const
 Bool_t AliAnalysisMuMuCutElement::Pass(const AliVEvent& event) const
 {
   /// Whether the event pass this cut
-  return CallCutMethod(reinterpret_cast<Long_t>(&event));
+  return CachedCallCutMethod(&event,0x0);
 }
 
 //_____________________________________________________________________________
 Bool_t AliAnalysisMuMuCutElement::Pass(const AliVEventHandler& eventHandler) const
 {
   /// Whether the eventHandler pass this cut
-  return CallCutMethod(reinterpret_cast<Long_t>(&eventHandler));
+  return CachedCallCutMethod(&eventHandler,0x0);
 }
 
 //_____________________________________________________________________________
 Bool_t AliAnalysisMuMuCutElement::Pass(const AliVParticle& part) const
 {
   /// Whether the particle pass this cut
-  return CallCutMethod(reinterpret_cast<Long_t>(&part));
+  return CachedCallCutMethod(&part,0x0);
 }
 
 //_____________________________________________________________________________
 Bool_t AliAnalysisMuMuCutElement::Pass(const AliVParticle& p1, const AliVParticle& p2) const
 {
   /// Whether the particle pair pass this cut
-  return CallCutMethod(reinterpret_cast<Long_t>(&p1),reinterpret_cast<Long_t>(&p2));
+  return CachedCallCutMethod(&p1,&p2);
 }
 
 //_____________________________________________________________________________
@@ -529,6 +630,31 @@ Bool_t AliAnalysisMuMuCutElement::Pass(const TString& firedTriggerClasses,
   return (result!=0);
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuCutElement::SetResultCacheEnabled(Bool_t value)
+{
+  /** Enable or disable the caching of the cut results (for all the cut elements).
+   * When enabled, \ref ResetResultCache must be called at each event, and whenever
+   * an object (event, track) the cuts were applied to is deleted.
+   */
+  ResultCache().fEnabled = value;
+  ResultCache().fResults.clear();
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuCutElement::IsResultCacheEnabled()
+{
+  /// Whether or not the cut results are cached
+  return ResultCache().fEnabled;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuCutElement::ResetResultCache()
+{
+  /// Forget all the cut results (to be called at each event)
+  ResultCache().fResults.clear();
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuCutElement::Print(Option_t* opt) const
 {
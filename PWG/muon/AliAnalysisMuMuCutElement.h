@@ -76,6 +76,10 @@ public:
 
   Bool_t IsEqual(const TObject* obj) const;
 
+  static void SetResultCacheEnabled(Bool_t value=kTRUE);
+  static Bool_t IsResultCacheEnabled();
+  static void ResetResultCache();
+
 private:
 
   void Init(ECutType type=kAny) const;
@@ -83,6 +87,8 @@ private:
   Bool_t CallCutMethod(Long_t p) const;
   Bool_t CallCutMethod(Long_t p1, Long_t p2) const;
 
+  Bool_t CachedCallCutMethod(const void* o1, const void* o2) const;
+
   Int_t CountOccurences(const TString& prototype, const char* search) const;
 
   /// not implemented on purpose
@@ -108,8 +114,9 @@ private:
 
   mutable std::vector<Long_t> fCallParams; //! vector of parameters for the fCutMethod
   mutable std::vector<Double_t> fDoubleParams; //! temporary vector to hold the references
+  mutable Int_t fCacheSlot; //! bit of this cut in the per-event result masks (-1 if none)
 
-  ClassDef(AliAnalysisMuMuCutElement,1) // One piece of a cut combination
+  ClassDef(AliAnalysisMuMuCutElement,2) // One piece of a cut combination
 };
 
 class AliAnalysisMuMuCutElementBar : public AliAnalysisMuMuCutElement
@@ -342,8 +342,8 @@ void AliAnalysisMuMuFlow::FillHistosForPair(const char* eventSelection,
     AliMCParticle* mother = static_cast<AliMCParticle*>(MCEvent()->GetTrack(currMotheri));
     if(mother->PdgCode() !=443) return;
 
-    // Create proxy for MC
-    mcProxy = HistogramCollection()->CreateProxy(BuildMCPath(eventSelection,triggerClassName,centrality,pairCutName));
+    // Get proxy for MC
+    mcProxy = MCProxy(eventSelection,triggerClassName,centrality,pairCutName);
     TLorentzVector mcpi(mcTracki->Px(),mcTracki->Py(),mcTracki->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTracki->P()*mcTracki->P()));
     TLorentzVector mcpj(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
     mcpj+=mcpi;
@@ -362,8 +362,8 @@ void AliAnalysisMuMuFlow::FillHistosForPair(const char* eventSelection,
 
   TVector2 U(cos(fHar*pair4Momentum.Phi()),sin(fHar*pair4Momentum.Phi()));//Unitary Q vector of the dimuon
 
-  // Create proxy in AliMergeableCollection
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,pairCutName));
+  // Get proxy in AliMergeableCollection (owned by the base class)
+  AliMergeableCollectionProxy* proxy = Proxy(eventSelection,triggerClassName,centrality,pairCutName);
 
   // Weight tracks if specified
   Double_t inputWeight=0.;
@@ -711,8 +711,6 @@ void AliAnalysisMuMuFlow::FillHistosForPair(const char* eventSelection,
       }
     }
   }
-  delete proxy;
-  delete mcProxy;
 }
 
 //________________________________________________________________________
@@ -252,8 +252,8 @@ void AliAnalysisMuMuFlowSP::FillHistosForPair(const char* eventSelection,
     AliMCParticle* mother = static_cast<AliMCParticle*>(MCEvent()->GetTrack(currMotheri));
     if(mother->PdgCode() !=443) return;
 
-    // Create proxy for MC
-    mcProxy = HistogramCollection()->CreateProxy(BuildMCPath(eventSelection,triggerClassName,centrality,pairCutName));
+    // Get proxy for MC
+    mcProxy = MCProxy(eventSelection,triggerClassName,centrality,pairCutName);
     TLorentzVector mcpi(mcTracki->Px(),mcTracki->Py(),mcTracki->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTracki->P()*mcTracki->P()));
     TLorentzVector mcpj(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
     mcpj+=mcpi;
@@ -272,8 +272,8 @@ void AliAnalysisMuMuFlowSP::FillHistosForPair(const char* eventSelection,
 
   TVector2 U(cos(fHar*pair4Momentum.Phi()),sin(fHar*pair4Momentum.Phi()));//Unitary Q vector of the dimuon
 
-  // Create proxy in AliMergeableCollection
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,pairCutName));
+  // Get proxy in AliMergeableCollection (owned by the base class)
+  AliMergeableCollectionProxy* proxy = Proxy(eventSelection,triggerClassName,centrality,pairCutName);
 
   // // Weight tracks if specified
   Double_t inputWeight=0.;
@@ -456,15 +456,13 @@ void AliAnalysisMuMuFlowSP::FillHistosForPair(const char* eventSelection,
       }
     }
   }
-  delete proxy;
-  delete mcProxy;
 }
 
 //_____________________________________________________________________________
 void AliAnalysisMuMuFlowSP::FillHistosForEvent(const char* eventSelection,const char* triggerClassName,const char* centrality)
 {
-    // Create proxy in AliMergeableCollection
-  AliMergeableCollectionProxy* proxyEv = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality));
+  // Get proxy in AliMergeableCollection (owned by the base class)
+  AliMergeableCollectionProxy* proxyEv = Proxy(eventSelection,triggerClassName,centrality);
 
   TVector2 Qn[3];//Q vectors (2nd harmonic) for each detector
   for(Int_t i=0; i<fNDetectors; i++){
@@ -477,8 +475,6 @@ void AliAnalysisMuMuFlowSP::FillHistosForEvent(const char* eventSelection,const
       if ( !IsHistogramDisabled(Form("R_%svs%s",fDetectors[i].Data(),fDetectors[j].Data())))  proxyEv->Histo(Form("R_%svs%s",fDetectors[i].Data(),fDetectors[j].Data()))->Fill(Qn[i]*Qn[j]);
     }
   }
-
-  delete proxyEv;
 }
 //_____________________________________________________________________________
 void AliAnalysisMuMuFlowSP::FillHistosForMCEvent(const char* eventSelection,const char* triggerClassName,const char* centrality)
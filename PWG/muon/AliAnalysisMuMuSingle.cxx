@@ -413,11 +413,9 @@ void AliAnalysisMuMuSingle::FillHistosForTrack(const char* eventSelection,
 
   if (!AliAnalysisMuonUtility::IsMuonTrack(&track) ) return;
 
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,trackCutName));
+  AliMergeableCollectionProxy* proxy = Proxy(eventSelection,triggerClassName,centrality,trackCutName);
 
   FillHistosForMuonTrack(*proxy,track);
-
-  delete proxy;
 }
 
 //_____________________________________________________________________________
@@ -45,6 +45,7 @@
 #include <algorithm>
 #include <cassert>
 #include <set>
+#include <vector>
 ///
 /// \ class AliAnalysisTaskMuMu
 ///
@@ -383,6 +384,15 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
   TIter nextTrackCut(fCutRegistry->GetCutCombinations(AliAnalysisMuMuCutElement::kTrack));
   TIter nextPairCut(fCutRegistry->GetCutCombinations(AliAnalysisMuMuCutElement::kTrackPair));
 
+  // Index of the track and pair cuts in the registry, used by the sub-analysis to retrieve
+  // their histogram proxies without building the paths for each fill
+  TObjArray* allCuts = fCutRegistry->GetCutCombinations(AliAnalysisMuMuCutElement::kAny);
+  std::vector<Int_t> trackCutIndices;
+  std::vector<Int_t> pairCutIndices;
+  TObject* cut;
+  while ( ( cut = nextTrackCut() ) ) trackCutIndices.push_back(allCuts->IndexOf(cut));
+  while ( ( cut = nextPairCut() ) ) pairCutIndices.push_back(allCuts->IndexOf(cut));
+
   // Get number of tracks
   Int_t nTracks   = AliAnalysisMuonUtility::GetNTracks(Event());
 
@@ -394,6 +404,7 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
 
       // Create proxy for the Histogram collections
       analysis->DefineHistogramCollection(eventSelection,triggerClassName,centrality,fMix);
+      analysis->SelectProxyCombination(eventSelection,triggerClassName,centrality);
 
       if ( MCEvent() != 0x0 )
       {
@@ -413,13 +424,16 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
 
         nextTrackCut.Reset();
         AliAnalysisMuMuCutCombination* trackCut;
+        Int_t iTrackCut(0);
 
         // Loop on all track selections and fill histos for track that pass it
         while ( ( trackCut = static_cast<AliAnalysisMuMuCutCombination*>(nextTrackCut()) ) )
         {
+          Int_t trackCutIndex = trackCutIndices[iTrackCut++];
           if ( trackCut->Pass(*tracki) )
           {
             AliCodeTimerAuto(Form("%s (FillHistosForTrack)",analysis->ClassName()),2);
+            analysis->SelectProxyCut(trackCutIndex,trackCut->GetName());
             analysis->FillHistosForTrack(eventSelection,triggerClassName,centrality,trackCut->GetName(),*tracki);
           }
         }
@@ -435,10 +449,12 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
 
           nextPairCut.Reset();
           AliAnalysisMuMuCutCombination* pairCut;
+          Int_t iPairCut(0);
 
           // Fill pair histo
           while ( ( pairCut = static_cast<AliAnalysisMuMuCutCombination*>(nextPairCut()) ) )
           {
+            Int_t pairCutIndex = pairCutIndices[iPairCut++];
             // Weither or not the pairs pass the tests
             Bool_t testi  = (pairCut->IsTrackCutter()) ? pairCut->Pass(*tracki) : kTRUE;
             Bool_t testj  = (pairCut->IsTrackCutter()) ? pairCut->Pass(*trackj) : kTRUE;
@@ -447,6 +463,7 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
             if ( ( testi && testj ) && testij )
             {
               AliCodeTimerAuto(Form("%s (FillHistosForPair)",analysis->ClassName()),3);
+              analysis->SelectProxyCut(pairCutIndex,pairCut->GetName());
               analysis->FillHistosForPair(eventSelection,triggerClassName,centrality,pairCut->GetName(),*tracki,*trackj,kFALSE);
             }
           }
@@ -461,10 +478,12 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
         nextTrackCut.Reset();
 
         AliAnalysisMuMuCutCombination* pairCut;
+        Int_t iPairCut(0);
 
         // Loop over pair cut
         while ( ( pairCut = static_cast<AliAnalysisMuMuCutCombination*>(nextPairCut()) ) )
         {
+          analysis->SelectProxyCut(pairCutIndices[iPairCut++],pairCut->GetName());
           // Loop over single track cut from mixing configuration
           while ( ( trackCut = static_cast<AliAnalysisMuMuCutCombination*>(nextTrackCut()) ) )
           {
@@ -531,6 +550,9 @@ void AliAnalysisTaskMuMu::FillPoolsWithTracks(const char* eventSelection,
       }
     }
   }
+
+  // the address of a deleted track might be reused by a new clone
+  if ( nTrackRemoved > 0 ) AliAnalysisMuMuCutElement::ResetResultCache();
 }
 
 //_____________________________________________________________________________
@@ -590,6 +612,12 @@ void AliAnalysisTaskMuMu::FillCounters(const char* eventSelection, const char* t
 void AliAnalysisTaskMuMu::FinishTaskOutput()
 {
   /// prune empty histograms BEFORE mergin, in order to save some bytes...
+
+  // the proxies of the sub-analysis might refer to pruned folders
+  TIter nextAnalysis(fSubAnalysisVector);
+  AliAnalysisMuMuBase* analysis;
+  while ( ( analysis = static_cast<AliAnalysisMuMuBase*>(nextAnalysis()) ) ) analysis->ClearProxyCache();
+
   if ( fHistogramCollection ) fHistogramCollection->PruneEmptyObjects();
 }
 
@@ -879,6 +907,9 @@ void AliAnalysisTaskMuMu::UserExec(Option_t* /*opt*/)
 
   Binning(); // insure we have a binning...
 
+  // forget the cut results of the previous event
+  AliAnalysisMuMuCutElement::ResetResultCache();
+
   TIter nextAnalysis(fSubAnalysisVector);
   AliAnalysisMuMuBase* analysis;
 
@@ -987,6 +1018,10 @@ void AliAnalysisTaskMuMu::UserCreateOutputObjects()
 
   while ( ( analysis = static_cast<AliAnalysisMuMuBase*>(nextAnalysis()) ) ) analysis->Init(*fEventCounters,*fHistogramCollection,*fBinning,*fCutRegistry);
 
+  // the cut elements shared by several cut combinations are evaluated only once
+  // per event, track and track pair (the cache is reset in UserExec)
+  AliAnalysisMuMuCutElement::SetResultCacheEnabled(kTRUE);
+
   // finally end the counters initialization
   fEventCounters->Init();
 
@@ -699,6 +699,29 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
+    // two-track efficiency cut: the dphi* bending terms are computed once per track instead of per pair
+    AliDPhiStarPairCut twoTrackCut(twoTrackEfficiencyCutValue, fTwoTrackCutMinRadius);
+    AliDPhiStarPairCut::TrackBlock triggerBlock, mixedBlock;
+    AliDPhiStarPairCut::TrackBlock& associatedBlock = (mixed) ? mixedBlock : triggerBlock;
+    if (twoTrackEfficiencyCut)
+    {
+      twoTrackCut.Clear(triggerBlock, bSign);
+      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      {
+	AliVParticle* particle = (AliVParticle*) particles->UncheckedAt(i);
+	twoTrackCut.Add(triggerBlock, particle->Phi(), particle->Pt(), particle->Charge(), (mixed) ? 0 : eta[i]);
+      }
+      if (mixed)
+      {
+	twoTrackCut.Clear(mixedBlock, bSign);
+	for (Int_t j=0; j<jMax; j++)
+	{
+	  AliVParticle* particle = (AliVParticle*) mixed->UncheckedAt(j);
+	  twoTrackCut.Add(mixedBlock, particle->Phi(), particle->Pt(), particle->Charge(), eta[j]);
+	}
+      }
+    }
+    
     for (Int_t i=0; i<particles->GetEntriesFast(); i++)
     {
       AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
@@ -898,13 +921,8 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
 
-	  Float_t phi1 = triggerParticle->Phi();
 	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
-	    
-	  Float_t phi2 = particle->Phi();
 	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
 	      
 	  Float_t deta = triggerEta - eta[j];
 	      
@@ -912,28 +930,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
 	  {
 	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
-	    
-	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
-
 	    Float_t dphistarminabs = 1e5;
 	    Float_t dphistarmin = 1e5;
-	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
+	    if (twoTrackCut.MinDPhiStar(triggerBlock, i, associatedBlock, j, dphistarmin, dphistarminabs))
 	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
-	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
-
-		Float_t dphistarabs = TMath::Abs(dphistar);
-		
-		if (dphistarabs < dphistarminabs)
-		{
-		  dphistarmin = dphistar;
-		  dphistarminabs = dphistarabs;
-		}
-	      }
-	      
 	      fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
 	      
 	      if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
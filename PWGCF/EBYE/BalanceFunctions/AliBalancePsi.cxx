@@ -33,12 +33,17 @@
 #include <TString.h>
 #include <TSpline.h>
 #include <TRandom3.h>
+#include <THnSparse.h>
+#include <TDirectory.h>
+#include <algorithm>
+#include <functional>
 
 #include "AliVParticle.h"
 #include "AliMCParticle.h"
 #include "AliESDtrack.h"
 #include "AliAODTrack.h"
 #include "AliTHn.h"
+#include "AliDPhiStarPairCut.h"
 #include "AliAnalysisTaskTriggeredBF.h"
 
 #include "AliBalancePsi.h"
@@ -48,6 +53,77 @@ using std::cerr;
 
 ClassImp(AliBalancePsi)
 
+namespace {
+  // Half maximum crossings of a spline for GetFWHM().
+  // The spline is scanned from xmin to the center and from the center to xmax
+  // in nSteps = binMax*1000 steps, for the first point above (below) the
+  // threshold. The points of a scan only depend on the center bin, they are
+  // evaluated once per center bin and stored with their running maximum
+  // (minimum), so that the first crossing for any threshold is found by
+  // bisection, with the same result as the sequential scan.
+  class SplineHalfMaxScan {
+  public:
+    SplineHalfMaxScan(TSpline3 *spline, Double_t xmin, Double_t xmax) :
+      fSpline(spline), fXmin(xmin), fXmax(xmax), fScans() {}
+
+    // left edge: point before the first one above the threshold, unchanged if none
+    void FindLeft(Int_t binMax, Double_t center, Double_t threshold, Double_t &xLeft) {
+      const vector<Double_t> &leftMax = Prepare(binMax,center).fLeftMax;
+      vector<Double_t>::const_iterator it = std::upper_bound(leftMax.begin(),leftMax.end(),threshold);
+      if(it == leftMax.end()) return;
+      Int_t i = it - leftMax.begin();
+      xLeft = fXmin + (i-1)*(center - fXmin)/(binMax*1000);
+    }
+    // right edge: first point below the threshold, unchanged if none
+    void FindRight(Int_t binMax, Double_t center, Double_t threshold, Double_t &xRight) {
+      const vector<Double_t> &rightMin = Prepare(binMax,center).fRightMin;
+      vector<Double_t>::const_iterator it = std::upper_bound(rightMin.begin(),rightMin.end(),threshold,std::greater<Double_t>());
+      if(it == rightMin.end()) return;
+      Int_t j = it - rightMin.begin();
+      xRight = center + j*(fXmax - center)/(binMax*1000);
+    }
+
+  private:
+    struct Scan {
+      Scan() : fCenter(0.), fLeftMax(), fRightMin() {}
+      Double_t fCenter;            // center of the scans
+      vector<Double_t> fLeftMax;   // running maximum from xmin to the center
+      vector<Double_t> fRightMin;  // running minimum from the center to xmax
+    };
+
+    // scans for the center bin binMax, evaluated at the first request
+    const Scan &Prepare(Int_t binMax, Double_t center) {
+      std::map<Int_t, Scan>::iterator it = fScans.find(binMax);
+      if(it != fScans.end() && it->second.fCenter == center) return it->second;
+      Scan &scan = fScans[binMax];
+      scan.fCenter = center;
+      scan.fLeftMax.clear();
+      scan.fRightMin.clear();
+      Int_t nSteps = binMax*1000;
+      if(nSteps <= 0) return scan;
+      scan.fLeftMax.resize(nSteps);
+      scan.fRightMin.resize(nSteps);
+      Double_t yMax = -TMath::Infinity();
+      for (Int_t i = 0; i < nSteps; i++){
+        Double_t y = fSpline->Eval(fXmin + i*(center - fXmin)/ (binMax*1000));
+        if(y > yMax) yMax = y;
+        scan.fLeftMax[i] = yMax;
+      }
+      Double_t yMin = TMath::Infinity();
+      for (Int_t j = 0; j < nSteps; j++){
+        Double_t y = fSpline->Eval(center + j*(fXmax - center)/(binMax*1000));
+        if(y < yMin) yMin = y;
+        scan.fRightMin[j] = yMin;
+      }
+      return scan;
+    }
+
+    TSpline3 *fSpline;             // spline to scan (not owned)
+    Double_t fXmin, fXmax;         // range of the scans
+    std::map<Int_t, Scan> fScans;  // scans by center bin
+  };
+}
+
 //____________________________________________________________________//
 AliBalancePsi::AliBalancePsi() :
   TObject(), 
@@ -92,7 +168,9 @@ AliBalancePsi::AliBalancePsi() :
   fVertexBinning(kFALSE),
   fCustomBinning(""),
   fBinningString(""),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fProjectionCache(),
+  fProjectionCacheSize(200){
   // Default constructor
 }
 
@@ -138,8 +216,11 @@ AliBalancePsi::AliBalancePsi(const AliBalancePsi& balance):
   fVertexBinning(balance.fVertexBinning),
   fCustomBinning(balance.fCustomBinning),
   fBinningString(balance.fBinningString),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fProjectionCache(),
+  fProjectionCacheSize(balance.fProjectionCacheSize){
   //copy constructor
+  //the projections are not copied, they are redone on demand
 }
 
 //____________________________________________________________________//
@@ -167,12 +248,78 @@ AliBalancePsi::~AliBalancePsi() {
   delete fHistResonancesLambda;
   delete fHistQbefore;
   delete fHistQafter;
-    
+
+  ClearProjectionCache();
+}
+
+//____________________________________________________________________//
+void AliBalancePsi::ClearProjectionCache() {
+  // Deletes the cached projections of the containers
+  for(std::map<vector<Long64_t>, TH1*>::iterator it = fProjectionCache.begin(); it != fProjectionCache.end(); ++it)
+    delete it->second;
+  fProjectionCache.clear();
+}
+
+//____________________________________________________________________//
+TH1 *AliBalancePsi::GetCachedProjection(AliTHn *gHist, Int_t iVariable1, Int_t iVariable2) {
+  // Returns the projection of step 0 of the container on iVariable1
+  // (and iVariable2), with the axis ranges currently set.
+  // The result extraction asks many times for the same projections
+  // (PN, NP, PP, NN normalized by the same P, N triggers, same and mixed
+  // events, several calls per bin), they are done only once per set of ranges.
+  // The returned histogram is owned by the cache, it must not be modified.
+  if(!gHist) return 0x0;
+  THnSparse *grid = gHist->GetGrid(0)->GetGrid();
+
+  // key: container, variables, content (filled bins, entries) and ranges
+  vector<Long64_t> key;
+  key.reserve(5 + 2*grid->GetNdimensions());
+  key.push_back((Long64_t)(Long_t)gHist);
+  key.push_back(iVariable1);
+  key.push_back(iVariable2);
+  key.push_back(grid->GetNbins());
+  key.push_back((Long64_t)grid->GetEntries());
+  for(Int_t iAxis = 0; iAxis < grid->GetNdimensions(); iAxis++){
+    TAxis *axis = grid->GetAxis(iAxis);
+    Bool_t hasRange = axis->TestBit(TAxis::kAxisRange);
+    key.push_back(hasRange ? axis->GetFirst() : -1);
+    key.push_back(hasRange ? axis->GetLast()  : -1);
+  }
+
+  std::map<vector<Long64_t>, TH1*>::iterator it = fProjectionCache.find(key);
+  if(it != fProjectionCache.end()) return it->second;
+
+  TH1 *gProjection = gHist->Project(0,iVariable1,iVariable2);
+  if(!gProjection) return 0x0;
+  gProjection->SetDirectory(0);
+  // the loops over psi, vertex and pt bins produce new ranges at each step:
+  // bound the memory, the projections reused within one result are recent
+  if((Int_t)fProjectionCache.size() >= fProjectionCacheSize) ClearProjectionCache();
+  fProjectionCache[key] = gProjection;
+  return gProjection;
+}
+
+//____________________________________________________________________//
+TH1 *AliBalancePsi::GetProjection(AliTHn *gHist, Int_t iVariable1, Int_t iVariable2) {
+  // Returns a copy of the (cached) projection, owned by the caller
+  TH1 *gProjection = GetCachedProjection(gHist,iVariable1,iVariable2);
+  if(!gProjection) return 0x0;
+  TH1 *gCopy = (TH1*)gProjection->Clone();
+  if(TH1::AddDirectoryStatus()) gCopy->SetDirectory(gDirectory);
+  return gCopy;
+}
+
+//____________________________________________________________________//
+Double_t AliBalancePsi::GetProjectionIntegral(AliTHn *gHist, Int_t iVariable) {
+  // Returns the integral of the (cached) projection, without copy
+  TH1 *gProjection = GetCachedProjection(gHist,iVariable);
+  return gProjection ? gProjection->Integral() : 0.;
 }
 
 //____________________________________________________________________//
 void AliBalancePsi::InitHistograms() {
   // single particle histograms
+  ClearProjectionCache();
 
   // global switch disabling the reference 
   // (to avoid "Replacing existing TH1" if several wagons are created in train)
@@ -422,6 +569,9 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
 				     Double_t vertexZ) {
   // Calculates the balance function
   fAnalyzedEvents++;
+
+  // the containers are filled, the cached projections are outdated
+  if(!fProjectionCache.empty()) ClearProjectionCache();
     
   // Initialize histograms if not done yet
   if(!fHistPN){
@@ -462,6 +612,23 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     secondCorrection[i]  = (Double_t)((AliBFBasicParticle*) particlesSecond->At(i))->Correction();   //==========================correction
     if (fSameLabelMCCut) secondLabel[i]  = (Int_t)((AliBFBasicParticle*) particlesSecond->At(i))->GetLabel(); 
   }
+
+  // HBT like cut: the dphi* bending terms are computed once per track instead of per pair
+  AliDPhiStarPairCut hbtCut(fHBTCutValue);
+  AliDPhiStarPairCut::TrackBlock firstBlock, secondBlock;
+  AliDPhiStarPairCut::TrackBlock& secondHBTBlock = (particlesMixed) ? secondBlock : firstBlock;
+  if(fHBTCut){
+    hbtCut.Clear(secondHBTBlock,bSign);
+    for (Int_t i=0; i<jMax; i++)
+      hbtCut.Add(secondHBTBlock,secondPhi[i],secondPt[i],secondCharge[i],secondEta[i]);
+    if (particlesMixed){
+      hbtCut.Clear(firstBlock,bSign);
+      for (Int_t i=0; i<iMax; i++){
+	AliVParticle* firstParticle = (AliVParticle*) particles->At(i);
+	hbtCut.Add(firstBlock,firstParticle->Phi(),firstParticle->Pt(),(Short_t)firstParticle->Charge(),firstParticle->Eta());
+      }
+    }
+  }
   
   //TLorenzVector implementation for resonances
   TLorentzVector vectorMother, vectorDaughter[2];
@@ -617,36 +784,11 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
 	// optimization
 	if (TMath::Abs(deta) < fHBTCutValue * 2.5 * 3) //fHBTCutValue = 0.02 [default for dphicorrelations]
 	  {
-	    // phi in rad
-	    //Float_t phi1rad = firstPhi*TMath::DegToRad();
-	    //Float_t phi2rad = secondPhi[j]*TMath::DegToRad();
-	    Float_t phi1rad = firstPhi;
-	    Float_t phi2rad = secondPhi[j];
-	    
-	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 0.8, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 2.5, bSign);
-	    
-	    const Float_t kLimit = fHBTCutValue * 3;
-
-	    // Printf("typical values: deta =%f dphistar1 0.8= %f,  dphistar2 2.5 =%f, kLimit =%f ", deta, dphistar1,  dphistar2, kLimit ); 
-	    
 	    Float_t dphistarminabs = 1e5;
-	    //Float_t dphistarmin = 1e5;
+	    Float_t dphistarmin = 1e5;
 	    
-	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0 ) {
-	      for (Double_t rad=0.8; rad<2.51; rad+=0.01) {
-		Float_t dphistar = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, rad, bSign);
-		//Printf("inside loop r = %f, dphistar = %f", rad,  dphistar); 
-			    
-		Float_t dphistarabs = TMath::Abs(dphistar);
-		
-		if (dphistarabs < dphistarminabs) {
-		  //dphistarmin = dphistar;
-		  dphistarminabs = dphistarabs;
-		}
-	      }
-	      
+	    // check first boundaries (R = 0.8, 2.5 m) to see if is worth to loop and find the minimum
+	    if (hbtCut.MinDPhiStar(firstBlock, i, secondHBTBlock, j, dphistarmin, dphistarminabs)) {
 	      if (dphistarminabs < fHBTCutValue && TMath::Abs(deta) < fHBTCutValue) {
 		//AliInfo(Form("HBT: Removed track pair %d %d with [[%f %f]] %f %f %f | %f %f %d %f %f %d %f", i, j, deta, dphi, dphistarminabs, dphistar1, dphistar2, phi1rad, pt1, charge1, phi2rad, pt2, charge2, bSign));
 		continue;
@@ -807,12 +949,12 @@ TH1D *AliBalancePsi::GetBalanceFunctionHistogram(Int_t iVariableSingle,
   //Printf("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0));
 
   // Project into the wanted space (1st: analysis step, 2nd: axis)
-  TH1D* hTemp1 = (TH1D*)fHistPN->Project(0,iVariablePair); //
-  TH1D* hTemp2 = (TH1D*)fHistNP->Project(0,iVariablePair); //
-  TH1D* hTemp3 = (TH1D*)fHistPP->Project(0,iVariablePair); //
-  TH1D* hTemp4 = (TH1D*)fHistNN->Project(0,iVariablePair); //
-  TH1D* hTemp5 = (TH1D*)fHistP->Project(0,iVariableSingle); //
-  TH1D* hTemp6 = (TH1D*)fHistN->Project(0,iVariableSingle); //
+  TH1D* hTemp1 = (TH1D*)GetProjection(fHistPN,iVariablePair); //
+  TH1D* hTemp2 = (TH1D*)GetProjection(fHistNP,iVariablePair); //
+  TH1D* hTemp3 = (TH1D*)GetProjection(fHistPP,iVariablePair); //
+  TH1D* hTemp4 = (TH1D*)GetProjection(fHistNN,iVariablePair); //
+  TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,iVariableSingle); //
+  TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,iVariableSingle); //
 
   TH1D *gHistBalanceFunctionHistogram = 0x0;
   if((hTemp1)&&(hTemp2)&&(hTemp3)&&(hTemp4)&&(hTemp5)&&(hTemp6)) {
@@ -1010,21 +1152,21 @@ TH1D *AliBalancePsi::GetBalanceFunctionHistogram2pMethod(Int_t iVariableSingle,
       //Printf("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0));
       
       // Project into the wanted space (1st: analysis step, 2nd: axis)
-      TH1D* hTempHelper1 = (TH1D*)fHistPN->Project(0,iVariablePair);
-      TH1D* hTempHelper2 = (TH1D*)fHistNP->Project(0,iVariablePair);
-      TH1D* hTempHelper3 = (TH1D*)fHistPP->Project(0,iVariablePair);
-      TH1D* hTempHelper4 = (TH1D*)fHistNN->Project(0,iVariablePair);
-      TH1D* hTemp5 = (TH1D*)fHistP->Project(0,iVariableSingle);
-      TH1D* hTemp6 = (TH1D*)fHistN->Project(0,iVariableSingle);
+      TH1D* hTempHelper1 = (TH1D*)GetProjection(fHistPN,iVariablePair);
+      TH1D* hTempHelper2 = (TH1D*)GetProjection(fHistNP,iVariablePair);
+      TH1D* hTempHelper3 = (TH1D*)GetProjection(fHistPP,iVariablePair);
+      TH1D* hTempHelper4 = (TH1D*)GetProjection(fHistNN,iVariablePair);
+      TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,iVariableSingle);
+      TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,iVariableSingle);
       
       // ============================================================================================
       // the same for event mixing
-      TH1D* hTempHelper1Mix = (TH1D*)fHistPNMix->Project(0,iVariablePair);
-      TH1D* hTempHelper2Mix = (TH1D*)fHistNPMix->Project(0,iVariablePair);
-      TH1D* hTempHelper3Mix = (TH1D*)fHistPPMix->Project(0,iVariablePair);
-      TH1D* hTempHelper4Mix = (TH1D*)fHistNNMix->Project(0,iVariablePair);
-      TH1D* hTemp5Mix = (TH1D*)fHistPMix->Project(0,iVariableSingle);
-      TH1D* hTemp6Mix = (TH1D*)fHistNMix->Project(0,iVariableSingle);
+      TH1D* hTempHelper1Mix = (TH1D*)bfMix->GetProjection(fHistPNMix,iVariablePair);
+      TH1D* hTempHelper2Mix = (TH1D*)bfMix->GetProjection(fHistNPMix,iVariablePair);
+      TH1D* hTempHelper3Mix = (TH1D*)bfMix->GetProjection(fHistPPMix,iVariablePair);
+      TH1D* hTempHelper4Mix = (TH1D*)bfMix->GetProjection(fHistNNMix,iVariablePair);
+      TH1D* hTemp5Mix = (TH1D*)bfMix->GetProjection(fHistPMix,iVariableSingle);
+      TH1D* hTemp6Mix = (TH1D*)bfMix->GetProjection(fHistNMix,iVariableSingle);
       // ============================================================================================
 
       hTempHelper1->Sumw2();
@@ -1376,12 +1518,12 @@ TH2D *AliBalancePsi::GetBalanceFunctionDeltaEtaDeltaPhi(Double_t psiMin,
   //AliInfo(Form("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0)));
 
   // Project into the wanted space (1st: analysis step, 2nd: axis)
-  TH2D* hTemp1 = (TH2D*)fHistPN->Project(0,1,2);
-  TH2D* hTemp2 = (TH2D*)fHistNP->Project(0,1,2);
-  TH2D* hTemp3 = (TH2D*)fHistPP->Project(0,1,2);
-  TH2D* hTemp4 = (TH2D*)fHistNN->Project(0,1,2);
-  TH1D* hTemp5 = (TH1D*)fHistP->Project(0,1);
-  TH1D* hTemp6 = (TH1D*)fHistN->Project(0,1);
+  TH2D* hTemp1 = (TH2D*)GetProjection(fHistPN,1,2);
+  TH2D* hTemp2 = (TH2D*)GetProjection(fHistNP,1,2);
+  TH2D* hTemp3 = (TH2D*)GetProjection(fHistPP,1,2);
+  TH2D* hTemp4 = (TH2D*)GetProjection(fHistNN,1,2);
+  TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,1);
+  TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,1);
 
   TH2D *gHistBalanceFunctionHistogram = 0x0;
   if((hTemp1)&&(hTemp2)&&(hTemp3)&&(hTemp4)&&(hTemp5)&&(hTemp6)) {
@@ -1576,19 +1718,19 @@ TH2D *AliBalancePsi::GetBalanceFunctionDeltaEtaDeltaPhi2pMethod(Double_t psiMin,
       //AliInfo(Form("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0)));
 
       // Project into the wanted space (1st: analysis step, 2nd: axis)
-      TH2D* hTemp1 = (TH2D*)fHistPN->Project(0,1,2);
-      TH2D* hTemp2 = (TH2D*)fHistNP->Project(0,1,2);
-      TH2D* hTemp3 = (TH2D*)fHistPP->Project(0,1,2);
-      TH2D* hTemp4 = (TH2D*)fHistNN->Project(0,1,2);
-      TH1D* hTemp5 = (TH1D*)fHistP->Project(0,1);
-      TH1D* hTemp6 = (TH1D*)fHistN->Project(0,1);
+      TH2D* hTemp1 = (TH2D*)GetProjection(fHistPN,1,2);
+      TH2D* hTemp2 = (TH2D*)GetProjection(fHistNP,1,2);
+      TH2D* hTemp3 = (TH2D*)GetProjection(fHistPP,1,2);
+      TH2D* hTemp4 = (TH2D*)GetProjection(fHistNN,1,2);
+      TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,1);
+      TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,1);
       
       // ============================================================================================
       // the same for event mixing
-      TH2D* hTemp1Mix = (TH2D*)fHistPNMix->Project(0,1,2);
-      TH2D* hTemp2Mix = (TH2D*)fHistNPMix->Project(0,1,2);
-      TH2D* hTemp3Mix = (TH2D*)fHistPPMix->Project(0,1,2);
-      TH2D* hTemp4Mix = (TH2D*)fHistNNMix->Project(0,1,2);
+      TH2D* hTemp1Mix = (TH2D*)bfMix->GetProjection(fHistPNMix,1,2);
+      TH2D* hTemp2Mix = (TH2D*)bfMix->GetProjection(fHistNPMix,1,2);
+      TH2D* hTemp3Mix = (TH2D*)bfMix->GetProjection(fHistPPMix,1,2);
+      TH2D* hTemp4Mix = (TH2D*)bfMix->GetProjection(fHistNNMix,1,2);
       // TH1D* hTemp5Mix = (TH1D*)fHistPMix->Project(0,1);
       // TH1D* hTemp6Mix = (TH1D*)fHistNMix->Project(0,1);
       // ============================================================================================
@@ -1823,19 +1965,19 @@ TH1D *AliBalancePsi::GetBalanceFunction1DFrom2D2pMethod(Bool_t bPhi,
       //AliInfo(Form("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0)));
       
       // Project into the wanted space (1st: analysis step, 2nd: axis)
-      TH2D* hTemp1 = (TH2D*)fHistPN->Project(0,1,2);
-      TH2D* hTemp2 = (TH2D*)fHistNP->Project(0,1,2);
-      TH2D* hTemp3 = (TH2D*)fHistPP->Project(0,1,2);
-      TH2D* hTemp4 = (TH2D*)fHistNN->Project(0,1,2);
-      TH1D* hTemp5 = (TH1D*)fHistP->Project(0,1);
-      TH1D* hTemp6 = (TH1D*)fHistN->Project(0,1);
+      TH2D* hTemp1 = (TH2D*)GetProjection(fHistPN,1,2);
+      TH2D* hTemp2 = (TH2D*)GetProjection(fHistNP,1,2);
+      TH2D* hTemp3 = (TH2D*)GetProjection(fHistPP,1,2);
+      TH2D* hTemp4 = (TH2D*)GetProjection(fHistNN,1,2);
+      TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,1);
+      TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,1);
 
       // ============================================================================================
       // the same for event mixing
-      TH2D* hTemp1Mix = (TH2D*)fHistPNMix->Project(0,1,2);
-      TH2D* hTemp2Mix = (TH2D*)fHistNPMix->Project(0,1,2);
-      TH2D* hTemp3Mix = (TH2D*)fHistPPMix->Project(0,1,2);
-      TH2D* hTemp4Mix = (TH2D*)fHistNNMix->Project(0,1,2);
+      TH2D* hTemp1Mix = (TH2D*)bfMix->GetProjection(fHistPNMix,1,2);
+      TH2D* hTemp2Mix = (TH2D*)bfMix->GetProjection(fHistNPMix,1,2);
+      TH2D* hTemp3Mix = (TH2D*)bfMix->GetProjection(fHistPPMix,1,2);
+      TH2D* hTemp4Mix = (TH2D*)bfMix->GetProjection(fHistNNMix,1,2);
       // TH1D* hTemp5Mix = (TH1D*)fHistPMix->Project(0,1);
       // TH1D* hTemp6Mix = (TH1D*)fHistNMix->Project(0,1);
       // ============================================================================================
@@ -1983,13 +2125,13 @@ TH1D *AliBalancePsi::GetTriggers(TString type,
     fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
     fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
     fHistP->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-    gHist = (TH1D*)fHistP->Project(0,1);
+    gHist = (TH1D*)GetProjection(fHistP,1);
   }
   else if(type=="NP" || type=="NN"){
     fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
     fHistN->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
     fHistN->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-    gHist = (TH1D*)fHistN->Project(0,1);
+    gHist = (TH1D*)GetProjection(fHistN,1);
   }
   else if(type=="ALL"){
     fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
@@ -1998,8 +2140,8 @@ TH1D *AliBalancePsi::GetTriggers(TString type,
     fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
     fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
     fHistP->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-    gHist = (TH1D*)fHistN->Project(0,1);
-    gHist->Add((TH1D*)fHistP->Project(0,1));
+    gHist = (TH1D*)GetProjection(fHistN,1);
+    gHist->Add(GetCachedProjection(fHistP,1));
   }
 
   return gHist;
@@ -2151,11 +2293,11 @@ TH2D *AliBalancePsi::GetCorrelationFunction(TString type,
 	// average over number of triggers in each sub-bin
 	Double_t NTrigSubBin = 0;
 	if(type=="PN" || type=="PP")
-	  NTrigSubBin = (Double_t)(fHistP->Project(0,1)->Integral());
+	  NTrigSubBin = (Double_t)(GetProjectionIntegral(fHistP,1));
 	else if(type=="NP" || type=="NN")
-	  NTrigSubBin = (Double_t)(fHistN->Project(0,1)->Integral());
+	  NTrigSubBin = (Double_t)(GetProjectionIntegral(fHistN,1));
 	else if(type=="ALL")
-	  NTrigSubBin = (Double_t)(fHistN->Project(0,1)->Integral() + fHistP->Project(0,1)->Integral());
+	  NTrigSubBin = (Double_t)(GetProjectionIntegral(fHistN,1) + GetProjectionIntegral(fHistP,1));
 	fSame->Scale(NTrigSubBin);
 	
 	// only if event mixing has enough statistics
@@ -2188,13 +2330,13 @@ TH2D *AliBalancePsi::GetCorrelationFunction(TString type,
       fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
       fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
       fHistP->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-      NTrigAll = (Double_t)(fHistP->Project(0,1)->Integral());
+      NTrigAll = (Double_t)(GetProjectionIntegral(fHistP,1));
     }
     else if(type=="NP" || type=="NN"){
       fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
       fHistN->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
       fHistN->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-      NTrigAll = (Double_t)(fHistN->Project(0,1)->Integral());
+      NTrigAll = (Double_t)(GetProjectionIntegral(fHistN,1));
     }
     else if(type=="ALL"){
       fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
@@ -2203,7 +2345,7 @@ TH2D *AliBalancePsi::GetCorrelationFunction(TString type,
       fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
       fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
       fHistP->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-      NTrigAll = (Double_t)(fHistN->Project(0,1)->Integral() + fHistP->Project(0,1)->Integral());
+      NTrigAll = (Double_t)(GetProjectionIntegral(fHistN,1) + GetProjectionIntegral(fHistP,1));
     }
 
     // subtract number of triggers with empty sub bins for correct normalization
@@ -2281,7 +2423,7 @@ TH2D *AliBalancePsi::GetCorrelationFunctionPN(Double_t psiMin,
   //}
 
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHist = dynamic_cast<TH2D *>(fHistPN->Project(0,1,2));
+  TH2D *gHist = dynamic_cast<TH2D *>(GetProjection(fHistPN,1,2));
   if(!gHist){
     AliError("Projection of fHistPN = NULL");
     return gHist;
@@ -2297,8 +2439,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionPN(Double_t psiMin,
   //c2->cd();
   //fHistPN->Project(0,1,2)->DrawCopy("colz");
 
-  if((Double_t)(fHistP->Project(0,1)->Integral())>0)
-    gHist->Scale(1./(Double_t)(fHistP->Project(0,1)->Integral()));
+  if((Double_t)(GetProjectionIntegral(fHistP,1))>0)
+    gHist->Scale(1./(Double_t)(GetProjectionIntegral(fHistP,1)));
 
   //normalize to bin width
   gHist->Scale(1./((Double_t)gHist->GetXaxis()->GetBinWidth(1)*(Double_t)gHist->GetYaxis()->GetBinWidth(1)));
@@ -2356,7 +2498,7 @@ TH2D *AliBalancePsi::GetCorrelationFunctionNP(Double_t psiMin,
     fHistNP->GetGrid(0)->GetGrid()->GetAxis(4)->SetRangeUser(ptAssociatedMin,ptAssociatedMax-0.00001);
 
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHist = dynamic_cast<TH2D *>(fHistNP->Project(0,1,2));
+  TH2D *gHist = dynamic_cast<TH2D *>(GetProjection(fHistNP,1,2));
   if(!gHist){
     AliError("Projection of fHistPN = NULL");
     return gHist;
@@ -2364,8 +2506,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionNP(Double_t psiMin,
 
   //Printf("Entries (1D): %lf",(Double_t)(fHistN->Project(0,2)->GetEntries()));
   //Printf("Entries (2D): %lf",(Double_t)(fHistNP->Project(0,2,3)->GetEntries()));
-  if((Double_t)(fHistN->Project(0,1)->Integral())>0)
-    gHist->Scale(1./(Double_t)(fHistN->Project(0,1)->Integral()));
+  if((Double_t)(GetProjectionIntegral(fHistN,1))>0)
+    gHist->Scale(1./(Double_t)(GetProjectionIntegral(fHistN,1)));
 
   //normalize to bin width
   gHist->Scale(1./((Double_t)gHist->GetXaxis()->GetBinWidth(1)*(Double_t)gHist->GetYaxis()->GetBinWidth(1)));
@@ -2423,7 +2565,7 @@ TH2D *AliBalancePsi::GetCorrelationFunctionPP(Double_t psiMin,
     fHistPP->GetGrid(0)->GetGrid()->GetAxis(4)->SetRangeUser(ptAssociatedMin,ptAssociatedMax-0.00001);
       
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHist = dynamic_cast<TH2D *>(fHistPP->Project(0,1,2));
+  TH2D *gHist = dynamic_cast<TH2D *>(GetProjection(fHistPP,1,2));
   if(!gHist){
     AliError("Projection of fHistPN = NULL");
     return gHist;
@@ -2431,8 +2573,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionPP(Double_t psiMin,
 
   //Printf("Entries (1D): %lf",(Double_t)(fHistP->Project(0,2)->GetEntries()));
   //Printf("Entries (2D): %lf",(Double_t)(fHistPP->Project(0,2,3)->GetEntries()));
-  if((Double_t)(fHistP->Project(0,1)->Integral())>0)
-    gHist->Scale(1./(Double_t)(fHistP->Project(0,1)->Integral()));
+  if((Double_t)(GetProjectionIntegral(fHistP,1))>0)
+    gHist->Scale(1./(Double_t)(GetProjectionIntegral(fHistP,1)));
 
   //normalize to bin width
   gHist->Scale(1./((Double_t)gHist->GetXaxis()->GetBinWidth(1)*(Double_t)gHist->GetYaxis()->GetBinWidth(1)));
@@ -2490,7 +2632,7 @@ TH2D *AliBalancePsi::GetCorrelationFunctionNN(Double_t psiMin,
     fHistNN->GetGrid(0)->GetGrid()->GetAxis(4)->SetRangeUser(ptAssociatedMin,ptAssociatedMax-0.00001);
     
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHist = dynamic_cast<TH2D *>(fHistNN->Project(0,1,2));
+  TH2D *gHist = dynamic_cast<TH2D *>(GetProjection(fHistNN,1,2));
   if(!gHist){
     AliError("Projection of fHistPN = NULL");
     return gHist;
@@ -2498,8 +2640,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionNN(Double_t psiMin,
 
   //Printf("Entries (1D): %lf",(Double_t)(fHistN->Project(0,2)->GetEntries()));
   //Printf("Entries (2D): %lf",(Double_t)(fHistNN->Project(0,2,3)->GetEntries()));
-  if((Double_t)(fHistN->Project(0,1)->Integral())>0)
-    gHist->Scale(1./(Double_t)(fHistN->Project(0,1)->Integral()));
+  if((Double_t)(GetProjectionIntegral(fHistN,1))>0)
+    gHist->Scale(1./(Double_t)(GetProjectionIntegral(fHistN,1)));
 
   //normalize to bin width
   gHist->Scale(1./((Double_t)gHist->GetXaxis()->GetBinWidth(1)*(Double_t)gHist->GetYaxis()->GetBinWidth(1)));
@@ -2573,22 +2715,22 @@ TH2D *AliBalancePsi::GetCorrelationFunctionChargeIndependent(Double_t psiMin,
   }
 
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHistNN = dynamic_cast<TH2D *>(fHistNN->Project(0,1,2));
+  TH2D *gHistNN = dynamic_cast<TH2D *>(GetProjection(fHistNN,1,2));
   if(!gHistNN){
     AliError("Projection of fHistNN = NULL");
     return gHistNN;
   }
-  TH2D *gHistPP = dynamic_cast<TH2D *>(fHistPP->Project(0,1,2));
+  TH2D *gHistPP = dynamic_cast<TH2D *>(GetProjection(fHistPP,1,2));
   if(!gHistPP){
     AliError("Projection of fHistPP = NULL");
     return gHistPP;
   }
-  TH2D *gHistNP = dynamic_cast<TH2D *>(fHistNP->Project(0,1,2));
+  TH2D *gHistNP = dynamic_cast<TH2D *>(GetProjection(fHistNP,1,2));
   if(!gHistNP){
     AliError("Projection of fHistNP = NULL");
     return gHistNP;
   }
-  TH2D *gHistPN = dynamic_cast<TH2D *>(fHistPN->Project(0,1,2));
+  TH2D *gHistPN = dynamic_cast<TH2D *>(GetProjection(fHistPN,1,2));
   if(!gHistPN){
     AliError("Projection of fHistPN = NULL");
     return gHistPN;
@@ -2600,8 +2742,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionChargeIndependent(Double_t psiMin,
   gHistNN->Add(gHistPN);
 
   // divide by sum of + and - triggers
-  if((Double_t)(fHistN->Project(0,1)->Integral())>0 && (Double_t)(fHistP->Project(0,1)->Integral())>0)
-    gHistNN->Scale(1./(Double_t)(fHistN->Project(0,1)->Integral() + fHistP->Project(0,1)->Integral()));
+  if((Double_t)(GetProjectionIntegral(fHistN,1))>0 && (Double_t)(GetProjectionIntegral(fHistP,1))>0)
+    gHistNN->Scale(1./(Double_t)(GetProjectionIntegral(fHistN,1) + GetProjectionIntegral(fHistP,1)));
 
   //normalize to bin width
   gHistNN->Scale(1./((Double_t)gHistNN->GetXaxis()->GetBinWidth(1)*(Double_t)gHistNN->GetYaxis()->GetBinWidth(1)));
@@ -2654,28 +2796,39 @@ Bool_t AliBalancePsi::GetMomentsAnalytical(Int_t fVariable, TH1D* gHist, Bool_t
       //zeroYield = gHist->GetMinimum();
     }
     // ----------------------------------------------------------------------
-    // first calculate the mean
+    // the bins entering the moments, read once from the projected array
+    // for Delta phi: moments only on near side -pi/2 < dphi < pi/2
 
-    Double_t fWeightedAverage   = 0.;
-    Double_t fNormalization     = 0.;
+    const Double_t *fContent = gHist->GetArray();
+    const TAxis    *fAxis    = gHist->GetXaxis();
+    vector<Double_t> fBinCenter;
+    vector<Double_t> fBinYield;
+    fBinCenter.reserve(fNumberOfBins);
+    fBinYield.reserve(fNumberOfBins);
 
     for(Int_t i = 1; i <= fNumberOfBins; i++) {
+      Double_t x = fAxis->GetBinCenter(i);
+      if(fVariable == 2 && (x < - TMath::Pi()/2 || x > TMath::Pi()/2)) continue;
+      fBinCenter.push_back(x);
+      fBinYield.push_back(fContent[i]-zeroYield);
+    }
+    const Int_t fNumberOfUsedBins = fBinCenter.size();
 
-      // for Delta phi: moments only on near side -pi/2 < dphi < pi/2
-      if(fVariable == 2 && 
-	 (gHist->GetBinCenter(i) < - TMath::Pi()/2 ||
-	  gHist->GetBinCenter(i) > TMath::Pi()/2)){
-	continue;
-      }
+    // ----------------------------------------------------------------------
+    // first calculate the mean
+
+    Double_t fWeightedAverage   = 0.;
+    Double_t fNormalization     = 0.;
 
-      fWeightedAverage   += (gHist->GetBinContent(i)-zeroYield) * gHist->GetBinCenter(i);
-      fNormalization     += (gHist->GetBinContent(i)-zeroYield);
+    for(Int_t i = 0; i < fNumberOfUsedBins; i++) {
+      fWeightedAverage   += fBinYield[i] * fBinCenter[i];
+      fNormalization     += fBinYield[i];
     }  
     
     mean = fWeightedAverage / fNormalization;
 
     // ----------------------------------------------------------------------
-    // then calculate the higher moments
+    // then calculate the higher moments, all orders in the same pass
 
     Double_t fMu  = 0.;
     Double_t fMu2 = 0.;
@@ -2686,23 +2839,17 @@ Bool_t AliBalancePsi::GetMomentsAnalytical(Int_t fVariable, TH1D* gHist, Bool_t
     Double_t fMu7 = 0.;
     Double_t fMu8 = 0.;
 
-    for(Int_t i = 1; i <= fNumberOfBins; i++) {
-
-      // for Delta phi: moments only on near side -pi/2 < dphi < pi/2
-      if(fVariable == 2 && 
-	 (gHist->GetBinCenter(i) < - TMath::Pi()/2 ||
-	  gHist->GetBinCenter(i) > TMath::Pi()/2)){
-	continue;
-      }
-
-      fMu  += (gHist->GetBinContent(i)-zeroYield) * (gHist->GetBinCenter(i) - mean);
-      fMu2 += (gHist->GetBinContent(i)-zeroYield) * TMath::Power((gHist->GetBinCenter(i) - mean),2);
-      fMu3 += (gHist->GetBinContent(i)-zeroYield) * TMath::Power((gHist->GetBinCenter(i) - mean),3);
-      fMu4 += (gHist->GetBinContent(i)-zeroYield) * TMath::Power((gHist->GetBinCenter(i) - mean),4);
-      fMu5 += (gHist->GetBinContent(i)-zeroYield) * TMath::Power((gHist->GetBinCenter(i) - mean),5);
-      fMu6 += (gHist->GetBinContent(i)-zeroYield) * TMath::Power((gHist->GetBinCenter(i) - mean),6);
-      fMu7 += (gHist->GetBinContent(i)-zeroYield) * TMath::Power((gHist->GetBinCenter(i) - mean),7);
-      fMu8 += (gHist->GetBinContent(i)-zeroYield) * TMath::Power((gHist->GetBinCenter(i) - mean),8);
+    for(Int_t i = 0; i < fNumberOfUsedBins; i++) {
+      Double_t d  = fBinCenter[i] - mean;
+      Double_t wd = fBinYield[i] * d;
+      fMu  += wd; wd *= d;
+      fMu2 += wd; wd *= d;
+      fMu3 += wd; wd *= d;
+      fMu4 += wd; wd *= d;
+      fMu5 += wd; wd *= d;
+      fMu6 += wd; wd *= d;
+      fMu7 += wd; wd *= d;
+      fMu8 += wd;
     }
 
     // normalize to bin entries!
@@ -2775,24 +2922,7 @@ Float_t AliBalancePsi::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, F
   //
   // calculates dphistar
   //
-  Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
-  
-  static const Double_t kPi = TMath::Pi();
-  
-  // circularity
-//   if (dphistar > 2 * kPi)
-//     dphistar -= 2 * kPi;
-//   if (dphistar < -2 * kPi)
-//     dphistar += 2 * kPi;
-  
-  if (dphistar > kPi)
-    dphistar = kPi * 2 - dphistar;
-  if (dphistar < -kPi)
-    dphistar = -kPi * 2 - dphistar;
-  if (dphistar > kPi) // might look funny but is needed
-    dphistar = kPi * 2 - dphistar;
-  
-  return dphistar;
+  return AliDPhiStarPairCut::DPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, radius, bSign);
 }
 
 //____________________________________________________________________//
@@ -2859,25 +2989,13 @@ Double_t AliBalancePsi::GetFWHM(Int_t gDeltaEtaPhi, TH1D* gHist,
       Int_t bin_max_hist_y = gHist->GetMaximumBin();
       Double_t bins_center_x = gHist->GetBinCenter(bin_max_hist_y);
       Double_t max_spline = spline3->Eval(bins_center_x);      
-      Double_t y_spline = -999;
-      Double_t y_spline_r = -999;
       Double_t x_spline_l = -999;
       Double_t x_spline_r = -999;
       
-      for (Int_t i= 0; i < bin_max_hist_y*1000; i++){
-	y_spline = spline3->Eval(xmin + i*(bins_center_x - xmin)/ (bin_max_hist_y*1000));
-	if (y_spline > max_spline/2){
-	  x_spline_l = xmin + (i-1)*(bins_center_x - xmin)/(bin_max_hist_y*1000);
-	  break;
-	}
-      } 
-      for (Int_t j= 0; j < bin_max_hist_y*1000; j++){
-	y_spline_r = spline3->Eval(bins_center_x + j*(xmax - bins_center_x)/(bin_max_hist_y*1000));
-	if (y_spline_r < max_spline/2){
-	  x_spline_r = bins_center_x + j*(xmax - bins_center_x)/(bin_max_hist_y*1000);
-	  break;
-	}
-      }   
+      // the scans of spline3 are shared by all the repetitions below
+      SplineHalfMaxScan scan(spline3,xmin,xmax);
+      scan.FindLeft(bin_max_hist_y,bins_center_x,max_spline/2,x_spline_l);
+      scan.FindRight(bin_max_hist_y,bins_center_x,max_spline/2,x_spline_r);
       fwhm_spline = x_spline_r - x_spline_l;
       //+++++++FWHM TSpline++++++++++++++++++++++++//
     
@@ -2887,8 +3005,6 @@ Double_t AliBalancePsi::GetFWHM(Int_t gDeltaEtaPhi, TH1D* gHist,
       Int_t bin_max_hist_y1;
       Double_t bins_center_x1;
       Double_t max_spline1;
-      Double_t y_spline1 = - 999.; 
-      Double_t y_spline_r1 = - 999.; 
       Double_t x_spline_l1 = -999.; 
       Double_t x_spline_r1 = -999.;
       Double_t fwhm_spline1 = 0.;
@@ -2917,21 +3033,10 @@ Double_t AliBalancePsi::GetFWHM(Int_t gDeltaEtaPhi, TH1D* gHist,
 	bin_max_hist_y1 = hEmpty2->GetMaximumBin();
 	bins_center_x1 = hEmpty2->GetBinCenter(bin_max_hist_y1);
 	max_spline1 = spline1->Eval(bins_center_x1);
+	delete spline1;
 	
-	for (Int_t i= 0; i < bin_max_hist_y1*1000; i++){
-	  y_spline1 = spline3->Eval(xmin + i*(bins_center_x1 - xmin)/ (bin_max_hist_y1*1000));
-	  if (y_spline1 > max_spline1/2){
-	    x_spline_l1 = xmin + (i-1)*(bins_center_x1 - xmin)/(bin_max_hist_y1*1000);
-	    break;
-	  }
-	} 
-	for (Int_t j= 0; j < bin_max_hist_y1*1000; j++){
-	  y_spline_r1 = spline3->Eval(bins_center_x1 + j*(xmax - bins_center_x1)/(bin_max_hist_y1*1000));
-	  if (y_spline_r1 < max_spline1/2){
-	    x_spline_r1 = bins_center_x1 + j*(xmax - bins_center_x1)/(bin_max_hist_y1*1000);
-	    break;
-	  }
-	}     
+	scan.FindLeft(bin_max_hist_y1,bins_center_x1,max_spline1/2,x_spline_l1);
+	scan.FindRight(bin_max_hist_y1,bins_center_x1,max_spline1/2,x_spline_r1);
 	
 	fwhm_spline1 = x_spline_r1 - x_spline_l1;
 	hists->Fill(fwhm_spline1);   
@@ -2939,6 +3044,10 @@ Double_t AliBalancePsi::GetFWHM(Int_t gDeltaEtaPhi, TH1D* gHist,
       }
      
       fwhmError = TMath::Sqrt(TMath::Abs(fwhm_T/(repeat-1)));
+      delete hists;
+      delete rgauss;
+      delete hEmpty2;
+      delete spline3;
       //+++++++Error Calculation SPLINE+++++++++++//
     }
     else{  
@@ -2964,25 +3073,13 @@ Double_t AliBalancePsi::GetFWHM(Int_t gDeltaEtaPhi, TH1D* gHist,
       Double_t bins_center_xmin = gHist->GetBinCenter(bin_min_hist_y);
       Double_t min_spline = spline3->Eval(bins_center_xmin);
       
-      Double_t y_spline = -999.;
-      Double_t y_spline_r = -999.;
       Double_t x_spline_l = -999.;
       Double_t x_spline_r = -999.;
       
-      for (Int_t i= 0; i < bin_max_hist_y*1000; i++){
-	y_spline = spline3->Eval(xmin + i*(bins_center_x - xmin)/ (bin_max_hist_y*1000));
-	if (y_spline > (max_spline+min_spline)/2){
-	  x_spline_l = xmin + (i-1)*(bins_center_x - xmin)/(bin_max_hist_y*1000);
-	  break;
-	}
-      } 
-      for (Int_t j= 0; j < bin_max_hist_y*1000; j++){
-	y_spline_r = spline3->Eval(bins_center_x + j*(xmax - bins_center_x)/(bin_max_hist_y*1000));
-	if (y_spline_r < (max_spline+min_spline)/2){
-	  x_spline_r = bins_center_x + j*(xmax - bins_center_x)/(bin_max_hist_y*1000);
-	  break;
-	}
-      }   
+      // the scans of spline3 are shared by all the repetitions below
+      SplineHalfMaxScan scan(spline3,xmin,xmax);
+      scan.FindLeft(bin_max_hist_y,bins_center_x,(max_spline+min_spline)/2,x_spline_l);
+      scan.FindRight(bin_max_hist_y,bins_center_x,(max_spline+min_spline)/2,x_spline_r);
       fwhm_spline = x_spline_r - x_spline_l;
       //+++++++FWHM TSpline++++++++++++++++++++++++//
       
@@ -2992,8 +3089,6 @@ Double_t AliBalancePsi::GetFWHM(Int_t gDeltaEtaPhi, TH1D* gHist,
       Int_t bin_max_hist_y1;
       Double_t bins_center_x1;
       Double_t max_spline1;
-      Double_t y_spline1 = -999.;
-      Double_t y_spline_r1 = -999.;
       Double_t x_spline_l1 = -999.;
       Double_t x_spline_r1 = -999.;
       Double_t fwhm_spline1 = 0.;
@@ -3027,26 +3122,18 @@ Double_t AliBalancePsi::GetFWHM(Int_t gDeltaEtaPhi, TH1D* gHist,
 	bin_min_hist_y1 = hEmpty2->GetMinimumBin();
 	bins_center_xmin1 = hEmpty2->GetBinCenter(bin_min_hist_y1);
 	min_spline1 = spline1->Eval(bins_center_xmin1);
+	delete spline1;
 	
-	for (Int_t i= 0; i < bin_max_hist_y1*1000; i++){
-	  y_spline1 = spline3->Eval(xmin + i*(bins_center_x1 - xmin)/ (bin_max_hist_y1*1000));
-	  if (y_spline1 > (max_spline1+min_spline1)/2){
-	    x_spline_l1 = xmin + (i-1)*(bins_center_x1 - xmin)/(bin_max_hist_y1*1000);
-	    break;
-	  }
-	} 
-	for (Int_t j= 0; j < bin_max_hist_y1*1000; j++){
-	  y_spline_r1 = spline3->Eval(bins_center_x1 + j*(xmax - bins_center_x1)/(bin_max_hist_y1*1000));
-	  if (y_spline_r1 < (max_spline1+min_spline1)/2){
-	    x_spline_r1 = bins_center_x1 + j*(xmax - bins_center_x1)/(bin_max_hist_y1*1000);
-	    break;
-	  }
-	}     
+	scan.FindLeft(bin_max_hist_y1,bins_center_x1,(max_spline1+min_spline1)/2,x_spline_l1);
+	scan.FindRight(bin_max_hist_y1,bins_center_x1,(max_spline1+min_spline1)/2,x_spline_r1);
 	
 	fwhm_spline1 = x_spline_r1 - x_spline_l1; 
 	fwhm_T += (fwhm_spline - fwhm_spline1)*(fwhm_spline - fwhm_spline1);    
       }           
       fwhmError = TMath::Sqrt(TMath::Abs(fwhm_T/(repeat-1)));
+      delete rgauss;
+      delete hEmpty2;
+      delete spline3;
     }
   }
   return fwhm_spline;
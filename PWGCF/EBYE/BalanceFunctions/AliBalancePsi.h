@@ -13,6 +13,7 @@
 //-------------------------------------------------------------------------
 
 #include <vector>
+#include <map>
 #include <TObject.h>
 #include "TString.h"
 #include "TH2D.h"
@@ -25,6 +26,7 @@ using std::vector;
 #define MAXIMUM_NUMBER_OF_STEPS	1024
 #define MAXIMUM_STEPS_IN_PSI 360
 
+class TH1;
 class TH1D;
 class TH2D;
 class TH3D;
@@ -137,17 +139,24 @@ class AliBalancePsi : public TObject {
   AliTHn *GetHistNnn() {return fHistNN;}
 
   void SetHistNp(AliTHn *gHist) {
-    fHistP = gHist; }//fHistP->FillParent(); fHistP->DeleteContainers();}
+    fHistP = gHist; ClearProjectionCache(); }//fHistP->FillParent(); fHistP->DeleteContainers();}
   void SetHistNn(AliTHn *gHist) {
-    fHistN = gHist; }//fHistN->FillParent(); fHistN->DeleteContainers();}
+    fHistN = gHist; ClearProjectionCache(); }//fHistN->FillParent(); fHistN->DeleteContainers();}
   void SetHistNpn(AliTHn *gHist) {
-    fHistPN = gHist; }//fHistPN->FillParent(); fHistPN->DeleteContainers();}
+    fHistPN = gHist; ClearProjectionCache(); }//fHistPN->FillParent(); fHistPN->DeleteContainers();}
   void SetHistNnp(AliTHn *gHist) {
-    fHistNP = gHist; }//fHistNP->FillParent(); fHistNP->DeleteContainers();}
+    fHistNP = gHist; ClearProjectionCache(); }//fHistNP->FillParent(); fHistNP->DeleteContainers();}
   void SetHistNpp(AliTHn *gHist) {
-    fHistPP = gHist; }//fHistPP->FillParent(); fHistPP->DeleteContainers();}
+    fHistPP = gHist; ClearProjectionCache(); }//fHistPP->FillParent(); fHistPP->DeleteContainers();}
   void SetHistNnn(AliTHn *gHist) {
-    fHistNN = gHist; }//fHistNN->FillParent(); fHistNN->DeleteContainers();}
+    fHistNN = gHist; ClearProjectionCache(); }//fHistNN->FillParent(); fHistNN->DeleteContainers();}
+
+  // projections of the AliTHn containers are cached per axis ranges,
+  // to be cleared if the content of the containers is modified from outside
+  void ClearProjectionCache();
+  // maximum number of cached projections, the cache is emptied when it is reached
+  void SetProjectionCacheSize(Int_t size) {
+    fProjectionCacheSize = size; ClearProjectionCache(); }
 
   TH1D *GetBalanceFunctionHistogram(Int_t iVariableSingle,
 				    Int_t iVariablePair,
@@ -241,6 +250,10 @@ class AliBalancePsi : public TObject {
   Double_t* GetBinning(const char* configuration, const char* tag, Int_t& nBins);
 
  private:
+  TH1      *GetCachedProjection(AliTHn *gHist, Int_t iVariable1, Int_t iVariable2 = -1);
+  TH1      *GetProjection(AliTHn *gHist, Int_t iVariable1, Int_t iVariable2 = -1);
+  Double_t  GetProjectionIntegral(AliTHn *gHist, Int_t iVariable);
+
   Float_t   GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign); 
 
   Bool_t fShuffle; //shuffled balance function object
@@ -294,9 +307,12 @@ class AliBalancePsi : public TObject {
 
   TString fEventClass;
 
+  std::map<vector<Long64_t>, TH1*> fProjectionCache; //! projections of the containers (owned), by container, variables and axis ranges
+  Int_t fProjectionCacheSize; //! maximum number of cached projections
+
   AliBalancePsi & operator=(const AliBalancePsi & ) {return *this;}
 
-  ClassDef(AliBalancePsi, 3)
+  ClassDef(AliBalancePsi, 4)
 };
 
 #endif
@@ -24,6 +24,7 @@
 #include "AliPID.h"
 
 #include "AliAODpidUtil.h"
+#include "AliPIDResponseCache.h"
 #include "AliAnalysisUtils.h"
 #include "AliGenHijingEventHeader.h"
 
@@ -2089,17 +2090,19 @@ void AliFemtoEventReaderAOD::CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemt
 
    //////  TPC ////////////////////////////////////////////
 
-  const float nsigmaTPCK = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kKaon);
-  const float nsigmaTPCPi = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kPion);
-  const float nsigmaTPCP = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kProton);
-  const float nsigmaTPCE = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kElectron);
+  // the number of sigmas are shared with the other PID users of the train through the per-event cache
+  AliPIDResponseCache *pidCache = AliPIDResponseCache::Instance();
+  const float nsigmaTPCK = pidCache->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kKaon);
+  const float nsigmaTPCPi = pidCache->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kPion);
+  const float nsigmaTPCP = pidCache->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kProton);
+  const float nsigmaTPCE = pidCache->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kElectron);
 
   
   /*************************************************************************************/
-  const float nsigmaTPCD = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kDeuteron);
-  const float nsigmaTPCT = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kTriton);
-  const float nsigmaTPCH = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kHe3);
-  const float nsigmaTPCA = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kAlpha);
+  const float nsigmaTPCD = pidCache->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kDeuteron);
+  const float nsigmaTPCT = pidCache->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kTriton);
+  const float nsigmaTPCH = pidCache->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kHe3);
+  const float nsigmaTPCA = pidCache->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kAlpha);
   /*************************************************************************************/
 
 
@@ -2149,16 +2152,16 @@ void AliFemtoEventReaderAOD::CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemt
       && ((status & AliVTrack::kTIME) == AliVTrack::kTIME)
       && probMis < 0.01) {
 
-    nsigmaTOFPi = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kPion);
-    nsigmaTOFK = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kKaon);
-    nsigmaTOFP = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kProton);
-    nsigmaTOFE = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kElectron);
+    nsigmaTOFPi = pidCache->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kPion);
+    nsigmaTOFK = pidCache->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kKaon);
+    nsigmaTOFP = pidCache->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kProton);
+    nsigmaTOFE = pidCache->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kElectron);
 
     /********************************************************************/
-    nsigmaTOFD = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kDeuteron);
-    nsigmaTOFT = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kTriton);
-    nsigmaTOFH = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kHe3);
-    nsigmaTOFA = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kAlpha);
+    nsigmaTOFD = pidCache->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kDeuteron);
+    nsigmaTOFT = pidCache->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kTriton);
+    nsigmaTOFH = pidCache->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kHe3);
+    nsigmaTOFA = pidCache->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kAlpha);
     /*********************************************************************/
 
     //  double trackTime=tAodTrack->GetTOFsignal();
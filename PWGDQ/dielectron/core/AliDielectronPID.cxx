@@ -36,6 +36,7 @@ Detailed description
 #include <AliExternalTrackParam.h>
 #include <AliPIDResponse.h>
 #include <AliTRDPIDResponse.h>
+#include <AliPIDResponseCache.h>
 #include <AliESDtrack.h> //!!!!! Remove once Eta correction is treated in the tender
 #include <AliAODTrack.h>
 #include <AliAODPid.h>
@@ -376,7 +377,7 @@ Bool_t AliDielectronPID::IsSelected(TObject* track)
 
     // check if fFunSigma is set, then check if 'part' is in sigma range of the function
     if(fFunSigma[icut]){
-        val= fPIDResponse->NumberOfSigmasTPC(part, fPartType[icut]);
+        val= AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse, part, fPartType[icut]);
         if (fPartType[icut]==AliPID::kElectron){
             val-=fgCorr;
         }
@@ -449,13 +450,13 @@ Bool_t AliDielectronPID::IsSelectedITS(AliVTrack * const part, Int_t icut)
   // ITS part of the PID check
   // Don't accept the track if there was no pid bit set
   //
-  AliPIDResponse::EDetPidStatus pidStatus = fPIDResponse->CheckPIDStatus(AliPIDResponse::kITS,part);
+  AliPIDResponse::EDetPidStatus pidStatus = AliPIDResponseCache::Instance()->CheckPIDStatus(fPIDResponse,AliPIDResponse::kITS,part);
   if (fRequirePIDbit[icut]==AliDielectronPID::kRequire&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kFALSE;
   if (fRequirePIDbit[icut]==AliDielectronPID::kIfAvailable&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kTRUE;
 
   Double_t mom=part->P();
 
-  Float_t numberOfSigmas=fPIDResponse->NumberOfSigmasITS(part, fPartType[icut]);
+  Float_t numberOfSigmas=AliPIDResponseCache::Instance()->NumberOfSigmasITS(fPIDResponse, part, fPartType[icut]);
 
   // post pid corrections ("eta corrections")
   if (fPartType[icut]==AliPID::kElectron){
@@ -479,12 +480,12 @@ Bool_t AliDielectronPID::IsSelectedTPC(AliVTrack * const part, Int_t icut, Doubl
   // TPC part of the PID check
   // Don't accept the track if there was no pid bit set
   //
-  AliPIDResponse::EDetPidStatus pidStatus = fPIDResponse->CheckPIDStatus(AliPIDResponse::kTPC,part);
+  AliPIDResponse::EDetPidStatus pidStatus = AliPIDResponseCache::Instance()->CheckPIDStatus(fPIDResponse,AliPIDResponse::kTPC,part);
   if (fRequirePIDbit[icut]==AliDielectronPID::kRequire&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kFALSE;
   if (fRequirePIDbit[icut]==AliDielectronPID::kIfAvailable&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kTRUE;
 
 
-  Float_t numberOfSigmas=fPIDResponse->NumberOfSigmasTPC(part, fPartType[icut]);
+  Float_t numberOfSigmas=AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse, part, fPartType[icut]);
 
   // post pid corrections ("eta corrections")
   if (fPartType[icut]==AliPID::kElectron){
@@ -533,7 +534,7 @@ Bool_t AliDielectronPID::IsSelectedTRD(AliVTrack * const part, Int_t icut, AliTR
   // the TRD checks on the probabilities.
   //
 
-  AliPIDResponse::EDetPidStatus pidStatus = fPIDResponse->CheckPIDStatus(AliPIDResponse::kTRD,part);
+  AliPIDResponse::EDetPidStatus pidStatus = AliPIDResponseCache::Instance()->CheckPIDStatus(fPIDResponse,AliPIDResponse::kTRD,part);
   if (fRequirePIDbit[icut]==AliDielectronPID::kRequire&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kFALSE;
   if (fRequirePIDbit[icut]==AliDielectronPID::kIfAvailable&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kTRUE;
 
@@ -556,7 +557,7 @@ Bool_t AliDielectronPID::IsSelectedTRDeleEff(AliVTrack * const part, Int_t icut,
   //   and the lower limit regarded as the requested electron efficiency
   //
 
-  AliPIDResponse::EDetPidStatus pidStatus = fPIDResponse->CheckPIDStatus(AliPIDResponse::kTRD,part);
+  AliPIDResponse::EDetPidStatus pidStatus = AliPIDResponseCache::Instance()->CheckPIDStatus(fPIDResponse,AliPIDResponse::kTRD,part);
   if (fRequirePIDbit[icut]==AliDielectronPID::kRequire&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kFALSE;
   if (fRequirePIDbit[icut]==AliDielectronPID::kIfAvailable&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kTRUE;
 
@@ -577,11 +578,11 @@ Bool_t AliDielectronPID::IsSelectedTOF(AliVTrack * const part, Int_t icut)
   // TOF part of the PID check
   // Don't accept the track if there was no pid bit set
   //
-  AliPIDResponse::EDetPidStatus pidStatus = fPIDResponse->CheckPIDStatus(AliPIDResponse::kTOF,part);
+  AliPIDResponse::EDetPidStatus pidStatus = AliPIDResponseCache::Instance()->CheckPIDStatus(fPIDResponse,AliPIDResponse::kTOF,part);
   if (fRequirePIDbit[icut]==AliDielectronPID::kRequire&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kFALSE;
   if (fRequirePIDbit[icut]==AliDielectronPID::kIfAvailable&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kTRUE;
 
-  Float_t numberOfSigmas=fPIDResponse->NumberOfSigmasTOF(part, fPartType[icut]);
+  Float_t numberOfSigmas=AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPIDResponse, part, fPartType[icut]);
 
   // post pid corrections ("eta corrections")
   if (fPartType[icut]==AliPID::kElectron){
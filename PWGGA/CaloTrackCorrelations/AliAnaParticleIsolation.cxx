@@ -13,6 +13,10 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 
+// --- C++ ---
+#include <algorithm>
+#include <iterator>
+
 // --- ROOT system ---
 #include <TClonesArray.h>
 #include <TList.h>
@@ -28,6 +32,7 @@
 #include "AliCaloTrackReader.h"
 #include "AliMCEvent.h"
 #include "AliIsolationCut.h"
+#include "AliCaloTrackEtaPhiGrid.h"
 #include "AliFiducialCut.h"
 #include "AliMCAnalysisUtils.h"
 #include "AliNeutralMesonSelection.h"
@@ -8338,6 +8343,23 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
   if(GetReader()->GetDataType() != AliCaloTrackReader::kMC)
     GetReader()->GetVertex(vertex);
   
+  // Tracks that can be in the perpendicular cones, for all cone sizes,
+  // with one query of the reader eta-phi index around each perpendicular direction
+  TObjArray * trackList = GetCTSTracks() ;
+  AliCaloTrackEtaPhiGrid * trackGrid = GetReader()->GetEtaPhiGrid(trackList);
+  std::vector<Int_t> perpTracks;
+  if ( trackGrid )
+  {
+    Float_t rmax = 0;
+    for(Int_t icone = 0; icone<fNCones; icone++) rmax = TMath::Max(rmax, fConeSizes[icone]);
+    
+    std::vector<Int_t> perpTracksUp, perpTracksDown;
+    trackGrid->GetEntriesAround(etaC, phiC+TMath::PiOver2(), rmax, kFALSE, perpTracksUp  );
+    trackGrid->GetEntriesAround(etaC, phiC-TMath::PiOver2(), rmax, kFALSE, perpTracksDown);
+    std::set_union(perpTracksUp.begin(), perpTracksUp.end(), perpTracksDown.begin(), perpTracksDown.end(),
+                   std::back_inserter(perpTracks));
+  }
+  
   // Loop on cone sizes
   for(Int_t icone = 0; icone<fNCones; icone++)
   {
@@ -8363,9 +8385,10 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
     
     // Tracks in perpendicular cones
     Double_t sumptPerp = 0. ;
-    TObjArray * trackList   = GetCTSTracks() ;
-    for(Int_t itrack=0; itrack < trackList->GetEntriesFast(); itrack++)
+    Int_t ntracks = trackGrid ? perpTracks.size() : trackList->GetEntriesFast();
+    for(Int_t ientry=0; ientry < ntracks; ientry++)
     {
+      Int_t itrack = trackGrid ? perpTracks[ientry] : ientry;
       AliVTrack* track = (AliVTrack *) trackList->At(itrack);
       //fill the histograms at forward range
       if(!track)
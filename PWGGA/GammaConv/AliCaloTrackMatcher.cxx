@@ -24,6 +24,7 @@
 #include "AliAODEvent.h"
 #include "AliCaloTrackMatcher.h"
 #include "AliEMCALRecoUtils.h"
+#include "AliEmcalTrackSurfaceCache.h"
 #include "AliESDEvent.h"
 #include "AliESDtrack.h"
 #include "AliESDtrackCuts.h"
@@ -61,6 +62,8 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
   fGeomPHOS(NULL),
   fMapTrackToCluster(),
   fMapClusterToTrack(),
+  fClusterGrid(),
+  fClusterCandidates(),
   fNEntries(1),
   fVectorDeltaEtaDeltaPhi(0),
   fMap_TrID_ClID_ToIndex(),
@@ -279,6 +282,24 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
   }
 
+  // propagations to the EMCal surface are shared with the other track matchers of the event
+  PWG::EMCAL::AliEmcalTrackSurfaceCache *surfaceCache = PWG::EMCAL::AliEmcalTrackSurfaceCache::Instance();
+  surfaceCache->SetEvent(event);
+
+  // clusters binned in z and phi, such that each track is only compared to the clusters
+  // which can be within the matching window
+  fClusterGrid.SetBinning(TMath::Max(1,TMath::CeilNint(1000./TMath::Max(fMatchingWindow,10.))), -500., 500., 72);
+  Double_t minClusterR = 1e10;
+  for(Int_t iclus=0;iclus < nClus;iclus++){
+    AliVCluster* cluster = arrClusters ? dynamic_cast<AliVCluster*>(arrClusters->At(iclus)) : event->GetCaloCluster(iclus);
+    if (!cluster) continue;
+    Float_t clsPos[3] = {0.,0.,0.};
+    cluster->GetPosition(clsPos);
+    fClusterGrid.Add(iclus, clsPos[2], TMath::ATan2(clsPos[1],clsPos[0]));
+    minClusterR = TMath::Min(minClusterR, (Double_t)TMath::Sqrt(clsPos[0]*clsPos[0] + clsPos[1]*clsPos[1]));
+  }
+  fClusterGrid.Build();
+
   for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
     AliExternalTrackParam *trackParam = 0;
     AliVTrack *inTrack = 0x0;
@@ -356,7 +377,7 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
 
     //propagate tracks to emc surfaces
     if(fClusterType == 1 || fClusterType == 3){
-      if (!AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 440., 0.139, 20., eta, phi, pt)) {
+      if (!surfaceCache->PropagateTrackParam(inTrack, &emcParam, 440., 0.139, 20., eta, phi, pt)) {
         delete trackParam;
         fHistControlMatches->Fill(2.,inTrack->Pt());
         continue;
@@ -411,8 +432,16 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     // cout << inTrack->GetID() << " - " << trackParam << endl;
     // cout << "eta/phi: " << eta << ", " << phi << endl;
     // cout << "nClus: " << nClus << endl;
+    // the distance to a cluster is larger than |dz| and than the chord between the
+    // azimuths at the smaller transverse radius
+    Double_t minR = TMath::Min(TMath::Sqrt(exPos[0]*exPos[0] + exPos[1]*exPos[1]), minClusterR);
+    Double_t maxDPhi = TMath::Pi();
+    if (2*minR > fMatchingWindow) maxDPhi = 2*TMath::ASin(fMatchingWindow/(2*minR));
+    fClusterGrid.FindCandidates(exPos[2], TMath::ATan2(exPos[1],exPos[0]), fMatchingWindow, maxDPhi, fClusterCandidates);
+
     Int_t nClusterMatchesToTrack = 0;
-    for(Int_t iclus=0;iclus < nClus;iclus++){
+    for(UInt_t icand=0;icand < fClusterCandidates.size();icand++){
+      Int_t iclus = fClusterCandidates[icand];
       AliVCluster* cluster = NULL;
       if(arrClusters){
         if(esdev){
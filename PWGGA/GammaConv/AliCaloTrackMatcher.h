@@ -4,6 +4,7 @@
 #include "AliAnalysisTaskSE.h"
 #include "AliEMCALGeometry.h"
 #include "AliPHOSGeometry.h"
+#include "AliEmcalEtaPhiGrid.h"
 #include <vector>
 #include <map>
 #include <utility>
@@ -114,6 +115,9 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     multimap<Int_t,Int_t> fMapTrackToCluster;      // connects a given track ID with all associated cluster IDs
     multimap<Int_t,Int_t> fMapClusterToTrack;      // connects a given cluster ID with all associated track IDs
 
+    PWG::EMCAL::AliEmcalEtaPhiGrid fClusterGrid;   //! clusters binned in z and phi of their position
+    vector<Int_t>         fClusterCandidates;      //! clusters within the matching window of the current track
+
     Int_t                 fNEntries;               // number of current TrackID/ClusterID -> Eta/Phi connections
     vector<pairFloat>     fVectorDeltaEtaDeltaPhi; // vector of all matching residuals for a specific TrackID/ClusterID
     mapT                  fMap_TrID_ClID_ToIndex;  // map tuple of (trackID,clusterID) to index in vector fVectorDeltaEtaDeltaPhi
@@ -132,7 +136,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,5)
+    ClassDef(AliCaloTrackMatcher,6)
 };
 
 #endif
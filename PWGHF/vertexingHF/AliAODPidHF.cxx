@@ -31,6 +31,7 @@
 #include "AliAODPid.h"
 #include "AliPID.h"
 #include "AliPIDResponse.h"
+#include "AliPIDResponseCache.h"
 #include "AliAODpidUtil.h"
 #include "AliESDtrack.h"
 
@@ -428,14 +429,14 @@ void AliAODPidHF::CombinedProbability(AliAODTrack *track,Bool_t *type) const{
 //--------------------------------
 Bool_t AliAODPidHF::CheckITSPIDStatus(AliAODTrack *track) const{
   /// Check if the track is good for ITS PID
-  AliPIDResponse::EDetPidStatus status = fPidResponse->CheckPIDStatus(AliPIDResponse::kITS,track);
+  AliPIDResponse::EDetPidStatus status = AliPIDResponseCache::Instance()->CheckPIDStatus(fPidResponse,AliPIDResponse::kITS,track);
   if (status != AliPIDResponse::kDetPidOk) return kFALSE;
   return kTRUE;
 }
 //--------------------------------
 Bool_t AliAODPidHF::CheckTPCPIDStatus(AliAODTrack *track) const{
   /// Check if the track is good for TPC PID
-  AliPIDResponse::EDetPidStatus status = fPidResponse->CheckPIDStatus(AliPIDResponse::kTPC,track);
+  AliPIDResponse::EDetPidStatus status = AliPIDResponseCache::Instance()->CheckPIDStatus(fPidResponse,AliPIDResponse::kTPC,track);
   if (status != AliPIDResponse::kDetPidOk) return kFALSE;
   UInt_t nclsTPCPID = track->GetTPCsignalN();
   if(nclsTPCPID<fMinNClustersTPCPID) return kFALSE;
@@ -444,7 +445,7 @@ Bool_t AliAODPidHF::CheckTPCPIDStatus(AliAODTrack *track) const{
 //--------------------------------
 Bool_t AliAODPidHF::CheckTOFPIDStatus(AliAODTrack *track) const{
   /// Check if the track is good for TOF PID
-  AliPIDResponse::EDetPidStatus status = fPidResponse->CheckPIDStatus(AliPIDResponse::kTOF,track);
+  AliPIDResponse::EDetPidStatus status = AliPIDResponseCache::Instance()->CheckPIDStatus(fPidResponse,AliPIDResponse::kTOF,track);
   if (status != AliPIDResponse::kDetPidOk) return kFALSE;
   Float_t probMis = fPidResponse->GetTOFMismatchProbability(track);
   if (probMis > fCutTOFmismatch) return kFALSE;
@@ -453,7 +454,7 @@ Bool_t AliAODPidHF::CheckTOFPIDStatus(AliAODTrack *track) const{
 //--------------------------------
 Bool_t AliAODPidHF::CheckTRDPIDStatus(AliAODTrack *track) const{
   /// Check if the track is good for TRD PID
-  AliPIDResponse::EDetPidStatus status = fPidResponse->CheckPIDStatus(AliPIDResponse::kTRD,track);
+  AliPIDResponse::EDetPidStatus status = AliPIDResponseCache::Instance()->CheckPIDStatus(fPidResponse,AliPIDResponse::kTRD,track);
   if (status != AliPIDResponse::kDetPidOk) return kFALSE;
   return kTRUE;
 }
@@ -624,12 +625,12 @@ Int_t AliAODPidHF::MatchTPCTOF(AliAODTrack *track, Int_t specie){
     
     Double_t nSigmaTPC=0.;
     if(okTPC) {
-      nSigmaTPC=fPidResponse->NumberOfSigmasTPC(track,(AliPID::EParticleType)specie);
+      nSigmaTPC=AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPidResponse,track,(AliPID::EParticleType)specie);
       if(nSigmaTPC<-990.) nSigmaTPC=0.;
     }
     Double_t nSigmaTOF=0.;
     if(okTOF) {
-      nSigmaTOF=fPidResponse->NumberOfSigmasTOF(track,(AliPID::EParticleType)specie);
+      nSigmaTOF=AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPidResponse,track,(AliPID::EParticleType)specie);
     }
     Int_t iPart=specie-2; //species is 2 for pions,3 for kaons and 4 for protons
     if(iPart<0 || iPart>2) return -1;
@@ -877,7 +878,7 @@ Int_t AliAODPidHF::GetnSigmaITS(AliAODTrack *track,Int_t species, Double_t &nsig
   else { // new pid
     
     AliPID::EParticleType type=AliPID::EParticleType(species);
-    nsigmaITS = fPidResponse->NumberOfSigmasITS(track,type);
+    nsigmaITS = AliPIDResponseCache::Instance()->NumberOfSigmasITS(fPidResponse,track,type);
     
   } //new pid
   
@@ -907,7 +908,7 @@ Int_t AliAODPidHF::GetnSigmaTPC(AliAODTrack *track, Int_t species, Double_t &nsi
   } else{
     if(!fPidResponse) return -1;
     AliPID::EParticleType type=AliPID::EParticleType(species);
-    nsigmaTPC = fPidResponse->NumberOfSigmasTPC(track,type);
+    nsigmaTPC = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPidResponse,track,type);
     nsigma=nsigmaTPC;
   }
   return 1;
@@ -921,7 +922,7 @@ Int_t AliAODPidHF::GetnSigmaTOF(AliAODTrack *track,Int_t species, Double_t &nsig
   if(!CheckTOFPIDStatus(track)) return -1;
   
   if(fPidResponse){
-    nsigma = fPidResponse->NumberOfSigmasTOF(track,(AliPID::EParticleType)species);
+    nsigma = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPidResponse,track,(AliPID::EParticleType)species);
     return 1;
   }else{
     AliFatal("To use TOF PID you need to attach AliPIDResponseTask");
@@ -1286,13 +1287,13 @@ Bool_t AliAODPidHF::CheckDetectorPIDStatus(AliPIDResponse::EDetector detector, A
 Float_t AliAODPidHF::NumberOfSigmas(AliPID::EParticleType specie, AliPIDResponse::EDetector detector, AliAODTrack *track) {
   switch (detector) {
     case AliPIDResponse::kITS:
-      return fPidResponse->NumberOfSigmasITS(track, specie);
+      return AliPIDResponseCache::Instance()->NumberOfSigmasITS(fPidResponse,track, specie);
       break;
     case AliPIDResponse::kTPC:
-      return fPidResponse->NumberOfSigmasTPC(track, specie);
+      return AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPidResponse,track, specie);
       break;
     case AliPIDResponse::kTOF:
-      return fPidResponse->NumberOfSigmasTOF(track, specie);
+      return AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPidResponse,track, specie);
       break;
     default:
       return -999.;
@@ -32,6 +32,7 @@
 #include <TString.h>
 #include <TList.h>
 #include <TProcessID.h>
+#include <TMath.h>
 #include "AliLog.h"
 #include "AliVEvent.h"
 #include "AliVVertex.h"
@@ -63,6 +64,7 @@
 #include "AliRDHFCutsD0toKpipipi.h"
 #include "AliRDHFCutsDStartoKpipi.h"
 #include "AliAnalysisFilter.h"
+#include "AliAnalysisManager.h"
 #include "AliAnalysisVertexingHF.h"
 #include "AliMixedEvent.h"
 #include "AliESDv0.h"
@@ -70,9 +72,77 @@
 #include "AliCodeTimer.h"
 #include "AliMultSelection.h"
 #include <cstring>
+#include <vector>
+#include <set>
 
 /// \cond CLASSIMP
 ClassImp(AliAnalysisVertexingHF);
+
+namespace {
+  /// Per-event cache shared by all AliAnalysisVertexingHF instances in the process,
+  /// i.e. by all the tasks of a train (they usually create their own instance per event).
+  /// It holds the AOD index map, the AliESDtrack conversions of the candidate daughters
+  /// (indexed by track ID) and the candidates whose refill failed, so that the
+  /// following tasks neither redo the conversions nor retry failed candidates.
+  /// Events are processed sequentially by the analysis manager, no locking needed.
+  /// The cache only deletes the conversions it created itself (GetRecoCandDaughter),
+  /// and only while events are processed: nothing is deleted at static teardown,
+  /// where the ROOT objects the tracks refer to may already be gone.
+  class HFRecoCandCache {
+  public:
+    HFRecoCandCache() : fEvent(0), fEntry(-1), fRun(-1), fNTracks(-1), fIndex(), fTracks(), fFailed() {}
+    ~HFRecoCandCache() {}
+
+    void Clear() {
+      for (size_t i=0; i<fTracks.size(); i++) delete fTracks[i];  // conversions made by the cache
+      fTracks.clear();
+      fIndex.clear();
+      fFailed.clear();
+      fEvent = 0;
+      fEntry = -1;
+    }
+    /// Invalidate the cache if the entry of the analysis manager changed. The event object
+    /// (and its header) can be the same for consecutive entries, e.g. in MC productions.
+    /// Outside of an analysis manager nothing is kept from one call to the next.
+    void Update(const AliVEvent *event) {
+      AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+      Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+      if (entry>=0 && entry==fEntry && event==fEvent && event->GetRunNumber()==fRun &&
+          event->GetNumberOfTracks()==fNTracks) return;
+      Clear();
+      fEvent   = event;
+      fEntry   = entry;
+      fRun     = event->GetRunNumber();
+      fNTracks = event->GetNumberOfTracks();
+    }
+    /// Candidates are identified by the IDs of their daughters, which unlike their
+    /// addresses are the same in all tasks and cannot be reused by another candidate.
+    /// Whether the refill fails depends on the vertexer as well, so the secondary vertex
+    /// algorithm (KF or AliVertexerTracks) and the field are part of the key. The
+    /// AliVertexerTracks is always default constructed by AliAnalysisVertexingHF,
+    /// the field is its only setting.
+    Bool_t HasFailed(const AliAODRecoDecayHF *cand, Int_t nProngs, Bool_t withKF, Double_t bz) const { return fFailed.count(Key(cand,nProngs,withKF,bz))>0; }
+    void   SetFailed(const AliAODRecoDecayHF *cand, Int_t nProngs, Bool_t withKF, Double_t bz) { fFailed.insert(Key(cand,nProngs,withKF,bz)); }
+
+    const AliVEvent *fEvent;           // event the cache is valid for
+    Long64_t  fEntry;                  // entry of the analysis manager the cache is valid for
+    Int_t     fRun;                    // run number of fEvent
+    Int_t     fNTracks;                // number of tracks in fEvent
+    std::vector<Int_t> fIndex;         // track ID -> index in the event, same convention as fAODMap
+    std::vector<AliESDtrack*> fTracks; // track ID -> daughter converted by GetRecoCandDaughter, owned
+    std::set<std::vector<Int_t> > fFailed; // daughter IDs and vertexer of the candidates whose refill failed in this entry
+
+  private:
+    static std::vector<Int_t> Key(const AliAODRecoDecayHF *cand, Int_t nProngs, Bool_t withKF, Double_t bz) {
+      std::vector<Int_t> key(nProngs+2);
+      for (Int_t i=0; i<nProngs; i++) key[i] = cand->GetProngID(i);
+      key[nProngs]   = withKF ? 1 : 0;
+      key[nProngs+1] = TMath::Nint(bz*1000.);
+      return key;
+    }
+  };
+  HFRecoCandCache gRecoCandCache;
+}
 /// \endcond
 
 //----------------------------------------------------------------------------
@@ -1699,18 +1769,21 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF3P
   // method to retrieve daughters from trackID and reconstruct secondary vertex
   // save the TRefs to the candidate AliAODRecoDecayHF3Prong rd
   // and fill on-the-fly the data member of rd
+  // the daughter conversions are shared with the other tasks through a per-event cache
   if(rd->GetIsFilled()!=0)return kTRUE;//if 0: reduced dAOD. skip if rd is already filled (1: standard dAOD, 2 already refilled)
-  if(!fAODMap)MapAODtracks(event);//fill the AOD index map if it is not yet done
+  gRecoCandCache.Update(event);
+  if(gRecoCandCache.HasFailed(rd,3,fSecVtxWithKF,event->GetMagneticField()))return kFALSE;//refill already failed in a previous task
+
+  AliESDtrack *cached1 = GetRecoCandDaughter(event,rd->GetProngID(0));//retrieve daughter from the trackID through the AOD index map
+  AliESDtrack *cached2 = GetRecoCandDaughter(event,rd->GetProngID(1));
+  AliESDtrack *cached3 = GetRecoCandDaughter(event,rd->GetProngID(2));
+  if(!cached1 || !cached2 || !cached3){
+    gRecoCandCache.SetFailed(rd,3,fSecVtxWithKF,event->GetMagneticField());
+    return kFALSE;
+  }
   TObjArray *threeTrackArray   = new TObjArray(3);
-
-  AliAODTrack *track1 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(0)]);//retrieve daughter from the trackID through the AOD index map
-  if(!track1)return kFALSE;
-  AliAODTrack *track2 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(1)]);
-  if(!track2)return kFALSE;
-  AliESDtrack *postrack1 = 0;
-  AliESDtrack *negtrack1 = 0;
-  postrack1 = new AliESDtrack(track1);
-  negtrack1 = new AliESDtrack(track2);
+  AliESDtrack *postrack1 = new AliESDtrack(*cached1);
+  AliESDtrack *negtrack1 = new AliESDtrack(*cached2);
 
   // DCA between the two tracks
   Double_t xdummy, ydummy;
@@ -1726,9 +1799,7 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF3P
   fV1->GetCovMatrix(cov);
   if(!fVertexerTracks)fVertexerTracks=new AliVertexerTracks(fBzkG);
 
-  AliAODTrack *track3 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(2)]);
-  if(!track3)return kFALSE;
-  AliESDtrack *esdt3 = new AliESDtrack(track3);
+  AliESDtrack *esdt3 = new AliESDtrack(*cached3);
 
   Double_t dca2;
   Double_t dca3;
@@ -1741,6 +1812,7 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF3P
 
   AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray, dispersion);
   if (!secVert3PrAOD) {
+    gRecoCandCache.SetFailed(rd,3,fSecVtxWithKF,event->GetMagneticField());
     threeTrackArray->Clear();
     threeTrackArray->Delete(); delete threeTrackArray;
     delete fV1; fV1=0;
@@ -1769,21 +1841,22 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF2P
   // method to retrieve daughters from trackID and reconstruct secondary vertex
   // save the TRefs to the candidate AliAODRecoDecayHF2Prong rd
   // and fill on-the-fly the data member of rd
+  // the daughter conversions are shared with the other tasks through a per-event cache
   if(rd->GetIsFilled()!=0)return kTRUE;//if 0: reduced dAOD. skip if rd is already filled (1:standard dAOD, 2 already refilled)
-  if(!fAODMap)MapAODtracks(event);//fill the AOD index map if it is not yet done
+  gRecoCandCache.Update(event);
+  if(gRecoCandCache.HasFailed(rd,2,fSecVtxWithKF,event->GetMagneticField()))return kFALSE;//refill already failed in a previous task
 
   Double_t dispersion;
-  TObjArray *twoTrackArray1    = new TObjArray(2);
-
-  AliAODTrack *track1 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(0)]);//retrieve daughter from the trackID through the AOD index map
-  if(!track1)return kFALSE;
-  AliAODTrack *track2 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(1)]);
-  if(!track2)return kFALSE;
 
-  AliESDtrack *esdt1 = 0;
-  AliESDtrack *esdt2 = 0;
-  esdt1 = new AliESDtrack(track1);
-  esdt2 = new AliESDtrack(track2);
+  AliESDtrack *cached1 = GetRecoCandDaughter(event,rd->GetProngID(0));//retrieve daughter from the trackID through the AOD index map
+  AliESDtrack *cached2 = GetRecoCandDaughter(event,rd->GetProngID(1));
+  if(!cached1 || !cached2){
+    gRecoCandCache.SetFailed(rd,2,fSecVtxWithKF,event->GetMagneticField());
+    return kFALSE;
+  }
+  TObjArray *twoTrackArray1    = new TObjArray(2);
+  AliESDtrack *esdt1 = new AliESDtrack(*cached1);
+  AliESDtrack *esdt2 = new AliESDtrack(*cached2);
 
   twoTrackArray1->AddAt(esdt1,0);
   twoTrackArray1->AddAt(esdt2,1);
@@ -1803,6 +1876,7 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF2P
 
   AliAODVertex *vtxRec = ReconstructSecondaryVertex(twoTrackArray1, dispersion);
   if(!vtxRec) {
+    gRecoCandCache.SetFailed(rd,2,fSecVtxWithKF,event->GetMagneticField());
     twoTrackArray1->Clear();
     twoTrackArray1->Delete();  delete twoTrackArray1;
     delete fV1; fV1=0;
@@ -2748,6 +2822,35 @@ AliAODRecoDecayHF4Prong* AliAnalysisVertexingHF::Make4Prong(
   return the4Prong;
 }
 //----------------------------------------------------------------------------------
+AliESDtrack* AliAnalysisVertexingHF::GetRecoCandDaughter(AliVEvent *event,Int_t id) const {
+  /// Returns the AliESDtrack conversion of the AOD track with the given ID.
+  /// The conversion is done once per event and shared by all the instances;
+  /// it is owned by the cache and must be copied before being modified.
+  if(id<0 || id>=100000) return 0;
+  if(gRecoCandCache.fIndex.empty()) {
+    // same selection and convention as MapAODtracks
+    gRecoCandCache.fIndex.assign(100000,0);
+    gRecoCandCache.fTracks.assign(100000,(AliESDtrack*)0);
+    for(Int_t i=0; i<event->GetNumberOfTracks(); i++) {
+      AliAODTrack *track = dynamic_cast<AliAODTrack*>(event->GetTrack(i));
+      if(!track) AliFatal("Not a standard AOD");
+      if(track->GetStatus()&AliESDtrack::kITSpureSA) continue;
+      if(!(track->GetStatus()&AliESDtrack::kITSin)) continue;
+      Double_t covtest[21];
+      if(!track->GetCovarianceXYZPxPyPz(covtest)) continue;
+      Int_t ind = (Int_t)track->GetID();
+      if (ind>-1 && ind < 100000) gRecoCandCache.fIndex[ind] = i;
+    }
+  }
+  AliESDtrack *esdt = gRecoCandCache.fTracks[id];
+  if(esdt) return esdt;
+  AliAODTrack *track = (AliAODTrack*)event->GetTrack(gRecoCandCache.fIndex[id]);
+  if(!track) return 0;
+  esdt = new AliESDtrack(track);
+  gRecoCandCache.fTracks[id] = esdt;
+  return esdt;
+}
+//----------------------------------------------------------------------------------
 void AliAnalysisVertexingHF::MapAODtracks(AliVEvent *aod){
   //assign and save in fAODMap the index of the AliAODTrack track
   //ordering them on the basis of selected criteria
@@ -190,8 +190,7 @@ void AliEmcalJetUtilityConstSubtractor::Terminate(AliFJWrapper& fjw)
   }
 
 #ifdef FASTJET_VERSION
-  std::vector<fastjet::PseudoJet> jets_sub;
-  jets_sub = fjw.GetConstituentSubtrJets();
+  const std::vector<fastjet::PseudoJet>& jets_sub = fjw.GetConstituentSubtrJets();
   AliDebug(1,Form("%d constituent subtracted jets found", (Int_t)jets_sub.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_sub.size(); ++ijet) {
     //Only storing 4-vector and jet area of unsubtracted jet
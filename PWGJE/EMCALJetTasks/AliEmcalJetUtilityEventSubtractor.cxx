@@ -183,8 +183,7 @@ void AliEmcalJetUtilityEventSubtractor::Terminate(AliFJWrapper& fjw)
   }
 
 #ifdef FASTJET_VERSION
-  std::vector<fastjet::PseudoJet> jets_event_sub;
-  jets_event_sub = fjw.GetEventSubJets();
+  const std::vector<fastjet::PseudoJet>& jets_event_sub = fjw.GetEventSubJets();
   AliDebug(1,Form("%d event constituent subtracted jets found", (Int_t)jets_event_sub.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_event_sub.size(); ++ijet) {
     //printf("Jet pt = %f, area = %f", jets_event_sub[ijet].perp(), fjw.GetEventSubJetArea(ijet));
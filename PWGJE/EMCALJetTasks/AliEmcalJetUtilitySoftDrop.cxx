@@ -169,11 +169,10 @@ void AliEmcalJetUtilitySoftDrop::ProcessJet(AliEmcalJet* jet, Int_t ij, AliFJWra
 
   #ifdef FASTJET_VERSION
 
-  std::vector<fastjet::PseudoJet> jets_inclusive;
-  std::vector<fastjet::PseudoJet> jets_groomed;
-  jets_inclusive = fjw.GetInclusiveJets();
+  // the groomed jets of the event are computed once in Prepare(), no copy per jet
+  const std::vector<fastjet::PseudoJet>& jets_inclusive = fjw.GetInclusiveJets();
   Int_t ninc = (Int_t)jets_inclusive.size();
-  jets_groomed = fjw.GetGroomedJets();
+  const std::vector<fastjet::PseudoJet>& jets_groomed = fjw.GetGroomedJets();
   Int_t ngrmd = (Int_t)jets_groomed.size();
   if( (ngrmd > 0) && (ij<ngrmd) ) {
 
@@ -13,6 +13,31 @@
 class AliFJWrapper
 {
  public:
+  // Jet shapes for DoGenericSubtractionJetShapes(), to be combined with |
+  enum EGenSubJetShape_t {
+    kGenSubJetMass                  = BIT(0),
+    kGenSubJetAngularity            = BIT(1),
+    kGenSubJetpTD                   = BIT(2),
+    kGenSubJetCircularity           = BIT(3),
+    kGenSubJetSigma2                = BIT(4),
+    kGenSubJetConstituent           = BIT(5),
+    kGenSubJetLeSub                 = BIT(6),
+    kGenSubJet1subjettiness_kt      = BIT(7),
+    kGenSubJet2subjettiness_kt      = BIT(8),
+    kGenSubJet3subjettiness_kt      = BIT(9),
+    kGenSubJetOpeningAngle_kt       = BIT(10),
+    kGenSubJet1subjettiness_ca      = BIT(11),
+    kGenSubJet2subjettiness_ca      = BIT(12),
+    kGenSubJetOpeningAngle_ca       = BIT(13),
+    kGenSubJet1subjettiness_akt02   = BIT(14),
+    kGenSubJet2subjettiness_akt02   = BIT(15),
+    kGenSubJetOpeningAngle_akt02    = BIT(16),
+    kGenSubJet1subjettiness_onepassca = BIT(17),
+    kGenSubJet2subjettiness_onepassca = BIT(18),
+    kGenSubJetOpeningAngle_onepassca  = BIT(19)
+  };
+  enum { kNGenSubJetShapes = 20 };
+
   AliFJWrapper(const char *name, const char *title);
   virtual ~AliFJWrapper();
 
@@ -53,29 +78,30 @@ class AliFJWrapper
   Double_t                                NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
   Double32_t                              NSubjettinessDerivativeSub(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Double_t JetR, fastjet::PseudoJet jet, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
 #ifdef FASTJET_VERSION
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetMass()        const {return fGenSubtractorInfoJetMass        ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetAngularity()  const {return fGenSubtractorInfoJetAngularity  ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetpTD()         const {return fGenSubtractorInfoJetpTD         ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetCircularity() const {return fGenSubtractorInfoJetCircularity ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetSigma2()      const {return fGenSubtractorInfoJetSigma2      ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetConstituent() const {return fGenSubtractorInfoJetConstituent ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetLeSub()       const {return fGenSubtractorInfoJetLeSub       ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJet1subjettiness_kt()       const {return fGenSubtractorInfoJet1subjettiness_kt ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJet2subjettiness_kt()       const {return fGenSubtractorInfoJet2subjettiness_kt ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJet3subjettiness_kt()       const {return fGenSubtractorInfoJet3subjettiness_kt ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetOpeningAngle_kt()       const {return fGenSubtractorInfoJetOpeningAngle_kt ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJet1subjettiness_ca()       const {return fGenSubtractorInfoJet1subjettiness_ca ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJet2subjettiness_ca()       const {return fGenSubtractorInfoJet2subjettiness_ca ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetOpeningAngle_ca()       const {return fGenSubtractorInfoJetOpeningAngle_ca ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJet1subjettiness_akt02()       const {return fGenSubtractorInfoJet1subjettiness_akt02 ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJet2subjettiness_akt02()       const {return fGenSubtractorInfoJet2subjettiness_akt02 ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetOpeningAngle_akt02()       const {return fGenSubtractorInfoJetOpeningAngle_akt02 ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJet1subjettiness_onepassca()       const {return fGenSubtractorInfoJet1subjettiness_onepassca ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJet2subjettiness_onepassca()       const {return fGenSubtractorInfoJet2subjettiness_onepassca ; }
-  const std::vector<fastjet::contrib::GenericSubtractorInfo> GetGenSubtractorInfoJetOpeningAngle_onepassca()       const {return fGenSubtractorInfoJetOpeningAngle_onepassca ; }
-  const std::vector<fastjet::PseudoJet>                      GetConstituentSubtrJets()            const {return fConstituentSubtrJets            ; }
-  const std::vector<fastjet::PseudoJet>                      GetGroomedJets()            const {return fGroomedJets            ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetMass()        const {return fGenSubtractorInfoJetMass        ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetAngularity()  const {return fGenSubtractorInfoJetAngularity  ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetpTD()         const {return fGenSubtractorInfoJetpTD         ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetCircularity() const {return fGenSubtractorInfoJetCircularity ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetSigma2()      const {return fGenSubtractorInfoJetSigma2      ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetConstituent() const {return fGenSubtractorInfoJetConstituent ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetLeSub()       const {return fGenSubtractorInfoJetLeSub       ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJet1subjettiness_kt()       const {return fGenSubtractorInfoJet1subjettiness_kt ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJet2subjettiness_kt()       const {return fGenSubtractorInfoJet2subjettiness_kt ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJet3subjettiness_kt()       const {return fGenSubtractorInfoJet3subjettiness_kt ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetOpeningAngle_kt()       const {return fGenSubtractorInfoJetOpeningAngle_kt ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJet1subjettiness_ca()       const {return fGenSubtractorInfoJet1subjettiness_ca ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJet2subjettiness_ca()       const {return fGenSubtractorInfoJet2subjettiness_ca ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetOpeningAngle_ca()       const {return fGenSubtractorInfoJetOpeningAngle_ca ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJet1subjettiness_akt02()       const {return fGenSubtractorInfoJet1subjettiness_akt02 ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJet2subjettiness_akt02()       const {return fGenSubtractorInfoJet2subjettiness_akt02 ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetOpeningAngle_akt02()       const {return fGenSubtractorInfoJetOpeningAngle_akt02 ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJet1subjettiness_onepassca()       const {return fGenSubtractorInfoJet1subjettiness_onepassca ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJet2subjettiness_onepassca()       const {return fGenSubtractorInfoJet2subjettiness_onepassca ; }
+  const std::vector<fastjet::contrib::GenericSubtractorInfo>& GetGenSubtractorInfoJetOpeningAngle_onepassca()       const {return fGenSubtractorInfoJetOpeningAngle_onepassca ; }
+  const std::vector<fastjet::PseudoJet>&                     GetConstituentSubtrJets()            const {return fConstituentSubtrJets            ; }
+  const std::vector<fastjet::PseudoJet>&                     GetGroomedJets()            const {return fGroomedJets            ; }
   Int_t CreateGenSub();          // fastjet::contrib::GenericSubtractor
+  Int_t PrepareGenSub();         // reuse the GenericSubtractor and background of the event if the background did not change
   Int_t CreateConstituentSub();  // fastjet::contrib::ConstituentSubtractor
   Int_t CreateEventConstituentSub(); //fastjet::contrib::ConstituentSubtractor
   Int_t CreateSoftDrop();
@@ -90,6 +116,7 @@ class AliFJWrapper
   virtual Int_t Run();
   virtual Int_t Filter();
   virtual void  DoGenericSubtraction(const fastjet::FunctionOfPseudoJet<Double32_t>& jetshape, std::vector<fastjet::contrib::GenericSubtractorInfo>& output);
+  virtual Int_t DoGenericSubtractionJetShapes(UInt_t shapes);
   virtual Int_t DoGenericSubtractionJetMass();
   virtual Int_t DoGenericSubtractionGR(Int_t ijet);
   virtual Int_t DoGenericSubtractionJetAngularity();
@@ -229,6 +256,9 @@ class AliFJWrapper
   Bool_t                                   fUseExternalBkg;       //!
   Double_t                                 fRho;                  //  pT background density
   Double_t                                 fRhom;                 //  mT background density
+  Bool_t                                   fGenSubUseExternalBkg; //! background used by fGenSubtractor
+  Double_t                                 fGenSubRho;            //! rho used by fGenSubtractor
+  Double_t                                 fGenSubRhom;           //! rho_m used by fGenSubtractor
   Double_t                                 fRMax;             //!
   Double_t                                 fDRStep;           //!
   std::vector<double>                      fGRNumerator;      //!
@@ -333,6 +363,9 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fUseExternalBkg    (false) 
   , fRho               (0)
   , fRhom              (0)
+  , fGenSubUseExternalBkg(false)
+  , fGenSubRho         (0)
+  , fGenSubRhom        (0)
   , fRMax(2.)
   , fDRStep(0.04)
   , fGRNumerator()
@@ -759,6 +792,8 @@ Int_t AliFJWrapper::Run()
   // FJ3 :: Define an JetMedianBackgroundEstimator just in case it will be used
 #ifdef FASTJET_VERSION
   fBkrdEstimator     = new fj::JetMedianBackgroundEstimator(fj::SelectorAbsRapMax(fMaxRap));
+  // the generic subtractor of the previous event refers to its estimator
+  if (fGenSubtractor) { delete fGenSubtractor; fGenSubtractor = NULL; }
 #endif
 
   if (fLegacyMode) { SetLegacyFJ(); } // for FJ 2.x even if fLegacyMode is set, SetLegacyFJ is dummy
@@ -889,7 +924,7 @@ void AliFJWrapper::SubtractBackground(Double_t median_pt)
 void AliFJWrapper::DoGenericSubtraction(const fastjet::FunctionOfPseudoJet<Double32_t>& jetshape, std::vector<fastjet::contrib::GenericSubtractorInfo>& output) {
   //Do generic subtraction for 1subjettiness
 #ifdef FASTJET_VERSION
-  CreateGenSub();
+  PrepareGenSub();
   
   // clear the generic subtractor info vector
   output.clear();
@@ -902,11 +937,83 @@ void AliFJWrapper::DoGenericSubtraction(const fastjet::FunctionOfPseudoJet<Doubl
 #endif
 }
 
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::DoGenericSubtractionJetShapes(UInt_t shapes) {
+  // Do generic subtraction for several jet shapes (EGenSubJetShape_t) in one pass over the jets:
+  // the subtractor and its background are shared, all shapes of a jet are evaluated in a row.
+  // The results are the same as with the DoGenericSubtractionJet*() of each shape.
+#ifdef FASTJET_VERSION
+  PrepareGenSub();
+
+  // Define jet shapes, same order as EGenSubJetShape_t
+  AliJetShapeMass                    shapeMass;
+  AliJetShapeAngularity              shapeAngularity;
+  AliJetShapepTD                     shapepTD;
+  AliJetShapeCircularity             shapecircularity;
+  AliJetShapeSigma2                  shapesigma2;
+  AliJetShapeConstituent             shapeconst;
+  AliJetShapeLeSub                   shapeLeSub;
+  AliJetShape1subjettiness_kt        shape1subjettiness_kt;
+  AliJetShape2subjettiness_kt        shape2subjettiness_kt;
+  AliJetShape3subjettiness_kt        shape3subjettiness_kt;
+  AliJetShapeOpeningAngle_kt         shapeOpeningAngle_kt;
+  AliJetShape1subjettiness_ca        shape1subjettiness_ca;
+  AliJetShape2subjettiness_ca        shape2subjettiness_ca;
+  AliJetShapeOpeningAngle_ca         shapeOpeningAngle_ca;
+  AliJetShape1subjettiness_akt02     shape1subjettiness_akt02;
+  AliJetShape2subjettiness_akt02     shape2subjettiness_akt02;
+  AliJetShapeOpeningAngle_akt02      shapeOpeningAngle_akt02;
+  AliJetShape1subjettiness_onepassca shape1subjettiness_onepassca;
+  AliJetShape2subjettiness_onepassca shape2subjettiness_onepassca;
+  AliJetShapeOpeningAngle_onepassca  shapeOpeningAngle_onepassca;
+
+  const fj::FunctionOfPseudoJet<Double32_t>* jetshape[kNGenSubJetShapes] = {
+    &shapeMass, &shapeAngularity, &shapepTD, &shapecircularity, &shapesigma2, &shapeconst, &shapeLeSub,
+    &shape1subjettiness_kt, &shape2subjettiness_kt, &shape3subjettiness_kt, &shapeOpeningAngle_kt,
+    &shape1subjettiness_ca, &shape2subjettiness_ca, &shapeOpeningAngle_ca,
+    &shape1subjettiness_akt02, &shape2subjettiness_akt02, &shapeOpeningAngle_akt02,
+    &shape1subjettiness_onepassca, &shape2subjettiness_onepassca, &shapeOpeningAngle_onepassca
+  };
+  std::vector<fj::contrib::GenericSubtractorInfo>* output[kNGenSubJetShapes] = {
+    &fGenSubtractorInfoJetMass, &fGenSubtractorInfoJetAngularity, &fGenSubtractorInfoJetpTD,
+    &fGenSubtractorInfoJetCircularity, &fGenSubtractorInfoJetSigma2, &fGenSubtractorInfoJetConstituent,
+    &fGenSubtractorInfoJetLeSub,
+    &fGenSubtractorInfoJet1subjettiness_kt, &fGenSubtractorInfoJet2subjettiness_kt,
+    &fGenSubtractorInfoJet3subjettiness_kt, &fGenSubtractorInfoJetOpeningAngle_kt,
+    &fGenSubtractorInfoJet1subjettiness_ca, &fGenSubtractorInfoJet2subjettiness_ca, &fGenSubtractorInfoJetOpeningAngle_ca,
+    &fGenSubtractorInfoJet1subjettiness_akt02, &fGenSubtractorInfoJet2subjettiness_akt02, &fGenSubtractorInfoJetOpeningAngle_akt02,
+    &fGenSubtractorInfoJet1subjettiness_onepassca, &fGenSubtractorInfoJet2subjettiness_onepassca,
+    &fGenSubtractorInfoJetOpeningAngle_onepassca
+  };
+
+  // clear the generic subtractor info vectors of the selected shapes
+  Int_t selected[kNGenSubJetShapes];
+  Int_t nselected = 0;
+  for (Int_t s = 0; s < kNGenSubJetShapes; s++) {
+    if (!(shapes & BIT(s))) continue;
+    output[s]->clear();
+    output[s]->reserve(fInclusiveJets.size());
+    selected[nselected++] = s;
+  }
+
+  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
+    Bool_t subtract = fInclusiveJets[i].perp()>1.e-4;
+    for (Int_t k = 0; k < nselected; k++) {
+      fj::contrib::GenericSubtractorInfo info;
+      if (subtract)
+        (*fGenSubtractor)(*jetshape[selected[k]], fInclusiveJets[i], info);
+      output[selected[k]]->push_back(info);
+    }
+  }
+#endif
+  return 0;
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoGenericSubtractionJetMass() {
   //Do generic subtraction for jet mass
 #ifdef FASTJET_VERSION
-  CreateGenSub();
+  PrepareGenSub();
 
   // Define jet shape
   AliJetShapeMass shapeMass;
@@ -927,7 +1034,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetMass() {
 Int_t AliFJWrapper::DoGenericSubtractionGR(Int_t ijet) {
   //Do generic subtraction for jet mass
 #ifdef FASTJET_VERSION
-  CreateGenSub();
+  PrepareGenSub();
 
   if(ijet>fInclusiveJets.size()) return 0;
 
@@ -964,7 +1071,7 @@ Int_t AliFJWrapper::DoGenericSubtractionGR(Int_t ijet) {
 Int_t AliFJWrapper::DoGenericSubtractionJetAngularity() {
   //Do generic subtraction for jet mass
 #ifdef FASTJET_VERSION
-  CreateGenSub();
+  PrepareGenSub();
 
   // Define jet shape
   AliJetShapeAngularity shapeAngularity;
@@ -984,7 +1091,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetAngularity() {
 Int_t AliFJWrapper::DoGenericSubtractionJetpTD() {
   //Do generic subtraction for jet mass
 #ifdef FASTJET_VERSION
-  CreateGenSub();
+  PrepareGenSub();
 
   // Define jet shape
   AliJetShapepTD shapepTD;
@@ -1004,7 +1111,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetpTD() {
 Int_t AliFJWrapper::DoGenericSubtractionJetCircularity() {
   //Do generic subtraction for jet mass
 #ifdef FASTJET_VERSION
-  CreateGenSub();
+  PrepareGenSub();
 
   // Define jet shape
   AliJetShapeCircularity shapecircularity;
@@ -1024,7 +1131,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetCircularity() {
 Int_t AliFJWrapper::DoGenericSubtractionJetSigma2() {
   //Do generic subtraction for jet mass
 #ifdef FASTJET_VERSION
-  CreateGenSub();
+  PrepareGenSub();
 
   // Define jet shape
   AliJetShapeSigma2 shapesigma2;
@@ -1044,7 +1151,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetSigma2() {
 Int_t AliFJWrapper::DoGenericSubtractionJetConstituent() {
   //Do generic subtraction for jet mass
 #ifdef FASTJET_VERSION
-  CreateGenSub();
+  PrepareGenSub();
 
   // Define jet shape
   AliJetShapeConstituent shapeconst;
@@ -1065,7 +1172,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetConstituent() {
 Int_t AliFJWrapper::DoGenericSubtractionJetLeSub() {
   //Do generic subtraction for jet mass
 #ifdef FASTJET_VERSION
-  CreateGenSub();
+  PrepareGenSub();
 
   // Define jet shape
   AliJetShapeLeSub shapeLeSub;
@@ -1229,6 +1336,7 @@ Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_onepassca() {
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoConstituentSubtraction() {
   //Do constituent subtraction
+  //one subtractor and one pass over the jets per event, nothing to share with the generic subtraction
 #ifdef FASTJET_VERSION
   CreateConstituentSub();
   // fConstituentSubtractor->set_alpha(/* double alpha */);
@@ -1264,6 +1372,7 @@ Int_t AliFJWrapper::DoEventConstituentSubtraction() {
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoSoftDrop() {
   //Do grooming
+  //once per event, the groomed jets are shared with AliEmcalJetUtilitySoftDrop::ProcessJet() by reference
 #ifdef FASTJET_VERSION
   CreateSoftDrop();
 
@@ -1308,20 +1417,51 @@ Int_t AliFJWrapper::CreateGenSub() {
   #ifdef FASTJET_VERSION
   if (fGenSubtractor) { delete fGenSubtractor; } // protect against memory leaks
 
+  fGenSubtractor = NULL;
   if (fUseExternalBkg)
     { fGenSubtractor   = new fj::contrib::GenericSubtractor(fRho,fRhom); }
   else
     {
-    fGenSubtractor     = new fj::contrib::GenericSubtractor(fBkrdEstimator);
     #if FASTJET_VERSION_NUMBER >= 30100
-    fGenSubtractor->set_common_bge_for_rho_and_rhom(); // see contrib 1.020 GenericSubtractor.hh line 62
+    // Estimate the background of the event once here, instead of querying the estimator in the
+    // subtraction of each shape of each jet: the estimator has no rescaling, rho(jet) = rho()
+    try {
+      Double_t rho  = fBkrdEstimator->rho();
+      Double_t rhom = fBkrdEstimator->rho_m(); // common estimator for rho and rho_m
+      fGenSubtractor = new fj::contrib::GenericSubtractor(rho,rhom);
+    } catch (fj::Error) {
+      // leave it to the subtractor to query the estimator, as before
+      fGenSubtractor = NULL;
+    }
     #endif
+    if (!fGenSubtractor) {
+      fGenSubtractor     = new fj::contrib::GenericSubtractor(fBkrdEstimator);
+      #if FASTJET_VERSION_NUMBER >= 30100
+      fGenSubtractor->set_common_bge_for_rho_and_rhom(); // see contrib 1.020 GenericSubtractor.hh line 62
+      #endif
+    }
     }
+  fGenSubUseExternalBkg = fUseExternalBkg;
+  fGenSubRho            = fRho;
+  fGenSubRhom           = fRhom;
 
   #endif
   return 0;
 }
 
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::PrepareGenSub() {
+  // Create the generic subtractor once per event and share it between all jet shapes and jets,
+  // with the background of the event evaluated once (see CreateGenSub()).
+  // It is created again only if the background changed in between (SetUseExternalBkg()).
+  #ifdef FASTJET_VERSION
+  if (fGenSubtractor && fGenSubUseExternalBkg == fUseExternalBkg &&
+      (!fUseExternalBkg || (fGenSubRho == fRho && fGenSubRhom == fRhom))) return 0;
+  return CreateGenSub();
+  #endif
+  return 0;
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::CreateConstituentSub() {
   //Do generic subtraction for jet mass
@@ -19,6 +19,7 @@
 #include "AliPIDResponse.h"
 #include "AliESDpid.h"
 #include "AliAODpidUtil.h"
+#include "AliPIDResponseCache.h"
 
 #include "AliRsnCutPIDNSigma.h"
 
@@ -150,16 +151,17 @@ Bool_t AliRsnCutPIDNSigma::IsSelected(TObject *object)
    // get reference momentum
    fTrackMom = (fDetector == kTPC) ? vtrack->GetTPCmomentum() : vtrack->P();
 
-   // get number of sigmas
+   // get number of sigmas, shared with the other PID cuts of the train through the per-event cache
+   AliPIDResponseCache *pidCache = AliPIDResponseCache::Instance();
    switch (fDetector) {
       case kITS:
-         fTrackNSigma = TMath::Abs(pid->NumberOfSigmasITS(vtrack, fSpecies));
+         fTrackNSigma = TMath::Abs(pidCache->NumberOfSigmasITS(pid, vtrack, fSpecies));
          break;
       case kTPC:
-         fTrackNSigma = TMath::Abs(pid->NumberOfSigmasTPC(vtrack, fSpecies));
+         fTrackNSigma = TMath::Abs(pidCache->NumberOfSigmasTPC(pid, vtrack, fSpecies));
          break;
       case kTOF:
-         fTrackNSigma = TMath::Abs(pid->NumberOfSigmasTOF(vtrack, fSpecies));
+         fTrackNSigma = TMath::Abs(pidCache->NumberOfSigmasTOF(pid, vtrack, fSpecies));
          break;
       default:
          AliError("Bad detector chosen. Rejecting track");
@@ -63,6 +63,8 @@ class AliESDv0;
 class AliAODv0;
 
 #include <Riostream.h>
+#include <map>
+#include <vector>
 #include "TList.h"
 #include "TH1.h"
 #include "TH2.h"
@@ -120,6 +122,17 @@ class AliAODv0;
 using std::cout;
 using std::endl;
 
+namespace {
+    //Exponential parametrization of the variable cuts of the superlight mode:
+    //parameters as Float_t, sum in double precision, as in the configuration sweep
+    Double_t VarCutExpression(const std::vector<Float_t> *lPar, Int_t i, Float_t lPt)
+    {
+        return lPar[0][i]*TMath::Exp(lPar[1][i]*lPt) +
+        lPar[2][i]*TMath::Exp(lPar[3][i]*lPt) +
+        lPar[4][i];
+    }
+}
+
 ClassImp(AliAnalysisTaskStrangenessVsMultiplicityRun2)
 
 AliAnalysisTaskStrangenessVsMultiplicityRun2::AliAnalysisTaskStrangenessVsMultiplicityRun2()
@@ -462,7 +475,9 @@ fTreeCascVarMagneticField(0),
 
 //Histos
 fHistEventCounter(0),
-fHistCentrality(0)
+fHistCentrality(0),
+fV0CutTable(0x0),
+fCascadeCutTable(0x0)
 //------------------------------------------------
 // Tree Variables
 {
@@ -808,7 +823,9 @@ fTreeCascVarMagneticField(0),
 //Histos
 fHistEventCounter(0),
 fHistEventCounterDifferential(0),
-fHistCentrality(0)
+fHistCentrality(0),
+fV0CutTable(0x0),
+fCascadeCutTable(0x0)
 {
     
     //Re-vertex: Will only apply for cascade candidates
@@ -926,6 +943,14 @@ AliAnalysisTaskStrangenessVsMultiplicityRun2::~AliAnalysisTaskStrangenessVsMulti
         delete fRand;
         fRand = 0x0;
     }
+    if (fV0CutTable) {
+        delete fV0CutTable;
+        fV0CutTable = 0x0;
+    }
+    if (fCascadeCutTable) {
+        delete fCascadeCutTable;
+        fCascadeCutTable = 0x0;
+    }
 }
 
 //________________________________________________________________________
@@ -1386,6 +1411,10 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserCreateOutputObjects()
     
     AliWarning( Form("Initialized %i cascade output objects!", lTotalCfgs));
     
+    //Compile the configurations into cut tables
+    BuildV0CutTable();
+    BuildCascadeCutTable();
+    
     //Regular Output: Slots 1-6
     PostData(1, fListHist    );
     PostData(2, fListV0      );
@@ -2057,141 +2086,99 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         
-        //Step 1: Sweep members of the output object TList and fill all of them as appropriate
-        Int_t lNumberOfConfigurations = fListV0->GetEntries();
-        //AliWarning(Form("[V0 Analyses] Processing different configurations (%i detected)",lNumberOfConfigurations));
-        TH3F *histoout         = 0x0;
-        AliV0Result *lV0Result = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurations; lcfg++){
-            lV0Result = (AliV0Result*) fListV0->At(lcfg);
-            histoout  = lV0Result->GetHistogram();
-            
-            Float_t lMass = 0;
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBaryonMomentum = -0.5;
-            Float_t lBaryonPt = -0.5;
-            Float_t lBaryondEdxFromProton = 0;
-            
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lV0Result -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lV0Result->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lV0Result->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lV0Result->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lV0Result->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lV0Result->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                             lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeVariablePt) +
-                                             lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeVariablePt) +
-                                             lVarV0CosPApar[4]);
-            if( lV0Result->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
+        //Step 1: Test the candidate against all configurations, cut by cut (see BuildV0CutTable)
+        //Candidate values for each mass hypothesis (K0Short, Lambda, AntiLambda, unknown)
+        Float_t lMassH[4]               = { fTreeVariableInvMassK0s, fTreeVariableInvMassLambda, fTreeVariableInvMassAntiLambda, 0 };
+        Float_t lRapH[4]                = { fTreeVariableRapK0Short, fTreeVariableRapLambda, fTreeVariableRapLambda, 0 };
+        Float_t lPDGMassH[4]            = { 0.497, 1.115683, 1.115683, -1 };
+        Float_t lNegdEdxH[4]            = { fTreeVariableNSigmasNegPion, fTreeVariableNSigmasNegPion, fTreeVariableNSigmasNegProton, 100 };
+        Float_t lPosdEdxH[4]            = { fTreeVariableNSigmasPosPion, fTreeVariableNSigmasPosProton, fTreeVariableNSigmasPosPion, 100 };
+        Float_t lBaryonMomentumH[4]     = { -0.5, fTreeVariablePosInnerP, fTreeVariableNegInnerP, -0.5 };
+        Float_t lBaryonPtH[4]           = { -0.5, lThisPosInnerPt, lThisNegInnerPt, -0.5 };
+        Float_t lBaryondEdxFromProtonH[4] = { 0, fTreeVariableNSigmasPosProton, fTreeVariableNSigmasNegProton, 0 };
+        
+        Float_t lLifetimeH[4], lAbsNegdEdxH[4], lAbsPosdEdxH[4];
+        Bool_t l276TeVLikedEdxH[4];
+        for(Int_t ih=0; ih<4; ih++){
+            lLifetimeH[ih]   = fTreeVariableDistOverTotMom*lPDGMassH[ih];
+            lAbsNegdEdxH[ih] = TMath::Abs(lNegdEdxH[ih]);
+            lAbsPosdEdxH[ih] = TMath::Abs(lPosdEdxH[ih]);
+            l276TeVLikedEdxH[ih] = ( ih == AliV0Result::kK0Short ||
+                                    ( lBaryonPtH[ih] > 1.0 || TMath::Abs(lBaryondEdxFromProtonH[ih])<3.0 ) );
+        }
+        Bool_t lITSRefitTracks = ( (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) &&
+                                  (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit) );
+        Bool_t lAtLeastOneTOF  = ( TMath::Abs(fTreeVariableNegTOFSignal) < 100 ||
+                                  TMath::Abs(fTreeVariablePosTOFSignal) < 100 );
+        
+        V0CutTable &lCuts = *fV0CutTable;
+        const Int_t lNumberOfCutSets = lCuts.fHypo.size();
+        UChar_t *lPass = lNumberOfCutSets ? &lCuts.fPass[0] : 0x0;
+        const Int_t *lHypo = lNumberOfCutSets ? &lCuts.fHypo[0] : 0x0;
+        
+        //Check 1: Offline Vertexer
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++) lPass[ic] = ( lOnFlyStatus == lCuts.fUseOnTheFly[ic] );
+        
+        //Check 2: Basic Acceptance cuts
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lCuts.fMinEtaTracks[ic] < fTreeVariableNegEta && fTreeVariableNegEta < lCuts.fMaxEtaTracks[ic] &&
+                          lCuts.fMinEtaTracks[ic] < fTreeVariablePosEta && fTreeVariablePosEta < lCuts.fMaxEtaTracks[ic] );
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lRapH[lHypo[ic]] > lCuts.fMinRapidity[ic] && lRapH[lHypo[ic]] < lCuts.fMaxRapidity[ic] );
+        
+        //Check 3: Topological Variables
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( fTreeVariableV0Radius > lCuts.fV0Radius[ic] && fTreeVariableV0Radius < lCuts.fMaxV0Radius[ic] );
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( fTreeVariableDcaNegToPrimVertex > lCuts.fDCANegToPV[ic] &&
+                          fTreeVariableDcaPosToPrimVertex > lCuts.fDCAPosToPV[ic] &&
+                          fTreeVariableDcaV0Daughters < lCuts.fDCAV0Daughters[ic] );
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++){
+            //Variable V0 CosPA: only use if tighter than the non-variable cut
+            Float_t lV0CosPACut = lCuts.fV0CosPA[ic];
+            if( lCuts.fUseVarV0CosPA[ic] ){
+                Float_t lVarV0CosPA = TMath::Cos( VarCutExpression(lCuts.fVarV0CosPA, ic, fTreeVariablePt) );
                 if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
             }
-            //========================================================================
-            
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short     ){
-                lMass    = fTreeVariableInvMassK0s;
-                lRap     = fTreeVariableRapK0Short;
-                lPDGMass = 0.497;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kLambda      ){
-                lMass = fTreeVariableInvMassLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosProton;
-                lBaryonMomentum = fTreeVariablePosInnerP;
-                lBaryonPt = lThisPosInnerPt;
-                lBaryondEdxFromProton = fTreeVariableNSigmasPosProton;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kAntiLambda  ){
-                lMass = fTreeVariableInvMassAntiLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegProton;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-                lBaryonMomentum = fTreeVariableNegInnerP;
-                lBaryonPt = lThisNegInnerPt;
-                lBaryondEdxFromProton = fTreeVariableNSigmasNegProton;
-            }
-            
-            if (
-                //Check 1: Offline Vertexer
-                lOnFlyStatus == lV0Result->GetUseOnTheFly() &&
-                
-                //Check 2: Basic Acceptance cuts
-                lV0Result->GetCutMinEtaTracks() < fTreeVariableNegEta && fTreeVariableNegEta < lV0Result->GetCutMaxEtaTracks() &&
-                lV0Result->GetCutMinEtaTracks() < fTreeVariablePosEta && fTreeVariablePosEta < lV0Result->GetCutMaxEtaTracks() &&
-                lRap > lV0Result->GetCutMinRapidity() &&
-                lRap < lV0Result->GetCutMaxRapidity() &&
-                
-                //Check 3: Topological Variables
-                fTreeVariableV0Radius > lV0Result->GetCutV0Radius() &&
-                fTreeVariableV0Radius < lV0Result->GetCutMaxV0Radius() &&
-                fTreeVariableDcaNegToPrimVertex > lV0Result->GetCutDCANegToPV() &&
-                fTreeVariableDcaPosToPrimVertex > lV0Result->GetCutDCAPosToPV() &&
-                fTreeVariableDcaV0Daughters < lV0Result->GetCutDCAV0Daughters() &&
-                fTreeVariableV0CosineOfPointingAngle > lV0CosPACut &&
-                fTreeVariableDistOverTotMom*lPDGMass < lV0Result->GetCutProperLifetime() &&
-                fTreeVariableLeastNbrCrossedRows > lV0Result->GetCutLeastNumberOfCrossedRows() &&
-                fTreeVariableLeastRatioCrossedRowsOverFindable > lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() &&
-                
-                //Check 4: Minimum momentum of baryon daughter
-                ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short || lBaryonMomentum > lV0Result->GetCutMinBaryonMomentum() ) &&
-                
-                //Check 5: TPC dEdx selections
-                TMath::Abs(lNegdEdx)<lV0Result->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx)<lV0Result->GetCutTPCdEdx() &&
-                
-                //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
-                ( ( lV0Result->GetCutArmenteros() == kFALSE || lV0Result->GetMassHypothesis() != AliV0Result::kK0Short ) || ( fTreeVariablePtArmV0>lV0Result->GetCutArmenterosParameter()*TMath::Abs(fTreeVariableAlphaV0) ) ) &&
-                
-                //Check 7: kITSrefit track selection if requested
-                (
-                 ( (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit) )
-                 ||
-                 !lV0Result->GetCutUseITSRefitTracks()
-                 )&&
-                
-                //Check 8: Max Chi2/Clusters if not absurd
-                ( lV0Result->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeVariableMaxChi2PerCluster < lV0Result->GetCutMaxChi2PerCluster()
-                 ) &&
-                //Check 9: Min Track Length if positive
-                ( lV0Result->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeVariableMinTrackLength > lV0Result->GetCutMinTrackLength()
-                 )&&
-                
-                //Check 10: Special 2.76TeV-like dedx
-                // Logic: either not requested, or K0Short, or high-pT baryon daughter, or passes cut!
-                ( !lV0Result->GetCut276TeVLikedEdx() ||
-                 ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short ||
-                  ( lBaryonPt > 1.0 || TMath::Abs(lBaryondEdxFromProton)<3.0 )
-                  )
-                 )&&
-                
-                //Check 14: has at least one track with some TOF info, please (reject pileup)
-                //          warning: this is still to be studied in more detail!
-                (
-                 lV0Result->GetCutAtLeastOneTOF() == kFALSE ||
-                 (
-                  TMath::Abs(fTreeVariableNegTOFSignal) < 100 ||
-                  TMath::Abs(fTreeVariablePosTOFSignal) < 100
-                  )
-                 )
-                )
-            {
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeVariablePt, lMass );
-            }
+            lPass[ic] &= ( fTreeVariableV0CosineOfPointingAngle > lV0CosPACut );
+        }
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lLifetimeH[lHypo[ic]] < lCuts.fProperLifetime[ic] &&
+                          fTreeVariableLeastNbrCrossedRows > lCuts.fLeastNbrCrossedRows[ic] &&
+                          fTreeVariableLeastRatioCrossedRowsOverFindable > lCuts.fLeastRatioCrossedRows[ic] );
+        
+        //Check 4: Minimum momentum of baryon daughter
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lHypo[ic] == AliV0Result::kK0Short || lBaryonMomentumH[lHypo[ic]] > lCuts.fMinBaryonMomentum[ic] );
+        
+        //Check 5: TPC dEdx selections
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lAbsNegdEdxH[lHypo[ic]] < lCuts.fTPCdEdx[ic] && lAbsPosdEdxH[lHypo[ic]] < lCuts.fTPCdEdx[ic] );
+        
+        //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( ( !lCuts.fArmenteros[ic] || lHypo[ic] != AliV0Result::kK0Short ) ||
+                          ( fTreeVariablePtArmV0>lCuts.fArmenterosParameter[ic]*TMath::Abs(fTreeVariableAlphaV0) ) );
+        
+        //Check 7: kITSrefit track selection if requested
+        //Check 8: Max Chi2/Clusters if not absurd
+        //Check 9: Min Track Length if positive
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( ( lITSRefitTracks || !lCuts.fUseITSRefitTracks[ic] ) &&
+                          ( lCuts.fMaxChi2PerCluster[ic]>1e+3 || fTreeVariableMaxChi2PerCluster < lCuts.fMaxChi2PerCluster[ic] ) &&
+                          ( lCuts.fMinTrackLength[ic]<0 || fTreeVariableMinTrackLength > lCuts.fMinTrackLength[ic] ) );
+        
+        //Check 10: Special 2.76TeV-like dedx
+        //Check 14: has at least one track with some TOF info, please (reject pileup)
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( ( !lCuts.f276TeVLikedEdx[ic] || l276TeVLikedEdxH[lHypo[ic]] ) &&
+                          ( !lCuts.fAtLeastOneTOF[ic] || lAtLeastOneTOF ) );
+        
+        //Step 2: These satisfy all my conditionals! Fill histograms
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++){
+            if( !lPass[ic] ) continue;
+            const std::vector<TH3F*> &lHistos = lCuts.fHistos[ic];
+            for(size_t ih=0; ih<lHistos.size(); ih++) lHistos[ih] -> Fill ( fCentrality, fTreeVariablePt, lMassH[lHypo[ic]] );
         }
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
@@ -3034,348 +3021,194 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         
-        //Step 1: Sweep members of the output object TLists and fill all of them as appropriate
-        TH3F *histoout         = 0x0;
-        AliCascadeResult *lCascadeResult = 0x0;
-        
-        //pointers to valid results
-        AliCascadeResult *lPointers[50000];
-        Long_t lValidConfigurations=0;
-        
-        if( lValidXiMinus )
-            for( Int_t icfg=0; icfg<fListXiMinus->GetEntries(); icfg++ ){
-                lPointers[lValidConfigurations] = (AliCascadeResult*) fListXiMinus->At(icfg);
-                lValidConfigurations++;
-            }
-        if( lValidXiPlus )
-            for( Int_t icfg=0; icfg<fListXiPlus->GetEntries(); icfg++ ){
-                lPointers[lValidConfigurations] = (AliCascadeResult*) fListXiPlus->At(icfg);
-                lValidConfigurations++;
-            }
-        if( lValidOmegaMinus )
-            for( Int_t icfg=0; icfg<fListOmegaMinus->GetEntries(); icfg++ ){
-                lPointers[lValidConfigurations] = (AliCascadeResult*) fListOmegaMinus->At(icfg);
-                lValidConfigurations++;
-            }
-        if( lValidOmegaPlus )
-            for( Int_t icfg=0; icfg<fListOmegaPlus->GetEntries(); icfg++ ){
-                lPointers[lValidConfigurations] = (AliCascadeResult*) fListOmegaPlus->At(icfg);
-                lValidConfigurations++;
-            }
-        
-        for(Int_t lcfg=0; lcfg<lValidConfigurations; lcfg++){
-            lCascadeResult = lPointers[lcfg];
-            histoout  = lCascadeResult->GetHistogram();
-            
-            Float_t lMass = 0;
-            Float_t lV0Mass = 0;
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBachdEdx = 100;
-            Float_t lNegTOFsigma = 100;
-            Float_t lPosTOFsigma = 100;
-            Float_t lBachTOFsigma = 100;
-            Short_t  lCharge = -2;
-            Int_t lChargePos =  1;
-            Int_t lChargeNeg = -1;
-            Float_t lprpx, lprpy, lprpz, lpipx, lpipy, lpipz;
-            lpipx = fTreeCascVarBachPx;
-            lpipy = fTreeCascVarBachPy;
-            lpipz = fTreeCascVarBachPz;
-            
-            //For parametric V0 Mass selection
-            Float_t lExpV0Mass =
-            fLambdaMassMean[0]+
-            fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
-            fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
-            
-            Float_t lExpV0Sigma =
-            fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
-            fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
-            
-            //========================================================================
-            //For 2.76TeV-like parametric V0 CosPA
-            Float_t l276TeVV0CosPA = 0.998;
-            Float_t pThr=1.5;
-            if (lV0TotMomentum<pThr) {
-                //Below the threshold "pThr", try a momentum dependent cos(PA) cut
-                const Double_t bend=0.03; // approximate Xi bending angle
-                const Double_t qt=0.211;  // max Lambda pT in Omega decay
-                const Double_t cpaThr=TMath::Cos(TMath::ATan(qt/pThr) + bend);
-                Double_t
-                cpaCut=(0.998/cpaThr)*TMath::Cos(TMath::ATan(qt/lV0TotMomentum) + bend);
-                l276TeVV0CosPA = cpaCut;
-            }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable Cascade CosPA
-            Float_t lCascCosPACut = lCascadeResult -> GetCutCascCosPA();
-            Float_t lVarCascCosPApar[5];
-            lVarCascCosPApar[0] = lCascadeResult->GetCutVarCascCosPAExp0Const();
-            lVarCascCosPApar[1] = lCascadeResult->GetCutVarCascCosPAExp0Slope();
-            lVarCascCosPApar[2] = lCascadeResult->GetCutVarCascCosPAExp1Const();
-            lVarCascCosPApar[3] = lCascadeResult->GetCutVarCascCosPAExp1Slope();
-            lVarCascCosPApar[4] = lCascadeResult->GetCutVarCascCosPAConst();
-            Float_t lVarCascCosPA = TMath::Cos(
-                                               lVarCascCosPApar[0]*TMath::Exp(lVarCascCosPApar[1]*fTreeCascVarPt) +
-                                               lVarCascCosPApar[2]*TMath::Exp(lVarCascCosPApar[3]*fTreeCascVarPt) +
-                                               lVarCascCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarCascCosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarCascCosPA > lCascCosPACut ) lCascCosPACut = lVarCascCosPA;
-            }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lCascadeResult -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lCascadeResult->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lCascadeResult->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lCascadeResult->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lCascadeResult->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lCascadeResult->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                             lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeCascVarPt) +
-                                             lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeCascVarPt) +
-                                             lVarV0CosPApar[4]);
-            if( lCascadeResult->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
+        //Step 1: Test the candidate against all configurations, cut by cut (see BuildCascadeCutTable)
+        Bool_t lValidList[4] = { lValidXiMinus, lValidXiPlus, lValidOmegaMinus, lValidOmegaPlus };
+        
+        //For parametric V0 Mass selection
+        Float_t lExpV0Mass =
+        fLambdaMassMean[0]+
+        fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
+        fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
+        
+        Float_t lExpV0Sigma =
+        fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
+        fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
+        
+        //========================================================================
+        //For 2.76TeV-like parametric V0 CosPA
+        Float_t l276TeVV0CosPA = 0.998;
+        Float_t pThr=1.5;
+        if (lV0TotMomentum<pThr) {
+            //Below the threshold "pThr", try a momentum dependent cos(PA) cut
+            const Double_t bend=0.03; // approximate Xi bending angle
+            const Double_t qt=0.211;  // max Lambda pT in Omega decay
+            const Double_t cpaThr=TMath::Cos(TMath::ATan(qt/pThr) + bend);
+            Double_t
+            cpaCut=(0.998/cpaThr)*TMath::Cos(TMath::ATan(qt/lV0TotMomentum) + bend);
+            l276TeVV0CosPA = cpaCut;
+        }
+        //========================================================================
+        
+        //Candidate values for each mass hypothesis (XiMinus, XiPlus, OmegaMinus, OmegaPlus, unknown)
+        Float_t lMassH[5]        = { fTreeCascVarMassAsXi, fTreeCascVarMassAsXi, fTreeCascVarMassAsOmega, fTreeCascVarMassAsOmega, 0 };
+        Float_t lV0MassH[5]      = { fTreeCascVarV0MassLambda, fTreeCascVarV0MassAntiLambda, fTreeCascVarV0MassLambda, fTreeCascVarV0MassAntiLambda, 0 };
+        Float_t lRapH[5]         = { fTreeCascVarRapXi, fTreeCascVarRapXi, fTreeCascVarRapOmega, fTreeCascVarRapOmega, 0 };
+        Float_t lPDGMassH[5]     = { 1.32171, 1.32171, 1.67245, 1.67245, -1 };
+        Float_t lNegdEdxH[5]     = { fTreeCascVarNegNSigmaPion, fTreeCascVarNegNSigmaProton, fTreeCascVarNegNSigmaPion, fTreeCascVarNegNSigmaProton, 100 };
+        Float_t lPosdEdxH[5]     = { fTreeCascVarPosNSigmaProton, fTreeCascVarPosNSigmaPion, fTreeCascVarPosNSigmaProton, fTreeCascVarPosNSigmaPion, 100 };
+        Float_t lBachdEdxH[5]    = { fTreeCascVarBachNSigmaPion, fTreeCascVarBachNSigmaPion, fTreeCascVarBachNSigmaKaon, fTreeCascVarBachNSigmaKaon, 100 };
+        Float_t lNegTOFsigmaH[5] = { fTreeCascVarNegTOFNSigmaPion, fTreeCascVarNegTOFNSigmaProton, fTreeCascVarNegTOFNSigmaPion, fTreeCascVarNegTOFNSigmaProton, 100 };
+        Float_t lPosTOFsigmaH[5] = { fTreeCascVarPosTOFNSigmaProton, fTreeCascVarPosTOFNSigmaPion, fTreeCascVarPosTOFNSigmaProton, fTreeCascVarPosTOFNSigmaPion, 100 };
+        Float_t lBachTOFsigmaH[5]= { fTreeCascVarBachTOFNSigmaPion, fTreeCascVarBachTOFNSigmaPion, fTreeCascVarBachTOFNSigmaKaon, fTreeCascVarBachTOFNSigmaKaon, 100 };
+        
+        Double_t lV0MassWindowH[5];
+        Float_t lV0MassNSigmaH[5], lLifetimeH[5], lAbsNegdEdxH[5], lAbsPosdEdxH[5], lAbsBachdEdxH[5];
+        Bool_t lTOFH[5];
+        for(Int_t ih=0; ih<5; ih++){
+            lV0MassWindowH[ih] = TMath::Abs(lV0MassH[ih]-1.116);
+            lV0MassNSigmaH[ih] = TMath::Abs( (lV0MassH[ih]-lExpV0Mass) / lExpV0Sigma );
+            lLifetimeH[ih]     = fTreeCascVarDistOverTotMom*lPDGMassH[ih];
+            lAbsNegdEdxH[ih]   = TMath::Abs(lNegdEdxH[ih] );
+            lAbsPosdEdxH[ih]   = TMath::Abs(lPosdEdxH[ih] );
+            lAbsBachdEdxH[ih]  = TMath::Abs(lBachdEdxH[ih]);
+            lTOFH[ih]          = ( TMath::Abs(lNegTOFsigmaH[ih] )< 4 &&
+                                  TMath::Abs(lPosTOFsigmaH[ih] )< 4 &&
+                                  TMath::Abs(lBachTOFsigmaH[ih])< 4 );
+        }
+        Double_t lXiRejection    = TMath::Abs( fTreeCascVarMassAsXi - 1.32171 );
+        Double_t lCascDCAtoPV    = TMath::Sqrt(fTreeCascVarCascDCAtoPVz*fTreeCascVarCascDCAtoPVz + fTreeCascVarCascDCAtoPVxy*fTreeCascVarCascDCAtoPVxy);
+        Bool_t lNegITSRefit      = fTreeCascVarNegTrackStatus  & AliESDtrack::kITSrefit;
+        Bool_t lPosITSRefit      = fTreeCascVarPosTrackStatus  & AliESDtrack::kITSrefit;
+        Bool_t lBachITSRefit     = fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit;
+        Bool_t lAtLeastOneTOF    = ( TMath::Abs(fTreeCascVarNegTOFSignal) < 100 ||
+                                    TMath::Abs(fTreeCascVarPosTOFSignal) < 100 ||
+                                    TMath::Abs(fTreeCascVarBachTOFSignal) < 100 );
+        
+        CascadeCutTable &lCuts = *fCascadeCutTable;
+        const Int_t lNumberOfCutSets = lCuts.fHypo.size();
+        UChar_t *lPass = lNumberOfCutSets ? &lCuts.fPass[0] : 0x0;
+        const Int_t *lHypo = lNumberOfCutSets ? &lCuts.fHypo[0] : 0x0;
+        
+        //Check 1: Charge consistent with expectations
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] = ( lValidList[lCuts.fList[ic]] && fTreeCascVarCharge == lCuts.fCharge[ic] );
+        
+        //Check 2: Basic Acceptance cuts
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lCuts.fMinEtaTracks[ic] < fTreeCascVarPosEta && fTreeCascVarPosEta < lCuts.fMaxEtaTracks[ic] &&
+                          lCuts.fMinEtaTracks[ic] < fTreeCascVarNegEta && fTreeCascVarNegEta < lCuts.fMaxEtaTracks[ic] &&
+                          lCuts.fMinEtaTracks[ic] < fTreeCascVarBachEta && fTreeCascVarBachEta < lCuts.fMaxEtaTracks[ic] );
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lRapH[lHypo[ic]] > lCuts.fMinRapidity[ic] && lRapH[lHypo[ic]] < lCuts.fMaxRapidity[ic] );
+        
+        //Check 3: Topological Variables
+        // - V0 Selections
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( fTreeCascVarDCANegToPrimVtx > lCuts.fDCANegToPV[ic] &&
+                          fTreeCascVarDCAPosToPrimVtx > lCuts.fDCAPosToPV[ic] &&
+                          fTreeCascVarDCAV0Daughters < lCuts.fDCAV0Daughters[ic] &&
+                          fTreeCascVarV0Radius > lCuts.fV0Radius[ic] );
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++){
+            //Variable V0 CosPA: only use if tighter than the non-variable cut
+            Float_t lV0CosPACut = lCuts.fV0CosPA[ic];
+            if( lCuts.fUseVarV0CosPA[ic] ){
+                Float_t lVarV0CosPA = TMath::Cos( VarCutExpression(lCuts.fVarV0CosPA, ic, fTreeCascVarPt) );
                 if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
             }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable BB CosPA
-            Float_t lBBCosPACut = lCascadeResult -> GetCutBachBaryonCosPA();
-            Float_t lVarBBCosPApar[5];
-            lVarBBCosPApar[0] = lCascadeResult->GetCutVarBBCosPAExp0Const();
-            lVarBBCosPApar[1] = lCascadeResult->GetCutVarBBCosPAExp0Slope();
-            lVarBBCosPApar[2] = lCascadeResult->GetCutVarBBCosPAExp1Const();
-            lVarBBCosPApar[3] = lCascadeResult->GetCutVarBBCosPAExp1Slope();
-            lVarBBCosPApar[4] = lCascadeResult->GetCutVarBBCosPAConst();
-            Float_t lVarBBCosPA = TMath::Cos(
-                                             lVarBBCosPApar[0]*TMath::Exp(lVarBBCosPApar[1]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[2]*TMath::Exp(lVarBBCosPApar[3]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarBBCosPA() ){
-                //Only use if looser than the non-variable cut (WARNING: BEWARE INVERSE LOGIC)
-                if( lVarBBCosPA > lBBCosPACut ) lBBCosPACut = lVarBBCosPA;
-            }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable DCA Casc Dau
-            Float_t lDCACascDauCut = lCascadeResult -> GetCutDCACascDaughters();
-            Float_t lVarDCACascDaupar[5];
-            lVarDCACascDaupar[0] = lCascadeResult->GetCutVarDCACascDauExp0Const();
-            lVarDCACascDaupar[1] = lCascadeResult->GetCutVarDCACascDauExp0Slope();
-            lVarDCACascDaupar[2] = lCascadeResult->GetCutVarDCACascDauExp1Const();
-            lVarDCACascDaupar[3] = lCascadeResult->GetCutVarDCACascDauExp1Slope();
-            lVarDCACascDaupar[4] = lCascadeResult->GetCutVarDCACascDauConst();
-            Float_t lVarDCACascDau = lVarDCACascDaupar[0]*TMath::Exp(lVarDCACascDaupar[1]*fTreeCascVarPt) +
-            lVarDCACascDaupar[2]*TMath::Exp(lVarDCACascDaupar[3]*fTreeCascVarPt) +
-            lVarDCACascDaupar[4];
-            if( lCascadeResult->GetCutUseVarDCACascDau() ){
-                //Loosest: default cut, parametric can go tighter
+            lPass[ic] &= ( fTreeCascVarV0CosPointingAngle > lV0CosPACut );
+        }
+        // - Cascade Selections
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( fTreeCascVarDCAV0ToPrimVtx > lCuts.fDCAV0ToPV[ic] &&
+                          lV0MassWindowH[lHypo[ic]] < lCuts.fV0Mass[ic] &&
+                          fTreeCascVarDCABachToPrimVtx > lCuts.fDCABachToPV[ic] &&
+                          fTreeCascVarCascRadius > lCuts.fCascRadius[ic] );
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++){
+            //Variable DCA Casc Dau. Loosest: default cut, parametric can go tighter
+            Float_t lDCACascDauCut = lCuts.fDCACascDau[ic];
+            if( lCuts.fUseVarDCACascDau[ic] ){
+                Float_t lVarDCACascDau = VarCutExpression(lCuts.fVarDCACascDau, ic, fTreeCascVarPt);
                 if( lVarDCACascDau < lDCACascDauCut ) lDCACascDauCut = lVarDCACascDau;
             }
-            //========================================================================
-            
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiMinus     ){
-                lCharge  = -1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsXi;
-                lV0Mass  = fTreeCascVarV0MassLambda;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lNegTOFsigma = fTreeCascVarNegTOFNSigmaPion;
-                lPosTOFsigma = fTreeCascVarPosTOFNSigmaProton;
-                lBachTOFsigma = fTreeCascVarBachTOFNSigmaPion;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiPlus      ){
-                lCharge  = +1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsXi;
-                lV0Mass  = fTreeCascVarV0MassAntiLambda;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lNegTOFsigma = fTreeCascVarNegTOFNSigmaProton;
-                lPosTOFsigma = fTreeCascVarPosTOFNSigmaPion;
-                lBachTOFsigma = fTreeCascVarBachTOFNSigmaPion;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaMinus     ){
-                lCharge  = -1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lV0Mass  = fTreeCascVarV0MassLambda;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lNegTOFsigma = fTreeCascVarNegTOFNSigmaPion;
-                lPosTOFsigma = fTreeCascVarPosTOFNSigmaProton;
-                lBachTOFsigma = fTreeCascVarBachTOFNSigmaKaon;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaPlus      ){
-                lCharge  = +1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lV0Mass  = fTreeCascVarV0MassAntiLambda;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lNegTOFsigma = fTreeCascVarNegTOFNSigmaProton;
-                lPosTOFsigma = fTreeCascVarPosTOFNSigmaPion;
-                lBachTOFsigma = fTreeCascVarBachTOFNSigmaKaon;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-            
-            if (lCascadeResult->GetCutUseTOFUnchecked() == kFALSE ){
-                //Always-pass values
-                lNegTOFsigma = 0;
-                lPosTOFsigma = 0;
-                lBachTOFsigma = 0;
+            lPass[ic] &= ( fTreeCascVarDCACascDaughters < lDCACascDauCut );
+        }
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++){
+            //Variable Cascade CosPA: only use if tighter than the non-variable cut
+            Float_t lCascCosPACut = lCuts.fCascCosPA[ic];
+            if( lCuts.fUseVarCascCosPA[ic] ){
+                Float_t lVarCascCosPA = TMath::Cos( VarCutExpression(lCuts.fVarCascCosPA, ic, fTreeCascVarPt) );
+                if( lVarCascCosPA > lCascCosPACut ) lCascCosPACut = lVarCascCosPA;
             }
-            
-            if (
-                //Check 1: Charge consistent with expectations
-                fTreeCascVarCharge == lCharge &&
-                
-                //Check 2: Basic Acceptance cuts
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarPosEta && fTreeCascVarPosEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarNegEta && fTreeCascVarNegEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarBachEta && fTreeCascVarBachEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lRap > lCascadeResult->GetCutMinRapidity() &&
-                lRap < lCascadeResult->GetCutMaxRapidity() &&
-                
-                //Check 3: Topological Variables
-                // - V0 Selections
-                fTreeCascVarDCANegToPrimVtx > lCascadeResult->GetCutDCANegToPV() &&
-                fTreeCascVarDCAPosToPrimVtx > lCascadeResult->GetCutDCAPosToPV() &&
-                fTreeCascVarDCAV0Daughters < lCascadeResult->GetCutDCAV0Daughters() &&
-                fTreeCascVarV0CosPointingAngle > lV0CosPACut &&
-                fTreeCascVarV0Radius > lCascadeResult->GetCutV0Radius() &&
-                // - Cascade Selections
-                fTreeCascVarDCAV0ToPrimVtx > lCascadeResult->GetCutDCAV0ToPV() &&
-                TMath::Abs(lV0Mass-1.116) < lCascadeResult->GetCutV0Mass() &&
-                fTreeCascVarDCABachToPrimVtx > lCascadeResult->GetCutDCABachToPV() &&
-                fTreeCascVarDCACascDaughters < lDCACascDauCut &&
-                fTreeCascVarCascCosPointingAngle > lCascCosPACut &&
-                fTreeCascVarCascRadius > lCascadeResult->GetCutCascRadius() &&
-                
-                // - Implementation of a parametric V0 Mass cut if requested
-                (
-                 ( lCascadeResult->GetCutV0MassSigma() > 50 ) || //anything goes
-                 (TMath::Abs( (lV0Mass-lExpV0Mass) / lExpV0Sigma ) < lCascadeResult->GetCutV0MassSigma() )
-                 ) &&
-                
-                // - Miscellaneous
-                fTreeCascVarDistOverTotMom*lPDGMass < lCascadeResult->GetCutProperLifetime() &&
-                fTreeCascVarLeastNbrClusters > lCascadeResult->GetCutLeastNumberOfClusters() &&
-                
-                //Check 4: TPC dEdx selections
-                TMath::Abs(lNegdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lBachdEdx)<lCascadeResult->GetCutTPCdEdx() &&
-                
-                //Check 4bis: TOF selections (experimental)
-                //WARNING: if lCascadeResult->GetCutUseTOFUnchecked is false, the TOFsigmas will be zero: will always pass
-                TMath::Abs(lNegTOFsigma )< 4 &&
-                TMath::Abs(lPosTOFsigma )< 4 &&
-                TMath::Abs(lBachTOFsigma)< 4 &&
-                
-                //Check 5: Xi rejection for Omega analysis
-                ( ( lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaMinus && lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaPlus  ) || ( TMath::Abs( fTreeCascVarMassAsXi - 1.32171 ) > lCascadeResult->GetCutXiRejection() ) ) &&
-                
-                //Check 6: Experimental DCA Bachelor to Baryon cut
-                ( fTreeCascVarDCABachToBaryon > lCascadeResult->GetCutDCABachToBaryon() ) &&
-                
-                //Check 7: Experimental Bach Baryon CosPA
-                ( fTreeCascVarWrongCosPA < lBBCosPACut  ) &&
-                
-                //Check 8: Min/Max V0 Lifetime cut
-                ( ( fTreeCascVarV0Lifetime > lCascadeResult->GetCutMinV0Lifetime() ) &&
-                 ( fTreeCascVarV0Lifetime < lCascadeResult->GetCutMaxV0Lifetime() ||
-                  lCascadeResult->GetCutMaxV0Lifetime() > 1e+3 ) ) &&
-                
-                //Check 9: kITSrefit track selection if requested
-                (
-                 ( (fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit)
-                  )
-                 ||
-                 !lCascadeResult->GetCutUseITSRefitTracks()
-                 ) &&
-                
-                //Check 10: Max Chi2/Clusters if not absurd
-                ( lCascadeResult->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeCascVarMaxChi2PerCluster < lCascadeResult->GetCutMaxChi2PerCluster()
-                 )&&
-                
-                //Check 11: Min Track Length if positive
-                ( lCascadeResult->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeCascVarMinTrackLength > lCascadeResult->GetCutMinTrackLength()
-                 )&&
-                
-                //Check 12: Check if special V0 CosPA cut used
-                //either don't use the cut at all, or make sure it's above threshold
-                ( lCascadeResult->GetCutUse276TeVV0CosPA()==kFALSE ||
-                 fTreeCascVarV0CosPointingAngle>l276TeVV0CosPA
-                 )&&
-                
-                //Check 13: 3D Cascade DCA to PV
-                ( lCascadeResult->GetCutDCACascadeToPV() > 999 ||
-                 (TMath::Sqrt(fTreeCascVarCascDCAtoPVz*fTreeCascVarCascDCAtoPVz + fTreeCascVarCascDCAtoPVxy*fTreeCascVarCascDCAtoPVxy)<lCascadeResult->GetCutDCACascadeToPV() )
-                 )&&
-                
-                //Check 14: has at least one track with some TOF info, please (reject pileup)
-                //          warning: this is still to be studied in more detail!
-                (
-                 lCascadeResult->GetCutAtLeastOneTOF() == kFALSE ||
-                 (
-                  TMath::Abs(fTreeCascVarNegTOFSignal) < 100 ||
-                  TMath::Abs(fTreeCascVarPosTOFSignal) < 100 ||
-                  TMath::Abs(fTreeCascVarBachTOFSignal) < 100
-                  )
-                 )&&
-                
-                //Check 15: check each prong for ITS refit
-                (
-                 ( lCascadeResult->GetCutUseITSRefitNegative()==kFALSE || fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit ) &&
-                 ( lCascadeResult->GetCutUseITSRefitPositive()==kFALSE || fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit ) &&
-                 ( lCascadeResult->GetCutUseITSRefitBachelor()==kFALSE || fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit )
-                 )
-                
-                )//end major if
-            {
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeCascVarPt, lMass );
+            lPass[ic] &= ( fTreeCascVarCascCosPointingAngle > lCascCosPACut );
+        }
+        // - Implementation of a parametric V0 Mass cut if requested
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lCuts.fV0MassSigma[ic] > 50 || lV0MassNSigmaH[lHypo[ic]] < lCuts.fV0MassSigma[ic] );
+        // - Miscellaneous
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lLifetimeH[lHypo[ic]] < lCuts.fProperLifetime[ic] &&
+                          fTreeCascVarLeastNbrClusters > lCuts.fLeastNbrClusters[ic] );
+        
+        //Check 4: TPC dEdx selections
+        //Check 4bis: TOF selections (experimental), only if GetCutUseTOFUnchecked
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( lAbsNegdEdxH[lHypo[ic]] < lCuts.fTPCdEdx[ic] &&
+                          lAbsPosdEdxH[lHypo[ic]] < lCuts.fTPCdEdx[ic] &&
+                          lAbsBachdEdxH[lHypo[ic]] < lCuts.fTPCdEdx[ic] &&
+                          ( !lCuts.fUseTOFUnchecked[ic] || lTOFH[lHypo[ic]] ) );
+        
+        //Check 5: Xi rejection for Omega analysis
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( ( lHypo[ic] != AliCascadeResult::kOmegaMinus && lHypo[ic] != AliCascadeResult::kOmegaPlus ) ||
+                          lXiRejection > lCuts.fXiRejection[ic] );
+        
+        //Check 6: Experimental DCA Bachelor to Baryon cut
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( fTreeCascVarDCABachToBaryon > lCuts.fDCABachToBaryon[ic] );
+        
+        //Check 7: Experimental Bach Baryon CosPA
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++){
+            //Variable BB CosPA: only use if looser than the non-variable cut (WARNING: BEWARE INVERSE LOGIC)
+            Float_t lBBCosPACut = lCuts.fBBCosPA[ic];
+            if( lCuts.fUseVarBBCosPA[ic] ){
+                Float_t lVarBBCosPA = TMath::Cos( VarCutExpression(lCuts.fVarBBCosPA, ic, fTreeCascVarPt) );
+                if( lVarBBCosPA > lBBCosPACut ) lBBCosPACut = lVarBBCosPA;
             }
+            lPass[ic] &= ( fTreeCascVarWrongCosPA < lBBCosPACut );
+        }
+        
+        //Check 8: Min/Max V0 Lifetime cut
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( fTreeCascVarV0Lifetime > lCuts.fMinV0Lifetime[ic] &&
+                          ( fTreeCascVarV0Lifetime < lCuts.fMaxV0Lifetime[ic] || lCuts.fMaxV0Lifetime[ic] > 1e+3 ) );
+        
+        //Check 9: kITSrefit track selection if requested
+        //Check 15: check each prong for ITS refit
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( ( ( lPosITSRefit && lNegITSRefit && lBachITSRefit ) || !lCuts.fUseITSRefitTracks[ic] ) &&
+                          ( !lCuts.fUseITSRefitNegative[ic] || lNegITSRefit ) &&
+                          ( !lCuts.fUseITSRefitPositive[ic] || lPosITSRefit ) &&
+                          ( !lCuts.fUseITSRefitBachelor[ic] || lBachITSRefit ) );
+        
+        //Check 10: Max Chi2/Clusters if not absurd
+        //Check 11: Min Track Length if positive
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( ( lCuts.fMaxChi2PerCluster[ic]>1e+3 || fTreeCascVarMaxChi2PerCluster < lCuts.fMaxChi2PerCluster[ic] ) &&
+                          ( lCuts.fMinTrackLength[ic]<0 || fTreeCascVarMinTrackLength > lCuts.fMinTrackLength[ic] ) );
+        
+        //Check 12: Check if special V0 CosPA cut used
+        //Check 13: 3D Cascade DCA to PV
+        //Check 14: has at least one track with some TOF info, please (reject pileup)
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++)
+            lPass[ic] &= ( ( !lCuts.fUse276TeVV0CosPA[ic] || fTreeCascVarV0CosPointingAngle>l276TeVV0CosPA ) &&
+                          ( lCuts.fDCACascadeToPV[ic] > 999 || lCascDCAtoPV < lCuts.fDCACascadeToPV[ic] ) &&
+                          ( !lCuts.fAtLeastOneTOF[ic] || lAtLeastOneTOF ) );
+        
+        //Step 2: These satisfy all my conditionals! Fill histograms
+        for(Int_t ic=0; ic<lNumberOfCutSets; ic++){
+            if( !lPass[ic] ) continue;
+            const std::vector<TH3F*> &lHistos = lCuts.fHistos[ic];
+            for(size_t ih=0; ih<lHistos.size(); ih++) lHistos[ih] -> Fill ( fCentrality, fTreeCascVarPt, lMassH[lHypo[ic]] );
         }
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
@@ -3484,6 +3317,264 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::AddConfiguration( AliCascadeR
     }
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::BuildV0CutTable()
+//Superlight mode: compile the V0 configurations into a cut table.
+//Configurations with identical cuts share one entry and are filled together.
+{
+    if ( !fV0CutTable ) fV0CutTable = new V0CutTable();
+    *fV0CutTable = V0CutTable();
+    V0CutTable &lCuts = *fV0CutTable;
+    
+    std::map< std::vector<Double_t>, Int_t > lEntries;
+    Int_t lNumberOfConfigurations = fListV0 ? fListV0->GetEntries() : 0;
+    for(Int_t lcfg=0; lcfg<lNumberOfConfigurations; lcfg++){
+        AliV0Result *lV0Result = (AliV0Result*) fListV0->At(lcfg);
+        Int_t lHypo = lV0Result->GetMassHypothesis();
+        if ( lHypo < AliV0Result::kK0Short || lHypo > AliV0Result::kAntiLambda ) lHypo = 3;
+        
+        //Everything entering the selection
+        std::vector<Double_t> lKey;
+        lKey.push_back( lHypo );
+        lKey.push_back( lV0Result->GetUseOnTheFly() );
+        lKey.push_back( lV0Result->GetCutMinEtaTracks() );
+        lKey.push_back( lV0Result->GetCutMaxEtaTracks() );
+        lKey.push_back( lV0Result->GetCutMinRapidity() );
+        lKey.push_back( lV0Result->GetCutMaxRapidity() );
+        lKey.push_back( lV0Result->GetCutV0Radius() );
+        lKey.push_back( lV0Result->GetCutMaxV0Radius() );
+        lKey.push_back( lV0Result->GetCutDCANegToPV() );
+        lKey.push_back( lV0Result->GetCutDCAPosToPV() );
+        lKey.push_back( lV0Result->GetCutDCAV0Daughters() );
+        lKey.push_back( lV0Result->GetCutV0CosPA() );
+        lKey.push_back( lV0Result->GetCutUseVarV0CosPA() );
+        lKey.push_back( lV0Result->GetCutVarV0CosPAExp0Const() );
+        lKey.push_back( lV0Result->GetCutVarV0CosPAExp0Slope() );
+        lKey.push_back( lV0Result->GetCutVarV0CosPAExp1Const() );
+        lKey.push_back( lV0Result->GetCutVarV0CosPAExp1Slope() );
+        lKey.push_back( lV0Result->GetCutVarV0CosPAConst() );
+        lKey.push_back( lV0Result->GetCutProperLifetime() );
+        lKey.push_back( lV0Result->GetCutLeastNumberOfCrossedRows() );
+        lKey.push_back( lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() );
+        lKey.push_back( lV0Result->GetCutMinBaryonMomentum() );
+        lKey.push_back( lV0Result->GetCutTPCdEdx() );
+        lKey.push_back( lV0Result->GetCutArmenteros() );
+        lKey.push_back( lV0Result->GetCutArmenterosParameter() );
+        lKey.push_back( lV0Result->GetCutUseITSRefitTracks() );
+        lKey.push_back( lV0Result->GetCutMaxChi2PerCluster() );
+        lKey.push_back( lV0Result->GetCutMinTrackLength() );
+        lKey.push_back( lV0Result->GetCut276TeVLikedEdx() );
+        lKey.push_back( lV0Result->GetCutAtLeastOneTOF() );
+        
+        std::map< std::vector<Double_t>, Int_t >::iterator lEntry = lEntries.find(lKey);
+        if ( lEntry != lEntries.end() ){
+            lCuts.fHistos[lEntry->second].push_back( lV0Result->GetHistogram() );
+            continue;
+        }
+        lEntries[lKey] = lCuts.fHypo.size();
+        
+        lCuts.fHypo.push_back( lHypo );
+        lCuts.fUseOnTheFly.push_back( lV0Result->GetUseOnTheFly() );
+        lCuts.fMinEtaTracks.push_back( lV0Result->GetCutMinEtaTracks() );
+        lCuts.fMaxEtaTracks.push_back( lV0Result->GetCutMaxEtaTracks() );
+        lCuts.fMinRapidity.push_back( lV0Result->GetCutMinRapidity() );
+        lCuts.fMaxRapidity.push_back( lV0Result->GetCutMaxRapidity() );
+        lCuts.fV0Radius.push_back( lV0Result->GetCutV0Radius() );
+        lCuts.fMaxV0Radius.push_back( lV0Result->GetCutMaxV0Radius() );
+        lCuts.fDCANegToPV.push_back( lV0Result->GetCutDCANegToPV() );
+        lCuts.fDCAPosToPV.push_back( lV0Result->GetCutDCAPosToPV() );
+        lCuts.fDCAV0Daughters.push_back( lV0Result->GetCutDCAV0Daughters() );
+        lCuts.fV0CosPA.push_back( lV0Result->GetCutV0CosPA() );
+        lCuts.fUseVarV0CosPA.push_back( lV0Result->GetCutUseVarV0CosPA() );
+        lCuts.fVarV0CosPA[0].push_back( lV0Result->GetCutVarV0CosPAExp0Const() );
+        lCuts.fVarV0CosPA[1].push_back( lV0Result->GetCutVarV0CosPAExp0Slope() );
+        lCuts.fVarV0CosPA[2].push_back( lV0Result->GetCutVarV0CosPAExp1Const() );
+        lCuts.fVarV0CosPA[3].push_back( lV0Result->GetCutVarV0CosPAExp1Slope() );
+        lCuts.fVarV0CosPA[4].push_back( lV0Result->GetCutVarV0CosPAConst() );
+        lCuts.fProperLifetime.push_back( lV0Result->GetCutProperLifetime() );
+        lCuts.fLeastNbrCrossedRows.push_back( lV0Result->GetCutLeastNumberOfCrossedRows() );
+        lCuts.fLeastRatioCrossedRows.push_back( lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() );
+        lCuts.fMinBaryonMomentum.push_back( lV0Result->GetCutMinBaryonMomentum() );
+        lCuts.fTPCdEdx.push_back( lV0Result->GetCutTPCdEdx() );
+        lCuts.fArmenteros.push_back( lV0Result->GetCutArmenteros() );
+        lCuts.fArmenterosParameter.push_back( lV0Result->GetCutArmenterosParameter() );
+        lCuts.fUseITSRefitTracks.push_back( lV0Result->GetCutUseITSRefitTracks() );
+        lCuts.fMaxChi2PerCluster.push_back( lV0Result->GetCutMaxChi2PerCluster() );
+        lCuts.fMinTrackLength.push_back( lV0Result->GetCutMinTrackLength() );
+        lCuts.f276TeVLikedEdx.push_back( lV0Result->GetCut276TeVLikedEdx() );
+        lCuts.fAtLeastOneTOF.push_back( lV0Result->GetCutAtLeastOneTOF() );
+        lCuts.fHistos.push_back( std::vector<TH3F*>(1, lV0Result->GetHistogram()) );
+    }
+    lCuts.fPass.resize( lCuts.fHypo.size() );
+    
+    AliWarning( Form("Compiled %i V0 configurations into %i cut sets!", lNumberOfConfigurations, (Int_t)lCuts.fHypo.size()));
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::BuildCascadeCutTable()
+//Superlight mode: compile the cascade configurations of the four output lists
+//into a cut table. Configurations of the same list with identical cuts share
+//one entry and are filled together.
+{
+    if ( !fCascadeCutTable ) fCascadeCutTable = new CascadeCutTable();
+    *fCascadeCutTable = CascadeCutTable();
+    CascadeCutTable &lCuts = *fCascadeCutTable;
+    
+    TList *lLists[4] = { fListXiMinus, fListXiPlus, fListOmegaMinus, fListOmegaPlus };
+    std::map< std::vector<Double_t>, Int_t > lEntries;
+    Int_t lTotalCfgs = 0;
+    for(Int_t ilist=0; ilist<4; ilist++){
+        Int_t lNbrConfigs = lLists[ilist] ? lLists[ilist]->GetEntries() : 0;
+        lTotalCfgs += lNbrConfigs;
+        for(Int_t lcfg=0; lcfg<lNbrConfigs; lcfg++){
+            AliCascadeResult *lCascadeResult = (AliCascadeResult*) lLists[ilist]->At(lcfg);
+            Int_t lHypo = lCascadeResult->GetMassHypothesis();
+            if ( lHypo < AliCascadeResult::kXiMinus || lHypo > AliCascadeResult::kOmegaPlus ) lHypo = 4;
+            Int_t lCharge = -2;
+            if ( lHypo == AliCascadeResult::kXiMinus || lHypo == AliCascadeResult::kOmegaMinus ) lCharge = -1;
+            if ( lHypo == AliCascadeResult::kXiPlus  || lHypo == AliCascadeResult::kOmegaPlus  ) lCharge = +1;
+            if ( lCharge != -2 && lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
+            
+            //Everything entering the selection
+            std::vector<Double_t> lKey;
+            lKey.push_back( ilist );
+            lKey.push_back( lHypo );
+            lKey.push_back( lCharge );
+            lKey.push_back( lCascadeResult->GetCutMinEtaTracks() );
+            lKey.push_back( lCascadeResult->GetCutMaxEtaTracks() );
+            lKey.push_back( lCascadeResult->GetCutMinRapidity() );
+            lKey.push_back( lCascadeResult->GetCutMaxRapidity() );
+            lKey.push_back( lCascadeResult->GetCutDCANegToPV() );
+            lKey.push_back( lCascadeResult->GetCutDCAPosToPV() );
+            lKey.push_back( lCascadeResult->GetCutDCAV0Daughters() );
+            lKey.push_back( lCascadeResult->GetCutV0Radius() );
+            lKey.push_back( lCascadeResult->GetCutV0CosPA() );
+            lKey.push_back( lCascadeResult->GetCutUseVarV0CosPA() );
+            lKey.push_back( lCascadeResult->GetCutVarV0CosPAExp0Const() );
+            lKey.push_back( lCascadeResult->GetCutVarV0CosPAExp0Slope() );
+            lKey.push_back( lCascadeResult->GetCutVarV0CosPAExp1Const() );
+            lKey.push_back( lCascadeResult->GetCutVarV0CosPAExp1Slope() );
+            lKey.push_back( lCascadeResult->GetCutVarV0CosPAConst() );
+            lKey.push_back( lCascadeResult->GetCutDCAV0ToPV() );
+            lKey.push_back( lCascadeResult->GetCutV0Mass() );
+            lKey.push_back( lCascadeResult->GetCutDCABachToPV() );
+            lKey.push_back( lCascadeResult->GetCutDCACascDaughters() );
+            lKey.push_back( lCascadeResult->GetCutUseVarDCACascDau() );
+            lKey.push_back( lCascadeResult->GetCutVarDCACascDauExp0Const() );
+            lKey.push_back( lCascadeResult->GetCutVarDCACascDauExp0Slope() );
+            lKey.push_back( lCascadeResult->GetCutVarDCACascDauExp1Const() );
+            lKey.push_back( lCascadeResult->GetCutVarDCACascDauExp1Slope() );
+            lKey.push_back( lCascadeResult->GetCutVarDCACascDauConst() );
+            lKey.push_back( lCascadeResult->GetCutCascCosPA() );
+            lKey.push_back( lCascadeResult->GetCutUseVarCascCosPA() );
+            lKey.push_back( lCascadeResult->GetCutVarCascCosPAExp0Const() );
+            lKey.push_back( lCascadeResult->GetCutVarCascCosPAExp0Slope() );
+            lKey.push_back( lCascadeResult->GetCutVarCascCosPAExp1Const() );
+            lKey.push_back( lCascadeResult->GetCutVarCascCosPAExp1Slope() );
+            lKey.push_back( lCascadeResult->GetCutVarCascCosPAConst() );
+            lKey.push_back( lCascadeResult->GetCutCascRadius() );
+            lKey.push_back( lCascadeResult->GetCutV0MassSigma() );
+            lKey.push_back( lCascadeResult->GetCutProperLifetime() );
+            lKey.push_back( lCascadeResult->GetCutLeastNumberOfClusters() );
+            lKey.push_back( lCascadeResult->GetCutTPCdEdx() );
+            lKey.push_back( lCascadeResult->GetCutUseTOFUnchecked() );
+            lKey.push_back( lCascadeResult->GetCutXiRejection() );
+            lKey.push_back( lCascadeResult->GetCutDCABachToBaryon() );
+            lKey.push_back( lCascadeResult->GetCutBachBaryonCosPA() );
+            lKey.push_back( lCascadeResult->GetCutUseVarBBCosPA() );
+            lKey.push_back( lCascadeResult->GetCutVarBBCosPAExp0Const() );
+            lKey.push_back( lCascadeResult->GetCutVarBBCosPAExp0Slope() );
+            lKey.push_back( lCascadeResult->GetCutVarBBCosPAExp1Const() );
+            lKey.push_back( lCascadeResult->GetCutVarBBCosPAExp1Slope() );
+            lKey.push_back( lCascadeResult->GetCutVarBBCosPAConst() );
+            lKey.push_back( lCascadeResult->GetCutMinV0Lifetime() );
+            lKey.push_back( lCascadeResult->GetCutMaxV0Lifetime() );
+            lKey.push_back( lCascadeResult->GetCutUseITSRefitTracks() );
+            lKey.push_back( lCascadeResult->GetCutMaxChi2PerCluster() );
+            lKey.push_back( lCascadeResult->GetCutMinTrackLength() );
+            lKey.push_back( lCascadeResult->GetCutUse276TeVV0CosPA() );
+            lKey.push_back( lCascadeResult->GetCutDCACascadeToPV() );
+            lKey.push_back( lCascadeResult->GetCutAtLeastOneTOF() );
+            lKey.push_back( lCascadeResult->GetCutUseITSRefitNegative() );
+            lKey.push_back( lCascadeResult->GetCutUseITSRefitPositive() );
+            lKey.push_back( lCascadeResult->GetCutUseITSRefitBachelor() );
+            
+            std::map< std::vector<Double_t>, Int_t >::iterator lEntry = lEntries.find(lKey);
+            if ( lEntry != lEntries.end() ){
+                lCuts.fHistos[lEntry->second].push_back( lCascadeResult->GetHistogram() );
+                continue;
+            }
+            lEntries[lKey] = lCuts.fHypo.size();
+            
+            lCuts.fList.push_back( ilist );
+            lCuts.fHypo.push_back( lHypo );
+            lCuts.fCharge.push_back( lCharge );
+            lCuts.fMinEtaTracks.push_back( lCascadeResult->GetCutMinEtaTracks() );
+            lCuts.fMaxEtaTracks.push_back( lCascadeResult->GetCutMaxEtaTracks() );
+            lCuts.fMinRapidity.push_back( lCascadeResult->GetCutMinRapidity() );
+            lCuts.fMaxRapidity.push_back( lCascadeResult->GetCutMaxRapidity() );
+            lCuts.fDCANegToPV.push_back( lCascadeResult->GetCutDCANegToPV() );
+            lCuts.fDCAPosToPV.push_back( lCascadeResult->GetCutDCAPosToPV() );
+            lCuts.fDCAV0Daughters.push_back( lCascadeResult->GetCutDCAV0Daughters() );
+            lCuts.fV0Radius.push_back( lCascadeResult->GetCutV0Radius() );
+            lCuts.fV0CosPA.push_back( lCascadeResult->GetCutV0CosPA() );
+            lCuts.fUseVarV0CosPA.push_back( lCascadeResult->GetCutUseVarV0CosPA() );
+            lCuts.fVarV0CosPA[0].push_back( lCascadeResult->GetCutVarV0CosPAExp0Const() );
+            lCuts.fVarV0CosPA[1].push_back( lCascadeResult->GetCutVarV0CosPAExp0Slope() );
+            lCuts.fVarV0CosPA[2].push_back( lCascadeResult->GetCutVarV0CosPAExp1Const() );
+            lCuts.fVarV0CosPA[3].push_back( lCascadeResult->GetCutVarV0CosPAExp1Slope() );
+            lCuts.fVarV0CosPA[4].push_back( lCascadeResult->GetCutVarV0CosPAConst() );
+            lCuts.fDCAV0ToPV.push_back( lCascadeResult->GetCutDCAV0ToPV() );
+            lCuts.fV0Mass.push_back( lCascadeResult->GetCutV0Mass() );
+            lCuts.fDCABachToPV.push_back( lCascadeResult->GetCutDCABachToPV() );
+            lCuts.fDCACascDau.push_back( lCascadeResult->GetCutDCACascDaughters() );
+            lCuts.fUseVarDCACascDau.push_back( lCascadeResult->GetCutUseVarDCACascDau() );
+            lCuts.fVarDCACascDau[0].push_back( lCascadeResult->GetCutVarDCACascDauExp0Const() );
+            lCuts.fVarDCACascDau[1].push_back( lCascadeResult->GetCutVarDCACascDauExp0Slope() );
+            lCuts.fVarDCACascDau[2].push_back( lCascadeResult->GetCutVarDCACascDauExp1Const() );
+            lCuts.fVarDCACascDau[3].push_back( lCascadeResult->GetCutVarDCACascDauExp1Slope() );
+            lCuts.fVarDCACascDau[4].push_back( lCascadeResult->GetCutVarDCACascDauConst() );
+            lCuts.fCascCosPA.push_back( lCascadeResult->GetCutCascCosPA() );
+            lCuts.fUseVarCascCosPA.push_back( lCascadeResult->GetCutUseVarCascCosPA() );
+            lCuts.fVarCascCosPA[0].push_back( lCascadeResult->GetCutVarCascCosPAExp0Const() );
+            lCuts.fVarCascCosPA[1].push_back( lCascadeResult->GetCutVarCascCosPAExp0Slope() );
+            lCuts.fVarCascCosPA[2].push_back( lCascadeResult->GetCutVarCascCosPAExp1Const() );
+            lCuts.fVarCascCosPA[3].push_back( lCascadeResult->GetCutVarCascCosPAExp1Slope() );
+            lCuts.fVarCascCosPA[4].push_back( lCascadeResult->GetCutVarCascCosPAConst() );
+            lCuts.fCascRadius.push_back( lCascadeResult->GetCutCascRadius() );
+            lCuts.fV0MassSigma.push_back( lCascadeResult->GetCutV0MassSigma() );
+            lCuts.fProperLifetime.push_back( lCascadeResult->GetCutProperLifetime() );
+            lCuts.fLeastNbrClusters.push_back( lCascadeResult->GetCutLeastNumberOfClusters() );
+            lCuts.fTPCdEdx.push_back( lCascadeResult->GetCutTPCdEdx() );
+            lCuts.fUseTOFUnchecked.push_back( lCascadeResult->GetCutUseTOFUnchecked() );
+            lCuts.fXiRejection.push_back( lCascadeResult->GetCutXiRejection() );
+            lCuts.fDCABachToBaryon.push_back( lCascadeResult->GetCutDCABachToBaryon() );
+            lCuts.fBBCosPA.push_back( lCascadeResult->GetCutBachBaryonCosPA() );
+            lCuts.fUseVarBBCosPA.push_back( lCascadeResult->GetCutUseVarBBCosPA() );
+            lCuts.fVarBBCosPA[0].push_back( lCascadeResult->GetCutVarBBCosPAExp0Const() );
+            lCuts.fVarBBCosPA[1].push_back( lCascadeResult->GetCutVarBBCosPAExp0Slope() );
+            lCuts.fVarBBCosPA[2].push_back( lCascadeResult->GetCutVarBBCosPAExp1Const() );
+            lCuts.fVarBBCosPA[3].push_back( lCascadeResult->GetCutVarBBCosPAExp1Slope() );
+            lCuts.fVarBBCosPA[4].push_back( lCascadeResult->GetCutVarBBCosPAConst() );
+            lCuts.fMinV0Lifetime.push_back( lCascadeResult->GetCutMinV0Lifetime() );
+            lCuts.fMaxV0Lifetime.push_back( lCascadeResult->GetCutMaxV0Lifetime() );
+            lCuts.fUseITSRefitTracks.push_back( lCascadeResult->GetCutUseITSRefitTracks() );
+            lCuts.fMaxChi2PerCluster.push_back( lCascadeResult->GetCutMaxChi2PerCluster() );
+            lCuts.fMinTrackLength.push_back( lCascadeResult->GetCutMinTrackLength() );
+            lCuts.fUse276TeVV0CosPA.push_back( lCascadeResult->GetCutUse276TeVV0CosPA() );
+            lCuts.fDCACascadeToPV.push_back( lCascadeResult->GetCutDCACascadeToPV() );
+            lCuts.fAtLeastOneTOF.push_back( lCascadeResult->GetCutAtLeastOneTOF() );
+            lCuts.fUseITSRefitNegative.push_back( lCascadeResult->GetCutUseITSRefitNegative() );
+            lCuts.fUseITSRefitPositive.push_back( lCascadeResult->GetCutUseITSRefitPositive() );
+            lCuts.fUseITSRefitBachelor.push_back( lCascadeResult->GetCutUseITSRefitBachelor() );
+            lCuts.fHistos.push_back( std::vector<TH3F*>(1, lCascadeResult->GetHistogram()) );
+        }
+    }
+    lCuts.fPass.resize( lCuts.fHypo.size() );
+    
+    AliWarning( Form("Compiled %i cascade configurations into %i cut sets!", lTotalCfgs, (Int_t)lCuts.fHypo.size()));
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskStrangenessVsMultiplicityRun2::SetupStandardVertexing()
 //Meant to store standard re-vertexing configuration
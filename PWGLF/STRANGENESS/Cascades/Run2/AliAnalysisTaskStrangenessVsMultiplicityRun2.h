@@ -48,6 +48,7 @@ class AliExternalTrackParam;
 
 //#include "TString.h"
 //#include "AliESDtrackCuts.h"
+#include <vector>
 #include "AliAnalysisTaskSE.h"
 #include "AliEventCuts.h"
 
@@ -218,6 +219,10 @@ public:
 
 
 private:
+    //Superlight mode: cut tables of the configurations
+    void BuildV0CutTable();
+    void BuildCascadeCutTable();
+
     // Note : In ROOT, "//!" means "do not stream the data from Master node to Worker node" ...
     // your data member object is created on the worker nodes and streaming is not needed.
     // http://root.cern.ch/download/doc/11InputOutput.pdf, page 14
@@ -631,11 +636,57 @@ private:
     TH1D *fHistEventCounterDifferential; //!
     TH1D *fHistCentrality; //!
 
+//===========================================================================================
+//   Superlight mode: cut tables
+//===========================================================================================
+    //The configurations are compiled once into tables with one array per cut
+    //and one entry per distinct set of cuts: each candidate is tested against
+    //all entries cut by cut, then the histograms of the configurations of the
+    //passing entries are filled. Cuts are stored with the type they have in
+    //the comparisons of the configuration sweep, so that results are unchanged.
+    struct V0CutTable {
+        std::vector<Int_t>    fHypo;                  //mass hypothesis, 3 if unknown
+        std::vector<Int_t>    fUseOnTheFly;
+        std::vector<Double_t> fMinEtaTracks, fMaxEtaTracks, fMinRapidity, fMaxRapidity;
+        std::vector<Double_t> fV0Radius, fMaxV0Radius, fDCANegToPV, fDCAPosToPV, fDCAV0Daughters;
+        std::vector<Float_t>  fV0CosPA;
+        std::vector<UChar_t>  fUseVarV0CosPA;
+        std::vector<Float_t>  fVarV0CosPA[5];
+        std::vector<Double_t> fProperLifetime, fLeastNbrCrossedRows, fLeastRatioCrossedRows;
+        std::vector<Double_t> fMinBaryonMomentum, fTPCdEdx, fArmenterosParameter;
+        std::vector<UChar_t>  fArmenteros, fUseITSRefitTracks;
+        std::vector<Double_t> fMaxChi2PerCluster, fMinTrackLength;
+        std::vector<UChar_t>  f276TeVLikedEdx, fAtLeastOneTOF;
+        std::vector< std::vector<TH3F*> > fHistos;    //histograms of the configurations of each entry
+        std::vector<UChar_t>  fPass;                  //result for the current candidate
+    };
+    struct CascadeCutTable {
+        std::vector<Int_t>    fList;                  //output list: 0 XiMinus, 1 XiPlus, 2 OmegaMinus, 3 OmegaPlus
+        std::vector<Int_t>    fHypo;                  //mass hypothesis, 4 if unknown
+        std::vector<Int_t>    fCharge;                //expected charge, with bachelor charge swap
+        std::vector<Double_t> fMinEtaTracks, fMaxEtaTracks, fMinRapidity, fMaxRapidity;
+        std::vector<Double_t> fDCANegToPV, fDCAPosToPV, fDCAV0Daughters, fV0Radius;
+        std::vector<Float_t>  fV0CosPA, fCascCosPA, fBBCosPA, fDCACascDau;
+        std::vector<UChar_t>  fUseVarV0CosPA, fUseVarCascCosPA, fUseVarBBCosPA, fUseVarDCACascDau;
+        std::vector<Float_t>  fVarV0CosPA[5], fVarCascCosPA[5], fVarBBCosPA[5], fVarDCACascDau[5];
+        std::vector<Double_t> fDCAV0ToPV, fV0Mass, fDCABachToPV, fCascRadius, fV0MassSigma;
+        std::vector<Double_t> fProperLifetime, fLeastNbrClusters, fTPCdEdx, fXiRejection;
+        std::vector<Double_t> fDCABachToBaryon, fMinV0Lifetime, fMaxV0Lifetime;
+        std::vector<Double_t> fMaxChi2PerCluster, fMinTrackLength, fDCACascadeToPV;
+        std::vector<UChar_t>  fUseTOFUnchecked, fUseITSRefitTracks, fUse276TeVV0CosPA, fAtLeastOneTOF;
+        std::vector<UChar_t>  fUseITSRefitNegative, fUseITSRefitPositive, fUseITSRefitBachelor;
+        std::vector< std::vector<TH3F*> > fHistos;    //histograms of the configurations of each entry
+        std::vector<UChar_t>  fPass;                  //result for the current candidate
+    };
+    V0CutTable      *fV0CutTable;      //! built in UserCreateOutputObjects
+    CascadeCutTable *fCascadeCutTable; //! built in UserCreateOutputObjects
+
     AliAnalysisTaskStrangenessVsMultiplicityRun2(const AliAnalysisTaskStrangenessVsMultiplicityRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 3);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 4);
     //1: first implementation
+    //4: cut tables for the superlight mode
 };
 
 #endif
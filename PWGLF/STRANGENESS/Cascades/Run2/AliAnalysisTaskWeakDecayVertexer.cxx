@@ -105,11 +105,126 @@ class AliAODv0;
 #include "AliLog.h"
 #include "AliTrackerBase.h"
 
+#include <vector>
+#include <algorithm>
+
 using std::cout;
 using std::endl;
 
 ClassImp(AliAnalysisTaskWeakDecayVertexer)
 
+namespace {
+    //________________________________________________________________________
+    // Transverse helix circles of V0 daughter candidates, grouped in radius bands
+    // (factor 2 in radius) and, within a band, in a grid of circle centers.
+    // Gives the circles which can come closer than a given gap to another circle:
+    // the distance D between the centers has to be in [|R1-R2|-gap, R1+R2+gap].
+    // Circles not indexed (almost straight tracks) are always returned.
+    class AliHelixCircleGrid {
+    public:
+        AliHelixCircleGrid() : fBands(), fAlways() {}
+        void Fill(const std::vector<Double_t> &xc, const std::vector<Double_t> &yc,
+                  const std::vector<Double_t> &radius, const std::vector<Bool_t> &indexed);
+        void GetCandidates(Double_t xc, Double_t yc, Double_t radius, Double_t gap,
+                           std::vector<Int_t> &candidates) const;
+    private:
+        struct Band {
+            Double_t fRMin, fRMax;         // radius range of the circles of the band
+            Double_t fXMin, fYMin, fCell;  // grid of the centers
+            Int_t fNX, fNY;
+            std::vector<Int_t> fCellStart; // first entry of each cell, last element: number of entries
+            std::vector<Int_t> fEntries;   // circles sorted by cell
+        };
+        std::vector<Band> fBands;
+        std::vector<Int_t> fAlways;
+    };
+    
+    void AliHelixCircleGrid::Fill(const std::vector<Double_t> &xc, const std::vector<Double_t> &yc,
+                                  const std::vector<Double_t> &radius, const std::vector<Bool_t> &indexed)
+    {
+        const Int_t lNBands = 16;
+        const Int_t lMaxCells = 32; //per dimension
+        fBands.clear();
+        fAlways.clear();
+        std::vector< std::vector<Int_t> > lMembers(lNBands);
+        for (UInt_t i=0; i<xc.size(); i++) {
+            if (!indexed[i]) { fAlways.push_back(i); continue; }
+            Int_t lBand = radius[i] < 2. ? 0 : TMath::FloorNint(TMath::Log2(radius[i]));
+            if (lBand >= lNBands) lBand = lNBands-1;
+            lMembers[lBand].push_back(i);
+        }
+        for (Int_t ib=0; ib<lNBands; ib++) {
+            const std::vector<Int_t> &lIn = lMembers[ib];
+            if (lIn.empty()) continue;
+            Band band;
+            band.fRMin = band.fRMax = radius[lIn[0]];
+            Double_t lXMax = xc[lIn[0]], lYMax = yc[lIn[0]];
+            band.fXMin = lXMax; band.fYMin = lYMax;
+            for (UInt_t j=1; j<lIn.size(); j++) {
+                Int_t i = lIn[j];
+                band.fRMin = TMath::Min(band.fRMin, radius[i]); band.fRMax = TMath::Max(band.fRMax, radius[i]);
+                band.fXMin = TMath::Min(band.fXMin, xc[i]);     lXMax = TMath::Max(lXMax, xc[i]);
+                band.fYMin = TMath::Min(band.fYMin, yc[i]);     lYMax = TMath::Max(lYMax, yc[i]);
+            }
+            band.fCell = TMath::Max(1., TMath::Max(lXMax-band.fXMin, lYMax-band.fYMin)/lMaxCells);
+            band.fNX = Int_t((lXMax-band.fXMin)/band.fCell)+1;
+            band.fNY = Int_t((lYMax-band.fYMin)/band.fCell)+1;
+            
+            //Sort the circles by cell, keep the input order within a cell
+            Int_t lNCells = band.fNX*band.fNY;
+            band.fCellStart.assign(lNCells+1, 0);
+            std::vector<Int_t> lCells(lIn.size());
+            for (UInt_t j=0; j<lIn.size(); j++) {
+                Int_t ix = TMath::Min(band.fNX-1, Int_t((xc[lIn[j]]-band.fXMin)/band.fCell));
+                Int_t iy = TMath::Min(band.fNY-1, Int_t((yc[lIn[j]]-band.fYMin)/band.fCell));
+                lCells[j] = ix*band.fNY + iy;
+                band.fCellStart[lCells[j]+1]++;
+            }
+            for (Int_t icell=0; icell<lNCells; icell++) band.fCellStart[icell+1] += band.fCellStart[icell];
+            band.fEntries.resize(lIn.size());
+            std::vector<Int_t> lFilled(band.fCellStart.begin(), band.fCellStart.end()-1);
+            for (UInt_t j=0; j<lIn.size(); j++) band.fEntries[lFilled[lCells[j]]++] = lIn[j];
+            fBands.push_back(band);
+        }
+    }
+    
+    void AliHelixCircleGrid::GetCandidates(Double_t xc, Double_t yc, Double_t radius, Double_t gap,
+                                           std::vector<Int_t> &candidates) const
+    {
+        candidates.assign(fAlways.begin(), fAlways.end());
+        for (UInt_t ib=0; ib<fBands.size(); ib++) {
+            const Band &band = fBands[ib];
+            //Range of center distances for a circle of this band
+            Double_t lDMax = radius + band.fRMax + gap;
+            Double_t lDMin = -gap;
+            if (radius < band.fRMin) lDMin += band.fRMin - radius;
+            if (radius > band.fRMax) lDMin += radius - band.fRMax;
+            
+            Int_t ixMin = TMath::Max(0,          TMath::FloorNint((xc-lDMax-band.fXMin)/band.fCell));
+            Int_t ixMax = TMath::Min(band.fNX-1, TMath::FloorNint((xc+lDMax-band.fXMin)/band.fCell));
+            Int_t iyMin = TMath::Max(0,          TMath::FloorNint((yc-lDMax-band.fYMin)/band.fCell));
+            Int_t iyMax = TMath::Min(band.fNY-1, TMath::FloorNint((yc+lDMax-band.fYMin)/band.fCell));
+            for (Int_t ix=ixMin; ix<=ixMax; ix++) {
+                Double_t x0 = band.fXMin + ix*band.fCell, x1 = x0 + band.fCell;
+                Double_t dxNear = xc < x0 ? x0-xc : (xc > x1 ? xc-x1 : 0.);
+                Double_t dxFar  = TMath::Max(TMath::Abs(xc-x0), TMath::Abs(xc-x1));
+                for (Int_t iy=iyMin; iy<=iyMax; iy++) {
+                    Double_t y0 = band.fYMin + iy*band.fCell, y1 = y0 + band.fCell;
+                    Double_t dyNear = yc < y0 ? y0-yc : (yc > y1 ? yc-y1 : 0.);
+                    Double_t dyFar  = TMath::Max(TMath::Abs(yc-y0), TMath::Abs(yc-y1));
+                    if (dxNear*dxNear + dyNear*dyNear > lDMax*lDMax) continue;
+                    if (lDMin > 0 && dxFar*dxFar + dyFar*dyFar < lDMin*lDMin) continue;
+                    Int_t icell = ix*band.fNY + iy;
+                    for (Int_t ie=band.fCellStart[icell]; ie<band.fCellStart[icell+1]; ie++)
+                        candidates.push_back(band.fEntries[ie]);
+                }
+            }
+        }
+        //Same order as the brute force loop
+        std::sort(candidates.begin(), candidates.end());
+    }
+}
+
 AliAnalysisTaskWeakDecayVertexer::AliAnalysisTaskWeakDecayVertexer()
 : AliAnalysisTaskSE(), fListHist(0), fPIDResponse(0),
 //________________________________________________
@@ -135,6 +250,7 @@ fkXYCase2 ( kTRUE ),
 fkResetInitialPositions ( kFALSE ),
 fkDoImprovedDCAV0DauPropagation( kFALSE ),
 fkDoMaterialCorrection( kFALSE ),
+fkUseV0HelixGrid( kFALSE ),
 fRunNumber(-1),
 //________________________________________________
 //Flags for cascade vertexer
@@ -187,6 +303,7 @@ fkXYCase2 ( kTRUE ),
 fkResetInitialPositions ( kFALSE ),
 fkDoImprovedDCAV0DauPropagation( kFALSE ),
 fkDoMaterialCorrection( kFALSE ),
+fkUseV0HelixGrid( kFALSE ),
 fRunNumber(-1), 
 //________________________________________________
 //Flags for cascade vertexer
@@ -596,16 +713,84 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
     }
     
     
+    //Quantities of the daughter candidates which do not depend on the pair: starting
+    //parameters, DCA to the primary vertex, mass for tracking and transverse helix circle.
+    //Entries 0..nneg-1 are the negative tracks, nneg..nneg+npos-1 the positive ones
+    Long_t ndau=nneg+npos;
+    std::vector<AliExternalTrackParam> lDauParam;
+    lDauParam.reserve(ndau);
+    std::vector<Double_t> lDauD(ndau), lDauMass(ndau), lDauXc(ndau), lDauYc(ndau), lDauR(ndau);
+    std::vector<Bool_t> lDauCircle(ndau);
+    for (i=0; i<ndau; i++) {
+        AliESDtrack *esdTrack=event->GetTrack(i<nneg ? neg[i] : pos[i-nneg]);
+        lDauParam.push_back(AliExternalTrackParam(*esdTrack));
+        lDauD[i] = TMath::Abs(esdTrack->GetD(xPrimaryVertex,yPrimaryVertex,b));
+        lDauMass[i] = esdTrack->GetMassForTracking();
+        
+        //Re-propagate to closest position to the primary vertex if asked to do so
+        if (fkResetInitialPositions){
+            Double_t dztemp[2], covartemp[3];
+            //Safety margin: 250 -> exceedingly large... not sure this makes sense, but ok
+            lDauParam[i].PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
+        }
+        //Transverse helix circle; (almost) straight tracks, radius above 100 m, are always tried
+        Double_t lDauC = lDauParam[i].GetC(b);
+        lDauCircle[i] = TMath::Abs(lDauC) > 1e-4;
+        if (lDauCircle[i]) {
+            Double_t lDauCenter[2];
+            GetHelixCenter( &lDauParam[i], lDauCenter, b );
+            lDauXc[i] = lDauCenter[0];
+            lDauYc[i] = lDauCenter[1];
+            lDauR[i] = 1./TMath::Abs(lDauC);
+        }
+    }
+    
+    //Pair pre-selection with the helix circles: the (weighed) DCA returned by
+    //AliExternalTrackParam::GetDCA is sqrt(dm*sqrt(dy2*dz2)) at two points of the
+    //helices, with dm=(dx^2+dy^2)/dy2+dz^2/dz2. It is then at least gap*(dz2/dy2)^(1/4),
+    //where gap is the distance between the transverse circles: pairs above the DCA cut
+    //are skipped without changing the result. With the improved DCA the tracks are
+    //propagated before the errors are taken (and with material corrections the circles
+    //change), so no pre-selection is done there.
+    Bool_t lUseGrid = fkUseV0HelixGrid && !fkDoImprovedDCAV0DauPropagation && TMath::Abs(b) > kAlmost0;
+    Double_t lMaxDCA2 = fV0VertexerSels[3]*fV0VertexerSels[3]*(1.+1e-6);
+    AliHelixCircleGrid lPosGrid;
+    Double_t lPosMinSigmaZ2 = 0., lPosMaxSigmaY2 = 0.;
+    std::vector<Int_t> lCandidates;
+    if (lUseGrid) {
+        std::vector<Double_t> lXc(lDauXc.begin()+nneg, lDauXc.end());
+        std::vector<Double_t> lYc(lDauYc.begin()+nneg, lDauYc.end());
+        std::vector<Double_t> lR (lDauR .begin()+nneg, lDauR .end());
+        std::vector<Bool_t> lIndexed(lDauCircle.begin()+nneg, lDauCircle.end());
+        lPosGrid.Fill(lXc, lYc, lR, lIndexed);
+        for (Int_t k=0; k<npos; k++) {
+            if (k==0 || lDauParam[nneg+k].GetSigmaZ2() < lPosMinSigmaZ2) lPosMinSigmaZ2 = lDauParam[nneg+k].GetSigmaZ2();
+            if (k==0 || lDauParam[nneg+k].GetSigmaY2() > lPosMaxSigmaY2) lPosMaxSigmaY2 = lDauParam[nneg+k].GetSigmaY2();
+        }
+    }
+    
     for (i=0; i<nneg; i++) {
         Long_t nidx=neg[i];
-        AliESDtrack *ntrk=event->GetTrack(nidx);
+        const AliExternalTrackParam &ntrk=lDauParam[i];
+        
+        //Candidates for the positive daughter: all, or the ones whose circle is close enough
+        Bool_t lPreselect = lUseGrid && lDauCircle[i];
+        Int_t ncand = npos;
+        if (lPreselect) {
+            //Largest circle gap allowed by the DCA cut, with the smallest possible error ratio
+            Double_t lMinRatio = TMath::Sqrt((ntrk.GetSigmaZ2()+lPosMinSigmaZ2)/(ntrk.GetSigmaY2()+lPosMaxSigmaY2));
+            Double_t lMaxGap = TMath::Sqrt(lMaxDCA2/lMinRatio) + 0.1; //generous margin: only a superset of the pairs is needed here
+            lPosGrid.GetCandidates(lDauXc[i], lDauYc[i], lDauR[i], lMaxGap, lCandidates);
+            ncand = (Int_t)lCandidates.size();
+        }
         
-        for (Int_t k=0; k<npos; k++) {
+        for (Int_t c=0; c<ncand; c++) {
+            Int_t k = lPreselect ? lCandidates[c] : c;
             Int_t pidx=pos[k];
-            AliESDtrack *ptrk=event->GetTrack(pidx);
+            const AliExternalTrackParam &ptrk=lDauParam[nneg+k];
             
-            Double_t lNegMassForTracking = ntrk->GetMassForTracking();
-            Double_t lPosMassForTracking = ptrk->GetMassForTracking();
+            Double_t lNegMassForTracking = lDauMass[i];
+            Double_t lPosMassForTracking = lDauMass[nneg+k];
             
             //Pre-select dE/dx: only proceed if at least one of these tracks looks like a proton
             /*
@@ -616,21 +801,27 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
              }
              */
             
-            if (TMath::Abs(ntrk->GetD(xPrimaryVertex,yPrimaryVertex,b))<fV0VertexerSels[1])
-                if (TMath::Abs(ptrk->GetD(xPrimaryVertex,yPrimaryVertex,b))<fV0VertexerSels[2]) continue;
+            if (lDauD[i]<fV0VertexerSels[1])
+                if (lDauD[nneg+k]<fV0VertexerSels[2]) continue;
+            
+            //Circle gap: exact lower bound of the DCA (see above)
+            if (lPreselect && lDauCircle[nneg+k]) {
+                Double_t lDist = TMath::Sqrt((lDauXc[i]-lDauXc[nneg+k])*(lDauXc[i]-lDauXc[nneg+k]) +
+                                             (lDauYc[i]-lDauYc[nneg+k])*(lDauYc[i]-lDauYc[nneg+k]));
+                Double_t lGap = TMath::Max(lDist - lDauR[i] - lDauR[nneg+k], TMath::Abs(lDauR[i]-lDauR[nneg+k]) - lDist);
+                //numerical tolerance of the centers, relative to the radii
+                lGap -= 1e-3 + 1e-6*(lDauR[i] + lDauR[nneg+k] + lDist);
+                if (lGap > 0) {
+                    Double_t lRatio = TMath::Sqrt((ntrk.GetSigmaZ2()+ptrk.GetSigmaZ2())/(ntrk.GetSigmaY2()+ptrk.GetSigmaY2()));
+                    if (lGap*lGap*lRatio > lMaxDCA2) continue;
+                }
+            }
             
-            AliExternalTrackParam nt(*ntrk), pt(*ptrk), *ntp=&nt, *ptp=&pt;
+            AliExternalTrackParam nt(ntrk), pt(ptrk), *ntp=&nt, *ptp=&pt;
             Double_t xn, xp, dca;
             
             //Improved call: use own function, including XY-pre-opt stage
-            
-            //Re-propagate to closest position to the primary vertex if asked to do so
-            if (fkResetInitialPositions){
-                Double_t dztemp[2], covartemp[3];
-                //Safety margin: 250 -> exceedingly large... not sure this makes sense, but ok
-                ntp->PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
-                ptp->PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
-            }
+            //(re-propagation to the primary vertex if asked to do so: done above, once per track)
             
             if( fkDoImprovedDCAV0DauPropagation ){
                 //Improved: use own call
@@ -823,6 +1014,20 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
         trk[ntr++]=i;
     }
     
+    // Bachelor candidates: starting parameters and mass for tracking, calculated once,
+    // in separate lists for the cascades (negative) and the anti-cascades (positive)
+    std::vector<AliExternalTrackParam> lBachParam;
+    lBachParam.reserve(ntr);
+    std::vector<Float_t> lBachMass(ntr);
+    std::vector<Int_t> lBachNeg, lBachPos;
+    for (i=0; i<ntr; i++) {
+        AliESDtrack *btrk=event->GetTrack(trk[i]);
+        lBachParam.push_back(AliExternalTrackParam(*btrk));
+        lBachMass[i]=btrk->GetMassForTracking();
+        if (btrk->GetSign()<=0) lBachNeg.push_back(i);
+        if (btrk->GetSign()>=0) lBachPos.push_back(i);
+    }
+    
     Double_t massLambda=1.11568;
     Long_t ncasc=0;
     
@@ -832,18 +1037,16 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
         AliESDv0 v0(*v);
         v0.ChangeMassHypothesis(kLambda0); // the v0 must be Lambda
         if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
-        for (Int_t j=0; j<ntr; j++) {//loop on tracks
+        for (UInt_t jneg=0; jneg<lBachNeg.size(); jneg++) {//loop on tracks, bachelor's charge: negative
+            Int_t j=lBachNeg[jneg];
             Int_t bidx=trk[j];
             //Bo:   if (bidx==v->GetNindex()) continue; //bachelor and v0's negative tracks must be different
             if (bidx==v0.GetIndex(0)) continue; //Bo:  consistency 0 for neg
             
-            AliESDtrack *btrk=event->GetTrack(bidx);
-            Float_t lBachMassForTracking=btrk->GetMassForTracking();
-            
-            if (btrk->GetSign()>0) continue;  // bachelor's charge
+            Float_t lBachMassForTracking=lBachMass[j];
             
             AliESDv0 *pv0=&v0;
-            AliExternalTrackParam bt(*btrk), *pbt=&bt;
+            AliExternalTrackParam bt(lBachParam[j]), *pbt=&bt;
             
             Double_t dca=PropagateToDCA(pv0,pbt,event,b,lBachMassForTracking);
             if (dca > fCascadeVertexerSels[4]) continue;
@@ -906,17 +1109,15 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
         v0.ChangeMassHypothesis(kLambda0Bar); //the v0 must be anti-Lambda
         if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
         
-        for (Int_t j=0; j<ntr; j++) {//loop on tracks
+        for (UInt_t jpos=0; jpos<lBachPos.size(); jpos++) {//loop on tracks, bachelor's charge: positive
+            Int_t j=lBachPos[jpos];
             Int_t bidx=trk[j];
             if (bidx==v0.GetIndex(1)) continue; //Bo:  consistency 1 for pos
             
-            AliESDtrack *btrk=event->GetTrack(bidx);
-            Float_t lBachMassForTracking=btrk->GetMassForTracking();
-            
-            if (btrk->GetSign()<0) continue;  // bachelor's charge
+            Float_t lBachMassForTracking=lBachMass[j];
             
             AliESDv0 *pv0=&v0;
-            AliExternalTrackParam bt(*btrk), *pbt=&bt;
+            AliExternalTrackParam bt(lBachParam[j]), *pbt=&bt;
             
             Double_t dca=PropagateToDCA(pv0,pbt,event,b,lBachMassForTracking);
             if (dca > fCascadeVertexerSels[4]) continue;
@@ -66,6 +66,12 @@ public:
         //Highly experimental, use with care!
         fkDoMaterialCorrection = lOpt;
     }
+    void SetUseV0HelixGrid( Bool_t lOpt = kTRUE ){
+        //Pre-select V0 daughter pairs with their transverse helix circles (off by default).
+        //Only pairs which cannot pass the DCA V0 daughters cut are skipped: same V0s as
+        //without it. Used with the standard DCA calculation only, see Tracks2V0vertices
+        fkUseV0HelixGrid = lOpt;
+    }
     void SetXYCase1Preoptimization( Bool_t lOpt = kTRUE ){
         //Highly experimental, use with care!
         fkXYCase1 = lOpt;
@@ -291,6 +297,7 @@ private:
     Bool_t fkResetInitialPositions; 
     Bool_t fkDoImprovedDCAV0DauPropagation;
     Bool_t fkDoMaterialCorrection; //Replace AliExternalTrackParam::PropagateTo with AliTrackerBase::PropagateTrackTo
+    Bool_t fkUseV0HelixGrid; //Pre-select V0 daughter pairs with their transverse helix circles
     Int_t fRunNumber; //keep track of run number, needed to load geometry + invoke AliTrackerBase 
     
     Bool_t fkRunCascadeVertexer;      // if true, re-run cascade vertexer
@@ -328,8 +335,9 @@ private:
     AliAnalysisTaskWeakDecayVertexer(const AliAnalysisTaskWeakDecayVertexer&);            // not implemented
     AliAnalysisTaskWeakDecayVertexer& operator=(const AliAnalysisTaskWeakDecayVertexer&); // not implemented
 
-    ClassDef(AliAnalysisTaskWeakDecayVertexer, 1);
+    ClassDef(AliAnalysisTaskWeakDecayVertexer, 2);
     //1: first implementation
+    //2: helix circle pre-selection of V0 daughter pairs
 };
 
 #endif
@@ -134,6 +134,18 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fPtResCentPtTPCITS(0)
   , fCurrentFileName("")
   , fDummyTrack(0)
+  , fUseSchemaWriter(kFALSE)
+  , fDummyFriendTrack(0)
+  , fDummyVertex(0)
+  , fDummyParam(0)
+  , fDummyTrackReference(0)
+  , fDummyParticle(0)
+  , fHighPtRow()
+  , fV0Row()
+  , fdEdxRow()
+  , fLaserRow()
+  , fMCEffRow()
+  , fCosmicPairsRow()
 {
   // Constructor
 
@@ -157,6 +169,11 @@ AliAnalysisTaskFilteredTree::~AliAnalysisTaskFilteredTree()
   delete fFilteredTreeAcceptanceCuts;
   delete fFilteredTreeRecAcceptanceCuts;
   delete fEsdTrackCuts;
+  delete fDummyFriendTrack;
+  delete fDummyVertex;
+  delete fDummyParam;
+  delete fDummyTrackReference;
+  delete fDummyParticle;
 }
 
 //____________________________________________________________________________
@@ -210,6 +227,7 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
   }
+  if (fUseSchemaWriter) InitSchemaWriter();
 
   // histogram booking
 
@@ -380,6 +398,246 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
   printf("processed event %d\n", Int_t(Entry()));
 }
 
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::InitSchemaWriter()
+{
+  //
+  // Declare the layout of the filtered tree streams once as typed branches bound to rows.
+  // Per fill only the row is updated and TTree::Fill is called, so the name resolution
+  // and element matching of the TTreeSRedirector chains is avoided.
+  // Branch names, leaf types and object classes are the same as the ones produced by the
+  // chains, objects are split (splitlevel 99) as in TTreeSRedirector, hence the output is
+  // the same and the existing TTree::Draw aliases stay valid.
+  // The highPt layout depends on the processing mode and on the MC availability - it is
+  // declared at the first highPt fill (BranchHighPtRow).
+  //
+  if (!fV0Tree || !fdEdxTree || !fLaserTree || !fMCEffTree || !fCosmicPairsTree) return;
+  if (fdEdxTree->GetNbranches()>0) return;  // already declared
+  if (!fDummyFriendTrack) fDummyFriendTrack = new AliESDfriendTrack();
+  if (!fDummyVertex) fDummyVertex = new AliESDVertex();
+  if (!fDummyParam) fDummyParam = new AliExternalTrackParam();
+  if (!fDummyTrackReference) fDummyTrackReference = new AliTrackReference();
+  if (!fDummyParticle) fDummyParticle = new TParticle();
+  const Int_t kSplit=99;
+  //
+  // V0s
+  //
+  fV0Tree->Branch("gid",&fV0Row.fGid,"gid/l");
+  fV0Tree->Branch("isDownscaled",&fV0Row.fIsDownscaled,"isDownscaled/B");   // TTreeStream stores Bool_t as 'B'
+  fV0Tree->Branch("triggerClass","TObjString",&fV0Row.fTriggerClass,32000,kSplit);
+  fV0Tree->Branch("Bz",&fV0Row.fBz,"Bz/F");
+  fV0Tree->Branch("fileName.","TObjString",&fV0Row.fFileName,32000,kSplit);
+  fV0Tree->Branch("runNumber",&fV0Row.fRunNumber,"runNumber/I");
+  fV0Tree->Branch("evtTimeStamp",&fV0Row.fEvtTimeStamp,"evtTimeStamp/I");
+  fV0Tree->Branch("evtNumberInFile",&fV0Row.fEvtNumberInFile,"evtNumberInFile/I");
+  fV0Tree->Branch("type",&fV0Row.fType,"type/I");
+  fV0Tree->Branch("ntracks",&fV0Row.fNtracks,"ntracks/I");
+  fV0Tree->Branch("v0.","AliESDv0",&fV0Row.fV0,32000,kSplit);
+  fV0Tree->Branch("kf.","AliKFParticle",&fV0Row.fKF,32000,kSplit);
+  fV0Tree->Branch("track0.","AliESDtrack",&fV0Row.fTrack0,32000,kSplit);
+  fV0Tree->Branch("track1.","AliESDtrack",&fV0Row.fTrack1,32000,kSplit);
+  fV0Tree->Branch("tofClInfo0.","TVectorT<double>",&fV0Row.fTofClInfo0,32000,kSplit);
+  fV0Tree->Branch("tofClInfo1.","TVectorT<double>",&fV0Row.fTofClInfo1,32000,kSplit);
+  fV0Tree->Branch("tofNsigma0.","TVectorT<double>",&fV0Row.fTofNsigma0,32000,kSplit);
+  fV0Tree->Branch("tofNsigma1.","TVectorT<double>",&fV0Row.fTofNsigma1,32000,kSplit);
+  fV0Tree->Branch("tpcNsigma0.","TVectorT<double>",&fV0Row.fTpcNsigma0,32000,kSplit);
+  fV0Tree->Branch("tpcNsigma1.","TVectorT<double>",&fV0Row.fTpcNsigma1,32000,kSplit);
+  fV0Tree->Branch("friendTrack0.","AliESDfriendTrack",&fV0Row.fFriendTrack0,32000,kSplit);
+  fV0Tree->Branch("friendTrack1.","AliESDfriendTrack",&fV0Row.fFriendTrack1,32000,kSplit);
+  fV0Tree->Branch("centralityF",&fV0Row.fCentralityF,"centralityF/F");
+  //
+  // dEdx
+  //
+  fdEdxTree->Branch("gid",&fdEdxRow.fGid,"gid/l");
+  fdEdxTree->Branch("fileName.","TObjString",&fdEdxRow.fFileName,32000,kSplit);
+  fdEdxTree->Branch("runNumber",&fdEdxRow.fRunNumber,"runNumber/D");
+  fdEdxTree->Branch("evtTimeStamp",&fdEdxRow.fEvtTimeStamp,"evtTimeStamp/D");
+  fdEdxTree->Branch("evtNumberInFile",&fdEdxRow.fEvtNumberInFile,"evtNumberInFile/I");
+  fdEdxTree->Branch("triggerClass","TObjString",&fdEdxRow.fTriggerClass,32000,kSplit);
+  fdEdxTree->Branch("Bz",&fdEdxRow.fBz,"Bz/D");
+  fdEdxTree->Branch("vtxESD.","AliESDVertex",&fdEdxRow.fVtxESD,32000,kSplit);
+  fdEdxTree->Branch("mult",&fdEdxRow.fMult,"mult/I");
+  fdEdxTree->Branch("esdTrack.","AliESDtrack",&fdEdxRow.fEsdTrack,32000,kSplit);
+  fdEdxTree->Branch("friendTrack.","AliESDfriendTrack",&fdEdxRow.fFriendTrack,32000,kSplit);
+  fdEdxTree->Branch("tofNsigma.","TVectorT<double>",&fdEdxRow.fTofNsigma,32000,kSplit);
+  fdEdxTree->Branch("tpcNsigma.","TVectorT<double>",&fdEdxRow.fTpcNsigma,32000,kSplit);
+  //
+  // Laser
+  //
+  fLaserTree->Branch("gid",&fLaserRow.fGid,"gid/l");
+  fLaserTree->Branch("fileName.","TObjString",&fLaserRow.fFileName,32000,kSplit);
+  fLaserTree->Branch("runNumber",&fLaserRow.fRunNumber,"runNumber/I");
+  fLaserTree->Branch("evtTimeStamp",&fLaserRow.fEvtTimeStamp,"evtTimeStamp/I");
+  fLaserTree->Branch("evtNumberInFile",&fLaserRow.fEvtNumberInFile,"evtNumberInFile/I");
+  fLaserTree->Branch("triggerClass","TObjString",&fLaserRow.fTriggerClass,32000,kSplit);
+  fLaserTree->Branch("Bz",&fLaserRow.fBz,"Bz/F");
+  fLaserTree->Branch("multTPCtracks",&fLaserRow.fMultTPCtracks,"multTPCtracks/I");
+  fLaserTree->Branch("track.","AliESDtrack",&fLaserRow.fTrack,32000,kSplit);
+  fLaserTree->Branch("friendTrack.","AliESDfriendTrack",&fLaserRow.fFriendTrack,32000,kSplit);
+  //
+  // MCEffTree
+  //
+  fMCEffTree->Branch("fileName.","TObjString",&fMCEffRow.fFileName,32000,kSplit);
+  fMCEffTree->Branch("triggerClass.","TObjString",&fMCEffRow.fTriggerClass,32000,kSplit);
+  fMCEffTree->Branch("runNumber",&fMCEffRow.fRunNumber,"runNumber/D");
+  fMCEffTree->Branch("evtTimeStamp",&fMCEffRow.fEvtTimeStamp,"evtTimeStamp/D");
+  fMCEffTree->Branch("evtNumberInFile",&fMCEffRow.fEvtNumberInFile,"evtNumberInFile/I");
+  fMCEffTree->Branch("Bz",&fMCEffRow.fBz,"Bz/D");
+  fMCEffTree->Branch("vtxESD.","AliESDVertex",&fMCEffRow.fVtxESD,32000,kSplit);
+  fMCEffTree->Branch("mult",&fMCEffRow.fMult,"mult/I");
+  fMCEffTree->Branch("multMCTrueTracks",&fMCEffRow.fMultMCTrueTracks,"multMCTrueTracks/I");
+  fMCEffTree->Branch("contTPC",&fMCEffRow.fContTPC,"contTPC/I");
+  fMCEffTree->Branch("contSPD",&fMCEffRow.fContSPD,"contSPD/I");
+  fMCEffTree->Branch("vertexPosTPC.","TVectorT<double>",&fMCEffRow.fVertexPosTPC,32000,kSplit);
+  fMCEffTree->Branch("vertexPosSPD.","TVectorT<double>",&fMCEffRow.fVertexPosSPD,32000,kSplit);
+  fMCEffTree->Branch("ntracksTPC",&fMCEffRow.fNtracksTPC,"ntracksTPC/I");
+  fMCEffTree->Branch("ntracksITS",&fMCEffRow.fNtracksITS,"ntracksITS/I");
+  fMCEffTree->Branch("isAcc0",&fMCEffRow.fIsAcc0,"isAcc0/I");
+  fMCEffTree->Branch("isAcc1",&fMCEffRow.fIsAcc1,"isAcc1/I");
+  fMCEffTree->Branch("esdTrack.","AliESDtrack",&fMCEffRow.fEsdTrack,32000,kSplit);
+  fMCEffTree->Branch("isRec",&fMCEffRow.fIsRec,"isRec/B");
+  fMCEffTree->Branch("tpcTrackLength",&fMCEffRow.fTpcTrackLength,"tpcTrackLength/D");
+  fMCEffTree->Branch("particle.","TParticle",&fMCEffRow.fParticle,32000,kSplit);
+  fMCEffTree->Branch("particleMother.","TParticle",&fMCEffRow.fParticleMother,32000,kSplit);
+  fMCEffTree->Branch("mech",&fMCEffRow.fMech,"mech/I");
+  fMCEffTree->Branch("nRec",&fMCEffRow.fNRec,"nRec/I");
+  fMCEffTree->Branch("nFakes",&fMCEffRow.fNFakes,"nFakes/I");
+  //
+  // CosmicPairs
+  //
+  fCosmicPairsTree->Branch("gid",&fCosmicPairsRow.fGid,"gid/l");
+  fCosmicPairsTree->Branch("fileName.","TObjString",&fCosmicPairsRow.fFileName,32000,kSplit);
+  fCosmicPairsTree->Branch("runNumber",&fCosmicPairsRow.fRunNumber,"runNumber/I");
+  fCosmicPairsTree->Branch("evtTimeStamp",&fCosmicPairsRow.fEvtTimeStamp,"evtTimeStamp/I");
+  fCosmicPairsTree->Branch("evtNumberInFile",&fCosmicPairsRow.fEvtNumberInFile,"evtNumberInFile/I");
+  fCosmicPairsTree->Branch("trigger",&fCosmicPairsRow.fTrigger,"trigger/l");
+  fCosmicPairsTree->Branch("triggerClass","TObjString",&fCosmicPairsRow.fTriggerClass,32000,kSplit);
+  fCosmicPairsTree->Branch("Bz",&fCosmicPairsRow.fBz,"Bz/F");
+  fCosmicPairsTree->Branch("multSPD",&fCosmicPairsRow.fMultSPD,"multSPD/I");
+  fCosmicPairsTree->Branch("multTPC",&fCosmicPairsRow.fMultTPC,"multTPC/I");
+  fCosmicPairsTree->Branch("vertSPD.","AliESDVertex",&fCosmicPairsRow.fVertSPD,32000,kSplit);
+  fCosmicPairsTree->Branch("vertTPC.","AliESDVertex",&fCosmicPairsRow.fVertTPC,32000,kSplit);
+  fCosmicPairsTree->Branch("t0.","AliESDtrack",&fCosmicPairsRow.fT0,32000,kSplit);
+  fCosmicPairsTree->Branch("t1.","AliESDtrack",&fCosmicPairsRow.fT1,32000,kSplit);
+  fCosmicPairsTree->Branch("friendTrack0.","AliESDfriendTrack",&fCosmicPairsRow.fFriendTrack0,32000,kSplit);
+  fCosmicPairsTree->Branch("friendTrack1.","AliESDfriendTrack",&fCosmicPairsRow.fFriendTrack1,32000,kSplit);
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::BranchHighPtRow(Bool_t processAll, Bool_t withMC)
+{
+  //
+  // Declare the highPt layout written by Process (processAll==kFALSE) or by ProcessAll,
+  // the MC part of the ProcessAll layout only if MC information is available
+  //
+  if (!fHighPtTree || fHighPtTree->GetNbranches()>0) return;
+  const Int_t kSplit=99;
+  FilteredTreeHighPtRow_t &row=fHighPtRow;
+  if (!processAll) {
+    fHighPtTree->Branch("gid",&row.fGid,"gid/l");
+    fHighPtTree->Branch("fileName.","TObjString",&row.fFileName,32000,kSplit);
+    fHighPtTree->Branch("runNumber",&row.fRunNumber,"runNumber/I");
+    fHighPtTree->Branch("evtTimeStamp",&row.fEvtTimeStamp,"evtTimeStamp/I");
+    fHighPtTree->Branch("evtNumberInFile",&row.fEvtNumberInFile,"evtNumberInFile/I");
+    fHighPtTree->Branch("triggerClass","TObjString",&row.fTriggerClass,32000,kSplit);
+    fHighPtTree->Branch("Bz",&row.fBz,"Bz/F");
+    fHighPtTree->Branch("vtxESD.","AliESDVertex",&row.fVtxESD,32000,kSplit);
+    fHighPtTree->Branch("ntracksESD",&row.fNtracksESD,"ntracksESD/I");
+    fHighPtTree->Branch("IRtot",&row.fIRtot,"IRtot/I");
+    fHighPtTree->Branch("IRint2",&row.fIRint2,"IRint2/I");
+    fHighPtTree->Branch("mult",&row.fMult,"mult/I");
+    fHighPtTree->Branch("multSPD",&row.fMultSPD,"multSPD/I");
+    fHighPtTree->Branch("multTPC",&row.fMultTPC,"multTPC/I");
+    fHighPtTree->Branch("esdTrack.","AliESDtrack",&row.fEsdTrack,32000,kSplit);
+    fHighPtTree->Branch("centralityF",&row.fCentralityF,"centralityF/F");
+    return;
+  }
+  fHighPtTree->Branch("downscaleCounter",&row.fDownscaleCounter,"downscaleCounter/I");
+  fHighPtTree->Branch("gid",&row.fGid,"gid/l");
+  fHighPtTree->Branch("fileName.","TObjString",&row.fFileName,32000,kSplit);
+  fHighPtTree->Branch("runNumber",&row.fRunNumber,"runNumber/I");
+  fHighPtTree->Branch("evtTimeStamp",&row.fEvtTimeStamp,"evtTimeStamp/I");
+  fHighPtTree->Branch("evtNumberInFile",&row.fEvtNumberInFile,"evtNumberInFile/I");
+  fHighPtTree->Branch("triggerClass","TObjString",&row.fTriggerClass,32000,kSplit);
+  fHighPtTree->Branch("Bz",&row.fBz,"Bz/F");
+  fHighPtTree->Branch("vtxESD.","AliESDVertex",&row.fVtxESD,32000,kSplit);
+  fHighPtTree->Branch("IRtot",&row.fIRtot,"IRtot/I");
+  fHighPtTree->Branch("IRint2",&row.fIRint2,"IRint2/I");
+  fHighPtTree->Branch("mult",&row.fMult,"mult/I");
+  fHighPtTree->Branch("ntracks",&row.fNtracks,"ntracks/I");
+  fHighPtTree->Branch("contTPC",&row.fContTPC,"contTPC/I");
+  fHighPtTree->Branch("contSPD",&row.fContSPD,"contSPD/I");
+  fHighPtTree->Branch("vertexPosTPC.","TVectorT<double>",&row.fVertexPosTPC,32000,kSplit);
+  fHighPtTree->Branch("vertexPosSPD.","TVectorT<double>",&row.fVertexPosSPD,32000,kSplit);
+  fHighPtTree->Branch("ntracksTPC",&row.fNtracksTPC,"ntracksTPC/I");
+  fHighPtTree->Branch("ntracksITS",&row.fNtracksITS,"ntracksITS/I");
+  fHighPtTree->Branch("esdTrack.","AliESDtrack",&row.fEsdTrack,32000,kSplit);
+  fHighPtTree->Branch("tofClInfo.","TVectorT<double>",&row.fTofClInfo,32000,kSplit);
+  fHighPtTree->Branch("tofNsigma.","TVectorT<double>",&row.fTofNsigma,32000,kSplit);
+  fHighPtTree->Branch("tpcNsigma.","TVectorT<double>",&row.fTpcNsigma,32000,kSplit);
+  fHighPtTree->Branch("tofPID.","TVectorT<double>",&row.fTofPID,32000,kSplit);
+  fHighPtTree->Branch("tpcPID.","TVectorT<double>",&row.fTpcPID,32000,kSplit);
+  fHighPtTree->Branch("friendTrack.","AliESDfriendTrack",&row.fFriendTrack,32000,kSplit);
+  fHighPtTree->Branch("extTPCInnerC.","AliExternalTrackParam",&row.fExtTPCInnerC,32000,kSplit);
+  fHighPtTree->Branch("extInnerParamV.","AliExternalTrackParam",&row.fExtInnerParamV,32000,kSplit);
+  fHighPtTree->Branch("extInnerParamC.","AliExternalTrackParam",&row.fExtInnerParamC,32000,kSplit);
+  fHighPtTree->Branch("extInnerParam.","AliExternalTrackParam",&row.fExtInnerParam,32000,kSplit);
+  fHighPtTree->Branch("extOuterITS.","AliExternalTrackParam",&row.fExtOuterITS,32000,kSplit);
+  fHighPtTree->Branch("extInnerParamRef.","AliExternalTrackParam",&row.fExtInnerParamRef,32000,kSplit);
+  fHighPtTree->Branch("chi2TPCInnerC",&row.fChi2TPCInnerC,"chi2TPCInnerC/D");
+  fHighPtTree->Branch("chi2InnerC",&row.fChi2InnerC,"chi2InnerC/D");
+  fHighPtTree->Branch("chi2OuterITS",&row.fChi2OuterITS,"chi2OuterITS/D");
+  fHighPtTree->Branch("centralityF",&row.fCentralityF,"centralityF/F");
+  fHighPtTree->Branch("paramITS.","AliExternalTrackParam",&row.fParamITS,32000,kSplit);
+  fHighPtTree->Branch("paramITSC.","AliExternalTrackParam",&row.fParamITSC,32000,kSplit);
+  fHighPtTree->Branch("paramComb.","AliExternalTrackParam",&row.fParamComb,32000,kSplit);
+  fHighPtTree->Branch("indexNearestITS",&row.fIndexNearestITS,"indexNearestITS/I");
+  fHighPtTree->Branch("indexNearestITSC",&row.fIndexNearestITSC,"indexNearestITSC/I");
+  fHighPtTree->Branch("indexNearestComb",&row.fIndexNearestComb,"indexNearestComb/I");
+  if (!withMC) return;
+  fHighPtTree->Branch("multMCTrueTracks",&row.fMultMCTrueTracks,"multMCTrueTracks/I");
+  fHighPtTree->Branch("nrefITS",&row.fNrefITS,"nrefITS/I");
+  fHighPtTree->Branch("nrefTPC",&row.fNrefTPC,"nrefTPC/I");
+  fHighPtTree->Branch("nrefTRD",&row.fNrefTRD,"nrefTRD/I");
+  fHighPtTree->Branch("nrefTOF",&row.fNrefTOF,"nrefTOF/I");
+  fHighPtTree->Branch("nrefEMCAL",&row.fNrefEMCAL,"nrefEMCAL/I");
+  fHighPtTree->Branch("nrefPHOS",&row.fNrefPHOS,"nrefPHOS/I");
+  fHighPtTree->Branch("refTPCIn.","AliTrackReference",&row.fRefTPCIn,32000,kSplit);
+  fHighPtTree->Branch("refTPCOut.","AliTrackReference",&row.fRefTPCOut,32000,kSplit);
+  fHighPtTree->Branch("refITS.","AliTrackReference",&row.fRefITS,32000,kSplit);
+  fHighPtTree->Branch("refTRD.","AliTrackReference",&row.fRefTRD,32000,kSplit);
+  fHighPtTree->Branch("refTOF.","AliTrackReference",&row.fRefTOF,32000,kSplit);
+  fHighPtTree->Branch("refEMCAL.","AliTrackReference",&row.fRefEMCAL,32000,kSplit);
+  fHighPtTree->Branch("refPHOS.","AliTrackReference",&row.fRefPHOS,32000,kSplit);
+  BranchMCParticleColumns(fHighPtTree,"",row.fMC);
+  BranchMCParticleColumns(fHighPtTree,"TPC",row.fMCTPC);
+  BranchMCParticleColumns(fHighPtTree,"ITS",row.fMCITS);
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::BranchMCParticleColumns(TTree *tree, const char *suffix, FilteredTreeMCParticleColumns_t &columns)
+{
+  //
+  // MC particle branches of the highPt stream: particle<suffix>., particleMother<suffix>., mech<suffix>, ...
+  //
+  const Int_t kSplit=99;
+  TString name;
+  name=TString::Format("particle%s.",suffix);
+  tree->Branch(name,"TParticle",&columns.fParticle,32000,kSplit);
+  name=TString::Format("particleMother%s.",suffix);
+  tree->Branch(name,"TParticle",&columns.fParticleMother,32000,kSplit);
+  name=TString::Format("mech%s",suffix);
+  tree->Branch(name,&columns.fMech,name+"/I");
+  name=TString::Format("isPrim%s",suffix);
+  tree->Branch(name,&columns.fIsPrim,name+"/B");
+  name=TString::Format("isFromStrangess%s",suffix);
+  tree->Branch(name,&columns.fIsFromStrangess,name+"/B");
+  name=TString::Format("isFromConversion%s",suffix);
+  tree->Branch(name,&columns.fIsFromConversion,name+"/B");
+  name=TString::Format("isFromMaterial%s",suffix);
+  tree->Branch(name,&columns.fIsFromMaterial,name+"/B");
+}
+
 //_____________________________________________________________________________
 void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliESDfriend* esdFriend)
 {
@@ -509,6 +767,26 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
       }
       if(!fFillTree) return;
       if(!fTreeSRedirector) return;
+      if (fUseSchemaWriter) {
+        fCosmicPairsRow.fGid = gid;
+        fCosmicPairsRow.fFileName = &fCurrentFileName;
+        fCosmicPairsRow.fRunNumber = runNumber;
+        fCosmicPairsRow.fEvtTimeStamp = timeStamp;
+        fCosmicPairsRow.fEvtNumberInFile = eventNumber;
+        fCosmicPairsRow.fTrigger = triggerMask;
+        fCosmicPairsRow.fTriggerClass = &triggerClass;
+        fCosmicPairsRow.fBz = magField;
+        fCosmicPairsRow.fMultSPD = ntracksSPD;
+        fCosmicPairsRow.fMultTPC = ntracksTPC;
+        fCosmicPairsRow.fVertSPD = vertexSPD;
+        fCosmicPairsRow.fVertTPC = vertexTPC;
+        fCosmicPairsRow.fT0 = track0;
+        fCosmicPairsRow.fT1 = track1;
+        fCosmicPairsRow.fFriendTrack0 = friendTrackStore0 ? friendTrackStore0 : fDummyFriendTrack;
+        fCosmicPairsRow.fFriendTrack1 = friendTrackStore1 ? friendTrackStore1 : fDummyFriendTrack;
+        fCosmicPairsTree->Fill();
+        continue;
+      }
       (*fTreeSRedirector)<<"CosmicPairs"<<
         "gid="<<gid<<                         // global id of track
         "fileName.="<<&fCurrentFileName<<     // file name
@@ -710,6 +988,27 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
       if(!fFillTree) return;
       if(!fTreeSRedirector) return;
       downscaleCounter++;
+      if (fUseSchemaWriter) {
+        BranchHighPtRow(kFALSE,kFALSE);
+        fHighPtRow.fGid = gid;
+        fHighPtRow.fFileName = &fCurrentFileName;
+        fHighPtRow.fRunNumber = runNumber;
+        fHighPtRow.fEvtTimeStamp = evtTimeStamp;
+        fHighPtRow.fEvtNumberInFile = evtNumberInFile;
+        fHighPtRow.fTriggerClass = &triggerClass;
+        fHighPtRow.fBz = bz;
+        fHighPtRow.fVtxESD = vtxESD;
+        fHighPtRow.fNtracksESD = ntracks;
+        fHighPtRow.fIRtot = ir1;
+        fHighPtRow.fIRint2 = ir2;
+        fHighPtRow.fMult = mult;
+        fHighPtRow.fMultSPD = multSPD;
+        fHighPtRow.fMultTPC = multTPC;
+        fHighPtRow.fEsdTrack = track;
+        fHighPtRow.fCentralityF = centralityF;
+        fHighPtTree->Fill();
+        continue;
+      }
       (*fTreeSRedirector)<<"highPt"<<
         "gid="<<gid<<
         "fileName.="<<&fCurrentFileName<<            
@@ -767,6 +1066,20 @@ void AliAnalysisTaskFilteredTree::ProcessLaser(AliESDEvent *const esdEvent, AliM
       Bool_t skipTrack=gRandom->Rndm()>1/(1+TMath::Abs(fFriendDownscaling));
       if (skipTrack) continue;
       if (esdFriend) {if (!esdFriend->TestSkipBit()) friendTrack = (AliESDfriendTrack*)track->GetFriendTrack();} //this guy can be NULL      
+      if (fUseSchemaWriter) {
+        fLaserRow.fGid = gid;
+        fLaserRow.fFileName = &fCurrentFileName;
+        fLaserRow.fRunNumber = runNumber;
+        fLaserRow.fEvtTimeStamp = evtTimeStamp;
+        fLaserRow.fEvtNumberInFile = evtNumberInFile;
+        fLaserRow.fTriggerClass = &triggerClass;
+        fLaserRow.fBz = bz;
+        fLaserRow.fMultTPCtracks = countLaserTracks;
+        fLaserRow.fTrack = track;
+        fLaserRow.fFriendTrack = friendTrack ? friendTrack : fDummyFriendTrack;
+        fLaserTree->Fill();
+        continue;
+      }
       (*fTreeSRedirector)<<"Laser"<<
         "gid="<<gid<<                          // global identifier of event
         "fileName.="<<&fCurrentFileName<<              //
@@ -1433,7 +1746,93 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTPC, track, nSpecies, tpcPID.GetMatrixArray());
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTOF, track, nSpecies, tofPID.GetMatrixArray());	    
 	}
-        if(fTreeSRedirector && dumpToTree && fFillTree) {
+        if(fTreeSRedirector && dumpToTree && fFillTree && fUseSchemaWriter) {
+	  downscaleCounter++;
+          BranchHighPtRow(kTRUE,mcEvent!=NULL);
+          fHighPtRow.fGid = gid;
+          fHighPtRow.fFileName = &fCurrentFileName;
+          fHighPtRow.fRunNumber = runNumber;
+          fHighPtRow.fEvtTimeStamp = evtTimeStamp;
+          fHighPtRow.fEvtNumberInFile = evtNumberInFile;
+          fHighPtRow.fTriggerClass = &triggerClass;
+          fHighPtRow.fBz = bz;
+          fHighPtRow.fVtxESD = vtxESD;
+          fHighPtRow.fIRtot = ir1;
+          fHighPtRow.fIRint2 = ir2;
+          fHighPtRow.fMult = mult;
+          fHighPtRow.fNtracks = ntracks;
+          fHighPtRow.fContTPC = contTPC;
+          fHighPtRow.fContSPD = contSPD;
+          fHighPtRow.fVertexPosTPC = &vertexPosTPC;
+          fHighPtRow.fVertexPosSPD = &vertexPosSPD;
+          fHighPtRow.fNtracksTPC = ntracksTPC;
+          fHighPtRow.fNtracksITS = ntracksITS;
+          fHighPtRow.fEsdTrack = track;
+          fHighPtRow.fTofClInfo = &tofClInfo;
+          fHighPtRow.fTofNsigma = &tofNsigma;
+          fHighPtRow.fTpcNsigma = &tpcNsigma;
+          fHighPtRow.fTofPID = &tofPID;
+          fHighPtRow.fTpcPID = &tpcPID;
+          fHighPtRow.fFriendTrack = friendTrackStore ? friendTrackStore : fDummyFriendTrack;
+          fHighPtRow.fExtTPCInnerC = tpcInnerC;
+          fHighPtRow.fExtInnerParamV = trackInnerV;
+          fHighPtRow.fExtInnerParamC = trackInnerC ? trackInnerC : fDummyParam;
+          fHighPtRow.fExtInnerParam = trackInnerC2;
+          fHighPtRow.fExtOuterITS = outerITSc ? outerITSc : fDummyParam;
+          fHighPtRow.fExtInnerParamRef = trackInnerC3;
+          fHighPtRow.fChi2TPCInnerC = chi2(0,0);
+          fHighPtRow.fChi2InnerC = chi2trackC(0,0);
+          fHighPtRow.fChi2OuterITS = chi2OuterITS(0,0);
+          fHighPtRow.fCentralityF = centralityF;
+          fHighPtRow.fParamITS = &paramITS;
+          fHighPtRow.fParamITSC = &paramITSC;
+          fHighPtRow.fParamComb = &paramComb;
+          fHighPtRow.fIndexNearestITS = indexNearestITS;
+          fHighPtRow.fIndexNearestITSC = indexNearestITSC;
+          fHighPtRow.fIndexNearestComb = indexNearestComb;
+          if (mcEvent) {
+	    downscaleCounter++;
+            fHighPtRow.fMultMCTrueTracks = multMCTrueTracks;
+            fHighPtRow.fNrefITS = nrefITS;
+            fHighPtRow.fNrefTPC = nrefTPC;
+            fHighPtRow.fNrefTRD = nrefTRD;
+            fHighPtRow.fNrefTOF = nrefTOF;
+            fHighPtRow.fNrefEMCAL = nrefEMCAL;
+            fHighPtRow.fNrefPHOS = nrefPHOS;
+            fHighPtRow.fRefTPCIn = refTPCIn;
+            fHighPtRow.fRefTPCOut = refTPCOut ? refTPCOut : fDummyTrackReference;
+            fHighPtRow.fRefITS = refITS;
+            fHighPtRow.fRefTRD = refTRD ? refTRD : fDummyTrackReference;
+            fHighPtRow.fRefTOF = refTOF ? refTOF : fDummyTrackReference;
+            fHighPtRow.fRefEMCAL = refEMCAL ? refEMCAL : fDummyTrackReference;
+            fHighPtRow.fRefPHOS = refPHOS ? refPHOS : fDummyTrackReference;
+            fHighPtRow.fMC.fParticle = particle;
+            fHighPtRow.fMC.fParticleMother = particleMother;
+            fHighPtRow.fMC.fMech = mech;
+            fHighPtRow.fMC.fIsPrim = isPrim;
+            fHighPtRow.fMC.fIsFromStrangess = isFromStrangess;
+            fHighPtRow.fMC.fIsFromConversion = isFromConversion;
+            fHighPtRow.fMC.fIsFromMaterial = isFromMaterial;
+            fHighPtRow.fMCTPC.fParticle = particleTPC;
+            fHighPtRow.fMCTPC.fParticleMother = particleMotherTPC;
+            fHighPtRow.fMCTPC.fMech = mechTPC;
+            fHighPtRow.fMCTPC.fIsPrim = isPrimTPC;
+            fHighPtRow.fMCTPC.fIsFromStrangess = isFromStrangessTPC;
+            fHighPtRow.fMCTPC.fIsFromConversion = isFromConversionTPC;
+            fHighPtRow.fMCTPC.fIsFromMaterial = isFromMaterialTPC;
+            fHighPtRow.fMCITS.fParticle = particleITS;
+            fHighPtRow.fMCITS.fParticleMother = particleMotherITS;
+            fHighPtRow.fMCITS.fMech = mechITS;
+            fHighPtRow.fMCITS.fIsPrim = isPrimITS;
+            fHighPtRow.fMCITS.fIsFromStrangess = isFromStrangessITS;
+            fHighPtRow.fMCITS.fIsFromConversion = isFromConversionITS;
+            fHighPtRow.fMCITS.fIsFromMaterial = isFromMaterialITS;
+          }
+          fHighPtRow.fDownscaleCounter = downscaleCounter;
+          AliInfo("writing tree highPt");
+          fHighPtTree->Fill();
+        }
+        if(fTreeSRedirector && dumpToTree && fFillTree && !fUseSchemaWriter) {
 	  downscaleCounter++;
           (*fTreeSRedirector)<<"highPt"<<
 	    "downscaleCounter="<<downscaleCounter<<   
@@ -1784,6 +2183,35 @@ void AliAnalysisTaskFilteredTree::ProcessMCEff(AliESDEvent *const esdEvent, AliM
       //
       if(fTreeSRedirector && fFillTree) {
 	downscaleCounter++;
+        if (fUseSchemaWriter) {
+          fMCEffRow.fFileName = &fCurrentFileName;
+          fMCEffRow.fTriggerClass = &triggerClass;
+          fMCEffRow.fRunNumber = runNumber;
+          fMCEffRow.fEvtTimeStamp = evtTimeStamp;
+          fMCEffRow.fEvtNumberInFile = evtNumberInFile;
+          fMCEffRow.fBz = bz;
+          fMCEffRow.fVtxESD = vtxESD;
+          fMCEffRow.fMult = mult;
+          fMCEffRow.fMultMCTrueTracks = multMCTrueTracks;
+          fMCEffRow.fContTPC = contTPC;
+          fMCEffRow.fContSPD = contSPD;
+          fMCEffRow.fVertexPosTPC = &vertexPosTPC;
+          fMCEffRow.fVertexPosSPD = &vertexPosSPD;
+          fMCEffRow.fNtracksTPC = ntracksTPC;
+          fMCEffRow.fNtracksITS = ntracksITS;
+          fMCEffRow.fIsAcc0 = isESDtrackCut;
+          fMCEffRow.fIsAcc1 = isAccCuts;
+          fMCEffRow.fEsdTrack = recTrack;
+          fMCEffRow.fIsRec = isRec;
+          fMCEffRow.fTpcTrackLength = tpcTrackLength;
+          fMCEffRow.fParticle = particle;
+          fMCEffRow.fParticleMother = particleMother ? particleMother : fDummyParticle;
+          fMCEffRow.fMech = mech;
+          fMCEffRow.fNRec = nRec;
+          fMCEffRow.fNFakes = nFakes;
+          fMCEffTree->Fill();
+          continue;
+        }
         (*fTreeSRedirector)<<"MCEffTree"<<
           "fileName.="<<&fCurrentFileName<<
           "triggerClass.="<<&triggerClass<<
@@ -2048,6 +2476,33 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
       }
 
       downscaleCounter++;
+      if (fUseSchemaWriter) {
+        fV0Row.fGid = gid;
+        fV0Row.fIsDownscaled = isDownscaled;
+        fV0Row.fTriggerClass = &triggerClass;
+        fV0Row.fBz = bz;
+        fV0Row.fFileName = &fCurrentFileName;
+        fV0Row.fRunNumber = run;
+        fV0Row.fEvtTimeStamp = time;
+        fV0Row.fEvtNumberInFile = evNr;
+        fV0Row.fType = type;
+        fV0Row.fNtracks = ntracks;
+        fV0Row.fV0 = v0;
+        fV0Row.fKF = &kfparticle;
+        fV0Row.fTrack0 = track0;
+        fV0Row.fTrack1 = track1;
+        fV0Row.fTofClInfo0 = &tofClInfo0;
+        fV0Row.fTofClInfo1 = &tofClInfo1;
+        fV0Row.fTofNsigma0 = &tofNsigma0;
+        fV0Row.fTofNsigma1 = &tofNsigma1;
+        fV0Row.fTpcNsigma0 = &tpcNsigma0;
+        fV0Row.fTpcNsigma1 = &tpcNsigma1;
+        fV0Row.fFriendTrack0 = friendTrackStore0 ? friendTrackStore0 : fDummyFriendTrack;
+        fV0Row.fFriendTrack1 = friendTrackStore1 ? friendTrackStore1 : fDummyFriendTrack;
+        fV0Row.fCentralityF = centralityF;
+        fV0Tree->Fill();
+        continue;
+      }
       (*fTreeSRedirector)<<"V0s"<<
         "gid="<<gid<<                         //  global id of event
         "isDownscaled="<<isDownscaled<<       //  
@@ -2199,6 +2654,23 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
       }
 	
       downscaleCounter++;
+      if (fUseSchemaWriter) {
+        fdEdxRow.fGid = gid;
+        fdEdxRow.fFileName = &fCurrentFileName;
+        fdEdxRow.fRunNumber = runNumber;
+        fdEdxRow.fEvtTimeStamp = evtTimeStamp;
+        fdEdxRow.fEvtNumberInFile = evtNumberInFile;
+        fdEdxRow.fTriggerClass = &triggerClass;
+        fdEdxRow.fBz = bz;
+        fdEdxRow.fVtxESD = vtxESD;
+        fdEdxRow.fMult = mult;
+        fdEdxRow.fEsdTrack = track;
+        fdEdxRow.fFriendTrack = friendTrack ? friendTrack : fDummyFriendTrack;
+        fdEdxRow.fTofNsigma = &tofNsigma;
+        fdEdxRow.fTpcNsigma = &tpcNsigma;
+        fdEdxTree->Fill();
+        continue;
+      }
       (*fTreeSRedirector)<<"dEdx"<<           // high dEdx tree
         "gid="<<gid<<                         // global id
         "fileName.="<<&fCurrentFileName<<     // file name
@@ -30,7 +30,9 @@ class TTree;
 class TTreeSRedirector;
 class TParticle;
 class TH3D;
+class AliTrackReference;
 #include <string>
+#include "TVectorD.h"
 
 #include "AliTriggerAnalysis.h"
 #include "AliAnalysisTaskSE.h"
@@ -114,6 +116,8 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   void SetFillTrees(Bool_t filltree) { fFillTree = filltree ;}
   Bool_t GetFillTrees() { return fFillTree ;}
+  void SetUseSchemaWriter(Bool_t flag) { fUseSchemaWriter = flag; }
+  Bool_t GetUseSchemaWriter() const { return fUseSchemaWriter; }
 
   void FillHistograms(AliESDtrack* const ptrack, AliExternalTrackParam* const ptpcInnerC, Double_t centralityF, Double_t chi2TPCInnerC);
   Int_t   GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType,  AliExternalTrackParam & paramNearest);
@@ -123,6 +127,186 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   Int_t GetMCInfoKink(Int_t label,    std::map<std::string,float> &kinkInfoF, std::map<std::string,TObject*> &kinkInfoO);  // TODO
   static Int_t GetMCTrackDiff(const TParticle &particle, const AliExternalTrackParam &param, TClonesArray &trackRefArray, TVectorF &mcDiff); //TODO test before enabling
  private:
+  //
+  // rows bound once to the branches of the filtered tree streams (see InitSchemaWriter)
+  // branch names, leaf types and object classes are the ones created by the TTreeSRedirector chains,
+  // objects are written as split branches (splitlevel 99), hence all the existing TTree::Draw aliases
+  // (member based as esdTrack.fP[4] and method based as esdTrack.Pt()) keep working
+  // object pointers are never NULL when a row is filled - missing objects are replaced by the dummies
+  //
+  struct FilteredTreeMCParticleColumns_t {
+    TParticle         *fParticle;          // MC particle
+    TParticle         *fParticleMother;    // MC mother
+    Int_t              fMech;              // production mechanism
+    Bool_t             fIsPrim;            // physical primary
+    Bool_t             fIsFromStrangess;   // from strangeness decay
+    Bool_t             fIsFromConversion;  // from conversion
+    Bool_t             fIsFromMaterial;    // from material
+  };
+  struct FilteredTreeHighPtRow_t {
+    Int_t              fDownscaleCounter;  // downscale counter (ProcessAll)
+    ULong64_t          fGid;               // global event id
+    TObjString        *fFileName;          // input file name
+    Int_t              fRunNumber;         // run number
+    Int_t              fEvtTimeStamp;      // event time stamp
+    Int_t              fEvtNumberInFile;   // event number in file
+    TObjString        *fTriggerClass;      // fired trigger classes
+    Float_t            fBz;                // magnetic field
+    AliESDVertex      *fVtxESD;            // primary vertex
+    Int_t              fNtracksESD;        // number of ESD tracks (Process)
+    Int_t              fIRtot;             // interaction record counter 1
+    Int_t              fIRint2;            // interaction record counter 2
+    Int_t              fMult;              // vertex contributors
+    Int_t              fMultSPD;           // SPD vertex contributors (Process)
+    Int_t              fMultTPC;           // TPC vertex contributors (Process)
+    Int_t              fNtracks;           // number of ESD tracks (ProcessAll)
+    Int_t              fContTPC;           // TPC vertex contributors (ProcessAll)
+    Int_t              fContSPD;           // SPD vertex contributors (ProcessAll)
+    TVectorD          *fVertexPosTPC;      // TPC vertex position
+    TVectorD          *fVertexPosSPD;      // SPD vertex position
+    Int_t              fNtracksTPC;        // number of TPC refitted tracks
+    Int_t              fNtracksITS;        // number of ITS refitted tracks
+    AliESDtrack       *fEsdTrack;          // track
+    TVectorD          *fTofClInfo;         // TOF cluster info
+    TVectorD          *fTofNsigma;         // TOF n sigma per species
+    TVectorD          *fTpcNsigma;         // TPC n sigma per species
+    TVectorD          *fTofPID;            // TOF bayesian PID
+    TVectorD          *fTpcPID;            // TPC bayesian PID
+    AliESDfriendTrack *fFriendTrack;       // friend track
+    AliExternalTrackParam *fExtTPCInnerC;     // TPC inner constrained at the vertex
+    AliExternalTrackParam *fExtInnerParamV;   // inner param propagated to the vertex
+    AliExternalTrackParam *fExtInnerParamC;   // inner param constrained at the vertex
+    AliExternalTrackParam *fExtInnerParam;    // inner param at the TPC reference radius
+    AliExternalTrackParam *fExtOuterITS;      // ITS outer param at the TPC reference radius
+    AliExternalTrackParam *fExtInnerParamRef; // inner param at the first TPC track reference
+    Double_t           fChi2TPCInnerC;     // chi2 TPC inner constrained - track
+    Double_t           fChi2InnerC;        // chi2 inner param constrained - track
+    Double_t           fChi2OuterITS;      // chi2 ITS outer - inner param
+    Float_t            fCentralityF;       // centrality
+    AliExternalTrackParam *fParamITS;      // nearest ITS track
+    AliExternalTrackParam *fParamITSC;     // nearest ITS track to the constrained track
+    AliExternalTrackParam *fParamComb;     // nearest combined track
+    Int_t              fIndexNearestITS;   // index of the nearest ITS track
+    Int_t              fIndexNearestITSC;  // index of the nearest ITS track to the constrained track
+    Int_t              fIndexNearestComb;  // index of the nearest combined track
+    Int_t              fMultMCTrueTracks;  // MC primary multiplicity
+    Int_t              fNrefITS;           // number of ITS track references
+    Int_t              fNrefTPC;           // number of TPC track references
+    Int_t              fNrefTRD;           // number of TRD track references
+    Int_t              fNrefTOF;           // number of TOF track references
+    Int_t              fNrefEMCAL;         // number of EMCAL track references
+    Int_t              fNrefPHOS;          // number of PHOS track references
+    AliTrackReference *fRefTPCIn;          // first TPC track reference
+    AliTrackReference *fRefTPCOut;         // last TPC track reference
+    AliTrackReference *fRefITS;            // ITS track reference
+    AliTrackReference *fRefTRD;            // TRD track reference
+    AliTrackReference *fRefTOF;            // TOF track reference
+    AliTrackReference *fRefEMCAL;          // EMCAL track reference
+    AliTrackReference *fRefPHOS;           // PHOS track reference
+    FilteredTreeMCParticleColumns_t fMC;    // MC particle of the global track
+    FilteredTreeMCParticleColumns_t fMCTPC; // MC particle of the TPC track
+    FilteredTreeMCParticleColumns_t fMCITS; // MC particle of the ITS track
+  };
+  struct FilteredTreeV0Row_t {
+    ULong64_t          fGid;               // global event id
+    Bool_t             fIsDownscaled;      // V0 downscaled
+    TObjString        *fTriggerClass;      // fired trigger classes
+    Float_t            fBz;                // magnetic field
+    TObjString        *fFileName;          // input file name
+    Int_t              fRunNumber;         // run number
+    Int_t              fEvtTimeStamp;      // event time stamp
+    Int_t              fEvtNumberInFile;   // event number in file
+    Int_t              fType;              // V0 type
+    Int_t              fNtracks;           // number of ESD tracks
+    AliESDv0          *fV0;                // V0
+    AliKFParticle     *fKF;                // KF particle
+    AliESDtrack       *fTrack0;            // positive track
+    AliESDtrack       *fTrack1;            // negative track
+    TVectorD          *fTofClInfo0;        // TOF cluster info track0
+    TVectorD          *fTofClInfo1;        // TOF cluster info track1
+    TVectorD          *fTofNsigma0;        // TOF n sigma track0
+    TVectorD          *fTofNsigma1;        // TOF n sigma track1
+    TVectorD          *fTpcNsigma0;        // TPC n sigma track0
+    TVectorD          *fTpcNsigma1;        // TPC n sigma track1
+    AliESDfriendTrack *fFriendTrack0;      // friend track0
+    AliESDfriendTrack *fFriendTrack1;      // friend track1
+    Float_t            fCentralityF;       // centrality
+  };
+  struct FilteredTreedEdxRow_t {
+    ULong64_t          fGid;               // global event id
+    TObjString        *fFileName;          // input file name
+    Double_t           fRunNumber;         // run number
+    Double_t           fEvtTimeStamp;      // event time stamp
+    Int_t              fEvtNumberInFile;   // event number in file
+    TObjString        *fTriggerClass;      // fired trigger classes
+    Double_t           fBz;                // magnetic field
+    AliESDVertex      *fVtxESD;            // primary vertex
+    Int_t              fMult;              // vertex contributors
+    AliESDtrack       *fEsdTrack;          // track
+    AliESDfriendTrack *fFriendTrack;       // friend track
+    TVectorD          *fTofNsigma;         // TOF n sigma per species
+    TVectorD          *fTpcNsigma;         // TPC n sigma per species
+  };
+  struct FilteredTreeLaserRow_t {
+    ULong64_t          fGid;               // global event id
+    TObjString        *fFileName;          // input file name
+    Int_t              fRunNumber;         // run number
+    Int_t              fEvtTimeStamp;      // event time stamp
+    Int_t              fEvtNumberInFile;   // event number in file
+    TObjString        *fTriggerClass;      // fired trigger classes
+    Float_t            fBz;                // magnetic field
+    Int_t              fMultTPCtracks;     // number of tracks with TPC inner param
+    AliESDtrack       *fTrack;             // track
+    AliESDfriendTrack *fFriendTrack;       // friend track
+  };
+  struct FilteredTreeMCEffRow_t {
+    TObjString        *fFileName;          // input file name
+    TObjString        *fTriggerClass;      // fired trigger classes
+    Double_t           fRunNumber;         // run number
+    Double_t           fEvtTimeStamp;      // event time stamp
+    Int_t              fEvtNumberInFile;   // event number in file
+    Double_t           fBz;                // magnetic field
+    AliESDVertex      *fVtxESD;            // primary vertex
+    Int_t              fMult;              // vertex contributors
+    Int_t              fMultMCTrueTracks;  // MC primary multiplicity
+    Int_t              fContTPC;           // TPC vertex contributors
+    Int_t              fContSPD;           // SPD vertex contributors
+    TVectorD          *fVertexPosTPC;      // TPC vertex position
+    TVectorD          *fVertexPosSPD;      // SPD vertex position
+    Int_t              fNtracksTPC;        // number of TPC refitted tracks
+    Int_t              fNtracksITS;        // number of ITS refitted tracks
+    Int_t              fIsAcc0;            // accepted by the ESD track cuts
+    Int_t              fIsAcc1;            // accepted by the acceptance cuts
+    AliESDtrack       *fEsdTrack;          // reconstructed track
+    Bool_t             fIsRec;             // particle reconstructed
+    Double_t           fTpcTrackLength;    // track length in the TPC
+    TParticle         *fParticle;          // MC particle
+    TParticle         *fParticleMother;    // MC mother
+    Int_t              fMech;              // production mechanism
+    Int_t              fNRec;              // number of reconstructed tracks
+    Int_t              fNFakes;            // number of fake tracks
+  };
+  struct FilteredTreeCosmicPairsRow_t {
+    ULong64_t          fGid;               // global event id
+    TObjString        *fFileName;          // input file name
+    Int_t              fRunNumber;         // run number
+    Int_t              fEvtTimeStamp;      // event time stamp
+    Int_t              fEvtNumberInFile;   // event number in file
+    ULong64_t          fTrigger;           // trigger mask
+    TObjString        *fTriggerClass;      // fired trigger classes
+    Float_t            fBz;                // magnetic field
+    Int_t              fMultSPD;           // SPD vertex contributors
+    Int_t              fMultTPC;           // TPC vertex contributors
+    AliESDVertex      *fVertSPD;           // SPD vertex
+    AliESDVertex      *fVertTPC;           // TPC vertex
+    AliESDtrack       *fT0;                // first half of the cosmic track
+    AliESDtrack       *fT1;                // second half of the cosmic track
+    AliESDfriendTrack *fFriendTrack0;      // friend track0
+    AliESDfriendTrack *fFriendTrack1;      // friend track1
+  };
+  void InitSchemaWriter();
+  void BranchHighPtRow(Bool_t processAll, Bool_t withMC);
+  static void BranchMCParticleColumns(TTree *tree, const char *suffix, FilteredTreeMCParticleColumns_t &columns);
 
   AliESDEvent *fESD;    //! ESD event
   AliMCEvent *fMC;      //! MC event
@@ -174,10 +358,22 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   TH3D* fPtResCentPtTPCITS; //! sigma(pt)/pt vs Cent vs Pt for prim. TPC+ITS tracks
   TObjString fCurrentFileName; // cached value of current file name
   AliESDtrack* fDummyTrack; //! dummy track for tree init
+  Bool_t fUseSchemaWriter;  // fill the trees through pre-bound branches instead of TTreeSRedirector chains
+  AliESDfriendTrack* fDummyFriendTrack;     //! dummy friend track for missing friend information
+  AliESDVertex* fDummyVertex;               //! dummy vertex for missing vertices
+  AliExternalTrackParam* fDummyParam;       //! dummy track parameters for failed propagations
+  AliTrackReference* fDummyTrackReference;  //! dummy track reference for missing references
+  TParticle* fDummyParticle;                //! dummy particle for missing MC particles
+  FilteredTreeHighPtRow_t      fHighPtRow;      //! row bound to the highPt tree
+  FilteredTreeV0Row_t          fV0Row;          //! row bound to the V0s tree
+  FilteredTreedEdxRow_t        fdEdxRow;        //! row bound to the dEdx tree
+  FilteredTreeLaserRow_t       fLaserRow;       //! row bound to the Laser tree
+  FilteredTreeMCEffRow_t       fMCEffRow;       //! row bound to the MCEffTree tree
+  FilteredTreeCosmicPairsRow_t fCosmicPairsRow; //! row bound to the CosmicPairs tree
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
@@ -0,0 +1,191 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TMap.h>
+#include <TMD5.h>
+#include <TObjString.h>
+#include <TSystem.h>
+
+#include "AliCalibSnapshot.h"
+#include "AliLog.h"
+
+ClassImp(AliCalibSnapshot)
+
+//______________________________________________________________________________
+AliCalibSnapshot::AliCalibSnapshot():
+           TObject(),
+           fDir(),
+           fPrefix(),
+           fSources(),
+           fRun(-1),
+           fFileName(),
+           fObjects(NULL),
+           fModified(kFALSE)
+{
+// Dummy constructor
+}
+
+//______________________________________________________________________________
+AliCalibSnapshot::AliCalibSnapshot(const char *dir, const char *prefix, const char *sources):
+           TObject(),
+           fDir(dir),
+           fPrefix(prefix),
+           fSources(sources),
+           fRun(-1),
+           fFileName(),
+           fObjects(NULL),
+           fModified(kFALSE)
+{
+// Constructor. The snapshots are named <dir>/<prefix>_<run>_<hash of sources>.root
+}
+
+//______________________________________________________________________________
+AliCalibSnapshot::~AliCalibSnapshot()
+{
+// Destructor, writes the objects added for the current run.
+  Flush();
+  if (fObjects) {
+    fObjects->DeleteAll();
+    delete fObjects;
+  }
+}
+
+//______________________________________________________________________________
+Bool_t AliCalibSnapshot::SetRun(Int_t run)
+{
+// Switch to a new run. The objects added for the previous run are written, then
+// the snapshot of the new run is loaded if it exists. Returns kTRUE if it does.
+  if (run == fRun) return (fObjects && fObjects->GetSize() > 0);
+  Flush();
+  if (!fObjects) {
+    fObjects = new TMap();
+  }
+  fObjects->DeleteAll();
+  fRun = run;
+  fFileName = GetFileName(fDir, fPrefix, fRun, fSources);
+  fModified = kFALSE;
+  if (gSystem->AccessPathName(fFileName, kReadPermission)) return kFALSE;
+
+  TFile *file = TFile::Open(fFileName, "READ");
+  if (!file || file->IsZombie()) {
+    AliWarning(Form("Cannot read the calibration snapshot %s", fFileName.Data()));
+    delete file;
+    return kFALSE;
+  }
+  // The objects must survive the closing of the file
+  Bool_t addDirectory = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+  TIter next(file->GetListOfKeys());
+  TKey *key;
+  while ((key=(TKey*)next())) {
+    TObject *obj = key->ReadObj();
+    if (obj) fObjects->Add(new TObjString(key->GetName()), obj);
+  }
+  TH1::AddDirectory(addDirectory);
+  file->Close();
+  delete file;
+  AliInfo(Form("Loaded %d objects from the calibration snapshot %s", fObjects->GetSize(), fFileName.Data()));
+  return (fObjects->GetSize() > 0);
+}
+
+//______________________________________________________________________________
+TObject *AliCalibSnapshot::Get(const char *key) const
+{
+// Object of the current run stored under key, owned by the snapshot.
+  return fObjects ? fObjects->GetValue(key) : NULL;
+}
+
+//______________________________________________________________________________
+void AliCalibSnapshot::Add(const char *key, TObject *obj)
+{
+// Add an object to the snapshot of the current run, the object is adopted.
+// It is written with the next Flush() or run change.
+  if (!fObjects || !obj) return;
+  TObjString skey(key);
+  if (fObjects->FindObject(&skey)) fObjects->DeleteEntry(&skey);
+  fObjects->Add(new TObjString(key), obj);
+  fModified = kTRUE;
+}
+
+//______________________________________________________________________________
+Bool_t AliCalibSnapshot::Flush()
+{
+// Write the snapshot of the current run if objects were added since it was
+// loaded. All objects of the run are written to a temporary file, renamed at
+// the end, such that concurrent jobs only see complete snapshots.
+  if (!fModified || !fObjects || !fFileName.Length()) return kTRUE;
+  fModified = kFALSE;
+  if (gSystem->AccessPathName(fDir) && gSystem->mkdir(fDir, kTRUE)) {
+    AliWarning(Form("Cannot create the snapshot directory %s", fDir.Data()));
+    return kFALSE;
+  }
+  TString tmpFileName = GetTempFileName(fFileName);
+  TFile *file = TFile::Open(tmpFileName, "RECREATE");
+  if (!file || file->IsZombie()) {
+    AliWarning(Form("Cannot write the calibration snapshot %s", tmpFileName.Data()));
+    delete file;
+    return kFALSE;
+  }
+  TIter next(fObjects);
+  TObjString *key;
+  while ((key=(TObjString*)next())) file->WriteTObject(fObjects->GetValue(key), key->GetName());
+  file->Close();
+  delete file;
+  return Publish(tmpFileName, fFileName);
+}
+
+//______________________________________________________________________________
+TString AliCalibSnapshot::GetFileName(const char *dir, const char *prefix, Int_t run, const char *sources)
+{
+// Name of the snapshot of a run for the given calibration sources.
+  return TString::Format("%s/%s_%09d_%s.root", dir, prefix, run, GetHash(sources).Data());
+}
+
+//______________________________________________________________________________
+TString AliCalibSnapshot::GetHash(const char *text)
+{
+// Short hash of a text, used in the file names and as keys of the objects.
+  TMD5 md5;
+  md5.Update((const UChar_t*)text, strlen(text));
+  md5.Final();
+  return TString(md5.AsString(), 16);
+}
+
+//______________________________________________________________________________
+Bool_t AliCalibSnapshot::Publish(const char *tmpFileName, const char *fileName)
+{
+// Move a complete temporary snapshot to its final name. The rename is atomic
+// within the directory, a concurrent job writing the same snapshot just
+// replaces it with an equivalent one.
+  if (gSystem->Rename(tmpFileName, fileName)) {
+    AliWarningClass(Form("Cannot rename %s to %s", tmpFileName, fileName));
+    gSystem->Unlink(tmpFileName);
+    return kFALSE;
+  }
+  AliInfoClass(Form("Calibration snapshot %s written", fileName));
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+TString AliCalibSnapshot::GetTempFileName(const char *fileName)
+{
+// Temporary name of a snapshot being written, unique to this process.
+  return TString::Format("%s.%s.%d.tmp", fileName, gSystem->HostName(), gSystem->GetPid());
+}
@@ -0,0 +1,62 @@
+#ifndef ALICALIBSNAPSHOT_H
+#define ALICALIBSNAPSHOT_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//==============================================================================
+//   AliCalibSnapshot - Local per-run snapshot of calibration objects.
+//      A snapshot is a ROOT file in a local directory, shared by the jobs
+//      running on the same node. Its name contains the run number and a hash
+//      of the calibration sources, so that jobs using other sources never
+//      read it. Inside, each object is stored under a key given by its
+//      requester, usually a hash of where the object came from. Snapshots
+//      are written to a temporary file and renamed, a job never reads a
+//      partial one.
+//==============================================================================
+
+#ifndef ROOT_TObject
+#include <TObject.h>
+#endif
+#ifndef ROOT_TString
+#include <TString.h>
+#endif
+
+class TMap;
+
+class AliCalibSnapshot : public TObject {
+
+private:
+  TString                   fDir;            // Directory of the snapshots
+  TString                   fPrefix;         // Prefix of the file names
+  TString                   fSources;        // Description of the calibration sources
+  Int_t                     fRun;            //! Run of the loaded snapshot
+  TString                   fFileName;       //! Snapshot of the current run
+  TMap                     *fObjects;        //! Objects of the current run, by key
+  Bool_t                    fModified;       //! Objects were added since loading
+
+  AliCalibSnapshot(const AliCalibSnapshot &other);
+  AliCalibSnapshot& operator=(const AliCalibSnapshot &other);
+
+public:
+  AliCalibSnapshot();
+  AliCalibSnapshot(const char *dir, const char *prefix, const char *sources="");
+  virtual ~AliCalibSnapshot();
+
+  const char               *GetDir() const {return fDir.Data();}
+  Int_t                     GetRun() const {return fRun;}
+  const char               *GetSnapshotFileName() const {return fFileName.Data();}
+  Bool_t                    IsModified() const {return fModified;}
+
+  Bool_t                    SetRun(Int_t run);
+  TObject                  *Get(const char *key) const;
+  void                      Add(const char *key, TObject *obj);
+  Bool_t                    Flush();
+
+  static TString            GetFileName(const char *dir, const char *prefix, Int_t run, const char *sources);
+  static TString            GetHash(const char *text);
+  static Bool_t             Publish(const char *tmpFileName, const char *fileName);
+  static TString            GetTempFileName(const char *fileName);
+
+  ClassDef(AliCalibSnapshot,1)  // Local per-run snapshot of calibration objects
+};
+#endif
@@ -15,20 +15,164 @@
 
 /* $Id$ */
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <fstream>
+
 #include <TChain.h>
 #include <TFile.h>
+#include <TH1D.h>
+#include <TList.h>
+#include <TObjString.h>
+#include <TROOT.h>
+#include <TStopwatch.h>
+#include <TSystem.h>
+#include <TMath.h>
  
 #include "AliTender.h"
+#include "AliCalibSnapshot.h"
 #include "AliTenderSupply.h"
 #include "AliAnalysisManager.h"
 #include "AliCDBManager.h"
 #include "AliESDEvent.h"
+#include "AliESDtrack.h"
 #include "AliESDInputHandler.h"
 #include "AliLog.h"
 
 
 ClassImp(AliTender)
 
+namespace {
+  // Process a range of tracks with a sequence of track independent supplies
+  void ProcessTrackRange(AliESDEvent *event, const std::vector<AliTenderSupply*> &supplies, Int_t first, Int_t last)
+  {
+    for (Int_t itrack=first; itrack<last; itrack++) {
+      AliESDtrack *track = event->GetTrack(itrack);
+      for (UInt_t isupply=0; isupply<supplies.size(); isupply++) supplies[isupply]->ProcessTrack(track);
+    }
+  }
+}
+
+//______________________________________________________________________________
+// Worker threads of the fused track loops. They are started once, in
+// UserCreateOutputObjects, and wait for the loops of all the events. The
+// calling thread processes the first range of tracks. The errors of the
+// supplies in the loop are kept and returned to the calling thread.
+class AliTenderTrackPool {
+public:
+  AliTenderTrackPool(Int_t nthreads);
+  ~AliTenderTrackPool();
+
+  Int_t GetNThreads() const {return fWorkers.size()+1;}
+  void  Process(AliESDEvent *event, const std::vector<AliTenderSupply*> &supplies, Int_t nranges, std::vector<TString> &errors);
+
+private:
+  AliTenderTrackPool(const AliTenderTrackPool &other);
+  AliTenderTrackPool& operator=(const AliTenderTrackPool &other);
+
+  void  Work(Int_t ithread);
+
+  std::vector<std::thread>            fWorkers;    // Threads 1..n-1
+  std::mutex                          fMutex;      // Protects the members below
+  std::condition_variable             fStart;      // New loop or stop
+  std::condition_variable             fDone;       // All workers done with the loop
+  ULong64_t                           fGeneration; // Number of the current loop
+  Int_t                               fPending;    // Workers still processing the loop
+  Bool_t                              fStop;       // Stop the workers
+  AliESDEvent                        *fEvent;      // Event of the loop
+  const std::vector<AliTenderSupply*> *fSupplies;  // Supplies of the loop
+  Int_t                               fNRanges;    // Number of track ranges of the loop
+  std::vector<TString>                fErrors;     // Errors of the workers in the loop
+};
+
+//______________________________________________________________________________
+AliTenderTrackPool::AliTenderTrackPool(Int_t nthreads):
+  fWorkers(),
+  fMutex(),
+  fStart(),
+  fDone(),
+  fGeneration(0),
+  fPending(0),
+  fStop(kFALSE),
+  fEvent(NULL),
+  fSupplies(NULL),
+  fNRanges(1),
+  fErrors()
+{
+// Start nthreads-1 workers
+  for (Int_t ithread=1; ithread<nthreads; ithread++)
+    fWorkers.push_back(std::thread(&AliTenderTrackPool::Work, this, ithread));
+}
+
+//______________________________________________________________________________
+AliTenderTrackPool::~AliTenderTrackPool()
+{
+// Stop and join the workers
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = kTRUE;
+  }
+  fStart.notify_all();
+  for (UInt_t ithread=0; ithread<fWorkers.size(); ithread++) fWorkers[ithread].join();
+}
+
+//______________________________________________________________________________
+void AliTenderTrackPool::Process(AliESDEvent *event, const std::vector<AliTenderSupply*> &supplies, Int_t nranges, std::vector<TString> &errors)
+{
+// Process the tracks of the event in nranges ranges (at most the number of threads),
+// returns when all of them are done, with the errors of the supplies appended to errors
+  Int_t ntracks = event->GetNumberOfTracks();
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fEvent = event;
+    fSupplies = &supplies;
+    fNRanges = nranges;
+    fPending = fWorkers.size();
+    fGeneration++;
+  }
+  fStart.notify_all();
+  AliTenderSupply::SetTrackErrors(&errors);
+  ProcessTrackRange(event, supplies, 0, ntracks/nranges);
+  AliTenderSupply::SetTrackErrors(NULL);
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (fPending > 0) fDone.wait(lock);
+  errors.insert(errors.end(), fErrors.begin(), fErrors.end());
+  fErrors.clear();
+}
+
+//______________________________________________________________________________
+void AliTenderTrackPool::Work(Int_t ithread)
+{
+// Loop of worker ithread: process its range of tracks of each new loop
+  ULong64_t done = 0;
+  std::vector<TString> errors;
+  AliTenderSupply::SetTrackErrors(&errors);
+  while (kTRUE) {
+    AliESDEvent *event = NULL;
+    const std::vector<AliTenderSupply*> *supplies = NULL;
+    Int_t nranges = 0;
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      while (!fStop && fGeneration == done) fStart.wait(lock);
+      if (fStop) return;
+      done = fGeneration;
+      event = fEvent;
+      supplies = fSupplies;
+      nranges = fNRanges;
+    }
+    if (ithread < nranges) {
+      Int_t ntracks = event->GetNumberOfTracks();
+      ProcessTrackRange(event, *supplies, ithread*ntracks/nranges, (ithread+1)*ntracks/nranges);
+    }
+    std::lock_guard<std::mutex> lock(fMutex);
+    fErrors.insert(fErrors.end(), errors.begin(), errors.end());
+    errors.clear();
+    if (--fPending == 0) fDone.notify_one();
+  }
+}
+
 //______________________________________________________________________________
 AliTender::AliTender():
            AliAnalysisTaskSE(),
@@ -41,7 +185,17 @@ AliTender::AliTender():
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fFuseTrackLoops(kFALSE),
+           fNTrackThreads(1),
+           fTrackPool(NULL),
+           fTimingOutput(kFALSE),
+           fOutputList(NULL),
+           fHistTiming(NULL),
+           fCDBSnapshotDir(),
+           fCDBSnapshotWrite(kFALSE),
+           fCDBSnapshotFile(),
+           fCDBCacheFlag(kFALSE)
 {
 // Dummy constructor
 }
@@ -58,7 +212,17 @@ AliTender::AliTender(const char* name):
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fFuseTrackLoops(kFALSE),
+           fNTrackThreads(1),
+           fTrackPool(NULL),
+           fTimingOutput(kFALSE),
+           fOutputList(NULL),
+           fHistTiming(NULL),
+           fCDBSnapshotDir(),
+           fCDBSnapshotWrite(kFALSE),
+           fCDBSnapshotFile(),
+           fCDBCacheFlag(kFALSE)
 {
 // Default constructor
   DefineOutput(1,  AliESDEvent::Class());
@@ -72,6 +236,8 @@ AliTender::~AliTender()
     fSupplies->Delete();
     delete fSupplies;
   }
+  if (fOutputList) delete fOutputList;
+  delete fTrackPool;
 }
 
 //______________________________________________________________________________
@@ -130,6 +296,15 @@ void AliTender::ConnectInputData(Option_t* option)
   TIter next(fSupplies);
   AliTenderSupply *supply;
   while ((supply=(AliTenderSupply*)next())) supply->Init();
+  // The snapshot depends on the specific storages set by the supplies
+  if (fCDBSnapshotDir.Length()) {
+    if (!fHandleCDB) AliWarning("The OCDB snapshots are only used when the tender handles the OCDB");
+    else if (run) {
+      fCDBkey = fCDB->SetLock(kFALSE, fCDBkey);
+      UseCDBSnapshot();
+      fCDBkey = fCDB->SetLock(kTRUE, fCDBkey);
+    }
+  }
 }
 
 //______________________________________________________________________________
@@ -142,6 +317,23 @@ void AliTender::UserCreateOutputObjects()
      fESDhandler->SetUserCallSelectionMask(kTRUE);
      Info("UserCreateOutputObjects","The TENDER will check the event selection. Make sure you add the tender as FIRST wagon!");
   }   
+  if (fTimingOutput) {
+    fOutputList = new TList();
+    fOutputList->SetOwner();
+    Int_t nsupplies = fSupplies ? fSupplies->GetEntriesFast() : 0;
+    fHistTiming = new TH1D("fHistTiming", "Real time per supply;;time (s)", nsupplies+1, 0, nsupplies+1);
+    for (Int_t isupply=0; isupply<nsupplies; isupply++)
+      fHistTiming->GetXaxis()->SetBinLabel(isupply+1, fSupplies->At(isupply)->GetName());
+    fHistTiming->GetXaxis()->SetBinLabel(nsupplies+1, "threaded track loops");
+    fOutputList->Add(fHistTiming);
+    PostData(2, fOutputList);
+  }
+  // The threads of the fused track loops are reused for all events. ROOT must know
+  // about them, the supplies use ROOT classes in the loops.
+  if (fFuseTrackLoops && fNTrackThreads > 1 && !fTrackPool) {
+    ROOT::EnableThreadSafety();
+    fTrackPool = new AliTenderTrackPool(fNTrackThreads);
+  }
 }
 
 //______________________________________________________________________________
@@ -166,19 +358,246 @@ void AliTender::UserExec(Option_t* option)
       // Unlock CDB
       fCDBkey = fCDB->SetLock(kFALSE, fCDBkey);
       fCDB->SetRun(fRun);
+      if (fCDBSnapshotDir.Length()) UseCDBSnapshot();
       // Lock CDB
       fCDBkey = fCDB->SetLock(kTRUE, fCDBkey);
     } 
   }
-  TIter next(fSupplies);
-  AliTenderSupply *supply;
-  while ((supply=(AliTenderSupply*)next())) supply->ProcessEvent();
+  ProcessSupplies();
+  // The objects of the run are requested in its first event
+  if (fCDBSnapshotFile.Length()) WriteCDBSnapshot();
   fRunChanged = kFALSE;
 
   if (TObject::TestBit(kCheckEventSelection)) fESDhandler->CheckSelectionMask();
 
   TString opt = option;
-  if (!opt.Contains("NoPost")) PostData(1, fESD);
+  if (!opt.Contains("NoPost")) {
+    PostData(1, fESD);
+    if (fOutputList) PostData(2, fOutputList);
+  }
+}
+
+//______________________________________________________________________________
+void AliTender::ProcessSupplies()
+{
+// Call the supplies in their order. With fused track loops, the event parts of a
+// sequence of supplies using the per-track interface are called first, then their
+// tracks are processed in a single loop.
+  Int_t nsupplies = fSupplies ? fSupplies->GetEntriesFast() : 0;
+  TStopwatch timer;
+  std::vector<Int_t> loop;
+  Int_t isupply = 0;
+  while (isupply < nsupplies) {
+    AliTenderSupply *supply = (AliTenderSupply*)fSupplies->At(isupply);
+    if (!fFuseTrackLoops || !supply->UsesTrackLoop()) {
+      if (fHistTiming) timer.Start(kTRUE);
+      supply->ProcessEvent();
+      if (fHistTiming) fHistTiming->AddBinContent(isupply+1, timer.RealTime());
+      isupply++;
+      continue;
+    }
+    // Event parts of the sequence, a supply needing the processed tracks starts a new one
+    loop.clear();
+    Bool_t threads = (fNTrackThreads > 1);
+    Int_t first = isupply;
+    while (isupply < nsupplies) {
+      supply = (AliTenderSupply*)fSupplies->At(isupply);
+      if (!supply->UsesTrackLoop() || (isupply > first && supply->NeedsProcessedTracks())) break;
+      if (fHistTiming) timer.Start(kTRUE);
+      if (supply->BeginEvent()) {
+        loop.push_back(isupply);
+        threads = threads && supply->IsTrackIndependent();
+      }
+      if (fHistTiming) fHistTiming->AddBinContent(isupply+1, timer.RealTime());
+      isupply++;
+    }
+    if (!loop.empty()) ProcessTrackLoop(loop, threads);
+  }
+}
+
+//______________________________________________________________________________
+void AliTender::ProcessTrackLoop(const std::vector<Int_t> &supplies, Bool_t threads)
+{
+// Process all tracks with the given supplies, in a single loop. The tracks are
+// split in fNTrackThreads ranges if requested, processed by the threads of the
+// pool created in UserCreateOutputObjects. The time spent in each supply is
+// measured only without threads, otherwise the time of the loop is accumulated
+// in the last bin of the timing histogram. The errors of the supplies in the
+// threads are logged here, after the loop.
+  Int_t ntracks = fESD->GetNumberOfTracks();
+  UInt_t nsupplies = supplies.size();
+  std::vector<AliTenderSupply*> loop(nsupplies);
+  for (UInt_t isupply=0; isupply<nsupplies; isupply++) loop[isupply] = (AliTenderSupply*)fSupplies->At(supplies[isupply]);
+
+  Int_t nthreads = (threads && fTrackPool) ? TMath::Min(fTrackPool->GetNThreads(), ntracks) : 1;
+  if (nthreads > 1) {
+    TStopwatch timer;
+    std::vector<TString> errors;
+    fTrackPool->Process(fESD, loop, nthreads, errors);
+    if (fHistTiming) fHistTiming->AddBinContent(fHistTiming->GetNbinsX(), timer.RealTime());
+    for (UInt_t ierror=0; ierror<errors.size(); ierror++) AliError(errors[ierror].Data());
+    return;
+  }
+
+  if (!fHistTiming) {
+    ProcessTrackRange(fESD, loop, 0, ntracks);
+    return;
+  }
+  std::vector<Double_t> time(nsupplies, 0.);
+  for (Int_t itrack=0; itrack<ntracks; itrack++) {
+    AliESDtrack *track = fESD->GetTrack(itrack);
+    for (UInt_t isupply=0; isupply<nsupplies; isupply++) {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      loop[isupply]->ProcessTrack(track);
+      time[isupply] += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+    }
+  }
+  for (UInt_t isupply=0; isupply<nsupplies; isupply++) fHistTiming->AddBinContent(supplies[isupply]+1, time[isupply]);
+}
+
+//______________________________________________________________________________
+void AliTender::SetTimingOutput(Bool_t flag)
+{
+// Switch on/off the timing of the supplies. The output slot 2 is defined when
+// switching it on, it has to be connected by the user.
+   if (flag && !fTimingOutput) DefineOutput(2, TList::Class());
+   fTimingOutput = flag;
+}
+
+//______________________________________________________________________________
+void AliTender::UseCDBSnapshot()
+{
+// Read the OCDB objects of the current run from its snapshot if it exists,
+// otherwise write the snapshot after the first event if requested. The CDB
+// must be unlocked.
+  fCDBSnapshotFile = "";
+  fCDB->UnsetSnapshotMode();
+  TString fileName = AliCalibSnapshot::GetFileName(fCDBSnapshotDir, "OCDB", fRun, GetCDBSources(fCDB));
+  if (!gSystem->AccessPathName(fileName, kReadPermission) && fCDB->SetSnapshotMode(fileName)) {
+    AliInfo(Form("Reading the OCDB objects of run %d from %s", fRun, fileName.Data()));
+    return;
+  }
+  if (!fCDBSnapshotWrite) return;
+  // The snapshot is dumped from the cache, switched on until it is written
+  fCDBCacheFlag = fCDB->GetCacheFlag();
+  fCDB->SetCacheFlag(kTRUE);
+  fCDBSnapshotFile = fileName;
+}
+
+//______________________________________________________________________________
+void AliTender::WriteCDBSnapshot()
+{
+// Write the OCDB objects requested for the current run to its snapshot, and the
+// list of their paths, used by MakeCDBSnapshots() to prepare other runs.
+  if (gSystem->AccessPathName(fCDBSnapshotDir) && gSystem->mkdir(fCDBSnapshotDir, kTRUE)) {
+    AliWarning(Form("Cannot create the snapshot directory %s", fCDBSnapshotDir.Data()));
+    fCDBSnapshotFile = "";
+    fCDB->SetCacheFlag(fCDBCacheFlag);
+    return;
+  }
+  TString tmpFileName = AliCalibSnapshot::GetTempFileName(fCDBSnapshotFile);
+  fCDB->DumpToSnapshotFile(tmpFileName, kFALSE);
+  AliCalibSnapshot::Publish(tmpFileName, fCDBSnapshotFile);
+  fCDBSnapshotFile = "";
+
+  TString pathsFileName = GetCDBPathsFileName(fCDBSnapshotDir, GetCDBSources(fCDB));
+  tmpFileName = AliCalibSnapshot::GetTempFileName(pathsFileName);
+  std::ofstream out(tmpFileName.Data());
+  TIter next(fCDB->GetEntryCache());
+  TObjString *path;
+  while ((path=(TObjString*)next())) out << path->GetName() << std::endl;
+  out.close();
+  if (out.fail()) gSystem->Unlink(tmpFileName);
+  else AliCalibSnapshot::Publish(tmpFileName, pathsFileName);
+  fCDB->SetCacheFlag(fCDBCacheFlag);
+}
+
+//______________________________________________________________________________
+TString AliTender::GetCDBSources(const AliCDBManager *cdb)
+{
+// Storages of the CDB manager (default and specific ones), sorted. The snapshots
+// are addressed by the run and by these sources.
+  TList sources;
+  sources.SetOwner();
+  TIter next(cdb->GetStorageMap());
+  TObjString *key;
+  while ((key=(TObjString*)next())) {
+    TObject *storage = cdb->GetStorageMap()->GetValue(key);
+    sources.Add(new TObjString(Form("%s=%s", key->GetName(), storage ? storage->GetName() : "")));
+  }
+  sources.Sort();
+  TString result;
+  TIter nextSource(&sources);
+  while ((key=(TObjString*)nextSource())) result += Form("%s;", key->GetName());
+  return result;
+}
+
+//______________________________________________________________________________
+TString AliTender::GetCDBPathsFileName(const char *dir, const char *sources)
+{
+// List of the OCDB paths requested by the tender for the given sources.
+  return TString::Format("%s/OCDB_paths_%s.txt", dir, AliCalibSnapshot::GetHash(sources).Data());
+}
+
+//______________________________________________________________________________
+Int_t AliTender::MakeCDBSnapshots(const char *dir, const char *runList, const char *paths)
+{
+// Warm-up of the OCDB snapshots for the runs listed in the file runList (one
+// per line), using the storages configured in AliCDBManager::Instance(), which
+// must be the same as in the tender jobs. The comma separated OCDB paths are
+// those requested by the tender, by default read from the list written by a
+// previous job with the same storages. Existing snapshots are kept. Returns
+// the number of snapshots written.
+  AliCDBManager *cdb = AliCDBManager::Instance();
+  if (!cdb->IsDefaultStorageSet()) {
+    AliErrorClass("Default CDB storage not set");
+    return 0;
+  }
+  TString sources = GetCDBSources(cdb);
+  TString list = paths;
+  if (!list.Length()) {
+    TString pathsFileName = GetCDBPathsFileName(dir, sources);
+    std::ifstream in(pathsFileName.Data());
+    if (!in) {
+      AliErrorClass(Form("No OCDB paths given and no list %s for these storages", pathsFileName.Data()));
+      return 0;
+    }
+    TString line;
+    while (line.ReadLine(in)) if (line.Length()) list += line + ",";
+  }
+  TObjArray *pathArray = list.Tokenize(",");
+  if (gSystem->AccessPathName(dir) && gSystem->mkdir(dir, kTRUE)) {
+    AliErrorClass(Form("Cannot create the snapshot directory %s", dir));
+    delete pathArray;
+    return 0;
+  }
+  std::ifstream runs(runList);
+  if (!runs) {
+    AliErrorClass(Form("Cannot read the run list %s", runList));
+    delete pathArray;
+    return 0;
+  }
+  // The snapshots are dumped from the cache
+  Bool_t cacheFlag = cdb->GetCacheFlag();
+  cdb->SetCacheFlag(kTRUE);
+  Int_t nwritten = 0;
+  Int_t run;
+  while (runs >> run) {
+    TString fileName = AliCalibSnapshot::GetFileName(dir, "OCDB", run, sources);
+    if (!gSystem->AccessPathName(fileName)) continue;
+    cdb->SetRun(run);
+    TIter next(pathArray);
+    TObjString *path;
+    while ((path=(TObjString*)next())) {
+      if (!cdb->Get(path->GetName())) AliWarningClass(Form("No %s for run %d", path->GetName(), run));
+    }
+    TString tmpFileName = AliCalibSnapshot::GetTempFileName(fileName);
+    cdb->DumpToSnapshotFile(tmpFileName, kFALSE);
+    if (AliCalibSnapshot::Publish(tmpFileName, fileName)) nwritten++;
+  }
+  cdb->SetCacheFlag(cacheFlag);
+  delete pathArray;
+  return nwritten;
 }
 
 //______________________________________________________________________________
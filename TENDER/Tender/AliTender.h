@@ -13,6 +13,8 @@
 //      during pass1 reconstruction.
 //==============================================================================
 
+#include <vector>
+
 #ifndef ALIANALYSISTASKSE_H
 #include "AliAnalysisTaskSE.h"
 #endif
@@ -20,10 +22,13 @@
 // #ifndef ALIESDINPUTHANDLER_H
 // #include "AliESDInputHandler.h"
 // #endif
+class TH1D;
+class TList;
 class AliCDBManager;
 class AliESDEvent;
 class AliESDInputHandler;
 class AliTenderSupply;
+class AliTenderTrackPool;
 
 class AliTender : public AliAnalysisTaskSE {
 
@@ -43,10 +48,27 @@ private:
   AliESDEvent              *fESD;            //! Pointer to current ESD event
   TObjArray                *fSupplies;       // Array of tender supplies
   TObjArray                *fCDBSettings;    // Array with CDB configuration
+  Bool_t                    fFuseTrackLoops; // Process the tracks of consecutive supplies in one loop
+  Int_t                     fNTrackThreads;  // Number of threads for the fused track loops
+  AliTenderTrackPool       *fTrackPool;      //! Threads of the fused track loops
+  Bool_t                    fTimingOutput;   // Time the supplies, output in slot 2
+  TList                    *fOutputList;     //! Timing output
+  TH1D                     *fHistTiming;     //! Real time spent in each supply (s)
+  TString                   fCDBSnapshotDir; // Directory of the per-run OCDB snapshots
+  Bool_t                    fCDBSnapshotWrite;// Write the missing snapshots, using the CDB cache
+  TString                   fCDBSnapshotFile;//! Snapshot to write after the first event of the run
+  Bool_t                    fCDBCacheFlag;   //! CDB cache flag to restore once the snapshot is written
   
   AliTender(const AliTender &other);
   AliTender& operator=(const AliTender &other);
 
+  void                      ProcessSupplies();
+  void                      ProcessTrackLoop(const std::vector<Int_t> &supplies, Bool_t threads);
+  void                      UseCDBSnapshot();
+  void                      WriteCDBSnapshot();
+  static TString            GetCDBSources(const AliCDBManager *cdb);
+  static TString            GetCDBPathsFileName(const char *dir, const char *sources);
+
 public:  
   AliTender();
   AliTender(const char *name);
@@ -68,6 +90,34 @@ public:
    */
   void 			    SetHandleOCDB(Bool_t doHandle) { fHandleCDB = doHandle; }
   void SetESDhandler(AliESDInputHandler*esdH) {fESDhandler = esdH;}
+  /**
+   * Process the tracks of consecutive supplies implementing the per-track
+   * interface of AliTenderSupply in a single loop, each track going through
+   * the supplies in their order. A supply whose event part needs the processed
+   * tracks (AliTenderSupply::NeedsProcessedTracks) starts a new loop.
+   * @param[in] flag Switch on/off the fused loops (default: off)
+   * @param[in] nthreads Split the loops in this number of threads when all
+   *            their supplies are track independent. The threads are started
+   *            once, in UserCreateOutputObjects.
+   */
+  void                      SetFuseTrackLoops(Bool_t flag=kTRUE, Int_t nthreads=1) {fFuseTrackLoops = flag; fNTrackThreads = nthreads;}
+  /**
+   * Accumulate the real time spent in each supply in a histogram, written in
+   * output slot 2. To be called before connecting the outputs.
+   */
+  void                      SetTimingOutput(Bool_t flag=kTRUE);
+  /**
+   * Keep a local snapshot of the OCDB objects of each run in dir, shared by
+   * the jobs running on the same node. If the snapshot of a run exists, the
+   * objects are read from it. Otherwise, if write is set, the objects requested
+   * in the first event of the run are written to it: the CDB cache is switched
+   * on for this event only. Snapshots can also be prepared with MakeCDBSnapshots().
+   * Only when the tender handles the OCDB.
+   * @param[in] dir Local directory of the snapshots, off if empty
+   * @param[in] write Write the snapshots of the runs without one (default: off)
+   */
+  void                      SetCDBSnapshotDir(const char *dir, Bool_t write=kFALSE) {fCDBSnapshotDir = dir; fCDBSnapshotWrite = write;}
+  static Int_t              MakeCDBSnapshots(const char *dir, const char *runList, const char *paths="");
 
   // Run control
   virtual void              ConnectInputData(Option_t *option = "");
@@ -75,6 +125,6 @@ public:
 //  virtual Bool_t            Notify() {return kTRUE;}
   virtual void              UserExec(Option_t *option);
     
-  ClassDef(AliTender,4)  // Class describing the tender car for ESD analysis
+  ClassDef(AliTender,7)  // Class describing the tender car for ESD analysis
 };
 #endif
@@ -15,11 +15,18 @@
 
 /* $Id$ */
  
+#include "AliESDEvent.h"
+#include "AliLog.h"
 #include "AliTender.h"
 #include "AliTenderSupply.h"
 
 ClassImp(AliTenderSupply)
 
+namespace {
+  // Errors of ProcessTrack() kept for the current thread, see SetTrackErrors()
+  thread_local std::vector<TString> *gTrackErrors = NULL;
+}
+
 //______________________________________________________________________________
 AliTenderSupply::AliTenderSupply()
                 :TNamed(),
@@ -60,3 +67,34 @@ AliTenderSupply& AliTenderSupply::operator=(const AliTenderSupply &other)
    fTender = other.fTender;
    return *this;
 }
+
+//______________________________________________________________________________
+void AliTenderSupply::ProcessTracks()
+{
+// Standalone processing with the per-track interface: event part, then all tracks.
+   AliESDEvent *event = fTender->GetEvent();
+   if (!event || !BeginEvent()) return;
+   Int_t ntracks = event->GetNumberOfTracks();
+   for (Int_t itrack=0; itrack<ntracks; itrack++) ProcessTrack(event->GetTrack(itrack));
+}
+
+//______________________________________________________________________________
+void AliTenderSupply::SetTrackErrors(std::vector<TString> *errors)
+{
+// Keep the errors of ProcessTrack() in the current thread in errors, log them if NULL
+   gTrackErrors = errors;
+}
+
+//______________________________________________________________________________
+void AliTenderSupply::TrackError(const char *message) const
+{
+// Log an error of ProcessTrack(), or keep it if the thread processes a fused track loop
+   if (!gTrackErrors) {
+      AliError(message);
+      return;
+   }
+   TString error(GetName());
+   error += ": ";
+   error += message;
+   gTrackErrors->push_back(error);
+}
@@ -10,11 +10,14 @@
 //   AliTenderSupply - Base class for user-defined ESD additions and corrections.
 //==============================================================================
 
+#include <vector>
+
 #ifndef ROOT_TNamed
 #include "TNamed.h"
 #endif
 
 class AliTender;
+class AliESDtrack;
 
 class AliTenderSupply : public TNamed {
 
@@ -31,8 +34,30 @@ public:
   // Run control
   virtual void              Init() = 0;
   virtual void              ProcessEvent() = 0;
+
+  // Optional per-track interface, allowing the tender to process the tracks of
+  // consecutive supplies in a single loop (see AliTender::SetFuseTrackLoops).
+  // The event level part goes to BeginEvent(), which returns kFALSE if the tracks
+  // need no processing in this event, and ProcessTrack() may only modify the given
+  // track. ProcessEvent() of such a supply just calls ProcessTracks().
+  virtual Bool_t            UsesTrackLoop() const        {return kFALSE;}
+  virtual Bool_t            BeginEvent()                 {return kFALSE;}
+  virtual void              ProcessTrack(AliESDtrack * /*track*/) {}
+  // BeginEvent() reads the tracks, so the preceding supplies must be done with them
+  virtual Bool_t            NeedsProcessedTracks() const {return kTRUE;}
+  // ProcessTrack() can be called concurrently for different tracks
+  virtual Bool_t            IsTrackIndependent() const   {return kFALSE;}
+  // Keep the errors of ProcessTrack() called in the current thread in errors instead of
+  // logging them (NULL to log again). AliLog is not thread safe, the tender reports the
+  // errors of its track threads from the main thread.
+  static void               SetTrackErrors(std::vector<TString> *errors);
   
   void                      SetTender(const AliTender *tender) {fTender = tender;}
+
+protected:
+  void                      ProcessTracks();
+  // Error in ProcessTrack(), to be used instead of AliError() by track independent supplies
+  void                      TrackError(const char *message) const;
     
   ClassDef(AliTenderSupply,1)  // Base class for tender user algorithms
 };
@@ -4,6 +4,7 @@
 #pragma link off all classes;
 #pragma link off all functions;
 
+#pragma link C++ class  AliCalibSnapshot+;
 #pragma link C++ class  AliTender+;
 #pragma link C++ class  AliTenderSupply+;
 
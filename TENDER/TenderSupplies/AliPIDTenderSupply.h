@@ -14,6 +14,9 @@
 
 #include <AliTenderSupply.h>
 
+class AliESDpid;
+class AliESDtrack;
+
 class AliPIDTenderSupply: public AliTenderSupply {
   
 public:
@@ -23,16 +26,23 @@ public:
   virtual ~AliPIDTenderSupply(){;}
   
   virtual void              Init(){;}
-  virtual void              ProcessEvent();
+  virtual void              ProcessEvent() {ProcessTracks();}
+
+  // per-track interface, see AliTenderSupply
+  virtual Bool_t            UsesTrackLoop()        const {return kTRUE;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
+  virtual Bool_t            NeedsProcessedTracks() const {return fCachePID;}
 
   void SetCachePID(Bool_t cachePID) { fCachePID=cachePID; }
 private:
   Bool_t fCachePID;                    // Cache PID values in transient object
+  AliESDpid *fESDpid;                  //! ESD pid object of the current event
   
   AliPIDTenderSupply(const AliPIDTenderSupply&c);
   AliPIDTenderSupply& operator= (const AliPIDTenderSupply&c);
   
-  ClassDef(AliPIDTenderSupply, 2);  // PID tender task
+  ClassDef(AliPIDTenderSupply, 3);  // PID tender task
 };
 
 
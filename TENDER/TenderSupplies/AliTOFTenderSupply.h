@@ -28,7 +28,12 @@ public:
   virtual ~AliTOFTenderSupply(){;}
 
   virtual void              Init();
-  virtual void              ProcessEvent();
+  virtual void              ProcessEvent() {ProcessTracks();}
+
+  // per-track interface, see AliTenderSupply
+  virtual Bool_t            UsesTrackLoop() const {return kTRUE;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
 
   // TOF tender methods
   void SetIsMC(Bool_t flag=kFALSE){fIsMC=flag;}
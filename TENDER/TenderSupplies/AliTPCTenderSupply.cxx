@@ -72,7 +72,10 @@ fGRP(0x0),
 fBeamType("PP"),
 fLHCperiod(),
 fMCperiod(),
-fRecoPass(0)
+fRecoPass(0),
+fCorrFactor(1),
+fCorrAttachSlope(0),
+fCorrGainMultiplicityPbPb(1)
 {
   //
   // default ctor
@@ -101,7 +104,10 @@ fGRP(0x0),
 fBeamType("PP"),
 fLHCperiod(),
 fMCperiod(),
-fRecoPass(0)
+fRecoPass(0),
+fCorrFactor(1),
+fCorrAttachSlope(0),
+fCorrGainMultiplicityPbPb(1)
 {
   //
   // named ctor
@@ -149,14 +155,14 @@ void AliTPCTenderSupply::Init()
 }
 
 //_____________________________________________________
-void AliTPCTenderSupply::ProcessEvent()
+Bool_t AliTPCTenderSupply::BeginEvent()
 {
   //
-  // Reapply pid information
+  // Prepare the corrections of the event
   //
   
   AliESDEvent *event=fTender->GetEvent();
-  if (!event) return;
+  if (!event) return kFALSE;
   
   //load gain correction if run has changed
   if (fTender->RunChanged()){
@@ -172,38 +178,39 @@ void AliTPCTenderSupply::ProcessEvent()
   //
   // get gain correction factor
   //
-  Double_t corrFactor = GetGainCorrection();
-  Double_t corrAttachSlope = 0;
-  Double_t corrGainMultiplicityPbPb=1;
-  if (fAttachmentCorrection && fGainAttachment) corrAttachSlope = fGainAttachment->Eval(event->GetTimeStamp());
-  if (fMultiCorrection&&fMultiCorrMean) corrGainMultiplicityPbPb = fMultiCorrMean->Eval(GetTPCMultiplicityBin());
-  
+  fCorrFactor = GetGainCorrection();
+  fCorrAttachSlope = 0;
+  fCorrGainMultiplicityPbPb=1;
+  if (fAttachmentCorrection && fGainAttachment) fCorrAttachSlope = fGainAttachment->Eval(event->GetTimeStamp());
+  if (fMultiCorrection&&fMultiCorrMean) fCorrGainMultiplicityPbPb = fMultiCorrMean->Eval(GetTPCMultiplicityBin());
+  return kTRUE;
+}
+
+//_____________________________________________________
+void AliTPCTenderSupply::ProcessTrack(AliESDtrack *track)
+{
   //
   // - correct TPC signals
   // - recalculate PID probabilities for TPC
   // - correct TPC signal multiplicity dependence
-
-  Int_t ntracks=event->GetNumberOfTracks();
-  for(Int_t itrack = 0; itrack < ntracks; itrack++){
-    AliESDtrack *track=event->GetTrack(itrack);
-    const AliExternalTrackParam *inner=track->GetInnerParam();
+  //
+  const AliExternalTrackParam *inner=track->GetInnerParam();
     
-    // skip tracks without TPC information
-    if (!inner) continue;
+  // skip tracks without TPC information
+  if (!inner) return;
 
-    //calculate total gain correction factor given by
-    // o gain calibration factor
-    // o attachment correction
-    // o multiplicity correction in PbPb
-    Float_t meanDrift= 250. - 0.5*TMath::Abs(2*inner->GetZ() + (247-83)*inner->GetTgl());
-    Double_t corrGainTotal=corrFactor*(1 + corrAttachSlope*180.)/(1 + corrAttachSlope*meanDrift)/corrGainMultiplicityPbPb;
+  //calculate total gain correction factor given by
+  // o gain calibration factor
+  // o attachment correction
+  // o multiplicity correction in PbPb
+  Float_t meanDrift= 250. - 0.5*TMath::Abs(2*inner->GetZ() + (247-83)*inner->GetTgl());
+  Double_t corrGainTotal=fCorrFactor*(1 + fCorrAttachSlope*180.)/(1 + fCorrAttachSlope*meanDrift)/fCorrGainMultiplicityPbPb;
 
-    // apply gain correction
-    track->SetTPCsignal(track->GetTPCsignal()*corrGainTotal ,track->GetTPCsignalSigma(), track->GetTPCsignalN());
+  // apply gain correction
+  track->SetTPCsignal(track->GetTPCsignal()*corrGainTotal ,track->GetTPCsignalSigma(), track->GetTPCsignalN());
 
-    // recalculate pid probabilities
-    fESDpid->MakeTPCPID(track);
-  }
+  // recalculate pid probabilities
+  fESDpid->MakeTPCPID(track);
 }
 
 //_____________________________________________________
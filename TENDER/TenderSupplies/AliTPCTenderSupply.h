@@ -16,6 +16,7 @@
 
 class TObjArray;
 class AliESDpid;
+class AliESDtrack;
 class AliSplineFit;
 class AliGRPObject;
 class TGraphErrors;
@@ -41,7 +42,13 @@ public:
   void AddSpecificStorage(const char* cdbPath, const char* storage);
 
   virtual void              Init();
-  virtual void              ProcessEvent();
+  virtual void              ProcessEvent() {ProcessTracks();}
+
+  // per-track interface, see AliTenderSupply
+  virtual Bool_t            UsesTrackLoop()        const {return kTRUE;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
+  virtual Bool_t            NeedsProcessedTracks() const {return kFALSE;}
   
 private:
   AliESDpid          *fESDpid;         //! ESD pid object
@@ -69,6 +76,10 @@ private:
   TString fMCperiod;                 //! corresponding MC period to use for the splines
   Int_t   fRecoPass;                 //! reconstruction pass
 
+  Double_t fCorrFactor;              //! gain correction factor of the current event
+  Double_t fCorrAttachSlope;         //! attachment correction slope of the current event
+  Double_t fCorrGainMultiplicityPbPb;//! multiplicity correction of the current event
+
   void SetSplines();
   Double_t GetGainCorrection();
 
@@ -82,7 +93,7 @@ private:
   AliTPCTenderSupply(const AliTPCTenderSupply&c);
   AliTPCTenderSupply& operator= (const AliTPCTenderSupply&c);
   
-  ClassDef(AliTPCTenderSupply, 2);  // TPC tender task
+  ClassDef(AliTPCTenderSupply, 3);  // TPC tender task
 };
 
 
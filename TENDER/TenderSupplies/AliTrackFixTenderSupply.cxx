@@ -38,7 +38,9 @@ fDebug(0),
   fParams(0),
   fOADBObjPath("$OADB/PWGPP/data/CorrPTInv.root"),
   fOADBObjName("CorrPTInv"),
-  fOADBCont(0)
+  fOADBCont(0),
+  fVtx(0),
+  fVtxTPC(0)
 {
   // default ctor
 }
@@ -51,7 +53,9 @@ AliTrackFixTenderSupply::AliTrackFixTenderSupply(const char *name, const AliTend
   fParams(0),
   fOADBObjPath("$OADB/PWGPP/data/CorrPTInv.root"),
   fOADBObjName("CorrPTInv"),
-  fOADBCont(0)
+  fOADBCont(0),
+  fVtx(0),
+  fVtxTPC(0)
 {
   // named ctor
   //
@@ -66,92 +70,93 @@ AliTrackFixTenderSupply::~AliTrackFixTenderSupply()
 
 
 //_____________________________________________________
-void AliTrackFixTenderSupply::ProcessEvent()
+Bool_t AliTrackFixTenderSupply::BeginEvent()
 {
   //
-  // Fix track kinematics
+  // Prepare the fix of the track kinematics
   //
   AliESDEvent *event=fTender->GetEvent();
-  if (!event) return;
+  if (!event) return kFALSE;
   //
-  if (fTender->RunChanged() && !GetRunCorrections(fTender->GetRun())) return;
+  if (fTender->RunChanged() && !GetRunCorrections(fTender->GetRun())) return kFALSE;
   //
-  int nTracks = event->GetNumberOfTracks();
   fBz = event->GetMagneticField();
-  if (TMath::Abs(fBz) < kAlmost0Field) return;
-  //
-  const AliESDVertex *vtx = 0, *vtxTPC = 0;
+  if (TMath::Abs(fBz) < kAlmost0Field) return kFALSE;
   //
-  vtx = event->GetPrimaryVertexTracks(); // vertex to be used for update via RelateToVertex
-  if (!vtx || vtx->GetStatus()<1) {
-    vtx = event->GetPrimaryVertexSPD();
-    if (vtx && vtx->GetStatus()<1) vtx = 0;
+  fVtx = event->GetPrimaryVertexTracks(); // vertex to be used for update via RelateToVertex
+  if (!fVtx || fVtx->GetStatus()<1) {
+    fVtx = event->GetPrimaryVertexSPD();
+    if (fVtx && fVtx->GetStatus()<1) fVtx = 0;
   }
-  vtxTPC = event->GetPrimaryVertexTPC(); // vertex to be used for update via RelateToVertexTPC
-  if (vtxTPC && vtxTPC->GetStatus()<1) vtxTPC = 0;
-  //  
+  fVtxTPC = event->GetPrimaryVertexTPC(); // vertex to be used for update via RelateToVertexTPC
+  if (fVtxTPC && fVtxTPC->GetStatus()<1) fVtxTPC = 0;
+  //
+  return kTRUE;
+}
+
+//_____________________________________________________
+void AliTrackFixTenderSupply::ProcessTrack(AliESDtrack* trc)
+{
+  //
+  // Fix track kinematics
+  //
+  if (!trc->IsOn(AliESDtrack::kTPCin)) return;
+  //
   AliExternalTrackParam* extPar = 0;
   double xOrig = 0;
   double xyzTPCInner[3] = {0,0,0};
-  for (int itr=0;itr<nTracks;itr++) {
-    //
-    AliESDtrack* trc = event->GetTrack(itr);
-    if (!trc->IsOn(AliESDtrack::kTPCin)) continue;
-    //
-    double sideAfraction = GetSideAFraction(trc);
-    // correct the main parameterization
-    int cormode = trc->IsOn(AliESDtrack::kITSin) ? AliOADBTrackFix::kCorModeGlob : AliOADBTrackFix::kCorModeTPCInner;
-    xOrig = trc->GetX();
-    double xIniCor = fParams->GetXIniPtInvCorr(cormode);
-    const AliExternalTrackParam* parInner = trc->GetInnerParam();
-    if (!parInner) {
-      AliError("Failed to extract inner param");
-      continue;
-    }
-    parInner->GetXYZ(xyzTPCInner);
-    double phi = TMath::ATan2(xyzTPCInner[1],xyzTPCInner[0]);
-    if (phi<0) phi += 2*TMath::Pi();
-    //
+  double sideAfraction = GetSideAFraction(trc);
+  // correct the main parameterization
+  int cormode = trc->IsOn(AliESDtrack::kITSin) ? AliOADBTrackFix::kCorModeGlob : AliOADBTrackFix::kCorModeTPCInner;
+  xOrig = trc->GetX();
+  double xIniCor = fParams->GetXIniPtInvCorr(cormode);
+  const AliExternalTrackParam* parInner = trc->GetInnerParam();
+  if (!parInner) {
+    TrackError("Failed to extract inner param");
+    return;
+  }
+  parInner->GetXYZ(xyzTPCInner);
+  double phi = TMath::ATan2(xyzTPCInner[1],xyzTPCInner[0]);
+  if (phi<0) phi += 2*TMath::Pi();
+  //
+  if (fDebug>1) {
+    AliInfo(Form("Tr:%4d kITSin:%d Phi=%+5.2f at X=%+7.2f | SideA fraction: %.3f",trc->GetID(),trc->IsOn(AliESDtrack::kITSin),phi,parInner->GetX(),sideAfraction));
+    AliInfo(Form("Main Param before corr. in mode %s, xIni:%.1f",cormode== AliOADBTrackFix::kCorModeGlob ?  "Glo":"TPC",xIniCor));
+    trc->AliExternalTrackParam::Print();
+  }
+  //
+  if (xIniCor>0) trc->PropagateTo(xIniCor,fBz);
+  CorrectTrackPtInv(trc, cormode, sideAfraction, phi);
+  if (xIniCor>0) {                             // full update is requested
+    if (fVtx) trc->RelateToVertex(fVtx, fBz, kVeryBig); // redo DCA if vtx is available
+    else      trc->PropagateTo(xOrig, fBz);             // otherwise bring to original point
+  }
+  // 
+  if (fDebug>1) {
+    AliInfo("Main Param after corr.");
+    trc->AliExternalTrackParam::Print();
+  }
+  // correct TPCinner param
+  if ( (extPar=(AliExternalTrackParam*)trc->GetTPCInnerParam()) ) {
+    cormode = AliOADBTrackFix::kCorModeTPCInner;
+    xOrig = extPar->GetX();
+    xIniCor = fParams->GetXIniPtInvCorr(cormode);
     if (fDebug>1) {
-      AliInfo(Form("Tr:%4d kITSin:%d Phi=%+5.2f at X=%+7.2f | SideA fraction: %.3f",itr,trc->IsOn(AliESDtrack::kITSin),phi,parInner->GetX(),sideAfraction));
-      AliInfo(Form("Main Param before corr. in mode %s, xIni:%.1f",cormode== AliOADBTrackFix::kCorModeGlob ?  "Glo":"TPC",xIniCor));
-      trc->AliExternalTrackParam::Print();
+      AliInfo(Form("TPCinner Param before corr. in mode %s, xIni:%.1f",cormode== AliOADBTrackFix::kCorModeGlob ?  "Glo":"TPC",xIniCor));
+      extPar->AliExternalTrackParam::Print();
     }
     //
-    if (xIniCor>0) trc->PropagateTo(xIniCor,fBz);
-    CorrectTrackPtInv(trc, cormode, sideAfraction, phi);
-    if (xIniCor>0) {                             // full update is requested
-      if (vtx) trc->RelateToVertex(vtx, fBz, kVeryBig); // redo DCA if vtx is available
-      else     trc->PropagateTo(xOrig, fBz);            // otherwise bring to original point
-    }
-    // 
-    if (fDebug>1) {
-      AliInfo("Main Param after corr.");
-      trc->AliExternalTrackParam::Print();
-    }
-    // correct TPCinner param
-    if ( (extPar=(AliExternalTrackParam*)trc->GetTPCInnerParam()) ) {
-      cormode = AliOADBTrackFix::kCorModeTPCInner;
-      xOrig = extPar->GetX();
-      xIniCor = fParams->GetXIniPtInvCorr(cormode);
-      if (fDebug>1) {
-	AliInfo(Form("TPCinner Param before corr. in mode %s, xIni:%.1f",cormode== AliOADBTrackFix::kCorModeGlob ?  "Glo":"TPC",xIniCor));
-	extPar->AliExternalTrackParam::Print();
-      }
-      //
-      if (xIniCor>0) extPar->PropagateTo(xIniCor,fBz);
-      CorrectTrackPtInv(extPar,cormode,sideAfraction, phi);
-      if (xIniCor>0) {                              // full update is requested
-	if (vtxTPC) trc->RelateToVertexTPC(vtxTPC, fBz, kVeryBig);  // redo DCA if vtx is available
-	else        extPar->PropagateTo(xOrig, fBz);                // otherwise bring to original point
-      }
-      //
-      if (fDebug>1) {
-	AliInfo("TPCinner Param after corr.");
-	extPar->AliExternalTrackParam::Print();
-      }      
+    if (xIniCor>0) extPar->PropagateTo(xIniCor,fBz);
+    CorrectTrackPtInv(extPar,cormode,sideAfraction, phi);
+    if (xIniCor>0) {                              // full update is requested
+      if (fVtxTPC) trc->RelateToVertexTPC(fVtxTPC, fBz, kVeryBig);  // redo DCA if vtx is available
+      else         extPar->PropagateTo(xOrig, fBz);                 // otherwise bring to original point
     }
     //
+    if (fDebug>1) {
+      AliInfo("TPCinner Param after corr.");
+      extPar->AliExternalTrackParam::Print();
+    }      
   }
   //
 }
@@ -206,7 +211,7 @@ Double_t AliTrackFixTenderSupply::GetSideAFraction(const AliESDtrack* track) con
   // for the moment just a placeholder...
   //
   const AliExternalTrackParam *trIn = track->GetInnerParam();
-  if (!trIn) {AliError("Failed to onbtain InnerParam"); return 0.5;}
+  if (!trIn) {TrackError("Failed to onbtain InnerParam"); return 0.5;}
   //
   // easy cases:
   double sideAfrac = 0.5;
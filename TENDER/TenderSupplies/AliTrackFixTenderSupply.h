@@ -30,9 +30,16 @@ public:
   AliTrackFixTenderSupply();
   AliTrackFixTenderSupply(const char *name, const AliTender *tender=NULL);
   virtual ~AliTrackFixTenderSupply();
-  virtual  void ProcessEvent();
+  virtual  void ProcessEvent() {ProcessTracks();}
   virtual  void Init() {}
   //
+  // per-track interface, see AliTenderSupply
+  virtual  Bool_t UsesTrackLoop()        const {return kTRUE;}
+  virtual  Bool_t BeginEvent();
+  virtual  void   ProcessTrack(AliESDtrack* trc);
+  virtual  Bool_t NeedsProcessedTracks() const {return kFALSE;}
+  virtual  Bool_t IsTrackIndependent()   const {return fDebug<2;}
+  //
   Double_t GetSideAFraction(const AliESDtrack* track) const;
   void     CorrectTrackPtInv(AliExternalTrackParam* trc, int mode, double sideAfraction, double phi) const;
   Bool_t   GetRunCorrections(int run);
@@ -57,8 +64,10 @@ private:
   TString           fOADBObjPath;            // path of file with parameters to use, starting from OADB dir
   TString           fOADBObjName;            // name of the corrections object in the OADB container
   AliOADBContainer* fOADBCont;               // OADB container with parameters collection
+  const AliESDVertex* fVtx;                  //! vertex for the update of the main param. in current event
+  const AliESDVertex* fVtxTPC;               //! vertex for the update of the TPCinner param. in current event
   //
-  ClassDef(AliTrackFixTenderSupply, 1);  // track fixing tender task 
+  ClassDef(AliTrackFixTenderSupply, 2);  // track fixing tender task 
 };
 
 